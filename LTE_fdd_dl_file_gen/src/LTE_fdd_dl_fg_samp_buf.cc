@@ -301,6 +301,7 @@ int32 LTE_fdd_dl_fg_samp_buf::work(int32                      noutput_items,
         if(!need_config)
         {
             // Initialize the LTE library
+            liblte_phy_set_default_fftw_wisdom_path();
             liblte_phy_init(&phy_struct,
                             fs,
                             N_id_cell,
@@ -568,8 +569,8 @@ int32 LTE_fdd_dl_fg_samp_buf::work(int32                      noutput_items,
                     liblte_phy_create_dl_subframe(phy_struct,
                                                   &subframe,
                                                   p,
-                                                  &i_buf[(p*phy_struct->N_samps_per_frame) + (subframe.num*phy_struct->N_samps_per_subfr)],
-                                                  &q_buf[(p*phy_struct->N_samps_per_frame) + (subframe.num*phy_struct->N_samps_per_subfr)]);
+                                                  &i_buf[(p*phy_struct->cell->N_samps_per_frame) + (subframe.num*phy_struct->cell->N_samps_per_subfr)],
+                                                  &q_buf[(p*phy_struct->cell->N_samps_per_frame) + (subframe.num*phy_struct->cell->N_samps_per_subfr)]);
                 }
             }
         }else{
@@ -594,7 +595,7 @@ int32 LTE_fdd_dl_fg_samp_buf::work(int32                      noutput_items,
                     q_samp = 0;
                     for(p=0; p<N_ant; p++)
                     {
-                        q_samp += q_buf[(p*phy_struct->N_samps_per_frame) + samp_buf_idx];
+                        q_samp += q_buf[(p*phy_struct->cell->N_samps_per_frame) + samp_buf_idx];
                     }
                     int8_out[out_idx++] = (int8)(q_samp);
                     samp_buf_idx++;
@@ -602,9 +603,9 @@ int32 LTE_fdd_dl_fg_samp_buf::work(int32                      noutput_items,
                 }
 
                 // Determine how many full samples to write
-                if((phy_struct->N_samps_per_frame - samp_buf_idx) < ((noutput_items - act_noutput_items) / 2))
+                if((phy_struct->cell->N_samps_per_frame - samp_buf_idx) < ((noutput_items - act_noutput_items) / 2))
                 {
-                    loop_cnt = (phy_struct->N_samps_per_frame - samp_buf_idx)*2;
+                    loop_cnt = (phy_struct->cell->N_samps_per_frame - samp_buf_idx)*2;
                 }else{
                     loop_cnt = noutput_items - act_noutput_items;
                 }
@@ -616,8 +617,8 @@ int32 LTE_fdd_dl_fg_samp_buf::work(int32                      noutput_items,
                     q_samp = 0;
                     for(p=0; p<N_ant; p++)
                     {
-                        i_samp += i_buf[(p*phy_struct->N_samps_per_frame) + samp_buf_idx];
-                        q_samp += q_buf[(p*phy_struct->N_samps_per_frame) + samp_buf_idx];
+                        i_samp += i_buf[(p*phy_struct->cell->N_samps_per_frame) + samp_buf_idx];
+                        q_samp += q_buf[(p*phy_struct->cell->N_samps_per_frame) + samp_buf_idx];
                     }
 
                     int8_out[out_idx++] = (int8)(i_samp);
@@ -632,7 +633,7 @@ int32 LTE_fdd_dl_fg_samp_buf::work(int32                      noutput_items,
                     i_samp = 0;
                     for(p=0; p<N_ant; p++)
                     {
-                        i_samp += i_buf[(p*phy_struct->N_samps_per_frame) + samp_buf_idx];
+                        i_samp += i_buf[(p*phy_struct->cell->N_samps_per_frame) + samp_buf_idx];
                     }
                     int8_out[out_idx++] = (int8)(i_samp);
                     act_noutput_items++;
@@ -642,9 +643,9 @@ int32 LTE_fdd_dl_fg_samp_buf::work(int32                      noutput_items,
                 }
             }else{ // LTE_FDD_DL_FG_OUT_SIZE_GR_COMPLEX == out_size
                 // Determine how many samples to write
-                if((phy_struct->N_samps_per_frame - samp_buf_idx) < noutput_items)
+                if((phy_struct->cell->N_samps_per_frame - samp_buf_idx) < noutput_items)
                 {
-                    loop_cnt = phy_struct->N_samps_per_frame - samp_buf_idx;
+                    loop_cnt = phy_struct->cell->N_samps_per_frame - samp_buf_idx;
                 }else{
                     loop_cnt = noutput_items;
                 }
@@ -656,8 +657,8 @@ int32 LTE_fdd_dl_fg_samp_buf::work(int32                      noutput_items,
                     q_samp = 0;
                     for(p=0; p<N_ant; p++)
                     {
-                        i_samp += i_buf[(p*phy_struct->N_samps_per_frame) + samp_buf_idx];
-                        q_samp += q_buf[(p*phy_struct->N_samps_per_frame) + samp_buf_idx];
+                        i_samp += i_buf[(p*phy_struct->cell->N_samps_per_frame) + samp_buf_idx];
+                        q_samp += q_buf[(p*phy_struct->cell->N_samps_per_frame) + samp_buf_idx];
                     }
                     gr_complex_out[out_idx++] = gr_complex(i_samp, q_samp);
                     samp_buf_idx++;
@@ -667,7 +668,7 @@ int32 LTE_fdd_dl_fg_samp_buf::work(int32                      noutput_items,
         }
 
         // Check to see if we need more samples
-        if(samp_buf_idx >= phy_struct->N_samps_per_frame)
+        if(samp_buf_idx >= phy_struct->cell->N_samps_per_frame)
         {
             samples_ready = false;
             samp_buf_idx  = 0;
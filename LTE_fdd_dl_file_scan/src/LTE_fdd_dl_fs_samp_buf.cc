@@ -184,6 +184,7 @@ int32 LTE_fdd_dl_fs_samp_buf::work(int32                      ninput_items,
         if(!need_config)
         {
             // Initialize the LTE library
+            liblte_phy_set_default_fftw_wisdom_path();
             liblte_phy_init(&phy_struct,
                             fs,
                             LIBLTE_PHY_INIT_N_ID_CELL_UNKNOWN,
@@ -191,19 +192,20 @@ int32 LTE_fdd_dl_fs_samp_buf::work(int32                      ninput_items,
                             LIBLTE_PHY_N_RB_DL_1_4MHZ,
                             LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP,
                             liblte_rrc_phich_resource_num[LIBLTE_RRC_PHICH_RESOURCE_1]);
-            num_samps_needed = phy_struct->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
+            liblte_phy_set_dl_channel_estimator(phy_struct, LIBLTE_PHY_DL_CE_TYPE_WIENER, true);
+            num_samps_needed = phy_struct->cell->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
         }
     }
     free(line);
 
     if(LTE_FDD_DL_FS_IN_SIZE_INT8 == in_size)
     {
-        if(samp_buf_w_idx < (LTE_FDD_DL_FS_SAMP_BUF_NUM_FRAMES*phy_struct->N_samps_per_frame - ((ninput_items+1)/2)))
+        if(samp_buf_w_idx < (LTE_FDD_DL_FS_SAMP_BUF_NUM_FRAMES*phy_struct->cell->N_samps_per_frame - ((ninput_items+1)/2)))
         {
             copy_input_to_samp_buf(input_items, ninput_items);
 
             // Check if buffer is full enough
-            if(samp_buf_w_idx >= (LTE_FDD_DL_FS_SAMP_BUF_NUM_FRAMES*phy_struct->N_samps_per_frame - ((ninput_items+1)/2)))
+            if(samp_buf_w_idx >= (LTE_FDD_DL_FS_SAMP_BUF_NUM_FRAMES*phy_struct->cell->N_samps_per_frame - ((ninput_items+1)/2)))
             {
                 process_samples = true;
                 copy_input      = false;
@@ -214,12 +216,12 @@ int32 LTE_fdd_dl_fs_samp_buf::work(int32                      ninput_items,
             copy_input      = true;
         }
     }else{ // LTE_FDD_DL_FS_IN_SIZE_GR_COMPLEX == in_size
-        if(samp_buf_w_idx < (LTE_FDD_DL_FS_SAMP_BUF_NUM_FRAMES*phy_struct->N_samps_per_frame - (ninput_items+1)))
+        if(samp_buf_w_idx < (LTE_FDD_DL_FS_SAMP_BUF_NUM_FRAMES*phy_struct->cell->N_samps_per_frame - (ninput_items+1)))
         {
             copy_input_to_samp_buf(input_items, ninput_items);
 
             // Check if buffer is full enough
-            if(samp_buf_w_idx >= (LTE_FDD_DL_FS_SAMP_BUF_NUM_FRAMES*phy_struct->N_samps_per_frame - (ninput_items+1)))
+            if(samp_buf_w_idx >= (LTE_FDD_DL_FS_SAMP_BUF_NUM_FRAMES*phy_struct->cell->N_samps_per_frame - (ninput_items+1)))
             {
                 process_samples = true;
                 copy_input      = false;
@@ -243,22 +245,22 @@ int32 LTE_fdd_dl_fs_samp_buf::work(int32                      ninput_items,
         switch(state)
         {
         case LTE_FDD_DL_FS_SAMP_BUF_STATE_COARSE_TIMING_SEARCH:
-            num_samps_needed = phy_struct->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
+            num_samps_needed = phy_struct->cell->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
             break;
         case LTE_FDD_DL_FS_SAMP_BUF_STATE_PSS_AND_FINE_TIMING_SEARCH:
-            num_samps_needed = phy_struct->N_samps_per_subfr * PSS_AND_FINE_TIMING_SEARCH_NUM_SUBFRAMES;
+            num_samps_needed = phy_struct->cell->N_samps_per_subfr * PSS_AND_FINE_TIMING_SEARCH_NUM_SUBFRAMES;
             break;
         case LTE_FDD_DL_FS_SAMP_BUF_STATE_SSS_SEARCH:
-            num_samps_needed = phy_struct->N_samps_per_subfr * SSS_SEARCH_NUM_SUBFRAMES;
+            num_samps_needed = phy_struct->cell->N_samps_per_subfr * SSS_SEARCH_NUM_SUBFRAMES;
             break;
         case LTE_FDD_DL_FS_SAMP_BUF_STATE_BCH_DECODE:
-            num_samps_needed = phy_struct->N_samps_per_frame * BCH_DECODE_NUM_FRAMES;
+            num_samps_needed = phy_struct->cell->N_samps_per_frame * BCH_DECODE_NUM_FRAMES;
             break;
         case LTE_FDD_DL_FS_SAMP_BUF_STATE_PDSCH_DECODE_SIB1:
-            num_samps_needed = phy_struct->N_samps_per_frame * PDSCH_DECODE_SIB1_NUM_FRAMES;
+            num_samps_needed = phy_struct->cell->N_samps_per_frame * PDSCH_DECODE_SIB1_NUM_FRAMES;
             break;
         case LTE_FDD_DL_FS_SAMP_BUF_STATE_PDSCH_DECODE_SI_GENERIC:
-            num_samps_needed = phy_struct->N_samps_per_frame * PDSCH_DECODE_SI_GENERIC_NUM_FRAMES;
+            num_samps_needed = phy_struct->cell->N_samps_per_frame * PDSCH_DECODE_SI_GENERIC_NUM_FRAMES;
             break;
         }
 
@@ -295,15 +297,15 @@ int32 LTE_fdd_dl_fs_samp_buf::work(int32                      ninput_items,
 
                         // Search for PSS and fine timing
                         state            = LTE_FDD_DL_FS_SAMP_BUF_STATE_PSS_AND_FINE_TIMING_SEARCH;
-                        num_samps_needed = phy_struct->N_samps_per_subfr * PSS_AND_FINE_TIMING_SEARCH_NUM_SUBFRAMES;
+                        num_samps_needed = phy_struct->cell->N_samps_per_subfr * PSS_AND_FINE_TIMING_SEARCH_NUM_SUBFRAMES;
                     }else{
                         // No more peaks, so signal that we are done
                         done_flag = -1;
                     }
                 }else{
                     // Stay in coarse timing search
-                    samp_buf_r_idx   += phy_struct->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
-                    num_samps_needed  = phy_struct->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
+                    samp_buf_r_idx   += phy_struct->cell->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
+                    num_samps_needed  = phy_struct->cell->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
                 }
                 break;
             case LTE_FDD_DL_FS_SAMP_BUF_STATE_PSS_AND_FINE_TIMING_SEARCH:
@@ -324,12 +326,12 @@ int32 LTE_fdd_dl_fs_samp_buf::work(int32                      ninput_items,
 
                     // Search for SSS
                     state            = LTE_FDD_DL_FS_SAMP_BUF_STATE_SSS_SEARCH;
-                    num_samps_needed = phy_struct->N_samps_per_subfr * SSS_SEARCH_NUM_SUBFRAMES;
+                    num_samps_needed = phy_struct->cell->N_samps_per_subfr * SSS_SEARCH_NUM_SUBFRAMES;
                 }else{
                     // Go back to coarse timing search
                     state             = LTE_FDD_DL_FS_SAMP_BUF_STATE_COARSE_TIMING_SEARCH;
-                    samp_buf_r_idx   += phy_struct->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
-                    num_samps_needed  = phy_struct->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
+                    samp_buf_r_idx   += phy_struct->cell->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
+                    num_samps_needed  = phy_struct->cell->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
                 }
                 break;
             case LTE_FDD_DL_FS_SAMP_BUF_STATE_SSS_SEARCH:
@@ -362,16 +364,16 @@ int32 LTE_fdd_dl_fs_samp_buf::work(int32                      ninput_items,
                         state = LTE_FDD_DL_FS_SAMP_BUF_STATE_BCH_DECODE;
                         while(frame_start_idx < samp_buf_r_idx)
                         {
-                            frame_start_idx += phy_struct->N_samps_per_frame;
+                            frame_start_idx += phy_struct->cell->N_samps_per_frame;
                         }
                         samp_buf_r_idx   = frame_start_idx;
-                        num_samps_needed = phy_struct->N_samps_per_frame * BCH_DECODE_NUM_FRAMES;
+                        num_samps_needed = phy_struct->cell->N_samps_per_frame * BCH_DECODE_NUM_FRAMES;
                     }
                 }else{
                     // Go back to coarse timing search
                     state             = LTE_FDD_DL_FS_SAMP_BUF_STATE_COARSE_TIMING_SEARCH;
-                    samp_buf_r_idx   += phy_struct->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
-                    num_samps_needed  = phy_struct->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
+                    samp_buf_r_idx   += phy_struct->cell->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
+                    num_samps_needed  = phy_struct->cell->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
                 }
                 break;
             case LTE_FDD_DL_FS_SAMP_BUF_STATE_BCH_DECODE:
@@ -430,15 +432,15 @@ int32 LTE_fdd_dl_fs_samp_buf::work(int32                      ninput_items,
                     state = LTE_FDD_DL_FS_SAMP_BUF_STATE_PDSCH_DECODE_SIB1;
                     if((sfn % 2) != 0)
                     {
-                        samp_buf_r_idx += phy_struct->N_samps_per_frame;
+                        samp_buf_r_idx += phy_struct->cell->N_samps_per_frame;
                         sfn++;
                     }
-                    num_samps_needed = phy_struct->N_samps_per_frame * PDSCH_DECODE_SIB1_NUM_FRAMES;
+                    num_samps_needed = phy_struct->cell->N_samps_per_frame * PDSCH_DECODE_SIB1_NUM_FRAMES;
                 }else{
                     // Go back to coarse timing search
                     state             = LTE_FDD_DL_FS_SAMP_BUF_STATE_COARSE_TIMING_SEARCH;
-                    samp_buf_r_idx   += phy_struct->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
-                    num_samps_needed  = phy_struct->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
+                    samp_buf_r_idx   += phy_struct->cell->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
+                    num_samps_needed  = phy_struct->cell->N_samps_per_subfr * COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
                 }
                 break;
             case LTE_FDD_DL_FS_SAMP_BUF_STATE_PDSCH_DECODE_SIB1:
@@ -465,6 +467,7 @@ int32 LTE_fdd_dl_fs_samp_buf::work(int32                      ninput_items,
                                                                      pdcch.N_symbs,
                                                                      N_id_cell,
                                                                      N_ant,
+                                                                     NULL,
                                                                      rrc_msg.msg,
                                                                      &rrc_msg.N_bits) &&
                    LIBLTE_SUCCESS == liblte_rrc_unpack_bcch_dlsch_msg(&rrc_msg,
@@ -479,12 +482,12 @@ int32 LTE_fdd_dl_fs_samp_buf::work(int32                      ninput_items,
                     // Decode all PDSCHs
                     state            = LTE_FDD_DL_FS_SAMP_BUF_STATE_PDSCH_DECODE_SI_GENERIC;
                     N_sfr            = 0;
-                    num_samps_needed = phy_struct->N_samps_per_frame * PDSCH_DECODE_SI_GENERIC_NUM_FRAMES;
+                    num_samps_needed = phy_struct->cell->N_samps_per_frame * PDSCH_DECODE_SI_GENERIC_NUM_FRAMES;
                 }else{
                     // Try to decode SIB1 again
-                    samp_buf_r_idx   += phy_struct->N_samps_per_frame * PDSCH_DECODE_SIB1_NUM_FRAMES;
+                    samp_buf_r_idx   += phy_struct->cell->N_samps_per_frame * PDSCH_DECODE_SIB1_NUM_FRAMES;
                     sfn              += 2;
-                    num_samps_needed  = phy_struct->N_samps_per_frame * PDSCH_DECODE_SIB1_NUM_FRAMES;
+                    num_samps_needed  = phy_struct->cell->N_samps_per_frame * PDSCH_DECODE_SIB1_NUM_FRAMES;
                 }
                 break;
             case LTE_FDD_DL_FS_SAMP_BUF_STATE_PDSCH_DECODE_SI_GENERIC:
@@ -511,6 +514,7 @@ int32 LTE_fdd_dl_fs_samp_buf::work(int32                      ninput_items,
                                                                      pdcch.N_symbs,
                                                                      N_id_cell,
                                                                      N_ant,
+                                                                     NULL,
                                                                      rrc_msg.msg,
                                                                      &rrc_msg.N_bits))
                 {
@@ -581,13 +585,13 @@ int32 LTE_fdd_dl_fs_samp_buf::work(int32                      ninput_items,
 
                 // Keep trying to decode PDSCHs
                 state            = LTE_FDD_DL_FS_SAMP_BUF_STATE_PDSCH_DECODE_SI_GENERIC;
-                num_samps_needed = phy_struct->N_samps_per_frame * PDSCH_DECODE_SI_GENERIC_NUM_FRAMES;
+                num_samps_needed = phy_struct->cell->N_samps_per_frame * PDSCH_DECODE_SI_GENERIC_NUM_FRAMES;
                 N_sfr++;
                 if(N_sfr >= 10)
                 {
                     N_sfr = 0;
                     sfn++;
-                    samp_buf_r_idx += phy_struct->N_samps_per_frame * PDSCH_DECODE_SI_GENERIC_NUM_FRAMES;
+                    samp_buf_r_idx += phy_struct->cell->N_samps_per_frame * PDSCH_DECODE_SI_GENERIC_NUM_FRAMES;
                 }
                 break;
             }
@@ -703,8 +707,8 @@ void LTE_fdd_dl_fs_samp_buf::freq_shift(uint32 start_idx, uint32 num_samps, floa
 
     for(i=start_idx; i<(start_idx+num_samps); i++)
     {
-        f_samp_re = cosf((i+1)*(freq_offset)*2*M_PI/phy_struct->fs);
-        f_samp_im = sinf((i+1)*(freq_offset)*2*M_PI/phy_struct->fs);
+        f_samp_re = cosf((i+1)*(freq_offset)*2*M_PI/phy_struct->cell->fs);
+        f_samp_im = sinf((i+1)*(freq_offset)*2*M_PI/phy_struct->cell->fs);
         tmp_i     = i_buf[i];
         tmp_q     = q_buf[i];
         i_buf[i]  = tmp_i*f_samp_re + tmp_q*f_samp_im;
@@ -119,6 +119,7 @@ LTE_fdd_dl_scan_state_machine::LTE_fdd_dl_scan_state_machine(uint32 samp_rate)
     uint32 i;
 
     // Initialize the LTE library
+    liblte_phy_set_default_fftw_wisdom_path();
     if(samp_rate == 1920000)
     {
         liblte_phy_init(&phy_struct,
@@ -172,6 +173,7 @@ LTE_fdd_dl_scan_state_machine::LTE_fdd_dl_scan_state_machine(uint32 samp_rate)
         pdsch_decode_sib1_num_samps          = PDSCH_DECODE_SIB1_NUM_SAMPS_15_36MHZ;
         pdsch_decode_si_generic_num_samps    = PDSCH_DECODE_SI_GENERIC_NUM_SAMPS_15_36MHZ;
     }
+    liblte_phy_set_dl_channel_estimator(phy_struct, LIBLTE_PHY_DL_CE_TYPE_WIENER, true);
 
     // Initialize the sample buffer
     i_buf          = (float *)malloc(SAMP_BUF_SIZE*sizeof(float));
@@ -488,6 +490,7 @@ int32 LTE_fdd_dl_scan_state_machine::work(int32                      ninput_item
                                                                      pdcch.N_symbs,
                                                                      chan_data.N_id_cell,
                                                                      N_ant,
+                                                                     NULL,
                                                                      rrc_msg.msg,
                                                                      &rrc_msg.N_bits) &&
                    LIBLTE_SUCCESS == liblte_rrc_unpack_bcch_dlsch_msg(&rrc_msg,
@@ -548,6 +551,7 @@ int32 LTE_fdd_dl_scan_state_machine::work(int32                      ninput_item
                                                                      pdcch.N_symbs,
                                                                      chan_data.N_id_cell,
                                                                      N_ant,
+                                                                     NULL,
                                                                      rrc_msg.msg,
                                                                      &rrc_msg.N_bits))
                 {
@@ -745,8 +749,8 @@ void LTE_fdd_dl_scan_state_machine::freq_shift(uint32 start_idx, uint32 num_samp
 
     for(i=start_idx; i<(start_idx+num_samps); i++)
     {
-        f_samp_re = cosf((i+1)*(freq_offset)*2*M_PI/phy_struct->fs);
-        f_samp_im = sinf((i+1)*(freq_offset)*2*M_PI/phy_struct->fs);
+        f_samp_re = cosf((i+1)*(freq_offset)*2*M_PI/phy_struct->cell->fs);
+        f_samp_im = sinf((i+1)*(freq_offset)*2*M_PI/phy_struct->cell->fs);
         tmp_i     = i_buf[i];
         tmp_q     = q_buf[i];
         i_buf[i]  = tmp_i*f_samp_re + tmp_q*f_samp_im;
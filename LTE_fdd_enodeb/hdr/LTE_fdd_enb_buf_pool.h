@@ -0,0 +1,128 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_buf_pool.h
+
+    Description: Contains all the definitions for the LTE FDD eNodeB
+                 reference counted buffer pool.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/18/2026    agent            Created file
+
+*******************************************************************************/
+
+#ifndef __LTE_FDD_ENB_BUF_POOL_H__
+#define __LTE_FDD_ENB_BUF_POOL_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "typedefs.h"
+#include <boost/thread/mutex.hpp>
+#include <pthread.h>
+#include <string>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define LTE_FDD_ENB_BUF_POOL_ALIGN      64
+#define LTE_FDD_ENB_BUF_POOL_MAX_CACHES 32
+#define LTE_FDD_ENB_BUF_POOL_CACHE_SIZE 16
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+class LTE_fdd_enb_buf_pool;
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+// Precedes every buffer, padded so buffers stay cache line aligned
+typedef struct LTE_FDD_ENB_BUF_HDR_STRUCT{
+    LTE_fdd_enb_buf_pool              *pool;
+    struct LTE_FDD_ENB_BUF_HDR_STRUCT *next;
+    uint32                             ref_count;
+}LTE_FDD_ENB_BUF_HDR_STRUCT;
+
+// Per thread list of free buffers, one for each cached pool
+typedef struct{
+    LTE_FDD_ENB_BUF_HDR_STRUCT *free_list;
+    uint32                      pool_id;
+    uint32                      N_free;
+}LTE_FDD_ENB_BUF_POOL_CACHE_STRUCT;
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+// Pools created with a thread cache keep up to LTE_FDD_ENB_BUF_POOL_CACHE_SIZE
+// free buffers per thread and only take the pool mutex to move half of a
+// cache at a time, so they should be sized with that headroom in mind.  A
+// thread's cached buffers go back to the shared free lists when it exits.
+class LTE_fdd_enb_buf_pool
+{
+public:
+    // Constructor/Destructor
+    LTE_fdd_enb_buf_pool(std::string _pool_name, uint32 _buf_size, uint32 _N_bufs, bool _thread_cache);
+    ~LTE_fdd_enb_buf_pool();
+
+    // Allocate/Reference/Release
+    void* alloc(void);
+    static void ref(void *buf);
+    static void release(void *buf);
+
+    // Statistics
+    std::string get_pool_name(void);
+    uint32 get_N_bufs(void);
+    uint32 get_N_in_use(void);
+    uint32 get_high_water(void);
+    uint32 get_N_failed(void);
+
+private:
+    // Buffers
+    LTE_FDD_ENB_BUF_HDR_STRUCT* get_hdr(uint32 idx);
+    void free_buf(LTE_FDD_ENB_BUF_HDR_STRUCT *hdr);
+    boost::mutex                mutex;
+    LTE_FDD_ENB_BUF_HDR_STRUCT *free_list;
+    uint8                      *mem;
+    uint8                      *mem_aligned;
+    uint32                      stride;
+    uint32                      N_bufs;
+
+    // Thread Cache
+    LTE_FDD_ENB_BUF_POOL_CACHE_STRUCT* get_cache(void);
+    void flush_cache(LTE_FDD_ENB_BUF_POOL_CACHE_STRUCT *cache);
+    static void create_cache_key(void);
+    static void handle_thread_exit(void *arg);
+    int32                              cache_slot;
+    uint32                             pool_id;
+
+    // Statistics
+    std::string                 pool_name;
+    uint32                      N_in_use;
+    uint32                      high_water;
+    uint32                      N_failed;
+};
+
+#endif /* __LTE_FDD_ENB_BUF_POOL_H__ */
@@ -0,0 +1,104 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_buf_pool_mgr.h
+
+    Description: Contains all the definitions for the LTE FDD eNodeB
+                 buffer pool manager.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/18/2026    agent            Created file
+
+*******************************************************************************/
+
+#ifndef __LTE_FDD_ENB_BUF_POOL_MGR_H__
+#define __LTE_FDD_ENB_BUF_POOL_MGR_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_interface.h"
+#include "LTE_fdd_enb_buf_pool.h"
+#include <boost/thread/mutex.hpp>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef enum{
+    LTE_FDD_ENB_BUF_POOL_BIT_MSG = 0,
+    LTE_FDD_ENB_BUF_POOL_BYTE_MSG,
+    LTE_FDD_ENB_BUF_POOL_RLC_AMD_PDU,
+    LTE_FDD_ENB_BUF_POOL_RAR_SCHED_QUEUE,
+    LTE_FDD_ENB_BUF_POOL_DL_SCHED_QUEUE,
+    LTE_FDD_ENB_BUF_POOL_UL_SCHED_QUEUE,
+    LTE_FDD_ENB_BUF_POOL_N_ITEMS,
+}LTE_FDD_ENB_BUF_POOL_ENUM;
+static const char LTE_fdd_enb_buf_pool_text[LTE_FDD_ENB_BUF_POOL_N_ITEMS][100] = {"bit_msg",
+                                                                                  "byte_msg",
+                                                                                  "rlc_amd_pdu",
+                                                                                  "rar_sched_queue",
+                                                                                  "dl_sched_queue",
+                                                                                  "ul_sched_queue"};
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+class LTE_fdd_enb_buf_pool_mgr
+{
+public:
+    // Singleton
+    static LTE_fdd_enb_buf_pool_mgr* get_instance(void);
+    static void cleanup(void);
+
+    // Start
+    void start(void);
+
+    // External Interface
+    void* alloc(LTE_FDD_ENB_BUF_POOL_ENUM type);
+    void print_stats(LTE_fdd_enb_interface *iface);
+
+private:
+    // Singleton
+    static LTE_fdd_enb_buf_pool_mgr *instance;
+    LTE_fdd_enb_buf_pool_mgr();
+    ~LTE_fdd_enb_buf_pool_mgr();
+
+    // Start
+    boost::mutex start_mutex;
+    bool         started;
+
+    // Pools
+    LTE_fdd_enb_buf_pool *pool[LTE_FDD_ENB_BUF_POOL_N_ITEMS];
+};
+
+#endif /* __LTE_FDD_ENB_BUF_POOL_MGR_H__ */
@@ -181,6 +181,12 @@ typedef enum{
     LTE_FDD_ENB_PARAM_USE_USER_FILE,
     LTE_FDD_ENB_PARAM_TX_GAIN,
     LTE_FDD_ENB_PARAM_RX_GAIN,
+    LTE_FDD_ENB_PARAM_FFTW_PLANNER_TIME_LIMIT,
+    LTE_FDD_ENB_PARAM_PUSCH_DECODE_WORKERS,
+    LTE_FDD_ENB_PARAM_MSGQ_SIZE,
+    LTE_FDD_ENB_PARAM_MSG_POOL_SIZE,
+    LTE_FDD_ENB_PARAM_RLC_PDU_POOL_SIZE,
+    LTE_FDD_ENB_PARAM_SCHED_POOL_SIZE,
 
     // Radio parameters managed by LTE_fdd_enb_radio
     LTE_FDD_ENB_PARAM_AVAILABLE_RADIOS,
@@ -234,6 +240,12 @@ static const char LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_N_ITEMS][100] = {"ban
                                                                             "use_user_file",
                                                                             "tx_gain",
                                                                             "rx_gain",
+                                                                            "fftw_planner_time_limit",
+                                                                            "pusch_decode_workers",
+                                                                            "msgq_size",
+                                                                            "msg_pool_size",
+                                                                            "rlc_pdu_pool_size",
+                                                                            "sched_pool_size",
                                                                             "available_radios",
                                                                             "selected_radio_name",
                                                                             "selected_radio_idx",
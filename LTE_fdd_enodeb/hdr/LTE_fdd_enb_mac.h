@@ -43,6 +43,7 @@
 *******************************************************************************/
 
 #include "LTE_fdd_enb_interface.h"
+#include "LTE_fdd_enb_buf_pool.h"
 #include "LTE_fdd_enb_cnfg_db.h"
 #include "LTE_fdd_enb_msgq.h"
 #include "LTE_fdd_enb_user.h"
@@ -55,6 +56,14 @@
                               DEFINES
 *******************************************************************************/
 
+// 10 DL and UL schedules held by MAC, 10 by PHY, and the rest in flight
+#define LTE_FDD_ENB_MAC_N_SCHED_BUFS 32
+
+// DL SDUs multiplexed into one MAC PDU, leaving subheaders for the
+// contention resolution ID and two padding subheaders, and a payload
+// limit that keeps the padded TBS within a LIBLTE_BIT_MSG_STRUCT
+#define LTE_FDD_ENB_MAC_MAX_DL_SDUS_PER_PDU   (LIBLTE_MAC_MAX_MAC_PDU_N_SUBHEADERS - 3)
+#define LTE_FDD_ENB_MAC_MAX_DL_PDU_SDU_BYTES  (LIBLTE_MAX_MSG_SIZE/16)
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -149,14 +158,17 @@ private:
     LTE_FDD_ENB_ERROR_ENUM add_to_rar_sched_queue(uint32 current_tti, LIBLTE_PHY_ALLOCATION_STRUCT *dl_alloc, LIBLTE_PHY_ALLOCATION_STRUCT *ul_alloc, LIBLTE_MAC_RAR_STRUCT *rar);
     LTE_FDD_ENB_ERROR_ENUM add_to_dl_sched_queue(uint32 current_tti, LIBLTE_MAC_PDU_STRUCT *mac_pdu, LIBLTE_PHY_ALLOCATION_STRUCT *alloc);
     LTE_FDD_ENB_ERROR_ENUM add_to_ul_sched_queue(uint32 current_tti, LIBLTE_PHY_ALLOCATION_STRUCT *alloc);
+    void send_phy_schedule(void);
     boost::mutex                                   rar_sched_queue_mutex;
     boost::mutex                                   dl_sched_queue_mutex;
     boost::mutex                                   ul_sched_queue_mutex;
     std::list<LTE_FDD_ENB_RAR_SCHED_QUEUE_STRUCT*> rar_sched_queue;
     std::list<LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT*>  dl_sched_queue;
     std::list<LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT*>  ul_sched_queue;
-    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT             sched_dl_subfr[10];
-    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT             sched_ul_subfr[10];
+    LTE_fdd_enb_buf_pool                          *dl_sched_pool;
+    LTE_fdd_enb_buf_pool                          *ul_sched_pool;
+    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT            *sched_dl_subfr[10];
+    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT            *sched_ul_subfr[10];
     uint8                                          sched_cur_dl_subfn;
     uint8                                          sched_cur_ul_subfn;
 
@@ -53,8 +53,7 @@
 #include "LTE_fdd_enb_user.h"
 #include "liblte_rrc.h"
 #include "liblte_phy.h"
-#include <boost/interprocess/sync/interprocess_semaphore.hpp>
-#include <boost/circular_buffer.hpp>
+#include <boost/thread/mutex.hpp>
 #include <string>
 
 /*******************************************************************************
@@ -63,6 +62,8 @@
 
 #define LTE_FDD_ENB_N_SIB_ALLOCS 7
 
+#define LTE_FDD_ENB_MSGQ_CACHE_LINE_SIZE 64
+
 /*******************************************************************************
                               FORWARD DECLARATIONS
 *******************************************************************************/
@@ -181,9 +182,11 @@ typedef struct{
     uint32                  current_tti;
     uint8                   next_prb;
 }LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT;
+// Handles to schedules built in LTE_fdd_enb_buf_pool buffers, the
+// receiver takes over the sender's reference to each
 typedef struct{
-    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT dl_sched;
-    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT ul_sched;
+    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *dl_sched;
+    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *ul_sched;
 }LTE_FDD_ENB_PHY_SCHEDULE_MSG_STRUCT;
 
 // PHY -> MAC Messages
@@ -197,6 +200,8 @@ typedef struct{
     uint32 timing_adv[64];
     uint32 preamble[64];
     uint32 num_preambles;
+    float  power[64];
+    float  noise_floor;
 }LTE_FDD_ENB_PRACH_DECODE_MSG_STRUCT;
 typedef struct{
     uint32 current_tti;
@@ -352,6 +357,26 @@ typedef struct{
     LTE_FDD_ENB_MESSAGE_UNION     msg;
 }LTE_FDD_ENB_MESSAGE_STRUCT;
 
+// Ring index padded to a cache line so the producer and consumer
+// indecies never share one
+typedef struct{
+    uint32 idx;
+    uint8  pad[LTE_FDD_ENB_MSGQ_CACHE_LINE_SIZE - sizeof(uint32)];
+}LTE_FDD_ENB_MSGQ_INDEX_STRUCT;
+
+// Ring slot, seq equals the slot's ring index when it is free for
+// that lap and the index plus one once its message is published
+typedef struct{
+    LTE_FDD_ENB_MESSAGE_STRUCT msg;
+    uint32                     seq;
+}LTE_FDD_ENB_MSGQ_SLOT_STRUCT;
+
+typedef struct{
+    uint64 N_sent;
+    uint64 N_dropped;
+    uint32 high_water;
+}LTE_FDD_ENB_MSGQ_STATS_STRUCT;
+
 /*******************************************************************************
                               CLASS DECLARATIONS
 *******************************************************************************/
@@ -377,7 +402,7 @@ template<class class_type, void (class_type::*Func)(LTE_FDD_ENB_MESSAGE_STRUCT&)
 class LTE_fdd_enb_msgq
 {
 public:
-    LTE_fdd_enb_msgq(std::string _msgq_name);
+    LTE_fdd_enb_msgq(std::string _msgq_name, uint32 _size);
     ~LTE_fdd_enb_msgq();
 
     // Setup
@@ -385,28 +410,41 @@ public:
     void attach_rx(LTE_fdd_enb_msgq_cb cb, uint32 _prio);
 
     // Send/Receive
-    void send(LTE_FDD_ENB_MESSAGE_TYPE_ENUM  type,
+    bool send(LTE_FDD_ENB_MESSAGE_TYPE_ENUM  type,
               LTE_FDD_ENB_DEST_LAYER_ENUM    dest_layer,
               LTE_FDD_ENB_MESSAGE_UNION     *msg_content,
               uint32                         msg_content_size);
-    void send(LTE_FDD_ENB_MESSAGE_TYPE_ENUM       type,
+    bool send(LTE_FDD_ENB_MESSAGE_TYPE_ENUM       type,
               LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *dl_sched,
               LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *ul_sched);
-    void send(LTE_FDD_ENB_MESSAGE_STRUCT &msg);
+    bool send(LTE_FDD_ENB_MESSAGE_STRUCT &msg);
+
+    // Statistics
+    void get_stats(LTE_FDD_ENB_MSGQ_STATS_STRUCT *_stats);
 
 private:
     // Send/Receive
+    LTE_FDD_ENB_MSGQ_SLOT_STRUCT* claim_slot(void);
+    void publish_slot(LTE_FDD_ENB_MSGQ_SLOT_STRUCT *slot);
     static void* receive_thread(void *inputs);
 
+    // Ring, producers claim the tail with a compare and swap and the
+    // head is only written by the receive thread
+    LTE_FDD_ENB_MSGQ_INDEX_STRUCT  tail;
+    LTE_FDD_ENB_MSGQ_INDEX_STRUCT  head;
+    LTE_FDD_ENB_MSGQ_SLOT_STRUCT  *ring;
+    uint32                         ring_size;
+    uint32                         ring_mask;
+    uint32                         rx_waiting;
+    int                            rx_efd;
+
     // Variables
-    LTE_fdd_enb_msgq_cb                                 callback;
-    boost::mutex                                        mutex;
-    boost::interprocess::interprocess_semaphore        *sema;
-    boost::circular_buffer<LTE_FDD_ENB_MESSAGE_STRUCT> *circ_buf;
-    std::string                                         msgq_name;
-    pthread_t                                           rx_thread;
-    uint32                                              prio;
-    bool                                                rx_setup;
+    LTE_fdd_enb_msgq_cb            callback;
+    LTE_FDD_ENB_MSGQ_STATS_STRUCT  stats;
+    std::string                    msgq_name;
+    pthread_t                      rx_thread;
+    uint32                         prio;
+    bool                           rx_setup;
 };
 
 #endif /* __LTE_FDD_ENB_MSGQ_H__ */
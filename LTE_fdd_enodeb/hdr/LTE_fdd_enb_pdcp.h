@@ -48,6 +48,9 @@
                               DEFINES
 *******************************************************************************/
 
+// SDUs/PDUs drained from an RB queue per ready message, RLC is signalled
+// once per batch so this must not exceed LTE_FDD_ENB_RLC_MAX_BATCH_SIZE
+#define LTE_FDD_ENB_PDCP_MAX_BATCH_SIZE 16
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
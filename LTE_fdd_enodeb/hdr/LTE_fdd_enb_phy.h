@@ -44,27 +44,37 @@
 *******************************************************************************/
 
 #include "LTE_fdd_enb_interface.h"
+#include "LTE_fdd_enb_buf_pool.h"
 #include "LTE_fdd_enb_cnfg_db.h"
 #include "LTE_fdd_enb_msgq.h"
 #include "LTE_fdd_enb_radio.h"
 #include "liblte_phy.h"
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
 
 /*******************************************************************************
                               DEFINES
 *******************************************************************************/
 
 #define LTE_FDD_ENB_CURRENT_TTI_MAX (LIBLTE_PHY_SFN_MAX*10 + 9)
+#define LTE_FDD_ENB_PHY_MAX_PUSCH_WORKERS 16
+#define LTE_FDD_ENB_PHY_DL_STATIC_RE_MAX 3072 // CRS, PSS, and SSS for 4 antennas at 20MHz
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
 *******************************************************************************/
 
+class LTE_fdd_enb_phy;
 
 /*******************************************************************************
                               TYPEDEFS
 *******************************************************************************/
 
+typedef struct{
+    LTE_fdd_enb_phy   *phy;
+    LIBLTE_PHY_STRUCT *phy_struct;
+    pthread_t          thread;
+}LTE_FDD_ENB_PHY_PUSCH_WORKER_STRUCT;
 
 /*******************************************************************************
                               CLASS DECLARATIONS
@@ -110,32 +120,60 @@ private:
     // Downlink
     void handle_phy_schedule(LTE_FDD_ENB_PHY_SCHEDULE_MSG_STRUCT *phy_sched);
     void process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf);
-    boost::mutex                       sys_info_mutex;
-    boost::mutex                       dl_sched_mutex;
-    boost::mutex                       ul_sched_mutex;
-    LTE_FDD_ENB_SYS_INFO_STRUCT        sys_info;
-    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT dl_schedule[10];
-    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT ul_schedule[10];
-    LIBLTE_PHY_PCFICH_STRUCT           pcfich;
-    LIBLTE_PHY_PHICH_STRUCT            phich[10];
-    LIBLTE_PHY_PDCCH_STRUCT            pdcch;
-    LIBLTE_PHY_SUBFRAME_STRUCT         dl_subframe;
-    LIBLTE_BIT_MSG_STRUCT              dl_rrc_msg;
-    uint32                             dl_current_tti;
-    uint32                             last_rts_current_tti;
-    bool                               late_subfr;
+    void build_dl_static_content(void);
+    void mark_dl_dirty(uint32 first_symb, uint32 last_symb, uint32 start_sc, uint32 end_sc);
+    boost::mutex                        sys_info_mutex;
+    boost::mutex                        dl_sched_mutex;
+    boost::mutex                        ul_sched_mutex;
+    LTE_FDD_ENB_SYS_INFO_STRUCT         sys_info;
+    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *dl_schedule[10];
+    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *ul_schedule[10];
+    LIBLTE_PHY_PCFICH_STRUCT            pcfich;
+    LIBLTE_PHY_PHICH_STRUCT             phich[10];
+    LIBLTE_PHY_PDCCH_STRUCT             pdcch;
+    LIBLTE_PHY_SUBFRAME_STRUCT          dl_subframe;
+    LIBLTE_BIT_MSG_STRUCT               dl_rrc_msg;
+    uint32                              dl_current_tti;
+    uint32                              last_rts_current_tti;
+    bool                                late_subfr;
+
+    // Static downlink content, PSS, SSS, and CRS per subframe number
+    float                               dl_static_re[10][LTE_FDD_ENB_PHY_DL_STATIC_RE_MAX];
+    float                               dl_static_im[10][LTE_FDD_ENB_PHY_DL_STATIC_RE_MAX];
+    uint32                              dl_static_idx[10][LTE_FDD_ENB_PHY_DL_STATIC_RE_MAX];
+    uint32                              dl_static_N_re[10];
+    uint32                              dl_static_N_id_cell;
+    uint32                              dl_static_N_ant;
+    uint32                              dl_dirty_start[14];
+    uint32                              dl_dirty_end[14];
+    uint32                              dl_mib_sfn_div_4;
 
     // Uplink
     void process_ul(LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf);
     LTE_FDD_ENB_PRACH_DECODE_MSG_STRUCT prach_decode;
     LTE_FDD_ENB_PUCCH_DECODE_MSG_STRUCT pucch_decode;
-    LTE_FDD_ENB_PUSCH_DECODE_MSG_STRUCT pusch_decode;
     LIBLTE_PHY_SUBFRAME_STRUCT          ul_subframe;
     uint32                              ul_current_tti;
     uint32                              prach_sfn_mod;
     uint32                              prach_subfn_mod;
     uint32                              prach_subfn_check;
     bool                                prach_subfn_zero_allowed;
+
+    // PUSCH decode workers
+    static void* pusch_worker_thread_func(void *inputs);
+    void decode_pusch(LIBLTE_PHY_STRUCT *ws);
+    LTE_FDD_ENB_PHY_PUSCH_WORKER_STRUCT pusch_worker[LTE_FDD_ENB_PHY_MAX_PUSCH_WORKERS];
+    LTE_FDD_ENB_PUSCH_DECODE_MSG_STRUCT pusch_decode[LIBLTE_PHY_PDCCH_MAX_ALLOC];
+    boost::mutex                        pusch_mutex;
+    boost::condition_variable           pusch_start_cond;
+    boost::condition_variable           pusch_done_cond;
+    uint32                              N_pusch_workers;
+    uint32                              pusch_job_id;
+    uint32                              pusch_N_alloc;
+    uint32                              pusch_next_alloc;
+    uint32                              pusch_N_done;
+    bool                                pusch_decode_pass[LIBLTE_PHY_PDCCH_MAX_ALLOC];
+    bool                                pusch_workers_running;
 };
 
 #endif /* __LTE_FDD_ENB_PHY_H__ */
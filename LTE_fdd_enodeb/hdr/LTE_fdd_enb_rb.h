@@ -56,15 +56,16 @@
 *******************************************************************************/
 
 #include "LTE_fdd_enb_common.h"
+#include "LTE_fdd_enb_rb_queue.h"
 #include "liblte_rlc.h"
 #include "liblte_rrc.h"
-#include <list>
-#include <boost/thread/mutex.hpp>
+#include <map>
 
 /*******************************************************************************
                               DEFINES
 *******************************************************************************/
 
+#define LTE_FDD_ENB_RB_QUEUE_SIZE 128
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -232,12 +233,18 @@ public:
     void queue_pdcp_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu);
     LTE_FDD_ENB_ERROR_ENUM get_next_pdcp_pdu(LIBLTE_BYTE_MSG_STRUCT **pdu);
     LTE_FDD_ENB_ERROR_ENUM delete_next_pdcp_pdu(void);
+    uint32 get_next_pdcp_pdus(LIBLTE_BYTE_MSG_STRUCT **pdu, uint32 N_max);
+    uint32 delete_next_pdcp_pdus(uint32 N_max);
     void queue_pdcp_sdu(LIBLTE_BIT_MSG_STRUCT *sdu);
     LTE_FDD_ENB_ERROR_ENUM get_next_pdcp_sdu(LIBLTE_BIT_MSG_STRUCT **sdu);
     LTE_FDD_ENB_ERROR_ENUM delete_next_pdcp_sdu(void);
+    uint32 get_next_pdcp_sdus(LIBLTE_BIT_MSG_STRUCT **sdu, uint32 N_max);
+    uint32 delete_next_pdcp_sdus(uint32 N_max);
     void queue_pdcp_data_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu);
     LTE_FDD_ENB_ERROR_ENUM get_next_pdcp_data_sdu(LIBLTE_BYTE_MSG_STRUCT **sdu);
     LTE_FDD_ENB_ERROR_ENUM delete_next_pdcp_data_sdu(void);
+    uint32 get_next_pdcp_data_sdus(LIBLTE_BYTE_MSG_STRUCT **sdu, uint32 N_max);
+    uint32 delete_next_pdcp_data_sdus(uint32 N_max);
     void set_pdcp_config(LTE_FDD_ENB_PDCP_CONFIG_ENUM config);
     LTE_FDD_ENB_PDCP_CONFIG_ENUM get_pdcp_config(void);
     uint32 get_pdcp_rx_count(void);
@@ -249,9 +256,13 @@ public:
     void queue_rlc_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu);
     LTE_FDD_ENB_ERROR_ENUM get_next_rlc_pdu(LIBLTE_BYTE_MSG_STRUCT **pdu);
     LTE_FDD_ENB_ERROR_ENUM delete_next_rlc_pdu(void);
+    uint32 get_next_rlc_pdus(LIBLTE_BYTE_MSG_STRUCT **pdu, uint32 N_max);
+    uint32 delete_next_rlc_pdus(uint32 N_max);
     void queue_rlc_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu);
     LTE_FDD_ENB_ERROR_ENUM get_next_rlc_sdu(LIBLTE_BYTE_MSG_STRUCT **sdu);
     LTE_FDD_ENB_ERROR_ENUM delete_next_rlc_sdu(void);
+    uint32 get_next_rlc_sdus(LIBLTE_BYTE_MSG_STRUCT **sdu, uint32 N_max);
+    uint32 delete_next_rlc_sdus(uint32 N_max);
     LTE_FDD_ENB_RLC_CONFIG_ENUM get_rlc_config(void);
     uint16 get_rlc_vrr(void);
     void set_rlc_vrr(uint16 vrr);
@@ -286,6 +297,9 @@ public:
     void queue_mac_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu);
     LTE_FDD_ENB_ERROR_ENUM get_next_mac_sdu(LIBLTE_BYTE_MSG_STRUCT **sdu);
     LTE_FDD_ENB_ERROR_ENUM delete_next_mac_sdu(void);
+    uint32 get_next_mac_sdus(LIBLTE_BYTE_MSG_STRUCT **sdu, uint32 N_max);
+    uint32 delete_next_mac_sdus(uint32 N_max);
+    uint32 get_mac_sdu_queue_bytes(void);
     LTE_FDD_ENB_MAC_CONFIG_ENUM get_mac_config(void);
     void set_last_tti(uint32 last_tti);
     uint32 get_last_tti(void);
@@ -310,40 +324,31 @@ private:
     LTE_fdd_enb_user    *user;
 
     // GW
-    boost::mutex                        gw_data_msg_queue_mutex;
-    std::list<LIBLTE_BYTE_MSG_STRUCT *> gw_data_msg_queue;
+    LTE_fdd_enb_rb_queue *gw_data_msg_queue;
 
     // MME
-    boost::mutex                        mme_nas_msg_queue_mutex;
-    std::list<LIBLTE_BYTE_MSG_STRUCT *> mme_nas_msg_queue;
-    LTE_FDD_ENB_MME_PROC_ENUM           mme_procedure;
-    LTE_FDD_ENB_MME_STATE_ENUM          mme_state;
+    LTE_fdd_enb_rb_queue       *mme_nas_msg_queue;
+    LTE_FDD_ENB_MME_PROC_ENUM   mme_procedure;
+    LTE_FDD_ENB_MME_STATE_ENUM  mme_state;
 
     // RRC
-    boost::mutex                        rrc_pdu_queue_mutex;
-    boost::mutex                        rrc_nas_msg_queue_mutex;
-    std::list<LIBLTE_BIT_MSG_STRUCT *>  rrc_pdu_queue;
-    std::list<LIBLTE_BYTE_MSG_STRUCT *> rrc_nas_msg_queue;
-    LTE_FDD_ENB_RRC_PROC_ENUM           rrc_procedure;
-    LTE_FDD_ENB_RRC_STATE_ENUM          rrc_state;
-    uint8                               rrc_transaction_id;
+    LTE_fdd_enb_rb_queue       *rrc_pdu_queue;
+    LTE_fdd_enb_rb_queue       *rrc_nas_msg_queue;
+    LTE_FDD_ENB_RRC_PROC_ENUM   rrc_procedure;
+    LTE_FDD_ENB_RRC_STATE_ENUM  rrc_state;
+    uint8                       rrc_transaction_id;
 
     // PDCP
-    boost::mutex                        pdcp_pdu_queue_mutex;
-    boost::mutex                        pdcp_sdu_queue_mutex;
-    boost::mutex                        pdcp_data_sdu_queue_mutex;
-    std::list<LIBLTE_BYTE_MSG_STRUCT *> pdcp_pdu_queue;
-    std::list<LIBLTE_BIT_MSG_STRUCT *>  pdcp_sdu_queue;
-    std::list<LIBLTE_BYTE_MSG_STRUCT *> pdcp_data_sdu_queue;
-    LTE_FDD_ENB_PDCP_CONFIG_ENUM        pdcp_config;
-    uint32                              pdcp_rx_count;
-    uint32                              pdcp_tx_count;
+    LTE_fdd_enb_rb_queue         *pdcp_pdu_queue;
+    LTE_fdd_enb_rb_queue         *pdcp_sdu_queue;
+    LTE_fdd_enb_rb_queue         *pdcp_data_sdu_queue;
+    LTE_FDD_ENB_PDCP_CONFIG_ENUM  pdcp_config;
+    uint32                        pdcp_rx_count;
+    uint32                        pdcp_tx_count;
 
     // RLC
-    boost::mutex                                  rlc_pdu_queue_mutex;
-    boost::mutex                                  rlc_sdu_queue_mutex;
-    std::list<LIBLTE_BYTE_MSG_STRUCT *>           rlc_pdu_queue;
-    std::list<LIBLTE_BYTE_MSG_STRUCT *>           rlc_sdu_queue;
+    LTE_fdd_enb_rb_queue                         *rlc_pdu_queue;
+    LTE_fdd_enb_rb_queue                         *rlc_sdu_queue;
     std::map<uint16, LIBLTE_RLC_AMD_PDU_STRUCT *> rlc_am_reception_buffer;
     std::map<uint16, LIBLTE_RLC_AMD_PDU_STRUCT *> rlc_am_transmission_buffer;
     std::map<uint16, LIBLTE_BYTE_MSG_STRUCT *>    rlc_um_reception_buffer;
@@ -362,12 +367,11 @@ private:
     uint16                                        rlc_vtus;
 
     // MAC
-    boost::mutex                        mac_sdu_queue_mutex;
-    std::list<LIBLTE_BYTE_MSG_STRUCT *> mac_sdu_queue;
-    LTE_FDD_ENB_MAC_CONFIG_ENUM         mac_config;
-    uint64                              mac_con_res_id;
-    uint32                              mac_last_tti;
-    uint32                              t_poll_retransmit_timer_id;
+    LTE_fdd_enb_rb_queue        *mac_sdu_queue;
+    LTE_FDD_ENB_MAC_CONFIG_ENUM  mac_config;
+    uint64                       mac_con_res_id;
+    uint32                       mac_last_tti;
+    uint32                       t_poll_retransmit_timer_id;
     bool                                mac_send_con_res_id;
 
     // DRB
@@ -377,12 +381,12 @@ private:
     uint8  log_chan_group;
 
     // Generic
-    void queue_msg(LIBLTE_BIT_MSG_STRUCT *msg, boost::mutex *mutex, std::list<LIBLTE_BIT_MSG_STRUCT *> *queue);
-    void queue_msg(LIBLTE_BYTE_MSG_STRUCT *msg, boost::mutex *mutex, std::list<LIBLTE_BYTE_MSG_STRUCT *> *queue);
-    LTE_FDD_ENB_ERROR_ENUM get_next_msg(boost::mutex *mutex, std::list<LIBLTE_BIT_MSG_STRUCT *> *queue, LIBLTE_BIT_MSG_STRUCT **msg);
-    LTE_FDD_ENB_ERROR_ENUM get_next_msg(boost::mutex *mutex, std::list<LIBLTE_BYTE_MSG_STRUCT *> *queue, LIBLTE_BYTE_MSG_STRUCT **msg);
-    LTE_FDD_ENB_ERROR_ENUM delete_next_msg(boost::mutex *mutex, std::list<LIBLTE_BIT_MSG_STRUCT *> *queue);
-    LTE_FDD_ENB_ERROR_ENUM delete_next_msg(boost::mutex *mutex, std::list<LIBLTE_BYTE_MSG_STRUCT *> *queue);
+    void queue_msg(LIBLTE_BIT_MSG_STRUCT *msg, LTE_fdd_enb_rb_queue *queue);
+    void queue_msg(LIBLTE_BYTE_MSG_STRUCT *msg, LTE_fdd_enb_rb_queue *queue);
+    LTE_FDD_ENB_ERROR_ENUM get_next_msg(LTE_fdd_enb_rb_queue *queue, LIBLTE_BIT_MSG_STRUCT **msg);
+    LTE_FDD_ENB_ERROR_ENUM get_next_msg(LTE_fdd_enb_rb_queue *queue, LIBLTE_BYTE_MSG_STRUCT **msg);
+    LTE_FDD_ENB_ERROR_ENUM delete_next_msg(LTE_fdd_enb_rb_queue *queue);
+    void report_queue_full(LTE_fdd_enb_rb_queue *queue);
 };
 
 #endif /* __LTE_FDD_ENB_RB_H__ */
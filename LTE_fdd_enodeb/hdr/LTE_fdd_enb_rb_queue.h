@@ -0,0 +1,99 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_rb_queue.h
+
+    Description: Contains all the definitions for the LTE FDD eNodeB
+                 radio bearer message queue.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/18/2026    agent            Created file
+
+*******************************************************************************/
+
+#ifndef __LTE_FDD_ENB_RB_QUEUE_H__
+#define __LTE_FDD_ENB_RB_QUEUE_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "typedefs.h"
+#include <boost/thread/mutex.hpp>
+#include <string>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef struct{
+    void   *msg;
+    uint32  N_bytes;
+}LTE_FDD_ENB_RB_QUEUE_ENTRY_STRUCT;
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+// Bounded ring of LTE_fdd_enb_buf_pool buffers.  The queue owns every
+// buffer pushed to it and returns them to their pools when they are popped
+// or when the queue is destroyed.
+class LTE_fdd_enb_rb_queue
+{
+public:
+    // Constructor/Destructor
+    LTE_fdd_enb_rb_queue(std::string _queue_name, uint32 _size);
+    ~LTE_fdd_enb_rb_queue();
+
+    // Push/Peek/Pop
+    bool push(void *msg, uint32 msg_bytes);
+    void* peek(void);
+    uint32 peek_many(void **msgs, uint32 N_max);
+    bool pop(void);
+    uint32 pop_many(uint32 N_max);
+
+    // Status
+    std::string get_queue_name(void);
+    uint32 get_N_msgs(void);
+    uint32 get_N_bytes(void);
+
+private:
+    // Ring
+    boost::mutex                       mutex;
+    LTE_FDD_ENB_RB_QUEUE_ENTRY_STRUCT *ring;
+    std::string                        queue_name;
+    uint32                             ring_size;
+    uint32                             ring_mask;
+    uint32                             head;
+    uint32                             N_msgs;
+    uint32                             N_bytes;
+};
+
+#endif /* __LTE_FDD_ENB_RB_QUEUE_H__ */
@@ -50,6 +50,8 @@
                               DEFINES
 *******************************************************************************/
 
+// SDUs/PDUs drained from an RB queue per ready message
+#define LTE_FDD_ENB_RLC_MAX_BATCH_SIZE 16
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -20,7 +20,7 @@
     File: LTE_fdd_enb_timer.h
 
     Description: Contains all the definitions for the LTE FDD eNodeB
-                 timer class.
+                 timer callback.
 
     Revision History
     ----------    -------------    --------------------------------------------
@@ -77,25 +77,4 @@ template<class class_type, void (class_type::*Func)(uint32)>
     return (static_cast<class_type*>(o)->*Func)(id);
 }
 
-class LTE_fdd_enb_timer
-{
-public:
-    // Constructor/Destructor
-    LTE_fdd_enb_timer(uint32 m_seconds, uint32 _id, LTE_fdd_enb_timer_cb _cb);
-    ~LTE_fdd_enb_timer();
-
-    // External interface
-    void reset(void);
-    void increment(void);
-    bool expired(void);
-    void call_callback(void);
-
-private:
-    // Identity
-    LTE_fdd_enb_timer_cb cb;
-    uint32               id;
-    uint32               expiry_m_seconds;
-    uint32               current_m_seconds;
-};
-
 #endif /* __LTE_FDD_ENB_TIMER_H__ */
@@ -43,6 +43,7 @@
 #include "LTE_fdd_enb_timer.h"
 #include "LTE_fdd_enb_msgq.h"
 #include <boost/thread/mutex.hpp>
+#include <vector>
 
 /*******************************************************************************
                               DEFINES
@@ -50,6 +51,22 @@
 
 #define LTE_FDD_ENB_INVALID_TIMER_ID 0xFFFFFFFF
 
+// Timing wheel, 1ms slots in the first level and four coarser levels
+// above it, enough to hold any 32 bit expiry
+#define LTE_FDD_ENB_TIMER_WHEEL_L0_BITS  8
+#define LTE_FDD_ENB_TIMER_WHEEL_L0_SIZE  (1 << LTE_FDD_ENB_TIMER_WHEEL_L0_BITS)
+#define LTE_FDD_ENB_TIMER_WHEEL_L0_MASK  (LTE_FDD_ENB_TIMER_WHEEL_L0_SIZE - 1)
+#define LTE_FDD_ENB_TIMER_WHEEL_LN_BITS  6
+#define LTE_FDD_ENB_TIMER_WHEEL_LN_SIZE  (1 << LTE_FDD_ENB_TIMER_WHEEL_LN_BITS)
+#define LTE_FDD_ENB_TIMER_WHEEL_LN_MASK  (LTE_FDD_ENB_TIMER_WHEEL_LN_SIZE - 1)
+#define LTE_FDD_ENB_TIMER_WHEEL_N_LEVELS 5
+
+// Timer ids are the index of the pooled timer plus a sequence number in
+// the upper bits, so a stale id can not stop or reset a reused timer
+#define LTE_FDD_ENB_TIMER_INDEX_BITS 20
+#define LTE_FDD_ENB_TIMER_INDEX_MASK ((1 << LTE_FDD_ENB_TIMER_INDEX_BITS) - 1)
+#define LTE_FDD_ENB_TIMER_MAX_TIMERS (1 << LTE_FDD_ENB_TIMER_INDEX_BITS)
+
 /*******************************************************************************
                               FORWARD DECLARATIONS
 *******************************************************************************/
@@ -59,6 +76,22 @@
                               TYPEDEFS
 *******************************************************************************/
 
+typedef enum{
+    LTE_FDD_ENB_TIMER_STATE_FREE = 0,
+    LTE_FDD_ENB_TIMER_STATE_RUNNING,
+    LTE_FDD_ENB_TIMER_STATE_EXPIRED,
+}LTE_FDD_ENB_TIMER_STATE_ENUM;
+
+typedef struct LTE_FDD_ENB_TIMER_STRUCT{
+    LTE_fdd_enb_timer_cb              cb;
+    struct LTE_FDD_ENB_TIMER_STRUCT  *next;
+    struct LTE_FDD_ENB_TIMER_STRUCT  *prev;
+    struct LTE_FDD_ENB_TIMER_STRUCT **slot;
+    LTE_FDD_ENB_TIMER_STATE_ENUM      state;
+    uint32                            id;
+    uint32                            m_seconds;
+    uint32                            expiry_tick;
+}LTE_FDD_ENB_TIMER_STRUCT;
 
 /*******************************************************************************
                               CLASS DECLARATIONS
@@ -97,9 +130,21 @@ private:
     LTE_fdd_enb_msgq *msgq_from_mac;
 
     // Timer Storage
-    boost::mutex                         timer_mutex;
-    std::map<uint32, LTE_fdd_enb_timer*> timer_map;
-    uint32                               next_timer_id;
+    LTE_FDD_ENB_TIMER_STRUCT* alloc_timer(void);
+    void free_timer(LTE_FDD_ENB_TIMER_STRUCT *timer);
+    LTE_FDD_ENB_TIMER_STRUCT* find_timer(uint32 timer_id);
+    boost::mutex                            timer_mutex;
+    std::vector<LTE_FDD_ENB_TIMER_STRUCT *> timer_pool;
+    std::vector<LTE_FDD_ENB_TIMER_STRUCT *> expired_timers;
+    LTE_FDD_ENB_TIMER_STRUCT               *free_timers;
+
+    // Timing Wheel
+    void add_to_wheel(LTE_FDD_ENB_TIMER_STRUCT *timer);
+    void remove_from_wheel(LTE_FDD_ENB_TIMER_STRUCT *timer);
+    uint32 cascade(uint32 level);
+    LTE_FDD_ENB_TIMER_STRUCT *wheel_l0[LTE_FDD_ENB_TIMER_WHEEL_L0_SIZE];
+    LTE_FDD_ENB_TIMER_STRUCT *wheel_ln[LTE_FDD_ENB_TIMER_WHEEL_N_LEVELS-1][LTE_FDD_ENB_TIMER_WHEEL_LN_SIZE];
+    uint32                    current_tick;
 };
 
 #endif /* __LTE_FDD_ENB_TIMER_MGR_H__ */
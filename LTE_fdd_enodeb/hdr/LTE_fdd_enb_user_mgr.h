@@ -45,6 +45,7 @@
 #include "LTE_fdd_enb_interface.h"
 #include "LTE_fdd_enb_user.h"
 #include <boost/thread/mutex.hpp>
+#include <list>
 #include <string>
 
 /*******************************************************************************
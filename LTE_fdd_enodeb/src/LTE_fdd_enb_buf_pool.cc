@@ -0,0 +1,347 @@
+#line 2 "LTE_fdd_enb_buf_pool.cc" // Make __FILE__ omit the path
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_buf_pool.cc
+
+    Description: Contains all the implementations for the LTE FDD eNodeB
+                 reference counted buffer pool.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/18/2026    agent            Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_buf_pool.h"
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define LTE_FDD_ENB_BUF_HDR_SIZE ((sizeof(LTE_FDD_ENB_BUF_HDR_STRUCT) + LTE_FDD_ENB_BUF_POOL_ALIGN - 1) & \
+                                  ~(LTE_FDD_ENB_BUF_POOL_ALIGN - 1))
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+// Thread caches are indexed by a slot claimed from buf_pool_cache_slots, a
+// pool_id mismatch means the slot was left behind by a destroyed pool
+static __thread LTE_FDD_ENB_BUF_POOL_CACHE_STRUCT buf_pool_cache[LTE_FDD_ENB_BUF_POOL_MAX_CACHES];
+static uint32                                     buf_pool_cache_slots = 0;
+static uint32                                     buf_pool_next_id     = 0;
+
+// Owner of each cache slot, used to flush a thread's caches when it exits
+static LTE_fdd_enb_buf_pool *buf_pool_cache_owner[LTE_FDD_ENB_BUF_POOL_MAX_CACHES];
+static boost::mutex          buf_pool_cache_owner_mutex;
+static pthread_key_t         buf_pool_cache_key;
+static pthread_once_t        buf_pool_cache_key_once = PTHREAD_ONCE_INIT;
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+/********************************/
+/*    Constructor/Destructor    */
+/********************************/
+LTE_fdd_enb_buf_pool::LTE_fdd_enb_buf_pool(std::string _pool_name,
+                                           uint32      _buf_size,
+                                           uint32      _N_bufs,
+                                           bool        _thread_cache)
+{
+    uint32 i;
+
+    // Every buffer is preallocated here, nothing is allocated afterwards
+    stride      = LTE_FDD_ENB_BUF_HDR_SIZE + ((_buf_size + LTE_FDD_ENB_BUF_POOL_ALIGN - 1) &
+                                              ~(LTE_FDD_ENB_BUF_POOL_ALIGN - 1));
+    N_bufs      = _N_bufs;
+    mem         = new uint8[(uint64)stride*N_bufs + LTE_FDD_ENB_BUF_POOL_ALIGN];
+    mem_aligned = (uint8 *)((((uintptr_t)mem) + LTE_FDD_ENB_BUF_POOL_ALIGN - 1) &
+                            ~((uintptr_t)LTE_FDD_ENB_BUF_POOL_ALIGN - 1));
+    free_list   = NULL;
+    for(i=N_bufs; i>0; i--)
+    {
+        get_hdr(i-1)->pool      = this;
+        get_hdr(i-1)->ref_count = 0;
+        get_hdr(i-1)->next      = free_list;
+        free_list               = get_hdr(i-1);
+    }
+
+    // Thread cache, pools run uncached once all slots are claimed
+    pool_id    = __sync_add_and_fetch(&buf_pool_next_id, 1);
+    cache_slot = -1;
+    if(_thread_cache)
+    {
+        pthread_once(&buf_pool_cache_key_once, create_cache_key);
+        for(i=0; i<LTE_FDD_ENB_BUF_POOL_MAX_CACHES; i++)
+        {
+            if(0 == (__sync_fetch_and_or(&buf_pool_cache_slots, 1U << i) & (1U << i)))
+            {
+                cache_slot = i;
+                buf_pool_cache_owner_mutex.lock();
+                buf_pool_cache_owner[i] = this;
+                buf_pool_cache_owner_mutex.unlock();
+                break;
+            }
+        }
+    }
+
+    pool_name  = _pool_name;
+    N_in_use   = 0;
+    high_water = 0;
+    N_failed   = 0;
+}
+LTE_fdd_enb_buf_pool::~LTE_fdd_enb_buf_pool()
+{
+    if(0 <= cache_slot)
+    {
+        buf_pool_cache_owner_mutex.lock();
+        buf_pool_cache_owner[cache_slot] = NULL;
+        buf_pool_cache_owner_mutex.unlock();
+        __sync_fetch_and_and(&buf_pool_cache_slots, ~(1U << cache_slot));
+    }
+    delete [] mem;
+}
+
+/************************************/
+/*    Allocate/Reference/Release    */
+/************************************/
+void* LTE_fdd_enb_buf_pool::alloc(void)
+{
+    LTE_FDD_ENB_BUF_POOL_CACHE_STRUCT *cache = get_cache();
+    LTE_FDD_ENB_BUF_HDR_STRUCT        *hdr;
+    uint32                             in_use;
+    uint32                             hw;
+    uint32                             i;
+
+    if(NULL != cache)
+    {
+        // Refill half of an empty cache from the shared free list
+        if(NULL == cache->free_list)
+        {
+            mutex.lock();
+            for(i=0; i<LTE_FDD_ENB_BUF_POOL_CACHE_SIZE/2 && NULL != free_list; i++)
+            {
+                hdr              = free_list;
+                free_list        = hdr->next;
+                hdr->next        = cache->free_list;
+                cache->free_list = hdr;
+                cache->N_free++;
+            }
+            mutex.unlock();
+        }
+        hdr = cache->free_list;
+        if(NULL != hdr)
+        {
+            cache->free_list = hdr->next;
+            cache->N_free--;
+        }
+    }else{
+        mutex.lock();
+        hdr = free_list;
+        if(NULL != hdr)
+        {
+            free_list = hdr->next;
+        }
+        mutex.unlock();
+    }
+
+    if(NULL == hdr)
+    {
+        __sync_add_and_fetch(&N_failed, 1);
+        return(NULL);
+    }
+
+    hdr->next      = NULL;
+    hdr->ref_count = 1;
+    in_use         = __sync_add_and_fetch(&N_in_use, 1);
+    hw             = __atomic_load_n(&high_water, __ATOMIC_RELAXED);
+    while(in_use > hw &&
+          !__sync_bool_compare_and_swap(&high_water, hw, in_use))
+    {
+        hw = __atomic_load_n(&high_water, __ATOMIC_RELAXED);
+    }
+
+    return((uint8 *)hdr + LTE_FDD_ENB_BUF_HDR_SIZE);
+}
+void LTE_fdd_enb_buf_pool::ref(void *buf)
+{
+    LTE_FDD_ENB_BUF_HDR_STRUCT *hdr;
+
+    if(NULL != buf)
+    {
+        hdr = (LTE_FDD_ENB_BUF_HDR_STRUCT *)((uint8 *)buf - LTE_FDD_ENB_BUF_HDR_SIZE);
+        __sync_add_and_fetch(&hdr->ref_count, 1);
+    }
+}
+void LTE_fdd_enb_buf_pool::release(void *buf)
+{
+    LTE_FDD_ENB_BUF_HDR_STRUCT *hdr;
+
+    if(NULL != buf)
+    {
+        hdr = (LTE_FDD_ENB_BUF_HDR_STRUCT *)((uint8 *)buf - LTE_FDD_ENB_BUF_HDR_SIZE);
+        if(0 == __sync_sub_and_fetch(&hdr->ref_count, 1))
+        {
+            hdr->pool->free_buf(hdr);
+        }
+    }
+}
+
+/********************/
+/*    Statistics    */
+/********************/
+std::string LTE_fdd_enb_buf_pool::get_pool_name(void)
+{
+    return(pool_name);
+}
+uint32 LTE_fdd_enb_buf_pool::get_N_bufs(void)
+{
+    return(N_bufs);
+}
+uint32 LTE_fdd_enb_buf_pool::get_N_in_use(void)
+{
+    return(__atomic_load_n(&N_in_use, __ATOMIC_RELAXED));
+}
+uint32 LTE_fdd_enb_buf_pool::get_high_water(void)
+{
+    return(__atomic_load_n(&high_water, __ATOMIC_RELAXED));
+}
+uint32 LTE_fdd_enb_buf_pool::get_N_failed(void)
+{
+    return(__atomic_load_n(&N_failed, __ATOMIC_RELAXED));
+}
+
+/*****************/
+/*    Buffers    */
+/*****************/
+LTE_FDD_ENB_BUF_HDR_STRUCT* LTE_fdd_enb_buf_pool::get_hdr(uint32 idx)
+{
+    return((LTE_FDD_ENB_BUF_HDR_STRUCT *)&mem_aligned[(uint64)idx*stride]);
+}
+void LTE_fdd_enb_buf_pool::free_buf(LTE_FDD_ENB_BUF_HDR_STRUCT *hdr)
+{
+    LTE_FDD_ENB_BUF_POOL_CACHE_STRUCT *cache = get_cache();
+    LTE_FDD_ENB_BUF_HDR_STRUCT        *tmp;
+    uint32                             i;
+
+    __sync_sub_and_fetch(&N_in_use, 1);
+
+    if(NULL != cache)
+    {
+        // Return half of a full cache to the shared free list
+        if(LTE_FDD_ENB_BUF_POOL_CACHE_SIZE <= cache->N_free)
+        {
+            mutex.lock();
+            for(i=0; i<LTE_FDD_ENB_BUF_POOL_CACHE_SIZE/2; i++)
+            {
+                tmp              = cache->free_list;
+                cache->free_list = tmp->next;
+                tmp->next        = free_list;
+                free_list        = tmp;
+                cache->N_free--;
+            }
+            mutex.unlock();
+        }
+        hdr->next        = cache->free_list;
+        cache->free_list = hdr;
+        cache->N_free++;
+    }else{
+        mutex.lock();
+        hdr->next = free_list;
+        free_list = hdr;
+        mutex.unlock();
+    }
+}
+
+/**********************/
+/*    Thread Cache    */
+/**********************/
+LTE_FDD_ENB_BUF_POOL_CACHE_STRUCT* LTE_fdd_enb_buf_pool::get_cache(void)
+{
+    LTE_FDD_ENB_BUF_POOL_CACHE_STRUCT *cache;
+
+    if(0 > cache_slot)
+    {
+        return(NULL);
+    }
+
+    // Buffers cached for a previous owner of the slot went with its memory
+    cache = &buf_pool_cache[cache_slot];
+    if(pool_id != cache->pool_id)
+    {
+        cache->free_list = NULL;
+        cache->pool_id   = pool_id;
+        cache->N_free    = 0;
+
+        // Key destructors only run for threads with a non NULL value
+        pthread_setspecific(buf_pool_cache_key, buf_pool_cache);
+    }
+
+    return(cache);
+}
+void LTE_fdd_enb_buf_pool::flush_cache(LTE_FDD_ENB_BUF_POOL_CACHE_STRUCT *cache)
+{
+    LTE_FDD_ENB_BUF_HDR_STRUCT *tmp;
+
+    mutex.lock();
+    while(NULL != cache->free_list)
+    {
+        tmp              = cache->free_list;
+        cache->free_list = tmp->next;
+        tmp->next        = free_list;
+        free_list        = tmp;
+    }
+    cache->N_free = 0;
+    mutex.unlock();
+}
+void LTE_fdd_enb_buf_pool::create_cache_key(void)
+{
+    pthread_key_create(&buf_pool_cache_key, handle_thread_exit);
+}
+void LTE_fdd_enb_buf_pool::handle_thread_exit(void *arg)
+{
+    LTE_FDD_ENB_BUF_POOL_CACHE_STRUCT *cache = (LTE_FDD_ENB_BUF_POOL_CACHE_STRUCT *)arg;
+    uint32                             i;
+
+    // Hand the exiting thread's cached buffers back to their pools, slots
+    // whose pool has since been destroyed are skipped
+    buf_pool_cache_owner_mutex.lock();
+    for(i=0; i<LTE_FDD_ENB_BUF_POOL_MAX_CACHES; i++)
+    {
+        if(NULL                    != buf_pool_cache_owner[i] &&
+           cache[i].pool_id        == buf_pool_cache_owner[i]->pool_id &&
+           NULL                    != cache[i].free_list)
+        {
+            buf_pool_cache_owner[i]->flush_cache(&cache[i]);
+        }
+        cache[i].pool_id = 0;
+    }
+    buf_pool_cache_owner_mutex.unlock();
+}
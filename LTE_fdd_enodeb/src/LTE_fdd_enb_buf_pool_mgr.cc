@@ -0,0 +1,202 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_buf_pool_mgr.cc
+
+    Description: Contains all the implementations for the LTE FDD eNodeB
+                 buffer pool manager.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/18/2026    agent            Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_buf_pool_mgr.h"
+#include "LTE_fdd_enb_cnfg_db.h"
+#include "LTE_fdd_enb_mac.h"
+#include "liblte_rlc.h"
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+LTE_fdd_enb_buf_pool_mgr* LTE_fdd_enb_buf_pool_mgr::instance = NULL;
+boost::mutex              buf_pool_mgr_instance_mutex;
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+/*******************/
+/*    Singleton    */
+/*******************/
+LTE_fdd_enb_buf_pool_mgr* LTE_fdd_enb_buf_pool_mgr::get_instance(void)
+{
+    boost::mutex::scoped_lock lock(buf_pool_mgr_instance_mutex);
+
+    if(NULL == instance)
+    {
+        instance = new LTE_fdd_enb_buf_pool_mgr();
+    }
+
+    return(instance);
+}
+void LTE_fdd_enb_buf_pool_mgr::cleanup(void)
+{
+    boost::mutex::scoped_lock lock(buf_pool_mgr_instance_mutex);
+
+    if(NULL != instance)
+    {
+        delete instance;
+        instance = NULL;
+    }
+}
+
+/********************************/
+/*    Constructor/Destructor    */
+/********************************/
+LTE_fdd_enb_buf_pool_mgr::LTE_fdd_enb_buf_pool_mgr()
+{
+    uint32 i;
+
+    started = false;
+    for(i=0; i<LTE_FDD_ENB_BUF_POOL_N_ITEMS; i++)
+    {
+        pool[i] = NULL;
+    }
+}
+LTE_fdd_enb_buf_pool_mgr::~LTE_fdd_enb_buf_pool_mgr()
+{
+    uint32 i;
+
+    for(i=0; i<LTE_FDD_ENB_BUF_POOL_N_ITEMS; i++)
+    {
+        delete pool[i];
+    }
+}
+
+/***************/
+/*    Start    */
+/***************/
+void LTE_fdd_enb_buf_pool_mgr::start(void)
+{
+    boost::mutex::scoped_lock  lock(start_mutex);
+    LTE_fdd_enb_cnfg_db       *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
+    int64                      msg_pool_size;
+    int64                      rlc_pdu_pool_size;
+    int64                      sched_pool_size;
+
+    // Buffers outlive a stop, since users and their radio bearers do, so
+    // the pools are only sized on the first start
+    if(!started)
+    {
+        started = true;
+
+        cnfg_db->get_param(LTE_FDD_ENB_PARAM_MSG_POOL_SIZE, msg_pool_size);
+        cnfg_db->get_param(LTE_FDD_ENB_PARAM_RLC_PDU_POOL_SIZE, rlc_pdu_pool_size);
+        cnfg_db->get_param(LTE_FDD_ENB_PARAM_SCHED_POOL_SIZE, sched_pool_size);
+
+        pool[LTE_FDD_ENB_BUF_POOL_BIT_MSG]          = new LTE_fdd_enb_buf_pool(LTE_fdd_enb_buf_pool_text[LTE_FDD_ENB_BUF_POOL_BIT_MSG],
+                                                                               sizeof(LIBLTE_BIT_MSG_STRUCT),
+                                                                               msg_pool_size,
+                                                                               true);
+        pool[LTE_FDD_ENB_BUF_POOL_BYTE_MSG]         = new LTE_fdd_enb_buf_pool(LTE_fdd_enb_buf_pool_text[LTE_FDD_ENB_BUF_POOL_BYTE_MSG],
+                                                                               sizeof(LIBLTE_BYTE_MSG_STRUCT),
+                                                                               msg_pool_size,
+                                                                               true);
+        pool[LTE_FDD_ENB_BUF_POOL_RLC_AMD_PDU]      = new LTE_fdd_enb_buf_pool(LTE_fdd_enb_buf_pool_text[LTE_FDD_ENB_BUF_POOL_RLC_AMD_PDU],
+                                                                               sizeof(LIBLTE_RLC_AMD_PDU_STRUCT),
+                                                                               rlc_pdu_pool_size,
+                                                                               true);
+        pool[LTE_FDD_ENB_BUF_POOL_RAR_SCHED_QUEUE]  = new LTE_fdd_enb_buf_pool(LTE_fdd_enb_buf_pool_text[LTE_FDD_ENB_BUF_POOL_RAR_SCHED_QUEUE],
+                                                                               sizeof(LTE_FDD_ENB_RAR_SCHED_QUEUE_STRUCT),
+                                                                               sched_pool_size,
+                                                                               true);
+        pool[LTE_FDD_ENB_BUF_POOL_DL_SCHED_QUEUE]   = new LTE_fdd_enb_buf_pool(LTE_fdd_enb_buf_pool_text[LTE_FDD_ENB_BUF_POOL_DL_SCHED_QUEUE],
+                                                                               sizeof(LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT),
+                                                                               sched_pool_size,
+                                                                               true);
+        pool[LTE_FDD_ENB_BUF_POOL_UL_SCHED_QUEUE]   = new LTE_fdd_enb_buf_pool(LTE_fdd_enb_buf_pool_text[LTE_FDD_ENB_BUF_POOL_UL_SCHED_QUEUE],
+                                                                               sizeof(LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT),
+                                                                               sched_pool_size,
+                                                                               true);
+    }
+}
+
+/****************************/
+/*    External Interface    */
+/****************************/
+void* LTE_fdd_enb_buf_pool_mgr::alloc(LTE_FDD_ENB_BUF_POOL_ENUM type)
+{
+    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
+    void                  *buf       = NULL;
+
+    if(NULL != pool[type])
+    {
+        buf = pool[type]->alloc();
+    }
+
+    if(NULL == buf)
+    {
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_IFACE,
+                                  __FILE__,
+                                  __LINE__,
+                                  "%s pool exhausted",
+                                  LTE_fdd_enb_buf_pool_text[type]);
+    }
+
+    return(buf);
+}
+void LTE_fdd_enb_buf_pool_mgr::print_stats(LTE_fdd_enb_interface *iface)
+{
+    uint32 i;
+
+    for(i=0; i<LTE_FDD_ENB_BUF_POOL_N_ITEMS; i++)
+    {
+        if(NULL != pool[i])
+        {
+            iface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_IFACE,
+                                  __FILE__,
+                                  __LINE__,
+                                  "%s pool in_use=%u high_water=%u/%u failed=%u",
+                                  pool[i]->get_pool_name().c_str(),
+                                  pool[i]->get_N_in_use(),
+                                  pool[i]->get_high_water(),
+                                  pool[i]->get_N_bufs(),
+                                  pool[i]->get_N_failed());
+        }
+    }
+}
@@ -157,6 +157,12 @@ LTE_fdd_enb_cnfg_db::LTE_fdd_enb_cnfg_db()
     var_map_int64[LTE_FDD_ENB_PARAM_USE_USER_FILE]             = 0;
     var_map_int64[LTE_FDD_ENB_PARAM_TX_GAIN]                   = 0;
     var_map_int64[LTE_FDD_ENB_PARAM_RX_GAIN]                   = 0;
+    var_map_double[LTE_FDD_ENB_PARAM_FFTW_PLANNER_TIME_LIMIT]  = -1;
+    var_map_int64[LTE_FDD_ENB_PARAM_PUSCH_DECODE_WORKERS]      = 2;
+    var_map_int64[LTE_FDD_ENB_PARAM_MSGQ_SIZE]                 = 128;
+    var_map_int64[LTE_FDD_ENB_PARAM_MSG_POOL_SIZE]             = 1024;
+    var_map_int64[LTE_FDD_ENB_PARAM_RLC_PDU_POOL_SIZE]         = 512;
+    var_map_int64[LTE_FDD_ENB_PARAM_SCHED_POOL_SIZE]           = 64;
     use_cnfg_file                                              = false;
 }
 LTE_fdd_enb_cnfg_db::~LTE_fdd_enb_cnfg_db()
@@ -1056,6 +1062,18 @@ void LTE_fdd_enb_cnfg_db::write_cnfg_file(void)
         fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_TX_GAIN], (*iter_i64).second);
         iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_RX_GAIN);
         fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_RX_GAIN], (*iter_i64).second);
+        iter_d = var_map_double.find(LTE_FDD_ENB_PARAM_FFTW_PLANNER_TIME_LIMIT);
+        fprintf(cnfg_file, "%s %f\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_FFTW_PLANNER_TIME_LIMIT], (*iter_d).second);
+        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_PUSCH_DECODE_WORKERS);
+        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PUSCH_DECODE_WORKERS], (*iter_i64).second);
+        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_MSGQ_SIZE);
+        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_MSGQ_SIZE], (*iter_i64).second);
+        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_MSG_POOL_SIZE);
+        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_MSG_POOL_SIZE], (*iter_i64).second);
+        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_RLC_PDU_POOL_SIZE);
+        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_RLC_PDU_POOL_SIZE], (*iter_i64).second);
+        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_SCHED_POOL_SIZE);
+        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SCHED_POOL_SIZE], (*iter_i64).second);
 
         fclose(cnfg_file);
     }
@@ -66,6 +66,7 @@
 #include "LTE_fdd_enb_phy.h"
 #include "LTE_fdd_enb_radio.h"
 #include "LTE_fdd_enb_timer_mgr.h"
+#include "LTE_fdd_enb_buf_pool_mgr.h"
 #include "liblte_interface.h"
 #include <boost/lexical_cast.hpp>
 #include <iomanip>
@@ -137,38 +138,44 @@ LTE_fdd_enb_interface::LTE_fdd_enb_interface()
     debug_connected = false;
 
     // Variables
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_BANDWIDTH]]          = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_DOUBLE, LTE_FDD_ENB_PARAM_BANDWIDTH, 0, 0, 0, 0, true, false, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_FREQ_BAND]]          = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_FREQ_BAND, 0, 0, 0, 0, true, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DL_EARFCN]]          = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_DL_EARFCN, 0, 0, 0, 0, true, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_UL_EARFCN]]          = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_UL_EARFCN, 0, 0, 0, 0, false, false, true};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DL_CENTER_FREQ]]     = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_DL_CENTER_FREQ, 0, 0, 0, 0, false, false, true};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_UL_CENTER_FREQ]]     = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_UL_CENTER_FREQ, 0, 0, 0, 0, false, false, true};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_N_ANT]]              = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_N_ANT, 0, 0, 0, 0, true, false, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_N_ID_CELL]]          = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_N_ID_CELL, 0, 0, 0, 503, false, false, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_MCC]]                = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_HEX, LTE_FDD_ENB_PARAM_MCC, 0, 0, 0, 0, true, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_MNC]]                = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_HEX, LTE_FDD_ENB_PARAM_MNC, 0, 0, 0, 0, true, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_CELL_ID]]            = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_CELL_ID, 0, 0, 0, 268435455, false, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_TRACKING_AREA_CODE]] = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_TRACKING_AREA_CODE, 0, 0, 0, 65535, false, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_Q_RX_LEV_MIN]]       = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_Q_RX_LEV_MIN, 0, 0, -140, -44, false, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_P0_NOMINAL_PUSCH]]   = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_P0_NOMINAL_PUSCH, 0, 0, -126, 24, false, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_P0_NOMINAL_PUCCH]]   = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_P0_NOMINAL_PUCCH, 0, 0, -127, -96, false, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB3_PRESENT]]       = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_SIB3_PRESENT, 0, 0, 0, 1, false, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_Q_HYST]]             = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_Q_HYST, 0, 0, 0, 0, true, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB4_PRESENT]]       = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_SIB4_PRESENT, 0, 0, 0, 1, false, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB5_PRESENT]]       = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_SIB5_PRESENT, 0, 0, 0, 1, false, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB6_PRESENT]]       = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_SIB6_PRESENT, 0, 0, 0, 1, false, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB7_PRESENT]]       = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_SIB7_PRESENT, 0, 0, 0, 1, false, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB8_PRESENT]]       = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_SIB8_PRESENT, 0, 0, 0, 1, false, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SEARCH_WIN_SIZE]]    = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_SEARCH_WIN_SIZE, 0, 0, 0, 15, false, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_TYPE]]         = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_UINT32, LTE_FDD_ENB_PARAM_DEBUG_TYPE, 0, 0, 0, 0, true, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_LEVEL]]        = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_UINT32, LTE_FDD_ENB_PARAM_DEBUG_LEVEL, 0, 0, 0, 0, true, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_ENABLE_PCAP]]        = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_ENABLE_PCAP, 0, 0, 0, 1, false, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_IP_ADDR_START]]      = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_HEX, LTE_FDD_ENB_PARAM_IP_ADDR_START, 0, 0, 0, 0, true, false, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DNS_ADDR]]           = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_HEX, LTE_FDD_ENB_PARAM_DNS_ADDR, 0, 0, 0, 0, true, false, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_USE_CNFG_FILE]]      = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_USE_CNFG_FILE, 0, 0, 0, 1, false, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_USE_USER_FILE]]      = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_USE_USER_FILE, 0, 0, 0, 1, false, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_TX_GAIN]]            = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_TX_GAIN, 0, 0, 0, 100, false, true, false};
-    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_RX_GAIN]]            = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_RX_GAIN, 0, 0, 0, 100, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_BANDWIDTH]]               = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_DOUBLE, LTE_FDD_ENB_PARAM_BANDWIDTH, 0, 0, 0, 0, true, false, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_FREQ_BAND]]               = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_FREQ_BAND, 0, 0, 0, 0, true, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DL_EARFCN]]               = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_DL_EARFCN, 0, 0, 0, 0, true, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_UL_EARFCN]]               = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_UL_EARFCN, 0, 0, 0, 0, false, false, true};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DL_CENTER_FREQ]]          = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_DL_CENTER_FREQ, 0, 0, 0, 0, false, false, true};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_UL_CENTER_FREQ]]          = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_UL_CENTER_FREQ, 0, 0, 0, 0, false, false, true};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_N_ANT]]                   = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_N_ANT, 0, 0, 0, 0, true, false, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_N_ID_CELL]]               = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_N_ID_CELL, 0, 0, 0, 503, false, false, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_MCC]]                     = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_HEX, LTE_FDD_ENB_PARAM_MCC, 0, 0, 0, 0, true, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_MNC]]                     = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_HEX, LTE_FDD_ENB_PARAM_MNC, 0, 0, 0, 0, true, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_CELL_ID]]                 = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_CELL_ID, 0, 0, 0, 268435455, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_TRACKING_AREA_CODE]]      = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_TRACKING_AREA_CODE, 0, 0, 0, 65535, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_Q_RX_LEV_MIN]]            = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_Q_RX_LEV_MIN, 0, 0, -140, -44, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_P0_NOMINAL_PUSCH]]        = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_P0_NOMINAL_PUSCH, 0, 0, -126, 24, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_P0_NOMINAL_PUCCH]]        = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_P0_NOMINAL_PUCCH, 0, 0, -127, -96, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB3_PRESENT]]            = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_SIB3_PRESENT, 0, 0, 0, 1, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_Q_HYST]]                  = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_Q_HYST, 0, 0, 0, 0, true, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB4_PRESENT]]            = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_SIB4_PRESENT, 0, 0, 0, 1, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB5_PRESENT]]            = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_SIB5_PRESENT, 0, 0, 0, 1, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB6_PRESENT]]            = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_SIB6_PRESENT, 0, 0, 0, 1, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB7_PRESENT]]            = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_SIB7_PRESENT, 0, 0, 0, 1, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB8_PRESENT]]            = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_SIB8_PRESENT, 0, 0, 0, 1, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SEARCH_WIN_SIZE]]         = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_SEARCH_WIN_SIZE, 0, 0, 0, 15, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_TYPE]]              = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_UINT32, LTE_FDD_ENB_PARAM_DEBUG_TYPE, 0, 0, 0, 0, true, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_LEVEL]]             = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_UINT32, LTE_FDD_ENB_PARAM_DEBUG_LEVEL, 0, 0, 0, 0, true, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_ENABLE_PCAP]]             = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_ENABLE_PCAP, 0, 0, 0, 1, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_IP_ADDR_START]]           = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_HEX, LTE_FDD_ENB_PARAM_IP_ADDR_START, 0, 0, 0, 0, true, false, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DNS_ADDR]]                = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_HEX, LTE_FDD_ENB_PARAM_DNS_ADDR, 0, 0, 0, 0, true, false, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_USE_CNFG_FILE]]           = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_USE_CNFG_FILE, 0, 0, 0, 1, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_USE_USER_FILE]]           = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_USE_USER_FILE, 0, 0, 0, 1, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_TX_GAIN]]                 = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_TX_GAIN, 0, 0, 0, 100, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_RX_GAIN]]                 = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_RX_GAIN, 0, 0, 0, 100, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_FFTW_PLANNER_TIME_LIMIT]] = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_DOUBLE, LTE_FDD_ENB_PARAM_FFTW_PLANNER_TIME_LIMIT, -1, 60, 0, 0, false, false, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PUSCH_DECODE_WORKERS]]    = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_PUSCH_DECODE_WORKERS, 0, 0, 0, 16, false, false, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_MSGQ_SIZE]]               = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_MSGQ_SIZE, 0, 0, 16, 4096, false, false, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_MSG_POOL_SIZE]]           = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_MSG_POOL_SIZE, 0, 0, 64, 16384, false, false, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_RLC_PDU_POOL_SIZE]]       = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_RLC_PDU_POOL_SIZE, 0, 0, 64, 8192, false, false, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SCHED_POOL_SIZE]]         = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_SCHED_POOL_SIZE, 0, 0, 16, 1024, false, false, false};
 
     debug_type_mask = 0;
     for(i=0; i<LTE_FDD_ENB_DEBUG_TYPE_N_ITEMS; i++)
@@ -978,7 +985,9 @@ void LTE_fdd_enb_interface::handle_start(void)
     LTE_fdd_enb_phy           *phy       = LTE_fdd_enb_phy::get_instance();
     LTE_fdd_enb_radio         *radio     = LTE_fdd_enb_radio::get_instance();
     LTE_fdd_enb_timer_mgr     *timer_mgr = LTE_fdd_enb_timer_mgr::get_instance();
+    LTE_fdd_enb_buf_pool_mgr  *pool_mgr  = LTE_fdd_enb_buf_pool_mgr::get_instance();
     LTE_FDD_ENB_ERROR_ENUM     err;
+    int64                      msgq_size;
     char                       err_str[LTE_FDD_ENB_MAX_LINE_SIZE];
 
     if(!started)
@@ -989,20 +998,24 @@ void LTE_fdd_enb_interface::handle_start(void)
         // Construct the system information
         cnfg_db->construct_sys_info();
 
+        // Preallocate data path buffers
+        pool_mgr->start();
+
         // Initialize inter-stack communication
-        phy_to_mac_comm   = new LTE_fdd_enb_msgq("phy_to_mac");
-        mac_to_phy_comm   = new LTE_fdd_enb_msgq("mac_to_phy");
-        mac_to_rlc_comm   = new LTE_fdd_enb_msgq("mac_to_rlc");
-        mac_to_timer_comm = new LTE_fdd_enb_msgq("mac_to_timer");
-        rlc_to_mac_comm   = new LTE_fdd_enb_msgq("rlc_to_mac");
-        rlc_to_pdcp_comm  = new LTE_fdd_enb_msgq("rlc_to_pdcp");
-        pdcp_to_rlc_comm  = new LTE_fdd_enb_msgq("pdcp_to_rlc");
-        pdcp_to_rrc_comm  = new LTE_fdd_enb_msgq("pdcp_to_rrc");
-        rrc_to_pdcp_comm  = new LTE_fdd_enb_msgq("rrc_to_pdcp");
-        rrc_to_mme_comm   = new LTE_fdd_enb_msgq("rrc_to_mme");
-        mme_to_rrc_comm   = new LTE_fdd_enb_msgq("mme_to_rrc");
-        pdcp_to_gw_comm   = new LTE_fdd_enb_msgq("pdcp_to_gw");
-        gw_to_pdcp_comm   = new LTE_fdd_enb_msgq("gw_to_pdcp");
+        cnfg_db->get_param(LTE_FDD_ENB_PARAM_MSGQ_SIZE, msgq_size);
+        phy_to_mac_comm   = new LTE_fdd_enb_msgq("phy_to_mac", msgq_size);
+        mac_to_phy_comm   = new LTE_fdd_enb_msgq("mac_to_phy", msgq_size);
+        mac_to_rlc_comm   = new LTE_fdd_enb_msgq("mac_to_rlc", msgq_size);
+        mac_to_timer_comm = new LTE_fdd_enb_msgq("mac_to_timer", msgq_size);
+        rlc_to_mac_comm   = new LTE_fdd_enb_msgq("rlc_to_mac", msgq_size);
+        rlc_to_pdcp_comm  = new LTE_fdd_enb_msgq("rlc_to_pdcp", msgq_size);
+        pdcp_to_rlc_comm  = new LTE_fdd_enb_msgq("pdcp_to_rlc", msgq_size);
+        pdcp_to_rrc_comm  = new LTE_fdd_enb_msgq("pdcp_to_rrc", msgq_size);
+        rrc_to_pdcp_comm  = new LTE_fdd_enb_msgq("rrc_to_pdcp", msgq_size);
+        rrc_to_mme_comm   = new LTE_fdd_enb_msgq("rrc_to_mme", msgq_size);
+        mme_to_rrc_comm   = new LTE_fdd_enb_msgq("mme_to_rrc", msgq_size);
+        pdcp_to_gw_comm   = new LTE_fdd_enb_msgq("pdcp_to_gw", msgq_size);
+        gw_to_pdcp_comm   = new LTE_fdd_enb_msgq("gw_to_pdcp", msgq_size);
 
         // Start layers
         err = gw->start(pdcp_to_gw_comm, gw_to_pdcp_comm, err_str, this);
@@ -1043,14 +1056,15 @@ void LTE_fdd_enb_interface::handle_start(void)
 void LTE_fdd_enb_interface::handle_stop(void)
 {
     boost::mutex::scoped_lock  lock(start_mutex);
-    LTE_fdd_enb_radio         *radio = LTE_fdd_enb_radio::get_instance();
-    LTE_fdd_enb_phy           *phy   = LTE_fdd_enb_phy::get_instance();
-    LTE_fdd_enb_mac           *mac   = LTE_fdd_enb_mac::get_instance();
-    LTE_fdd_enb_rlc           *rlc   = LTE_fdd_enb_rlc::get_instance();
-    LTE_fdd_enb_pdcp          *pdcp  = LTE_fdd_enb_pdcp::get_instance();
-    LTE_fdd_enb_rrc           *rrc   = LTE_fdd_enb_rrc::get_instance();
-    LTE_fdd_enb_mme           *mme   = LTE_fdd_enb_mme::get_instance();
-    LTE_fdd_enb_gw            *gw    = LTE_fdd_enb_gw::get_instance();
+    LTE_fdd_enb_radio         *radio    = LTE_fdd_enb_radio::get_instance();
+    LTE_fdd_enb_phy           *phy      = LTE_fdd_enb_phy::get_instance();
+    LTE_fdd_enb_mac           *mac      = LTE_fdd_enb_mac::get_instance();
+    LTE_fdd_enb_rlc           *rlc      = LTE_fdd_enb_rlc::get_instance();
+    LTE_fdd_enb_pdcp          *pdcp     = LTE_fdd_enb_pdcp::get_instance();
+    LTE_fdd_enb_rrc           *rrc      = LTE_fdd_enb_rrc::get_instance();
+    LTE_fdd_enb_mme           *mme      = LTE_fdd_enb_mme::get_instance();
+    LTE_fdd_enb_gw            *gw       = LTE_fdd_enb_gw::get_instance();
+    LTE_fdd_enb_buf_pool_mgr  *pool_mgr = LTE_fdd_enb_buf_pool_mgr::get_instance();
     LTE_FDD_ENB_ERROR_ENUM     err;
 
     if(started)
@@ -1147,6 +1161,9 @@ void LTE_fdd_enb_interface::handle_stop(void)
             LTE_fdd_enb_mme::cleanup();
             LTE_fdd_enb_gw::cleanup();
 
+            // Report buffer pool usage, the pools persist until the next start
+            pool_mgr->print_stats(this);
+
             send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, "");
         }else{
             send_ctrl_error_msg(err, "");
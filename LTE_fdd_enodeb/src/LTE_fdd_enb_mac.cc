@@ -61,6 +61,7 @@
 
 #include "LTE_fdd_enb_user_mgr.h"
 #include "LTE_fdd_enb_timer_mgr.h"
+#include "LTE_fdd_enb_buf_pool_mgr.h"
 #include "LTE_fdd_enb_mac.h"
 #include "LTE_fdd_enb_phy.h"
 
@@ -115,12 +116,57 @@ void LTE_fdd_enb_mac::cleanup(void)
 /********************************/
 LTE_fdd_enb_mac::LTE_fdd_enb_mac()
 {
+    uint32 i;
+
     interface = NULL;
     started   = false;
+
+    // Schedules are built in pool buffers and handed to PHY
+    dl_sched_pool = new LTE_fdd_enb_buf_pool("dl_sched",
+                                             sizeof(LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT),
+                                             LTE_FDD_ENB_MAC_N_SCHED_BUFS,
+                                             false);
+    ul_sched_pool = new LTE_fdd_enb_buf_pool("ul_sched",
+                                             sizeof(LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT),
+                                             LTE_FDD_ENB_MAC_N_SCHED_BUFS,
+                                             false);
+    for(i=0; i<10; i++)
+    {
+        sched_dl_subfr[i] = NULL;
+        sched_ul_subfr[i] = NULL;
+    }
 }
 LTE_fdd_enb_mac::~LTE_fdd_enb_mac()
 {
+    uint32 i;
+
     stop();
+
+    for(i=0; i<10; i++)
+    {
+        LTE_fdd_enb_buf_pool::release(sched_dl_subfr[i]);
+        LTE_fdd_enb_buf_pool::release(sched_ul_subfr[i]);
+    }
+
+    // Return queued entries, the queue pools outlive the MAC
+    while(0 != rar_sched_queue.size())
+    {
+        LTE_fdd_enb_buf_pool::release(rar_sched_queue.front());
+        rar_sched_queue.pop_front();
+    }
+    while(0 != dl_sched_queue.size())
+    {
+        LTE_fdd_enb_buf_pool::release(dl_sched_queue.front());
+        dl_sched_queue.pop_front();
+    }
+    while(0 != ul_sched_queue.size())
+    {
+        LTE_fdd_enb_buf_pool::release(ul_sched_queue.front());
+        ul_sched_queue.pop_front();
+    }
+
+    delete dl_sched_pool;
+    delete ul_sched_pool;
 }
 
 /********************/
@@ -155,21 +201,30 @@ void LTE_fdd_enb_mac::start(LTE_fdd_enb_msgq      *from_phy,
         cnfg_db->get_sys_info(sys_info);
         for(i=0; i<10; i++)
         {
-            sched_dl_subfr[i].dl_allocations.N_alloc = 0;
-            sched_dl_subfr[i].ul_allocations.N_alloc = 0;
-            sched_dl_subfr[i].N_avail_prbs           = sys_info.N_rb_dl - get_n_reserved_prbs(i);
-            sched_dl_subfr[i].N_sched_prbs           = 0;
-            sched_dl_subfr[i].current_tti            = i;
-
-            sched_ul_subfr[i].decodes.N_alloc = 0;
-            sched_ul_subfr[i].N_avail_prbs    = sys_info.N_rb_ul;
-            sched_ul_subfr[i].N_sched_prbs    = 0;
-            sched_ul_subfr[i].current_tti     = i;
-            sched_ul_subfr[i].next_prb        = 0;
+            if(NULL == sched_dl_subfr[i])
+            {
+                sched_dl_subfr[i] = (LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *)dl_sched_pool->alloc();
+            }
+            if(NULL == sched_ul_subfr[i])
+            {
+                sched_ul_subfr[i] = (LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *)ul_sched_pool->alloc();
+            }
+
+            sched_dl_subfr[i]->dl_allocations.N_alloc = 0;
+            sched_dl_subfr[i]->ul_allocations.N_alloc = 0;
+            sched_dl_subfr[i]->N_avail_prbs           = sys_info.N_rb_dl - get_n_reserved_prbs(i);
+            sched_dl_subfr[i]->N_sched_prbs           = 0;
+            sched_dl_subfr[i]->current_tti            = i;
+
+            sched_ul_subfr[i]->decodes.N_alloc = 0;
+            sched_ul_subfr[i]->N_avail_prbs    = sys_info.N_rb_ul;
+            sched_ul_subfr[i]->N_sched_prbs    = 0;
+            sched_ul_subfr[i]->current_tti     = i;
+            sched_ul_subfr[i]->next_prb        = 0;
         }
-        sched_dl_subfr[0].current_tti = 10;
-        sched_dl_subfr[1].current_tti = 11;
-        sched_dl_subfr[2].current_tti = 12;
+        sched_dl_subfr[0]->current_tti = 10;
+        sched_dl_subfr[1]->current_tti = 11;
+        sched_dl_subfr[2]->current_tti = 12;
         sched_cur_dl_subfn            = 3;
         sched_cur_ul_subfn            = 0;
     }
@@ -289,7 +344,7 @@ void LTE_fdd_enb_mac::sched_ul(LTE_fdd_enb_user *user,
     }
 
     // Add the allocation to the scheduling queue
-    if(LTE_FDD_ENB_ERROR_NONE != add_to_ul_sched_queue((sched_ul_subfr[sched_cur_ul_subfn].current_tti + 4) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1),
+    if(LTE_FDD_ENB_ERROR_NONE != add_to_ul_sched_queue((sched_ul_subfr[sched_cur_ul_subfn]->current_tti + 4) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1),
                                                        &alloc))
     {
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
@@ -327,50 +382,46 @@ void LTE_fdd_enb_mac::handle_ready_to_send(LTE_FDD_ENB_READY_TO_SEND_MSG_STRUCT
 
     if(rts->late)
     {
-        msgq_to_phy->send(LTE_FDD_ENB_MESSAGE_TYPE_PHY_SCHEDULE,
-                          &sched_dl_subfr[sched_cur_dl_subfn],
-                          &sched_ul_subfr[sched_cur_ul_subfn]);
+        send_phy_schedule();
 
         for(i=0; i<2; i++)
         {
             // Advance the frame number combination
-            sched_dl_subfr[sched_cur_dl_subfn].current_tti = (sched_dl_subfr[sched_cur_dl_subfn].current_tti + 10) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
-            sched_ul_subfr[sched_cur_ul_subfn].current_tti = (sched_ul_subfr[sched_cur_ul_subfn].current_tti + 10) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+            sched_dl_subfr[sched_cur_dl_subfn]->current_tti = (sched_dl_subfr[sched_cur_dl_subfn]->current_tti + 10) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+            sched_ul_subfr[sched_cur_ul_subfn]->current_tti = (sched_ul_subfr[sched_cur_ul_subfn]->current_tti + 10) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
 
             // Clear the subframes
             sys_info_mutex.lock();
-            sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc = 0;
-            sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc = 0;
-            sched_dl_subfr[sched_cur_dl_subfn].N_avail_prbs           = sys_info.N_rb_dl - get_n_reserved_prbs(sched_dl_subfr[sched_cur_dl_subfn].current_tti);
-            sched_dl_subfr[sched_cur_dl_subfn].N_sched_prbs           = 0;
-            sched_ul_subfr[sched_cur_ul_subfn].decodes.N_alloc        = 0;
-            sched_ul_subfr[sched_cur_ul_subfn].N_sched_prbs           = 0;
-            sched_ul_subfr[sched_cur_ul_subfn].next_prb               = 0;
+            sched_dl_subfr[sched_cur_dl_subfn]->dl_allocations.N_alloc = 0;
+            sched_dl_subfr[sched_cur_dl_subfn]->ul_allocations.N_alloc = 0;
+            sched_dl_subfr[sched_cur_dl_subfn]->N_avail_prbs           = sys_info.N_rb_dl - get_n_reserved_prbs(sched_dl_subfr[sched_cur_dl_subfn]->current_tti);
+            sched_dl_subfr[sched_cur_dl_subfn]->N_sched_prbs           = 0;
+            sched_ul_subfr[sched_cur_ul_subfn]->decodes.N_alloc        = 0;
+            sched_ul_subfr[sched_cur_ul_subfn]->N_sched_prbs           = 0;
+            sched_ul_subfr[sched_cur_ul_subfn]->next_prb               = 0;
             sys_info_mutex.unlock();
 
             // Advance the subframe numbers
             sched_cur_dl_subfn = (sched_cur_dl_subfn + 1) % 10;
             sched_cur_ul_subfn = (sched_cur_ul_subfn + 1) % 10;
         }
-    }else if(rts->dl_current_tti == sched_dl_subfr[sched_cur_dl_subfn].current_tti &&
-             rts->ul_current_tti == sched_ul_subfr[sched_cur_ul_subfn].current_tti){
-        msgq_to_phy->send(LTE_FDD_ENB_MESSAGE_TYPE_PHY_SCHEDULE,
-                          &sched_dl_subfr[sched_cur_dl_subfn],
-                          &sched_ul_subfr[sched_cur_ul_subfn]);
+    }else if(rts->dl_current_tti == sched_dl_subfr[sched_cur_dl_subfn]->current_tti &&
+             rts->ul_current_tti == sched_ul_subfr[sched_cur_ul_subfn]->current_tti){
+        send_phy_schedule();
 
         // Advance the frame number combination
-        sched_dl_subfr[sched_cur_dl_subfn].current_tti = (sched_dl_subfr[sched_cur_dl_subfn].current_tti + 10) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
-        sched_ul_subfr[sched_cur_ul_subfn].current_tti = (sched_ul_subfr[sched_cur_ul_subfn].current_tti + 10) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+        sched_dl_subfr[sched_cur_dl_subfn]->current_tti = (sched_dl_subfr[sched_cur_dl_subfn]->current_tti + 10) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+        sched_ul_subfr[sched_cur_ul_subfn]->current_tti = (sched_ul_subfr[sched_cur_ul_subfn]->current_tti + 10) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
 
         // Clear the subframes
         sys_info_mutex.lock();
-        sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc = 0;
-        sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc = 0;
-        sched_dl_subfr[sched_cur_dl_subfn].N_avail_prbs           = sys_info.N_rb_dl - get_n_reserved_prbs(sched_dl_subfr[sched_cur_dl_subfn].current_tti);
-        sched_dl_subfr[sched_cur_dl_subfn].N_sched_prbs           = 0;
-        sched_ul_subfr[sched_cur_ul_subfn].decodes.N_alloc        = 0;
-        sched_ul_subfr[sched_cur_ul_subfn].N_sched_prbs           = 0;
-        sched_ul_subfr[sched_cur_ul_subfn].next_prb               = 0;
+        sched_dl_subfr[sched_cur_dl_subfn]->dl_allocations.N_alloc = 0;
+        sched_dl_subfr[sched_cur_dl_subfn]->ul_allocations.N_alloc = 0;
+        sched_dl_subfr[sched_cur_dl_subfn]->N_avail_prbs           = sys_info.N_rb_dl - get_n_reserved_prbs(sched_dl_subfr[sched_cur_dl_subfn]->current_tti);
+        sched_dl_subfr[sched_cur_dl_subfn]->N_sched_prbs           = 0;
+        sched_ul_subfr[sched_cur_ul_subfn]->decodes.N_alloc        = 0;
+        sched_ul_subfr[sched_cur_ul_subfn]->N_sched_prbs           = 0;
+        sched_ul_subfr[sched_cur_ul_subfn]->next_prb               = 0;
         sys_info_mutex.unlock();
 
         // Advance the subframe numbers
@@ -475,98 +526,119 @@ void LTE_fdd_enb_mac::handle_sdu_ready(LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT *sdu
     LTE_fdd_enb_user             *user;
     LIBLTE_MAC_PDU_STRUCT         mac_pdu;
     LIBLTE_PHY_ALLOCATION_STRUCT  alloc;
-    LIBLTE_BYTE_MSG_STRUCT       *sdu;
+    LIBLTE_BYTE_MSG_STRUCT       *sdu[LTE_FDD_ENB_MAC_MAX_DL_SDUS_PER_PDU];
+    uint32                        queued_bytes;
+    uint32                        N_sdus;
+    uint32                        N_sdu_bytes;
+    uint32                        i;
     uint32                        current_tti;
     uint32                        last_tti = sdu_ready->rb->get_last_tti();
     uint32                        tti_freq = sdu_ready->user->get_qos_dl_tti_freq();
 
-    if(LTE_FDD_ENB_ERROR_NONE == sdu_ready->rb->get_next_mac_sdu(&sdu))
+    // Each SDU_READY signals one SDU, but earlier messages may already
+    // have drained it along with their own SDUs
+    queued_bytes = sdu_ready->rb->get_mac_sdu_queue_bytes();
+    N_sdus       = sdu_ready->rb->get_next_mac_sdus(sdu, LTE_FDD_ENB_MAC_MAX_DL_SDUS_PER_PDU);
+    if(0 == N_sdus)
     {
-        user = sdu_ready->user;
+        return;
+    }
 
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                  __FILE__,
-                                  __LINE__,
-                                  sdu,
-                                  "Received SDU for RNTI=%u and RB=%s",
-                                  user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
-
-        // Fill in the allocation
-        alloc.pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
-        alloc.mod_type       = LIBLTE_PHY_MODULATION_TYPE_QPSK;
-        alloc.chan_type      = LIBLTE_PHY_CHAN_TYPE_DLSCH;
-        alloc.rv_idx         = 0;
-        alloc.N_codewords    = 1;
-        sys_info_mutex.lock();
-        if(1 == sys_info.N_ant)
-        {
-            alloc.tx_mode = 1;
-        }else{
-            alloc.tx_mode = 2;
-        }
-        sys_info_mutex.unlock();
-        alloc.rnti = user->get_c_rnti();
-        alloc.tpc  = LIBLTE_PHY_TPC_COMMAND_DCI_1_1A_1B_1D_2_3_DB_ZERO;
-        alloc.ndi  = user->get_dl_ndi();
-        user->flip_dl_ndi();
-
-        // Pack the PDU
-        mac_pdu.chan_type = LIBLTE_MAC_CHAN_TYPE_DLSCH;
-        if(sdu_ready->rb->get_send_con_res_id())
+    // Multiplex as many queued SDUs as fit into one PDU, the first is
+    // always sent
+    N_sdu_bytes = sdu[0]->N_bytes;
+    for(i=1; i<N_sdus; i++)
+    {
+        if((N_sdu_bytes + sdu[i]->N_bytes) > LTE_FDD_ENB_MAC_MAX_DL_PDU_SDU_BYTES)
         {
-            mac_pdu.N_subheaders                          = 2;
-            mac_pdu.subheader[0].lcid                     = LIBLTE_MAC_DLSCH_UE_CONTENTION_RESOLUTION_ID_LCID;
-            mac_pdu.subheader[0].payload.ue_con_res_id.id = sdu_ready->rb->get_con_res_id();
-            mac_pdu.subheader[1].lcid                     = sdu_ready->rb->get_rb_id();
-            memcpy(&mac_pdu.subheader[1].payload.sdu, sdu, sizeof(LIBLTE_BIT_MSG_STRUCT));
-            sdu_ready->rb->set_send_con_res_id(false);
-        }else{
-            mac_pdu.N_subheaders      = 1;
-            mac_pdu.subheader[0].lcid = sdu_ready->rb->get_rb_id();
-            memcpy(&mac_pdu.subheader[0].payload.sdu, sdu, sizeof(LIBLTE_BIT_MSG_STRUCT));
+            break;
         }
+        N_sdu_bytes += sdu[i]->N_bytes;
+    }
+    N_sdus = i;
 
-        // Determine the current_tti
-        current_tti = (sched_dl_subfr[sched_cur_dl_subfn].current_tti + 4) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
-        if(0xFFFFFFFF            != last_tti &&
-           (last_tti + tti_freq)  > current_tti)
-        {
-            current_tti = (last_tti + tti_freq) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
-        }
-        sdu_ready->rb->set_last_tti(current_tti);
+    user = sdu_ready->user;
 
-        // Add the PDU to the scheduling queue
-        if(LTE_FDD_ENB_ERROR_NONE != add_to_dl_sched_queue(current_tti,
-                                                           &mac_pdu,
-                                                           &alloc))
-        {
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Can't schedule PDU");
-        }else{
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                      __FILE__,
-                                      __LINE__,
-                                      &alloc.msg,
-                                      "PDU scheduled for RNTI=%u, DL_QUEUE_SIZE=%u",
-                                      alloc.rnti,
-                                      dl_sched_queue.size());
-        }
-
-        // Delete the SDU
-        sdu_ready->rb->delete_next_mac_sdu();
+    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                              __FILE__,
+                              __LINE__,
+                              sdu[0],
+                              "Received %u SDUs (%u of %u queued bytes) for RNTI=%u and RB=%s",
+                              N_sdus,
+                              N_sdu_bytes,
+                              queued_bytes,
+                              user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
+
+    // Fill in the allocation
+    alloc.pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
+    alloc.mod_type       = LIBLTE_PHY_MODULATION_TYPE_QPSK;
+    alloc.chan_type      = LIBLTE_PHY_CHAN_TYPE_DLSCH;
+    alloc.rv_idx         = 0;
+    alloc.N_codewords    = 1;
+    sys_info_mutex.lock();
+    if(1 == sys_info.N_ant)
+    {
+        alloc.tx_mode = 1;
     }else{
+        alloc.tx_mode = 2;
+    }
+    sys_info_mutex.unlock();
+    alloc.rnti = user->get_c_rnti();
+    alloc.tpc  = LIBLTE_PHY_TPC_COMMAND_DCI_1_1A_1B_1D_2_3_DB_ZERO;
+    alloc.ndi  = user->get_dl_ndi();
+    user->flip_dl_ndi();
+
+    // Pack the PDU
+    mac_pdu.chan_type    = LIBLTE_MAC_CHAN_TYPE_DLSCH;
+    mac_pdu.N_subheaders = 0;
+    if(sdu_ready->rb->get_send_con_res_id())
+    {
+        mac_pdu.subheader[0].lcid                     = LIBLTE_MAC_DLSCH_UE_CONTENTION_RESOLUTION_ID_LCID;
+        mac_pdu.subheader[0].payload.ue_con_res_id.id = sdu_ready->rb->get_con_res_id();
+        mac_pdu.N_subheaders++;
+        sdu_ready->rb->set_send_con_res_id(false);
+    }
+    for(i=0; i<N_sdus; i++)
+    {
+        mac_pdu.subheader[mac_pdu.N_subheaders].lcid = sdu_ready->rb->get_rb_id();
+        memcpy(&mac_pdu.subheader[mac_pdu.N_subheaders].payload.sdu, sdu[i], sizeof(LIBLTE_BIT_MSG_STRUCT));
+        mac_pdu.N_subheaders++;
+    }
+
+    // Determine the current_tti
+    current_tti = (sched_dl_subfr[sched_cur_dl_subfn]->current_tti + 4) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+    if(0xFFFFFFFF            != last_tti &&
+       (last_tti + tti_freq)  > current_tti)
+    {
+        current_tti = (last_tti + tti_freq) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+    }
+    sdu_ready->rb->set_last_tti(current_tti);
+
+    // Add the PDU to the scheduling queue
+    if(LTE_FDD_ENB_ERROR_NONE != add_to_dl_sched_queue(current_tti,
+                                                       &mac_pdu,
+                                                       &alloc))
+    {
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                   LTE_FDD_ENB_DEBUG_LEVEL_MAC,
                                   __FILE__,
                                   __LINE__,
-                                  "Received sdu_ready message with no SDU queued");
+                                  "Can't schedule PDU");
+    }else{
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                  __FILE__,
+                                  __LINE__,
+                                  &alloc.msg,
+                                  "PDU scheduled for RNTI=%u, DL_QUEUE_SIZE=%u",
+                                  alloc.rnti,
+                                  dl_sched_queue.size());
     }
+
+    // Delete the SDUs
+    sdu_ready->rb->delete_next_mac_sdus(N_sdus);
 }
 
 /**************************/
@@ -898,24 +970,24 @@ void LTE_fdd_enb_mac::scheduler(void)
         // Take into account the SFN wrap
         // FIXME: Test this
         if(resp_win_start                                 <  LIBLTE_PHY_SFN_MAX*10 &&
-           sched_dl_subfr[sched_cur_dl_subfn].current_tti >= LIBLTE_PHY_SFN_MAX*10)
+           sched_dl_subfr[sched_cur_dl_subfn]->current_tti >= LIBLTE_PHY_SFN_MAX*10)
         {
             resp_win_start += LIBLTE_PHY_SFN_MAX*10;
         }
         if(resp_win_stop                                  <  LIBLTE_PHY_SFN_MAX*10 &&
-           sched_dl_subfr[sched_cur_dl_subfn].current_tti >= LIBLTE_PHY_SFN_MAX*10)
+           sched_dl_subfr[sched_cur_dl_subfn]->current_tti >= LIBLTE_PHY_SFN_MAX*10)
         {
             resp_win_stop += LIBLTE_PHY_SFN_MAX*10;
         }
 
         // Check to see if this current_tti falls in the response window
-        if(resp_win_start <= sched_dl_subfr[sched_cur_dl_subfn].current_tti &&
-           resp_win_stop  >= sched_dl_subfr[sched_cur_dl_subfn].current_tti)
+        if(resp_win_start <= sched_dl_subfr[sched_cur_dl_subfn]->current_tti &&
+           resp_win_stop  >= sched_dl_subfr[sched_cur_dl_subfn]->current_tti)
         {
             // Determine how many PRBs are needed for the DL allocation, if using this subframe
             interface->send_lte_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_DL,
                                          rar_sched->dl_alloc.rnti,
-                                         sched_dl_subfr[sched_cur_dl_subfn].current_tti,
+                                         sched_dl_subfr[sched_cur_dl_subfn]->current_tti,
                                          rar_sched->dl_alloc.msg.msg,
                                          rar_sched->dl_alloc.msg.N_bits);
             liblte_phy_get_tbs_mcs_and_n_prb_for_dl(rar_sched->dl_alloc.msg.N_bits,
@@ -927,17 +999,17 @@ void LTE_fdd_enb_mac::scheduler(void)
                                                     &rar_sched->dl_alloc.N_prb);
 
             // Determine how many PRBs and DCIs are available in this subframe
-            N_avail_dl_prbs = sched_dl_subfr[sched_cur_dl_subfn].N_avail_prbs - sched_dl_subfr[sched_cur_dl_subfn].N_sched_prbs;
-            N_avail_ul_prbs = sched_ul_subfr[(sched_cur_ul_subfn+6)%10].N_avail_prbs - sched_ul_subfr[(sched_cur_ul_subfn+6)%10].N_sched_prbs;
-            N_avail_dcis    = N_cce - (sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc);
+            N_avail_dl_prbs = sched_dl_subfr[sched_cur_dl_subfn]->N_avail_prbs - sched_dl_subfr[sched_cur_dl_subfn]->N_sched_prbs;
+            N_avail_ul_prbs = sched_ul_subfr[(sched_cur_ul_subfn+6)%10]->N_avail_prbs - sched_ul_subfr[(sched_cur_ul_subfn+6)%10]->N_sched_prbs;
+            N_avail_dcis    = N_cce - (sched_dl_subfr[sched_cur_dl_subfn]->dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn]->ul_allocations.N_alloc);
 
             if(rar_sched->dl_alloc.N_prb <= N_avail_dl_prbs &&
                rar_sched->ul_alloc.N_prb <= N_avail_ul_prbs &&
                1                         <= N_avail_dcis)
             {
                 // Determine the RB start for the UL allocation
-                rb_start                                            = sched_ul_subfr[(sched_cur_ul_subfn+6)%10].next_prb;
-                sched_ul_subfr[(sched_cur_ul_subfn+6)%10].next_prb += rar_sched->ul_alloc.N_prb;
+                rb_start                                            = sched_ul_subfr[(sched_cur_ul_subfn+6)%10]->next_prb;
+                sched_ul_subfr[(sched_cur_ul_subfn+6)%10]->next_prb += rar_sched->ul_alloc.N_prb;
 
                 // Fill in the PRBs for the UL allocation
                 for(i=0; i<rar_sched->ul_alloc.N_prb; i++)
@@ -974,27 +1046,27 @@ void LTE_fdd_enb_mac::scheduler(void)
                                           "RAR sent %u %u %u %u",
                                           resp_win_start,
                                           resp_win_stop,
-                                          sched_dl_subfr[sched_cur_dl_subfn].current_tti,
-                                          sched_ul_subfr[(sched_cur_dl_subfn+6)%10].current_tti);
+                                          sched_dl_subfr[sched_cur_dl_subfn]->current_tti,
+                                          sched_ul_subfr[(sched_cur_dl_subfn+6)%10]->current_tti);
 
                 // Schedule DL
-                memcpy(&sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.alloc[sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc],
+                memcpy(&sched_dl_subfr[sched_cur_dl_subfn]->dl_allocations.alloc[sched_dl_subfr[sched_cur_dl_subfn]->dl_allocations.N_alloc],
                        &rar_sched->dl_alloc,
                        sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
-                sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc++;
+                sched_dl_subfr[sched_cur_dl_subfn]->dl_allocations.N_alloc++;
                 // Schedule UL decode 6 subframes from now
-                memcpy(&sched_ul_subfr[(sched_cur_dl_subfn+6)%10].decodes.alloc[sched_ul_subfr[(sched_cur_dl_subfn+6)%10].decodes.N_alloc],
+                memcpy(&sched_ul_subfr[(sched_cur_dl_subfn+6)%10]->decodes.alloc[sched_ul_subfr[(sched_cur_dl_subfn+6)%10]->decodes.N_alloc],
                        &rar_sched->ul_alloc,
                        sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
-                sched_ul_subfr[(sched_cur_dl_subfn+6)%10].decodes.N_alloc++;
+                sched_ul_subfr[(sched_cur_dl_subfn+6)%10]->decodes.N_alloc++;
 
                 // Remove RAR from queue
                 rar_sched_queue.pop_front();
-                delete rar_sched;
+                LTE_fdd_enb_buf_pool::release(rar_sched);
             }else{
                 sched_out_of_headroom = true;
             }
-        }else if(resp_win_stop < sched_dl_subfr[sched_cur_dl_subfn].current_tti){ // Check to see if the response window has passed
+        }else if(resp_win_stop < sched_dl_subfr[sched_cur_dl_subfn]->current_tti){ // Check to see if the response window has passed
             // Response window has passed, remove from queue
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                       LTE_FDD_ENB_DEBUG_LEVEL_MAC,
@@ -1002,9 +1074,9 @@ void LTE_fdd_enb_mac::scheduler(void)
                                       __LINE__,
                                       "RAR outside of resp win %u %u",
                                       resp_win_stop,
-                                      sched_dl_subfr[sched_cur_dl_subfn].current_tti);
+                                      sched_dl_subfr[sched_cur_dl_subfn]->current_tti);
             rar_sched_queue.pop_front();
-            delete rar_sched;
+            LTE_fdd_enb_buf_pool::release(rar_sched);
         }else{
             break;
         }
@@ -1019,7 +1091,7 @@ void LTE_fdd_enb_mac::scheduler(void)
     {
         dl_sched = dl_sched_queue.front();
 
-        if(dl_sched->current_tti == sched_dl_subfr[sched_cur_dl_subfn].current_tti)
+        if(dl_sched->current_tti == sched_dl_subfr[sched_cur_dl_subfn]->current_tti)
         {
             // Pack the message and determine TBS
             liblte_mac_pack_mac_pdu(&dl_sched->mac_pdu,
@@ -1073,13 +1145,13 @@ void LTE_fdd_enb_mac::scheduler(void)
             // Send a PCAP message
             interface->send_lte_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_DL,
                                          dl_sched->alloc.rnti,
-                                         sched_dl_subfr[sched_cur_dl_subfn].current_tti,
+                                         sched_dl_subfr[sched_cur_dl_subfn]->current_tti,
                                          dl_sched->alloc.msg.msg,
                                          dl_sched->alloc.tbs);
 
             // Determine how many PRBs and DCIs are available in this subframe
-            N_avail_dl_prbs = sched_dl_subfr[sched_cur_dl_subfn].N_avail_prbs - sched_dl_subfr[sched_cur_dl_subfn].N_sched_prbs;
-            N_avail_dcis    = N_cce - (sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc);
+            N_avail_dl_prbs = sched_dl_subfr[sched_cur_dl_subfn]->N_avail_prbs - sched_dl_subfr[sched_cur_dl_subfn]->N_sched_prbs;
+            N_avail_dcis    = N_cce - (sched_dl_subfr[sched_cur_dl_subfn]->dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn]->ul_allocations.N_alloc);
 
             if(dl_sched->alloc.N_prb <= N_avail_dl_prbs &&
                1                     <= N_avail_dcis)
@@ -1094,17 +1166,17 @@ void LTE_fdd_enb_mac::scheduler(void)
                                           dl_sched->alloc.tbs,
                                           dl_sched->alloc.N_prb,
                                           dl_sched->alloc.rnti,
-                                          sched_dl_subfr[sched_cur_dl_subfn].current_tti);
+                                          sched_dl_subfr[sched_cur_dl_subfn]->current_tti);
 
                 // Schedule DL
-                memcpy(&sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.alloc[sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc],
+                memcpy(&sched_dl_subfr[sched_cur_dl_subfn]->dl_allocations.alloc[sched_dl_subfr[sched_cur_dl_subfn]->dl_allocations.N_alloc],
                        &dl_sched->alloc,
                        sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
-                sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc++;
+                sched_dl_subfr[sched_cur_dl_subfn]->dl_allocations.N_alloc++;
 
                 // Remove DL schedule from queue
                 dl_sched_queue.pop_front();
-                delete dl_sched;
+                LTE_fdd_enb_buf_pool::release(dl_sched);
             }else{
                 interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                           LTE_FDD_ENB_DEBUG_LEVEL_MAC,
@@ -1118,12 +1190,12 @@ void LTE_fdd_enb_mac::scheduler(void)
 
                 // Remove DL schedule from queue
                 dl_sched_queue.pop_front();
-                delete dl_sched;
+                LTE_fdd_enb_buf_pool::release(dl_sched);
             }
-        }else if(dl_sched->current_tti < sched_dl_subfr[sched_cur_dl_subfn].current_tti){
+        }else if(dl_sched->current_tti < sched_dl_subfr[sched_cur_dl_subfn]->current_tti){
             // Remove DL schedule from queue
             dl_sched_queue.pop_front();
-            delete dl_sched;
+            LTE_fdd_enb_buf_pool::release(dl_sched);
         }else{
             sched_out_of_headroom = true;
         }
@@ -1139,15 +1211,15 @@ void LTE_fdd_enb_mac::scheduler(void)
         ul_sched = ul_sched_queue.front();
 
         // Determine how many PRBs and DCIs are available in this subframe
-        N_avail_ul_prbs = sched_ul_subfr[(sched_cur_dl_subfn+4)%10].N_avail_prbs - sched_ul_subfr[(sched_cur_dl_subfn+4)%10].N_sched_prbs;
-        N_avail_dcis    = N_cce - (sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc);
+        N_avail_ul_prbs = sched_ul_subfr[(sched_cur_dl_subfn+4)%10]->N_avail_prbs - sched_ul_subfr[(sched_cur_dl_subfn+4)%10]->N_sched_prbs;
+        N_avail_dcis    = N_cce - (sched_dl_subfr[sched_cur_dl_subfn]->dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn]->ul_allocations.N_alloc);
 
         if(ul_sched->alloc.N_prb <= N_avail_ul_prbs &&
            1                     <= N_avail_dcis)
         {
             // Determine the RB start
-            rb_start                                            = sched_ul_subfr[(sched_cur_dl_subfn+4)%10].next_prb;
-            sched_ul_subfr[(sched_cur_dl_subfn+4)%10].next_prb += ul_sched->alloc.N_prb;
+            rb_start                                            = sched_ul_subfr[(sched_cur_dl_subfn+4)%10]->next_prb;
+            sched_ul_subfr[(sched_cur_dl_subfn+4)%10]->next_prb += ul_sched->alloc.N_prb;
 
             // Fill in the PRBs
             for(i=0; i<ul_sched->alloc.N_prb; i++)
@@ -1162,22 +1234,22 @@ void LTE_fdd_enb_mac::scheduler(void)
                                       __LINE__,
                                       "UL allocation sent for RNTI=%u CURRENT_TTI=%u",
                                       ul_sched->alloc.rnti,
-                                      sched_ul_subfr[(sched_cur_dl_subfn+4)%10].current_tti);
+                                      sched_ul_subfr[(sched_cur_dl_subfn+4)%10]->current_tti);
 
             // Schedule UL decode 4 subframes from now
-            memcpy(&sched_ul_subfr[(sched_cur_dl_subfn+4)%10].decodes.alloc[sched_ul_subfr[(sched_cur_dl_subfn+4)%10].decodes.N_alloc],
+            memcpy(&sched_ul_subfr[(sched_cur_dl_subfn+4)%10]->decodes.alloc[sched_ul_subfr[(sched_cur_dl_subfn+4)%10]->decodes.N_alloc],
                    &ul_sched->alloc,
                    sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
-            sched_ul_subfr[(sched_cur_dl_subfn+4)%10].decodes.N_alloc++;
+            sched_ul_subfr[(sched_cur_dl_subfn+4)%10]->decodes.N_alloc++;
             // Schedule UL allocation
-            memcpy(&sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.alloc[sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc],
+            memcpy(&sched_dl_subfr[sched_cur_dl_subfn]->ul_allocations.alloc[sched_dl_subfr[sched_cur_dl_subfn]->ul_allocations.N_alloc],
                    &ul_sched->alloc,
                    sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
-            sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc++;
+            sched_dl_subfr[sched_cur_dl_subfn]->ul_allocations.N_alloc++;
 
             // Remove UL schedule from queue
             ul_sched_queue.pop_front();
-            delete ul_sched;
+            LTE_fdd_enb_buf_pool::release(ul_sched);
         }else{
             sched_out_of_headroom = true;
         }
@@ -1189,10 +1261,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_mac::add_to_rar_sched_queue(uint32
                                                                LIBLTE_PHY_ALLOCATION_STRUCT *ul_alloc,
                                                                LIBLTE_MAC_RAR_STRUCT        *rar)
 {
+    LTE_fdd_enb_buf_pool_mgr           *pool_mgr  = LTE_fdd_enb_buf_pool_mgr::get_instance();
     LTE_FDD_ENB_RAR_SCHED_QUEUE_STRUCT *rar_sched = NULL;
     LTE_FDD_ENB_ERROR_ENUM              err       = LTE_FDD_ENB_ERROR_CANT_SCHEDULE;
 
-    rar_sched = new LTE_FDD_ENB_RAR_SCHED_QUEUE_STRUCT;
+    rar_sched = (LTE_FDD_ENB_RAR_SCHED_QUEUE_STRUCT *)pool_mgr->alloc(LTE_FDD_ENB_BUF_POOL_RAR_SCHED_QUEUE);
 
     if(NULL != rar_sched)
     {
@@ -1214,11 +1287,12 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_mac::add_to_dl_sched_queue(uint32
                                                               LIBLTE_MAC_PDU_STRUCT        *mac_pdu,
                                                               LIBLTE_PHY_ALLOCATION_STRUCT *alloc)
 {
+    LTE_fdd_enb_buf_pool_mgr                                 *pool_mgr = LTE_fdd_enb_buf_pool_mgr::get_instance();
     std::list<LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT *>::iterator  iter;
     LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT                        *dl_sched = NULL;
     LTE_FDD_ENB_ERROR_ENUM                                    err      = LTE_FDD_ENB_ERROR_CANT_SCHEDULE;
 
-    dl_sched = new LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT;
+    dl_sched = (LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT *)pool_mgr->alloc(LTE_FDD_ENB_BUF_POOL_DL_SCHED_QUEUE);
 
     if(NULL != dl_sched)
     {
@@ -1246,11 +1320,12 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_mac::add_to_dl_sched_queue(uint32
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_mac::add_to_ul_sched_queue(uint32                        current_tti,
                                                               LIBLTE_PHY_ALLOCATION_STRUCT *alloc)
 {
+    LTE_fdd_enb_buf_pool_mgr                                 *pool_mgr = LTE_fdd_enb_buf_pool_mgr::get_instance();
     std::list<LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT *>::iterator  iter;
     LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT                        *ul_sched = NULL;
     LTE_FDD_ENB_ERROR_ENUM                                    err      = LTE_FDD_ENB_ERROR_CANT_SCHEDULE;
 
-    ul_sched = new LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT;
+    ul_sched = (LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT *)pool_mgr->alloc(LTE_FDD_ENB_BUF_POOL_UL_SCHED_QUEUE);
 
     if(NULL != ul_sched)
     {
@@ -1275,6 +1350,45 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_mac::add_to_ul_sched_queue(uint32
     return(err);
 }
 
+void LTE_fdd_enb_mac::send_phy_schedule(void)
+{
+    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *dl_sched = sched_dl_subfr[sched_cur_dl_subfn];
+    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *ul_sched = sched_ul_subfr[sched_cur_ul_subfn];
+    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *next_dl_sched;
+    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *next_ul_sched;
+
+    // Hand the current schedules to PHY and continue in fresh buffers,
+    // the caller advances and clears them for the next frame
+    next_dl_sched = (LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *)dl_sched_pool->alloc();
+    next_ul_sched = (LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *)ul_sched_pool->alloc();
+    if(NULL == next_dl_sched ||
+       NULL == next_ul_sched)
+    {
+        LTE_fdd_enb_buf_pool::release(next_dl_sched);
+        LTE_fdd_enb_buf_pool::release(next_ul_sched);
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                  __FILE__,
+                                  __LINE__,
+                                  "Out of schedule buffers, not sending schedule for CURRENT_TTI=%u",
+                                  dl_sched->current_tti);
+        return;
+    }
+    next_dl_sched->current_tti  = dl_sched->current_tti;
+    next_ul_sched->current_tti  = ul_sched->current_tti;
+    next_ul_sched->N_avail_prbs = ul_sched->N_avail_prbs;
+    sched_dl_subfr[sched_cur_dl_subfn] = next_dl_sched;
+    sched_ul_subfr[sched_cur_ul_subfn] = next_ul_sched;
+
+    if(!msgq_to_phy->send(LTE_FDD_ENB_MESSAGE_TYPE_PHY_SCHEDULE,
+                          dl_sched,
+                          ul_sched))
+    {
+        LTE_fdd_enb_buf_pool::release(dl_sched);
+        LTE_fdd_enb_buf_pool::release(ul_sched);
+    }
+}
+
 /*****************/
 /*    Helpers    */
 /*****************/
@@ -43,6 +43,8 @@
 
 #include "LTE_fdd_enb_interface.h"
 #include "LTE_fdd_enb_msgq.h"
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 /*******************************************************************************
                               DEFINES
@@ -82,15 +84,35 @@ void LTE_fdd_enb_msgq_cb::operator()(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
 /********************************/
 /*    Constructor/Destructor    */
 /********************************/
-LTE_fdd_enb_msgq::LTE_fdd_enb_msgq(std::string _msgq_name)
+LTE_fdd_enb_msgq::LTE_fdd_enb_msgq(std::string _msgq_name,
+                                   uint32      _size)
 {
-    sema      = new boost::interprocess::interprocess_semaphore(0);
-    circ_buf  = new boost::circular_buffer<LTE_FDD_ENB_MESSAGE_STRUCT>(100);
-    msgq_name = _msgq_name;
-    rx_setup  = false;
+    uint32 i;
+
+    // Round the capacity up to a power of two so indecies can be masked
+    ring_size = 1;
+    while(ring_size < _size)
+    {
+        ring_size <<= 1;
+    }
+    ring_mask  = ring_size - 1;
+    ring       = new LTE_FDD_ENB_MSGQ_SLOT_STRUCT[ring_size];
+    for(i=0; i<ring_size; i++)
+    {
+        ring[i].seq = i;
+    }
+    head.idx   = 0;
+    tail.idx   = 0;
+    rx_waiting = 0;
+    rx_efd     = eventfd(0, 0);
+    memset(&stats, 0, sizeof(stats));
+    msgq_name  = _msgq_name;
+    rx_setup   = false;
 }
 LTE_fdd_enb_msgq::~LTE_fdd_enb_msgq()
 {
+    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
+
     if(rx_setup)
     {
         send(LTE_FDD_ENB_MESSAGE_TYPE_KILL,
@@ -103,6 +125,20 @@ LTE_fdd_enb_msgq::~LTE_fdd_enb_msgq()
         pthread_join(rx_thread, NULL);
         rx_setup = false;
     }
+
+    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MSGQ,
+                              __FILE__,
+                              __LINE__,
+                              "%s sent=%llu dropped=%llu high_water=%u/%u",
+                              msgq_name.c_str(),
+                              stats.N_sent,
+                              stats.N_dropped,
+                              stats.high_water,
+                              ring_size);
+
+    close(rx_efd);
+    delete [] ring;
 }
 
 /***************/
@@ -127,102 +163,167 @@ void LTE_fdd_enb_msgq::attach_rx(LTE_fdd_enb_msgq_cb cb,
 /**********************/
 /*    Send/Receive    */
 /**********************/
-void LTE_fdd_enb_msgq::send(LTE_FDD_ENB_MESSAGE_TYPE_ENUM  type,
+bool LTE_fdd_enb_msgq::send(LTE_FDD_ENB_MESSAGE_TYPE_ENUM  type,
                             LTE_FDD_ENB_DEST_LAYER_ENUM    dest_layer,
                             LTE_FDD_ENB_MESSAGE_UNION     *msg_content,
                             uint32                         msg_content_size)
 {
-    LTE_FDD_ENB_MESSAGE_STRUCT msg;
+    LTE_FDD_ENB_MSGQ_SLOT_STRUCT *slot = claim_slot();
+
+    if(NULL == slot)
+    {
+        return(false);
+    }
 
-    msg.type       = type;
-    msg.dest_layer = dest_layer;
+    slot->msg.type       = type;
+    slot->msg.dest_layer = dest_layer;
     if(msg_content != NULL)
     {
-        memcpy(&msg.msg, msg_content, msg_content_size);
+        memcpy(&slot->msg.msg, msg_content, msg_content_size);
     }
+    publish_slot(slot);
 
-    mutex.lock();
-    circ_buf->push_back(msg);
-    mutex.unlock();
-    sema->post();
+    return(true);
 }
-void LTE_fdd_enb_msgq::send(LTE_FDD_ENB_MESSAGE_TYPE_ENUM       type,
+bool LTE_fdd_enb_msgq::send(LTE_FDD_ENB_MESSAGE_TYPE_ENUM       type,
                             LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *dl_sched,
                             LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *ul_sched)
 {
-    LTE_FDD_ENB_MESSAGE_STRUCT msg;
+    LTE_FDD_ENB_MSGQ_SLOT_STRUCT *slot = claim_slot();
+
+    if(NULL == slot)
+    {
+        return(false);
+    }
+
+    slot->msg.type                      = type;
+    slot->msg.dest_layer                = LTE_FDD_ENB_DEST_LAYER_PHY;
+    slot->msg.msg.phy_schedule.dl_sched = dl_sched;
+    slot->msg.msg.phy_schedule.ul_sched = ul_sched;
+    publish_slot(slot);
+
+    return(true);
+}
+bool LTE_fdd_enb_msgq::send(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
+{
+    LTE_FDD_ENB_MSGQ_SLOT_STRUCT *slot = claim_slot();
+
+    if(NULL == slot)
+    {
+        return(false);
+    }
 
-    msg.type       = type;
-    msg.dest_layer = LTE_FDD_ENB_DEST_LAYER_PHY;
-    memcpy(&msg.msg.phy_schedule.dl_sched, dl_sched, sizeof(LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT));
-    memcpy(&msg.msg.phy_schedule.ul_sched, ul_sched, sizeof(LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT));
+    memcpy(&slot->msg, &msg, sizeof(LTE_FDD_ENB_MESSAGE_STRUCT));
+    publish_slot(slot);
 
-    mutex.lock();
-    circ_buf->push_back(msg);
-    mutex.unlock();
-    sema->post();
+    return(true);
 }
-void LTE_fdd_enb_msgq::send(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
+LTE_FDD_ENB_MSGQ_SLOT_STRUCT* LTE_fdd_enb_msgq::claim_slot(void)
 {
-    mutex.lock();
-    circ_buf->push_back(msg);
-    mutex.unlock();
-    sema->post();
+    LTE_FDD_ENB_MSGQ_SLOT_STRUCT *slot;
+    uint32                        t = __atomic_load_n(&tail.idx, __ATOMIC_RELAXED);
+    int32                         diff;
+
+    // Producers claim a slot by advancing the tail with a compare and
+    // swap.  A full ring never blocks the sender, the message is
+    // dropped and counted so real time threads keep their deadlines.
+    while(1)
+    {
+        slot = &ring[t & ring_mask];
+        diff = (int32)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - t);
+        if(0 == diff)
+        {
+            if(__atomic_compare_exchange_n(&tail.idx, &t, t + 1, true,
+                                           __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                return(slot);
+            }
+        }else if(0 > diff){
+            __sync_fetch_and_add(&stats.N_dropped, 1);
+            return(NULL);
+        }else{
+            t = __atomic_load_n(&tail.idx, __ATOMIC_RELAXED);
+        }
+    }
+}
+void LTE_fdd_enb_msgq::publish_slot(LTE_FDD_ENB_MSGQ_SLOT_STRUCT *slot)
+{
+    uint32 t     = slot->seq + 1;
+    uint32 depth = t - __atomic_load_n(&head.idx, __ATOMIC_RELAXED);
+    uint32 hw    = __atomic_load_n(&stats.high_water, __ATOMIC_RELAXED);
+
+    // The sequentially consistent store pairs with the one in
+    // receive_thread so either the receive thread sees the message or
+    // this thread sees that it is waiting
+    __atomic_store_n(&slot->seq, t, __ATOMIC_SEQ_CST);
+    if(__atomic_load_n(&rx_waiting, __ATOMIC_SEQ_CST))
+    {
+        eventfd_write(rx_efd, 1);
+    }
+
+    __sync_fetch_and_add(&stats.N_sent, 1);
+    while(depth > hw &&
+          !__atomic_compare_exchange_n(&stats.high_water, &hw, depth, true,
+                                       __ATOMIC_RELAXED, __ATOMIC_RELAXED));
 }
 void* LTE_fdd_enb_msgq::receive_thread(void *inputs)
 {
-    LTE_fdd_enb_interface      *interface = LTE_fdd_enb_interface::get_instance();
-    LTE_fdd_enb_msgq           *msgq      = (LTE_fdd_enb_msgq *)inputs;
-    LTE_FDD_ENB_MESSAGE_STRUCT  msg;
-    struct sched_param          priority;
-    std::size_t                 rx_size;
-    uint32                      prio;
-    bool                        not_done = true;
+    LTE_fdd_enb_msgq             *msgq     = (LTE_fdd_enb_msgq *)inputs;
+    LTE_FDD_ENB_MSGQ_SLOT_STRUCT *slot;
+    struct sched_param            priority;
+    eventfd_t                     cnt;
+    uint32                        h        = 0;
+    bool                          not_done = true;
 
     // Set priority
     if(msgq->prio != 0)
     {
         // FIXME: verify
-        priority.sched_priority = prio;
+        priority.sched_priority = msgq->prio;
         pthread_setschedparam(msgq->rx_thread, SCHED_FIFO, &priority);
     }
 
     while(not_done)
     {
-        // Wait for a message
-        msgq->sema->wait();
-        msgq->mutex.lock();
-        if(msgq->circ_buf->size() != 0)
+        // Wait for a message, only sleeping until the next slot is published
+        slot = &msgq->ring[h & msgq->ring_mask];
+        if((h + 1) != __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE))
         {
-            while(msgq->circ_buf->size() != 0)
+            __atomic_store_n(&msgq->rx_waiting, 1, __ATOMIC_SEQ_CST);
+            if((h + 1) != __atomic_load_n(&slot->seq, __ATOMIC_SEQ_CST))
             {
-                msg = msgq->circ_buf->front();
-                msgq->circ_buf->pop_front();
-                msgq->mutex.unlock();
-
-                // Process message
-                switch(msg.type)
-                {
-                case LTE_FDD_ENB_MESSAGE_TYPE_KILL:
-                    not_done = false;
-                    break;
-                default:
-                    msgq->callback(msg);
-                    break;
-                }
-
-                msgq->mutex.lock();
+                eventfd_read(msgq->rx_efd, &cnt);
             }
-        }else{
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MSGQ,
-                                      __FILE__,
-                                      __LINE__,
-                                      "%s circular buffer empty on receive",
-                                      msgq->msgq_name.c_str());
+            __atomic_store_n(&msgq->rx_waiting, 0, __ATOMIC_RELAXED);
+            continue;
+        }
+
+        // Process the message in place, the slot is not released to
+        // the producers until the callback returns
+        switch(slot->msg.type)
+        {
+        case LTE_FDD_ENB_MESSAGE_TYPE_KILL:
+            not_done = false;
+            break;
+        default:
+            msgq->callback(slot->msg);
+            break;
         }
-        msgq->mutex.unlock();
+
+        __atomic_store_n(&slot->seq, h + msgq->ring_size, __ATOMIC_RELEASE);
+        h++;
+        __atomic_store_n(&msgq->head.idx, h, __ATOMIC_RELAXED);
     }
 
     return(NULL);
 }
+
+/********************/
+/*    Statistics    */
+/********************/
+void LTE_fdd_enb_msgq::get_stats(LTE_FDD_ENB_MSGQ_STATS_STRUCT *_stats)
+{
+    _stats->N_sent     = __atomic_load_n(&stats.N_sent, __ATOMIC_RELAXED);
+    _stats->N_dropped  = __atomic_load_n(&stats.N_dropped, __ATOMIC_RELAXED);
+    _stats->high_water = __atomic_load_n(&stats.high_water, __ATOMIC_RELAXED);
+}
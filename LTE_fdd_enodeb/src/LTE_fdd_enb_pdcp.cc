@@ -246,13 +246,21 @@ void LTE_fdd_enb_pdcp::handle_pdu_ready(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT *p
     LTE_FDD_ENB_GW_DATA_READY_MSG_STRUCT      gw_data_ready;
     LIBLTE_PDCP_CONTROL_PDU_STRUCT            contents;
     LIBLTE_PDCP_DATA_PDU_WITH_LONG_SN_STRUCT  data_contents;
+    LIBLTE_BYTE_MSG_STRUCT                   *pdus[LTE_FDD_ENB_PDCP_MAX_BATCH_SIZE];
     LIBLTE_BYTE_MSG_STRUCT                   *pdu;
     LIBLTE_BIT_MSG_STRUCT                     rrc_pdu;
     uint8                                    *pdu_ptr;
+    uint32                                    N_pdus;
     uint32                                    i;
+    uint32                                    j;
 
-    if(LTE_FDD_ENB_ERROR_NONE == pdu_ready->rb->get_next_pdcp_pdu(&pdu))
+    // Each ready message signals one entry, but earlier messages may
+    // already have drained it along with their own
+    N_pdus = pdu_ready->rb->get_next_pdcp_pdus(pdus, LTE_FDD_ENB_PDCP_MAX_BATCH_SIZE);
+    for(j=0; j<N_pdus; j++)
     {
+        pdu = pdus[j];
+
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                   LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
                                   __FILE__,
@@ -333,10 +341,10 @@ void LTE_fdd_enb_pdcp::handle_pdu_ready(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT *p
                                       pdu_ready->user->get_c_rnti(),
                                       LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()]);
         }
-
-        // Delete the PDU
-        pdu_ready->rb->delete_next_pdcp_pdu();
     }
+
+    // Delete the PDUs
+    pdu_ready->rb->delete_next_pdcp_pdus(N_pdus);
 }
 
 /******************************/
@@ -347,12 +355,21 @@ void LTE_fdd_enb_pdcp::handle_sdu_ready(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT *s
     LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT  rlc_sdu_ready;
     LIBLTE_PDCP_CONTROL_PDU_STRUCT        contents;
     LIBLTE_BYTE_MSG_STRUCT                pdu;
+    LIBLTE_BIT_MSG_STRUCT                *sdus[LTE_FDD_ENB_PDCP_MAX_BATCH_SIZE];
     LIBLTE_BIT_MSG_STRUCT                *sdu;
     uint8                                *sdu_ptr;
+    uint32                                N_sdus;
+    uint32                                N_rlc_sdus = 0;
     uint32                                i;
+    uint32                                j;
 
-    if(LTE_FDD_ENB_ERROR_NONE == sdu_ready->rb->get_next_pdcp_sdu(&sdu))
+    // Each ready message signals one entry, but earlier messages may
+    // already have drained it along with their own
+    N_sdus = sdu_ready->rb->get_next_pdcp_sdus(sdus, LTE_FDD_ENB_PDCP_MAX_BATCH_SIZE);
+    for(j=0; j<N_sdus; j++)
     {
+        sdu = sdus[j];
+
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                   LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
                                   __FILE__,
@@ -393,17 +410,7 @@ void LTE_fdd_enb_pdcp::handle_sdu_ready(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT *s
 
             // Queue the PDU for RLC
             sdu_ready->rb->queue_rlc_sdu(&pdu);
-
-            // Signal RLC
-            rlc_sdu_ready.user = sdu_ready->user;
-            rlc_sdu_ready.rb   = sdu_ready->rb;
-            msgq_to_rlc->send(LTE_FDD_ENB_MESSAGE_TYPE_RLC_SDU_READY,
-                              LTE_FDD_ENB_DEST_LAYER_RLC,
-                              (LTE_FDD_ENB_MESSAGE_UNION *)&rlc_sdu_ready,
-                              sizeof(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT));
-
-            // Delete the SDU
-            sdu_ready->rb->delete_next_pdcp_sdu();
+            N_rlc_sdus++;
         }else if(LTE_FDD_ENB_RB_SRB1 == sdu_ready->rb->get_rb_id() ||
                  LTE_FDD_ENB_RB_SRB2 == sdu_ready->rb->get_rb_id()){
             // Pack the control PDU
@@ -436,17 +443,7 @@ void LTE_fdd_enb_pdcp::handle_sdu_ready(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT *s
 
             // Queue the PDU for RLC
             sdu_ready->rb->queue_rlc_sdu(&pdu);
-
-            // Signal RLC
-            rlc_sdu_ready.user = sdu_ready->user;
-            rlc_sdu_ready.rb   = sdu_ready->rb;
-            msgq_to_rlc->send(LTE_FDD_ENB_MESSAGE_TYPE_RLC_SDU_READY,
-                              LTE_FDD_ENB_DEST_LAYER_RLC,
-                              (LTE_FDD_ENB_MESSAGE_UNION *)&rlc_sdu_ready,
-                              sizeof(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT));
-
-            // Delete the SDU
-            sdu_ready->rb->delete_next_pdcp_sdu();
+            N_rlc_sdus++;
         }else{
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                       LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
@@ -457,15 +454,21 @@ void LTE_fdd_enb_pdcp::handle_sdu_ready(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT *s
                                       sdu_ready->user->get_c_rnti(),
                                       LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
         }
-    }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received SDU ready with no data, RNTI=%u, RB=%s",
-                                  sdu_ready->user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
     }
+
+    // Signal RLC once for the batch
+    if(0 != N_rlc_sdus)
+    {
+        rlc_sdu_ready.user = sdu_ready->user;
+        rlc_sdu_ready.rb   = sdu_ready->rb;
+        msgq_to_rlc->send(LTE_FDD_ENB_MESSAGE_TYPE_RLC_SDU_READY,
+                          LTE_FDD_ENB_DEST_LAYER_RLC,
+                          (LTE_FDD_ENB_MESSAGE_UNION *)&rlc_sdu_ready,
+                          sizeof(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT));
+    }
+
+    // Delete the SDUs
+    sdu_ready->rb->delete_next_pdcp_sdus(N_sdus);
 }
 
 /*****************************/
@@ -476,10 +479,19 @@ void LTE_fdd_enb_pdcp::handle_data_sdu_ready(LTE_FDD_ENB_PDCP_DATA_SDU_READY_MSG
     LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT      rlc_sdu_ready;
     LIBLTE_PDCP_DATA_PDU_WITH_LONG_SN_STRUCT  contents;
     LIBLTE_BYTE_MSG_STRUCT                    pdu;
+    LIBLTE_BYTE_MSG_STRUCT                   *sdus[LTE_FDD_ENB_PDCP_MAX_BATCH_SIZE];
     LIBLTE_BYTE_MSG_STRUCT                   *sdu;
-
-    if(LTE_FDD_ENB_ERROR_NONE == data_sdu_ready->rb->get_next_pdcp_data_sdu(&sdu))
+    uint32                                    N_sdus;
+    uint32                                    N_rlc_sdus = 0;
+    uint32                                    j;
+
+    // Each ready message signals one entry, but earlier messages may
+    // already have drained it along with their own
+    N_sdus = data_sdu_ready->rb->get_next_pdcp_data_sdus(sdus, LTE_FDD_ENB_PDCP_MAX_BATCH_SIZE);
+    for(j=0; j<N_sdus; j++)
     {
+        sdu = sdus[j];
+
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                   LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
                                   __FILE__,
@@ -512,17 +524,7 @@ void LTE_fdd_enb_pdcp::handle_data_sdu_ready(LTE_FDD_ENB_PDCP_DATA_SDU_READY_MSG
 
             // Queue the PDU for RLC
             data_sdu_ready->rb->queue_rlc_sdu(&pdu);
-
-            // Signal RLC
-            rlc_sdu_ready.user = data_sdu_ready->user;
-            rlc_sdu_ready.rb   = data_sdu_ready->rb;
-            msgq_to_rlc->send(LTE_FDD_ENB_MESSAGE_TYPE_RLC_SDU_READY,
-                              LTE_FDD_ENB_DEST_LAYER_RLC,
-                              (LTE_FDD_ENB_MESSAGE_UNION *)&rlc_sdu_ready,
-                              sizeof(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT));
-
-            // Delete the SDU
-            data_sdu_ready->rb->delete_next_pdcp_data_sdu();
+            N_rlc_sdus++;
         }else{
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                       LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
@@ -532,13 +534,19 @@ void LTE_fdd_enb_pdcp::handle_data_sdu_ready(LTE_FDD_ENB_PDCP_DATA_SDU_READY_MSG
                                       LTE_fdd_enb_rb_text[data_sdu_ready->rb->get_rb_id()],
                                       data_sdu_ready->user->get_c_rnti());
         }
-    }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received data SDU ready from GW with no data, RNTI=%u, RB=%s",
-                                  data_sdu_ready->user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[data_sdu_ready->rb->get_rb_id()]);
     }
+
+    // Signal RLC once for the batch
+    if(0 != N_rlc_sdus)
+    {
+        rlc_sdu_ready.user = data_sdu_ready->user;
+        rlc_sdu_ready.rb   = data_sdu_ready->rb;
+        msgq_to_rlc->send(LTE_FDD_ENB_MESSAGE_TYPE_RLC_SDU_READY,
+                          LTE_FDD_ENB_DEST_LAYER_RLC,
+                          (LTE_FDD_ENB_MESSAGE_UNION *)&rlc_sdu_ready,
+                          sizeof(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT));
+    }
+
+    // Delete the SDUs
+    data_sdu_ready->rb->delete_next_pdcp_data_sdus(N_sdus);
 }
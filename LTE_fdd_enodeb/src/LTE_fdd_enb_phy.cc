@@ -106,8 +106,15 @@ void LTE_fdd_enb_phy::cleanup(void)
 /********************************/
 LTE_fdd_enb_phy::LTE_fdd_enb_phy()
 {
+    uint32 i;
+
     interface = NULL;
     started   = false;
+    for(i=0; i<10; i++)
+    {
+        dl_schedule[i] = NULL;
+        ul_schedule[i] = NULL;
+    }
 }
 LTE_fdd_enb_phy::~LTE_fdd_enb_phy()
 {
@@ -121,9 +128,12 @@ void LTE_fdd_enb_phy::start(LTE_fdd_enb_msgq      *from_mac,
                             LTE_fdd_enb_msgq      *to_mac,
                             LTE_fdd_enb_interface *iface)
 {
-    LTE_fdd_enb_radio   *radio = LTE_fdd_enb_radio::get_instance();
+    LTE_fdd_enb_radio   *radio   = LTE_fdd_enb_radio::get_instance();
+    LTE_fdd_enb_cnfg_db *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
     LTE_fdd_enb_msgq_cb  cb(&LTE_fdd_enb_msgq_cb_wrapper<LTE_fdd_enb_phy, &LTE_fdd_enb_phy::handle_mac_msg>, this);
     LIBLTE_PHY_FS_ENUM   fs;
+    double               planner_time_limit;
+    int64                pusch_decode_workers;
     uint32               i;
     uint32               j;
     uint32               k;
@@ -156,6 +166,9 @@ void LTE_fdd_enb_phy::start(LTE_fdd_enb_msgq      *from_mac,
                                   "Invalid sample rate %u",
                                   samp_rate);
         }
+        cnfg_db->get_param(LTE_FDD_ENB_PARAM_FFTW_PLANNER_TIME_LIMIT, planner_time_limit);
+        liblte_phy_set_default_fftw_wisdom_path();
+        liblte_phy_set_fftw_planner_time_limit(planner_time_limit);
         liblte_phy_init(&phy_struct,
                         fs,
                         sys_info.N_id_cell,
@@ -175,14 +188,28 @@ void LTE_fdd_enb_phy::start(LTE_fdd_enb_msgq      *from_mac,
                            sys_info.sib2.rr_config_common_sib.pusch_cnfg.ul_rs.cyclic_shift,
                            0);
 
+        // PUSCH decode workers, each decodes with its own workspace
+        cnfg_db->get_param(LTE_FDD_ENB_PARAM_PUSCH_DECODE_WORKERS, pusch_decode_workers);
+        N_pusch_workers       = (uint32)pusch_decode_workers;
+        pusch_job_id          = 0;
+        pusch_N_alloc         = 0;
+        pusch_next_alloc      = 0;
+        pusch_N_done          = 0;
+        pusch_workers_running = true;
+        for(i=0; i<N_pusch_workers; i++)
+        {
+            pusch_worker[i].phy = this;
+            liblte_phy_init_workspace(phy_struct, &pusch_worker[i].phy_struct);
+            pthread_create(&pusch_worker[i].thread, NULL, &pusch_worker_thread_func, &pusch_worker[i]);
+        }
+
         // Downlink
         for(i=0; i<10; i++)
         {
-            dl_schedule[i].current_tti            = i;
-            dl_schedule[i].dl_allocations.N_alloc = 0;
-            dl_schedule[i].ul_allocations.N_alloc = 0;
-            ul_schedule[i].current_tti            = i;
-            ul_schedule[i].decodes.N_alloc        = 0;
+            LTE_fdd_enb_buf_pool::release(dl_schedule[i]);
+            LTE_fdd_enb_buf_pool::release(ul_schedule[i]);
+            dl_schedule[i] = NULL;
+            ul_schedule[i] = NULL;
         }
         pcfich.cfi = 2; // FIXME: Make this dynamic every subfr
         for(i=0; i<10; i++)
@@ -198,6 +225,7 @@ void LTE_fdd_enb_phy::start(LTE_fdd_enb_msgq      *from_mac,
         pdcch.N_alloc        = 0;
         pdcch.N_symbs        = 2; // FIXME: Make this dynamic every subfr
         dl_subframe.num      = 0;
+        build_dl_static_content();
         dl_current_tti       = 0;
         last_rts_current_tti = 0;
         late_subfr           = false;
@@ -301,12 +329,38 @@ void LTE_fdd_enb_phy::start(LTE_fdd_enb_msgq      *from_mac,
 }
 void LTE_fdd_enb_phy::stop(void)
 {
+    uint32 i;
+
     if(started)
     {
         started = false;
 
+        // Stop the PUSCH decode workers before the cell is torn down
+        pusch_mutex.lock();
+        pusch_workers_running = false;
+        pusch_mutex.unlock();
+        pusch_start_cond.notify_all();
+        for(i=0; i<N_pusch_workers; i++)
+        {
+            pthread_join(pusch_worker[i].thread, NULL);
+            liblte_phy_cleanup(pusch_worker[i].phy_struct);
+        }
+
         liblte_phy_ul_cleanup(phy_struct);
         liblte_phy_cleanup(phy_struct);
+
+        // Return the schedules to MAC's pools
+        dl_sched_mutex.lock();
+        ul_sched_mutex.lock();
+        for(i=0; i<10; i++)
+        {
+            LTE_fdd_enb_buf_pool::release(dl_schedule[i]);
+            LTE_fdd_enb_buf_pool::release(ul_schedule[i]);
+            dl_schedule[i] = NULL;
+            ul_schedule[i] = NULL;
+        }
+        ul_sched_mutex.unlock();
+        dl_sched_mutex.unlock();
     }
 }
 
@@ -319,6 +373,7 @@ void LTE_fdd_enb_phy::update_sys_info(void)
 
     sys_info_mutex.lock();
     cnfg_db->get_sys_info(sys_info);
+    dl_mib_sfn_div_4 = 0xFFFFFFFF;
     sys_info_mutex.unlock();
 }
 uint32 LTE_fdd_enb_phy::get_n_cce(void)
@@ -396,65 +451,70 @@ void LTE_fdd_enb_phy::handle_phy_schedule(LTE_FDD_ENB_PHY_SCHEDULE_MSG_STRUCT *p
     boost::mutex::scoped_lock d_lock(dl_sched_mutex);
     boost::mutex::scoped_lock u_lock(ul_sched_mutex);
 
-    if(phy_sched->dl_sched.current_tti                    < dl_current_tti &&
-       (dl_current_tti - phy_sched->dl_sched.current_tti) < (LTE_FDD_ENB_CURRENT_TTI_MAX/2))
+    if(phy_sched->dl_sched->current_tti                    < dl_current_tti &&
+       (dl_current_tti - phy_sched->dl_sched->current_tti) < (LTE_FDD_ENB_CURRENT_TTI_MAX/2))
     {
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                   LTE_FDD_ENB_DEBUG_LEVEL_PHY,
                                   __FILE__,
                                   __LINE__,
                                   "Late DL subframe from MAC:%u, PHY is currently on %u",
-                                  phy_sched->dl_sched.current_tti,
+                                  phy_sched->dl_sched->current_tti,
                                   dl_current_tti);
 
         late_subfr = true;
-        if(phy_sched->dl_sched.current_tti == last_rts_current_tti)
+        if(phy_sched->dl_sched->current_tti == last_rts_current_tti)
         {
             late_subfr = false;
         }
+        LTE_fdd_enb_buf_pool::release(phy_sched->dl_sched);
     }else{
-        if(phy_sched->dl_sched.dl_allocations.N_alloc ||
-           phy_sched->dl_sched.ul_allocations.N_alloc)
+        if(phy_sched->dl_sched->dl_allocations.N_alloc ||
+           phy_sched->dl_sched->ul_allocations.N_alloc)
         {
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                       LTE_FDD_ENB_DEBUG_LEVEL_PHY,
                                       __FILE__,
                                       __LINE__,
                                       "Received PDSCH schedule from MAC CURRENT_TTI:MAC=%u,PHY=%u N_dl_allocs=%u N_ul_allocs=%u",
-                                      phy_sched->dl_sched.current_tti,
+                                      phy_sched->dl_sched->current_tti,
                                       dl_current_tti,
-                                      phy_sched->dl_sched.dl_allocations.N_alloc,
-                                      phy_sched->dl_sched.ul_allocations.N_alloc);
+                                      phy_sched->dl_sched->dl_allocations.N_alloc,
+                                      phy_sched->dl_sched->ul_allocations.N_alloc);
         }
 
-        memcpy(&dl_schedule[phy_sched->dl_sched.current_tti%10], &phy_sched->dl_sched, sizeof(LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT));
+        // Take over MAC's reference to the schedule
+        LTE_fdd_enb_buf_pool::release(dl_schedule[phy_sched->dl_sched->current_tti%10]);
+        dl_schedule[phy_sched->dl_sched->current_tti%10] = phy_sched->dl_sched;
 
         late_subfr = false;
     }
-    if(phy_sched->ul_sched.current_tti                    < ul_current_tti &&
-       (ul_current_tti - phy_sched->ul_sched.current_tti) < (LTE_FDD_ENB_CURRENT_TTI_MAX/2))
+    if(phy_sched->ul_sched->current_tti                    < ul_current_tti &&
+       (ul_current_tti - phy_sched->ul_sched->current_tti) < (LTE_FDD_ENB_CURRENT_TTI_MAX/2))
     {
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                   LTE_FDD_ENB_DEBUG_LEVEL_PHY,
                                   __FILE__,
                                   __LINE__,
                                   "Late UL subframe from MAC:%u, PHY is currently on %u",
-                                  phy_sched->ul_sched.current_tti,
+                                  phy_sched->ul_sched->current_tti,
                                   ul_current_tti);
+        LTE_fdd_enb_buf_pool::release(phy_sched->ul_sched);
     }else{
-        if(phy_sched->ul_sched.decodes.N_alloc)
+        if(phy_sched->ul_sched->decodes.N_alloc)
         {
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                       LTE_FDD_ENB_DEBUG_LEVEL_PHY,
                                       __FILE__,
                                       __LINE__,
                                       "Received PUSCH schedule from MAC CURRENT_TTI:MAC=%u,PHY=%u N_ul_decodes=%u",
-                                      phy_sched->ul_sched.current_tti,
+                                      phy_sched->ul_sched->current_tti,
                                       ul_current_tti,
-                                      phy_sched->ul_sched.decodes.N_alloc);
+                                      phy_sched->ul_sched->decodes.N_alloc);
         }
 
-        memcpy(&ul_schedule[phy_sched->ul_sched.current_tti%10], &phy_sched->ul_sched, sizeof(LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT));
+        LTE_fdd_enb_buf_pool::release(ul_schedule[phy_sched->ul_sched->current_tti%10]);
+        ul_schedule[phy_sched->ul_sched->current_tti%10] = phy_sched->ul_sched;
     }
 }
 void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
@@ -462,6 +522,8 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
     LTE_fdd_enb_radio                    *radio = LTE_fdd_enb_radio::get_instance();
     boost::mutex::scoped_lock             lock(sys_info_mutex);
     LTE_FDD_ENB_READY_TO_SEND_MSG_STRUCT  rts;
+    float                                *static_re;
+    float                                *static_im;
     uint32                                p;
     uint32                                i;
     uint32                                j;
@@ -469,48 +531,62 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
     uint32                                act_noutput_items;
     uint32                                sfn   = dl_current_tti/10;
     uint32                                subfn = dl_current_tti%10;
+    uint32                                N_sc  = phy_struct->cell->N_rb_dl*phy_struct->cell->N_sc_rb_dl;
 
-    // Initialize the output to all zeros
+    // Rebuild the static content if the cell has changed
+    if(sys_info.N_id_cell != dl_static_N_id_cell ||
+       sys_info.N_ant     != dl_static_N_ant)
+    {
+        build_dl_static_content();
+    }
+
+    // Clear only the resource elements written on top of the static
+    // content by the last subframe
     for(p=0; p<sys_info.N_ant; p++)
     {
         for(i=0; i<14; i++)
         {
-            for(j=0; j<LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP; j++)
+            if(dl_dirty_end[i] > dl_dirty_start[i])
             {
-                dl_subframe.tx_symb_re[p][i][j] = 0;
-                dl_subframe.tx_symb_im[p][i][j] = 0;
+                memset(&dl_subframe.tx_symb_re[p][i][dl_dirty_start[i]], 0, sizeof(float)*(dl_dirty_end[i] - dl_dirty_start[i]));
+                memset(&dl_subframe.tx_symb_im[p][i][dl_dirty_start[i]], 0, sizeof(float)*(dl_dirty_end[i] - dl_dirty_start[i]));
             }
         }
     }
+    for(i=0; i<14; i++)
+    {
+        dl_dirty_start[i] = 0;
+        dl_dirty_end[i]   = 0;
+    }
     dl_subframe.num = subfn;
 
-    // Handle PSS and SSS
-    if(0 == dl_subframe.num ||
-       5 == dl_subframe.num)
+    // Handle PSS, SSS, and CRS
+    static_re = &dl_subframe.tx_symb_re[0][0][0];
+    static_im = &dl_subframe.tx_symb_im[0][0][0];
+    for(i=0; i<dl_static_N_re[subfn]; i++)
     {
-        liblte_phy_map_pss(phy_struct,
-                           &dl_subframe,
-                           sys_info.N_id_2,
-                           sys_info.N_ant);
-        liblte_phy_map_sss(phy_struct,
-                           &dl_subframe,
-                           sys_info.N_id_1,
-                           sys_info.N_id_2,
-                           sys_info.N_ant);
+        static_re[dl_static_idx[subfn][i]] = dl_static_re[subfn][i];
+        static_im[dl_static_idx[subfn][i]] = dl_static_im[subfn][i];
+    }
+    if(0 == dl_subframe.num)
+    {
+        // PSS, SSS, and PBCH
+        mark_dl_dirty(5, 10, N_sc/2 - 36, N_sc/2 + 36);
+    }else if(5 == dl_subframe.num){
+        // PSS and SSS
+        mark_dl_dirty(5, 6, N_sc/2 - 36, N_sc/2 + 36);
     }
 
-    // Handle CRS
-    liblte_phy_map_crs(phy_struct,
-                       &dl_subframe,
-                       sys_info.N_id_cell,
-                       sys_info.N_ant);
-
-    // Handle PBCH
+    // Handle PBCH, the MIB only changes every 4 frames
     if(0 == dl_subframe.num)
     {
-        sys_info.mib.sfn_div_4 = sfn/4;
-        liblte_rrc_pack_bcch_bch_msg(&sys_info.mib,
-                                     &dl_rrc_msg);
+        if(dl_mib_sfn_div_4 != sfn/4)
+        {
+            sys_info.mib.sfn_div_4 = sfn/4;
+            liblte_rrc_pack_bcch_bch_msg(&sys_info.mib,
+                                         &dl_rrc_msg);
+            dl_mib_sfn_div_4 = sfn/4;
+        }
         if(!sys_info.mib_pcap_sent)
         {
             interface->send_lte_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_DL,
@@ -623,25 +699,29 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
 
     // Handle user data
     dl_sched_mutex.lock();
-    if(dl_schedule[dl_current_tti%10].current_tti == dl_current_tti)
+    if(NULL != dl_schedule[subfn] &&
+       dl_schedule[subfn]->current_tti == dl_current_tti)
     {
-        for(i=0; i<dl_schedule[subfn].dl_allocations.N_alloc; i++)
+        for(i=0; i<dl_schedule[subfn]->dl_allocations.N_alloc; i++)
         {
-            memcpy(&pdcch.alloc[pdcch.N_alloc], &dl_schedule[subfn].dl_allocations.alloc[i], sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+            memcpy(&pdcch.alloc[pdcch.N_alloc], &dl_schedule[subfn]->dl_allocations.alloc[i], sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
             pdcch.N_alloc++;
         }
-        for(i=0; i<dl_schedule[subfn].ul_allocations.N_alloc; i++)
+        for(i=0; i<dl_schedule[subfn]->ul_allocations.N_alloc; i++)
         {
-            memcpy(&pdcch.alloc[pdcch.N_alloc], &dl_schedule[subfn].ul_allocations.alloc[i], sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+            memcpy(&pdcch.alloc[pdcch.N_alloc], &dl_schedule[subfn]->ul_allocations.alloc[i], sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
             pdcch.N_alloc++;
         }
-    }else{
+    }else if(NULL != dl_schedule[subfn] ||
+             dl_current_tti != subfn){
+        // Until MAC's first schedule for a subframe arrives the subframe
+        // is empty, as it is for the first frame
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                   LTE_FDD_ENB_DEBUG_LEVEL_PHY,
                                   __FILE__,
                                   __LINE__,
                                   "PDSCH current_tti from MAC (%u) does not match PHY (%u)",
-                                  dl_schedule[subfn].current_tti,
+                                  (NULL != dl_schedule[subfn]) ? dl_schedule[subfn]->current_tti : subfn,
                                   dl_current_tti);
     }
     dl_sched_mutex.unlock();
@@ -655,7 +735,7 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
             pdcch.alloc[i].prb[1][j] = last_prb++;
         }
     }
-    if(last_prb > phy_struct->N_rb_dl)
+    if(last_prb > phy_struct->cell->N_rb_dl)
     {
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                   LTE_FDD_ENB_DEBUG_LEVEL_PHY,
@@ -672,6 +752,7 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
                                         liblte_rrc_phich_resource_num[sys_info.mib.phich_config.res],
                                         sys_info.mib.phich_config.dur,
                                         &dl_subframe);
+        mark_dl_dirty(0, 3, 0, N_sc);
         if(0 != pdcch.N_alloc)
         {
             liblte_phy_pdsch_channel_encode(phy_struct,
@@ -679,6 +760,7 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
                                             sys_info.N_id_cell,
                                             sys_info.N_ant,
                                             &dl_subframe);
+            mark_dl_dirty(pdcch.N_symbs, 13, 0, last_prb*phy_struct->cell->N_sc_rb_dl);
         }
         // Clear PHICH
         for(i=0; i<25; i++)
@@ -698,7 +780,7 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
                                       &tx_buf->i_buf[p][0],
                                       &tx_buf->q_buf[p][0]);
     }
-    tx_buf->N_samps_per_ant = phy_struct->N_samps_per_subfr;
+    tx_buf->N_samps_per_ant = phy_struct->cell->N_samps_per_subfr;
     tx_buf->current_tti     = dl_current_tti;
     tx_buf->N_ant           = sys_info.N_ant;
 
@@ -718,6 +800,99 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
     // Send samples to radio
     radio->send(tx_buf);
 }
+void LTE_fdd_enb_phy::build_dl_static_content(void)
+{
+    float  *re   = &dl_subframe.tx_symb_re[0][0][0];
+    float  *im   = &dl_subframe.tx_symb_im[0][0][0];
+    uint32  N_sc = phy_struct->cell->N_rb_dl*phy_struct->cell->N_sc_rb_dl;
+    uint32  subfn;
+    uint32  idx;
+    uint32  p;
+    uint32  i;
+    uint32  j;
+
+    // Map the PSS, SSS, and CRS of each subframe into an empty subframe
+    // and keep the resource elements that were written
+    memset(dl_subframe.tx_symb_re, 0, sizeof(dl_subframe.tx_symb_re));
+    memset(dl_subframe.tx_symb_im, 0, sizeof(dl_subframe.tx_symb_im));
+    for(subfn=0; subfn<10; subfn++)
+    {
+        dl_subframe.num = subfn;
+        if(0 == subfn ||
+           5 == subfn)
+        {
+            liblte_phy_map_pss(phy_struct,
+                               &dl_subframe,
+                               sys_info.N_id_2,
+                               sys_info.N_ant);
+            liblte_phy_map_sss(phy_struct,
+                               &dl_subframe,
+                               sys_info.N_id_1,
+                               sys_info.N_id_2,
+                               sys_info.N_ant);
+        }
+        liblte_phy_map_crs(phy_struct,
+                           &dl_subframe,
+                           sys_info.N_id_cell,
+                           sys_info.N_ant);
+
+        dl_static_N_re[subfn] = 0;
+        for(p=0; p<sys_info.N_ant; p++)
+        {
+            for(i=0; i<14; i++)
+            {
+                for(j=0; j<N_sc; j++)
+                {
+                    idx = &dl_subframe.tx_symb_re[p][i][j] - re;
+                    if((0 != re[idx] ||
+                        0 != im[idx]) &&
+                       LTE_FDD_ENB_PHY_DL_STATIC_RE_MAX > dl_static_N_re[subfn])
+                    {
+                        dl_static_idx[subfn][dl_static_N_re[subfn]] = idx;
+                        dl_static_re[subfn][dl_static_N_re[subfn]]  = re[idx];
+                        dl_static_im[subfn][dl_static_N_re[subfn]]  = im[idx];
+                        dl_static_N_re[subfn]++;
+                    }
+                    re[idx] = 0;
+                    im[idx] = 0;
+                }
+            }
+        }
+    }
+    for(i=0; i<14; i++)
+    {
+        dl_dirty_start[i] = 0;
+        dl_dirty_end[i]   = 0;
+    }
+    dl_static_N_id_cell = sys_info.N_id_cell;
+    dl_static_N_ant     = sys_info.N_ant;
+    dl_mib_sfn_div_4    = 0xFFFFFFFF;
+}
+void LTE_fdd_enb_phy::mark_dl_dirty(uint32 first_symb,
+                                    uint32 last_symb,
+                                    uint32 start_sc,
+                                    uint32 end_sc)
+{
+    uint32 i;
+
+    for(i=first_symb; i<=last_symb; i++)
+    {
+        if(dl_dirty_end[i] > dl_dirty_start[i])
+        {
+            if(start_sc < dl_dirty_start[i])
+            {
+                dl_dirty_start[i] = start_sc;
+            }
+            if(end_sc > dl_dirty_end[i])
+            {
+                dl_dirty_end[i] = end_sc;
+            }
+        }else{
+            dl_dirty_start[i] = start_sc;
+            dl_dirty_end[i]   = end_sc;
+        }
+    }
+}
 
 /****************/
 /*    Uplink    */
@@ -763,7 +938,9 @@ void LTE_fdd_enb_phy::process_ul(LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf)
                                         sys_info.sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_freq_offset,
                                         &prach_decode.num_preambles,
                                         prach_decode.preamble,
-                                        prach_decode.timing_adv);
+                                        prach_decode.timing_adv,
+                                        prach_decode.power,
+                                        &prach_decode.noise_floor);
 
                 msgq_to_mac->send(LTE_FDD_ENB_MESSAGE_TYPE_PRACH_DECODE,
                                   LTE_FDD_ENB_DEST_LAYER_MAC,
@@ -778,35 +955,45 @@ void LTE_fdd_enb_phy::process_ul(LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf)
 
     // Handle PUSCH
     ul_sched_mutex.lock();
-    if(0 != ul_schedule[ul_subframe.num].decodes.N_alloc)
+    if(NULL != ul_schedule[ul_subframe.num] &&
+       0    != ul_schedule[ul_subframe.num]->decodes.N_alloc)
     {
         if(LIBLTE_SUCCESS == liblte_phy_get_ul_subframe(phy_struct,
                                                         rx_buf->i_buf,
                                                         rx_buf->q_buf,
                                                         &ul_subframe))
         {
-            for(i=0; i<ul_schedule[ul_subframe.num].decodes.N_alloc; i++)
+            // Hand the allocations to the decode workers and decode
+            // alongside them until all allocations are done
+            pusch_mutex.lock();
+            pusch_N_alloc    = ul_schedule[ul_subframe.num]->decodes.N_alloc;
+            pusch_next_alloc = 0;
+            pusch_N_done     = 0;
+            pusch_job_id++;
+            pusch_mutex.unlock();
+            pusch_start_cond.notify_all();
+            decode_pusch(phy_struct);
+            {
+                boost::mutex::scoped_lock lock(pusch_mutex);
+                while(pusch_N_done != pusch_N_alloc)
+                {
+                    pusch_done_cond.wait(lock);
+                }
+            }
+
+            // Report results in allocation order
+            for(i=0; i<ul_schedule[ul_subframe.num]->decodes.N_alloc; i++)
             {
                 // Determine PHICH indecies
-                I_prb_ra      = ul_schedule[ul_subframe.num].decodes.alloc[i].prb[0][0];
+                I_prb_ra      = ul_schedule[ul_subframe.num]->decodes.alloc[i].prb[0][0];
                 n_group_phich = I_prb_ra % phy_struct->N_group_phich;
                 n_seq_phich   = (I_prb_ra/phy_struct->N_group_phich) % (2*phy_struct->N_sf_phich);
 
-                // Attempt decode
-                if(LIBLTE_SUCCESS == liblte_phy_pusch_channel_decode(phy_struct,
-                                                                     &ul_subframe,
-                                                                     &ul_schedule[ul_subframe.num].decodes.alloc[i],
-                                                                     sys_info.N_id_cell,
-                                                                     1,
-                                                                     pusch_decode.msg.msg,
-                                                                     &pusch_decode.msg.N_bits))
+                if(pusch_decode_pass[i])
                 {
-                    pusch_decode.current_tti = ul_current_tti;
-                    pusch_decode.rnti        = ul_schedule[ul_subframe.num].decodes.alloc[i].rnti;
-
                     msgq_to_mac->send(LTE_FDD_ENB_MESSAGE_TYPE_PUSCH_DECODE,
                                       LTE_FDD_ENB_DEST_LAYER_MAC,
-                                      (LTE_FDD_ENB_MESSAGE_UNION *)&pusch_decode,
+                                      (LTE_FDD_ENB_MESSAGE_UNION *)&pusch_decode[i],
                                       sizeof(LTE_FDD_ENB_PUSCH_DECODE_MSG_STRUCT));
 
                     // Add ACK to PHICH
@@ -820,9 +1007,76 @@ void LTE_fdd_enb_phy::process_ul(LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf)
             }
         }
     }
-    ul_schedule[ul_subframe.num].decodes.N_alloc = 0;
+    LTE_fdd_enb_buf_pool::release(ul_schedule[ul_subframe.num]);
+    ul_schedule[ul_subframe.num] = NULL;
     ul_sched_mutex.unlock();
 
     // Update counters
     ul_current_tti = (ul_current_tti + 1) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
 }
+void* LTE_fdd_enb_phy::pusch_worker_thread_func(void *inputs)
+{
+    LTE_FDD_ENB_PHY_PUSCH_WORKER_STRUCT *worker = (LTE_FDD_ENB_PHY_PUSCH_WORKER_STRUCT *)inputs;
+    LTE_fdd_enb_phy                     *phy    = worker->phy;
+    struct sched_param                   priority;
+    uint32                               job_id = 0;
+
+    // The radio thread waits on these decodes, so match its priority
+    priority.sched_priority = 99;
+    pthread_setschedparam(worker->thread, SCHED_FIFO, &priority);
+
+    while(1)
+    {
+        {
+            boost::mutex::scoped_lock lock(phy->pusch_mutex);
+            while(phy->pusch_workers_running &&
+                  job_id == phy->pusch_job_id)
+            {
+                phy->pusch_start_cond.wait(lock);
+            }
+            if(!phy->pusch_workers_running)
+            {
+                break;
+            }
+            job_id = phy->pusch_job_id;
+        }
+
+        phy->decode_pusch(worker->phy_struct);
+    }
+
+    return(NULL);
+}
+void LTE_fdd_enb_phy::decode_pusch(LIBLTE_PHY_STRUCT *ws)
+{
+    LIBLTE_PHY_ALLOCATION_STRUCT *alloc;
+    uint32                        i;
+
+    // Allocations are claimed one at a time so a slow decode does not
+    // hold up the others, ul_sched_mutex is held by process_ul
+    pusch_mutex.lock();
+    while(pusch_next_alloc < pusch_N_alloc)
+    {
+        i = pusch_next_alloc++;
+        pusch_mutex.unlock();
+
+        alloc                       = &ul_schedule[ul_subframe.num]->decodes.alloc[i];
+        pusch_decode[i].current_tti = ul_current_tti;
+        pusch_decode[i].rnti        = alloc->rnti;
+        pusch_decode_pass[i]        = (LIBLTE_SUCCESS == liblte_phy_pusch_channel_decode(ws,
+                                                                                         &ul_subframe,
+                                                                                         alloc,
+                                                                                         sys_info.N_id_cell,
+                                                                                         1,
+                                                                                         NULL,
+                                                                                         pusch_decode[i].msg.msg,
+                                                                                         &pusch_decode[i].msg.N_bits));
+
+        pusch_mutex.lock();
+        pusch_N_done++;
+        if(pusch_N_done == pusch_N_alloc)
+        {
+            pusch_done_cond.notify_one();
+        }
+    }
+    pusch_mutex.unlock();
+}
@@ -56,6 +56,7 @@
 
 #include "LTE_fdd_enb_rb.h"
 #include "LTE_fdd_enb_timer_mgr.h"
+#include "LTE_fdd_enb_buf_pool_mgr.h"
 #include "LTE_fdd_enb_user.h"
 #include "LTE_fdd_enb_rlc.h"
 #include "LTE_fdd_enb_mac.h"
@@ -125,6 +126,18 @@ LTE_fdd_enb_rb::LTE_fdd_enb_rb(LTE_FDD_ENB_RB_ENUM  _rb,
         mac_config  = LTE_FDD_ENB_MAC_CONFIG_TM;
     }
 
+    // Message queues
+    gw_data_msg_queue   = new LTE_fdd_enb_rb_queue("gw_data_msg", LTE_FDD_ENB_RB_QUEUE_SIZE);
+    mme_nas_msg_queue   = new LTE_fdd_enb_rb_queue("mme_nas_msg", LTE_FDD_ENB_RB_QUEUE_SIZE);
+    rrc_pdu_queue       = new LTE_fdd_enb_rb_queue("rrc_pdu", LTE_FDD_ENB_RB_QUEUE_SIZE);
+    rrc_nas_msg_queue   = new LTE_fdd_enb_rb_queue("rrc_nas_msg", LTE_FDD_ENB_RB_QUEUE_SIZE);
+    pdcp_pdu_queue      = new LTE_fdd_enb_rb_queue("pdcp_pdu", LTE_FDD_ENB_RB_QUEUE_SIZE);
+    pdcp_sdu_queue      = new LTE_fdd_enb_rb_queue("pdcp_sdu", LTE_FDD_ENB_RB_QUEUE_SIZE);
+    pdcp_data_sdu_queue = new LTE_fdd_enb_rb_queue("pdcp_data_sdu", LTE_FDD_ENB_RB_QUEUE_SIZE);
+    rlc_pdu_queue       = new LTE_fdd_enb_rb_queue("rlc_pdu", LTE_FDD_ENB_RB_QUEUE_SIZE);
+    rlc_sdu_queue       = new LTE_fdd_enb_rb_queue("rlc_sdu", LTE_FDD_ENB_RB_QUEUE_SIZE);
+    mac_sdu_queue       = new LTE_fdd_enb_rb_queue("mac_sdu", LTE_FDD_ENB_RB_QUEUE_SIZE);
+
     // RRC
     rrc_transaction_id = 0;
 
@@ -155,12 +168,38 @@ LTE_fdd_enb_rb::LTE_fdd_enb_rb(LTE_FDD_ENB_RB_ENUM  _rb,
 }
 LTE_fdd_enb_rb::~LTE_fdd_enb_rb()
 {
-    LTE_fdd_enb_timer_mgr *timer_mgr = LTE_fdd_enb_timer_mgr::get_instance();
+    LTE_fdd_enb_timer_mgr                                   *timer_mgr = LTE_fdd_enb_timer_mgr::get_instance();
+    std::map<uint16, LIBLTE_RLC_AMD_PDU_STRUCT *>::iterator  am_iter;
+    std::map<uint16, LIBLTE_BYTE_MSG_STRUCT *>::iterator     um_iter;
 
     if(LTE_FDD_ENB_INVALID_TIMER_ID != t_poll_retransmit_timer_id)
     {
         timer_mgr->stop_timer(t_poll_retransmit_timer_id);
     }
+
+    // Return all queued messages and PDUs to their pools
+    delete gw_data_msg_queue;
+    delete mme_nas_msg_queue;
+    delete rrc_pdu_queue;
+    delete rrc_nas_msg_queue;
+    delete pdcp_pdu_queue;
+    delete pdcp_sdu_queue;
+    delete pdcp_data_sdu_queue;
+    delete rlc_pdu_queue;
+    delete rlc_sdu_queue;
+    delete mac_sdu_queue;
+    for(am_iter=rlc_am_reception_buffer.begin(); am_iter!=rlc_am_reception_buffer.end(); am_iter++)
+    {
+        LTE_fdd_enb_buf_pool::release((*am_iter).second);
+    }
+    for(am_iter=rlc_am_transmission_buffer.begin(); am_iter!=rlc_am_transmission_buffer.end(); am_iter++)
+    {
+        LTE_fdd_enb_buf_pool::release((*am_iter).second);
+    }
+    for(um_iter=rlc_um_reception_buffer.begin(); um_iter!=rlc_um_reception_buffer.end(); um_iter++)
+    {
+        LTE_fdd_enb_buf_pool::release((*um_iter).second);
+    }
 }
 
 /******************/
@@ -180,15 +219,15 @@ void LTE_fdd_enb_rb::reset_user(LTE_fdd_enb_user *_user)
 /************/
 void LTE_fdd_enb_rb::queue_gw_data_msg(LIBLTE_BYTE_MSG_STRUCT *gw_data)
 {
-    queue_msg(gw_data, &gw_data_msg_queue_mutex, &gw_data_msg_queue);
+    queue_msg(gw_data, gw_data_msg_queue);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_gw_data_msg(LIBLTE_BYTE_MSG_STRUCT **gw_data)
 {
-    return(get_next_msg(&gw_data_msg_queue_mutex, &gw_data_msg_queue, gw_data));
+    return(get_next_msg(gw_data_msg_queue, gw_data));
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_gw_data_msg(void)
 {
-    return(delete_next_msg(&gw_data_msg_queue_mutex, &gw_data_msg_queue));
+    return(delete_next_msg(gw_data_msg_queue));
 }
 
 /*************/
@@ -196,15 +235,15 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_gw_data_msg(void)
 /*************/
 void LTE_fdd_enb_rb::queue_mme_nas_msg(LIBLTE_BYTE_MSG_STRUCT *nas_msg)
 {
-    queue_msg(nas_msg, &mme_nas_msg_queue_mutex, &mme_nas_msg_queue);
+    queue_msg(nas_msg, mme_nas_msg_queue);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_mme_nas_msg(LIBLTE_BYTE_MSG_STRUCT **nas_msg)
 {
-    return(get_next_msg(&mme_nas_msg_queue_mutex, &mme_nas_msg_queue, nas_msg));
+    return(get_next_msg(mme_nas_msg_queue, nas_msg));
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_mme_nas_msg(void)
 {
-    return(delete_next_msg(&mme_nas_msg_queue_mutex, &mme_nas_msg_queue));
+    return(delete_next_msg(mme_nas_msg_queue));
 }
 void LTE_fdd_enb_rb::set_mme_procedure(LTE_FDD_ENB_MME_PROC_ENUM procedure)
 {
@@ -252,27 +291,27 @@ LTE_FDD_ENB_MME_STATE_ENUM LTE_fdd_enb_rb::get_mme_state(void)
 /*************/
 void LTE_fdd_enb_rb::queue_rrc_pdu(LIBLTE_BIT_MSG_STRUCT *pdu)
 {
-    queue_msg(pdu, &rrc_pdu_queue_mutex, &rrc_pdu_queue);
+    queue_msg(pdu, rrc_pdu_queue);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_rrc_pdu(LIBLTE_BIT_MSG_STRUCT **pdu)
 {
-    return(get_next_msg(&rrc_pdu_queue_mutex, &rrc_pdu_queue, pdu));
+    return(get_next_msg(rrc_pdu_queue, pdu));
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_rrc_pdu(void)
 {
-    return(delete_next_msg(&rrc_pdu_queue_mutex, &rrc_pdu_queue));
+    return(delete_next_msg(rrc_pdu_queue));
 }
 void LTE_fdd_enb_rb::queue_rrc_nas_msg(LIBLTE_BYTE_MSG_STRUCT *nas_msg)
 {
-    queue_msg(nas_msg, &rrc_nas_msg_queue_mutex, &rrc_nas_msg_queue);
+    queue_msg(nas_msg, rrc_nas_msg_queue);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_rrc_nas_msg(LIBLTE_BYTE_MSG_STRUCT **nas_msg)
 {
-    return(get_next_msg(&rrc_nas_msg_queue_mutex, &rrc_nas_msg_queue, nas_msg));
+    return(get_next_msg(rrc_nas_msg_queue, nas_msg));
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_rrc_nas_msg(void)
 {
-    return(delete_next_msg(&rrc_nas_msg_queue_mutex, &rrc_nas_msg_queue));
+    return(delete_next_msg(rrc_nas_msg_queue));
 }
 void LTE_fdd_enb_rb::set_rrc_procedure(LTE_FDD_ENB_RRC_PROC_ENUM procedure)
 {
@@ -326,39 +365,66 @@ void LTE_fdd_enb_rb::set_rrc_transaction_id(uint8 transaction_id)
 /**************/
 void LTE_fdd_enb_rb::queue_pdcp_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu)
 {
-    queue_msg(pdu, &pdcp_pdu_queue_mutex, &pdcp_pdu_queue);
+    queue_msg(pdu, pdcp_pdu_queue);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_pdcp_pdu(LIBLTE_BYTE_MSG_STRUCT **pdu)
 {
-    return(get_next_msg(&pdcp_pdu_queue_mutex, &pdcp_pdu_queue, pdu));
+    return(get_next_msg(pdcp_pdu_queue, pdu));
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_pdcp_pdu(void)
 {
-    return(delete_next_msg(&pdcp_pdu_queue_mutex, &pdcp_pdu_queue));
+    return(delete_next_msg(pdcp_pdu_queue));
+}
+uint32 LTE_fdd_enb_rb::get_next_pdcp_pdus(LIBLTE_BYTE_MSG_STRUCT **pdu,
+                                          uint32                   N_max)
+{
+    return(pdcp_pdu_queue->peek_many((void **)pdu, N_max));
+}
+uint32 LTE_fdd_enb_rb::delete_next_pdcp_pdus(uint32 N_max)
+{
+    return(pdcp_pdu_queue->pop_many(N_max));
 }
 void LTE_fdd_enb_rb::queue_pdcp_sdu(LIBLTE_BIT_MSG_STRUCT *sdu)
 {
-    queue_msg(sdu, &pdcp_sdu_queue_mutex, &pdcp_sdu_queue);
+    queue_msg(sdu, pdcp_sdu_queue);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_pdcp_sdu(LIBLTE_BIT_MSG_STRUCT **sdu)
 {
-    return(get_next_msg(&pdcp_sdu_queue_mutex, &pdcp_sdu_queue, sdu));
+    return(get_next_msg(pdcp_sdu_queue, sdu));
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_pdcp_sdu(void)
 {
-    return(delete_next_msg(&pdcp_sdu_queue_mutex, &pdcp_sdu_queue));
+    return(delete_next_msg(pdcp_sdu_queue));
+}
+uint32 LTE_fdd_enb_rb::get_next_pdcp_sdus(LIBLTE_BIT_MSG_STRUCT **sdu,
+                                          uint32                  N_max)
+{
+    return(pdcp_sdu_queue->peek_many((void **)sdu, N_max));
+}
+uint32 LTE_fdd_enb_rb::delete_next_pdcp_sdus(uint32 N_max)
+{
+    return(pdcp_sdu_queue->pop_many(N_max));
 }
 void LTE_fdd_enb_rb::queue_pdcp_data_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu)
 {
-    queue_msg(sdu, &pdcp_data_sdu_queue_mutex, &pdcp_data_sdu_queue);
+    queue_msg(sdu, pdcp_data_sdu_queue);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_pdcp_data_sdu(LIBLTE_BYTE_MSG_STRUCT **sdu)
 {
-    return(get_next_msg(&pdcp_data_sdu_queue_mutex, &pdcp_data_sdu_queue, sdu));
+    return(get_next_msg(pdcp_data_sdu_queue, sdu));
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_pdcp_data_sdu(void)
 {
-    return(delete_next_msg(&pdcp_data_sdu_queue_mutex, &pdcp_data_sdu_queue));
+    return(delete_next_msg(pdcp_data_sdu_queue));
+}
+uint32 LTE_fdd_enb_rb::get_next_pdcp_data_sdus(LIBLTE_BYTE_MSG_STRUCT **sdu,
+                                               uint32                   N_max)
+{
+    return(pdcp_data_sdu_queue->peek_many((void **)sdu, N_max));
+}
+uint32 LTE_fdd_enb_rb::delete_next_pdcp_data_sdus(uint32 N_max)
+{
+    return(pdcp_data_sdu_queue->pop_many(N_max));
 }
 void LTE_fdd_enb_rb::set_pdcp_config(LTE_FDD_ENB_PDCP_CONFIG_ENUM config)
 {
@@ -390,27 +456,45 @@ void LTE_fdd_enb_rb::set_pdcp_tx_count(uint32 tx_count)
 /*************/
 void LTE_fdd_enb_rb::queue_rlc_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu)
 {
-    queue_msg(pdu, &rlc_pdu_queue_mutex, &rlc_pdu_queue);
+    queue_msg(pdu, rlc_pdu_queue);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_rlc_pdu(LIBLTE_BYTE_MSG_STRUCT **pdu)
 {
-    return(get_next_msg(&rlc_pdu_queue_mutex, &rlc_pdu_queue, pdu));
+    return(get_next_msg(rlc_pdu_queue, pdu));
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_rlc_pdu(void)
 {
-    return(delete_next_msg(&rlc_pdu_queue_mutex, &rlc_pdu_queue));
+    return(delete_next_msg(rlc_pdu_queue));
+}
+uint32 LTE_fdd_enb_rb::get_next_rlc_pdus(LIBLTE_BYTE_MSG_STRUCT **pdu,
+                                         uint32                   N_max)
+{
+    return(rlc_pdu_queue->peek_many((void **)pdu, N_max));
+}
+uint32 LTE_fdd_enb_rb::delete_next_rlc_pdus(uint32 N_max)
+{
+    return(rlc_pdu_queue->pop_many(N_max));
 }
 void LTE_fdd_enb_rb::queue_rlc_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu)
 {
-    queue_msg(sdu, &rlc_sdu_queue_mutex, &rlc_sdu_queue);
+    queue_msg(sdu, rlc_sdu_queue);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_rlc_sdu(LIBLTE_BYTE_MSG_STRUCT **sdu)
 {
-    return(get_next_msg(&rlc_sdu_queue_mutex, &rlc_sdu_queue, sdu));
+    return(get_next_msg(rlc_sdu_queue, sdu));
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_rlc_sdu(void)
 {
-    return(delete_next_msg(&rlc_sdu_queue_mutex, &rlc_sdu_queue));
+    return(delete_next_msg(rlc_sdu_queue));
+}
+uint32 LTE_fdd_enb_rb::get_next_rlc_sdus(LIBLTE_BYTE_MSG_STRUCT **sdu,
+                                         uint32                   N_max)
+{
+    return(rlc_sdu_queue->peek_many((void **)sdu, N_max));
+}
+uint32 LTE_fdd_enb_rb::delete_next_rlc_sdus(uint32 N_max)
+{
+    return(rlc_sdu_queue->pop_many(N_max));
 }
 LTE_FDD_ENB_RLC_CONFIG_ENUM LTE_fdd_enb_rb::get_rlc_config(void)
 {
@@ -454,20 +538,19 @@ void LTE_fdd_enb_rb::set_rlc_vrh(uint16 vrh)
 }
 void LTE_fdd_enb_rb::rlc_add_to_am_reception_buffer(LIBLTE_RLC_AMD_PDU_STRUCT *amd_pdu)
 {
+    LTE_fdd_enb_buf_pool_mgr                                *pool_mgr = LTE_fdd_enb_buf_pool_mgr::get_instance();
     std::map<uint16, LIBLTE_RLC_AMD_PDU_STRUCT *>::iterator  iter;
-    LIBLTE_RLC_AMD_PDU_STRUCT                               *new_pdu = NULL;
+    LIBLTE_RLC_AMD_PDU_STRUCT                               *new_pdu  = NULL;
 
-    new_pdu = new LIBLTE_RLC_AMD_PDU_STRUCT;
-
-    if(NULL != new_pdu)
+    iter = rlc_am_reception_buffer.find(amd_pdu->hdr.sn);
+    if(rlc_am_reception_buffer.end() == iter)
     {
-        iter = rlc_am_reception_buffer.find(amd_pdu->hdr.sn);
-        if(rlc_am_reception_buffer.end() == iter)
+        new_pdu = (LIBLTE_RLC_AMD_PDU_STRUCT *)pool_mgr->alloc(LTE_FDD_ENB_BUF_POOL_RLC_AMD_PDU);
+
+        if(NULL != new_pdu)
         {
             memcpy(new_pdu, amd_pdu, sizeof(LIBLTE_RLC_AMD_PDU_STRUCT));
             rlc_am_reception_buffer[amd_pdu->hdr.sn] = new_pdu;
-        }else{
-            delete new_pdu;
         }
     }
 }
@@ -528,7 +611,7 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_am_reassemble(LIBLTE_BYTE_MSG_STRUCT
 
         // Somehow the first PDU in the RX buffer is not a full or first SDU
         // Delete until this is true.
-        delete (*iter).second;
+        LTE_fdd_enb_buf_pool::release((*iter).second);
         rlc_am_reception_buffer.erase(iter);
         iter = rlc_am_reception_buffer.begin();
     }
@@ -570,7 +653,7 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_am_reassemble(LIBLTE_BYTE_MSG_STRUCT
                 iter = rlc_am_reception_buffer.find(i);
                 memcpy(&sdu->msg[sdu->N_bytes], (*iter).second->data[0].msg, (*iter).second->data[0].N_bytes);
                 sdu->N_bytes += (*iter).second->data[0].N_bytes;
-                delete (*iter).second;
+                LTE_fdd_enb_buf_pool::release((*iter).second);
                 rlc_am_reception_buffer.erase(iter);
             }
             iter = rlc_am_reception_buffer.find(last);
@@ -579,7 +662,7 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_am_reassemble(LIBLTE_BYTE_MSG_STRUCT
             if(LIBLTE_RLC_FI_FIELD_LAST_SDU_SEGMENT == (*iter).second->hdr.fi ||
                LIBLTE_RLC_FI_FIELD_FULL_SDU         == (*iter).second->hdr.fi)
             {
-                delete (*iter).second;
+                LTE_fdd_enb_buf_pool::release((*iter).second);
                 rlc_am_reception_buffer.erase(iter);
             }else{
                 memcpy((*iter).second->data[0].msg, (*iter).second->data[1].msg, (*iter).second->data[1].N_bytes);
@@ -618,13 +701,22 @@ void LTE_fdd_enb_rb::set_rlc_vts(uint16 vts)
 }
 void LTE_fdd_enb_rb::rlc_add_to_transmission_buffer(LIBLTE_RLC_AMD_PDU_STRUCT *amd_pdu)
 {
-    LIBLTE_RLC_AMD_PDU_STRUCT *new_pdu = NULL;
+    LTE_fdd_enb_buf_pool_mgr                                *pool_mgr = LTE_fdd_enb_buf_pool_mgr::get_instance();
+    std::map<uint16, LIBLTE_RLC_AMD_PDU_STRUCT *>::iterator  iter;
+    LIBLTE_RLC_AMD_PDU_STRUCT                               *new_pdu  = NULL;
 
-    new_pdu = new LIBLTE_RLC_AMD_PDU_STRUCT;
+    new_pdu = (LIBLTE_RLC_AMD_PDU_STRUCT *)pool_mgr->alloc(LTE_FDD_ENB_BUF_POOL_RLC_AMD_PDU);
 
     if(NULL != new_pdu)
     {
         memcpy(new_pdu, amd_pdu, sizeof(LIBLTE_RLC_AMD_PDU_STRUCT));
+
+        // Replace any earlier copy of this SN rather than leak it
+        iter = rlc_am_transmission_buffer.find(amd_pdu->hdr.sn);
+        if(rlc_am_transmission_buffer.end() != iter)
+        {
+            LTE_fdd_enb_buf_pool::release((*iter).second);
+        }
         rlc_am_transmission_buffer[amd_pdu->hdr.sn] = new_pdu;
     }
 }
@@ -653,7 +745,7 @@ void LTE_fdd_enb_rb::rlc_update_transmission_buffer(LIBLTE_RLC_STATUS_PDU_STRUCT
             iter = rlc_am_transmission_buffer.find(i);
             if(rlc_am_transmission_buffer.end() != iter)
             {
-                delete (*iter).second;
+                LTE_fdd_enb_buf_pool::release((*iter).second);
                 rlc_am_transmission_buffer.erase(iter);
                 if(update_vta)
                 {
@@ -725,15 +817,16 @@ uint16 LTE_fdd_enb_rb::get_rlc_um_window_size(void)
 void LTE_fdd_enb_rb::rlc_add_to_um_reception_buffer(LIBLTE_RLC_UMD_PDU_STRUCT *umd_pdu,
                                                     uint32                     idx)
 {
+    LTE_fdd_enb_buf_pool_mgr                             *pool_mgr = LTE_fdd_enb_buf_pool_mgr::get_instance();
     std::map<uint16, LIBLTE_BYTE_MSG_STRUCT *>::iterator  iter;
-    LIBLTE_BYTE_MSG_STRUCT                               *new_pdu = NULL;
+    LIBLTE_BYTE_MSG_STRUCT                               *new_pdu  = NULL;
 
-    new_pdu = new LIBLTE_BYTE_MSG_STRUCT;
-
-    if(NULL != new_pdu)
+    iter = rlc_um_reception_buffer.find(umd_pdu->hdr.sn);
+    if(rlc_um_reception_buffer.end() == iter)
     {
-        iter = rlc_um_reception_buffer.find(umd_pdu->hdr.sn);
-        if(rlc_um_reception_buffer.end() == iter)
+        new_pdu = (LIBLTE_BYTE_MSG_STRUCT *)pool_mgr->alloc(LTE_FDD_ENB_BUF_POOL_BYTE_MSG);
+
+        if(NULL != new_pdu)
         {
             memcpy(new_pdu, &umd_pdu->data[idx], sizeof(LIBLTE_BYTE_MSG_STRUCT));
             rlc_um_reception_buffer[umd_pdu->hdr.sn] = new_pdu;
@@ -751,8 +844,6 @@ void LTE_fdd_enb_rb::rlc_add_to_um_reception_buffer(LIBLTE_RLC_UMD_PDU_STRUCT *u
             {
                 rlc_last_um_segment_sn = 0xFFFF;
             }
-        }else{
-            delete new_pdu;
         }
     }
 }
@@ -785,7 +876,7 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_um_reassemble(LIBLTE_BYTE_MSG_STRUCT
                 iter = rlc_um_reception_buffer.find(i);
                 memcpy(&sdu->msg[sdu->N_bytes], (*iter).second->msg, (*iter).second->N_bytes);
                 sdu->N_bytes += (*iter).second->N_bytes;
-                delete (*iter).second;
+                LTE_fdd_enb_buf_pool::release((*iter).second);
                 rlc_um_reception_buffer.erase(iter);
             }
 
@@ -813,15 +904,28 @@ uint16 LTE_fdd_enb_rb::get_rlc_vtus(void)
 /*************/
 void LTE_fdd_enb_rb::queue_mac_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu)
 {
-    queue_msg(sdu, &mac_sdu_queue_mutex, &mac_sdu_queue);
+    queue_msg(sdu, mac_sdu_queue);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_mac_sdu(LIBLTE_BYTE_MSG_STRUCT **sdu)
 {
-    return(get_next_msg(&mac_sdu_queue_mutex, &mac_sdu_queue, sdu));
+    return(get_next_msg(mac_sdu_queue, sdu));
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_mac_sdu(void)
 {
-    return(delete_next_msg(&mac_sdu_queue_mutex, &mac_sdu_queue));
+    return(delete_next_msg(mac_sdu_queue));
+}
+uint32 LTE_fdd_enb_rb::get_next_mac_sdus(LIBLTE_BYTE_MSG_STRUCT **sdu,
+                                         uint32                   N_max)
+{
+    return(mac_sdu_queue->peek_many((void **)sdu, N_max));
+}
+uint32 LTE_fdd_enb_rb::delete_next_mac_sdus(uint32 N_max)
+{
+    return(mac_sdu_queue->pop_many(N_max));
+}
+uint32 LTE_fdd_enb_rb::get_mac_sdu_queue_bytes(void)
+{
+    return(mac_sdu_queue->get_N_bytes());
 }
 LTE_FDD_ENB_MAC_CONFIG_ENUM LTE_fdd_enb_rb::get_mac_config(void)
 {
@@ -891,91 +995,89 @@ uint8 LTE_fdd_enb_rb::get_log_chan_group(void)
 /*****************/
 /*    Generic    */
 /*****************/
-void LTE_fdd_enb_rb::queue_msg(LIBLTE_BIT_MSG_STRUCT              *msg,
-                               boost::mutex                       *mutex,
-                               std::list<LIBLTE_BIT_MSG_STRUCT *> *queue)
+void LTE_fdd_enb_rb::queue_msg(LIBLTE_BIT_MSG_STRUCT *msg,
+                               LTE_fdd_enb_rb_queue  *queue)
 {
-    boost::mutex::scoped_lock  lock(*mutex);
-    LIBLTE_BIT_MSG_STRUCT     *loc_msg;
+    LTE_fdd_enb_buf_pool_mgr *pool_mgr = LTE_fdd_enb_buf_pool_mgr::get_instance();
+    LIBLTE_BIT_MSG_STRUCT    *loc_msg;
 
-    loc_msg = new LIBLTE_BIT_MSG_STRUCT;
-    memcpy(loc_msg, msg, sizeof(LIBLTE_BIT_MSG_STRUCT));
+    loc_msg = (LIBLTE_BIT_MSG_STRUCT *)pool_mgr->alloc(LTE_FDD_ENB_BUF_POOL_BIT_MSG);
 
-    queue->push_back(loc_msg);
+    if(NULL != loc_msg)
+    {
+        memcpy(loc_msg, msg, sizeof(LIBLTE_BIT_MSG_STRUCT));
+        if(!queue->push(loc_msg, (msg->N_bits + 7) / 8))
+        {
+            report_queue_full(queue);
+            LTE_fdd_enb_buf_pool::release(loc_msg);
+        }
+    }
 }
-void LTE_fdd_enb_rb::queue_msg(LIBLTE_BYTE_MSG_STRUCT              *msg,
-                               boost::mutex                        *mutex,
-                               std::list<LIBLTE_BYTE_MSG_STRUCT *> *queue)
+void LTE_fdd_enb_rb::queue_msg(LIBLTE_BYTE_MSG_STRUCT *msg,
+                               LTE_fdd_enb_rb_queue   *queue)
 {
-    boost::mutex::scoped_lock  lock(*mutex);
-    LIBLTE_BYTE_MSG_STRUCT    *loc_msg;
+    LTE_fdd_enb_buf_pool_mgr *pool_mgr = LTE_fdd_enb_buf_pool_mgr::get_instance();
+    LIBLTE_BYTE_MSG_STRUCT   *loc_msg;
 
-    loc_msg = new LIBLTE_BYTE_MSG_STRUCT;
-    memcpy(loc_msg, msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+    loc_msg = (LIBLTE_BYTE_MSG_STRUCT *)pool_mgr->alloc(LTE_FDD_ENB_BUF_POOL_BYTE_MSG);
 
-    queue->push_back(loc_msg);
-}
-LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_msg(boost::mutex                        *mutex,
-                                                    std::list<LIBLTE_BIT_MSG_STRUCT *>  *queue,
-                                                    LIBLTE_BIT_MSG_STRUCT              **msg)
-{
-    boost::mutex::scoped_lock lock(*mutex);
-    LTE_FDD_ENB_ERROR_ENUM    err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
-
-    if(0 != queue->size())
+    if(NULL != loc_msg)
     {
-        *msg = queue->front();
-        err  = LTE_FDD_ENB_ERROR_NONE;
+        memcpy(loc_msg, msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+        if(!queue->push(loc_msg, msg->N_bytes))
+        {
+            report_queue_full(queue);
+            LTE_fdd_enb_buf_pool::release(loc_msg);
+        }
     }
-
-    return(err);
 }
-LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_msg(boost::mutex                         *mutex,
-                                                    std::list<LIBLTE_BYTE_MSG_STRUCT *>  *queue,
-                                                    LIBLTE_BYTE_MSG_STRUCT              **msg)
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_msg(LTE_fdd_enb_rb_queue   *queue,
+                                                    LIBLTE_BIT_MSG_STRUCT **msg)
 {
-    boost::mutex::scoped_lock lock(*mutex);
-    LTE_FDD_ENB_ERROR_ENUM    err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
+    LTE_FDD_ENB_ERROR_ENUM err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
 
-    if(0 != queue->size())
+    *msg = (LIBLTE_BIT_MSG_STRUCT *)queue->peek();
+    if(NULL != *msg)
     {
-        *msg = queue->front();
-        err  = LTE_FDD_ENB_ERROR_NONE;
+        err = LTE_FDD_ENB_ERROR_NONE;
     }
 
     return(err);
 }
-LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_msg(boost::mutex                       *mutex,
-                                                       std::list<LIBLTE_BIT_MSG_STRUCT *> *queue)
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_msg(LTE_fdd_enb_rb_queue    *queue,
+                                                    LIBLTE_BYTE_MSG_STRUCT **msg)
 {
-    boost::mutex::scoped_lock  lock(*mutex);
-    LTE_FDD_ENB_ERROR_ENUM     err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
-    LIBLTE_BIT_MSG_STRUCT     *msg;
+    LTE_FDD_ENB_ERROR_ENUM err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
 
-    if(0 != queue->size())
+    *msg = (LIBLTE_BYTE_MSG_STRUCT *)queue->peek();
+    if(NULL != *msg)
     {
-        msg = queue->front();
-        queue->pop_front();
-        delete msg;
         err = LTE_FDD_ENB_ERROR_NONE;
     }
 
     return(err);
 }
-LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_msg(boost::mutex                        *mutex,
-                                                       std::list<LIBLTE_BYTE_MSG_STRUCT *> *queue)
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_msg(LTE_fdd_enb_rb_queue *queue)
 {
-    boost::mutex::scoped_lock  lock(*mutex);
-    LTE_FDD_ENB_ERROR_ENUM     err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
-    LIBLTE_BYTE_MSG_STRUCT    *msg;
+    LTE_FDD_ENB_ERROR_ENUM err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
 
-    if(0 != queue->size())
+    if(queue->pop())
     {
-        msg = queue->front();
-        queue->pop_front();
-        delete msg;
         err = LTE_FDD_ENB_ERROR_NONE;
     }
 
     return(err);
 }
+void LTE_fdd_enb_rb::report_queue_full(LTE_fdd_enb_rb_queue *queue)
+{
+    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
+
+    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RB,
+                              __FILE__,
+                              __LINE__,
+                              "%s %s queue full for RNTI=%u, dropping message",
+                              LTE_fdd_enb_rb_text[rb],
+                              queue->get_queue_name().c_str(),
+                              user->get_c_rnti());
+}
@@ -0,0 +1,167 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_rb_queue.cc
+
+    Description: Contains all the implementations for the LTE FDD eNodeB
+                 radio bearer message queue.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/18/2026    agent            Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_rb_queue.h"
+#include "LTE_fdd_enb_buf_pool.h"
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+/********************************/
+/*    Constructor/Destructor    */
+/********************************/
+LTE_fdd_enb_rb_queue::LTE_fdd_enb_rb_queue(std::string _queue_name,
+                                           uint32      _size)
+{
+    // Power of two size so indices wrap with a mask
+    ring_size = 1;
+    while(ring_size < _size)
+    {
+        ring_size <<= 1;
+    }
+    ring_mask  = ring_size - 1;
+    ring       = new LTE_FDD_ENB_RB_QUEUE_ENTRY_STRUCT[ring_size];
+    queue_name = _queue_name;
+    head       = 0;
+    N_msgs     = 0;
+    N_bytes    = 0;
+}
+LTE_fdd_enb_rb_queue::~LTE_fdd_enb_rb_queue()
+{
+    while(0 != pop_many(ring_size));
+
+    delete [] ring;
+}
+
+/***********************/
+/*    Push/Peek/Pop    */
+/***********************/
+bool LTE_fdd_enb_rb_queue::push(void   *msg,
+                                uint32  msg_bytes)
+{
+    boost::mutex::scoped_lock          lock(mutex);
+    LTE_FDD_ENB_RB_QUEUE_ENTRY_STRUCT *entry;
+
+    if(ring_size == N_msgs)
+    {
+        return(false);
+    }
+
+    entry          = &ring[(head + N_msgs) & ring_mask];
+    entry->msg     = msg;
+    entry->N_bytes = msg_bytes;
+    N_msgs++;
+    N_bytes += msg_bytes;
+
+    return(true);
+}
+void* LTE_fdd_enb_rb_queue::peek(void)
+{
+    boost::mutex::scoped_lock lock(mutex);
+
+    if(0 == N_msgs)
+    {
+        return(NULL);
+    }
+
+    return(ring[head].msg);
+}
+uint32 LTE_fdd_enb_rb_queue::peek_many(void   **msgs,
+                                       uint32   N_max)
+{
+    boost::mutex::scoped_lock lock(mutex);
+    uint32                    i;
+
+    for(i=0; i<N_max && i<N_msgs; i++)
+    {
+        msgs[i] = ring[(head + i) & ring_mask].msg;
+    }
+
+    return(i);
+}
+bool LTE_fdd_enb_rb_queue::pop(void)
+{
+    return(1 == pop_many(1));
+}
+uint32 LTE_fdd_enb_rb_queue::pop_many(uint32 N_max)
+{
+    boost::mutex::scoped_lock lock(mutex);
+    uint32                    i;
+
+    for(i=0; i<N_max && 0<N_msgs; i++)
+    {
+        LTE_fdd_enb_buf_pool::release(ring[head].msg);
+        N_bytes -= ring[head].N_bytes;
+        head     = (head + 1) & ring_mask;
+        N_msgs--;
+    }
+
+    return(i);
+}
+
+/****************/
+/*    Status    */
+/****************/
+std::string LTE_fdd_enb_rb_queue::get_queue_name(void)
+{
+    return(queue_name);
+}
+uint32 LTE_fdd_enb_rb_queue::get_N_msgs(void)
+{
+    boost::mutex::scoped_lock lock(mutex);
+
+    return(N_msgs);
+}
+uint32 LTE_fdd_enb_rb_queue::get_N_bytes(void)
+{
+    boost::mutex::scoped_lock lock(mutex);
+
+    return(N_bytes);
+}
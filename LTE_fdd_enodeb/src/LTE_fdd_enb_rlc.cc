@@ -253,10 +253,18 @@ void LTE_fdd_enb_rlc::handle_retransmit(LIBLTE_RLC_AMD_PDU_STRUCT *amd,
 /******************************/
 void LTE_fdd_enb_rlc::handle_pdu_ready(LTE_FDD_ENB_RLC_PDU_READY_MSG_STRUCT *pdu_ready)
 {
+    LIBLTE_BYTE_MSG_STRUCT *pdus[LTE_FDD_ENB_RLC_MAX_BATCH_SIZE];
     LIBLTE_BYTE_MSG_STRUCT *pdu;
+    uint32                  N_pdus;
+    uint32                  j;
 
-    if(LTE_FDD_ENB_ERROR_NONE == pdu_ready->rb->get_next_rlc_pdu(&pdu))
+    // Each ready message signals one entry, but earlier messages may
+    // already have drained it along with their own
+    N_pdus = pdu_ready->rb->get_next_rlc_pdus(pdus, LTE_FDD_ENB_RLC_MAX_BATCH_SIZE);
+    for(j=0; j<N_pdus; j++)
     {
+        pdu = pdus[j];
+
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                   LTE_FDD_ENB_DEBUG_LEVEL_RLC,
                                   __FILE__,
@@ -289,16 +297,10 @@ void LTE_fdd_enb_rlc::handle_pdu_ready(LTE_FDD_ENB_RLC_PDU_READY_MSG_STRUCT *pdu
                                       LTE_fdd_enb_rlc_config_text[pdu_ready->rb->get_rlc_config()]);
             break;
         }
-
-        // Delete the PDU
-        pdu_ready->rb->delete_next_rlc_pdu();
-    }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received pdu_ready message with no PDU queued");
     }
+
+    // Delete the PDUs
+    pdu_ready->rb->delete_next_rlc_pdus(N_pdus);
 }
 void LTE_fdd_enb_rlc::handle_tm_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
                                     LTE_fdd_enb_user       *user,
@@ -568,10 +570,18 @@ void LTE_fdd_enb_rlc::handle_status_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
 /*******************************/
 void LTE_fdd_enb_rlc::handle_sdu_ready(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT *sdu_ready)
 {
+    LIBLTE_BYTE_MSG_STRUCT *sdus[LTE_FDD_ENB_RLC_MAX_BATCH_SIZE];
     LIBLTE_BYTE_MSG_STRUCT *sdu;
+    uint32                  N_sdus;
+    uint32                  j;
 
-    if(LTE_FDD_ENB_ERROR_NONE == sdu_ready->rb->get_next_rlc_sdu(&sdu))
+    // Each ready message signals one entry, but earlier messages may
+    // already have drained it along with their own
+    N_sdus = sdu_ready->rb->get_next_rlc_sdus(sdus, LTE_FDD_ENB_RLC_MAX_BATCH_SIZE);
+    for(j=0; j<N_sdus; j++)
     {
+        sdu = sdus[j];
+
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                   LTE_FDD_ENB_DEBUG_LEVEL_RLC,
                                   __FILE__,
@@ -603,16 +613,10 @@ void LTE_fdd_enb_rlc::handle_sdu_ready(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT *sdu
                                       LTE_fdd_enb_rlc_config_text[sdu_ready->rb->get_rlc_config()]);
             break;
         }
-
-        // Delete the SDU
-        sdu_ready->rb->delete_next_rlc_sdu();
-    }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received sdu_ready message with no SDU queued");
     }
+
+    // Delete the SDUs
+    sdu_ready->rb->delete_next_rlc_sdus(N_sdus);
 }
 void LTE_fdd_enb_rlc::handle_tm_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu,
                                     LTE_fdd_enb_user       *user,
@@ -21,7 +21,7 @@
     File: LTE_fdd_enb_timer.cc
 
     Description: Contains all the implementations for the LTE FDD eNodeB
-                 timer class.
+                 timer callback.
 
     Revision History
     ----------    -------------    --------------------------------------------
@@ -72,49 +72,3 @@ void LTE_fdd_enb_timer_cb::operator()(uint32 id)
 {
     return (*func)(obj, id);
 }
-
-/********************************/
-/*    Constructor/Destructor    */
-/********************************/
-LTE_fdd_enb_timer::LTE_fdd_enb_timer(uint32               m_seconds,
-                                     uint32               _id,
-                                     LTE_fdd_enb_timer_cb _cb)
-{
-    cb                = _cb;
-    id                = _id;
-    expiry_m_seconds  = m_seconds;
-    current_m_seconds = 0;
-}
-LTE_fdd_enb_timer::~LTE_fdd_enb_timer()
-{
-}
-
-/****************************/
-/*    External Interface    */
-/****************************/
-void LTE_fdd_enb_timer::reset(void)
-{
-    current_m_seconds = 0;
-}
-void LTE_fdd_enb_timer::increment(void)
-{
-    current_m_seconds++;
-}
-bool LTE_fdd_enb_timer::expired(void)
-{
-    bool exp = false;
-
-    if(current_m_seconds > expiry_m_seconds)
-    {
-        exp = true;
-    }
-
-    return(exp);
-}
-void LTE_fdd_enb_timer::call_callback(void)
-{
-    if(expired())
-    {
-        cb(id);
-    }
-}
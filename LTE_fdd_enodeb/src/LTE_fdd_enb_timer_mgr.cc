@@ -40,7 +40,6 @@
 
 #include "LTE_fdd_enb_timer_mgr.h"
 #include "LTE_fdd_enb_user_mgr.h"
-#include <list>
 
 /*******************************************************************************
                               DEFINES
@@ -93,11 +92,37 @@ void LTE_fdd_enb_timer_mgr::cleanup(void)
 /********************************/
 LTE_fdd_enb_timer_mgr::LTE_fdd_enb_timer_mgr()
 {
+    uint32 i;
+    uint32 j;
+
     interface = NULL;
     started   = false;
+
+    // Timer Storage
+    free_timers = NULL;
+
+    // Timing Wheel
+    for(i=0; i<LTE_FDD_ENB_TIMER_WHEEL_L0_SIZE; i++)
+    {
+        wheel_l0[i] = NULL;
+    }
+    for(i=0; i<LTE_FDD_ENB_TIMER_WHEEL_N_LEVELS-1; i++)
+    {
+        for(j=0; j<LTE_FDD_ENB_TIMER_WHEEL_LN_SIZE; j++)
+        {
+            wheel_ln[i][j] = NULL;
+        }
+    }
+    current_tick = 0;
 }
 LTE_fdd_enb_timer_mgr::~LTE_fdd_enb_timer_mgr()
 {
+    uint32 i;
+
+    for(i=0; i<timer_pool.size(); i++)
+    {
+        delete timer_pool[i];
+    }
 }
 
 /********************/
@@ -113,7 +138,6 @@ void LTE_fdd_enb_timer_mgr::start(LTE_fdd_enb_msgq      *from_mac,
     {
         interface     = iface;
         started       = true;
-        next_timer_id = 0;
         msgq_from_mac = from_mac;
         msgq_from_mac->attach_rx(timer_cb);
     }
@@ -135,38 +159,38 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_timer_mgr::start_timer(uint32
                                                           LTE_fdd_enb_timer_cb  cb,
                                                           uint32               *timer_id)
 {
-    boost::mutex::scoped_lock                        lock(timer_mutex);
-    std::map<uint32, LTE_fdd_enb_timer *>::iterator  iter      = timer_map.find(next_timer_id);
-    LTE_fdd_enb_timer                               *new_timer = NULL;
-    LTE_FDD_ENB_ERROR_ENUM                           err       = LTE_FDD_ENB_ERROR_BAD_ALLOC;
-
-    while(timer_map.end()              != iter &&
-          LTE_FDD_ENB_INVALID_TIMER_ID != next_timer_id)
-    {
-        next_timer_id++;
-        iter = timer_map.find(next_timer_id);
-    }
-    new_timer = new LTE_fdd_enb_timer(m_seconds, next_timer_id, cb);
+    boost::mutex::scoped_lock  lock(timer_mutex);
+    LTE_FDD_ENB_TIMER_STRUCT  *new_timer = alloc_timer();
+    LTE_FDD_ENB_ERROR_ENUM     err       = LTE_FDD_ENB_ERROR_BAD_ALLOC;
 
     if(NULL != new_timer)
     {
-        *timer_id                  = next_timer_id;
-        timer_map[next_timer_id++] = new_timer;
-        err                        = LTE_FDD_ENB_ERROR_NONE;
+        new_timer->cb          = cb;
+        new_timer->state       = LTE_FDD_ENB_TIMER_STATE_RUNNING;
+        new_timer->m_seconds   = m_seconds;
+        new_timer->expiry_tick = current_tick + m_seconds;
+        add_to_wheel(new_timer);
+        *timer_id = new_timer->id;
+        err       = LTE_FDD_ENB_ERROR_NONE;
     }
 
     return(err);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_timer_mgr::stop_timer(uint32 timer_id)
 {
-    boost::mutex::scoped_lock                       lock(timer_mutex);
-    std::map<uint32, LTE_fdd_enb_timer *>::iterator iter = timer_map.find(timer_id);
-    LTE_FDD_ENB_ERROR_ENUM                          err  = LTE_FDD_ENB_ERROR_TIMER_NOT_FOUND;
+    boost::mutex::scoped_lock  lock(timer_mutex);
+    LTE_FDD_ENB_TIMER_STRUCT  *timer = find_timer(timer_id);
+    LTE_FDD_ENB_ERROR_ENUM     err   = LTE_FDD_ENB_ERROR_TIMER_NOT_FOUND;
 
-    if(timer_map.end() != iter)
+    if(NULL != timer)
     {
-        delete (*iter).second;
-        timer_map.erase(iter);
+        // Expired timers are waiting in the callback batch, freeing
+        // them here keeps handle_tick from calling their callbacks
+        if(LTE_FDD_ENB_TIMER_STATE_RUNNING == timer->state)
+        {
+            remove_from_wheel(timer);
+        }
+        free_timer(timer);
         err = LTE_FDD_ENB_ERROR_NONE;
     }
 
@@ -174,13 +198,21 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_timer_mgr::stop_timer(uint32 timer_id)
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_timer_mgr::reset_timer(uint32 timer_id)
 {
-    boost::mutex::scoped_lock                       lock(timer_mutex);
-    std::map<uint32, LTE_fdd_enb_timer *>::iterator iter = timer_map.find(timer_id);
-    LTE_FDD_ENB_ERROR_ENUM                          err  = LTE_FDD_ENB_ERROR_TIMER_NOT_FOUND;
+    boost::mutex::scoped_lock  lock(timer_mutex);
+    LTE_FDD_ENB_TIMER_STRUCT  *timer = find_timer(timer_id);
+    LTE_FDD_ENB_ERROR_ENUM     err   = LTE_FDD_ENB_ERROR_TIMER_NOT_FOUND;
 
-    if(timer_map.end() != iter)
+    if(NULL != timer)
     {
-        (*iter).second->reset();
+        // Resetting an expired timer before its callback is called
+        // puts it back on the wheel instead of calling the callback
+        if(LTE_FDD_ENB_TIMER_STATE_RUNNING == timer->state)
+        {
+            remove_from_wheel(timer);
+        }
+        timer->state       = LTE_FDD_ENB_TIMER_STATE_RUNNING;
+        timer->expiry_tick = current_tick + timer->m_seconds;
+        add_to_wheel(timer);
         err = LTE_FDD_ENB_ERROR_NONE;
     }
 
@@ -220,35 +252,200 @@ void LTE_fdd_enb_timer_mgr::handle_msg(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
 }
 void LTE_fdd_enb_timer_mgr::handle_tick(void)
 {
-    LTE_fdd_enb_user_mgr                            *user_mgr = LTE_fdd_enb_user_mgr::get_instance();
-    std::map<uint32, LTE_fdd_enb_timer *>::iterator  iter;
-    std::list<uint32>                                expired_list;
+    LTE_fdd_enb_user_mgr     *user_mgr = LTE_fdd_enb_user_mgr::get_instance();
+    LTE_FDD_ENB_TIMER_STRUCT *timer;
+    LTE_fdd_enb_timer_cb      cb;
+    uint32                    idx;
+    uint32                    id;
+    uint32                    level;
+    uint32                    i;
+    bool                      call_cb;
 
     timer_mutex.lock();
-    for(iter=timer_map.begin(); iter!=timer_map.end(); iter++)
-    {
-        (*iter).second->increment();
 
-        if((*iter).second->expired())
+    // Refill the first level from the coarser levels each time it wraps
+    idx = current_tick & LTE_FDD_ENB_TIMER_WHEEL_L0_MASK;
+    if(0 == idx)
+    {
+        for(level=1; level<LTE_FDD_ENB_TIMER_WHEEL_N_LEVELS; level++)
         {
-            expired_list.push_back((*iter).first);
+            if(0 != cascade(level))
+            {
+                break;
+            }
         }
     }
+
+    // Every timer in the current slot has expired
+    timer         = wheel_l0[idx];
+    wheel_l0[idx] = NULL;
+    while(NULL != timer)
+    {
+        timer->state = LTE_FDD_ENB_TIMER_STATE_EXPIRED;
+        timer->slot  = NULL;
+        expired_timers.push_back(timer);
+        timer = timer->next;
+    }
+    current_tick++;
     timer_mutex.unlock();
 
-    // Delete expired timers
-    while(0 != expired_list.size())
+    // Call the callbacks without holding the timer mutex, since they
+    // are free to start, stop, and reset timers
+    for(i=0; i<expired_timers.size(); i++)
     {
-        iter = timer_map.find(expired_list.front());
-        if(timer_map.end() != iter)
+        timer_mutex.lock();
+        timer   = expired_timers[i];
+        call_cb = false;
+        if(LTE_FDD_ENB_TIMER_STATE_EXPIRED == timer->state)
         {
-            (*iter).second->call_callback();
-            delete (*iter).second;
-            timer_map.erase(iter);
+            cb      = timer->cb;
+            id      = timer->id;
+            call_cb = true;
+            free_timer(timer);
+        }
+        timer_mutex.unlock();
+
+        if(call_cb)
+        {
+            cb(id);
         }
-        expired_list.pop_front();
     }
+    expired_timers.clear();
 
     // Pass tick to user_mgr
     user_mgr->handle_tick();
 }
+
+/***********************/
+/*    Timer Storage    */
+/***********************/
+LTE_FDD_ENB_TIMER_STRUCT* LTE_fdd_enb_timer_mgr::alloc_timer(void)
+{
+    LTE_FDD_ENB_TIMER_STRUCT *timer = free_timers;
+    uint32                    seq;
+
+    if(NULL != timer)
+    {
+        free_timers = timer->next;
+
+        // Bump the sequence number so ids of the previous use go stale
+        seq       = (timer->id >> LTE_FDD_ENB_TIMER_INDEX_BITS) + 1;
+        timer->id = (seq << LTE_FDD_ENB_TIMER_INDEX_BITS) | (timer->id & LTE_FDD_ENB_TIMER_INDEX_MASK);
+        if(LTE_FDD_ENB_INVALID_TIMER_ID == timer->id)
+        {
+            timer->id &= LTE_FDD_ENB_TIMER_INDEX_MASK;
+        }
+    }else if(LTE_FDD_ENB_TIMER_MAX_TIMERS > timer_pool.size()){
+        // Timers are only allocated when the pool is empty and are
+        // kept for reuse until the timer manager is destroyed
+        timer = new LTE_FDD_ENB_TIMER_STRUCT;
+        if(NULL != timer)
+        {
+            timer->id = timer_pool.size();
+            timer_pool.push_back(timer);
+        }
+    }
+
+    if(NULL != timer)
+    {
+        timer->next = NULL;
+        timer->prev = NULL;
+        timer->slot = NULL;
+    }
+
+    return(timer);
+}
+void LTE_fdd_enb_timer_mgr::free_timer(LTE_FDD_ENB_TIMER_STRUCT *timer)
+{
+    timer->state = LTE_FDD_ENB_TIMER_STATE_FREE;
+    timer->next  = free_timers;
+    free_timers  = timer;
+}
+LTE_FDD_ENB_TIMER_STRUCT* LTE_fdd_enb_timer_mgr::find_timer(uint32 timer_id)
+{
+    LTE_FDD_ENB_TIMER_STRUCT *timer = NULL;
+    uint32                    idx   = timer_id & LTE_FDD_ENB_TIMER_INDEX_MASK;
+
+    if(idx                          <  timer_pool.size()   &&
+       timer_id                     == timer_pool[idx]->id &&
+       LTE_FDD_ENB_TIMER_STATE_FREE != timer_pool[idx]->state)
+    {
+        timer = timer_pool[idx];
+    }
+
+    return(timer);
+}
+
+/**********************/
+/*    Timing Wheel    */
+/**********************/
+void LTE_fdd_enb_timer_mgr::add_to_wheel(LTE_FDD_ENB_TIMER_STRUCT *timer)
+{
+    LTE_FDD_ENB_TIMER_STRUCT **slot;
+    uint32                     delta = timer->expiry_tick - current_tick;
+    uint32                     shift;
+    uint32                     level;
+
+    // Timers expiring within a rotation of the first level go directly
+    // into their 1ms slot, later timers go into the first level whose
+    // range covers them and are moved down by cascade()
+    if(LTE_FDD_ENB_TIMER_WHEEL_L0_SIZE > delta)
+    {
+        slot = &wheel_l0[timer->expiry_tick & LTE_FDD_ENB_TIMER_WHEEL_L0_MASK];
+    }else{
+        for(level=1; level<LTE_FDD_ENB_TIMER_WHEEL_N_LEVELS-1; level++)
+        {
+            if((1U << (LTE_FDD_ENB_TIMER_WHEEL_L0_BITS + level*LTE_FDD_ENB_TIMER_WHEEL_LN_BITS)) > delta)
+            {
+                break;
+            }
+        }
+        shift = LTE_FDD_ENB_TIMER_WHEEL_L0_BITS + (level-1)*LTE_FDD_ENB_TIMER_WHEEL_LN_BITS;
+        slot  = &wheel_ln[level-1][(timer->expiry_tick >> shift) & LTE_FDD_ENB_TIMER_WHEEL_LN_MASK];
+    }
+
+    timer->slot = slot;
+    timer->prev = NULL;
+    timer->next = *slot;
+    if(NULL != *slot)
+    {
+        (*slot)->prev = timer;
+    }
+    *slot = timer;
+}
+void LTE_fdd_enb_timer_mgr::remove_from_wheel(LTE_FDD_ENB_TIMER_STRUCT *timer)
+{
+    if(NULL != timer->prev)
+    {
+        timer->prev->next = timer->next;
+    }else{
+        *timer->slot = timer->next;
+    }
+    if(NULL != timer->next)
+    {
+        timer->next->prev = timer->prev;
+    }
+    timer->next = NULL;
+    timer->prev = NULL;
+    timer->slot = NULL;
+}
+uint32 LTE_fdd_enb_timer_mgr::cascade(uint32 level)
+{
+    LTE_FDD_ENB_TIMER_STRUCT *timer;
+    LTE_FDD_ENB_TIMER_STRUCT *next;
+    uint32                    shift = LTE_FDD_ENB_TIMER_WHEEL_L0_BITS + (level-1)*LTE_FDD_ENB_TIMER_WHEEL_LN_BITS;
+    uint32                    idx   = (current_tick >> shift) & LTE_FDD_ENB_TIMER_WHEEL_LN_MASK;
+
+    // Re-add every timer in the current slot, they now fall into a
+    // finer level
+    timer                  = wheel_ln[level-1][idx];
+    wheel_ln[level-1][idx] = NULL;
+    while(NULL != timer)
+    {
+        next = timer->next;
+        add_to_wheel(timer);
+        timer = next;
+    }
+
+    return(idx);
+}
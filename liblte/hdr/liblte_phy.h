@@ -187,12 +187,22 @@ typedef enum{
     LIBLTE_PHY_CHAN_TYPE_ULSCH,
 }LIBLTE_PHY_CHAN_TYPE_ENUM;
 
+typedef enum{
+    LIBLTE_PHY_DL_CE_TYPE_POLAR = 0,
+    LIBLTE_PHY_DL_CE_TYPE_LINEAR,
+    LIBLTE_PHY_DL_CE_TYPE_WIENER,
+    LIBLTE_PHY_DL_CE_TYPE_N_ITEMS,
+}LIBLTE_PHY_DL_CE_TYPE_ENUM;
+static const char liblte_phy_dl_ce_type_text[LIBLTE_PHY_DL_CE_TYPE_N_ITEMS][20] = {"polar", "linear", "wiener"};
+
 typedef struct{
     // Receive
     float rx_symb_re[16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
     float rx_symb_im[16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
     float rx_ce_re[LIBLTE_PHY_N_ANT_MAX][16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
     float rx_ce_im[LIBLTE_PHY_N_ANT_MAX][16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float rx_noise_var[LIBLTE_PHY_N_RB_DL_20MHZ];
+    bool  rx_noise_var_valid;
 
     // Transmit
     float tx_symb_re[LIBLTE_PHY_N_ANT_MAX][16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
@@ -215,35 +225,319 @@ typedef struct{
 *********************************************************************/
 // Defines
 #define LIBLTE_PHY_INIT_N_ID_CELL_UNKNOWN 0xFFFF
+#define LIBLTE_PHY_TURBO_DECODE_N_ITER_DEFAULT 8
+#define LIBLTE_PHY_PRS_CACHE_N_ENTRIES         32
+#define LIBLTE_PHY_PRS_CACHE_N_WORDS           900
+#define LIBLTE_PHY_RM_CACHE_N_ENTRIES          16
+#define LIBLTE_PHY_RM_CACHE_N_IDX              18528
 // Enums
 // Structs
 typedef struct{
+    uint32 c_packed[LIBLTE_PHY_PRS_CACHE_N_WORDS];
+    uint32 c_init;
+    uint32 len;
+    uint32 last_used;
+}LIBLTE_PHY_PRS_CACHE_STRUCT;
+// Turbo rate matching circular buffer of one code block size, filler
+// count, and soft buffer size, holding the interleaved d index
+// (3*bit+stream) of every non NULL position in buffer order
+typedef struct{
+    uint16 idx[LIBLTE_PHY_RM_CACHE_N_IDX];
+    uint32 N_idx;
+    uint32 rv_start[4];
+    uint32 N_branch_bits;
+    uint32 N_fill_bits;
+    uint32 N_cb;
+    uint32 last_used;
+}LIBLTE_PHY_RM_CACHE_STRUCT;
+// One turbo code block of a DLSCH or ULSCH transport block, the code
+// blocks of a transport block are decoded independently
+typedef struct{
+    LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type;
+    float                     *e_bits;
+    uint32                     N_e_bits;
+    uint32                     N_fill_bits;
+    uint32                     N_codeblocks;
+    uint32                     tx_mode;
+    uint32                     N_soft;
+    uint32                     M_dl_harq;
+    uint32                     rv_idx;
+    uint32                     crc;
+    uint32                    *N_c_bits;
+    uint8                     *c_bits;
+    int16                     *harq_bits;
+}LIBLTE_PHY_CB_JOB_STRUCT;
+// Code block decode threads, see liblte_phy_set_code_block_threads
+typedef struct LIBLTE_PHY_CB_POOL_STRUCT LIBLTE_PHY_CB_POOL_STRUCT;
+// Tables that only depend on the cell configuration, built by
+// liblte_phy_init and liblte_phy_ul_init and shared read only by every
+// workspace created from the same cell
+typedef struct{
+    // Generic
+    uint32 fs;
+    uint32 N_samps_per_symb;
+    uint32 N_samps_cp_l_0;
+    uint32 N_samps_cp_l_else;
+    uint32 N_samps_per_slot;
+    uint32 N_samps_per_subfr;
+    uint32 N_samps_per_frame;
+    uint32 N_rb_dl;
+    uint32 N_rb_ul;
+    uint32 N_sc_rb_dl;
+    uint32 N_sc_rb_ul;
+    uint32 FFT_pad_size;
+    uint32 FFT_size;
+    uint32 ref_count;
+    bool   ul_init;
+
+    // Samples to Symbols & Symbols to Samples
+    fftwf_plan symbs_to_samps_dl_plan;
+    fftwf_plan samps_to_symbs_dl_plan;
+    fftwf_plan symbs_to_samps_ul_plan;
+    fftwf_plan samps_to_symbs_ul_plan;
+    fftwf_plan symbs_to_samps_dl_subfr_plan;
+    fftwf_plan samps_to_symbs_dl_subfr_plan;
+    fftwf_plan samps_to_symbs_ul_subfr_plan;
+    float      s2s_ul_shift_re[LIBLTE_PHY_N_SAMPS_PER_SYMB_30_72MHZ];
+    float      s2s_ul_shift_im[LIBLTE_PHY_N_SAMPS_PER_SYMB_30_72MHZ];
+
+    // PUSCH
+    fftwf_plan transform_precoding_plan[LIBLTE_PHY_N_RB_UL_MAX];
+    fftwf_plan transform_pre_decoding_plan[LIBLTE_PHY_N_RB_UL_MAX];
+
+    // DMRS
+    float dmrs_0_re[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX][LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
+    float dmrs_0_im[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX][LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
+    float dmrs_1_re[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX][LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
+    float dmrs_1_im[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX][LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
+
+    // PRACH
+    fftwf_plan prach_dft_plan;
+    fftwf_plan prach_ifft_plan;
+    fftwf_plan prach_fft_plan;
+    fftwf_plan prach_idft_plan;
+    fftwf_plan prach_corr_plan;
+    float      prach_x_u_v_re[64][839];
+    float      prach_x_u_v_im[64][839];
+    float      prach_x_u_re[64][839];
+    float      prach_x_u_im[64][839];
+    float      prach_x_u_fft_re[64][839];
+    float      prach_x_u_fft_im[64][839];
+    uint32     prach_zczc;
+    uint32     prach_preamble_format;
+    uint32     prach_root_seq_idx;
+    uint32     prach_N_x_u;
+    uint32     prach_pre_root[64];
+    uint32     prach_pre_C_v[64];
+    uint32     prach_N_cs;
+    uint32     prach_N_zc;
+    uint32     prach_T_fft;
+    uint32     prach_T_seq;
+    uint32     prach_T_cp;
+    uint32     prach_delta_f_RA;
+    uint32     prach_phi;
+    bool       prach_hs_flag;
+
+    // PSS
+    float pss_corr_re[3][3][LIBLTE_PHY_N_SAMPS_PER_SYMB_30_72MHZ*2];
+    float pss_corr_im[3][3][LIBLTE_PHY_N_SAMPS_PER_SYMB_30_72MHZ*2];
+
+    // SSS, real valued references for subframes 0 and 5 with the 62
+    // subcarriers padded to 64
+    float sss_ref[3][2][168][64];
+
+    // PDCCH
+    uint32 pdcch_permute_map[550][550];
+
+    // CRS Storage
+    float  crs_re_storage[20][3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float  crs_im_storage[20][3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    uint32 N_id_cell_crs;
+
+    // Viterbi decode
+    int16 vd_bm_mask[3][32];
+
+    // Turbo encode
+    uint16 te_table[8][256];
+}LIBLTE_PHY_CELL_STRUCT;
+// PUSCH encode and decode scratch
+typedef struct{
+    // PUSCH
+    float  pusch_z_est_re[14400];
+    float  pusch_z_est_im[14400];
+    float  pusch_c_est_0_re[LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
+    float  pusch_c_est_0_im[LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
+    float  pusch_c_est_1_re[LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
+    float  pusch_c_est_1_im[LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
+    float  pusch_c_est_re[14400];
+    float  pusch_c_est_im[14400];
+    float  pusch_z_re[LIBLTE_PHY_N_ANT_MAX][14400];
+    float  pusch_z_im[LIBLTE_PHY_N_ANT_MAX][14400];
+    float  pusch_y_re[14400];
+    float  pusch_y_im[14400];
+    float  pusch_x_re[14400];
+    float  pusch_x_im[14400];
+    float  pusch_d_re[14400];
+    float  pusch_d_im[14400];
+    float  pusch_noise_var[14400];
+    float  pusch_descramb_bits[28800];
+    uint32 pusch_c[28800];
+    uint8  pusch_encode_bits[28800];
+    uint8  pusch_scramb_bits[28800];
+    int8   pusch_soft_bits[28800];
+
+    // ULSCH
+    // FIXME: Sizes
+    float  ulsch_y_idx[92160];
+    float  ulsch_y_mat[92160];
+    float *ulsch_rx_e_bits[13];
+    float  ulsch_rx_f_bits[92160];
+    float  ulsch_rx_g_bits[92160];
+    uint64 ulsch_b_words[1179];
+    uint64 ulsch_c_words[13][96];
+    uint64 ulsch_d_words[3][97];
+    uint64 ulsch_f_words[1440];
+    uint32 ulsch_N_c_bits[13];
+    uint32 ulsch_N_e_bits[13];
+    uint8  ulsch_b_bits[75400];
+    uint8  ulsch_c_bits[13][6144];
+    uint8  ulsch_tx_f_bits[92160];
+    uint8  ulsch_tx_g_bits[92160];
+}LIBLTE_PHY_UL_SCRATCH_STRUCT;
+// PDSCH encode and decode scratch
+typedef struct{
+    // PDSCH
+    float  pdsch_y_est_re[15600];
+    float  pdsch_y_est_im[15600];
+    float  pdsch_c_est_re[LIBLTE_PHY_N_ANT_MAX][15600];
+    float  pdsch_c_est_im[LIBLTE_PHY_N_ANT_MAX][15600];
+    float  pdsch_y_re[LIBLTE_PHY_N_ANT_MAX][15600];
+    float  pdsch_y_im[LIBLTE_PHY_N_ANT_MAX][15600];
+    float  pdsch_x_re[31200];
+    float  pdsch_x_im[31200];
+    float  pdsch_d_re[31200];
+    float  pdsch_d_im[31200];
+    float  pdsch_noise_var[31200];
+    float  pdsch_descramb_bits[93600];
+    uint32 pdsch_c[93600];
+    uint8  pdsch_encode_bits[93600];
+    uint8  pdsch_scramb_bits[93600];
+    int8   pdsch_soft_bits[93600];
+
+    // DLSCH
+    // FIXME: Sizes
+    float *dlsch_rx_e_bits[13];
+    uint64 dlsch_b_words[1179];
+    uint64 dlsch_c_words[13][96];
+    uint64 dlsch_d_words[3][97];
+    uint64 dlsch_f_words[1463];
+    uint32 dlsch_N_c_bits[13];
+    uint32 dlsch_N_e_bits[13];
+    uint8  dlsch_b_bits[75400];
+    uint8  dlsch_c_bits[13][6144];
+}LIBLTE_PHY_DL_SCRATCH_STRUCT;
+// PDCCH encode and decode scratch
+typedef struct{
+    // PDCCH
+    // FIXME: Sizes
+    float pdcch_reg_y_est_re[550][4];
+    float pdcch_reg_y_est_im[550][4];
+    float pdcch_reg_c_est_re[LIBLTE_PHY_N_ANT_MAX][550][4];
+    float pdcch_reg_c_est_im[LIBLTE_PHY_N_ANT_MAX][550][4];
+    float pdcch_shift_y_est_re[550][4];
+    float pdcch_shift_y_est_im[550][4];
+    float pdcch_shift_c_est_re[LIBLTE_PHY_N_ANT_MAX][550][4];
+    float pdcch_shift_c_est_im[LIBLTE_PHY_N_ANT_MAX][550][4];
+    float pdcch_perm_y_est_re[550][4];
+    float pdcch_perm_y_est_im[550][4];
+    float pdcch_perm_c_est_re[LIBLTE_PHY_N_ANT_MAX][550][4];
+    float pdcch_perm_c_est_im[LIBLTE_PHY_N_ANT_MAX][550][4];
+    float pdcch_cce_y_est_re[50][576];
+    float pdcch_cce_y_est_im[50][576];
+    float pdcch_cce_c_est_re[LIBLTE_PHY_N_ANT_MAX][50][576];
+    float pdcch_cce_c_est_im[LIBLTE_PHY_N_ANT_MAX][50][576];
+    float pdcch_cce_re[LIBLTE_PHY_N_ANT_MAX][50][576];
+    float pdcch_cce_im[LIBLTE_PHY_N_ANT_MAX][50][576];
+    float pdcch_reg_re[LIBLTE_PHY_N_ANT_MAX][550][4];
+    float pdcch_reg_im[LIBLTE_PHY_N_ANT_MAX][550][4];
+    float pdcch_perm_re[LIBLTE_PHY_N_ANT_MAX][550][4];
+    float pdcch_perm_im[LIBLTE_PHY_N_ANT_MAX][550][4];
+    float pdcch_shift_re[LIBLTE_PHY_N_ANT_MAX][550][4];
+    float pdcch_shift_im[LIBLTE_PHY_N_ANT_MAX][550][4];
+}LIBLTE_PHY_PDCCH_SCRATCH_STRUCT;
+// CRS mapping and downlink channel estimate scratch
+typedef struct{
+    // CRS
+    float crs_re[14][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float crs_im[14][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+
+    // Channel Estimate
+    float dl_ce_crs_re[16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float dl_ce_crs_im[16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float dl_ce_mag[5][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float dl_ce_ang[5][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float dl_ce_re[5][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float dl_ce_im[5][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float dl_ce_ls_re[LIBLTE_PHY_N_ANT_MAX][5][2*LIBLTE_PHY_N_RB_DL_20MHZ];
+    float dl_ce_ls_im[LIBLTE_PHY_N_ANT_MAX][5][2*LIBLTE_PHY_N_RB_DL_20MHZ];
+    float dl_ce_nv_acc[LIBLTE_PHY_N_RB_DL_20MHZ];
+}LIBLTE_PHY_DL_CE_SCRATCH_STRUCT;
+// Downlink timing and PSS search scratch
+typedef struct{
+    // PSS
+    float pss_mod_re_n1[3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float pss_mod_im_n1[3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float pss_mod_re[3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float pss_mod_im[3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float pss_mod_re_p1[3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float pss_mod_im_p1[3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+
+    // Timing
+    float dl_timing_abs_corr[LIBLTE_PHY_N_SAMPS_PER_SLOT_30_72MHZ*2];
+    float dl_timing_prod_re[LIBLTE_PHY_N_SAMPS_PER_SLOT_30_72MHZ+LIBLTE_PHY_N_SAMPS_CP_L_ELSE_30_72MHZ];
+    float dl_timing_prod_im[LIBLTE_PHY_N_SAMPS_PER_SLOT_30_72MHZ+LIBLTE_PHY_N_SAMPS_CP_L_ELSE_30_72MHZ];
+}LIBLTE_PHY_DL_SYNC_SCRATCH_STRUCT;
+// Turbo decode scratch
+typedef struct{
+    // Turbo decode
+    int16  td_alpha[6144*8];
+    int16  td_sys[6144];
+    int16  td_sys_int[6144];
+    int16  td_par_1[6144];
+    int16  td_par_2[6144];
+    int16  td_tail_1[6];
+    int16  td_tail_2[6];
+    int16  td_ext_1[6144];
+    int16  td_ext_2[6144];
+    int16  td_apriori[6144];
+    int16  td_in[3*6148];
+    uint16 td_int_idx[6144];
+}LIBLTE_PHY_TD_SCRATCH_STRUCT;
+// Per thread workspace, the large channel scratch is allocated by the
+// first call that needs it so each thread only holds what it uses
+typedef struct{
+    // Shared cell tables
+    LIBLTE_PHY_CELL_STRUCT *cell;
+
+    // Channel scratch, allocated on first use
+    LIBLTE_PHY_UL_SCRATCH_STRUCT      *ul_scratch;
+    LIBLTE_PHY_DL_SCRATCH_STRUCT      *dl_scratch;
+    LIBLTE_PHY_PDCCH_SCRATCH_STRUCT   *pdcch_scratch;
+    LIBLTE_PHY_DL_CE_SCRATCH_STRUCT   *dl_ce_scratch;
+    LIBLTE_PHY_DL_SYNC_SCRATCH_STRUCT *dl_sync_scratch;
+    LIBLTE_PHY_TD_SCRATCH_STRUCT      *td_scratch;
+
+    // Pseudo random sequence cache
+    LIBLTE_PHY_PRS_CACHE_STRUCT prs_cache[LIBLTE_PHY_PRS_CACHE_N_ENTRIES];
+    uint32                      prs_cache_time;
+
+    // Rate match index cache
+    LIBLTE_PHY_RM_CACHE_STRUCT rm_cache[LIBLTE_PHY_RM_CACHE_N_ENTRIES];
+    uint32                     rm_cache_time;
+
     // PUSCH
     fftwf_complex *transform_precoding_in;
     fftwf_complex *transform_precoding_out;
-    fftwf_plan     transform_precoding_plan[LIBLTE_PHY_N_RB_UL_MAX];
-    fftwf_plan     transform_pre_decoding_plan[LIBLTE_PHY_N_RB_UL_MAX];
-    float          pusch_z_est_re[14400];
-    float          pusch_z_est_im[14400];
-    float          pusch_c_est_0_re[LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
-    float          pusch_c_est_0_im[LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
-    float          pusch_c_est_1_re[LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
-    float          pusch_c_est_1_im[LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
-    float          pusch_c_est_re[14400];
-    float          pusch_c_est_im[14400];
-    float          pusch_z_re[LIBLTE_PHY_N_ANT_MAX][14400];
-    float          pusch_z_im[LIBLTE_PHY_N_ANT_MAX][14400];
-    float          pusch_y_re[14400];
-    float          pusch_y_im[14400];
-    float          pusch_x_re[14400];
-    float          pusch_x_im[14400];
-    float          pusch_d_re[14400];
-    float          pusch_d_im[14400];
-    float          pusch_descramb_bits[28800];
-    uint32         pusch_c[28800];
-    uint8          pusch_encode_bits[28800];
-    uint8          pusch_scramb_bits[28800];
-    int8           pusch_soft_bits[28800];
 
     // UL Reference Signals
     float  ulrs_x_q_re[2048];
@@ -253,10 +547,6 @@ typedef struct{
     uint32 ulrs_c[160];
 
     // DMRS
-    float  dmrs_0_re[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX][LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
-    float  dmrs_0_im[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX][LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
-    float  dmrs_1_re[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX][LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
-    float  dmrs_1_im[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX][LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
     uint32 dmrs_c[1120];
 
     // PRACH
@@ -264,46 +554,10 @@ typedef struct{
     fftwf_complex *prach_dft_out;
     fftwf_complex *prach_fft_in;
     fftwf_complex *prach_fft_out;
-    fftwf_plan     prach_dft_plan;
-    fftwf_plan     prach_ifft_plan;
-    fftwf_plan     prach_fft_plan;
-    fftwf_plan     prach_idft_plan;
-    float          prach_x_u_v_re[64][839];
-    float          prach_x_u_v_im[64][839];
-    float          prach_x_u_re[64][839];
-    float          prach_x_u_im[64][839];
-    float          prach_x_u_fft_re[64][839];
-    float          prach_x_u_fft_im[64][839];
+    fftwf_complex *prach_corr_in;
+    fftwf_complex *prach_corr_out;
     float          prach_x_hat_re[839];
     float          prach_x_hat_im[839];
-    uint32         prach_zczc;
-    uint32         prach_preamble_format;
-    uint32         prach_root_seq_idx;
-    uint32         prach_N_x_u;
-    uint32         prach_N_zc;
-    uint32         prach_T_fft;
-    uint32         prach_T_seq;
-    uint32         prach_T_cp;
-    uint32         prach_delta_f_RA;
-    uint32         prach_phi;
-    bool           prach_hs_flag;
-
-    // PDSCH
-    float  pdsch_y_est_re[5000];
-    float  pdsch_y_est_im[5000];
-    float  pdsch_c_est_re[LIBLTE_PHY_N_ANT_MAX][5000];
-    float  pdsch_c_est_im[LIBLTE_PHY_N_ANT_MAX][5000];
-    float  pdsch_y_re[LIBLTE_PHY_N_ANT_MAX][5000];
-    float  pdsch_y_im[LIBLTE_PHY_N_ANT_MAX][5000];
-    float  pdsch_x_re[10000];
-    float  pdsch_x_im[10000];
-    float  pdsch_d_re[10000];
-    float  pdsch_d_im[10000];
-    float  pdsch_descramb_bits[10000];
-    uint32 pdsch_c[10000];
-    uint8  pdsch_encode_bits[10000];
-    uint8  pdsch_scramb_bits[10000];
-    int8   pdsch_soft_bits[10000];
 
     // BCH
     float  bch_y_est_re[240];
@@ -328,43 +582,18 @@ typedef struct{
 
     // PDCCH
     // FIXME: Sizes
-    float  pdcch_reg_y_est_re[550][4];
-    float  pdcch_reg_y_est_im[550][4];
-    float  pdcch_reg_c_est_re[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_reg_c_est_im[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_shift_y_est_re[550][4];
-    float  pdcch_shift_y_est_im[550][4];
-    float  pdcch_shift_c_est_re[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_shift_c_est_im[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_perm_y_est_re[550][4];
-    float  pdcch_perm_y_est_im[550][4];
-    float  pdcch_perm_c_est_re[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_perm_c_est_im[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_cce_y_est_re[50][576];
-    float  pdcch_cce_y_est_im[50][576];
-    float  pdcch_cce_c_est_re[LIBLTE_PHY_N_ANT_MAX][50][576];
-    float  pdcch_cce_c_est_im[LIBLTE_PHY_N_ANT_MAX][50][576];
     float  pdcch_y_est_re[576];
     float  pdcch_y_est_im[576];
     float  pdcch_c_est_re[LIBLTE_PHY_N_ANT_MAX][576];
     float  pdcch_c_est_im[LIBLTE_PHY_N_ANT_MAX][576];
     float  pdcch_y_re[LIBLTE_PHY_N_ANT_MAX][576];
     float  pdcch_y_im[LIBLTE_PHY_N_ANT_MAX][576];
-    float  pdcch_cce_re[LIBLTE_PHY_N_ANT_MAX][50][576];
-    float  pdcch_cce_im[LIBLTE_PHY_N_ANT_MAX][50][576];
-    float  pdcch_reg_re[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_reg_im[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_perm_re[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_perm_im[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_shift_re[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_shift_im[LIBLTE_PHY_N_ANT_MAX][550][4];
     float  pdcch_x_re[576];
     float  pdcch_x_im[576];
     float  pdcch_d_re[576];
     float  pdcch_d_im[576];
     float  pdcch_descramb_bits[576];
     uint32 pdcch_c[1152];
-    uint32 pdcch_permute_map[550][550];
     uint16 pdcch_reg_vec[550];
     uint16 pdcch_reg_perm_vec[550];
     uint8  pdcch_dci[100]; // FIXME: This is a guess at worst case
@@ -378,26 +607,11 @@ typedef struct{
     uint32 N_sf_phich;
 
     // CRS & Channel Estimate
-    float crs_re[14][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float crs_im[14][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float dl_ce_crs_re[16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float dl_ce_crs_im[16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float dl_ce_mag[5][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float dl_ce_ang[5][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-
-    // PSS
-    float pss_mod_re_n1[3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float pss_mod_im_n1[3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float pss_mod_re[3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float pss_mod_im[3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float pss_mod_re_p1[3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float pss_mod_im_p1[3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float                      dl_ce_w[29][4];
+    LIBLTE_PHY_DL_CE_TYPE_ENUM dl_ce_type;
+    bool                       dl_ce_est_noise_var;
 
     // SSS
-    float sss_mod_re_0[168][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float sss_mod_im_0[168][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float sss_mod_re_5[168][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float sss_mod_im_5[168][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
     float sss_re_0[63];
     float sss_im_0[63];
     float sss_re_5[63];
@@ -415,70 +629,31 @@ typedef struct{
     int8  sss_z1_m0[31];
     int8  sss_z1_m1[31];
 
-    // Timing
-    float dl_timing_abs_corr[LIBLTE_PHY_N_SAMPS_PER_SLOT_30_72MHZ*2];
-
-    // CRS Storage
-    float  crs_re_storage[20][3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float  crs_im_storage[20][3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    uint32 N_id_cell_crs;
-
     // Samples to Symbols & Symbols to Samples
     fftwf_complex *s2s_in;
     fftwf_complex *s2s_out;
-    fftwf_plan     symbs_to_samps_dl_plan;
-    fftwf_plan     samps_to_symbs_dl_plan;
-    fftwf_plan     symbs_to_samps_ul_plan;
-    fftwf_plan     samps_to_symbs_ul_plan;
 
     // Viterbi decode
-    float vd_path_metric[128][2048];
-    float vd_br_metric[128][2];
-    float vd_p_metric[128][2];
-    float vd_br_weight[128][2];
-    float vd_w_metric[128][2048];
-    float vd_tb_state[2048];
-    float vd_tb_weight[2048];
-    uint8 vd_st_output[128][2][3];
+    int16  vd_in[576];
+    uint64 vd_dec[320];
 
     // Turbo encode
-    uint8 te_z[6144];
-    uint8 te_fb1[6144];
-    uint8 te_c_prime[6144];
-    uint8 te_z_prime[6144];
-    uint8 te_x_prime[6144];
+    uint16 te_int_idx[6144];
+    uint64 te_c_words[96];
+    uint64 te_c_prime_words[96];
+    uint64 te_d_words[3][97];
 
     // Turbo decode
-    int8 td_vitdec_in[18432];
-    int8 td_in_int[6144];
-    int8 td_in_calc_1[6144];
-    int8 td_in_calc_2[6144];
-    int8 td_in_calc_3[6144];
-    int8 td_in_int_1[6144];
-    int8 td_int_calc_1[6144];
-    int8 td_int_calc_2[6144];
-    int8 td_in_act_1[6144];
-    int8 td_fb_1[6144];
-    int8 td_int_act_1[6144];
-    int8 td_int_act_2[6144];
-    int8 td_fb_int_1[6144];
-    int8 td_fb_int_2[6144];
+    uint32 td_N_iter;
+
+    // Code block decode
+    LIBLTE_PHY_CB_JOB_STRUCT   cb_job[13];
+    LIBLTE_PHY_CB_POOL_STRUCT *cb_pool;
+    float                      cbd_rx_d_bits[3*6148];
 
     // Rate Match Turbo
-    uint8 rmt_tmp[6144];
-    uint8 rmt_sb_mat[32][192];
-    uint8 rmt_sb_perm_mat[32][192];
-    uint8 rmt_y[6144];
-    uint8 rmt_w[18432];
-
-    // Rate Unmatch Turbo
-    float rut_tmp[6144];
-    float rut_sb_mat[32][192];
-    float rut_sb_perm_mat[32][192];
-    float rut_y[6144];
-    float rut_w_dum[18432];
-    float rut_w[18432];
-    float rut_v[3][6144];
+    uint64 rmt_d_words[3][97];
+    uint64 rmt_e_words[1463];
 
     // Rate Match Conv
     uint8 rmc_tmp[1024];
@@ -494,34 +669,6 @@ typedef struct{
     float ruc_w[3*1024];
     float ruc_v[3][1024];
 
-    // ULSCH
-    // FIXME: Sizes
-    float  ulsch_y_idx[92160];
-    float  ulsch_y_mat[92160];
-    float  ulsch_rx_d_bits[75376];
-    float  ulsch_rx_e_bits[5][18432];
-    float  ulsch_rx_f_bits[92160];
-    float  ulsch_rx_g_bits[92160];
-    uint32 ulsch_N_c_bits[5];
-    uint32 ulsch_N_e_bits[5];
-    uint8  ulsch_b_bits[30720];
-    uint8  ulsch_c_bits[5][6144];
-    uint8  ulsch_tx_d_bits[75376];
-    uint8  ulsch_tx_e_bits[5][18432];
-    uint8  ulsch_tx_f_bits[92160];
-    uint8  ulsch_tx_g_bits[92160];
-
-    // DLSCH
-    // FIXME: Sizes
-    float  dlsch_rx_d_bits[75376];
-    float  dlsch_rx_e_bits[5][18432];
-    uint32 dlsch_N_c_bits[5];
-    uint32 dlsch_N_e_bits[5];
-    uint8  dlsch_b_bits[30720];
-    uint8  dlsch_c_bits[5][6144];
-    uint8  dlsch_tx_d_bits[75376];
-    uint8  dlsch_tx_e_bits[5][18432];
-
     // DCI
     float dci_rx_d_bits[576];
     uint8 dci_tx_d_bits[576];
@@ -530,20 +677,6 @@ typedef struct{
     // Generic
     float  rx_symb_re[LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
     float  rx_symb_im[LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    uint32 fs;
-    uint32 N_samps_per_symb;
-    uint32 N_samps_cp_l_0;
-    uint32 N_samps_cp_l_else;
-    uint32 N_samps_per_slot;
-    uint32 N_samps_per_subfr;
-    uint32 N_samps_per_frame;
-    uint32 N_rb_dl;
-    uint32 N_rb_ul;
-    uint32 N_sc_rb_dl;
-    uint32 N_sc_rb_ul;
-    uint32 FFT_pad_size;
-    uint32 FFT_size;
-    bool   ul_init;
 }LIBLTE_PHY_STRUCT;
 // Functions
 LIBLTE_ERROR_ENUM liblte_phy_init(LIBLTE_PHY_STRUCT  **phy_struct,
@@ -579,6 +712,27 @@ LIBLTE_ERROR_ENUM liblte_phy_ul_init(LIBLTE_PHY_STRUCT *phy_struct,
 LIBLTE_ERROR_ENUM liblte_phy_cleanup(LIBLTE_PHY_STRUCT *phy_struct);
 LIBLTE_ERROR_ENUM liblte_phy_ul_cleanup(LIBLTE_PHY_STRUCT *phy_struct);
 
+/*********************************************************************
+    Name: liblte_phy_init_workspace
+
+    Description: Creates an additional workspace sharing the cell
+                 tables of an initialized LTE Physical Layer library
+                 instance, one workspace is needed per thread.
+                 Workspaces are released with liblte_phy_cleanup and
+                 the cell tables are freed with the last of them.
+                 liblte_phy_ul_init, liblte_phy_ul_cleanup, and
+                 liblte_phy_update_n_rb_dl change the shared cell and
+                 must not run while other workspaces are in use.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_init_workspace(LIBLTE_PHY_STRUCT  *phy_struct,
+                                            LIBLTE_PHY_STRUCT **workspace);
+
 /*********************************************************************
     Name: liblte_phy_update_n_rb_dl
 
@@ -593,6 +747,167 @@ LIBLTE_ERROR_ENUM liblte_phy_ul_cleanup(LIBLTE_PHY_STRUCT *phy_struct);
 LIBLTE_ERROR_ENUM liblte_phy_update_n_rb_dl(LIBLTE_PHY_STRUCT *phy_struct,
                                             uint32             N_rb_dl);
 
+/*********************************************************************
+    Name: liblte_phy_set_turbo_decode_n_iter
+
+    Description: Sets the maximum number of turbo decoder iterations.
+                 Decoding stops early once the code block CRC passes.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+#define LIBLTE_PHY_TURBO_DECODE_N_ITER_MAX 16
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_set_turbo_decode_n_iter(LIBLTE_PHY_STRUCT *phy_struct,
+                                                     uint32             N_iter);
+
+/*********************************************************************
+    Name: liblte_phy_set_dl_channel_estimator
+
+    Description: Selects the channel estimator used by
+                 liblte_phy_get_dl_subframe_and_ce.  POLAR interpolates
+                 magnitude and phase between CRSs, LINEAR and WIENER
+                 interpolate the least squares CRS estimates directly.
+                 When est_noise_var is set, LINEAR and WIENER also
+                 estimate the noise variance of each PRB, which
+                 liblte_phy_pdsch_channel_decode uses to scale the
+                 demapper LLRs.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_set_dl_channel_estimator(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                      LIBLTE_PHY_DL_CE_TYPE_ENUM  ce_type,
+                                                      bool                        est_noise_var);
+
+/*********************************************************************
+    Name: liblte_phy_set_code_block_threads
+
+    Description: Sets the number of threads used to decode the code
+                 blocks of a DLSCH or ULSCH transport block.  The
+                 calling thread decodes alongside N_threads-1 helper
+                 threads, each with its own workspace, and 0 or 1
+                 decodes serially.  Must not be called while the
+                 workspace is decoding.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+#define LIBLTE_PHY_CODE_BLOCK_THREADS_MAX 16
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_set_code_block_threads(LIBLTE_PHY_STRUCT *phy_struct,
+                                                    uint32             N_threads);
+
+/*********************************************************************
+    Name: liblte_phy_set_fftw_wisdom_path
+
+    Description: Sets the directory of the FFTW wisdom store.  Wisdom
+                 is imported before and exported after the FFT plans
+                 are created by liblte_phy_init and liblte_phy_ul_init,
+                 in one file per CPU and sample rate.  The directory
+                 must be owned by the user and not writable by group or
+                 others, otherwise the store is disabled.  A NULL or
+                 empty path disables the store.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+#define LIBLTE_PHY_FFTW_WISDOM_PATH_MAX 256
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_set_fftw_wisdom_path(const char *path);
+
+/*********************************************************************
+    Name: liblte_phy_set_default_fftw_wisdom_path
+
+    Description: Sets the directory of the FFTW wisdom store to the
+                 per user cache, $XDG_CACHE_HOME/openlte or
+                 $HOME/.cache/openlte, creating it if needed.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_set_default_fftw_wisdom_path(void);
+
+/*********************************************************************
+    Name: liblte_phy_set_fftw_planner_time_limit
+
+    Description: Bounds the time FFTW spends measuring each plan that
+                 is not already covered by wisdom.  A negative limit
+                 removes the bound.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_set_fftw_planner_time_limit(float seconds);
+
+/*********************************************************************
+    Name: liblte_phy_get_simd
+
+    Description: Returns the instruction set of the DSP kernels in
+                 use.  The kernels are selected once, by the first
+                 call to liblte_phy_init or this function, as the best
+                 instruction set the CPU supports.  Setting the
+                 LIBLTE_PHY_SIMD environment variable to one of
+                 liblte_phy_simd_text selects a lower one instead.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+#define LIBLTE_PHY_SIMD_ENV_VAR "LIBLTE_PHY_SIMD"
+// Enums
+typedef enum{
+    LIBLTE_PHY_SIMD_SCALAR = 0,
+    LIBLTE_PHY_SIMD_SSE2,
+    LIBLTE_PHY_SIMD_SSE4_1,
+    LIBLTE_PHY_SIMD_AVX2,
+    LIBLTE_PHY_SIMD_AVX512,
+    LIBLTE_PHY_SIMD_N_ITEMS,
+}LIBLTE_PHY_SIMD_ENUM;
+static const char liblte_phy_simd_text[LIBLTE_PHY_SIMD_N_ITEMS][20] = {"scalar", "sse2", "sse4.1", "avx2", "avx512"};
+// Structs
+// Functions
+LIBLTE_PHY_SIMD_ENUM liblte_phy_get_simd(void);
+
+/*********************************************************************
+    Name: liblte_phy_harq_buffer_reset
+
+    Description: Empties a HARQ soft buffer.  The PDSCH and PUSCH
+                 decoders add each transmission of a transport block
+                 to the soft bits of its HARQ buffer before turbo
+                 decoding, and empty it once the transport block CRC
+                 passes or the transport block size changes.  Callers
+                 reset the buffer when the new data indicator toggles.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1.2
+*********************************************************************/
+// Defines
+#define LIBLTE_PHY_HARQ_N_CODEBLOCKS_MAX 13
+#define LIBLTE_PHY_HARQ_N_SOFT_BITS_MAX  (3*6148)
+// Enums
+// Structs
+typedef struct{
+    int16  soft_bits[LIBLTE_PHY_HARQ_N_CODEBLOCKS_MAX][LIBLTE_PHY_HARQ_N_SOFT_BITS_MAX];
+    uint32 tbs;
+    uint32 N_codeblocks;
+}LIBLTE_PHY_HARQ_BUFFER_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_harq_buffer_reset(LIBLTE_PHY_HARQ_BUFFER_STRUCT *harq);
+
 /*********************************************************************
     Name: liblte_phy_pusch_channel_encode
 
@@ -650,7 +965,9 @@ LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_encode(LIBLTE_PHY_STRUCT            *
     Name: liblte_phy_pusch_channel_decode
 
     Description: Demodulates and decodes the Physical Uplink Shared
-                 Channel
+                 Channel, combining with the earlier transmissions in
+                 harq when it is not NULL.  The demapper LLRs are
+                 scaled by the noise variance estimated from the DMRS.
 
     Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3
 *********************************************************************/
@@ -658,13 +975,14 @@ LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_encode(LIBLTE_PHY_STRUCT            *
 // Enums
 // Structs
 // Functions
-LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_decode(LIBLTE_PHY_STRUCT            *phy_struct,
-                                                  LIBLTE_PHY_SUBFRAME_STRUCT   *subframe,
-                                                  LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
-                                                  uint32                        N_id_cell,
-                                                  uint8                         N_ant,
-                                                  uint8                        *out_bits,
-                                                  uint32                       *N_out_bits);
+LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_decode(LIBLTE_PHY_STRUCT             *phy_struct,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT    *subframe,
+                                                  LIBLTE_PHY_ALLOCATION_STRUCT  *alloc,
+                                                  uint32                         N_id_cell,
+                                                  uint8                          N_ant,
+                                                  LIBLTE_PHY_HARQ_BUFFER_STRUCT *harq,
+                                                  uint8                         *out_bits,
+                                                  uint32                        *N_out_bits);
 
 /*********************************************************************
     Name: liblte_phy_generate_prach
@@ -686,7 +1004,9 @@ LIBLTE_ERROR_ENUM liblte_phy_generate_prach(LIBLTE_PHY_STRUCT *phy_struct,
 /*********************************************************************
     Name: liblte_phy_detect_prach
 
-    Description: Detects PRACHs from baseband I/Q
+    Description: Detects PRACHs from baseband I/Q, reporting up to 64
+                 preambles with their timing advance and correlation
+                 power, along with the correlation noise floor
 
     Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.2 and 5.7.3
 *********************************************************************/
@@ -700,7 +1020,9 @@ LIBLTE_ERROR_ENUM liblte_phy_detect_prach(LIBLTE_PHY_STRUCT *phy_struct,
                                           uint32             freq_offset,
                                           uint32            *N_det_pre,
                                           uint32            *det_pre,
-                                          uint32            *det_ta);
+                                          uint32            *det_ta,
+                                          float             *det_pwr,
+                                          float             *noise_floor);
 
 /*********************************************************************
     Name: liblte_phy_pdsch_channel_encode
@@ -730,7 +1052,8 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *ph
     Name: liblte_phy_pdsch_channel_decode
 
     Description: Demodulates and decodes the Physical Downlink Shared
-                 Channel
+                 Channel, combining with the earlier transmissions in
+                 harq when it is not NULL
 
     Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3 and 6.4
 *********************************************************************/
@@ -738,14 +1061,15 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *ph
 // Enums
 // Structs
 // Functions
-LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_decode(LIBLTE_PHY_STRUCT            *phy_struct,
-                                                  LIBLTE_PHY_SUBFRAME_STRUCT   *subframe,
-                                                  LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
-                                                  uint32                        N_pdcch_symbs,
-                                                  uint32                        N_id_cell,
-                                                  uint8                         N_ant,
-                                                  uint8                        *out_bits,
-                                                  uint32                       *N_out_bits);
+LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_decode(LIBLTE_PHY_STRUCT             *phy_struct,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT    *subframe,
+                                                  LIBLTE_PHY_ALLOCATION_STRUCT  *alloc,
+                                                  uint32                         N_pdcch_symbs,
+                                                  uint32                         N_id_cell,
+                                                  uint8                          N_ant,
+                                                  LIBLTE_PHY_HARQ_BUFFER_STRUCT *harq,
+                                                  uint8                         *out_bits,
+                                                  uint32                        *N_out_bits);
 
 /*********************************************************************
     Name: liblte_phy_bch_channel_encode
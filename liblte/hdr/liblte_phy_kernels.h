@@ -0,0 +1,194 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_phy_kernels.h
+
+    Description: Contains the declarations of the LTE Physical Layer library
+                 coding and demapping kernels that are exported for testing
+                 and benchmarking.  These are not part of the stable API.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/18/2026    agent            Created file
+
+*******************************************************************************/
+
+#ifndef __LIBLTE_PHY_KERNELS_H__
+#define __LIBLTE_PHY_KERNELS_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_phy.h"
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+// Transport Block Size from 3GPP TS 36.213 v10.3.0 table 7.1.7.2.1-1
+extern uint32 TBS_71721[27][110];
+
+/*******************************************************************************
+                              DECLARATIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: modulation_demapper
+
+    Description: Maps complex-valued modulation symbols to 8 bit max-log
+                 soft bits, positive for a binary 0
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void modulation_demapper(float                           *d_re,
+                         float                           *d_im,
+                         float                           *noise_var,
+                         uint32                           M_symb,
+                         LIBLTE_PHY_MODULATION_TYPE_ENUM  type,
+                         int8                            *bits,
+                         uint32                          *N_bits);
+
+/*********************************************************************
+    Name: conv_encode
+
+    Description: Convolutionally encodes a bit array using the
+                 provided parameters
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void conv_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                 uint8             *c_bits,
+                 uint32             N_c_bits,
+                 uint32             constraint_len,
+                 uint32             rate,
+                 uint32            *g,
+                 bool               tail_bit,
+                 uint8             *d_bits,
+                 uint32            *N_d_bits);
+
+/*********************************************************************
+    Name: viterbi_decode
+
+    Description: Tail biting Viterbi decoder for the LTE rate 1/3,
+                 constraint length 7 convolutional code.  The circular
+                 trellis is decoded by wrapping the input around both
+                 ends of the block.  All 64 states are updated with 16
+                 bit saturating add-compare-select and the survivor
+                 decisions of each step are packed into one word.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void viterbi_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                    float             *d_bits,
+                    uint32             N_d_bits,
+                    uint8             *c_bits,
+                    uint32            *N_c_bits);
+
+/*********************************************************************
+    Name: turbo_encode
+
+    Description: Turbo encodes a bit array using the LTE Parallel
+                 Concatenated Convolutional Code
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM turbo_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                               uint8             *c_bits,
+                               uint32             N_c_bits,
+                               uint32             N_fill_bits,
+                               uint8             *d_bits,
+                               uint32            *N_d_bits);
+
+/*********************************************************************
+    Name: turbo_decode
+
+    Description: Turbo decodes data according to the LTE Parallel
+                 Concatenated Convolutional Code.  Two max-log-MAP
+                 constituent decoders exchange extrinsic information
+                 for up to td_N_iter iterations, stopping as soon as
+                 the code block CRC passes.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM turbo_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                               float             *d_bits,
+                               uint32             N_d_bits,
+                               uint32             N_fill_bits,
+                               uint32             crc,
+                               uint8             *c_bits,
+                               uint32            *N_c_bits);
+
+/*********************************************************************
+    Name: rate_unmatch_turbo
+
+    Description: Rate unmatches turbo encoded data, soft combining
+                 repeated bits
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void rate_unmatch_turbo(LIBLTE_PHY_STRUCT         *phy_struct,
+                        float                     *e_bits,
+                        uint32                     N_e_bits,
+                        uint32                     N_c_bits,
+                        uint32                     N_fill_bits,
+                        uint32                     N_codeblocks,
+                        uint32                     tx_mode,
+                        uint32                     N_soft,
+                        uint32                     M_dl_harq,
+                        LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type,
+                        uint32                     rv_idx,
+                        float                     *d_bits,
+                        uint32                    *N_d_bits);
+
+#endif /* __LIBLTE_PHY_KERNELS_H__ */
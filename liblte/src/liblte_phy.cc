@@ -120,19 +120,53 @@
 *******************************************************************************/
 
 #include "liblte_phy.h"
+#include "liblte_phy_kernels.h"
 #include "liblte_mac.h"
 #include <math.h>
+#include <float.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PHY_KERNEL_X86
+#include <immintrin.h>
+#endif
 
 /*******************************************************************************
                               DEFINES
 *******************************************************************************/
 
 #define N_SYMB_DL_NORMAL_CP 7
+#define PRACH_DETECT_THRESH 50
+
+// Kernels above the baseline instruction set are built for their own
+// target and only called when the CPU supports it
+#if defined(PHY_KERNEL_X86)
+#define PHY_TARGET_SSE4_1 __attribute__((target("sse4.1")))
+#define PHY_TARGET_AVX2   __attribute__((target("avx2")))
+#define PHY_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
 
 /*******************************************************************************
                               TYPEDEFS
 *******************************************************************************/
 
+// DSP kernels with one implementation per instruction set, filled in by
+// phy_kernel_select
+typedef struct{
+    void (*cmul)(float *a_re, float *a_im, float *b_re, float *b_im, uint32 N, float *y_re, float *y_im);
+    void (*cmul_conj)(float *a_re, float *a_im, float *b_re, float *b_im, uint32 N, float *y_re, float *y_im);
+    void (*cmul_conj_interleaved)(float *a_re, float *a_im, float *b_re, float *b_im, uint32 N, fftwf_complex *y);
+    void (*sss_correlate)(float *sss_ref, uint32 N_refs, float *y_re, float *y_im, float *abs_corr);
+    void (*normalize_unit_magnitude)(float *re, float *im, uint32 N);
+    void (*dl_ce_interp_time)(float *a_re, float *a_im, float *b_re, float *b_im, float frac, uint32 N, float *ce_re, float *ce_im);
+    void (*modulation_demapper_llr)(float *d_re, float *d_im, float *noise_var, uint32 M_symb, uint32 Q_m, float *A, float unit_scale, float nv_scale, int8 *bits);
+    void (*viterbi_acs)(LIBLTE_PHY_STRUCT *phy_struct, int16 *in, uint32 N_bits, uint32 N_wrap, uint32 N_steps, int16 *metric);
+    void (*turbo_map_recursions)(LIBLTE_PHY_STRUCT *phy_struct, int16 *sys, int16 *par, int16 *apriori, int16 *beta, uint32 K, int16 *ext);
+}PHY_KERNEL_STRUCT;
 
 /*******************************************************************************
                               GLOBAL VARIABLES
@@ -444,7 +478,108 @@ uint32 TURBO_INT_F2_TABLE[188] = { 10, 12, 42, 16, 18, 20, 22, 24, 26, 84, 90, 3
                                   234,158, 80, 96,902,166,336,170, 86,174,176,178,120,
                                   182,184,186, 94,190,480};
 
-// Transport Block Size from 3GPP TS 36.213 v10.3.0 table 7.1.7.2.1-1
+// Pseudo random sequence from 3GPP TS 36.211 v10.1.0 section 7.2, bits
+// n=1600 to n=1663 of x1 and of x2 for each bit of c_init
+uint64 PRS_X1_INIT     = 0x6AC0A9A45E485840ULL;
+uint64 PRS_X2_INIT[31] = {0x2D7FF07070889900ULL, 0x778010909199AB01ULL, 0xC27FD15153BBCF03ULL,
+                          0xA98052D2D7FF0707ULL, 0x5300A5A5AFFE0E0EULL, 0xA6014B4B5FFC1C1CULL,
+                          0x4C029696BFF83838ULL, 0x98052D2D7FF07070ULL, 0x300A5A5AFFE0E0E1ULL,
+                          0x6014B4B5FFC1C1C2ULL, 0xC029696BFF838384ULL, 0x8052D2D7FF070708ULL,
+                          0x00A5A5AFFE0E0E11ULL, 0x014B4B5FFC1C1C22ULL, 0x029696BFF8383844ULL,
+                          0x052D2D7FF0707088ULL, 0x0A5A5AFFE0E0E111ULL, 0x14B4B5FFC1C1C222ULL,
+                          0x29696BFF83838444ULL, 0x52D2D7FF07070889ULL, 0xA5A5AFFE0E0E1113ULL,
+                          0x4B4B5FFC1C1C2226ULL, 0x9696BFF83838444CULL, 0x2D2D7FF070708899ULL,
+                          0x5A5AFFE0E0E11132ULL, 0xB4B5FFC1C1C22264ULL, 0x696BFF83838444C8ULL,
+                          0xD2D7FF0707088990ULL, 0xA5AFFE0E0E111320ULL, 0x4B5FFC1C1C222640ULL,
+                          0x96BFF83838444C80ULL};
+
+// Turbo decoder trellis, 0/-1 masks selecting the sign of the systematic
+// and parity branch metrics for each of the 8 constituent encoder states
+int16 TD_FWD_U_MASK[8] = {0,-1, 0,-1,-1, 0,-1, 0};
+int16 TD_FWD_P_MASK[8] = {0, 0,-1,-1,-1,-1, 0, 0};
+int16 TD_BWD_U_MASK[8] = {0,-1,-1, 0, 0,-1,-1, 0};
+int16 TD_BWD_P_MASK[8] = {0,-1, 0,-1,-1, 0,-1, 0};
+
+// CRC24A and CRC24B remainders for each leading byte, 3GPP TS 36.212
+// v10.1.0 section 5.1.1, used to calculate the CRC a byte at a time
+uint32 CRC24A_TABLE[256] = {0x000000, 0x864CFB, 0x8AD50D, 0x0C99F6, 0x93E6E1, 0x15AA1A, 0x1933EC, 0x9F7F17,
+                            0xA18139, 0x27CDC2, 0x2B5434, 0xAD18CF, 0x3267D8, 0xB42B23, 0xB8B2D5, 0x3EFE2E,
+                            0xC54E89, 0x430272, 0x4F9B84, 0xC9D77F, 0x56A868, 0xD0E493, 0xDC7D65, 0x5A319E,
+                            0x64CFB0, 0xE2834B, 0xEE1ABD, 0x685646, 0xF72951, 0x7165AA, 0x7DFC5C, 0xFBB0A7,
+                            0x0CD1E9, 0x8A9D12, 0x8604E4, 0x00481F, 0x9F3708, 0x197BF3, 0x15E205, 0x93AEFE,
+                            0xAD50D0, 0x2B1C2B, 0x2785DD, 0xA1C926, 0x3EB631, 0xB8FACA, 0xB4633C, 0x322FC7,
+                            0xC99F60, 0x4FD39B, 0x434A6D, 0xC50696, 0x5A7981, 0xDC357A, 0xD0AC8C, 0x56E077,
+                            0x681E59, 0xEE52A2, 0xE2CB54, 0x6487AF, 0xFBF8B8, 0x7DB443, 0x712DB5, 0xF7614E,
+                            0x19A3D2, 0x9FEF29, 0x9376DF, 0x153A24, 0x8A4533, 0x0C09C8, 0x00903E, 0x86DCC5,
+                            0xB822EB, 0x3E6E10, 0x32F7E6, 0xB4BB1D, 0x2BC40A, 0xAD88F1, 0xA11107, 0x275DFC,
+                            0xDCED5B, 0x5AA1A0, 0x563856, 0xD074AD, 0x4F0BBA, 0xC94741, 0xC5DEB7, 0x43924C,
+                            0x7D6C62, 0xFB2099, 0xF7B96F, 0x71F594, 0xEE8A83, 0x68C678, 0x645F8E, 0xE21375,
+                            0x15723B, 0x933EC0, 0x9FA736, 0x19EBCD, 0x8694DA, 0x00D821, 0x0C41D7, 0x8A0D2C,
+                            0xB4F302, 0x32BFF9, 0x3E260F, 0xB86AF4, 0x2715E3, 0xA15918, 0xADC0EE, 0x2B8C15,
+                            0xD03CB2, 0x567049, 0x5AE9BF, 0xDCA544, 0x43DA53, 0xC596A8, 0xC90F5E, 0x4F43A5,
+                            0x71BD8B, 0xF7F170, 0xFB6886, 0x7D247D, 0xE25B6A, 0x641791, 0x688E67, 0xEEC29C,
+                            0x3347A4, 0xB50B5F, 0xB992A9, 0x3FDE52, 0xA0A145, 0x26EDBE, 0x2A7448, 0xAC38B3,
+                            0x92C69D, 0x148A66, 0x181390, 0x9E5F6B, 0x01207C, 0x876C87, 0x8BF571, 0x0DB98A,
+                            0xF6092D, 0x7045D6, 0x7CDC20, 0xFA90DB, 0x65EFCC, 0xE3A337, 0xEF3AC1, 0x69763A,
+                            0x578814, 0xD1C4EF, 0xDD5D19, 0x5B11E2, 0xC46EF5, 0x42220E, 0x4EBBF8, 0xC8F703,
+                            0x3F964D, 0xB9DAB6, 0xB54340, 0x330FBB, 0xAC70AC, 0x2A3C57, 0x26A5A1, 0xA0E95A,
+                            0x9E1774, 0x185B8F, 0x14C279, 0x928E82, 0x0DF195, 0x8BBD6E, 0x872498, 0x016863,
+                            0xFAD8C4, 0x7C943F, 0x700DC9, 0xF64132, 0x693E25, 0xEF72DE, 0xE3EB28, 0x65A7D3,
+                            0x5B59FD, 0xDD1506, 0xD18CF0, 0x57C00B, 0xC8BF1C, 0x4EF3E7, 0x426A11, 0xC426EA,
+                            0x2AE476, 0xACA88D, 0xA0317B, 0x267D80, 0xB90297, 0x3F4E6C, 0x33D79A, 0xB59B61,
+                            0x8B654F, 0x0D29B4, 0x01B042, 0x87FCB9, 0x1883AE, 0x9ECF55, 0x9256A3, 0x141A58,
+                            0xEFAAFF, 0x69E604, 0x657FF2, 0xE33309, 0x7C4C1E, 0xFA00E5, 0xF69913, 0x70D5E8,
+                            0x4E2BC6, 0xC8673D, 0xC4FECB, 0x42B230, 0xDDCD27, 0x5B81DC, 0x57182A, 0xD154D1,
+                            0x26359F, 0xA07964, 0xACE092, 0x2AAC69, 0xB5D37E, 0x339F85, 0x3F0673, 0xB94A88,
+                            0x87B4A6, 0x01F85D, 0x0D61AB, 0x8B2D50, 0x145247, 0x921EBC, 0x9E874A, 0x18CBB1,
+                            0xE37B16, 0x6537ED, 0x69AE1B, 0xEFE2E0, 0x709DF7, 0xF6D10C, 0xFA48FA, 0x7C0401,
+                            0x42FA2F, 0xC4B6D4, 0xC82F22, 0x4E63D9, 0xD11CCE, 0x575035, 0x5BC9C3, 0xDD8538};
+
+uint32 CRC24B_TABLE[256] = {0x000000, 0x800063, 0x8000A5, 0x0000C6, 0x800129, 0x00014A, 0x00018C, 0x8001EF,
+                            0x800231, 0x000252, 0x000294, 0x8002F7, 0x000318, 0x80037B, 0x8003BD, 0x0003DE,
+                            0x800401, 0x000462, 0x0004A4, 0x8004C7, 0x000528, 0x80054B, 0x80058D, 0x0005EE,
+                            0x000630, 0x800653, 0x800695, 0x0006F6, 0x800719, 0x00077A, 0x0007BC, 0x8007DF,
+                            0x800861, 0x000802, 0x0008C4, 0x8008A7, 0x000948, 0x80092B, 0x8009ED, 0x00098E,
+                            0x000A50, 0x800A33, 0x800AF5, 0x000A96, 0x800B79, 0x000B1A, 0x000BDC, 0x800BBF,
+                            0x000C60, 0x800C03, 0x800CC5, 0x000CA6, 0x800D49, 0x000D2A, 0x000DEC, 0x800D8F,
+                            0x800E51, 0x000E32, 0x000EF4, 0x800E97, 0x000F78, 0x800F1B, 0x800FDD, 0x000FBE,
+                            0x8010A1, 0x0010C2, 0x001004, 0x801067, 0x001188, 0x8011EB, 0x80112D, 0x00114E,
+                            0x001290, 0x8012F3, 0x801235, 0x001256, 0x8013B9, 0x0013DA, 0x00131C, 0x80137F,
+                            0x0014A0, 0x8014C3, 0x801405, 0x001466, 0x801589, 0x0015EA, 0x00152C, 0x80154F,
+                            0x801691, 0x0016F2, 0x001634, 0x801657, 0x0017B8, 0x8017DB, 0x80171D, 0x00177E,
+                            0x0018C0, 0x8018A3, 0x801865, 0x001806, 0x8019E9, 0x00198A, 0x00194C, 0x80192F,
+                            0x801AF1, 0x001A92, 0x001A54, 0x801A37, 0x001BD8, 0x801BBB, 0x801B7D, 0x001B1E,
+                            0x801CC1, 0x001CA2, 0x001C64, 0x801C07, 0x001DE8, 0x801D8B, 0x801D4D, 0x001D2E,
+                            0x001EF0, 0x801E93, 0x801E55, 0x001E36, 0x801FD9, 0x001FBA, 0x001F7C, 0x801F1F,
+                            0x802121, 0x002142, 0x002184, 0x8021E7, 0x002008, 0x80206B, 0x8020AD, 0x0020CE,
+                            0x002310, 0x802373, 0x8023B5, 0x0023D6, 0x802239, 0x00225A, 0x00229C, 0x8022FF,
+                            0x002520, 0x802543, 0x802585, 0x0025E6, 0x802409, 0x00246A, 0x0024AC, 0x8024CF,
+                            0x802711, 0x002772, 0x0027B4, 0x8027D7, 0x002638, 0x80265B, 0x80269D, 0x0026FE,
+                            0x002940, 0x802923, 0x8029E5, 0x002986, 0x802869, 0x00280A, 0x0028CC, 0x8028AF,
+                            0x802B71, 0x002B12, 0x002BD4, 0x802BB7, 0x002A58, 0x802A3B, 0x802AFD, 0x002A9E,
+                            0x802D41, 0x002D22, 0x002DE4, 0x802D87, 0x002C68, 0x802C0B, 0x802CCD, 0x002CAE,
+                            0x002F70, 0x802F13, 0x802FD5, 0x002FB6, 0x802E59, 0x002E3A, 0x002EFC, 0x802E9F,
+                            0x003180, 0x8031E3, 0x803125, 0x003146, 0x8030A9, 0x0030CA, 0x00300C, 0x80306F,
+                            0x8033B1, 0x0033D2, 0x003314, 0x803377, 0x003298, 0x8032FB, 0x80323D, 0x00325E,
+                            0x803581, 0x0035E2, 0x003524, 0x803547, 0x0034A8, 0x8034CB, 0x80340D, 0x00346E,
+                            0x0037B0, 0x8037D3, 0x803715, 0x003776, 0x803699, 0x0036FA, 0x00363C, 0x80365F,
+                            0x8039E1, 0x003982, 0x003944, 0x803927, 0x0038C8, 0x8038AB, 0x80386D, 0x00380E,
+                            0x003BD0, 0x803BB3, 0x803B75, 0x003B16, 0x803AF9, 0x003A9A, 0x003A5C, 0x803A3F,
+                            0x003DE0, 0x803D83, 0x803D45, 0x003D26, 0x803CC9, 0x003CAA, 0x003C6C, 0x803C0F,
+                            0x803FD1, 0x003FB2, 0x003F74, 0x803F17, 0x003EF8, 0x803E9B, 0x803E5D, 0x003E3E};
+
+// FFTW wisdom store directory, FFTW planning is process wide so this is
+// shared by all LIBLTE_PHY_STRUCTs
+char FFTW_WISDOM_PATH[LIBLTE_PHY_FFTW_WISDOM_PATH_MAX] = "";
+
+// DSP kernel selection, the CPU is the same for all LIBLTE_PHY_STRUCTs
+// so this is process wide
+LIBLTE_PHY_SIMD_ENUM PHY_SIMD        = LIBLTE_PHY_SIMD_SCALAR;
+PHY_KERNEL_STRUCT    PHY_KERNELS;
+pthread_once_t       PHY_KERNEL_ONCE = PTHREAD_ONCE_INIT;
+
+// Transport Block Size from 3GPP TS 36.213 v10.3.0 table 7.1.7.2.1-1,
+// exported through liblte_phy_kernels.h
 uint32 TBS_71721[27][110] = {{   16,   32,   56,   88,  120,  152,  176,  208,  224,  256,  288,
                                 328,  344,  376,  392,  424,  456,  488,  504,  536,  568,  600,
                                 616,  648,  680,  712,  744,  776,  776,  808,  840,  872,  904,
@@ -720,6 +855,17 @@ uint32 TBS_71721[27][110] = {{   16,   32,   56,   88,  120,  152,  176,  208,
 uint32 TBS_71723[32] = {  40,  56,  72, 120, 136, 144, 176, 208, 224, 256, 280, 296, 328, 336, 392, 488,
                          552, 600, 632, 696, 776, 840, 904,1000,1064,1128,1224,1288,1384,1480,1608,1736};
 
+// Downlink CRS symbols, 14 and 15 being in the next subframe, and v for each antenna port from 3GPP TS 36.211 v10.1.0 section 6.10.1.2
+uint32 DL_CE_N_CRS_SYMBS[4]  = {5, 5, 3, 3};
+uint32 DL_CE_CRS_SYMB[4][5]  = {{0, 4, 7, 11, 14},
+                                {0, 4, 7, 11, 14},
+                                {1, 8, 15, 0, 0},
+                                {1, 8, 15, 0, 0}};
+uint32 DL_CE_CRS_V[4][5]     = {{0, 3, 0, 3, 0},
+                                {3, 0, 3, 0, 3},
+                                {0, 3, 0, 0, 0},
+                                {3, 0, 3, 0, 0}};
+
 /*******************************************************************************
                               LOCAL FUNCTION PROTOTYPES
 *******************************************************************************/
@@ -929,6 +1075,21 @@ void prach_preamble_seq_gen(LIBLTE_PHY_STRUCT *phy_struct,
                             uint32             zczc,
                             bool               hs_flag);
 
+/*********************************************************************
+    Name: prach_corr_mult
+
+    Description: Multiplies the received PRACH subcarriers with the
+                 conjugate of every root sequence, filling the input
+                 of the batched correlation IDFT
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void prach_corr_mult(LIBLTE_PHY_STRUCT *phy_struct);
+
 /*********************************************************************
     Name: layer_mapper_dl
 
@@ -1152,6 +1313,59 @@ void generate_pss(uint32  N_id_2,
                   float  *pss_re,
                   float  *pss_im);
 
+/*********************************************************************
+    Name: pss_corr_pre_calc
+
+    Description: Builds the overlap-save correlation filters for each
+                 N_id_2 and for frequency offsets of -1, 0, and +1
+                 subcarriers
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void pss_corr_pre_calc(LIBLTE_PHY_STRUCT *phy_struct);
+
+/*********************************************************************
+    Name: s2s_subframe_pre_calc
+
+    Description: Creates the batched subframe plans used by
+                 symbols_to_samples_dl_subframe,
+                 samples_to_symbols_dl_subframe, and
+                 samples_to_symbols_ul_subframe, along with the uplink
+                 half subcarrier shift
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 5.6 and 6.12
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void s2s_subframe_pre_calc(LIBLTE_PHY_STRUCT *phy_struct);
+
+/*********************************************************************
+    Name: pss_corr_block
+
+    Description: Correlates a block of samples against the time domain
+                 PSS using overlap-save, producing the correlation
+                 magnitude at N_offsets consecutive sample offsets
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void pss_corr_block(LIBLTE_PHY_STRUCT *phy_struct,
+                    float             *i_samps,
+                    float             *q_samps,
+                    uint32             N_offsets,
+                    uint32             N_id_2,
+                    uint32             freq_hyp,
+                    float             *abs_corr);
+
 /*********************************************************************
     Name: generate_sss
 
@@ -1172,2755 +1386,4220 @@ void generate_sss(LIBLTE_PHY_STRUCT *phy_struct,
                   float             *sss_im_5);
 
 /*********************************************************************
-    Name: symbols_to_samples_dl
+    Name: dl_timing_cp_corr
 
-    Description: Converts subcarrier symbols to I/Q samples for the
-                 downlink
+    Description: Accumulates the magnitude squared of the cyclic
+                 prefix auto-correlation at every sample offset of a
+                 slot, sliding the correlation window one sample at a
+                 time
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.12
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void symbols_to_samples_dl(LIBLTE_PHY_STRUCT *phy_struct,
-                           float             *symb_re,
-                           float             *symb_im,
-                           uint32             symbol_offset,
-                           float             *samps_re,
-                           float             *samps_im,
-                           uint32            *N_samps);
+void dl_timing_cp_corr(LIBLTE_PHY_STRUCT *phy_struct,
+                       float             *i_samps,
+                       float             *q_samps,
+                       float             *abs_corr);
 
 /*********************************************************************
-    Name: symbols_to_samples_ul
+    Name: sss_pre_calc
 
-    Description: Converts subcarrier symbols to I/Q samples for the
-                 uplink
+    Description: Builds the SSS references for every N_id_2 and N_id_1
+                 in subframes 0 and 5, keeping only the 62 subcarriers
+                 the SSS occupies
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.6
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.2.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void symbols_to_samples_ul(LIBLTE_PHY_STRUCT *phy_struct,
-                           float             *symb_re,
-                           float             *symb_im,
-                           uint32             symbol_offset,
-                           float             *samps_re,
-                           float             *samps_im,
-                           uint32            *N_samps);
+void sss_pre_calc(LIBLTE_PHY_STRUCT *phy_struct);
 
 /*********************************************************************
-    Name: samples_to_symbols_dl
+    Name: sss_correlate_scalar
 
-    Description: Converts I/Q samples to subcarrier symbols for the
-                 downlink
+    Description: Correlates the received SSS subcarriers against N_refs
+                 real valued SSS references as one matrix-vector
+                 product, producing the correlation magnitude for each
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.12
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void samples_to_symbols_dl(LIBLTE_PHY_STRUCT *phy_struct,
-                           float             *samps_re,
-                           float             *samps_im,
-                           uint32             slot_start_idx,
-                           uint32             symbol_offset,
-                           uint8              scale,
-                           float             *symb_re,
-                           float             *symb_im);
+void sss_correlate_scalar(float  *sss_ref,
+                          uint32  N_refs,
+                          float  *y_re,
+                          float  *y_im,
+                          float  *abs_corr);
 
+#if defined(__SSE2__)
 /*********************************************************************
-    Name: samples_to_symbols_ul
+    Name: sss_correlate_sse2
 
-    Description: Converts I/Q samples to subcarrier symbols for the
-                 uplink
+    Description: SSE2 version of sss_correlate_scalar
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.6
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void samples_to_symbols_ul(LIBLTE_PHY_STRUCT *phy_struct,
-                           float             *samps_re,
-                           float             *samps_im,
-                           uint32             slot_start_idx,
-                           uint32             symbol_offset,
-                           float             *symb_re,
-                           float             *symb_im);
-
+void sss_correlate_sse2(float  *sss_ref,
+                        uint32  N_refs,
+                        float  *y_re,
+                        float  *y_im,
+                        float  *abs_corr);
+#endif
+
+#if defined(PHY_KERNEL_X86)
 /*********************************************************************
-    Name: modulation_mapper
+    Name: sss_correlate_avx2
 
-    Description: Maps binary digits to complex-valued modulation
-                 symbols
-
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
+    Description: AVX2 version of sss_correlate_scalar
 
-    NOTES: Currently only supports BPSK and QPSK
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void modulation_mapper(uint8                           *bits,
-                       uint32                           N_bits,
-                       LIBLTE_PHY_MODULATION_TYPE_ENUM  type,
-                       float                           *d_re,
-                       float                           *d_im,
-                       uint32                          *M_symb);
+PHY_TARGET_AVX2
+void sss_correlate_avx2(float  *sss_ref,
+                        uint32  N_refs,
+                        float  *y_re,
+                        float  *y_im,
+                        float  *abs_corr);
 
 /*********************************************************************
-    Name: modulation_demapper
-
-    Description: Maps complex-valued modulation symbols to binary
-                 digits
+    Name: hsum_avx512
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
+    Description: Sums the 16 values of an AVX-512 register
 
-    NOTES: Currently only supports BPSK and QPSK
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void modulation_demapper(float                           *d_re,
-                         float                           *d_im,
-                         uint32                           M_symb,
-                         LIBLTE_PHY_MODULATION_TYPE_ENUM  type,
-                         int8                            *bits,
-                         uint32                          *N_bits);
+PHY_TARGET_AVX512
+float hsum_avx512(__m512 v);
 
 /*********************************************************************
-    Name: generate_prs_c
+    Name: sss_correlate_avx512
 
-    Description: Generates the psuedo random sequence c
+    Description: AVX-512 version of sss_correlate_scalar
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void generate_prs_c(uint32  c_init,
-                    uint32  len,
-                    uint32 *c);
+PHY_TARGET_AVX512
+void sss_correlate_avx512(float  *sss_ref,
+                          uint32  N_refs,
+                          float  *y_re,
+                          float  *y_im,
+                          float  *abs_corr);
+#endif
 
 /*********************************************************************
-    Name: calc_crc
+    Name: symbols_to_samples_dl_subframe
 
-    Description: Calculates one of the LTE CRCs
+    Description: Converts the subcarrier symbols of a downlink
+                 subframe to I/Q samples, transforming all 14 symbols
+                 with one batched IFFT that writes directly into the
+                 output between the cyclic prefixes
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.12
 *********************************************************************/
 // Defines
-#define CRC24A 0x01864CFB
-#define CRC24B 0x01800063
-#define CRC16  0x00011021
-#define CRC8   0x0000019B
 // Enums
 // Structs
 // Functions
-void calc_crc(uint8  *a_bits,
-              uint32  N_a_bits,
-              uint32  crc,
-              uint8  *p_bits,
-              uint32  N_p_bits);
+void symbols_to_samples_dl_subframe(LIBLTE_PHY_STRUCT *phy_struct,
+                                    float             *symb_re,
+                                    float             *symb_im,
+                                    uint32             symb_stride,
+                                    float             *samps_re,
+                                    float             *samps_im);
 
 /*********************************************************************
-    Name: code_block_segmentation
+    Name: symbols_to_samples_ul
 
-    Description: Performs code block segmentation for turbo coded
-                 channels
+    Description: Converts subcarrier symbols to I/Q samples for the
+                 uplink
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.6
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void code_block_segmentation(uint8  *b_bits,
-                             uint32  N_b_bits,
-                             uint32 *N_codeblocks,
-                             uint32 *N_filler_bits,
-                             uint8  *c_bits,
-                             uint32  N_c_bits_max,
-                             uint32 *N_c_bits);
+void symbols_to_samples_ul(LIBLTE_PHY_STRUCT *phy_struct,
+                           float             *symb_re,
+                           float             *symb_im,
+                           uint32             symbol_offset,
+                           float             *samps_re,
+                           float             *samps_im,
+                           uint32            *N_samps);
 
 /*********************************************************************
-    Name: code_block_desegmentation
+    Name: samples_to_symbols_dl
 
-    Description: Performs code block desegmentation for turbo coded
-                 channels
+    Description: Converts I/Q samples to subcarrier symbols for the
+                 downlink
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.12
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void code_block_desegmentation(uint8  *c_bits,
-                               uint32 *N_c_bits,
-                               uint32  N_c_bits_max,
-                               uint32  tbs,
-                               uint8  *b_bits,
-                               uint32  N_b_bits);
+void samples_to_symbols_dl(LIBLTE_PHY_STRUCT *phy_struct,
+                           float             *samps_re,
+                           float             *samps_im,
+                           uint32             slot_start_idx,
+                           uint32             symbol_offset,
+                           uint8              scale,
+                           float             *symb_re,
+                           float             *symb_im);
 
 /*********************************************************************
-    Name: conv_encode
+    Name: normalize_unit_magnitude_scalar
 
-    Description: Convolutionally encodes a bit array using the
-                 provided parameters
+    Description: Scales complex values to unit magnitude, keeping their
+                 angle
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void conv_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                 uint8             *c_bits,
-                 uint32             N_c_bits,
-                 uint32             constraint_len,
-                 uint32             rate,
-                 uint32            *g,
-                 bool               tail_bit,
-                 uint8             *d_bits,
-                 uint32            *N_d_bits);
+void normalize_unit_magnitude_scalar(float  *re,
+                                     float  *im,
+                                     uint32  N);
 
+#if defined(__SSE2__)
 /*********************************************************************
-    Name: conv_encode_soft
+    Name: normalize_unit_magnitude_sse2
 
-    Description: Convolutionally encodes a soft bit array using the
-                 provided parameters
+    Description: SSE2 version of normalize_unit_magnitude_scalar, 4
+                 values at a time
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void conv_encode_soft(LIBLTE_PHY_STRUCT *phy_struct,
-                      int8              *c_bits,
-                      uint32             N_c_bits,
-                      uint32             constraint_len,
-                      uint32             rate,
-                      uint32            *g,
-                      bool               tail_bit,
-                      int8              *d_bits,
-                      uint32            *N_d_bits);
+void normalize_unit_magnitude_sse2(float  *re,
+                                   float  *im,
+                                   uint32  N);
+#endif
 
+#if defined(PHY_KERNEL_X86)
 /*********************************************************************
-    Name: viterbi_decode
+    Name: normalize_unit_magnitude_avx2
 
-    Description: Viterbi decodes a convolutionally coded input bit
-                 array using the provided parameters
+    Description: AVX2 version of normalize_unit_magnitude_scalar, 8
+                 values at a time
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void viterbi_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                    float             *d_bits,
-                    uint32             N_d_bits,
-                    uint32             constraint_len,
-                    uint32             rate,
-                    uint32            *g,
-                    uint8             *c_bits,
-                    uint32            *N_c_bits);
+PHY_TARGET_AVX2
+void normalize_unit_magnitude_avx2(float  *re,
+                                   float  *im,
+                                   uint32  N);
 
 /*********************************************************************
-    Name: viterbi_decode_siso
+    Name: normalize_unit_magnitude_avx512
 
-    Description: Soft input soft output viterbi decodes a
-                 convolutionally coded input bit array using the
-                 provided parameters
+    Description: AVX-512 version of normalize_unit_magnitude_scalar,
+                 16 values at a time.  rsqrt14 is good to 14 bits so
+                 the Newton-Raphson step brings it to full precision.
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void viterbi_decode_siso(LIBLTE_PHY_STRUCT *phy_struct,
-                         int8              *d_bits,
-                         uint32             N_d_bits,
-                         uint32             constraint_len,
-                         uint32             rate,
-                         uint32            *g,
-                         int8              *c_bits,
-                         uint32            *N_c_bits);
+PHY_TARGET_AVX512
+void normalize_unit_magnitude_avx512(float  *re,
+                                     float  *im,
+                                     uint32  N);
+#endif
 
 /*********************************************************************
-    Name: turbo_encode
-
-    Description: Turbo encodes a bit array using the LTE Parallel
-                 Concatenated Convolutional Code
+    Name: samples_to_symbols_dl_subframe
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+    Description: Converts the I/Q samples of a downlink subframe to
+                 subcarrier symbols, transforming all 14 symbols with
+                 one batched FFT that reads directly from the input
 
-    Notes: Currently not handling filler bits
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.12
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void turbo_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                  uint8             *c_bits,
-                  uint32             N_c_bits,
-                  uint32             N_fill_bits,
-                  uint8             *d_bits,
-                  uint32            *N_d_bits);
+void samples_to_symbols_dl_subframe(LIBLTE_PHY_STRUCT *phy_struct,
+                                    float             *samps_re,
+                                    float             *samps_im,
+                                    uint32             subfr_start_idx,
+                                    float             *symb_re,
+                                    float             *symb_im,
+                                    uint32             symb_stride);
 
 /*********************************************************************
-    Name: turbo_decode
+    Name: samples_to_symbols_ul_subframe
 
-    Description: Turbo decodes data according to the LTE Parallel
-                 Concatenated Convolutional Code.  The design of this
-                 decoder is based on the conversion of the constituent
-                 coder from:
-                                   -------->+---------------->+---- out
-                                   |        ^                 ^
-                           in_act  |   |-|  |   |-|      |-|  |
-                 in --->+------------->|D|----->|D|----->|D|---
-                        ^              |-|      |-|  |   |-|  |
-                        |                            v        |
-                        -----------------------------+<--------
-                 to:
-                           ------->+---------------->+------------- out
-                           |       ^                 ^
-                           |  |-|  |   |-|      |-|  |       
-                 in_act ------|D|----->|D|----->|D|---         
-                           |  |-|      |-|  |   |-|  |          
-                           |                v        v         
-                           ---------------->+------->+------------- in
-                 in_act can be determined using viterbi decoding and
-                 a second copy of in can be calculated using in_act
-
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+    Description: Converts the I/Q samples of an uplink subframe to
+                 subcarrier symbols, transforming all 14 symbols with
+                 one batched FFT
 
-    Notes: Currently not handling filler bits
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.6
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void turbo_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                  float             *d_bits,
-                  uint32             N_d_bits,
-                  uint32             N_fill_bits,
-                  uint8             *c_bits,
-                  uint32            *N_c_bits);
+void samples_to_symbols_ul_subframe(LIBLTE_PHY_STRUCT *phy_struct,
+                                    float             *samps_re,
+                                    float             *samps_im,
+                                    float             *symb_re,
+                                    float             *symb_im,
+                                    uint32             symb_stride);
 
 /*********************************************************************
-    Name: turbo_constituent_encoder
+    Name: modulation_mapper
 
-    Description: Constituent encoder for the LTE Parallel Concatenated
-                 Convolutional Code
+    Description: Maps binary digits to complex-valued modulation
+                 symbols
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
+
+    NOTES: Currently only supports BPSK and QPSK
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void turbo_constituent_encoder(uint8  *in_bits,
-                               uint32  N_in_bits,
-                               uint8  *out_bits,
-                               uint8  *fb_bits);
+void modulation_mapper(uint8                           *bits,
+                       uint32                           N_bits,
+                       LIBLTE_PHY_MODULATION_TYPE_ENUM  type,
+                       float                           *d_re,
+                       float                           *d_im,
+                       uint32                          *M_symb);
 
 /*********************************************************************
-    Name: turbo_internal_interleaver
+    Name: modulation_demapper
 
-    Description: Internal interleaver for the LTE Parallel
-                 Concatenated Convolutional Code
+    Description: Maps complex-valued modulation symbols to 8 bit max-log
+                 soft bits, positive for a binary 0.  Uses the piecewise
+                 linear LLRs of Gray mapped QAM, re and im for the first
+                 two bits, then A - |previous| for each following pair.
+                 Each RE is scaled by 1/noise_var when noise_var is not
+                 NULL, otherwise by 1/d so that a received point d from
+                 a decision boundary maps to DEMAP_INT8_UNIT.
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
 *********************************************************************/
 // Defines
+#define DEMAP_INT8_UNIT     32
+#define DEMAP_INT8_STEPS    4
+#define DEMAP_INT8_MAX      127
+#define DEMAP_NOISE_VAR_MIN 1e-6
 // Enums
 // Structs
 // Functions
-void turbo_internal_interleaver(uint8  *in_bits,
-                                uint32  N_in_bits,
-                                uint8  *out_bits);
-void turbo_internal_interleaver(int8   *in_bits,
-                                uint32  N_in_bits,
-                                int8   *out_bits);
-void turbo_internal_interleaver(float  *in_bits,
-                                uint32  N_in_bits,
-                                float  *out_bits);
+void modulation_demapper(float                           *d_re,
+                         float                           *d_im,
+                         float                           *noise_var,
+                         uint32                           M_symb,
+                         LIBLTE_PHY_MODULATION_TYPE_ENUM  type,
+                         int8                            *bits,
+                         uint32                          *N_bits);
 
 /*********************************************************************
-    Name: turbo_internal_deinterleaver
+    Name: modulation_demapper_llr_scalar
 
-    Description: Internal Deinterleaver for the LTE Parallel
-                 Concatenated Convolutional Code
+    Description: Calculates the LLRs of M_symb REs for
+                 modulation_demapper, A holds the decision boundary
+                 for each bit of an RE
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void turbo_internal_deinterleaver(float  *in_bits,
-                                  uint32  N_in_bits,
-                                  float  *out_bits);
-void turbo_internal_deinterleaver(int8   *in_bits,
-                                  uint32  N_in_bits,
-                                  int8   *out_bits);
-
+void modulation_demapper_llr_scalar(float  *d_re,
+                                    float  *d_im,
+                                    float  *noise_var,
+                                    uint32  M_symb,
+                                    uint32  Q_m,
+                                    float  *A,
+                                    float   unit_scale,
+                                    float   nv_scale,
+                                    int8   *bits);
+
+#if defined(__SSE2__)
 /*********************************************************************
-    Name: rate_match_turbo
+    Name: modulation_demapper_llr_sse2
 
-    Description: Rate matches turbo encoded data
+    Description: SSE2 version of modulation_demapper_llr_scalar,
+                 blocks of 8 REs are processed at a time
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void rate_match_turbo(LIBLTE_PHY_STRUCT         *phy_struct,
-                      uint8                     *d_bits,
-                      uint32                     N_d_bits,
-                      uint32                     N_codeblocks,
-                      uint32                     tx_mode,
-                      uint32                     N_soft,
-                      uint32                     M_dl_harq,
-                      LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type,
-                      uint32                     rv_idx,
-                      uint32                     N_e_bits,
-                      uint8                     *e_bits);
+void modulation_demapper_llr_sse2(float  *d_re,
+                                  float  *d_im,
+                                  float  *noise_var,
+                                  uint32  M_symb,
+                                  uint32  Q_m,
+                                  float  *A,
+                                  float   unit_scale,
+                                  float   nv_scale,
+                                  int8   *bits);
+#endif
 
 /*********************************************************************
-    Name: rate_unmatch_turbo
+    Name: generate_prs_c
 
-    Description: Rate unmatches turbo encoded data
+    Description: Generates the psuedo random sequence c
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void rate_unmatch_turbo(LIBLTE_PHY_STRUCT         *phy_struct,
-                        float                     *e_bits,
-                        uint32                     N_e_bits,
-                        uint8                     *dummy_bits,
-                        uint32                     N_dummy_bits,
-                        uint32                     N_codeblocks,
-                        uint32                     tx_mode,
-                        uint32                     N_soft,
-                        uint32                     M_dl_harq,
-                        LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type,
-                        uint32                     rv_idx,
-                        float                     *d_bits,
-                        uint32                    *N_d_bits);
+void generate_prs_c(uint32  c_init,
+                    uint32  len,
+                    uint32 *c);
 
 /*********************************************************************
-    Name: rate_match_conv
+    Name: generate_prs_c_packed
 
-    Description: Rate matches convolutionally encoded data
+    Description: Generates the psuedo random sequence c, 32 bits at a
+                 time, packed LSB first into 32 bit words
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.2
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void rate_match_conv(LIBLTE_PHY_STRUCT *phy_struct,
-                     uint8             *d_bits,
-                     uint32             N_d_bits,
-                     uint32             N_e_bits,
-                     uint8             *e_bits);
+void generate_prs_c_packed(uint32  c_init,
+                           uint32  len,
+                           uint32 *c_packed);
 
 /*********************************************************************
-    Name: rate_unmatch_conv
+    Name: generate_prs_c_cached
 
-    Description: Rate unmatches convolutionally encoded data
+    Description: Generates the psuedo random sequence c using a least
+                 recently used cache of packed sequences keyed by
+                 c_init
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.2
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
 *********************************************************************/
 // Defines
-#define RX_NULL_BIT 10000
-#define TX_NULL_BIT 100
 // Enums
 // Structs
 // Functions
-void rate_unmatch_conv(LIBLTE_PHY_STRUCT *phy_struct,
-                       float             *e_bits,
-                       uint32             N_e_bits,
-                       uint32             N_c_bits,
-                       float             *d_bits,
-                       uint32            *N_d_bits);
+void generate_prs_c_cached(LIBLTE_PHY_STRUCT *phy_struct,
+                           uint32             c_init,
+                           uint32             len,
+                           uint32            *c);
 
 /*********************************************************************
-    Name: code_block_concatenation
+    Name: pack_bits
 
-    Description: Performs code block concatenation for turbo coded
-                 channels
+    Description: Packs a bit array into 64 bit words, first bit in the
+                 most significant position of the first word
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.5
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void code_block_concatenation(uint8  *e_bits,
-                              uint32 *N_e_bits,
-                              uint32  N_e_bits_max,
-                              uint32  N_codeblocks,
-                              uint8  *f_bits,
-                              uint32 *N_f_bits);
+void pack_bits(uint8  *bits,
+               uint32  N_bits,
+               uint64 *words);
 
 /*********************************************************************
-    Name: code_block_deconcatenation
+    Name: unpack_bits
 
-    Description: Performs code block deconcatenation for turbo coded
-                 channels
+    Description: Unpacks 64 bit words into a bit array
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.5
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void code_block_deconcatenation(float  *f_bits,
-                                uint32  N_f_bits,
-                                uint32  tbs,
-                                float  *e_bits,
-                                uint32 *N_e_bits,
-                                uint32  N_e_bits_max,
-                                uint32 *N_codeblocks);
+void unpack_bits(uint64 *words,
+                 uint32  N_bits,
+                 uint8  *bits);
 
 /*********************************************************************
-    Name: ulsch_data_control_multiplexing
+    Name: copy_bits
 
-    Description: Multiplexes the control and data bits for Uplink
-                 Shared Channel
+    Description: Copies a range of packed bits between arbitrary bit
+                 offsets, leaving the surrounding destination bits
+                 untouched
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.7
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void ulsch_data_control_multiplexing(uint8  *f_bits,
-                                     uint32  N_f_bits,
-                                     uint8  *cqi_bits,
-                                     uint32  N_cqi_bits,
-                                     uint32  N_l,
-                                     uint32  Q_m,
-                                     uint8  *g_bits,
-                                     uint32 *N_g_bits);
+void copy_bits(uint64 *src_words,
+               uint32  src_offset,
+               uint32  N_bits,
+               uint64 *dst_words,
+               uint32  dst_offset);
 
 /*********************************************************************
-    Name: ulsch_data_control_demultiplexing
+    Name: calc_crc
 
-    Description: Demultiplexes the control and data bits for Uplink
-                 Shared Channel
+    Description: Calculates one of the LTE CRCs
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.7
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
 *********************************************************************/
 // Defines
+#define CRC24A 0x01864CFB
+#define CRC24B 0x01800063
+#define CRC16  0x00011021
+#define CRC8   0x0000019B
 // Enums
 // Structs
 // Functions
-void ulsch_data_control_demultiplexing(float  *g_bits,
-                                       uint32  N_g_bits,
-                                       uint32  N_cqi_bits,
-                                       uint32  N_l,
-                                       uint32  Q_m,
-                                       float  *f_bits,
-                                       uint32 *N_f_bits,
-                                       float  *cqi_bits);
+void calc_crc(uint8  *a_bits,
+              uint32  N_a_bits,
+              uint32  crc,
+              uint8  *p_bits,
+              uint32  N_p_bits);
 
 /*********************************************************************
-    Name: ulsch_channel_interleaver
+    Name: calc_crc_packed
 
-    Description: Interleaves Uplink Shared Channel data with RI and
-                 ACK control information
+    Description: Calculates one of the LTE CRCs over packed bits,
+                 CRC24A and CRC24B are calculated a byte at a time
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.8
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void ulsch_channel_interleaver(LIBLTE_PHY_STRUCT *phy_struct,
-                               uint8             *g_bits,
-                               uint32             N_g_bits,
-                               uint8             *ri_bits,
-                               uint32             N_ri_bits,
-                               uint8             *ack_bits,
-                               uint32             N_ack_bits,
-                               uint32             N_l,
-                               uint32             Q_m,
-                               uint8             *h_bits,
-                               uint32            *N_h_bits);
+uint32 calc_crc_packed(uint64 *a_words,
+                       uint32  N_a_bits,
+                       uint32  crc,
+                       uint32  N_p_bits);
 
 /*********************************************************************
-    Name: ulsch_channel_deinterleaver
+    Name: code_block_segmentation
 
-    Description: Deinterleaves Uplink Shared Channel data from RI and
-                 ACK control information
+    Description: Performs code block segmentation for turbo coded
+                 channels
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.8
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void ulsch_channel_deinterleaver(LIBLTE_PHY_STRUCT *phy_struct,
-                                 float             *h_bits,
-                                 uint32             N_h_bits,
-                                 uint32             N_ri_bits,
-                                 uint32             N_ack_bits,
-                                 uint32             N_l,
-                                 uint32             Q_m,
-                                 float             *g_bits,
-                                 uint32            *N_g_bits,
-                                 float             *ri_bits,
-                                 float             *ack_bits);
+void code_block_segmentation(uint8  *b_bits,
+                             uint32  N_b_bits,
+                             uint32 *N_codeblocks,
+                             uint32 *N_filler_bits,
+                             uint8  *c_bits,
+                             uint32  N_c_bits_max,
+                             uint32 *N_c_bits);
 
 /*********************************************************************
-    Name: ulsch_channel_encode
+    Name: code_block_segmentation_packed
 
-    Description: Channel encodes the Uplink Shared Channel
-
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2
+    Description: Performs code block segmentation for turbo coded
+                 channels on packed bits, filler bits are zero
 
-    Notes: Not handling control bits
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void ulsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                          uint8             *in_bits,
-                          uint32             N_in_bits,
-                          uint32             tbs,
-                          uint32             tx_mode,
-                          uint32             G,
-                          uint32             N_l,
-                          uint32             Q_m,
-                          uint32             rv_idx,
-                          uint8             *out_bits,
-                          uint32            *N_out_bits);
+void code_block_segmentation_packed(uint64 *b_words,
+                                    uint32  N_b_bits,
+                                    uint32 *N_codeblocks,
+                                    uint32 *N_filler_bits,
+                                    uint64 *c_words,
+                                    uint32  N_c_words_max,
+                                    uint32 *N_c_bits);
 
 /*********************************************************************
-    Name: ulsch_channel_decode
-
-    Description: Channel decodes the Uplink Shared Channel
+    Name: code_block_desegmentation
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2
+    Description: Performs code block desegmentation for turbo coded
+                 channels, failing if the CRC of any code block fails
 
-    Notes: Not handling control bits
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-LIBLTE_ERROR_ENUM ulsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                       float             *in_bits,
-                                       uint32             N_in_bits,
-                                       uint32             tbs,
-                                       uint32             tx_mode,
-                                       uint32             N_l,
-                                       uint32             Q_m,
-                                       uint32             rv_idx,
-                                       uint8             *out_bits,
-                                       uint32            *N_out_bits);
+LIBLTE_ERROR_ENUM code_block_desegmentation(uint8  *c_bits,
+                                            uint32 *N_c_bits,
+                                            uint32  N_c_bits_max,
+                                            uint32  tbs,
+                                            uint8  *b_bits,
+                                            uint32  N_b_bits);
 
 /*********************************************************************
-    Name: bch_channel_encode
+    Name: conv_encode
 
-    Description: Channel encodes the broadcast channel
+    Description: Convolutionally encodes a bit array using the
+                 provided parameters
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.1
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void bch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                        uint8             *in_bits,
-                        uint32             N_in_bits,
-                        uint8              N_ant,
-                        uint8             *out_bits,
-                        uint32            *N_out_bits);
+void conv_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                 uint8             *c_bits,
+                 uint32             N_c_bits,
+                 uint32             constraint_len,
+                 uint32             rate,
+                 uint32            *g,
+                 bool               tail_bit,
+                 uint8             *d_bits,
+                 uint32            *N_d_bits);
 
 /*********************************************************************
-    Name: bch_channel_decode
+    Name: viterbi_decode
 
-    Description: Channel decodes the broadcast channel
+    Description: Tail biting Viterbi decoder for the LTE rate 1/3,
+                 constraint length 7 convolutional code.  The circular
+                 trellis is decoded by wrapping the input around both
+                 ends of the block.  All 64 states are updated with 16
+                 bit saturating add-compare-select and the survivor
+                 decisions of each step are packed into one word.
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.1
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+
+    Notes: Branch metric sign masks are pre calculated by
+           viterbi_pre_calc
 *********************************************************************/
 // Defines
+#define VD_IN_MAX  127
+#define VD_TB_WRAP 64
 // Enums
 // Structs
 // Functions
-LIBLTE_ERROR_ENUM bch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                     float             *in_bits,
-                                     uint32             N_in_bits,
-                                     uint8             *N_ant,
-                                     uint8             *out_bits,
-                                     uint32            *N_out_bits);
+void viterbi_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                    float             *d_bits,
+                    uint32             N_d_bits,
+                    uint8             *c_bits,
+                    uint32            *N_c_bits);
 
 /*********************************************************************
-    Name: dlsch_channel_encode
+    Name: viterbi_acs_scalar
 
-    Description: Channel encodes the Downlink Shared Channel
+    Description: Runs the add-compare-select of viterbi_decode over
+                 N_steps trellis steps starting with all states equal,
+                 leaving the survivor decisions in vd_dec and the final
+                 path metrics in metric
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void dlsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                          uint8             *in_bits,
-                          uint32             N_in_bits,
-                          uint32             tbs,
-                          uint32             tx_mode,
-                          uint32             rv_idx,
-                          uint32             G,
-                          uint32             N_l,
-                          uint32             Q_m,
-                          uint32             M_dl_harq,
-                          uint32             N_soft,
-                          uint8             *out_bits,
-                          uint32            *N_out_bits);
+void viterbi_acs_scalar(LIBLTE_PHY_STRUCT *phy_struct,
+                        int16             *in,
+                        uint32             N_bits,
+                        uint32             N_wrap,
+                        uint32             N_steps,
+                        int16             *metric);
+
+#if defined(__SSE2__)
+/*********************************************************************
+    Name: viterbi_acs_sse2
 
+    Description: SSE2 version of viterbi_acs_scalar, 8 states per
+                 register
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void viterbi_acs_sse2(LIBLTE_PHY_STRUCT *phy_struct,
+                      int16             *in,
+                      uint32             N_bits,
+                      uint32             N_wrap,
+                      uint32             N_steps,
+                      int16             *metric);
+#endif
+
+#if defined(PHY_KERNEL_X86)
 /*********************************************************************
-    Name: dlsch_channel_decode
+    Name: viterbi_acs_avx2
 
-    Description: Channel decodes the Downlink Shared Channel
+    Description: AVX2 version of viterbi_acs_scalar, 16 states per
+                 register.  The packs work within each 128 bit lane so
+                 their 64 bit blocks are put back in state order with
+                 a permute.
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-LIBLTE_ERROR_ENUM dlsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                       float             *in_bits,
-                                       uint32             N_in_bits,
-                                       uint32             tbs,
-                                       uint32             tx_mode,
-                                       uint32             rv_idx,
-                                       uint32             M_dl_harq,
-                                       uint32             N_soft,
-                                       uint8             *out_bits,
-                                       uint32            *N_out_bits);
+PHY_TARGET_AVX2
+void viterbi_acs_avx2(LIBLTE_PHY_STRUCT *phy_struct,
+                      int16             *in,
+                      uint32             N_bits,
+                      uint32             N_wrap,
+                      uint32             N_steps,
+                      int16             *metric);
+#endif
 
 /*********************************************************************
-    Name: dci_channel_encode
+    Name: viterbi_pre_calc
 
-    Description: Channel encodes the Downlink Control Information
-                 channel
+    Description: Pre calculates the Viterbi decoder branch metric
+                 sign masks for the LTE rate 1/3, constraint length 7
+                 convolutional code.
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void dci_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                        uint8             *in_bits,
-                        uint32             N_in_bits,
-                        uint16             rnti,
-                        uint8              ue_ant,
-                        uint32             N_out_bits,
-                        uint8             *out_bits);
+void viterbi_pre_calc(LIBLTE_PHY_STRUCT *phy_struct);
 
 /*********************************************************************
-    Name: dci_channel_decode
+    Name: turbo_encode
 
-    Description: Channel decodes the Downlink Control Information
-                 channel
+    Description: Turbo encodes a bit array using the LTE Parallel
+                 Concatenated Convolutional Code
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-LIBLTE_ERROR_ENUM dci_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                     float             *in_bits,
-                                     uint32             N_in_bits,
-                                     uint16             rnti_start,
-                                     uint16             rnti_range,
-                                     uint8              ue_ant,
-                                     uint8             *out_bits,
-                                     uint32             N_out_bits,
-                                     uint16            *rnti_found);
+LIBLTE_ERROR_ENUM turbo_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                               uint8             *c_bits,
+                               uint32             N_c_bits,
+                               uint32             N_fill_bits,
+                               uint8             *d_bits,
+                               uint32            *N_d_bits);
 
 /*********************************************************************
-    Name: dci_0_pack
+    Name: turbo_encode_packed
 
-    Description: Packs all of the fields into the Downlink Control
-                 Information format 0
-
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.1
-                        3GPP TS 36.213 v10.3.0 section 8.1.1
-                        3GPP TS 36.213 v10.3.0 section 8.6
+    Description: Turbo encodes packed bits using the LTE Parallel
+                 Concatenated Convolutional Code, producing the three
+                 packed output streams d0, d1, and d2
 
-    Notes: Currently only handles non-hopping single-cluster
-           assignments
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 *********************************************************************/
 // Defines
-#define DCI_0_1A_FLAG_0          0
-#define DCI_0_1A_FLAG_1A         1
-#define DCI_VRB_TYPE_LOCALIZED   0
-#define DCI_VRB_TYPE_DISTRIBUTED 1
 // Enums
 // Structs
 // Functions
-void dci_0_pack(LIBLTE_PHY_ALLOCATION_STRUCT    *alloc,
-                LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
-                uint32                           N_rb_ul,
-                uint8                            N_ant,
-                uint8                           *out_bits,
-                uint32                          *N_out_bits);
+LIBLTE_ERROR_ENUM turbo_encode_packed(LIBLTE_PHY_STRUCT *phy_struct,
+                                      uint64            *c_words,
+                                      uint32             N_c_bits,
+                                      uint64            *d_words,
+                                      uint32             N_d_words_max,
+                                      uint32            *N_d_bits);
 
 /*********************************************************************
-    Name: dci_0_unpack
+    Name: turbo_encode_pre_calc
 
-    Description: Unpacks all of the fields from the Downlink Control
-                 Information format 0
+    Description: Builds the constituent encoder table used by
+                 turbo_encode_packed, indexed by encoder state and
+                 input byte
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.1
-                        3GPP TS 36.213 v10.3.0 section 8.1.1
-                        3GPP TS 36.213 v10.3.0 section 8.6
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void turbo_encode_pre_calc(LIBLTE_PHY_STRUCT *phy_struct);
 
-    Notes: N/A
+/*********************************************************************
+    Name: turbo_decode
+
+    Description: Turbo decodes data according to the LTE Parallel
+                 Concatenated Convolutional Code.  Two max-log-MAP
+                 constituent decoders exchange extrinsic information
+                 for up to td_N_iter iterations, stopping as soon as
+                 the code block CRC passes.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 *********************************************************************/
 // Defines
+#define TD_IN_MAX     256
+#define TD_EXT_MAX    1024
+#define TD_METRIC_MIN -8192
 // Enums
 // Structs
 // Functions
-// FIXME
+LIBLTE_ERROR_ENUM turbo_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                               float             *d_bits,
+                               uint32             N_d_bits,
+                               uint32             N_fill_bits,
+                               uint32             crc,
+                               uint8             *c_bits,
+                               uint32            *N_c_bits);
 
 /*********************************************************************
-    Name: dci_1a_pack
+    Name: turbo_map_decode
 
-    Description: Packs all of the fields into the Downlink Control
-                 Information format 1A
+    Description: Max-log-MAP (BCJR) decoder for one of the LTE turbo
+                 code constituent encoders.  The 8 trellis states are
+                 processed as 8 int16 lanes, the trellis termination is
+                 handled here and the recursions by the selected
+                 turbo_map_recursions kernel.
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.3
-                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
-                        3GPP TS 36.213 v10.3.0 section 7.1.7
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2.1
 
-    Notes: Currently only handles localized virtual resource blocks
+    Notes: Branch and path metrics are kept at twice their natural
+           scale and the extrinsic output is scaled by 0.75
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void dci_1a_pack(LIBLTE_PHY_ALLOCATION_STRUCT    *alloc,
-                 LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
-                 uint32                           N_rb_dl,
-                 uint8                            N_ant,
-                 uint8                           *out_bits,
-                 uint32                          *N_out_bits);
+void turbo_map_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                      int16             *sys,
+                      int16             *par,
+                      int16             *apriori,
+                      int16             *tail,
+                      uint32             K,
+                      int16             *ext);
 
 /*********************************************************************
-    Name: dci_1a_unpack
+    Name: turbo_map_recursions_scalar
 
-    Description: Unpacks all of the fields from the Downlink Control
-                 Information format 1A
+    Description: Forward and backward recursions of turbo_map_decode,
+                 starting the backward recursion from the terminated
+                 beta
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.3
-                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
-                        3GPP TS 36.213 v10.3.0 section 7.1.7
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void turbo_map_recursions_scalar(LIBLTE_PHY_STRUCT *phy_struct,
+                                 int16             *sys,
+                                 int16             *par,
+                                 int16             *apriori,
+                                 int16             *beta,
+                                 uint32             K,
+                                 int16             *ext);
+
+#if defined(__SSE2__)
+/*********************************************************************
+    Name: turbo_map_recursions_sse2
 
-    Notes: Currently only handles SI-RNTI, P-RNTI, or RA-RNTI and
-           localized virtual resource blocks
+    Description: SSE2 version of turbo_map_recursions_scalar
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-LIBLTE_ERROR_ENUM dci_1a_unpack(uint8                           *in_bits,
-                                uint32                           N_in_bits,
-                                LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
-                                uint16                           rnti,
-                                uint32                           N_rb_dl,
-                                uint8                            N_ant,
-                                LIBLTE_PHY_ALLOCATION_STRUCT    *alloc);
+void turbo_map_recursions_sse2(LIBLTE_PHY_STRUCT *phy_struct,
+                               int16             *sys,
+                               int16             *par,
+                               int16             *apriori,
+                               int16             *beta,
+                               uint32             K,
+                               int16             *ext);
+#endif
+
+#if defined(PHY_KERNEL_X86)
+/*********************************************************************
+    Name: turbo_map_recursions_sse4_1
+
+    Description: SSE4.1 version of turbo_map_recursions_scalar.  The
+                 branch metric sign flips use psignw, the even and odd
+                 predecessors are gathered with pshufb, and the
+                 extrinsic maximums come from phminposuw on the
+                 metrics flipped by 0x7FFF.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+PHY_TARGET_SSE4_1
+void turbo_map_recursions_sse4_1(LIBLTE_PHY_STRUCT *phy_struct,
+                                 int16             *sys,
+                                 int16             *par,
+                                 int16             *apriori,
+                                 int16             *beta,
+                                 uint32             K,
+                                 int16             *ext);
+#endif
 
 /*********************************************************************
-    Name: dci_1c_pack
+    Name: turbo_internal_interleaver
 
-    Description: Packs all of the fields into the Downlink Control
-                 Information format 1C
+    Description: Internal interleaver for the LTE Parallel
+                 Concatenated Convolutional Code, N_in_bits must be
+                 one of the 188 sizes in TURBO_INT_K_TABLE
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.4
-                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
-                        3GPP TS 36.213 v10.3.0 section 7.1.7
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-// FIXME
+LIBLTE_ERROR_ENUM turbo_internal_interleaver_idx(uint32  N_in_bits,
+                                                 uint16 *idx);
 
 /*********************************************************************
-    Name: dci_1c_unpack
+    Name: rate_match_turbo_table
 
-    Description: Unpacks all of the fields from the Downlink Control
-                 Information format 1C
+    Description: Looks up the circular buffer index table of a turbo
+                 code block in the rate match index cache, building it
+                 in place of the least recently used entry if needed
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.4
-                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
-                        3GPP TS 36.213 v10.3.0 section 7.1.7
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1
+*********************************************************************/
+// Defines
+#define RMT_NULL_IDX 0xFFFF
+// Enums
+// Structs
+// Functions
+LIBLTE_PHY_RM_CACHE_STRUCT* rate_match_turbo_table(LIBLTE_PHY_STRUCT         *phy_struct,
+                                                   uint32                     N_branch_bits,
+                                                   uint32                     N_fill_bits,
+                                                   uint32                     N_codeblocks,
+                                                   uint32                     tx_mode,
+                                                   uint32                     N_soft,
+                                                   uint32                     M_dl_harq,
+                                                   LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type);
 
-    Notes: Currently only handling SI-RNTI, P-RNTI, and RA-RNTI
+/*********************************************************************
+    Name: rate_match_turbo
+
+    Description: Rate matches turbo encoded data
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void dci_1c_unpack(uint8                        *in_bits,
-                   uint32                        N_in_bits,
-                   uint16                        rnti,
-                   uint32                        N_rb_dl,
-                   uint8                         N_ant,
-                   LIBLTE_PHY_ALLOCATION_STRUCT *alloc);
+void rate_match_turbo(LIBLTE_PHY_STRUCT         *phy_struct,
+                      uint8                     *d_bits,
+                      uint32                     N_d_bits,
+                      uint32                     N_codeblocks,
+                      uint32                     tx_mode,
+                      uint32                     N_soft,
+                      uint32                     M_dl_harq,
+                      LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type,
+                      uint32                     rv_idx,
+                      uint32                     N_e_bits,
+                      uint8                     *e_bits);
 
 /*********************************************************************
-    Name: cfi_channel_encode
+    Name: rate_match_turbo_packed
 
-    Description: Channel encodes the Control Format Indicator channel
+    Description: Rate matches packed turbo encoded data, writing the
+                 e bits at e_offset in the output so that code block
+                 concatenation happens in place
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.4
+    Document Reference: 3GPP TS 36.212 v10.1.0 sections 5.1.4.1 and
+                        5.1.5
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void cfi_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                        uint32             cfi,
-                        uint8             *out_bits,
-                        uint32            *N_out_bits);
+void rate_match_turbo_packed(LIBLTE_PHY_STRUCT         *phy_struct,
+                             uint64                    *d_words,
+                             uint32                     N_d_words_max,
+                             uint32                     N_d_bits,
+                             uint32                     N_fill_bits,
+                             uint32                     N_codeblocks,
+                             uint32                     tx_mode,
+                             uint32                     N_soft,
+                             uint32                     M_dl_harq,
+                             LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type,
+                             uint32                     rv_idx,
+                             uint32                     N_e_bits,
+                             uint64                    *e_words,
+                             uint32                     e_offset);
 
 /*********************************************************************
-    Name: cfi_channel_decode
+    Name: rate_unmatch_turbo
 
-    Description: Channel decodes the Control Format Indicator channel
+    Description: Rate unmatches turbo encoded data, soft combining
+                 repeated bits
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.4
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1
 *********************************************************************/
 // Defines
-#define CFI_N_ACCEPTABLE_BERS 4
 // Enums
 // Structs
 // Functions
-LIBLTE_ERROR_ENUM cfi_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                     float             *in_bits,
-                                     uint32             N_in_bits,
-                                     uint32            *cfi);
+void rate_unmatch_turbo(LIBLTE_PHY_STRUCT         *phy_struct,
+                        float                     *e_bits,
+                        uint32                     N_e_bits,
+                        uint32                     N_c_bits,
+                        uint32                     N_fill_bits,
+                        uint32                     N_codeblocks,
+                        uint32                     tx_mode,
+                        uint32                     N_soft,
+                        uint32                     M_dl_harq,
+                        LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type,
+                        uint32                     rv_idx,
+                        float                     *d_bits,
+                        uint32                    *N_d_bits);
 
 /*********************************************************************
-    Name: get_ul_ce
+    Name: rate_match_conv
 
-    Description: Resolves channel estimates for the uplink
+    Description: Rate matches convolutionally encoded data
 
-    Document Reference: N/A
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.2
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void get_ul_ce(LIBLTE_PHY_STRUCT *phy_struct,
-               float             *c_est_0_re,
-               float             *c_est_0_im,
-               float             *c_est_1_re,
-               float             *c_est_1_im,
-               uint32             N_prb,
-               uint32             N_subfr,
-               float             *c_est_re,
-               float             *c_est_im);
+void rate_match_conv(LIBLTE_PHY_STRUCT *phy_struct,
+                     uint8             *d_bits,
+                     uint32             N_d_bits,
+                     uint32             N_e_bits,
+                     uint8             *e_bits);
 
 /*********************************************************************
-    Name: get_soft_decision
+    Name: rate_unmatch_conv
 
-    Description: Determines the magnitude of the soft decision
+    Description: Rate unmatches convolutionally encoded data
 
-    Document Reference: N/A
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.2
 *********************************************************************/
 // Defines
+#define RX_NULL_BIT 10000
+#define TX_NULL_BIT 100
 // Enums
 // Structs
 // Functions
-float get_soft_decision(float rx_re,
-                        float rx_im,
-                        float exp_re,
-                        float exp_im,
-                        float max_dist);
-float get_soft_decision(float rx,
-                        float exp,
-                        float max_dist);
+void rate_unmatch_conv(LIBLTE_PHY_STRUCT *phy_struct,
+                       float             *e_bits,
+                       uint32             N_e_bits,
+                       uint32             N_c_bits,
+                       float             *d_bits,
+                       uint32            *N_d_bits);
 
 /*********************************************************************
-    Name: get_num_bits_in_prb
+    Name: code_block_concatenation
 
-    Description: Determines the number of bits available in a
-                 particular PRB with a particular modulation type
+    Description: Performs code block concatenation for turbo coded
+                 channels
 
-    Document Reference: N/A
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.5
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-uint32 get_num_bits_in_prb(uint32                          N_subframe,
-                           uint32                          N_ctrl_symbs,
-                           uint32                          prb,
-                           uint32                          N_rb_dl,
-                           uint8                           N_ant,
-                           LIBLTE_PHY_MODULATION_TYPE_ENUM mod_type);
+void code_block_concatenation(uint8  *e_bits,
+                              uint32 *N_e_bits,
+                              uint32  N_e_bits_max,
+                              uint32  N_codeblocks,
+                              uint8  *f_bits,
+                              uint32 *N_f_bits);
 
 /*********************************************************************
-    Name: wrap_phase
+    Name: code_block_deconcatenation
 
-    Description: Checks the phase difference between two angles and
-                 wraps one to make the difference less than 2*pi.
+    Description: Performs code block deconcatenation for turbo coded
+                 channels
 
-    Document Reference: N/A
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.5
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void wrap_phase(float *phase_1,
-                float  phase_2);
+void code_block_deconcatenation(float   *f_bits,
+                                uint32   N_f_bits,
+                                uint32   N_codeblocks,
+                                uint32   N_l,
+                                uint32   Q_m,
+                                float  **e_bits,
+                                uint32  *N_e_bits);
 
-/*******************************************************************************
-                              LIBRARY FUNCTIONS
-*******************************************************************************/
+/*********************************************************************
+    Name: code_block_decode
+
+    Description: Rate unmatches and turbo decodes a single code block
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 sections 5.1.3.2 and
+                        5.1.4.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void code_block_decode(LIBLTE_PHY_STRUCT        *phy_struct,
+                       LIBLTE_PHY_CB_JOB_STRUCT *job);
 
 /*********************************************************************
-    Name: liblte_phy_init
+    Name: code_block_decode_all
 
-    Description: Initializes the LTE Physical Layer library.
+    Description: Decodes the first N_codeblocks code block jobs of a
+                 workspace, on the code block threads when they exist
 
     Document Reference: N/A
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_init(LIBLTE_PHY_STRUCT  **phy_struct,
-                                  LIBLTE_PHY_FS_ENUM   fs,
-                                  uint16               N_id_cell,
-                                  uint8                N_ant,
-                                  uint32               N_rb_dl,
-                                  uint32               N_sc_rb_dl,
-                                  float                phich_res)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            j;
+// Defines
+// Enums
+// Structs
+typedef struct{
+    LIBLTE_PHY_CB_POOL_STRUCT *pool;
+    LIBLTE_PHY_STRUCT         *ws;
+    pthread_t                  thread;
+}LIBLTE_PHY_CB_WORKER_STRUCT;
+struct LIBLTE_PHY_CB_POOL_STRUCT{
+    LIBLTE_PHY_CB_WORKER_STRUCT  worker[LIBLTE_PHY_CODE_BLOCK_THREADS_MAX-1];
+    LIBLTE_PHY_CB_JOB_STRUCT    *job;
+    pthread_mutex_t              mutex;
+    pthread_cond_t               start_cond;
+    pthread_cond_t               done_cond;
+    uint32                       N_workers;
+    uint32                       job_id;
+    uint32                       N_jobs;
+    uint32                       next_job;
+    uint32                       N_done;
+    bool                         run;
+};
+// Functions
+void code_block_decode_all(LIBLTE_PHY_STRUCT *phy_struct,
+                           uint32             N_codeblocks);
+void code_block_decode_run(LIBLTE_PHY_CB_POOL_STRUCT *pool,
+                           LIBLTE_PHY_STRUCT         *ws);
+void* code_block_decode_thread(void *inputs);
+void code_block_pool_cleanup(LIBLTE_PHY_STRUCT *phy_struct);
 
-    if(phy_struct != NULL)
-    {
-        *phy_struct = (LIBLTE_PHY_STRUCT *)malloc(sizeof(LIBLTE_PHY_STRUCT));
+/*********************************************************************
+    Name: ulsch_data_control_multiplexing
 
-        // Generic
-        switch(fs)
-        {
-        case LIBLTE_PHY_FS_30_72MHZ:
-            (*phy_struct)->fs                = 30720000;
-            (*phy_struct)->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_30_72MHZ;
-            (*phy_struct)->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_30_72MHZ;
-            (*phy_struct)->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_30_72MHZ;
-            (*phy_struct)->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_30_72MHZ;
-            (*phy_struct)->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_30_72MHZ;
-            (*phy_struct)->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_30_72MHZ;
-            break;
-        case LIBLTE_PHY_FS_15_36MHZ:
-            (*phy_struct)->fs                = 15360000;
-            (*phy_struct)->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_15_36MHZ;
-            (*phy_struct)->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_15_36MHZ;
-            (*phy_struct)->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_15_36MHZ;
-            (*phy_struct)->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_15_36MHZ;
-            (*phy_struct)->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_15_36MHZ;
-            (*phy_struct)->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_15_36MHZ;
-            break;
-        case LIBLTE_PHY_FS_7_68MHZ:
-            (*phy_struct)->fs                = 7680000;
-            (*phy_struct)->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_7_68MHZ;
-            (*phy_struct)->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_7_68MHZ;
-            (*phy_struct)->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_7_68MHZ;
-            (*phy_struct)->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_7_68MHZ;
-            (*phy_struct)->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_7_68MHZ;
-            (*phy_struct)->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_7_68MHZ;
-            break;
-        case LIBLTE_PHY_FS_3_84MHZ:
-            (*phy_struct)->fs                = 3840000;
-            (*phy_struct)->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_3_84MHZ;
-            (*phy_struct)->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_3_84MHZ;
-            (*phy_struct)->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_3_84MHZ;
-            (*phy_struct)->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_3_84MHZ;
-            (*phy_struct)->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_3_84MHZ;
-            (*phy_struct)->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_3_84MHZ;
-            break;
-        case LIBLTE_PHY_FS_1_92MHZ:
-            (*phy_struct)->fs                = 1920000;
-            (*phy_struct)->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_1_92MHZ;
-            (*phy_struct)->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_1_92MHZ;
-            (*phy_struct)->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_1_92MHZ;
-            (*phy_struct)->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_1_92MHZ;
-            (*phy_struct)->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_1_92MHZ;
-            (*phy_struct)->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_1_92MHZ;
-            break;
-        }
-        (*phy_struct)->N_sc_rb_dl = N_sc_rb_dl;
-        (*phy_struct)->N_sc_rb_ul = LIBLTE_PHY_N_SC_RB_UL;
-        liblte_phy_update_n_rb_dl((*phy_struct), N_rb_dl);
-        (*phy_struct)->ul_init = false;
-
-        // PHICH
-        if(LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP == (*phy_struct)->N_sc_rb_dl)
-        {
-            (*phy_struct)->N_group_phich = (uint32)ceilf((float)phich_res*((float)(*phy_struct)->N_rb_dl/(float)8));
-            (*phy_struct)->N_sf_phich    = 4;
-        }else{
-            (*phy_struct)->N_group_phich = 2*(uint32)ceilf((float)phich_res*((float)(*phy_struct)->N_rb_dl/(float)8));
-            (*phy_struct)->N_sf_phich    = 2;
-        }
-
-        // PDCCH Permutation
-        pdcch_permute_pre_calc(*phy_struct,
-                               N_ant,
-                               phich_res);
-
-        // CRS Storage
-        if(LIBLTE_PHY_INIT_N_ID_CELL_UNKNOWN != N_id_cell)
-        {
-            (*phy_struct)->N_id_cell_crs = N_id_cell;
-            for(i=0; i<20; i++)
-            {
-                generate_crs(i, 0, N_id_cell, N_sc_rb_dl, (*phy_struct)->crs_re_storage[i][0], (*phy_struct)->crs_im_storage[i][0]);
-                generate_crs(i, 1, N_id_cell, N_sc_rb_dl, (*phy_struct)->crs_re_storage[i][1], (*phy_struct)->crs_im_storage[i][1]);
-                generate_crs(i, 4, N_id_cell, N_sc_rb_dl, (*phy_struct)->crs_re_storage[i][2], (*phy_struct)->crs_im_storage[i][2]);
-            }
-        }
-
-        // Samples to symbols
-        (*phy_struct)->s2s_in                 = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*(*phy_struct)->N_samps_per_symb*2*20);
-        (*phy_struct)->s2s_out                = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*(*phy_struct)->N_samps_per_symb*2*20);
-        (*phy_struct)->symbs_to_samps_dl_plan = fftwf_plan_dft_1d((*phy_struct)->N_samps_per_symb,
-                                                                  (*phy_struct)->s2s_in,
-                                                                  (*phy_struct)->s2s_out,
-                                                                  FFTW_BACKWARD,
-                                                                  FFTW_MEASURE);
-        (*phy_struct)->samps_to_symbs_dl_plan = fftwf_plan_dft_1d((*phy_struct)->N_samps_per_symb,
-                                                                  (*phy_struct)->s2s_in,
-                                                                  (*phy_struct)->s2s_out,
-                                                                  FFTW_FORWARD,
-                                                                  FFTW_MEASURE);
-        (*phy_struct)->symbs_to_samps_ul_plan = fftwf_plan_dft_1d((*phy_struct)->N_samps_per_symb*2,
-                                                                  (*phy_struct)->s2s_in,
-                                                                  (*phy_struct)->s2s_out,
-                                                                  FFTW_BACKWARD,
-                                                                  FFTW_MEASURE);
-        (*phy_struct)->samps_to_symbs_ul_plan = fftwf_plan_dft_1d((*phy_struct)->N_samps_per_symb*2,
-                                                                  (*phy_struct)->s2s_in,
-                                                                  (*phy_struct)->s2s_out,
-                                                                  FFTW_FORWARD,
-                                                                  FFTW_MEASURE);
-
-        err = LIBLTE_SUCCESS;
-    }
-
-    return(err);
-}
-LIBLTE_ERROR_ENUM liblte_phy_ul_init(LIBLTE_PHY_STRUCT *phy_struct,
-                                     uint16             N_id_cell,
-                                     uint32             prach_root_seq_idx,
-                                     uint32             prach_preamble_format,
-                                     uint32             prach_zczc,
-                                     bool               prach_hs_flag,
-                                     uint8              group_assignment_pusch,
-                                     bool               group_hopping_enabled,
-                                     bool               sequence_hopping_enabled,
-                                     uint8              cyclic_shift,
-                                     uint8              cyclic_shift_dci)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            j;
+    Description: Multiplexes the control and data bits for Uplink
+                 Shared Channel
 
-    if(phy_struct != NULL)
-    {
-        // PUSCH
-        phy_struct->transform_precoding_in  = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL);
-        phy_struct->transform_precoding_out = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL);
-        for(i=0; i<phy_struct->N_rb_ul; i++)
-        {
-            if((i % 2) == 0 ||
-               (i % 3) == 0 ||
-               (i % 5) == 0)
-            {
-                phy_struct->transform_precoding_plan[i]    = fftwf_plan_dft_1d(i*LIBLTE_PHY_N_SC_RB_UL,
-                                                                               phy_struct->transform_precoding_in,
-                                                                               phy_struct->transform_precoding_out,
-                                                                               FFTW_FORWARD,
-                                                                               FFTW_MEASURE);
-                phy_struct->transform_pre_decoding_plan[i] = fftwf_plan_dft_1d(i*LIBLTE_PHY_N_SC_RB_UL,
-                                                                               phy_struct->transform_precoding_in,
-                                                                               phy_struct->transform_precoding_out,
-                                                                               FFTW_BACKWARD,
-                                                                               FFTW_MEASURE);
-            }
-        }
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.7
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void ulsch_data_control_multiplexing(uint8  *f_bits,
+                                     uint32  N_f_bits,
+                                     uint8  *cqi_bits,
+                                     uint32  N_cqi_bits,
+                                     uint32  N_l,
+                                     uint32  Q_m,
+                                     uint8  *g_bits,
+                                     uint32 *N_g_bits);
 
-        // DMRS
-        for(i=0; i<LIBLTE_PHY_N_SUBFR_PER_FRAME; i++)
-        {
-            for(j=0; j<LIBLTE_PHY_N_RB_UL_MAX; j++)
-            {
-                generate_dmrs_pusch(phy_struct,
-                                    i,
-                                    N_id_cell,
-                                    group_assignment_pusch,
-                                    cyclic_shift,
-                                    cyclic_shift_dci,
-                                    j,
-                                    0,
-                                    group_hopping_enabled,
-                                    sequence_hopping_enabled,
-                                    phy_struct->dmrs_0_re[i][j],
-                                    phy_struct->dmrs_0_im[i][j],
-                                    phy_struct->dmrs_1_re[i][j],
-                                    phy_struct->dmrs_1_im[i][j]);
-            }
-        }
+/*********************************************************************
+    Name: ulsch_data_control_demultiplexing
 
-        // PRACH
-        prach_preamble_seq_gen(phy_struct,
-                               prach_root_seq_idx,
-                               prach_preamble_format,
-                               prach_zczc,
-                               prach_hs_flag);
+    Description: Demultiplexes the control and data bits for Uplink
+                 Shared Channel
 
-        switch(prach_preamble_format)
-        {
-        case 0:
-            phy_struct->prach_T_fft      = 24576/(30720000/phy_struct->fs);
-            phy_struct->prach_T_seq      = 24576/(30720000/phy_struct->fs);
-            phy_struct->prach_T_cp       = 3168/(30720000/phy_struct->fs);
-            phy_struct->prach_delta_f_RA = 1250;
-            phy_struct->prach_phi        = 7;
-            break;
-        case 1:
-            phy_struct->prach_T_fft      = 24576/(30720000/phy_struct->fs);
-            phy_struct->prach_T_seq      = 24576/(30720000/phy_struct->fs);
-            phy_struct->prach_T_cp       = 21024/(30720000/phy_struct->fs);
-            phy_struct->prach_delta_f_RA = 1250;
-            phy_struct->prach_phi        = 7;
-            break;
-        case 2:
-            phy_struct->prach_T_fft      = 24576/(30720000/phy_struct->fs);
-            phy_struct->prach_T_seq      = 2*24576/(30720000/phy_struct->fs);
-            phy_struct->prach_T_cp       = 6240/(30720000/phy_struct->fs);
-            phy_struct->prach_delta_f_RA = 1250;
-            phy_struct->prach_phi        = 7;
-            break;
-        case 3:
-            phy_struct->prach_T_fft      = 24576/(30720000/phy_struct->fs);
-            phy_struct->prach_T_seq      = 2*24576/(30720000/phy_struct->fs);
-            phy_struct->prach_T_cp       = 21024/(30720000/phy_struct->fs);
-            phy_struct->prach_delta_f_RA = 1250;
-            phy_struct->prach_phi        = 7;
-            break;
-        case 4:
-        default:
-            phy_struct->prach_T_fft      = 4096/(30720000/phy_struct->fs);
-            phy_struct->prach_T_seq      = 4096/(30720000/phy_struct->fs);
-            phy_struct->prach_T_cp       = 448/(30720000/phy_struct->fs);
-            phy_struct->prach_delta_f_RA = 7500;
-            phy_struct->prach_phi        = 2;
-            break;
-        }
-        phy_struct->prach_dft_in    = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*phy_struct->prach_N_zc);
-        phy_struct->prach_dft_out   = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*phy_struct->prach_N_zc);
-        phy_struct->prach_fft_in    = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*phy_struct->prach_T_fft);
-        phy_struct->prach_fft_out   = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*phy_struct->prach_T_fft);
-        phy_struct->prach_dft_plan  = fftwf_plan_dft_1d(phy_struct->prach_N_zc,
-                                                        phy_struct->prach_dft_in,
-                                                        phy_struct->prach_dft_out,
-                                                        FFTW_FORWARD,
-                                                        FFTW_MEASURE);
-        phy_struct->prach_ifft_plan = fftwf_plan_dft_1d(phy_struct->prach_T_fft,
-                                                        phy_struct->prach_fft_in,
-                                                        phy_struct->prach_fft_out,
-                                                        FFTW_BACKWARD,
-                                                        FFTW_MEASURE);
-        phy_struct->prach_fft_plan  = fftwf_plan_dft_1d(phy_struct->prach_T_fft,
-                                                        phy_struct->prach_fft_in,
-                                                        phy_struct->prach_fft_out,
-                                                        FFTW_FORWARD,
-                                                        FFTW_MEASURE);
-        phy_struct->prach_idft_plan = fftwf_plan_dft_1d(phy_struct->prach_N_zc,
-                                                        phy_struct->prach_dft_in,
-                                                        phy_struct->prach_dft_out,
-                                                        FFTW_BACKWARD,
-                                                        FFTW_MEASURE);
-        for(i=0; i<phy_struct->prach_N_x_u; i++)
-        {
-            for(j=0; j<phy_struct->prach_N_zc; j++)
-            {
-                phy_struct->prach_dft_in[j][0] = phy_struct->prach_x_u_re[i][j];
-                phy_struct->prach_dft_in[j][1] = phy_struct->prach_x_u_im[i][j];
-            }
-            fftwf_execute(phy_struct->prach_dft_plan);
-            for(j=0; j<phy_struct->prach_N_zc; j++)
-            {
-                phy_struct->prach_x_u_fft_re[i][j] = phy_struct->prach_dft_out[j][0];
-                phy_struct->prach_x_u_fft_im[i][j] = phy_struct->prach_dft_out[j][1];
-            }
-        }
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.7
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void ulsch_data_control_demultiplexing(float  *g_bits,
+                                       uint32  N_g_bits,
+                                       uint32  N_cqi_bits,
+                                       uint32  N_l,
+                                       uint32  Q_m,
+                                       float  *f_bits,
+                                       uint32 *N_f_bits,
+                                       float  *cqi_bits);
 
-        // Generic
-        phy_struct->ul_init = true;
+/*********************************************************************
+    Name: ulsch_channel_interleaver
 
-        err = LIBLTE_SUCCESS;
-    }
+    Description: Interleaves Uplink Shared Channel data with RI and
+                 ACK control information
 
-    return(err);
-}
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.8
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void ulsch_channel_interleaver(LIBLTE_PHY_STRUCT *phy_struct,
+                               uint8             *g_bits,
+                               uint32             N_g_bits,
+                               uint8             *ri_bits,
+                               uint32             N_ri_bits,
+                               uint8             *ack_bits,
+                               uint32             N_ack_bits,
+                               uint32             N_l,
+                               uint32             Q_m,
+                               uint8             *h_bits,
+                               uint32            *N_h_bits);
 
 /*********************************************************************
-    Name: liblte_phy_cleanup
+    Name: ulsch_channel_deinterleaver
 
-    Description: Cleans up the LTE Physical Layer library.
+    Description: Deinterleaves Uplink Shared Channel data from RI and
+                 ACK control information
 
-    Document Reference: N/A
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.8
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_cleanup(LIBLTE_PHY_STRUCT *phy_struct)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+// Defines
+// Enums
+// Structs
+// Functions
+void ulsch_channel_deinterleaver(LIBLTE_PHY_STRUCT *phy_struct,
+                                 float             *h_bits,
+                                 uint32             N_h_bits,
+                                 uint32             N_ri_bits,
+                                 uint32             N_ack_bits,
+                                 uint32             N_l,
+                                 uint32             Q_m,
+                                 float             *g_bits,
+                                 uint32            *N_g_bits,
+                                 float             *ri_bits,
+                                 float             *ack_bits);
 
-    if(phy_struct != NULL)
-    {
-        // Samples to symbols
-        fftwf_destroy_plan(phy_struct->samps_to_symbs_dl_plan);
-        fftwf_destroy_plan(phy_struct->symbs_to_samps_dl_plan);
-        fftwf_destroy_plan(phy_struct->samps_to_symbs_ul_plan);
-        fftwf_destroy_plan(phy_struct->symbs_to_samps_ul_plan);
-        fftwf_free(phy_struct->s2s_in);
-        fftwf_free(phy_struct->s2s_out);
+/*********************************************************************
+    Name: ulsch_channel_encode
 
-        free(phy_struct);
-        err = LIBLTE_SUCCESS;
-    }
+    Description: Channel encodes the Uplink Shared Channel
 
-    return(err);
-}
-LIBLTE_ERROR_ENUM liblte_phy_ul_cleanup(LIBLTE_PHY_STRUCT *phy_struct)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2
 
-    if(phy_struct != NULL &&
-       phy_struct->ul_init)
-    {
-        // PRACH
-        fftwf_destroy_plan(phy_struct->prach_idft_plan);
-        fftwf_destroy_plan(phy_struct->prach_fft_plan);
-        fftwf_destroy_plan(phy_struct->prach_ifft_plan);
-        fftwf_destroy_plan(phy_struct->prach_dft_plan);
-        fftwf_free(phy_struct->prach_dft_in);
-        fftwf_free(phy_struct->prach_dft_out);
-        fftwf_free(phy_struct->prach_fft_in);
-        fftwf_free(phy_struct->prach_fft_out);
+    Notes: Not handling control bits
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void ulsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                          uint8             *in_bits,
+                          uint32             N_in_bits,
+                          uint32             tbs,
+                          uint32             tx_mode,
+                          uint32             G,
+                          uint32             N_l,
+                          uint32             Q_m,
+                          uint32             rv_idx,
+                          uint8             *out_bits,
+                          uint32            *N_out_bits);
 
-        // PUSCH
-        for(i=0; i<phy_struct->N_rb_ul; i++)
-        {
-            if((i % 2) == 0 ||
-               (i % 3) == 0 ||
-               (i % 5) == 0)
-            {
-                fftwf_destroy_plan(phy_struct->transform_precoding_plan[i]);
-                fftwf_destroy_plan(phy_struct->transform_pre_decoding_plan[i]);
-            }
-        }
-        fftwf_free(phy_struct->transform_precoding_in);
-        fftwf_free(phy_struct->transform_precoding_out);
+/*********************************************************************
+    Name: ulsch_channel_decode
 
-        // Generic
-        phy_struct->ul_init = false;
+    Description: Channel decodes the Uplink Shared Channel
 
-        err = LIBLTE_SUCCESS;
-    }
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2
 
-    return(err);
-}
+    Notes: Not handling control bits
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM ulsch_channel_decode(LIBLTE_PHY_STRUCT             *phy_struct,
+                                       float                         *in_bits,
+                                       uint32                         N_in_bits,
+                                       uint32                         tbs,
+                                       uint32                         tx_mode,
+                                       uint32                         N_l,
+                                       uint32                         Q_m,
+                                       uint32                         rv_idx,
+                                       LIBLTE_PHY_HARQ_BUFFER_STRUCT *harq,
+                                       uint8                         *out_bits,
+                                       uint32                        *N_out_bits);
 
 /*********************************************************************
-    Name: liblte_phy_update_n_rb_dl
+    Name: bch_channel_encode
 
-    Description: Updates N_rb_dl and all associated variables.
+    Description: Channel encodes the broadcast channel
 
-    Document Reference: N/A
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.1
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_update_n_rb_dl(LIBLTE_PHY_STRUCT *phy_struct,
-                                            uint32             N_rb_dl)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            used_subcarriers;
+// Defines
+// Enums
+// Structs
+// Functions
+void bch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                        uint8             *in_bits,
+                        uint32             N_in_bits,
+                        uint8              N_ant,
+                        uint8             *out_bits,
+                        uint32            *N_out_bits);
 
-    if(phy_struct != NULL)
-    {
-        used_subcarriers = N_rb_dl*phy_struct->N_sc_rb_dl;
-        switch(phy_struct->N_samps_per_symb)
-        {
-        case LIBLTE_PHY_N_SAMPS_PER_SYMB_30_72MHZ:
-            phy_struct->FFT_size = LIBLTE_PHY_FFT_SIZE_30_72MHZ;
-            err                  = LIBLTE_SUCCESS;
-            break;
-        case LIBLTE_PHY_N_SAMPS_PER_SYMB_15_36MHZ:
-            if(LIBLTE_PHY_N_RB_DL_10MHZ  == N_rb_dl ||
-               LIBLTE_PHY_N_RB_DL_5MHZ   == N_rb_dl ||
-               LIBLTE_PHY_N_RB_DL_3MHZ   == N_rb_dl ||
-               LIBLTE_PHY_N_RB_DL_1_4MHZ == N_rb_dl)
-            {
-                phy_struct->FFT_size = LIBLTE_PHY_FFT_SIZE_15_36MHZ;
-                err                  = LIBLTE_SUCCESS;
-            }
-            break;
-        case LIBLTE_PHY_N_SAMPS_PER_SYMB_7_68MHZ:
-            if(LIBLTE_PHY_N_RB_DL_5MHZ   == N_rb_dl ||
-               LIBLTE_PHY_N_RB_DL_3MHZ   == N_rb_dl ||
-               LIBLTE_PHY_N_RB_DL_1_4MHZ == N_rb_dl)
-            {
-                phy_struct->FFT_size = LIBLTE_PHY_FFT_SIZE_7_68MHZ;
-                err                  = LIBLTE_SUCCESS;
-            }
-            break;
-        case LIBLTE_PHY_N_SAMPS_PER_SYMB_3_84MHZ:
-            if(LIBLTE_PHY_N_RB_DL_3MHZ   == N_rb_dl ||
-               LIBLTE_PHY_N_RB_DL_1_4MHZ == N_rb_dl)
-            {
-                phy_struct->FFT_size = LIBLTE_PHY_FFT_SIZE_3_84MHZ;
-                err                  = LIBLTE_SUCCESS;
-            }
-            break;
-        case LIBLTE_PHY_N_SAMPS_PER_SYMB_1_92MHZ:
-            if(LIBLTE_PHY_N_RB_DL_1_4MHZ == N_rb_dl)
-            {
-                phy_struct->FFT_size = LIBLTE_PHY_FFT_SIZE_1_92MHZ;
-                err                  = LIBLTE_SUCCESS;
-            }
-            break;
-        }
+/*********************************************************************
+    Name: bch_channel_decode
 
-        if(LIBLTE_SUCCESS == err)
-        {
-            phy_struct->N_rb_dl      = N_rb_dl;
-            phy_struct->N_rb_ul      = N_rb_dl;
-            phy_struct->FFT_pad_size = (phy_struct->FFT_size - used_subcarriers)/2;
-        }
-    }
+    Description: Channel decodes the broadcast channel
 
-    return(err);
-}
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM bch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                                     float             *in_bits,
+                                     uint32             N_in_bits,
+                                     uint8             *N_ant,
+                                     uint8             *out_bits,
+                                     uint32            *N_out_bits);
 
 /*********************************************************************
-    Name: liblte_phy_pusch_channel_encode
-
-    Description: Encodes and modulates the Physical Uplink Shared
-                 Channel
+    Name: dlsch_channel_encode
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3
+    Description: Channel encodes the Downlink Shared Channel
 
-    Notes: Only handling normal CP and N_ant=1
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.2
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_encode(LIBLTE_PHY_STRUCT            *phy_struct,
-                                                  LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
-                                                  uint32                        N_id_cell,
-                                                  uint8                         N_ant,
-                                                  LIBLTE_PHY_SUBFRAME_STRUCT   *subframe)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            j;
-    uint32            p;
-    uint32            L;
-    uint32            idx;
-    uint32            c_init;
-    uint32            N_bits;
-    uint32            M_symb;
-    uint32            M_layer_symb;
-    uint32            M_ap_symb;
-    uint32            M_pusch_sc = alloc->N_prb*phy_struct->N_sc_rb_ul;
-    uint32            Q_m;
-    uint32            N_ul_symb = 7; // FIXME: Only handling normal CP
+// Defines
+// Enums
+// Structs
+// Functions
+void dlsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                          uint8             *in_bits,
+                          uint32             N_in_bits,
+                          uint32             tbs,
+                          uint32             tx_mode,
+                          uint32             rv_idx,
+                          uint32             G,
+                          uint32             N_l,
+                          uint32             Q_m,
+                          uint32             M_dl_harq,
+                          uint32             N_soft,
+                          uint8             *out_bits,
+                          uint32            *N_out_bits);
 
-    if(phy_struct != NULL &&
-       alloc      != NULL &&
-       subframe   != NULL)
-    {
-        // Determine Q_m
-        if(LIBLTE_PHY_MODULATION_TYPE_BPSK == alloc->mod_type)
-        {
-            Q_m = 1;
-        }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == alloc->mod_type){
-            Q_m = 2;
-        }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == alloc->mod_type){
-            Q_m = 4;
-        }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == alloc->mod_type
-            Q_m = 6;
-        }
+/*********************************************************************
+    Name: dlsch_channel_decode
 
-        // Encode the PUSCH
-        ulsch_channel_encode(phy_struct,
-                             alloc->msg.msg,
-                             alloc->msg.N_bits,
-                             alloc->tbs,
-                             alloc->tx_mode,
-                             alloc->N_prb*phy_struct->N_sc_rb_ul*(N_ul_symb-1)*2,
-                             alloc->N_layers,
-                             Q_m,
-                             alloc->rv_idx,
-                             phy_struct->pusch_encode_bits,
-                             &N_bits);
-        // FIXME: Only handling 1 codeword
-        c_init = (alloc->rnti << 14) | (0 << 13) | (subframe->num << 9) | N_id_cell;
-        generate_prs_c(c_init, N_bits, phy_struct->pusch_c);
-        for(i=0; i<N_bits; i++)
-        {
-            phy_struct->pusch_scramb_bits[i] = phy_struct->pusch_encode_bits[i] ^ phy_struct->pusch_c[i];
-        }
-        modulation_mapper(phy_struct->pusch_scramb_bits,
-                          N_bits,
-                          alloc->mod_type,
-                          phy_struct->pusch_d_re,
-                          phy_struct->pusch_d_im,
-                          &M_symb);
-        layer_mapper_ul(phy_struct->pusch_d_re,
-                        phy_struct->pusch_d_im,
-                        M_symb,
-                        N_ant,
-                        alloc->N_codewords,
-                        phy_struct->pusch_x_re,
-                        phy_struct->pusch_x_im,
-                        &M_layer_symb);
-        transform_precoding(phy_struct,
-                            phy_struct->pusch_x_re,
-                            phy_struct->pusch_x_im,
-                            M_layer_symb,
-                            alloc->N_prb,
-                            N_ant,
-                            alloc->N_codewords,
-                            phy_struct->pusch_y_re,
-                            phy_struct->pusch_y_im);
-        pre_coder_ul(phy_struct->pusch_y_re,
-                     phy_struct->pusch_y_im,
-                     M_layer_symb,
-                     N_ant,
-                     alloc->N_layers,
-                     phy_struct->pusch_z_re[0],
-                     phy_struct->pusch_z_im[0],
-                     &M_ap_symb);
+    Description: Channel decodes the Downlink Shared Channel
 
-        // Map to physical resources
-        for(p=0; p<N_ant; p++)
-        {
-            idx = 0;
-            for(L=0; L<14; L++)
-            {
-                if(3 == L)
-                {
-                    // DMRS 0
-                    for(j=0; j<M_pusch_sc; j++)
-                    {
-                        subframe->tx_symb_re[p][L][j] = phy_struct->dmrs_0_re[subframe->num][alloc->N_prb][j];
-                        subframe->tx_symb_im[p][L][j] = phy_struct->dmrs_0_im[subframe->num][alloc->N_prb][j];
-                    }
-                }else if(10 == L){
-                    // DMRS 1
-                    for(j=0; j<M_pusch_sc; j++)
-                    {
-                        subframe->tx_symb_re[p][L][j] = phy_struct->dmrs_1_re[subframe->num][alloc->N_prb][j];
-                        subframe->tx_symb_im[p][L][j] = phy_struct->dmrs_1_im[subframe->num][alloc->N_prb][j];
-                    }
-                }else{
-                    // PUSCH
-                    for(j=0; j<M_pusch_sc; j++)
-                    {
-                        subframe->tx_symb_re[p][L][j] = phy_struct->pusch_z_re[p][idx];
-                        subframe->tx_symb_im[p][L][j] = phy_struct->pusch_z_im[p][idx];
-                        idx++;
-                    }
-                }
-            }
-        }
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.2
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM dlsch_channel_decode(LIBLTE_PHY_STRUCT             *phy_struct,
+                                       float                         *in_bits,
+                                       uint32                         N_in_bits,
+                                       uint32                         tbs,
+                                       uint32                         tx_mode,
+                                       uint32                         rv_idx,
+                                       uint32                         N_l,
+                                       uint32                         Q_m,
+                                       uint32                         M_dl_harq,
+                                       uint32                         N_soft,
+                                       LIBLTE_PHY_HARQ_BUFFER_STRUCT *harq,
+                                       uint8                         *out_bits,
+                                       uint32                        *N_out_bits);
 
-        err = LIBLTE_SUCCESS;
-    }
+/*********************************************************************
+    Name: dci_channel_encode
 
-    return(err);
-}
+    Description: Channel encodes the Downlink Control Information
+                 channel
 
-/*********************************************************************
-    Name: liblte_phy_pusch_channel_decode
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void dci_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                        uint8             *in_bits,
+                        uint32             N_in_bits,
+                        uint16             rnti,
+                        uint8              ue_ant,
+                        uint32             N_out_bits,
+                        uint8             *out_bits);
 
-    Description: Demodulates and decodes the Physical Uplink Shared
-                 Channel
+/*********************************************************************
+    Name: dci_channel_decode
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3
+    Description: Channel decodes the Downlink Control Information
+                 channel
 
-    Notes: Only handles normal CP
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_decode(LIBLTE_PHY_STRUCT            *phy_struct,
-                                                  LIBLTE_PHY_SUBFRAME_STRUCT   *subframe,
-                                                  LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
-                                                  uint32                        N_id_cell,
-                                                  uint8                         N_ant,
-                                                  uint8                        *out_bits,
-                                                  uint32                       *N_out_bits)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            j;
-    uint32            L;
-    uint32            prb_idx;
-    uint32            z_idx;
-    uint32            c_idx_0;
-    uint32            c_idx_1;
-    uint32            M_layer_symb;
-    uint32            M_symb;
-    uint32            N_bits;
-    uint32            c_init;
-    uint32            Q_m;
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM dci_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                                     float             *in_bits,
+                                     uint32             N_in_bits,
+                                     uint16             rnti_start,
+                                     uint16             rnti_range,
+                                     uint8              ue_ant,
+                                     uint8             *out_bits,
+                                     uint32             N_out_bits,
+                                     uint16            *rnti_found);
 
-    if(phy_struct != NULL &&
-       subframe   != NULL &&
-       alloc      != NULL &&
-       out_bits   != NULL &&
-       N_out_bits != NULL &&
-       phy_struct->ul_init)
-    {
-        // FIXME: Timing
+/*********************************************************************
+    Name: dci_0_pack
 
-        // Extract resource elements and construct channel estimate
-        z_idx   = 0;
-        c_idx_0 = 0;
-        c_idx_1 = 0;
-        for(L=0; L<14; L++)
-        {
-            for(prb_idx=0; prb_idx<alloc->N_prb; prb_idx++)
-            {
-                i = alloc->prb[L/7][prb_idx];
-                for(j=0; j<phy_struct->N_sc_rb_ul; j++)
-                {
-                    if(3 == L)
-                    {
-                        phy_struct->pusch_c_est_0_re[c_idx_0] = subframe->rx_symb_re[L][i*phy_struct->N_sc_rb_ul+j];
-                        phy_struct->pusch_c_est_0_im[c_idx_0] = subframe->rx_symb_im[L][i*phy_struct->N_sc_rb_ul+j];
-                        c_idx_0++;
-                    }else if(10 == L){
-                        phy_struct->pusch_c_est_1_re[c_idx_1] = subframe->rx_symb_re[L][i*phy_struct->N_sc_rb_ul+j];
-                        phy_struct->pusch_c_est_1_im[c_idx_1] = subframe->rx_symb_im[L][i*phy_struct->N_sc_rb_ul+j];
-                        c_idx_1++;
-                    }else{
-                        phy_struct->pusch_z_est_re[z_idx] = subframe->rx_symb_re[L][i*phy_struct->N_sc_rb_ul+j];
-                        phy_struct->pusch_z_est_im[z_idx] = subframe->rx_symb_im[L][i*phy_struct->N_sc_rb_ul+j];
-                        z_idx++;
-                    }
-                }
-            }
-        }
-        get_ul_ce(phy_struct,
-                  phy_struct->pusch_c_est_0_re,
-                  phy_struct->pusch_c_est_0_im,
-                  phy_struct->pusch_c_est_1_re,
-                  phy_struct->pusch_c_est_1_im,
-                  alloc->N_prb,
-                  subframe->num,
-                  phy_struct->pusch_c_est_re,
-                  phy_struct->pusch_c_est_im);
-        pre_decoder_and_matched_filter_ul(phy_struct->pusch_z_est_re,
-                                          phy_struct->pusch_z_est_im,
-                                          phy_struct->pusch_c_est_re,
-                                          phy_struct->pusch_c_est_im,
-                                          z_idx,
-                                          N_ant,
-                                          alloc->N_layers,
-                                          phy_struct->pusch_y_re,
-                                          phy_struct->pusch_y_im,
-                                          &M_layer_symb);
-        transform_pre_decoding(phy_struct,
-                               phy_struct->pusch_y_re,
-                               phy_struct->pusch_y_im,
-                               M_layer_symb,
-                               alloc->N_prb,
-                               N_ant,
-                               alloc->N_codewords,
-                               phy_struct->pusch_x_re,
-                               phy_struct->pusch_x_im);
-        layer_demapper_ul(phy_struct->pusch_x_re,
-                          phy_struct->pusch_x_im,
-                          M_layer_symb,
-                          N_ant,
-                          alloc->N_codewords,
-                          phy_struct->pusch_d_re,
-                          phy_struct->pusch_d_im,
-                          &M_symb);
-        modulation_demapper(phy_struct->pusch_d_re,
-                            phy_struct->pusch_d_im,
-                            M_symb,
-                            alloc->mod_type,
-                            phy_struct->pusch_soft_bits,
-                            &N_bits);
-        // FIXME: Only handling 1 codewords
-        c_init = (alloc->rnti << 14) | (0 << 13) | (subframe->num << 9) | N_id_cell;
-        generate_prs_c(c_init, N_bits, phy_struct->pusch_c);
-        for(i=0; i<N_bits; i++)
-        {
-            phy_struct->pusch_descramb_bits[i] = (float)phy_struct->pusch_soft_bits[i]*(1-2*(float)phy_struct->pusch_c[i]);
-        }
-        if(LIBLTE_PHY_MODULATION_TYPE_BPSK == alloc->mod_type)
-        {
-            Q_m = 1;
-        }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == alloc->mod_type){
-            Q_m = 2;
-        }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == alloc->mod_type){
-            Q_m = 4;
-        }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == alloc->mod_type
-            Q_m = 6;
-        }
-        if(LIBLTE_SUCCESS == ulsch_channel_decode(phy_struct,
-                                                  phy_struct->pusch_descramb_bits,
-                                                  N_bits,
-                                                  alloc->tbs,
-                                                  alloc->tx_mode,
-                                                  alloc->N_layers,
-                                                  Q_m,
-                                                  alloc->rv_idx,
-                                                  out_bits,
-                                                  N_out_bits))
-        {
-            err = LIBLTE_SUCCESS;
-        }
-    }
+    Description: Packs all of the fields into the Downlink Control
+                 Information format 0
 
-    return(err);
-}
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.1
+                        3GPP TS 36.213 v10.3.0 section 8.1.1
+                        3GPP TS 36.213 v10.3.0 section 8.6
+
+    Notes: Currently only handles non-hopping single-cluster
+           assignments
+*********************************************************************/
+// Defines
+#define DCI_0_1A_FLAG_0          0
+#define DCI_0_1A_FLAG_1A         1
+#define DCI_VRB_TYPE_LOCALIZED   0
+#define DCI_VRB_TYPE_DISTRIBUTED 1
+// Enums
+// Structs
+// Functions
+void dci_0_pack(LIBLTE_PHY_ALLOCATION_STRUCT    *alloc,
+                LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
+                uint32                           N_rb_ul,
+                uint8                            N_ant,
+                uint8                           *out_bits,
+                uint32                          *N_out_bits);
 
 /*********************************************************************
-    Name: liblte_phy_generate_prach
+    Name: dci_0_unpack
 
-    Description: Generates the baseband signal for a PRACH
+    Description: Unpacks all of the fields from the Downlink Control
+                 Information format 0
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.3
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.1
+                        3GPP TS 36.213 v10.3.0 section 8.1.1
+                        3GPP TS 36.213 v10.3.0 section 8.6
+
+    Notes: N/A
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_generate_prach(LIBLTE_PHY_STRUCT *phy_struct,
-                                            uint32             preamble_idx,
-                                            uint32             freq_offset,
-                                            float             *samps_re,
-                                            float             *samps_im)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            idx;
-    uint32            N_ra_prb;
-    uint32            k_0;
-    uint32            K;
-    uint32            start;
+// Defines
+// Enums
+// Structs
+// Functions
+// FIXME
 
-    if(phy_struct != NULL &&
-       samps_re   != NULL &&
-       samps_im   != NULL &&
-       phy_struct->ul_init)
-    {
-        // Calculate PRACH parameters
-        N_ra_prb = freq_offset;
-        k_0      = N_ra_prb*phy_struct->N_sc_rb_ul - phy_struct->N_rb_ul*phy_struct->N_sc_rb_ul/2 + (phy_struct->FFT_size/2);
-        K        = 15000/phy_struct->prach_delta_f_RA;
+/*********************************************************************
+    Name: dci_1a_pack
 
-        for(i=0; i<phy_struct->prach_N_zc; i++)
-        {
-            phy_struct->prach_dft_in[i][0] = phy_struct->prach_x_u_v_re[preamble_idx][i];
-            phy_struct->prach_dft_in[i][1] = phy_struct->prach_x_u_v_im[preamble_idx][i];
-        }
-        fftwf_execute(phy_struct->prach_dft_plan);
-        for(i=0; i<phy_struct->prach_T_fft; i++)
-        {
-            phy_struct->prach_fft_in[i][0] = 0;
-            phy_struct->prach_fft_in[i][1] = 0;
-        }
-        start = phy_struct->prach_phi + (K*k_0) + (K/2);
-        for(i=0; i<phy_struct->prach_N_zc; i++)
-        {
-            idx                              = (i+start+phy_struct->prach_T_fft/2)%phy_struct->prach_T_fft;
-            phy_struct->prach_fft_in[idx][0] = phy_struct->prach_dft_out[(i+phy_struct->prach_N_zc/2)%phy_struct->prach_N_zc][0];
-            phy_struct->prach_fft_in[idx][1] = phy_struct->prach_dft_out[(i+phy_struct->prach_N_zc/2)%phy_struct->prach_N_zc][1];
-        }
-        fftwf_execute(phy_struct->prach_ifft_plan);
-        if(phy_struct->prach_T_fft == phy_struct->prach_T_seq)
-        {
-            for(i=0; i<phy_struct->prach_T_fft; i++)
-            {
-                samps_re[phy_struct->prach_T_cp+i] = phy_struct->prach_fft_out[i][0];
-                samps_im[phy_struct->prach_T_cp+i] = phy_struct->prach_fft_out[i][1];
-            }
-        }else{
-            for(i=0; i<phy_struct->prach_T_fft; i++)
-            {
-                samps_re[phy_struct->prach_T_cp+i]                         = phy_struct->prach_fft_out[i][0];
-                samps_im[phy_struct->prach_T_cp+i]                         = phy_struct->prach_fft_out[i][1];
-                samps_re[phy_struct->prach_T_cp+phy_struct->prach_T_fft+i] = phy_struct->prach_fft_out[i][0];
-                samps_im[phy_struct->prach_T_cp+phy_struct->prach_T_fft+i] = phy_struct->prach_fft_out[i][1];
-            }
-        }
-        for(i=0; i<phy_struct->prach_T_cp; i++)
-        {
-            samps_re[i] = samps_re[phy_struct->prach_T_seq+i];
-            samps_im[i] = samps_im[phy_struct->prach_T_seq+i];
-        }
+    Description: Packs all of the fields into the Downlink Control
+                 Information format 1A
 
-        err = LIBLTE_SUCCESS;
-    }
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.3
+                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
+                        3GPP TS 36.213 v10.3.0 section 7.1.7
 
-    return(err);
-}
+    Notes: Currently only handles localized virtual resource blocks
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void dci_1a_pack(LIBLTE_PHY_ALLOCATION_STRUCT    *alloc,
+                 LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
+                 uint32                           N_rb_dl,
+                 uint8                            N_ant,
+                 uint8                           *out_bits,
+                 uint32                          *N_out_bits);
 
 /*********************************************************************
-    Name: liblte_phy_detect_prach
+    Name: dci_1a_unpack
 
-    Description: Detects PRACHs from baseband I/Q
+    Description: Unpacks all of the fields from the Downlink Control
+                 Information format 1A
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.2 and 5.7.3
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.3
+                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
+                        3GPP TS 36.213 v10.3.0 section 7.1.7
 
-    Notes: Currently only supports detection of one preamble
+    Notes: Currently only handles SI-RNTI, P-RNTI, or RA-RNTI and
+           localized virtual resource blocks
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_detect_prach(LIBLTE_PHY_STRUCT *phy_struct,
-                                          float             *samps_re,
-                                          float             *samps_im,
-                                          uint32             freq_offset,
-                                          uint32            *N_det_pre,
-                                          uint32            *det_pre,
-                                          uint32            *det_ta)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    float             max_val;
-    float             abs_corr;
-    float             ave_val;
-    int32             N_neg_RA_shift;
-    uint32            i;
-    uint32            j;
-    uint32            u;
-    uint32            N_cs;
-    uint32            p;
-    uint32            v_max;
-    uint32            d_u;
-    uint32            d_start;
-    uint32            N_RA_shift;
-    uint32            N_RA_group;
-    uint32            N_ra_prb;
-    uint32            k_0;
-    uint32            K;
-    uint32            start;
-    uint32            idx;
-    uint32            max_root;
-    uint32            max_offset;
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM dci_1a_unpack(uint8                           *in_bits,
+                                uint32                           N_in_bits,
+                                LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
+                                uint16                           rnti,
+                                uint32                           N_rb_dl,
+                                uint8                            N_ant,
+                                LIBLTE_PHY_ALLOCATION_STRUCT    *alloc);
 
-    if(phy_struct != NULL &&
-       samps_re   != NULL &&
-       samps_im   != NULL &&
-       N_det_pre  != NULL &&
-       det_pre    != NULL &&
-       det_ta     != NULL &&
-       phy_struct->ul_init)
-    {
-        // Determine u
-        if(4 == phy_struct->prach_preamble_format)
-        {
-            u = PRACH_5_7_2_5[phy_struct->prach_root_seq_idx];
-        }else{
-            u = PRACH_5_7_2_4[phy_struct->prach_root_seq_idx];
-        }
+/*********************************************************************
+    Name: dci_1c_pack
 
-        // Determine N_cs
-        if(4 == phy_struct->prach_preamble_format)
-        {
-            N_cs = PRACH_5_7_2_3[phy_struct->prach_zczc];
-        }else{
-            if(phy_struct->prach_hs_flag)
-            {
-                N_cs = PRACH_5_7_2_2_RS[phy_struct->prach_zczc];
-            }else{
-                N_cs = PRACH_5_7_2_2_URS[phy_struct->prach_zczc];
-            }
-        }
+    Description: Packs all of the fields into the Downlink Control
+                 Information format 1C
 
-        // Determine v_max
-        if(phy_struct->prach_hs_flag)
-        {
-            // Determine d_u
-            for(p=1; p<=phy_struct->prach_N_zc; p++)
-            {
-                if(((p*u) % phy_struct->prach_N_zc) == 1)
-                {
-                    break;
-                }
-            }
-            if(p >= 0 && p < phy_struct->prach_N_zc/2)
-            {
-                d_u = p;
-            }else{
-                d_u = phy_struct->prach_N_zc - p;
-            }
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.4
+                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
+                        3GPP TS 36.213 v10.3.0 section 7.1.7
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+// FIXME
 
-            // Determine N_RA_shift, d_start, N_RA_group, and N_neg_RA_shift
-            if(d_u >= N_cs && d_u < phy_struct->prach_N_zc/3)
-            {
-                N_RA_shift     = d_u/N_cs;
-                d_start        = 2*d_u + N_RA_shift*N_cs;
-                N_RA_group     = phy_struct->prach_N_zc/d_start;
-                N_neg_RA_shift = (phy_struct->prach_N_zc - 2*d_u - N_RA_group*d_start)/N_cs;
-                if(N_neg_RA_shift < 0)
-                {
-                    N_neg_RA_shift = 0;
-                }
-            }else{
-                N_RA_shift     = (phy_struct->prach_N_zc - 2*d_u)/N_cs;
-                d_start        = phy_struct->prach_N_zc - 2*d_u + N_RA_shift*N_cs;
-                N_RA_group     = d_u/d_start;
-                N_neg_RA_shift = (d_u - N_RA_group*d_start)/N_cs;
-                if(N_neg_RA_shift < 0)
-                {
-                    N_neg_RA_shift = 0;
-                }
-                if(N_neg_RA_shift > N_RA_shift)
-                {
-                    N_neg_RA_shift = N_RA_shift;
-                }
-            }
-
-            // Restricted set
-            v_max = N_RA_shift*N_RA_group + N_neg_RA_shift - 1;
-        }else{
-            // Unrestricted set
-            if(0 == N_cs)
-            {
-                v_max = 0;
-            }else{
-                v_max = (phy_struct->prach_N_zc/N_cs)-1;
-            }
-        }
+/*********************************************************************
+    Name: dci_1c_unpack
 
-        // Calculate PRACH parameters
-        N_ra_prb = freq_offset;
-        k_0      = N_ra_prb*phy_struct->N_sc_rb_ul - phy_struct->N_rb_ul*phy_struct->N_sc_rb_ul/2 + (phy_struct->FFT_size/2);
-        K        = 15000/phy_struct->prach_delta_f_RA;
+    Description: Unpacks all of the fields from the Downlink Control
+                 Information format 1C
 
-        for(i=0; i<phy_struct->prach_T_fft; i++)
-        {
-            phy_struct->prach_fft_in[i][0] = samps_re[phy_struct->prach_T_cp+i];
-            phy_struct->prach_fft_in[i][1] = samps_im[phy_struct->prach_T_cp+i];
-        }
-        fftwf_execute(phy_struct->prach_fft_plan);
-        start = phy_struct->prach_phi + (K*k_0) + (K/2);
-        for(i=0; i<phy_struct->prach_N_zc; i++)
-        {
-            idx                           = (i+start+phy_struct->prach_T_fft/2)%phy_struct->prach_T_fft;
-            phy_struct->prach_x_hat_re[i] = phy_struct->prach_fft_out[idx][0];
-            phy_struct->prach_x_hat_im[i] = phy_struct->prach_fft_out[idx][1];
-        }
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.4
+                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
+                        3GPP TS 36.213 v10.3.0 section 7.1.7
 
-        // Correlate with all available roots
-        ave_val = 0;
-        max_val = 0;
-        for(i=0; i<phy_struct->prach_N_x_u; i++)
-        {
-            for(j=0; j<phy_struct->prach_N_zc; j++)
-            {
-                phy_struct->prach_dft_in[j][0] = phy_struct->prach_x_u_fft_re[i][j]*phy_struct->prach_x_hat_re[j] + phy_struct->prach_x_u_fft_im[i][j]*phy_struct->prach_x_hat_im[j];
-                phy_struct->prach_dft_in[j][1] = phy_struct->prach_x_u_fft_im[i][j]*phy_struct->prach_x_hat_re[j] - phy_struct->prach_x_u_fft_re[i][j]*phy_struct->prach_x_hat_im[j];
-            }
-            fftwf_execute(phy_struct->prach_idft_plan);
-            for(j=0; j<phy_struct->prach_N_zc; j++)
-            {
-                abs_corr  = phy_struct->prach_dft_out[j][0]*phy_struct->prach_dft_out[j][0] + phy_struct->prach_dft_out[j][1]*phy_struct->prach_dft_out[j][1];
-                ave_val  += abs_corr;
-                if(abs_corr > max_val)
-                {
-                    max_val    = abs_corr;
-                    max_root   = i;
-                    max_offset = j;
-                }
-            }
-            ave_val /= phy_struct->prach_N_zc;
-        }
+    Notes: Currently only handling SI-RNTI, P-RNTI, and RA-RNTI
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void dci_1c_unpack(uint8                        *in_bits,
+                   uint32                        N_in_bits,
+                   uint16                        rnti,
+                   uint32                        N_rb_dl,
+                   uint8                         N_ant,
+                   LIBLTE_PHY_ALLOCATION_STRUCT *alloc);
 
-        if(max_val >= 50*ave_val &&
-           max_val != 0)
-        {
-            *N_det_pre = 1;
-            if(0 == N_cs)
-            {
-                *det_pre = max_root*(v_max+1);
-                *det_ta  = ((max_offset%phy_struct->prach_N_zc)*29.155/16)-1;
-            }else{
-                *det_pre = max_root*(v_max+1) + ((max_offset+N_cs)%phy_struct->prach_N_zc)/N_cs;
-                *det_ta  = (((N_cs - ((max_offset+N_cs)%phy_struct->prach_N_zc))%N_cs)*29.155/16)-1;
-            }
-        }else{
-            *N_det_pre = 0;
-        }
+/*********************************************************************
+    Name: cfi_channel_encode
 
-        err = LIBLTE_SUCCESS;
-    }
+    Description: Channel encodes the Control Format Indicator channel
 
-    return(err);
-}
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.4
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void cfi_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                        uint32             cfi,
+                        uint8             *out_bits,
+                        uint32            *N_out_bits);
 
 /*********************************************************************
-    Name: liblte_phy_pdsch_channel_encode
+    Name: cfi_channel_decode
 
-    Description: Encodes and modulates the Physical Downlink Shared
-                 Channel
+    Description: Channel decodes the Control Format Indicator channel
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3 and 6.4
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.4
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *phy_struct,
-                                                  LIBLTE_PHY_PDCCH_STRUCT    *pdcch,
-                                                  uint32                      N_id_cell,
-                                                  uint8                       N_ant,
-                                                  LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            j;
-    uint32            p;
-    uint32            L;
-    uint32            idx;
-    uint32            alloc_idx;
-    uint32            prb_idx;
-    uint32            c_init;
-    uint32            N_bits_tot;
-    uint32            N_bits;
-    uint32            M_symb;
-    uint32            M_layer_symb;
-    uint32            M_ap_symb;
-    uint32            first_sc;
-    uint32            last_sc;
-    uint32            Q_m;
-
-    if(phy_struct != NULL &&
-       pdcch      != NULL &&
-       N_id_cell  >= 0    &&
-       N_id_cell  <= 503  &&
-       subframe   != NULL)
-    {
-        // Determine first and last PBCH, PSS, and SSS subcarriers
-        if(phy_struct->N_rb_dl == 6)
-        {
-            first_sc = 0;
-            last_sc  = (6*phy_struct->N_sc_rb_dl)-1;
-        }else if(phy_struct->N_rb_dl == 15){
-            first_sc = (4*phy_struct->N_sc_rb_dl)+6;
-            last_sc  = (11*phy_struct->N_sc_rb_dl)-7;
-        }else if(phy_struct->N_rb_dl == 25){
-            first_sc = (9*phy_struct->N_sc_rb_dl)+6;
-            last_sc  = (16*phy_struct->N_sc_rb_dl)-7;
-        }else if(phy_struct->N_rb_dl == 50){
-            first_sc = 22*phy_struct->N_sc_rb_dl;
-            last_sc  = (28*phy_struct->N_sc_rb_dl)-1;
-        }else if(phy_struct->N_rb_dl == 75){
-            first_sc = (34*phy_struct->N_sc_rb_dl)+6;
-            last_sc  = (41*phy_struct->N_sc_rb_dl)-7;
-        }else{ // phy_struct->N_rb_dl == 100
-            first_sc = 47*phy_struct->N_sc_rb_dl;
-            last_sc  = (53*phy_struct->N_sc_rb_dl)-1;
-        }
+// Defines
+#define CFI_N_ACCEPTABLE_BERS 4
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM cfi_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                                     float             *in_bits,
+                                     uint32             N_in_bits,
+                                     uint32            *cfi);
 
-        for(alloc_idx=0; alloc_idx<pdcch->N_alloc; alloc_idx++)
-        {
-            if(pdcch->alloc[alloc_idx].chan_type == LIBLTE_PHY_CHAN_TYPE_DLSCH)
-            {
-                // Determine the number of bits available for transmission
-                N_bits_tot = 0;
-                for(i=0; i<pdcch->alloc[alloc_idx].N_prb; i++)
-                {
-                    N_bits_tot += get_num_bits_in_prb(subframe->num,
-                                                      pdcch->N_symbs,
-                                                      pdcch->alloc[alloc_idx].prb[0][i],
-                                                      phy_struct->N_rb_dl,
-                                                      N_ant,
-                                                      pdcch->alloc[alloc_idx].mod_type);
-                }
-                // Determine Q_m
-                if(LIBLTE_PHY_MODULATION_TYPE_BPSK == pdcch->alloc[alloc_idx].mod_type)
-                {
-                    Q_m = 1;
-                }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == pdcch->alloc[alloc_idx].mod_type){
-                    Q_m = 2;
-                }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == pdcch->alloc[alloc_idx].mod_type){
-                    Q_m = 4;
-                }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == pdcch->alloc[alloc_idx].mod_type
-                    Q_m = 6;
-                }
-                // Encode the PDSCH
-                dlsch_channel_encode(phy_struct,
-                                     pdcch->alloc[alloc_idx].msg.msg,
-                                     pdcch->alloc[alloc_idx].msg.N_bits,
-                                     pdcch->alloc[alloc_idx].tbs,
-                                     pdcch->alloc[alloc_idx].tx_mode,
-                                     pdcch->alloc[alloc_idx].rv_idx,
-                                     N_bits_tot,
-                                     2,
-                                     Q_m,
-                                     8,
-                                     250368,
-                                     phy_struct->pdsch_encode_bits,
-                                     &N_bits);
-                // FIXME: Only handling 1 codeword
-                c_init = (pdcch->alloc[alloc_idx].rnti << 14) | (0 << 13) | (subframe->num << 9) | N_id_cell;
-                generate_prs_c(c_init, N_bits, phy_struct->pdsch_c);
-                for(i=0; i<N_bits; i++)
-                {
-                    phy_struct->pdsch_scramb_bits[i] = phy_struct->pdsch_encode_bits[i] ^ phy_struct->pdsch_c[i];
-                }
-                modulation_mapper(phy_struct->pdsch_scramb_bits,
-                                  N_bits,
-                                  pdcch->alloc[alloc_idx].mod_type,
-                                  phy_struct->pdsch_d_re,
-                                  phy_struct->pdsch_d_im,
-                                  &M_symb);
-                layer_mapper_dl(phy_struct->pdsch_d_re,
-                                phy_struct->pdsch_d_im,
-                                M_symb,
-                                N_ant,
-                                1,
-                                pdcch->alloc[alloc_idx].pre_coder_type,
-                                phy_struct->pdsch_x_re,
-                                phy_struct->pdsch_x_im,
-                                &M_layer_symb);
-                pre_coder_dl(phy_struct->pdsch_x_re,
-                             phy_struct->pdsch_x_im,
-                             M_layer_symb,
-                             N_ant,
-                             pdcch->alloc[alloc_idx].pre_coder_type,
-                             phy_struct->pdsch_y_re[0],
-                             phy_struct->pdsch_y_im[0],
-                             5000,
-                             &M_ap_symb);
+/*********************************************************************
+    Name: get_ul_ce
 
-                // Map the symbols to resource elements 3GPP TS 36.211 v10.1.0 section 6.3.5
-                for(p=0; p<N_ant; p++)
-                {
-                    idx = 0;
-                    for(L=pdcch->N_symbs; L<14; L++)
-                    {
-                        for(prb_idx=0; prb_idx<pdcch->alloc[alloc_idx].N_prb; prb_idx++)
-                        {
-                            i = pdcch->alloc[alloc_idx].prb[L/7][prb_idx];
-                            for(j=0; j<phy_struct->N_sc_rb_dl; j++)
-                            {
-                                if(N_ant           == 1 &&
-                                   (L % 7)         == 0 &&
-                                   (N_id_cell % 6) == (j % 6))
-                                {
-                                    // Skip CRS
-                                }else if(N_ant               == 1 &&
-                                         (L % 7)             == 4 &&
-                                         ((N_id_cell+3) % 6) == (j % 6)){
-                                    // Skip CRS
-                                }else if((N_ant          == 2  ||
-                                          N_ant          == 4) &&
-                                         ((L % 7)        == 0  ||
-                                          (L % 7)        == 4) &&
-                                         (N_id_cell % 3) == (j % 3)){
-                                    // Skip CRS
-                                }else if(N_ant           == 4 &&
-                                         (L % 7)         == 1 &&
-                                         (N_id_cell % 3) == (j % 3)){
-                                    // Skip CRS
-                                }else if(subframe->num                == 0        &&
-                                         (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
-                                         (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
-                                         L                            >= 7        &&
-                                         L                            <= 10){
-                                    // Skip PBCH
-                                }else if((subframe->num               == 0        ||
-                                          subframe->num               == 5)       &&
-                                         (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
-                                         (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
-                                         L                            == 6){
-                                    // Skip PSS
-                                }else if((subframe->num               == 0        ||
-                                          subframe->num               == 5)       &&
-                                         (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
-                                         (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
-                                         L                            == 5){
-                                    // Skip SSS
-                                }else{
-                                    subframe->tx_symb_re[p][L][i*phy_struct->N_sc_rb_dl+j] = phy_struct->pdsch_y_re[p][idx];
-                                    subframe->tx_symb_im[p][L][i*phy_struct->N_sc_rb_dl+j] = phy_struct->pdsch_y_im[p][idx];
-                                    idx++;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        err = LIBLTE_SUCCESS;
-    }
+    Description: Resolves channel estimates for the uplink and
+                 estimates the noise variance from the second
+                 difference of neighboring DMRS least squares
+                 estimates, which cancels any channel that is linear
+                 across them
 
-    return(err);
-}
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void get_ul_ce(LIBLTE_PHY_STRUCT *phy_struct,
+               float             *c_est_0_re,
+               float             *c_est_0_im,
+               float             *c_est_1_re,
+               float             *c_est_1_im,
+               uint32             N_prb,
+               uint32             N_subfr,
+               float             *c_est_re,
+               float             *c_est_im,
+               float             *noise_var);
 
 /*********************************************************************
-    Name: liblte_phy_pdsch_channel_decode
-
-    Description: Demodulates and decodes the Physical Downlink Shared
-                 Channel
+    Name: get_num_bits_in_prb
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3 and 6.4
+    Description: Determines the number of bits available in a
+                 particular PRB with a particular modulation type
+
+    Document Reference: N/A
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_decode(LIBLTE_PHY_STRUCT            *phy_struct,
-                                                  LIBLTE_PHY_SUBFRAME_STRUCT   *subframe,
-                                                  LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
-                                                  uint32                        N_pdcch_symbs,
-                                                  uint32                        N_id_cell,
-                                                  uint8                         N_ant,
-                                                  uint8                        *out_bits,
-                                                  uint32                       *N_out_bits)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            j;
-    uint32            p;
-    uint32            L;
-    uint32            prb_idx;
-    uint32            idx;
-    uint32            c_init;
-    uint32            M_layer_symb;
-    uint32            M_symb;
-    uint32            N_bits;
-    uint32            first_sc;
-    uint32            last_sc;
+// Defines
+// Enums
+// Structs
+// Functions
+uint32 get_num_bits_in_prb(uint32                          N_subframe,
+                           uint32                          N_ctrl_symbs,
+                           uint32                          prb,
+                           uint32                          N_rb_dl,
+                           uint8                           N_ant,
+                           LIBLTE_PHY_MODULATION_TYPE_ENUM mod_type);
 
-    if(phy_struct != NULL &&
-       subframe   != NULL &&
-       N_id_cell  >= 0    &&
-       N_id_cell  <= 503  &&
-       out_bits   != NULL &&
-       N_out_bits != NULL)
-    {
-        err = LIBLTE_ERROR_DECODE_FAIL;
+/*********************************************************************
+    Name: wrap_phase
 
-        // Determine first and last PBCH, PSS, and SSS subcarriers
-        if(phy_struct->N_rb_dl == 6)
-        {
-            first_sc = 0;
-            last_sc  = (6*phy_struct->N_sc_rb_dl)-1;
-        }else if(phy_struct->N_rb_dl == 15){
-            first_sc = (4*phy_struct->N_sc_rb_dl)+6;
-            last_sc  = (11*phy_struct->N_sc_rb_dl)-7;
-        }else if(phy_struct->N_rb_dl == 25){
-            first_sc = (9*phy_struct->N_sc_rb_dl)+6;
-            last_sc  = (16*phy_struct->N_sc_rb_dl)-7;
-        }else if(phy_struct->N_rb_dl == 50){
-            first_sc = 22*phy_struct->N_sc_rb_dl;
-            last_sc  = (28*phy_struct->N_sc_rb_dl)-1;
-        }else if(phy_struct->N_rb_dl == 75){
-            first_sc = (34*phy_struct->N_sc_rb_dl)+6;
-            last_sc  = (41*phy_struct->N_sc_rb_dl)-7;
-        }else{ // phy_struct->N_rb_dl == 100
-            first_sc = 47*phy_struct->N_sc_rb_dl;
-            last_sc  = (53*phy_struct->N_sc_rb_dl)-1;
-        }
+    Description: Checks the phase difference between two angles and
+                 wraps one to make the difference less than 2*pi.
 
-        // Extract resource elements and channel estimate 3GPP TS 36.211 v10.1.0 section 6.3.5
-        idx = 0;
-        for(L=N_pdcch_symbs; L<14; L++)
-        {
-            for(prb_idx=0; prb_idx<alloc->N_prb; prb_idx++)
-            {
-                i = alloc->prb[L/7][prb_idx];
-                for(j=0; j<phy_struct->N_sc_rb_dl; j++)
-                {
-                    if(N_ant           == 1 &&
-                       (L % 7)         == 0 &&
-                       (N_id_cell % 6) == (j % 6))
-                    {
-                        // Skip CRS
-                    }else if(N_ant               == 1 &&
-                             (L % 7)             == 4 &&
-                             ((N_id_cell+3) % 6) == (j % 6)){
-                        // Skip CRS
-                    }else if((N_ant          == 2  ||
-                              N_ant          == 4) &&
-                             ((L % 7)        == 0  ||
-                              (L % 7)        == 4) &&
-                             (N_id_cell % 3) == (j % 3)){
-                        // Skip CRS
-                    }else if(N_ant           == 4 &&
-                             (L % 7)         == 1 &&
-                             (N_id_cell % 3) == (j % 3)){
-                        // Skip CRS
-                    }else if(subframe->num                == 0        &&
-                             (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
-                             (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
-                             L                            >= 7        &&
-                             L                            <= 10){
-                        // Skip PBCH
-                    }else if((subframe->num               == 0        ||
-                              subframe->num               == 5)       &&
-                             (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
-                             (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
-                             L                            == 6){
-                        // Skip PSS
-                    }else if((subframe->num               == 0        ||
-                              subframe->num               == 5)       &&
-                             (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
-                             (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
-                             L                            == 5){
-                        // Skip SSS
-                    }else{
-                        phy_struct->pdsch_y_est_re[idx] = subframe->rx_symb_re[L][i*phy_struct->N_sc_rb_dl+j];
-                        phy_struct->pdsch_y_est_im[idx] = subframe->rx_symb_im[L][i*phy_struct->N_sc_rb_dl+j];
-                        for(p=0; p<N_ant; p++)
-                        {
-                            phy_struct->pdsch_c_est_re[p][idx] = subframe->rx_ce_re[p][L][i*phy_struct->N_sc_rb_dl+j];
-                            phy_struct->pdsch_c_est_im[p][idx] = subframe->rx_ce_im[p][L][i*phy_struct->N_sc_rb_dl+j];
-                        }
-                        idx++;
-                    }
-                }
-            }
-        }
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void wrap_phase(float *phase_1,
+                float  phase_2);
 
-        pre_decoder_and_matched_filter_dl(phy_struct->pdsch_y_est_re,
-                                          phy_struct->pdsch_y_est_im,
-                                          phy_struct->pdsch_c_est_re[0],
-                                          phy_struct->pdsch_c_est_im[0],
-                                          5000,
-                                          idx,
-                                          N_ant,
-                                          alloc->pre_coder_type,
-                                          phy_struct->pdsch_x_re,
-                                          phy_struct->pdsch_x_im,
-                                          &M_layer_symb);
-        layer_demapper_dl(phy_struct->pdsch_x_re,
-                          phy_struct->pdsch_x_im,
-                          M_layer_symb,
-                          N_ant,
-                          alloc->N_codewords,
-                          alloc->pre_coder_type,
-                          phy_struct->pdsch_d_re,
-                          phy_struct->pdsch_d_im,
-                          &M_symb);
-        modulation_demapper(phy_struct->pdsch_d_re,
-                            phy_struct->pdsch_d_im,
-                            M_symb,
-                            alloc->mod_type,
-                            phy_struct->pdsch_soft_bits,
-                            &N_bits);
-        // FIXME: Only handling 1 codeword
-        c_init = (alloc->rnti << 14) | (0 << 13) | (subframe->num << 9) | N_id_cell;
-        generate_prs_c(c_init, N_bits, phy_struct->pdsch_c);
-        for(i=0; i<N_bits; i++)
-        {
-            phy_struct->pdsch_descramb_bits[i] = (float)phy_struct->pdsch_soft_bits[i]*(1-2*(float)phy_struct->pdsch_c[i]);
-        }
-        if(LIBLTE_SUCCESS == dlsch_channel_decode(phy_struct,
-                                                  phy_struct->pdsch_descramb_bits,
-                                                  N_bits,
-                                                  alloc->tbs,
-                                                  alloc->tx_mode,
-                                                  alloc->rv_idx,
-                                                  8,
-                                                  250368, // FIXME: Using N_soft from a cat 1 UE (3GPP TS 36.306)
-                                                  out_bits,
-                                                  N_out_bits))
-        {
-            err = LIBLTE_SUCCESS;
-        }
-    }
+/*********************************************************************
+    Name: dl_ce_polar
 
-    return(err);
-}
+    Description: Estimates the downlink channel by interpolating the
+                 magnitude and unwrapped phase of the CRS estimates in
+                 frequency and then in time
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.10.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void dl_ce_polar(LIBLTE_PHY_STRUCT          *phy_struct,
+                 uint32                      N_id_cell,
+                 uint8                       N_ant,
+                 LIBLTE_PHY_SUBFRAME_STRUCT *subframe);
 
 /*********************************************************************
-    Name: liblte_phy_bch_channel_encode
+    Name: dl_ce_cartesian
 
-    Description: Encodes and modulates the Physical Broadcast
-                 Channel
+    Description: Estimates the downlink channel from the least squares
+                 CRS estimates, interpolating the complex values with
+                 the linear or Wiener weights in frequency and linearly
+                 in time.  The noise variance of each PRB is estimated
+                 from the second difference of neighboring CRSs, which
+                 cancels any channel that is linear across them.
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.6
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.10.1
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_bch_channel_encode(LIBLTE_PHY_STRUCT          *phy_struct,
-                                                uint8                      *in_bits,
-                                                uint32                      N_in_bits,
-                                                uint32                      N_id_cell,
-                                                uint8                       N_ant,
-                                                LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
-                                                uint32                      sfn)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            k;
-    uint32            p;
-    uint32            offset;
-    uint32            idx;
-    uint32            M_symb;
-    uint32            M_layer_symb;
-    uint32            M_ap_symb;
-
-    if(phy_struct != NULL &&
-       in_bits    != NULL &&
-       N_id_cell  >= 0    &&
-       N_id_cell  <= 503  &&
-       subframe   != NULL)
-    {
-        // Encode the bits to symbols
-        if(0 == phy_struct->bch_N_bits)
-        {
-            bch_channel_encode(phy_struct,
-                               in_bits,
-                               N_in_bits,
-                               N_ant,
-                               phy_struct->bch_encode_bits,
-                               &phy_struct->bch_N_bits);
-            generate_prs_c(N_id_cell, phy_struct->bch_N_bits, phy_struct->bch_c);
-        }
-        for(i=0; i<480; i++)
-        {
-            offset                         = (sfn % 4)*480;
-            phy_struct->bch_scramb_bits[i] = phy_struct->bch_encode_bits[offset+i] ^ phy_struct->bch_c[offset + i];
-        }
-        if(3 == (sfn % 4))
-        {
-            phy_struct->bch_N_bits = 0;
-        }
-        modulation_mapper(phy_struct->bch_scramb_bits,
-                          480,
-                          LIBLTE_PHY_MODULATION_TYPE_QPSK,
-                          phy_struct->bch_d_re,
-                          phy_struct->bch_d_im,
-                          &M_symb);
-        layer_mapper_dl(phy_struct->bch_d_re,
-                        phy_struct->bch_d_im,
-                        M_symb,
-                        N_ant,
-                        1,
-                        LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                        phy_struct->bch_x_re,
-                        phy_struct->bch_x_im,
-                        &M_layer_symb);
-        pre_coder_dl(phy_struct->bch_x_re,
-                     phy_struct->bch_x_im,
-                     M_layer_symb,
-                     N_ant,
-                     LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                     phy_struct->bch_y_re[0],
-                     phy_struct->bch_y_im[0],
-                     240,
-                     &M_ap_symb);
+// Defines
+#define DL_CE_NOISE_RATIO_MIN 1e-4
+// Enums
+// Structs
+// Functions
+void dl_ce_cartesian(LIBLTE_PHY_STRUCT          *phy_struct,
+                     uint32                      N_id_cell,
+                     uint8                       N_ant,
+                     LIBLTE_PHY_SUBFRAME_STRUCT *subframe);
 
-        // Map the symbols to resource elements
-        idx = 0;
-        for(p=0; p<N_ant; p++)
-        {
-            for(i=0; i<72; i++)
-            {
-                k = (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl)/2 - 36 + i;
-                if((N_id_cell % 3) != (i % 3))
-                {
-                    subframe->tx_symb_re[p][7][k] = phy_struct->bch_y_re[p][idx];
-                    subframe->tx_symb_im[p][7][k] = phy_struct->bch_y_im[p][idx];
-                    subframe->tx_symb_re[p][8][k] = phy_struct->bch_y_re[p][idx+48];
-                    subframe->tx_symb_im[p][8][k] = phy_struct->bch_y_im[p][idx+48];
-                    idx++;
-                }
-                subframe->tx_symb_re[p][9][k]  = phy_struct->bch_y_re[p][i+96];
-                subframe->tx_symb_im[p][9][k]  = phy_struct->bch_y_im[p][i+96];
-                subframe->tx_symb_re[p][10][k] = phy_struct->bch_y_re[p][i+168];
-                subframe->tx_symb_im[p][10][k] = phy_struct->bch_y_im[p][i+168];
-            }
-        }
+/*********************************************************************
+    Name: dl_ce_interp_weights
 
-        err = LIBLTE_SUCCESS;
-    }
+    Description: Fills dl_ce_w with the 4 tap frequency interpolation
+                 weights for each subcarrier position relative to a
+                 window of 4 CRSs, from 5 subcarriers before the first
+                 CRS to 23 after it.  Wiener weights use a sinc
+                 frequency correlation for a delay spread as long as
+                 the normal cyclic prefix and the given noise to
+                 signal ratio.
 
-    return(err);
-}
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+#define DL_CE_N_W_POS         29
+#define DL_CE_WIENER_DF_TAU   0.07 // 15kHz subcarrier spacing * 4.7us cyclic prefix
+// Enums
+// Structs
+// Functions
+void dl_ce_interp_weights(LIBLTE_PHY_STRUCT          *phy_struct,
+                          LIBLTE_PHY_DL_CE_TYPE_ENUM  ce_type,
+                          float                       noise_ratio);
 
 /*********************************************************************
-    Name: liblte_phy_bch_channel_decode
+    Name: dl_ce_interp_freq
 
-    Description: Demodulates and decodes the Physical Broadcast
-                 Channel
+    Description: Interpolates the CRS estimates of one symbol to all
+                 subcarriers, each subcarrier uses the 4 closest CRSs
+                 and the weights for its position relative to them.
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.6
+    Document Reference: N/A
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_bch_channel_decode(LIBLTE_PHY_STRUCT          *phy_struct,
-                                                LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
-                                                uint32                      N_id_cell,
-                                                uint8                      *N_ant,
-                                                uint8                      *out_bits,
-                                                uint32                     *N_out_bits,
-                                                uint8                      *offset)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            j;
-    uint32            p;
-    uint32            in_idx;
-    uint32            idx;
-    uint32            M_layer_symb;
-    uint32            M_symb;
-    uint32            N_bits;
+// Defines
+// Enums
+// Structs
+// Functions
+void dl_ce_interp_freq(float  *ls_re,
+                       float  *ls_im,
+                       uint32  N_pilots,
+                       uint32  offset,
+                       float   w[][4],
+                       float  *ce_re,
+                       float  *ce_im);
 
-    if(phy_struct != NULL &&
-       subframe   != NULL &&
-       N_id_cell  >= 0    &&
-       N_id_cell  <= 503  &&
-       N_ant      != NULL &&
-       out_bits   != NULL &&
-       N_out_bits != NULL &&
-       offset     != NULL)
-    {
-        err = LIBLTE_ERROR_DECODE_FAIL;
+/*********************************************************************
+    Name: dl_ce_interp_time_scalar
 
-        // Unmap PBCH and channel estimates from resource elements
-        idx = 0;
-        for(i=0; i<72; i++)
-        {
-            in_idx = phy_struct->N_sc_rb_dl*phy_struct->N_rb_dl/2 - 36 + i;
-            if((N_id_cell % 3) != (i % 3))
-            {
-                phy_struct->bch_y_est_re[idx]    = subframe->rx_symb_re[7][in_idx];
-                phy_struct->bch_y_est_im[idx]    = subframe->rx_symb_im[7][in_idx];
-                phy_struct->bch_y_est_re[idx+48] = subframe->rx_symb_re[8][in_idx];
-                phy_struct->bch_y_est_im[idx+48] = subframe->rx_symb_im[8][in_idx];
-                for(p=0; p<4; p++)
-                {
-                    phy_struct->bch_c_est_re[p][idx]    = subframe->rx_ce_re[p][7][in_idx];
-                    phy_struct->bch_c_est_im[p][idx]    = subframe->rx_ce_im[p][7][in_idx];
-                    phy_struct->bch_c_est_re[p][idx+48] = subframe->rx_ce_re[p][8][in_idx];
-                    phy_struct->bch_c_est_im[p][idx+48] = subframe->rx_ce_im[p][8][in_idx];
-                }
-                idx++;
-            }
-            phy_struct->bch_y_est_re[i+96]  = subframe->rx_symb_re[9][in_idx];
-            phy_struct->bch_y_est_im[i+96]  = subframe->rx_symb_im[9][in_idx];
-            phy_struct->bch_y_est_re[i+168] = subframe->rx_symb_re[10][in_idx];
-            phy_struct->bch_y_est_im[i+168] = subframe->rx_symb_im[10][in_idx];
-            for(p=0; p<4; p++)
-            {
-                phy_struct->bch_c_est_re[p][i+96]  = subframe->rx_ce_re[p][9][in_idx];
-                phy_struct->bch_c_est_im[p][i+96]  = subframe->rx_ce_im[p][9][in_idx];
-                phy_struct->bch_c_est_re[p][i+168] = subframe->rx_ce_re[p][10][in_idx];
-                phy_struct->bch_c_est_im[p][i+168] = subframe->rx_ce_im[p][10][in_idx];
-            }
-        }
+    Description: Linearly interpolates, or extrapolates when frac is
+                 outside of [0, 1], between two symbols of channel
+                 estimates.
 
-        // Generate the scrambling sequence
-        generate_prs_c(N_id_cell, 1920, phy_struct->bch_c);
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void dl_ce_interp_time_scalar(float  *a_re,
+                              float  *a_im,
+                              float  *b_re,
+                              float  *b_im,
+                              float   frac,
+                              uint32  N,
+                              float  *ce_re,
+                              float  *ce_im);
+
+#if defined(__SSE2__)
+/*********************************************************************
+    Name: dl_ce_interp_time_sse2
 
-        // Try decoding with 1, 2, and 4 antennas
-        for(p=1; p<5; p++)
-        {
-            if(p != 3)
-            {
-                pre_decoder_and_matched_filter_dl(phy_struct->bch_y_est_re,
-                                                  phy_struct->bch_y_est_im,
-                                                  phy_struct->bch_c_est_re[0],
-                                                  phy_struct->bch_c_est_im[0],
-                                                  240,
-                                                  240,
-                                                  p,
-                                                  LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                                                  phy_struct->bch_x_re,
-                                                  phy_struct->bch_x_im,
-                                                  &M_layer_symb);
-                layer_demapper_dl(phy_struct->bch_x_re,
-                                  phy_struct->bch_x_im,
-                                  M_layer_symb,
-                                  p,
-                                  1,
-                                  LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                                  phy_struct->bch_d_re,
-                                  phy_struct->bch_d_im,
-                                  &M_symb);
-                modulation_demapper(phy_struct->bch_d_re,
-                                    phy_struct->bch_d_im,
-                                    M_symb,
-                                    LIBLTE_PHY_MODULATION_TYPE_QPSK,
-                                    phy_struct->bch_soft_bits,
-                                    &N_bits);
+    Description: SSE2 version of dl_ce_interp_time_scalar
 
-                // Try decoding at each offset
-                *N_ant = 0;
-                for(i=0; i<4; i++)
-                {
-                    for(j=0; j<1920; j++)
-                    {
-                        phy_struct->bch_descramb_bits[j] = RX_NULL_BIT;
-                    }
-                    for(j=0; j<480; j++)
-                    {
-                        phy_struct->bch_descramb_bits[(i*480)+j] = (float)phy_struct->bch_soft_bits[j]*(1-2*(float)phy_struct->bch_c[(i*480)+j]);
-                    }
-                    if(LIBLTE_SUCCESS == bch_channel_decode(phy_struct,
-                                                            phy_struct->bch_descramb_bits,
-                                                            1920,
-                                                            N_ant,
-                                                            out_bits,
-                                                            N_out_bits))
-                    {
-                        *offset = i;
-                        break;
-                    }
-                }
-                if(*N_ant != 0)
-                {
-                    err = LIBLTE_SUCCESS;
-                    break;
-                }
-            }
-        }
-    }
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void dl_ce_interp_time_sse2(float  *a_re,
+                            float  *a_im,
+                            float  *b_re,
+                            float  *b_im,
+                            float   frac,
+                            uint32  N,
+                            float  *ce_re,
+                            float  *ce_im);
+#endif
+
+#if defined(PHY_KERNEL_X86)
+/*********************************************************************
+    Name: dl_ce_interp_time_avx2
 
-    return(err);
-}
+    Description: AVX2 version of dl_ce_interp_time_scalar
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+PHY_TARGET_AVX2
+void dl_ce_interp_time_avx2(float  *a_re,
+                            float  *a_im,
+                            float  *b_re,
+                            float  *b_im,
+                            float   frac,
+                            uint32  N,
+                            float  *ce_re,
+                            float  *ce_im);
 
 /*********************************************************************
-    Name: liblte_phy_pdcch_channel_encode
+    Name: dl_ce_interp_time_avx512
 
-    Description: Encodes and modulates all of the Physical Downlink
-                 Control Channels (PCFICH, PHICH, and PDCCH)
+    Description: AVX-512 version of dl_ce_interp_time_scalar
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.7, 6.8, and
-                        6.9
-                        3GPP TS 36.212 v10.1.0 section 5.1.4.2.1
-                        3GPP TS 36.213 v10.3.0 section 7.1 and 9.1.1
+    Document Reference: N/A
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT              *phy_struct,
-                                                  LIBLTE_PHY_PCFICH_STRUCT       *pcfich,
-                                                  LIBLTE_PHY_PHICH_STRUCT        *phich,
-                                                  LIBLTE_PHY_PDCCH_STRUCT        *pdcch,
-                                                  uint32                          N_id_cell,
-                                                  uint8                           N_ant,
-                                                  float                           phich_res,
-                                                  LIBLTE_RRC_PHICH_DURATION_ENUM  phich_dur,
-                                                  LIBLTE_PHY_SUBFRAME_STRUCT     *subframe)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            j;
-    uint32            k;
-    uint32            p;
-    uint32            idx;
-    uint32            a_idx;
-    uint32            css_idx;
-    uint32            uss_idx;
-    uint32            actual_idx;
-    uint32            c_init;
-    uint32            N_bits;
-    uint32            M_symb;
-    uint32            M_layer_symb;
-    uint32            M_ap_symb;
-    uint32            N_reg_rb;
-    uint32            N_reg_pdcch;
-    uint32            N_cce_pdcch;
-    uint32            N_reg_cce;
-    uint32            dci_size;
-    uint32            N_dummy;
-    uint32            C_cc_sb;
-    uint32            R_cc_sb;
-    uint32            K_pi;
-    uint32            shift_idx;
-    uint32            k_prime;
-    uint32            l_prime;
-    uint32            m_prime;
-    uint32            Y_k;
-    bool              valid_reg;
+// Defines
+// Enums
+// Structs
+// Functions
+PHY_TARGET_AVX512
+void dl_ce_interp_time_avx512(float  *a_re,
+                              float  *a_im,
+                              float  *b_re,
+                              float  *b_im,
+                              float   frac,
+                              uint32  N,
+                              float  *ce_re,
+                              float  *ce_im);
+#endif
 
-    if(phy_struct != NULL &&
-       pcfich     != NULL &&
-       phich      != NULL &&
-       pdcch      != NULL &&
-       N_id_cell  >= 0    &&
-       N_id_cell  <= 503  &&
-       subframe   != NULL)
-    {
-        // PCFICH
-        pcfich_channel_map(phy_struct, pcfich, N_id_cell, N_ant, subframe);
+/*********************************************************************
+    Name: fftw_wisdom_filename
 
-        // PHICH
-        phich_channel_map(phy_struct, phich, pcfich, N_id_cell, N_ant, phich_res, phich_dur, subframe);
+    Description: Builds the wisdom file name for this CPU and sample
+                 rate, the CPU is identified by a hash of its model
+                 name and feature flags.
 
-        // PDCCH
-        if(pdcch->N_alloc != 0)
-        {
-            // Calculate number of symbols, 3GPP TS 36.211 v10.1.0 section 6.7
-            pdcch->N_symbs = pcfich->cfi;
-            if(phy_struct->N_rb_dl <= 10)
-            {
-                pdcch->N_symbs++;
-            }
-            // Calculate resources, 3GPP TS 36.211 v10.1.0 section 6.8.1
-            N_reg_rb    = 3;
-            N_reg_cce   = 9;
-            N_reg_pdcch = pdcch->N_symbs*(phy_struct->N_rb_dl*N_reg_rb) - phy_struct->N_rb_dl - pcfich->N_reg - phich->N_reg;
-            if(N_ant == 4)
-            {
-                // Remove CRS
-                N_reg_pdcch -= phy_struct->N_rb_dl;
-            }
-            N_cce_pdcch = N_reg_pdcch/N_reg_cce;
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+#define FFTW_WISDOM_FILENAME_MAX (LIBLTE_PHY_FFTW_WISDOM_PATH_MAX + 64)
+// Enums
+// Structs
+// Functions
+void fftw_wisdom_filename(uint32  fs,
+                          char   *filename);
 
-            // Initialize the search space
-            for(p=0; p<N_ant; p++)
-            {
-                for(i=0; i<N_cce_pdcch; i++)
-                {
-                    for(j=0; j<4*N_reg_cce; j++)
-                    {
-                        phy_struct->pdcch_cce_re[p][i][j] = 0;
-                        phy_struct->pdcch_cce_im[p][i][j] = 0;
-                    }
-                    phy_struct->pdcch_cce_used[i] = false;
-                }
-            }
+/*********************************************************************
+    Name: fftw_wisdom_import
 
-            // Generate the scrambling sequence
-            c_init = (subframe->num << 9) + N_id_cell;
-            generate_prs_c(c_init, 1152, phy_struct->pdcch_c);
+    Description: Imports stored wisdom ahead of FFT plan creation and
+                 returns a snapshot of the wisdom, to be handed to
+                 fftw_wisdom_export once the plans are created.
 
-            // Add the DCIs
-            for(a_idx=0; a_idx<pdcch->N_alloc; a_idx++)
-            {
-                // Encode the DCI
-                if(LIBLTE_PHY_CHAN_TYPE_DLSCH == pdcch->alloc[a_idx].chan_type)
-                {
-                    dci_1a_pack(&pdcch->alloc[a_idx],
-                                LIBLTE_PHY_DCI_CA_NOT_PRESENT,
-                                phy_struct->N_rb_dl,
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+char* fftw_wisdom_import(uint32 fs);
+
+/*********************************************************************
+    Name: fftw_wisdom_export
+
+    Description: Stores the wisdom if plan creation added to it since
+                 the snapshot was taken, and frees the snapshot.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void fftw_wisdom_export(uint32  fs,
+                        char   *snapshot);
+
+/*********************************************************************
+    Name: phy_kernel_select
+
+    Description: Fills PHY_KERNELS with the best implementation of each
+                 DSP kernel for this CPU.  LIBLTE_PHY_SIMD_ENV_VAR can
+                 select a lower instruction set, for comparing the
+                 implementations, but never one the CPU lacks.  Each
+                 level starts from the one below it so kernels without
+                 a version for an instruction set keep the best lower
+                 one.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void phy_kernel_select(void);
+
+/*********************************************************************
+    Name: cmul_scalar
+
+    Description: Multiplies two complex vectors, y = a*b
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void cmul_scalar(float  *a_re,
+                 float  *a_im,
+                 float  *b_re,
+                 float  *b_im,
+                 uint32  N,
+                 float  *y_re,
+                 float  *y_im);
+
+/*********************************************************************
+    Name: cmul_conj_scalar
+
+    Description: Multiplies the conjugate of one complex vector with
+                 another, y = conj(a)*b
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void cmul_conj_scalar(float  *a_re,
+                      float  *a_im,
+                      float  *b_re,
+                      float  *b_im,
+                      uint32  N,
+                      float  *y_re,
+                      float  *y_im);
+
+/*********************************************************************
+    Name: cmul_conj_interleaved_scalar
+
+    Description: Multiplies the conjugate of one complex vector with
+                 another, y = conj(a)*b, writing interleaved output
+                 for FFTW
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void cmul_conj_interleaved_scalar(float         *a_re,
+                                  float         *a_im,
+                                  float         *b_re,
+                                  float         *b_im,
+                                  uint32         N,
+                                  fftwf_complex *y);
+
+#if defined(__SSE2__)
+/*********************************************************************
+    Name: cmul_sse2
+
+    Description: SSE2 version of cmul_scalar
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void cmul_sse2(float  *a_re,
+               float  *a_im,
+               float  *b_re,
+               float  *b_im,
+               uint32  N,
+               float  *y_re,
+               float  *y_im);
+
+/*********************************************************************
+    Name: cmul_conj_sse2
+
+    Description: SSE2 version of cmul_conj_scalar
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void cmul_conj_sse2(float  *a_re,
+                    float  *a_im,
+                    float  *b_re,
+                    float  *b_im,
+                    uint32  N,
+                    float  *y_re,
+                    float  *y_im);
+
+/*********************************************************************
+    Name: cmul_conj_interleaved_sse2
+
+    Description: SSE2 version of cmul_conj_interleaved_scalar
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void cmul_conj_interleaved_sse2(float         *a_re,
+                                float         *a_im,
+                                float         *b_re,
+                                float         *b_im,
+                                uint32         N,
+                                fftwf_complex *y);
+#endif
+
+#if defined(PHY_KERNEL_X86)
+/*********************************************************************
+    Name: cmul_avx2
+
+    Description: AVX2 version of cmul_scalar
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+PHY_TARGET_AVX2
+void cmul_avx2(float  *a_re,
+               float  *a_im,
+               float  *b_re,
+               float  *b_im,
+               uint32  N,
+               float  *y_re,
+               float  *y_im);
+
+/*********************************************************************
+    Name: cmul_conj_avx2
+
+    Description: AVX2 version of cmul_conj_scalar
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+PHY_TARGET_AVX2
+void cmul_conj_avx2(float  *a_re,
+                    float  *a_im,
+                    float  *b_re,
+                    float  *b_im,
+                    uint32  N,
+                    float  *y_re,
+                    float  *y_im);
+
+/*********************************************************************
+    Name: cmul_conj_interleaved_avx2
+
+    Description: AVX2 version of cmul_conj_interleaved_scalar.  The
+                 unpacks work within each 128 bit lane so the lanes
+                 are swapped back into order before storing.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+PHY_TARGET_AVX2
+void cmul_conj_interleaved_avx2(float         *a_re,
+                                float         *a_im,
+                                float         *b_re,
+                                float         *b_im,
+                                uint32         N,
+                                fftwf_complex *y);
+
+/*********************************************************************
+    Name: cmul_avx512
+
+    Description: AVX-512 version of cmul_scalar
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+PHY_TARGET_AVX512
+void cmul_avx512(float  *a_re,
+                 float  *a_im,
+                 float  *b_re,
+                 float  *b_im,
+                 uint32  N,
+                 float  *y_re,
+                 float  *y_im);
+
+/*********************************************************************
+    Name: cmul_conj_avx512
+
+    Description: AVX-512 version of cmul_conj_scalar
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+PHY_TARGET_AVX512
+void cmul_conj_avx512(float  *a_re,
+                      float  *a_im,
+                      float  *b_re,
+                      float  *b_im,
+                      uint32  N,
+                      float  *y_re,
+                      float  *y_im);
+#endif
+
+/*********************************************************************
+    Name: phy_workspace_alloc
+
+    Description: Allocates a workspace for a cell, including its own
+                 FFT buffers so that the shared plans can be executed
+                 from several threads at once.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+#define PRACH_N_ZC_MAX 839
+// Enums
+// Structs
+// Functions
+void phy_workspace_alloc(LIBLTE_PHY_CELL_STRUCT  *cell,
+                         LIBLTE_PHY_STRUCT      **workspace);
+
+/*********************************************************************
+    Name: phy_cell_ul_cleanup
+
+    Description: Destroys the uplink plans of a cell.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void phy_cell_ul_cleanup(LIBLTE_PHY_CELL_STRUCT *cell);
+
+/*******************************************************************************
+                              LIBRARY FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: liblte_phy_init
+
+    Description: Initializes the LTE Physical Layer library.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_init(LIBLTE_PHY_STRUCT  **phy_struct,
+                                  LIBLTE_PHY_FS_ENUM   fs,
+                                  uint16               N_id_cell,
+                                  uint8                N_ant,
+                                  uint32               N_rb_dl,
+                                  uint32               N_sc_rb_dl,
+                                  float                phich_res)
+{
+    LIBLTE_PHY_CELL_STRUCT *cell;
+    LIBLTE_ERROR_ENUM       err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32                  i;
+    char                   *wisdom;
+
+    if(phy_struct != NULL)
+    {
+        pthread_once(&PHY_KERNEL_ONCE, phy_kernel_select);
+
+        cell            = (LIBLTE_PHY_CELL_STRUCT *)malloc(sizeof(LIBLTE_PHY_CELL_STRUCT));
+        cell->ref_count = 1;
+
+        // Generic
+        switch(fs)
+        {
+        case LIBLTE_PHY_FS_30_72MHZ:
+            cell->fs                = 30720000;
+            cell->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_30_72MHZ;
+            cell->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_30_72MHZ;
+            cell->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_30_72MHZ;
+            cell->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_30_72MHZ;
+            cell->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_30_72MHZ;
+            cell->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_30_72MHZ;
+            break;
+        case LIBLTE_PHY_FS_15_36MHZ:
+            cell->fs                = 15360000;
+            cell->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_15_36MHZ;
+            cell->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_15_36MHZ;
+            cell->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_15_36MHZ;
+            cell->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_15_36MHZ;
+            cell->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_15_36MHZ;
+            cell->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_15_36MHZ;
+            break;
+        case LIBLTE_PHY_FS_7_68MHZ:
+            cell->fs                = 7680000;
+            cell->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_7_68MHZ;
+            cell->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_7_68MHZ;
+            cell->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_7_68MHZ;
+            cell->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_7_68MHZ;
+            cell->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_7_68MHZ;
+            cell->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_7_68MHZ;
+            break;
+        case LIBLTE_PHY_FS_3_84MHZ:
+            cell->fs                = 3840000;
+            cell->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_3_84MHZ;
+            cell->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_3_84MHZ;
+            cell->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_3_84MHZ;
+            cell->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_3_84MHZ;
+            cell->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_3_84MHZ;
+            cell->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_3_84MHZ;
+            break;
+        case LIBLTE_PHY_FS_1_92MHZ:
+            cell->fs                = 1920000;
+            cell->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_1_92MHZ;
+            cell->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_1_92MHZ;
+            cell->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_1_92MHZ;
+            cell->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_1_92MHZ;
+            cell->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_1_92MHZ;
+            cell->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_1_92MHZ;
+            break;
+        }
+        cell->N_sc_rb_dl = N_sc_rb_dl;
+        cell->N_sc_rb_ul = LIBLTE_PHY_N_SC_RB_UL;
+        cell->ul_init    = false;
+
+        // Workspace
+        phy_workspace_alloc(cell, phy_struct);
+        liblte_phy_update_n_rb_dl((*phy_struct), N_rb_dl);
+
+        // PHICH
+        if(LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP == cell->N_sc_rb_dl)
+        {
+            (*phy_struct)->N_group_phich = (uint32)ceilf((float)phich_res*((float)cell->N_rb_dl/(float)8));
+            (*phy_struct)->N_sf_phich    = 4;
+        }else{
+            (*phy_struct)->N_group_phich = 2*(uint32)ceilf((float)phich_res*((float)cell->N_rb_dl/(float)8));
+            (*phy_struct)->N_sf_phich    = 2;
+        }
+
+        // PDCCH Permutation
+        pdcch_permute_pre_calc(*phy_struct,
+                               N_ant,
+                               phich_res);
+
+        // Viterbi decode
+        viterbi_pre_calc(*phy_struct);
+        turbo_encode_pre_calc(*phy_struct);
+
+        // SSS references
+        sss_pre_calc(*phy_struct);
+
+        // CRS Storage
+        if(LIBLTE_PHY_INIT_N_ID_CELL_UNKNOWN != N_id_cell)
+        {
+            cell->N_id_cell_crs = N_id_cell;
+            for(i=0; i<20; i++)
+            {
+                generate_crs(i, 0, N_id_cell, N_sc_rb_dl, cell->crs_re_storage[i][0], cell->crs_im_storage[i][0]);
+                generate_crs(i, 1, N_id_cell, N_sc_rb_dl, cell->crs_re_storage[i][1], cell->crs_im_storage[i][1]);
+                generate_crs(i, 4, N_id_cell, N_sc_rb_dl, cell->crs_re_storage[i][2], cell->crs_im_storage[i][2]);
+            }
+        }
+
+        // Samples to symbols, the plans are created on this workspace's
+        // buffers and executed on the buffers of whichever workspace
+        // uses them
+        wisdom                       = fftw_wisdom_import(cell->fs);
+        cell->symbs_to_samps_dl_plan = fftwf_plan_dft_1d(cell->N_samps_per_symb,
+                                                         (*phy_struct)->s2s_in,
+                                                         (*phy_struct)->s2s_out,
+                                                         FFTW_BACKWARD,
+                                                         FFTW_MEASURE);
+        cell->samps_to_symbs_dl_plan = fftwf_plan_dft_1d(cell->N_samps_per_symb,
+                                                         (*phy_struct)->s2s_in,
+                                                         (*phy_struct)->s2s_out,
+                                                         FFTW_FORWARD,
+                                                         FFTW_MEASURE);
+        cell->symbs_to_samps_ul_plan = fftwf_plan_dft_1d(cell->N_samps_per_symb*2,
+                                                         (*phy_struct)->s2s_in,
+                                                         (*phy_struct)->s2s_out,
+                                                         FFTW_BACKWARD,
+                                                         FFTW_MEASURE);
+        cell->samps_to_symbs_ul_plan = fftwf_plan_dft_1d(cell->N_samps_per_symb*2,
+                                                         (*phy_struct)->s2s_in,
+                                                         (*phy_struct)->s2s_out,
+                                                         FFTW_FORWARD,
+                                                         FFTW_MEASURE);
+        s2s_subframe_pre_calc(*phy_struct);
+        fftw_wisdom_export(cell->fs, wisdom);
+
+        // PSS correlation filters
+        pss_corr_pre_calc(*phy_struct);
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_phy_ul_init(LIBLTE_PHY_STRUCT *phy_struct,
+                                     uint16             N_id_cell,
+                                     uint32             prach_root_seq_idx,
+                                     uint32             prach_preamble_format,
+                                     uint32             prach_zczc,
+                                     bool               prach_hs_flag,
+                                     uint8              group_assignment_pusch,
+                                     bool               group_hopping_enabled,
+                                     bool               sequence_hopping_enabled,
+                                     uint8              cyclic_shift,
+                                     uint8              cyclic_shift_dci)
+{
+    LIBLTE_PHY_CELL_STRUCT *cell;
+    LIBLTE_ERROR_ENUM       err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32                  i;
+    uint32                  j;
+    char                   *wisdom;
+
+    if(phy_struct != NULL)
+    {
+        cell = phy_struct->cell;
+
+        // PUSCH
+        wisdom = fftw_wisdom_import(cell->fs);
+        for(i=0; i<cell->N_rb_ul; i++)
+        {
+            if((i % 2) == 0 ||
+               (i % 3) == 0 ||
+               (i % 5) == 0)
+            {
+                cell->transform_precoding_plan[i]    = fftwf_plan_dft_1d(i*LIBLTE_PHY_N_SC_RB_UL,
+                                                                         phy_struct->transform_precoding_in,
+                                                                         phy_struct->transform_precoding_out,
+                                                                         FFTW_FORWARD,
+                                                                         FFTW_MEASURE);
+                cell->transform_pre_decoding_plan[i] = fftwf_plan_dft_1d(i*LIBLTE_PHY_N_SC_RB_UL,
+                                                                         phy_struct->transform_precoding_in,
+                                                                         phy_struct->transform_precoding_out,
+                                                                         FFTW_BACKWARD,
+                                                                         FFTW_MEASURE);
+            }
+        }
+
+        // DMRS
+        for(i=0; i<LIBLTE_PHY_N_SUBFR_PER_FRAME; i++)
+        {
+            for(j=0; j<LIBLTE_PHY_N_RB_UL_MAX; j++)
+            {
+                generate_dmrs_pusch(phy_struct,
+                                    i,
+                                    N_id_cell,
+                                    group_assignment_pusch,
+                                    cyclic_shift,
+                                    cyclic_shift_dci,
+                                    j,
+                                    0,
+                                    group_hopping_enabled,
+                                    sequence_hopping_enabled,
+                                    cell->dmrs_0_re[i][j],
+                                    cell->dmrs_0_im[i][j],
+                                    cell->dmrs_1_re[i][j],
+                                    cell->dmrs_1_im[i][j]);
+            }
+        }
+
+        // PRACH
+        prach_preamble_seq_gen(phy_struct,
+                               prach_root_seq_idx,
+                               prach_preamble_format,
+                               prach_zczc,
+                               prach_hs_flag);
+
+        switch(prach_preamble_format)
+        {
+        case 0:
+            cell->prach_T_fft      = 24576/(30720000/cell->fs);
+            cell->prach_T_seq      = 24576/(30720000/cell->fs);
+            cell->prach_T_cp       = 3168/(30720000/cell->fs);
+            cell->prach_delta_f_RA = 1250;
+            cell->prach_phi        = 7;
+            break;
+        case 1:
+            cell->prach_T_fft      = 24576/(30720000/cell->fs);
+            cell->prach_T_seq      = 24576/(30720000/cell->fs);
+            cell->prach_T_cp       = 21024/(30720000/cell->fs);
+            cell->prach_delta_f_RA = 1250;
+            cell->prach_phi        = 7;
+            break;
+        case 2:
+            cell->prach_T_fft      = 24576/(30720000/cell->fs);
+            cell->prach_T_seq      = 2*24576/(30720000/cell->fs);
+            cell->prach_T_cp       = 6240/(30720000/cell->fs);
+            cell->prach_delta_f_RA = 1250;
+            cell->prach_phi        = 7;
+            break;
+        case 3:
+            cell->prach_T_fft      = 24576/(30720000/cell->fs);
+            cell->prach_T_seq      = 2*24576/(30720000/cell->fs);
+            cell->prach_T_cp       = 21024/(30720000/cell->fs);
+            cell->prach_delta_f_RA = 1250;
+            cell->prach_phi        = 7;
+            break;
+        case 4:
+        default:
+            cell->prach_T_fft      = 4096/(30720000/cell->fs);
+            cell->prach_T_seq      = 4096/(30720000/cell->fs);
+            cell->prach_T_cp       = 448/(30720000/cell->fs);
+            cell->prach_delta_f_RA = 7500;
+            cell->prach_phi        = 2;
+            break;
+        }
+        cell->prach_dft_plan  = fftwf_plan_dft_1d(cell->prach_N_zc,
+                                                  phy_struct->prach_dft_in,
+                                                  phy_struct->prach_dft_out,
+                                                  FFTW_FORWARD,
+                                                  FFTW_MEASURE);
+        cell->prach_ifft_plan = fftwf_plan_dft_1d(cell->prach_T_fft,
+                                                  phy_struct->prach_fft_in,
+                                                  phy_struct->prach_fft_out,
+                                                  FFTW_BACKWARD,
+                                                  FFTW_MEASURE);
+        cell->prach_fft_plan  = fftwf_plan_dft_1d(cell->prach_T_fft,
+                                                  phy_struct->prach_fft_in,
+                                                  phy_struct->prach_fft_out,
+                                                  FFTW_FORWARD,
+                                                  FFTW_MEASURE);
+        cell->prach_idft_plan = fftwf_plan_dft_1d(cell->prach_N_zc,
+                                                  phy_struct->prach_dft_in,
+                                                  phy_struct->prach_dft_out,
+                                                  FFTW_BACKWARD,
+                                                  FFTW_MEASURE);
+        cell->prach_corr_plan = fftwf_plan_many_dft(1,
+                                                    (int *)&cell->prach_N_zc,
+                                                    cell->prach_N_x_u,
+                                                    phy_struct->prach_corr_in,
+                                                    NULL,
+                                                    1,
+                                                    cell->prach_N_zc,
+                                                    phy_struct->prach_corr_out,
+                                                    NULL,
+                                                    1,
+                                                    cell->prach_N_zc,
+                                                    FFTW_BACKWARD,
+                                                    FFTW_MEASURE);
+        fftw_wisdom_export(cell->fs, wisdom);
+
+        // The root spectra are stored in the same subcarrier order that
+        // liblte_phy_generate_prach maps them, which is the order
+        // liblte_phy_detect_prach reads them back in
+        for(i=0; i<cell->prach_N_x_u; i++)
+        {
+            for(j=0; j<cell->prach_N_zc; j++)
+            {
+                phy_struct->prach_dft_in[j][0] = cell->prach_x_u_re[i][j];
+                phy_struct->prach_dft_in[j][1] = cell->prach_x_u_im[i][j];
+            }
+            fftwf_execute_dft(cell->prach_dft_plan, phy_struct->prach_dft_in, phy_struct->prach_dft_out);
+            for(j=0; j<cell->prach_N_zc; j++)
+            {
+                cell->prach_x_u_fft_re[i][j] = phy_struct->prach_dft_out[(j+cell->prach_N_zc/2)%cell->prach_N_zc][0];
+                cell->prach_x_u_fft_im[i][j] = phy_struct->prach_dft_out[(j+cell->prach_N_zc/2)%cell->prach_N_zc][1];
+            }
+        }
+
+        // Generic
+        cell->ul_init = true;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_cleanup
+
+    Description: Cleans up the LTE Physical Layer library.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_cleanup(LIBLTE_PHY_STRUCT *phy_struct)
+{
+    LIBLTE_PHY_CELL_STRUCT *cell;
+    LIBLTE_ERROR_ENUM       err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(phy_struct != NULL)
+    {
+        cell = phy_struct->cell;
+
+        // Workspace
+        code_block_pool_cleanup(phy_struct);
+        fftwf_free(phy_struct->s2s_in);
+        fftwf_free(phy_struct->s2s_out);
+        fftwf_free(phy_struct->transform_precoding_in);
+        fftwf_free(phy_struct->transform_precoding_out);
+        fftwf_free(phy_struct->prach_dft_in);
+        fftwf_free(phy_struct->prach_dft_out);
+        fftwf_free(phy_struct->prach_fft_in);
+        fftwf_free(phy_struct->prach_fft_out);
+        fftwf_free(phy_struct->prach_corr_in);
+        fftwf_free(phy_struct->prach_corr_out);
+        free(phy_struct->ul_scratch);
+        free(phy_struct->dl_scratch);
+        free(phy_struct->pdcch_scratch);
+        free(phy_struct->dl_ce_scratch);
+        free(phy_struct->dl_sync_scratch);
+        free(phy_struct->td_scratch);
+        free(phy_struct);
+
+        // Cell, freed with its last workspace
+        if(0 == __sync_sub_and_fetch(&cell->ref_count, 1))
+        {
+            if(cell->ul_init)
+            {
+                phy_cell_ul_cleanup(cell);
+            }
+            fftwf_destroy_plan(cell->samps_to_symbs_dl_plan);
+            fftwf_destroy_plan(cell->symbs_to_samps_dl_plan);
+            fftwf_destroy_plan(cell->samps_to_symbs_ul_plan);
+            fftwf_destroy_plan(cell->symbs_to_samps_ul_plan);
+            fftwf_destroy_plan(cell->symbs_to_samps_dl_subfr_plan);
+            fftwf_destroy_plan(cell->samps_to_symbs_dl_subfr_plan);
+            fftwf_destroy_plan(cell->samps_to_symbs_ul_subfr_plan);
+            free(cell);
+        }
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_phy_ul_cleanup(LIBLTE_PHY_STRUCT *phy_struct)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(phy_struct != NULL &&
+       phy_struct->cell->ul_init)
+    {
+        phy_cell_ul_cleanup(phy_struct->cell);
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_init_workspace
+
+    Description: Creates an additional workspace sharing the cell
+                 tables of an initialized LTE Physical Layer library
+                 instance, one workspace is needed per thread.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_init_workspace(LIBLTE_PHY_STRUCT  *phy_struct,
+                                            LIBLTE_PHY_STRUCT **workspace)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(phy_struct != NULL &&
+       workspace  != NULL)
+    {
+        __sync_add_and_fetch(&phy_struct->cell->ref_count, 1);
+        phy_workspace_alloc(phy_struct->cell, workspace);
+        (*workspace)->N_group_phich = phy_struct->N_group_phich;
+        (*workspace)->N_sf_phich    = phy_struct->N_sf_phich;
+        (*workspace)->td_N_iter     = phy_struct->td_N_iter;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_update_n_rb_dl
+
+    Description: Updates N_rb_dl and all associated variables.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_update_n_rb_dl(LIBLTE_PHY_STRUCT *phy_struct,
+                                            uint32             N_rb_dl)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            used_subcarriers;
+
+    if(phy_struct != NULL)
+    {
+        used_subcarriers = N_rb_dl*phy_struct->cell->N_sc_rb_dl;
+        switch(phy_struct->cell->N_samps_per_symb)
+        {
+        case LIBLTE_PHY_N_SAMPS_PER_SYMB_30_72MHZ:
+            phy_struct->cell->FFT_size = LIBLTE_PHY_FFT_SIZE_30_72MHZ;
+            err                        = LIBLTE_SUCCESS;
+            break;
+        case LIBLTE_PHY_N_SAMPS_PER_SYMB_15_36MHZ:
+            if(LIBLTE_PHY_N_RB_DL_10MHZ  == N_rb_dl ||
+               LIBLTE_PHY_N_RB_DL_5MHZ   == N_rb_dl ||
+               LIBLTE_PHY_N_RB_DL_3MHZ   == N_rb_dl ||
+               LIBLTE_PHY_N_RB_DL_1_4MHZ == N_rb_dl)
+            {
+                phy_struct->cell->FFT_size = LIBLTE_PHY_FFT_SIZE_15_36MHZ;
+                err                        = LIBLTE_SUCCESS;
+            }
+            break;
+        case LIBLTE_PHY_N_SAMPS_PER_SYMB_7_68MHZ:
+            if(LIBLTE_PHY_N_RB_DL_5MHZ   == N_rb_dl ||
+               LIBLTE_PHY_N_RB_DL_3MHZ   == N_rb_dl ||
+               LIBLTE_PHY_N_RB_DL_1_4MHZ == N_rb_dl)
+            {
+                phy_struct->cell->FFT_size = LIBLTE_PHY_FFT_SIZE_7_68MHZ;
+                err                        = LIBLTE_SUCCESS;
+            }
+            break;
+        case LIBLTE_PHY_N_SAMPS_PER_SYMB_3_84MHZ:
+            if(LIBLTE_PHY_N_RB_DL_3MHZ   == N_rb_dl ||
+               LIBLTE_PHY_N_RB_DL_1_4MHZ == N_rb_dl)
+            {
+                phy_struct->cell->FFT_size = LIBLTE_PHY_FFT_SIZE_3_84MHZ;
+                err                        = LIBLTE_SUCCESS;
+            }
+            break;
+        case LIBLTE_PHY_N_SAMPS_PER_SYMB_1_92MHZ:
+            if(LIBLTE_PHY_N_RB_DL_1_4MHZ == N_rb_dl)
+            {
+                phy_struct->cell->FFT_size = LIBLTE_PHY_FFT_SIZE_1_92MHZ;
+                err                        = LIBLTE_SUCCESS;
+            }
+            break;
+        }
+
+        if(LIBLTE_SUCCESS == err)
+        {
+            phy_struct->cell->N_rb_dl      = N_rb_dl;
+            phy_struct->cell->N_rb_ul      = N_rb_dl;
+            phy_struct->cell->FFT_pad_size = (phy_struct->cell->FFT_size - used_subcarriers)/2;
+        }
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_set_turbo_decode_n_iter
+
+    Description: Sets the maximum number of turbo decoder iterations.
+                 Decoding stops early once the code block CRC passes.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_set_turbo_decode_n_iter(LIBLTE_PHY_STRUCT *phy_struct,
+                                                     uint32             N_iter)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+
+    if(phy_struct != NULL &&
+       N_iter     >  0    &&
+       N_iter     <= LIBLTE_PHY_TURBO_DECODE_N_ITER_MAX)
+    {
+        phy_struct->td_N_iter = N_iter;
+        if(NULL != phy_struct->cb_pool)
+        {
+            for(i=0; i<phy_struct->cb_pool->N_workers; i++)
+            {
+                phy_struct->cb_pool->worker[i].ws->td_N_iter = N_iter;
+            }
+        }
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_set_dl_channel_estimator
+
+    Description: Selects the channel estimator used by
+                 liblte_phy_get_dl_subframe_and_ce.  POLAR interpolates
+                 magnitude and phase between CRSs, LINEAR and WIENER
+                 interpolate the least squares CRS estimates directly.
+                 When est_noise_var is set, LINEAR and WIENER also
+                 estimate the noise variance of each PRB, which
+                 liblte_phy_pdsch_channel_decode uses to scale the
+                 demapper LLRs.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_set_dl_channel_estimator(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                      LIBLTE_PHY_DL_CE_TYPE_ENUM  ce_type,
+                                                      bool                        est_noise_var)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(phy_struct != NULL                           &&
+       ce_type    <  LIBLTE_PHY_DL_CE_TYPE_N_ITEMS  &&
+       (!est_noise_var                              ||
+        LIBLTE_PHY_DL_CE_TYPE_POLAR != ce_type))
+    {
+        phy_struct->dl_ce_type          = ce_type;
+        phy_struct->dl_ce_est_noise_var = est_noise_var;
+        err                             = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_set_code_block_threads
+
+    Description: Sets the number of threads used to decode the code
+                 blocks of a DLSCH or ULSCH transport block.  The
+                 calling thread decodes alongside N_threads-1 helper
+                 threads, each with its own workspace, and 0 or 1
+                 decodes serially.  Must not be called while the
+                 workspace is decoding.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_set_code_block_threads(LIBLTE_PHY_STRUCT *phy_struct,
+                                                    uint32             N_threads)
+{
+    LIBLTE_PHY_CB_POOL_STRUCT *pool;
+    LIBLTE_ERROR_ENUM          err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32                     i;
+
+    if(phy_struct != NULL &&
+       N_threads  <= LIBLTE_PHY_CODE_BLOCK_THREADS_MAX)
+    {
+        code_block_pool_cleanup(phy_struct);
+
+        if(N_threads > 1)
+        {
+            pool            = (LIBLTE_PHY_CB_POOL_STRUCT *)malloc(sizeof(LIBLTE_PHY_CB_POOL_STRUCT));
+            pool->N_workers = N_threads - 1;
+            pool->job       = NULL;
+            pool->job_id    = 0;
+            pool->N_jobs    = 0;
+            pool->next_job  = 0;
+            pool->N_done    = 0;
+            pool->run       = true;
+            pthread_mutex_init(&pool->mutex, NULL);
+            pthread_cond_init(&pool->start_cond, NULL);
+            pthread_cond_init(&pool->done_cond, NULL);
+            for(i=0; i<pool->N_workers; i++)
+            {
+                pool->worker[i].pool = pool;
+                liblte_phy_init_workspace(phy_struct, &pool->worker[i].ws);
+                pthread_create(&pool->worker[i].thread, NULL, &code_block_decode_thread, &pool->worker[i]);
+            }
+            phy_struct->cb_pool = pool;
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_set_fftw_wisdom_path
+
+    Description: Sets the directory of the FFTW wisdom store.  Wisdom
+                 is imported before and exported after the FFT plans
+                 are created by liblte_phy_init and liblte_phy_ul_init,
+                 in one file per CPU and sample rate.  The directory
+                 must be owned by the user and not writable by group or
+                 others, otherwise the store is disabled.  A NULL or
+                 empty path disables the store.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_set_fftw_wisdom_path(const char *path)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    struct stat       dir_stat;
+
+    // Wisdom steers plan creation, so only trust a directory that no
+    // other user can plant files in
+    FFTW_WISDOM_PATH[0] = '\0';
+    if(NULL == path || '\0' == path[0])
+    {
+        err = LIBLTE_SUCCESS;
+    }else if(strlen(path) < LIBLTE_PHY_FFTW_WISDOM_PATH_MAX &&
+             0            == stat(path, &dir_stat)          &&
+             S_ISDIR(dir_stat.st_mode)                      &&
+             geteuid()    == dir_stat.st_uid                &&
+             0            == (dir_stat.st_mode & (S_IWGRP | S_IWOTH))){
+        strcpy(FFTW_WISDOM_PATH, path);
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_set_default_fftw_wisdom_path
+
+    Description: Sets the directory of the FFTW wisdom store to the
+                 per user cache, $XDG_CACHE_HOME/openlte or
+                 $HOME/.cache/openlte, creating it if needed.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_set_default_fftw_wisdom_path(void)
+{
+    LIBLTE_ERROR_ENUM  err        = LIBLTE_ERROR_INVALID_INPUTS;
+    const char        *cache_home = getenv("XDG_CACHE_HOME");
+    const char        *home       = getenv("HOME");
+    char               cache_path[LIBLTE_PHY_FFTW_WISDOM_PATH_MAX];
+    char               path[LIBLTE_PHY_FFTW_WISDOM_PATH_MAX];
+    int32              N_chars    = -1;
+
+    // XDG requires an absolute cache path, otherwise fall back to HOME
+    if(NULL != cache_home && '/' == cache_home[0])
+    {
+        N_chars = snprintf(cache_path, sizeof(cache_path), "%s", cache_home);
+    }else if(NULL != home && '/' == home[0]){
+        N_chars = snprintf(cache_path, sizeof(cache_path), "%s/.cache", home);
+    }
+
+    FFTW_WISDOM_PATH[0] = '\0';
+    if(N_chars >= 0 && N_chars < (int32)sizeof(cache_path))
+    {
+        N_chars = snprintf(path, sizeof(path), "%s/openlte", cache_path);
+        if(N_chars >= 0 && N_chars < (int32)sizeof(path))
+        {
+            // Existing directories are checked by
+            // liblte_phy_set_fftw_wisdom_path
+            mkdir(cache_path, 0700);
+            mkdir(path, 0700);
+            err = liblte_phy_set_fftw_wisdom_path(path);
+        }
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_set_fftw_planner_time_limit
+
+    Description: Bounds the time FFTW spends measuring each plan that
+                 is not already covered by wisdom.  A negative limit
+                 removes the bound.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_set_fftw_planner_time_limit(float seconds)
+{
+    if(seconds < 0)
+    {
+        fftwf_set_timelimit(FFTW_NO_TIMELIMIT);
+    }else{
+        fftwf_set_timelimit(seconds);
+    }
+
+    return(LIBLTE_SUCCESS);
+}
+
+/*********************************************************************
+    Name: liblte_phy_get_simd
+
+    Description: Returns the instruction set of the DSP kernels in
+                 use, selecting them if this is the first call.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_PHY_SIMD_ENUM liblte_phy_get_simd(void)
+{
+    pthread_once(&PHY_KERNEL_ONCE, phy_kernel_select);
+
+    return(PHY_SIMD);
+}
+
+/*********************************************************************
+    Name: liblte_phy_harq_buffer_reset
+
+    Description: Empties a HARQ soft buffer.  The PDSCH and PUSCH
+                 decoders add each transmission of a transport block
+                 to the soft bits of its HARQ buffer before turbo
+                 decoding, and empty it once the transport block CRC
+                 passes or the transport block size changes.  Callers
+                 reset the buffer when the new data indicator toggles.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1.2
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_harq_buffer_reset(LIBLTE_PHY_HARQ_BUFFER_STRUCT *harq)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(harq != NULL)
+    {
+        // The soft bits are cleared when the next transport block
+        // starts
+        harq->tbs          = 0;
+        harq->N_codeblocks = 0;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_pusch_channel_encode
+
+    Description: Encodes and modulates the Physical Uplink Shared
+                 Channel
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3
+
+    Notes: Only handling normal CP and N_ant=1
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_encode(LIBLTE_PHY_STRUCT            *phy_struct,
+                                                  LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
+                                                  uint32                        N_id_cell,
+                                                  uint8                         N_ant,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT   *subframe)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            j;
+    uint32            k;
+    uint32            p;
+    uint32            L;
+    uint32            idx;
+    uint32            c_init;
+    uint32            N_bits;
+    uint32            M_symb;
+    uint32            M_layer_symb;
+    uint32            M_ap_symb;
+    uint32            M_pusch_sc = alloc->N_prb*phy_struct->cell->N_sc_rb_ul;
+    uint32            Q_m;
+    uint32            N_ul_symb = 7; // FIXME: Only handling normal CP
+
+    if(phy_struct != NULL &&
+       alloc      != NULL &&
+       subframe   != NULL)
+    {
+        // Scratch, allocated on first use
+        if(NULL == phy_struct->ul_scratch)
+        {
+            phy_struct->ul_scratch = (LIBLTE_PHY_UL_SCRATCH_STRUCT *)malloc(sizeof(LIBLTE_PHY_UL_SCRATCH_STRUCT));
+        }
+
+        // Determine Q_m
+        if(LIBLTE_PHY_MODULATION_TYPE_BPSK == alloc->mod_type)
+        {
+            Q_m = 1;
+        }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == alloc->mod_type){
+            Q_m = 2;
+        }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == alloc->mod_type){
+            Q_m = 4;
+        }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == alloc->mod_type
+            Q_m = 6;
+        }
+
+        // Encode the PUSCH
+        ulsch_channel_encode(phy_struct,
+                             alloc->msg.msg,
+                             alloc->msg.N_bits,
+                             alloc->tbs,
+                             alloc->tx_mode,
+                             M_pusch_sc*(N_ul_symb-1)*2*Q_m,
+                             alloc->N_layers,
+                             Q_m,
+                             alloc->rv_idx,
+                             phy_struct->ul_scratch->pusch_encode_bits,
+                             &N_bits);
+        // FIXME: Only handling 1 codeword
+        c_init = (alloc->rnti << 14) | (0 << 13) | (subframe->num << 9) | N_id_cell;
+        generate_prs_c_cached(phy_struct, c_init, N_bits, phy_struct->ul_scratch->pusch_c);
+        for(i=0; i<N_bits; i++)
+        {
+            phy_struct->ul_scratch->pusch_scramb_bits[i] = phy_struct->ul_scratch->pusch_encode_bits[i] ^ phy_struct->ul_scratch->pusch_c[i];
+        }
+        modulation_mapper(phy_struct->ul_scratch->pusch_scramb_bits,
+                          N_bits,
+                          alloc->mod_type,
+                          phy_struct->ul_scratch->pusch_d_re,
+                          phy_struct->ul_scratch->pusch_d_im,
+                          &M_symb);
+        layer_mapper_ul(phy_struct->ul_scratch->pusch_d_re,
+                        phy_struct->ul_scratch->pusch_d_im,
+                        M_symb,
+                        N_ant,
+                        alloc->N_codewords,
+                        phy_struct->ul_scratch->pusch_x_re,
+                        phy_struct->ul_scratch->pusch_x_im,
+                        &M_layer_symb);
+        transform_precoding(phy_struct,
+                            phy_struct->ul_scratch->pusch_x_re,
+                            phy_struct->ul_scratch->pusch_x_im,
+                            M_layer_symb,
+                            alloc->N_prb,
+                            N_ant,
+                            alloc->N_codewords,
+                            phy_struct->ul_scratch->pusch_y_re,
+                            phy_struct->ul_scratch->pusch_y_im);
+        pre_coder_ul(phy_struct->ul_scratch->pusch_y_re,
+                     phy_struct->ul_scratch->pusch_y_im,
+                     M_layer_symb,
+                     N_ant,
+                     alloc->N_layers,
+                     phy_struct->ul_scratch->pusch_z_re[0],
+                     phy_struct->ul_scratch->pusch_z_im[0],
+                     &M_ap_symb);
+
+        // Map to physical resources, in the same order that
+        // liblte_phy_pusch_channel_decode extracts them
+        for(p=0; p<N_ant; p++)
+        {
+            idx = 0;
+            for(L=0; L<14; L++)
+            {
+                for(j=0; j<M_pusch_sc; j++)
+                {
+                    k = alloc->prb[L/7][j/phy_struct->cell->N_sc_rb_ul]*phy_struct->cell->N_sc_rb_ul + (j % phy_struct->cell->N_sc_rb_ul);
+                    if(3 == L)
+                    {
+                        // DMRS 0
+                        subframe->tx_symb_re[p][L][k] = phy_struct->cell->dmrs_0_re[subframe->num][alloc->N_prb][j];
+                        subframe->tx_symb_im[p][L][k] = phy_struct->cell->dmrs_0_im[subframe->num][alloc->N_prb][j];
+                    }else if(10 == L){
+                        // DMRS 1
+                        subframe->tx_symb_re[p][L][k] = phy_struct->cell->dmrs_1_re[subframe->num][alloc->N_prb][j];
+                        subframe->tx_symb_im[p][L][k] = phy_struct->cell->dmrs_1_im[subframe->num][alloc->N_prb][j];
+                    }else{
+                        // PUSCH
+                        subframe->tx_symb_re[p][L][k] = phy_struct->ul_scratch->pusch_z_re[p][idx];
+                        subframe->tx_symb_im[p][L][k] = phy_struct->ul_scratch->pusch_z_im[p][idx];
+                        idx++;
+                    }
+                }
+            }
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_pusch_channel_decode
+
+    Description: Demodulates and decodes the Physical Uplink Shared
+                 Channel, combining with the earlier transmissions in
+                 harq when it is not NULL.  The demapper LLRs are
+                 scaled by the noise variance estimated from the DMRS.
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3
+
+    Notes: Only handles normal CP
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_decode(LIBLTE_PHY_STRUCT             *phy_struct,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT    *subframe,
+                                                  LIBLTE_PHY_ALLOCATION_STRUCT  *alloc,
+                                                  uint32                         N_id_cell,
+                                                  uint8                          N_ant,
+                                                  LIBLTE_PHY_HARQ_BUFFER_STRUCT *harq,
+                                                  uint8                         *out_bits,
+                                                  uint32                        *N_out_bits)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            j;
+    uint32            L;
+    uint32            prb_idx;
+    uint32            z_idx;
+    uint32            c_idx_0;
+    uint32            c_idx_1;
+    uint32            M_layer_symb;
+    uint32            M_symb;
+    uint32            N_bits;
+    uint32            c_init;
+    uint32            Q_m;
+    uint32            M_pusch_sc;
+    float             nv;
+    float             h_sum;
+    float             g_inv;
+
+    if(phy_struct != NULL &&
+       subframe   != NULL &&
+       alloc      != NULL &&
+       out_bits   != NULL &&
+       N_out_bits != NULL &&
+       phy_struct->cell->ul_init)
+    {
+        // Scratch, allocated on first use
+        if(NULL == phy_struct->ul_scratch)
+        {
+            phy_struct->ul_scratch = (LIBLTE_PHY_UL_SCRATCH_STRUCT *)malloc(sizeof(LIBLTE_PHY_UL_SCRATCH_STRUCT));
+        }
+
+        // FIXME: Timing
+
+        // Extract resource elements and construct channel estimate
+        z_idx   = 0;
+        c_idx_0 = 0;
+        c_idx_1 = 0;
+        for(L=0; L<14; L++)
+        {
+            for(prb_idx=0; prb_idx<alloc->N_prb; prb_idx++)
+            {
+                i = alloc->prb[L/7][prb_idx];
+                for(j=0; j<phy_struct->cell->N_sc_rb_ul; j++)
+                {
+                    if(3 == L)
+                    {
+                        phy_struct->ul_scratch->pusch_c_est_0_re[c_idx_0] = subframe->rx_symb_re[L][i*phy_struct->cell->N_sc_rb_ul+j];
+                        phy_struct->ul_scratch->pusch_c_est_0_im[c_idx_0] = subframe->rx_symb_im[L][i*phy_struct->cell->N_sc_rb_ul+j];
+                        c_idx_0++;
+                    }else if(10 == L){
+                        phy_struct->ul_scratch->pusch_c_est_1_re[c_idx_1] = subframe->rx_symb_re[L][i*phy_struct->cell->N_sc_rb_ul+j];
+                        phy_struct->ul_scratch->pusch_c_est_1_im[c_idx_1] = subframe->rx_symb_im[L][i*phy_struct->cell->N_sc_rb_ul+j];
+                        c_idx_1++;
+                    }else{
+                        phy_struct->ul_scratch->pusch_z_est_re[z_idx] = subframe->rx_symb_re[L][i*phy_struct->cell->N_sc_rb_ul+j];
+                        phy_struct->ul_scratch->pusch_z_est_im[z_idx] = subframe->rx_symb_im[L][i*phy_struct->cell->N_sc_rb_ul+j];
+                        z_idx++;
+                    }
+                }
+            }
+        }
+        get_ul_ce(phy_struct,
+                  phy_struct->ul_scratch->pusch_c_est_0_re,
+                  phy_struct->ul_scratch->pusch_c_est_0_im,
+                  phy_struct->ul_scratch->pusch_c_est_1_re,
+                  phy_struct->ul_scratch->pusch_c_est_1_im,
+                  alloc->N_prb,
+                  subframe->num,
+                  phy_struct->ul_scratch->pusch_c_est_re,
+                  phy_struct->ul_scratch->pusch_c_est_im,
+                  &nv);
+        pre_decoder_and_matched_filter_ul(phy_struct->ul_scratch->pusch_z_est_re,
+                                          phy_struct->ul_scratch->pusch_z_est_im,
+                                          phy_struct->ul_scratch->pusch_c_est_re,
+                                          phy_struct->ul_scratch->pusch_c_est_im,
+                                          z_idx,
+                                          N_ant,
+                                          alloc->N_layers,
+                                          phy_struct->ul_scratch->pusch_y_re,
+                                          phy_struct->ul_scratch->pusch_y_im,
+                                          &M_layer_symb);
+        transform_pre_decoding(phy_struct,
+                               phy_struct->ul_scratch->pusch_y_re,
+                               phy_struct->ul_scratch->pusch_y_im,
+                               M_layer_symb,
+                               alloc->N_prb,
+                               N_ant,
+                               alloc->N_codewords,
+                               phy_struct->ul_scratch->pusch_x_re,
+                               phy_struct->ul_scratch->pusch_x_im);
+
+        // The matched filter leaves each SC-FDMA symbol scaled by the
+        // mean channel magnitude across its subcarriers, remove it and
+        // scale the noise variance to match
+        M_pusch_sc = alloc->N_prb*phy_struct->cell->N_sc_rb_ul;
+        for(L=0; L<12; L++)
+        {
+            h_sum = 0;
+            for(j=0; j<M_pusch_sc; j++)
+            {
+                h_sum += sqrt(phy_struct->ul_scratch->pusch_c_est_re[L*M_pusch_sc+j]*phy_struct->ul_scratch->pusch_c_est_re[L*M_pusch_sc+j] +
+                              phy_struct->ul_scratch->pusch_c_est_im[L*M_pusch_sc+j]*phy_struct->ul_scratch->pusch_c_est_im[L*M_pusch_sc+j]);
+            }
+            g_inv = M_pusch_sc/fmaxf(h_sum, FLT_MIN);
+            for(j=0; j<M_pusch_sc; j++)
+            {
+                phy_struct->ul_scratch->pusch_x_re[L*M_pusch_sc+j]      *= g_inv;
+                phy_struct->ul_scratch->pusch_x_im[L*M_pusch_sc+j]      *= g_inv;
+                phy_struct->ul_scratch->pusch_noise_var[L*M_pusch_sc+j]  = nv*g_inv*g_inv;
+            }
+        }
+        layer_demapper_ul(phy_struct->ul_scratch->pusch_x_re,
+                          phy_struct->ul_scratch->pusch_x_im,
+                          M_layer_symb,
+                          N_ant,
+                          alloc->N_codewords,
+                          phy_struct->ul_scratch->pusch_d_re,
+                          phy_struct->ul_scratch->pusch_d_im,
+                          &M_symb);
+        modulation_demapper(phy_struct->ul_scratch->pusch_d_re,
+                            phy_struct->ul_scratch->pusch_d_im,
+                            phy_struct->ul_scratch->pusch_noise_var,
+                            M_symb,
+                            alloc->mod_type,
+                            phy_struct->ul_scratch->pusch_soft_bits,
+                            &N_bits);
+        // FIXME: Only handling 1 codewords
+        c_init = (alloc->rnti << 14) | (0 << 13) | (subframe->num << 9) | N_id_cell;
+        generate_prs_c_cached(phy_struct, c_init, N_bits, phy_struct->ul_scratch->pusch_c);
+        for(i=0; i<N_bits; i++)
+        {
+            phy_struct->ul_scratch->pusch_descramb_bits[i] = (float)phy_struct->ul_scratch->pusch_soft_bits[i]*(1-2*(float)phy_struct->ul_scratch->pusch_c[i]);
+        }
+        if(LIBLTE_PHY_MODULATION_TYPE_BPSK == alloc->mod_type)
+        {
+            Q_m = 1;
+        }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == alloc->mod_type){
+            Q_m = 2;
+        }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == alloc->mod_type){
+            Q_m = 4;
+        }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == alloc->mod_type
+            Q_m = 6;
+        }
+        if(LIBLTE_SUCCESS == ulsch_channel_decode(phy_struct,
+                                                  phy_struct->ul_scratch->pusch_descramb_bits,
+                                                  N_bits,
+                                                  alloc->tbs,
+                                                  alloc->tx_mode,
+                                                  alloc->N_layers,
+                                                  Q_m,
+                                                  alloc->rv_idx,
+                                                  harq,
+                                                  out_bits,
+                                                  N_out_bits))
+        {
+            err = LIBLTE_SUCCESS;
+        }
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_generate_prach
+
+    Description: Generates the baseband signal for a PRACH
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.3
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_generate_prach(LIBLTE_PHY_STRUCT *phy_struct,
+                                            uint32             preamble_idx,
+                                            uint32             freq_offset,
+                                            float             *samps_re,
+                                            float             *samps_im)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            idx;
+    uint32            N_ra_prb;
+    uint32            k_0;
+    uint32            K;
+    uint32            start;
+
+    if(phy_struct != NULL &&
+       samps_re   != NULL &&
+       samps_im   != NULL &&
+       phy_struct->cell->ul_init)
+    {
+        // Calculate PRACH parameters
+        N_ra_prb = freq_offset;
+        k_0      = N_ra_prb*phy_struct->cell->N_sc_rb_ul - phy_struct->cell->N_rb_ul*phy_struct->cell->N_sc_rb_ul/2 + (phy_struct->cell->FFT_size/2);
+        K        = 15000/phy_struct->cell->prach_delta_f_RA;
+
+        for(i=0; i<phy_struct->cell->prach_N_zc; i++)
+        {
+            phy_struct->prach_dft_in[i][0] = phy_struct->cell->prach_x_u_v_re[preamble_idx][i];
+            phy_struct->prach_dft_in[i][1] = phy_struct->cell->prach_x_u_v_im[preamble_idx][i];
+        }
+        fftwf_execute_dft(phy_struct->cell->prach_dft_plan, phy_struct->prach_dft_in, phy_struct->prach_dft_out);
+        for(i=0; i<phy_struct->cell->prach_T_fft; i++)
+        {
+            phy_struct->prach_fft_in[i][0] = 0;
+            phy_struct->prach_fft_in[i][1] = 0;
+        }
+        start = phy_struct->cell->prach_phi + (K*k_0) + (K/2);
+        for(i=0; i<phy_struct->cell->prach_N_zc; i++)
+        {
+            idx                              = (i+start+phy_struct->cell->prach_T_fft/2)%phy_struct->cell->prach_T_fft;
+            phy_struct->prach_fft_in[idx][0] = phy_struct->prach_dft_out[(i+phy_struct->cell->prach_N_zc/2)%phy_struct->cell->prach_N_zc][0];
+            phy_struct->prach_fft_in[idx][1] = phy_struct->prach_dft_out[(i+phy_struct->cell->prach_N_zc/2)%phy_struct->cell->prach_N_zc][1];
+        }
+        fftwf_execute_dft(phy_struct->cell->prach_ifft_plan, phy_struct->prach_fft_in, phy_struct->prach_fft_out);
+        if(phy_struct->cell->prach_T_fft == phy_struct->cell->prach_T_seq)
+        {
+            for(i=0; i<phy_struct->cell->prach_T_fft; i++)
+            {
+                samps_re[phy_struct->cell->prach_T_cp+i] = phy_struct->prach_fft_out[i][0];
+                samps_im[phy_struct->cell->prach_T_cp+i] = phy_struct->prach_fft_out[i][1];
+            }
+        }else{
+            for(i=0; i<phy_struct->cell->prach_T_fft; i++)
+            {
+                samps_re[phy_struct->cell->prach_T_cp+i]                               = phy_struct->prach_fft_out[i][0];
+                samps_im[phy_struct->cell->prach_T_cp+i]                               = phy_struct->prach_fft_out[i][1];
+                samps_re[phy_struct->cell->prach_T_cp+phy_struct->cell->prach_T_fft+i] = phy_struct->prach_fft_out[i][0];
+                samps_im[phy_struct->cell->prach_T_cp+phy_struct->cell->prach_T_fft+i] = phy_struct->prach_fft_out[i][1];
+            }
+        }
+        for(i=0; i<phy_struct->cell->prach_T_cp; i++)
+        {
+            samps_re[i] = samps_re[phy_struct->cell->prach_T_seq+i];
+            samps_im[i] = samps_im[phy_struct->cell->prach_T_seq+i];
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_detect_prach
+
+    Description: Detects PRACHs from baseband I/Q
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.2 and 5.7.3
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_detect_prach(LIBLTE_PHY_STRUCT *phy_struct,
+                                          float             *samps_re,
+                                          float             *samps_im,
+                                          uint32             freq_offset,
+                                          uint32            *N_det_pre,
+                                          uint32            *det_pre,
+                                          uint32            *det_ta,
+                                          float             *det_pwr,
+                                          float             *noise_floor)
+{
+    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_INPUTS;
+    fftwf_complex     *corr;
+    float              abs_corr;
+    float              max_val;
+    float              noise_pwr;
+    float              T_fft_ts;
+    uint32             N_zc;
+    uint32             N_win;
+    uint32             N_ra_prb;
+    uint32             k_0;
+    uint32             K;
+    uint32             start;
+    uint32             idx;
+    uint32             max_offset;
+    uint32             pre;
+    uint32             i;
+
+    if(phy_struct  != NULL &&
+       samps_re    != NULL &&
+       samps_im    != NULL &&
+       N_det_pre   != NULL &&
+       det_pre     != NULL &&
+       det_ta      != NULL &&
+       det_pwr     != NULL &&
+       noise_floor != NULL &&
+       phy_struct->cell->ul_init)
+    {
+        N_zc = phy_struct->cell->prach_N_zc;
+
+        // Calculate PRACH parameters
+        N_ra_prb = freq_offset;
+        k_0      = N_ra_prb*phy_struct->cell->N_sc_rb_ul - phy_struct->cell->N_rb_ul*phy_struct->cell->N_sc_rb_ul/2 + (phy_struct->cell->FFT_size/2);
+        K        = 15000/phy_struct->cell->prach_delta_f_RA;
+
+        // Formats 2 and 3 repeat the sequence, so the two repetitions
+        // are combined before the FFT
+        for(i=0; i<phy_struct->cell->prach_T_fft; i++)
+        {
+            phy_struct->prach_fft_in[i][0] = samps_re[phy_struct->cell->prach_T_cp+i];
+            phy_struct->prach_fft_in[i][1] = samps_im[phy_struct->cell->prach_T_cp+i];
+        }
+        if(phy_struct->cell->prach_T_fft != phy_struct->cell->prach_T_seq)
+        {
+            for(i=0; i<phy_struct->cell->prach_T_fft; i++)
+            {
+                phy_struct->prach_fft_in[i][0] += samps_re[phy_struct->cell->prach_T_cp+phy_struct->cell->prach_T_fft+i];
+                phy_struct->prach_fft_in[i][1] += samps_im[phy_struct->cell->prach_T_cp+phy_struct->cell->prach_T_fft+i];
+            }
+        }
+        fftwf_execute_dft(phy_struct->cell->prach_fft_plan, phy_struct->prach_fft_in, phy_struct->prach_fft_out);
+        start = phy_struct->cell->prach_phi + (K*k_0) + (K/2);
+        for(i=0; i<N_zc; i++)
+        {
+            idx                           = (i+start+phy_struct->cell->prach_T_fft/2)%phy_struct->cell->prach_T_fft;
+            phy_struct->prach_x_hat_re[i] = phy_struct->prach_fft_out[idx][0];
+            phy_struct->prach_x_hat_im[i] = phy_struct->prach_fft_out[idx][1];
+        }
+
+        // Correlate with all roots at once
+        prach_corr_mult(phy_struct);
+        fftwf_execute_dft(phy_struct->cell->prach_corr_plan, phy_struct->prach_corr_in, phy_struct->prach_corr_out);
+
+        // Noise floor is the mean correlation power over all roots
+        noise_pwr = 0;
+        for(i=0; i<phy_struct->cell->prach_N_x_u*N_zc; i++)
+        {
+            noise_pwr += (phy_struct->prach_corr_out[i][0]*phy_struct->prach_corr_out[i][0] +
+                          phy_struct->prach_corr_out[i][1]*phy_struct->prach_corr_out[i][1]);
+        }
+        noise_pwr /= phy_struct->cell->prach_N_x_u*N_zc;
+
+        // Search the cyclic shift window of each preamble, a preamble
+        // with cyclic shift C_v received d correlation samples late
+        // peaks at C_v - d
+        if(0 == phy_struct->cell->prach_N_cs)
+        {
+            N_win = N_zc;
+        }else{
+            N_win = phy_struct->cell->prach_N_cs;
+        }
+        T_fft_ts   = phy_struct->cell->prach_T_fft*(30720000/phy_struct->cell->fs);
+        *N_det_pre = 0;
+        for(pre=0; pre<64; pre++)
+        {
+            corr       = &phy_struct->prach_corr_out[phy_struct->cell->prach_pre_root[pre]*N_zc];
+            max_val    = 0;
+            max_offset = 0;
+            for(i=0; i<N_win; i++)
+            {
+                idx      = (phy_struct->cell->prach_pre_C_v[pre] + N_zc - i) % N_zc;
+                abs_corr = corr[idx][0]*corr[idx][0] + corr[idx][1]*corr[idx][1];
+                if(abs_corr > max_val)
+                {
+                    max_val    = abs_corr;
+                    max_offset = i;
+                }
+            }
+
+            // A peak on the last sample of the window that is smaller
+            // than the first sample of the next window is leakage from
+            // the preamble using that window
+            if(N_win != N_zc &&
+               max_offset == (N_win - 1))
+            {
+                idx = (phy_struct->cell->prach_pre_C_v[pre] + N_zc - N_win) % N_zc;
+                if((corr[idx][0]*corr[idx][0] + corr[idx][1]*corr[idx][1]) > max_val)
+                {
+                    max_val = 0;
+                }
+            }
+
+            if(max_val >= PRACH_DETECT_THRESH*noise_pwr &&
+               max_val != 0)
+            {
+                // Timing advance is in units of 16 T_s
+                det_pre[*N_det_pre] = pre;
+                det_ta[*N_det_pre]  = (uint32)((max_offset*T_fft_ts)/(16*N_zc) + 0.5);
+                det_pwr[*N_det_pre] = max_val;
+                (*N_det_pre)++;
+            }
+        }
+        *noise_floor = noise_pwr;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_pdsch_channel_encode
+
+    Description: Encodes and modulates the Physical Downlink Shared
+                 Channel
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3 and 6.4
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                  LIBLTE_PHY_PDCCH_STRUCT    *pdcch,
+                                                  uint32                      N_id_cell,
+                                                  uint8                       N_ant,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            j;
+    uint32            p;
+    uint32            L;
+    uint32            idx;
+    uint32            alloc_idx;
+    uint32            prb_idx;
+    uint32            c_init;
+    uint32            N_bits_tot;
+    uint32            N_bits;
+    uint32            M_symb;
+    uint32            M_layer_symb;
+    uint32            M_ap_symb;
+    uint32            first_sc;
+    uint32            last_sc;
+    uint32            Q_m;
+
+    if(phy_struct != NULL &&
+       pdcch      != NULL &&
+       N_id_cell  >= 0    &&
+       N_id_cell  <= 503  &&
+       subframe   != NULL)
+    {
+        // Scratch, allocated on first use
+        if(NULL == phy_struct->dl_scratch)
+        {
+            phy_struct->dl_scratch = (LIBLTE_PHY_DL_SCRATCH_STRUCT *)malloc(sizeof(LIBLTE_PHY_DL_SCRATCH_STRUCT));
+        }
+
+        // Determine first and last PBCH, PSS, and SSS subcarriers
+        if(phy_struct->cell->N_rb_dl == 6)
+        {
+            first_sc = 0;
+            last_sc  = (6*phy_struct->cell->N_sc_rb_dl)-1;
+        }else if(phy_struct->cell->N_rb_dl == 15){
+            first_sc = (4*phy_struct->cell->N_sc_rb_dl)+6;
+            last_sc  = (11*phy_struct->cell->N_sc_rb_dl)-7;
+        }else if(phy_struct->cell->N_rb_dl == 25){
+            first_sc = (9*phy_struct->cell->N_sc_rb_dl)+6;
+            last_sc  = (16*phy_struct->cell->N_sc_rb_dl)-7;
+        }else if(phy_struct->cell->N_rb_dl == 50){
+            first_sc = 22*phy_struct->cell->N_sc_rb_dl;
+            last_sc  = (28*phy_struct->cell->N_sc_rb_dl)-1;
+        }else if(phy_struct->cell->N_rb_dl == 75){
+            first_sc = (34*phy_struct->cell->N_sc_rb_dl)+6;
+            last_sc  = (41*phy_struct->cell->N_sc_rb_dl)-7;
+        }else{ // phy_struct->cell->N_rb_dl == 100
+            first_sc = 47*phy_struct->cell->N_sc_rb_dl;
+            last_sc  = (53*phy_struct->cell->N_sc_rb_dl)-1;
+        }
+
+        for(alloc_idx=0; alloc_idx<pdcch->N_alloc; alloc_idx++)
+        {
+            if(pdcch->alloc[alloc_idx].chan_type == LIBLTE_PHY_CHAN_TYPE_DLSCH)
+            {
+                // Determine the number of bits available for transmission
+                N_bits_tot = 0;
+                for(i=0; i<pdcch->alloc[alloc_idx].N_prb; i++)
+                {
+                    N_bits_tot += get_num_bits_in_prb(subframe->num,
+                                                      pdcch->N_symbs,
+                                                      pdcch->alloc[alloc_idx].prb[0][i],
+                                                      phy_struct->cell->N_rb_dl,
+                                                      N_ant,
+                                                      pdcch->alloc[alloc_idx].mod_type);
+                }
+                // Determine Q_m
+                if(LIBLTE_PHY_MODULATION_TYPE_BPSK == pdcch->alloc[alloc_idx].mod_type)
+                {
+                    Q_m = 1;
+                }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == pdcch->alloc[alloc_idx].mod_type){
+                    Q_m = 2;
+                }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == pdcch->alloc[alloc_idx].mod_type){
+                    Q_m = 4;
+                }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == pdcch->alloc[alloc_idx].mod_type
+                    Q_m = 6;
+                }
+                // Encode the PDSCH
+                dlsch_channel_encode(phy_struct,
+                                     pdcch->alloc[alloc_idx].msg.msg,
+                                     pdcch->alloc[alloc_idx].msg.N_bits,
+                                     pdcch->alloc[alloc_idx].tbs,
+                                     pdcch->alloc[alloc_idx].tx_mode,
+                                     pdcch->alloc[alloc_idx].rv_idx,
+                                     N_bits_tot,
+                                     2,
+                                     Q_m,
+                                     8,
+                                     250368,
+                                     phy_struct->dl_scratch->pdsch_encode_bits,
+                                     &N_bits);
+                // FIXME: Only handling 1 codeword
+                c_init = (pdcch->alloc[alloc_idx].rnti << 14) | (0 << 13) | (subframe->num << 9) | N_id_cell;
+                generate_prs_c_cached(phy_struct, c_init, N_bits, phy_struct->dl_scratch->pdsch_c);
+                for(i=0; i<N_bits; i++)
+                {
+                    phy_struct->dl_scratch->pdsch_scramb_bits[i] = phy_struct->dl_scratch->pdsch_encode_bits[i] ^ phy_struct->dl_scratch->pdsch_c[i];
+                }
+                modulation_mapper(phy_struct->dl_scratch->pdsch_scramb_bits,
+                                  N_bits,
+                                  pdcch->alloc[alloc_idx].mod_type,
+                                  phy_struct->dl_scratch->pdsch_d_re,
+                                  phy_struct->dl_scratch->pdsch_d_im,
+                                  &M_symb);
+                layer_mapper_dl(phy_struct->dl_scratch->pdsch_d_re,
+                                phy_struct->dl_scratch->pdsch_d_im,
+                                M_symb,
+                                N_ant,
+                                1,
+                                pdcch->alloc[alloc_idx].pre_coder_type,
+                                phy_struct->dl_scratch->pdsch_x_re,
+                                phy_struct->dl_scratch->pdsch_x_im,
+                                &M_layer_symb);
+                pre_coder_dl(phy_struct->dl_scratch->pdsch_x_re,
+                             phy_struct->dl_scratch->pdsch_x_im,
+                             M_layer_symb,
+                             N_ant,
+                             pdcch->alloc[alloc_idx].pre_coder_type,
+                             phy_struct->dl_scratch->pdsch_y_re[0],
+                             phy_struct->dl_scratch->pdsch_y_im[0],
+                             15600,
+                             &M_ap_symb);
+
+                // Map the symbols to resource elements 3GPP TS 36.211 v10.1.0 section 6.3.5
+                for(p=0; p<N_ant; p++)
+                {
+                    idx = 0;
+                    for(L=pdcch->N_symbs; L<14; L++)
+                    {
+                        for(prb_idx=0; prb_idx<pdcch->alloc[alloc_idx].N_prb; prb_idx++)
+                        {
+                            i = pdcch->alloc[alloc_idx].prb[L/7][prb_idx];
+                            for(j=0; j<phy_struct->cell->N_sc_rb_dl; j++)
+                            {
+                                if(N_ant           == 1 &&
+                                   (L % 7)         == 0 &&
+                                   (N_id_cell % 6) == (j % 6))
+                                {
+                                    // Skip CRS
+                                }else if(N_ant               == 1 &&
+                                         (L % 7)             == 4 &&
+                                         ((N_id_cell+3) % 6) == (j % 6)){
+                                    // Skip CRS
+                                }else if((N_ant          == 2  ||
+                                          N_ant          == 4) &&
+                                         ((L % 7)        == 0  ||
+                                          (L % 7)        == 4) &&
+                                         (N_id_cell % 3) == (j % 3)){
+                                    // Skip CRS
+                                }else if(N_ant           == 4 &&
+                                         (L % 7)         == 1 &&
+                                         (N_id_cell % 3) == (j % 3)){
+                                    // Skip CRS
+                                }else if(subframe->num                == 0        &&
+                                         (i*phy_struct->cell->N_sc_rb_dl+j) >= first_sc &&
+                                         (i*phy_struct->cell->N_sc_rb_dl+j) <= last_sc  &&
+                                         L                            >= 7        &&
+                                         L                            <= 10){
+                                    // Skip PBCH
+                                }else if((subframe->num               == 0        ||
+                                          subframe->num               == 5)       &&
+                                         (i*phy_struct->cell->N_sc_rb_dl+j) >= first_sc &&
+                                         (i*phy_struct->cell->N_sc_rb_dl+j) <= last_sc  &&
+                                         L                            == 6){
+                                    // Skip PSS
+                                }else if((subframe->num               == 0        ||
+                                          subframe->num               == 5)       &&
+                                         (i*phy_struct->cell->N_sc_rb_dl+j) >= first_sc &&
+                                         (i*phy_struct->cell->N_sc_rb_dl+j) <= last_sc  &&
+                                         L                            == 5){
+                                    // Skip SSS
+                                }else{
+                                    subframe->tx_symb_re[p][L][i*phy_struct->cell->N_sc_rb_dl+j] = phy_struct->dl_scratch->pdsch_y_re[p][idx];
+                                    subframe->tx_symb_im[p][L][i*phy_struct->cell->N_sc_rb_dl+j] = phy_struct->dl_scratch->pdsch_y_im[p][idx];
+                                    idx++;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_pdsch_channel_decode
+
+    Description: Demodulates and decodes the Physical Downlink Shared
+                 Channel, combining with the earlier transmissions in
+                 harq when it is not NULL
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3 and 6.4
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_decode(LIBLTE_PHY_STRUCT             *phy_struct,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT    *subframe,
+                                                  LIBLTE_PHY_ALLOCATION_STRUCT  *alloc,
+                                                  uint32                         N_pdcch_symbs,
+                                                  uint32                         N_id_cell,
+                                                  uint8                          N_ant,
+                                                  LIBLTE_PHY_HARQ_BUFFER_STRUCT *harq,
+                                                  uint8                         *out_bits,
+                                                  uint32                        *N_out_bits)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            j;
+    uint32            p;
+    uint32            L;
+    uint32            prb_idx;
+    uint32            idx;
+    uint32            c_init;
+    uint32            M_layer_symb;
+    uint32            M_symb;
+    uint32            N_bits;
+    uint32            Q_m;
+    uint32            first_sc;
+    uint32            last_sc;
+    float             h_pow;
+    bool              use_noise_var;
+
+    if(phy_struct != NULL &&
+       subframe   != NULL &&
+       N_id_cell  >= 0    &&
+       N_id_cell  <= 503  &&
+       out_bits   != NULL &&
+       N_out_bits != NULL)
+    {
+        // Scratch, allocated on first use
+        if(NULL == phy_struct->dl_scratch)
+        {
+            phy_struct->dl_scratch = (LIBLTE_PHY_DL_SCRATCH_STRUCT *)malloc(sizeof(LIBLTE_PHY_DL_SCRATCH_STRUCT));
+        }
+
+        err = LIBLTE_ERROR_DECODE_FAIL;
+
+        // Per RE noise variances are only derived for a single
+        // antenna, transmit diversity keeps the default LLR scaling
+        use_noise_var = (1 == N_ant && subframe->rx_noise_var_valid);
+
+        // Determine first and last PBCH, PSS, and SSS subcarriers
+        if(phy_struct->cell->N_rb_dl == 6)
+        {
+            first_sc = 0;
+            last_sc  = (6*phy_struct->cell->N_sc_rb_dl)-1;
+        }else if(phy_struct->cell->N_rb_dl == 15){
+            first_sc = (4*phy_struct->cell->N_sc_rb_dl)+6;
+            last_sc  = (11*phy_struct->cell->N_sc_rb_dl)-7;
+        }else if(phy_struct->cell->N_rb_dl == 25){
+            first_sc = (9*phy_struct->cell->N_sc_rb_dl)+6;
+            last_sc  = (16*phy_struct->cell->N_sc_rb_dl)-7;
+        }else if(phy_struct->cell->N_rb_dl == 50){
+            first_sc = 22*phy_struct->cell->N_sc_rb_dl;
+            last_sc  = (28*phy_struct->cell->N_sc_rb_dl)-1;
+        }else if(phy_struct->cell->N_rb_dl == 75){
+            first_sc = (34*phy_struct->cell->N_sc_rb_dl)+6;
+            last_sc  = (41*phy_struct->cell->N_sc_rb_dl)-7;
+        }else{ // phy_struct->cell->N_rb_dl == 100
+            first_sc = 47*phy_struct->cell->N_sc_rb_dl;
+            last_sc  = (53*phy_struct->cell->N_sc_rb_dl)-1;
+        }
+
+        // Extract resource elements and channel estimate 3GPP TS 36.211 v10.1.0 section 6.3.5
+        idx = 0;
+        for(L=N_pdcch_symbs; L<14; L++)
+        {
+            for(prb_idx=0; prb_idx<alloc->N_prb; prb_idx++)
+            {
+                i = alloc->prb[L/7][prb_idx];
+                for(j=0; j<phy_struct->cell->N_sc_rb_dl; j++)
+                {
+                    if(N_ant           == 1 &&
+                       (L % 7)         == 0 &&
+                       (N_id_cell % 6) == (j % 6))
+                    {
+                        // Skip CRS
+                    }else if(N_ant               == 1 &&
+                             (L % 7)             == 4 &&
+                             ((N_id_cell+3) % 6) == (j % 6)){
+                        // Skip CRS
+                    }else if((N_ant          == 2  ||
+                              N_ant          == 4) &&
+                             ((L % 7)        == 0  ||
+                              (L % 7)        == 4) &&
+                             (N_id_cell % 3) == (j % 3)){
+                        // Skip CRS
+                    }else if(N_ant           == 4 &&
+                             (L % 7)         == 1 &&
+                             (N_id_cell % 3) == (j % 3)){
+                        // Skip CRS
+                    }else if(subframe->num                == 0        &&
+                             (i*phy_struct->cell->N_sc_rb_dl+j) >= first_sc &&
+                             (i*phy_struct->cell->N_sc_rb_dl+j) <= last_sc  &&
+                             L                            >= 7        &&
+                             L                            <= 10){
+                        // Skip PBCH
+                    }else if((subframe->num               == 0        ||
+                              subframe->num               == 5)       &&
+                             (i*phy_struct->cell->N_sc_rb_dl+j) >= first_sc &&
+                             (i*phy_struct->cell->N_sc_rb_dl+j) <= last_sc  &&
+                             L                            == 6){
+                        // Skip PSS
+                    }else if((subframe->num               == 0        ||
+                              subframe->num               == 5)       &&
+                             (i*phy_struct->cell->N_sc_rb_dl+j) >= first_sc &&
+                             (i*phy_struct->cell->N_sc_rb_dl+j) <= last_sc  &&
+                             L                            == 5){
+                        // Skip SSS
+                    }else{
+                        phy_struct->dl_scratch->pdsch_y_est_re[idx] = subframe->rx_symb_re[L][i*phy_struct->cell->N_sc_rb_dl+j];
+                        phy_struct->dl_scratch->pdsch_y_est_im[idx] = subframe->rx_symb_im[L][i*phy_struct->cell->N_sc_rb_dl+j];
+                        for(p=0; p<N_ant; p++)
+                        {
+                            phy_struct->dl_scratch->pdsch_c_est_re[p][idx] = subframe->rx_ce_re[p][L][i*phy_struct->cell->N_sc_rb_dl+j];
+                            phy_struct->dl_scratch->pdsch_c_est_im[p][idx] = subframe->rx_ce_im[p][L][i*phy_struct->cell->N_sc_rb_dl+j];
+                        }
+                        if(use_noise_var)
+                        {
+                            // The matched filter divides the noise variance by |h|^2
+                            h_pow                            = (phy_struct->dl_scratch->pdsch_c_est_re[0][idx]*phy_struct->dl_scratch->pdsch_c_est_re[0][idx] +
+                                                                phy_struct->dl_scratch->pdsch_c_est_im[0][idx]*phy_struct->dl_scratch->pdsch_c_est_im[0][idx]);
+                            phy_struct->dl_scratch->pdsch_noise_var[idx] = subframe->rx_noise_var[i]/fmaxf(h_pow, FLT_MIN);
+                        }
+                        idx++;
+                    }
+                }
+            }
+        }
+
+        pre_decoder_and_matched_filter_dl(phy_struct->dl_scratch->pdsch_y_est_re,
+                                          phy_struct->dl_scratch->pdsch_y_est_im,
+                                          phy_struct->dl_scratch->pdsch_c_est_re[0],
+                                          phy_struct->dl_scratch->pdsch_c_est_im[0],
+                                          15600,
+                                          idx,
+                                          N_ant,
+                                          alloc->pre_coder_type,
+                                          phy_struct->dl_scratch->pdsch_x_re,
+                                          phy_struct->dl_scratch->pdsch_x_im,
+                                          &M_layer_symb);
+        layer_demapper_dl(phy_struct->dl_scratch->pdsch_x_re,
+                          phy_struct->dl_scratch->pdsch_x_im,
+                          M_layer_symb,
+                          N_ant,
+                          alloc->N_codewords,
+                          alloc->pre_coder_type,
+                          phy_struct->dl_scratch->pdsch_d_re,
+                          phy_struct->dl_scratch->pdsch_d_im,
+                          &M_symb);
+        modulation_demapper(phy_struct->dl_scratch->pdsch_d_re,
+                            phy_struct->dl_scratch->pdsch_d_im,
+                            use_noise_var ? phy_struct->dl_scratch->pdsch_noise_var : NULL,
+                            M_symb,
+                            alloc->mod_type,
+                            phy_struct->dl_scratch->pdsch_soft_bits,
+                            &N_bits);
+        // FIXME: Only handling 1 codeword
+        c_init = (alloc->rnti << 14) | (0 << 13) | (subframe->num << 9) | N_id_cell;
+        generate_prs_c_cached(phy_struct, c_init, N_bits, phy_struct->dl_scratch->pdsch_c);
+        for(i=0; i<N_bits; i++)
+        {
+            phy_struct->dl_scratch->pdsch_descramb_bits[i] = (float)phy_struct->dl_scratch->pdsch_soft_bits[i]*(1-2*(float)phy_struct->dl_scratch->pdsch_c[i]);
+        }
+        if(LIBLTE_PHY_MODULATION_TYPE_BPSK == alloc->mod_type)
+        {
+            Q_m = 1;
+        }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == alloc->mod_type){
+            Q_m = 2;
+        }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == alloc->mod_type){
+            Q_m = 4;
+        }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == alloc->mod_type
+            Q_m = 6;
+        }
+        if(LIBLTE_SUCCESS == dlsch_channel_decode(phy_struct,
+                                                  phy_struct->dl_scratch->pdsch_descramb_bits,
+                                                  N_bits,
+                                                  alloc->tbs,
+                                                  alloc->tx_mode,
+                                                  alloc->rv_idx,
+                                                  2,
+                                                  Q_m,
+                                                  8,
+                                                  250368, // FIXME: Using N_soft from a cat 1 UE (3GPP TS 36.306)
+                                                  harq,
+                                                  out_bits,
+                                                  N_out_bits))
+        {
+            err = LIBLTE_SUCCESS;
+        }
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_bch_channel_encode
+
+    Description: Encodes and modulates the Physical Broadcast
+                 Channel
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.6
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_bch_channel_encode(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                uint8                      *in_bits,
+                                                uint32                      N_in_bits,
+                                                uint32                      N_id_cell,
+                                                uint8                       N_ant,
+                                                LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                                uint32                      sfn)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            k;
+    uint32            p;
+    uint32            offset;
+    uint32            idx;
+    uint32            M_symb;
+    uint32            M_layer_symb;
+    uint32            M_ap_symb;
+
+    if(phy_struct != NULL &&
+       in_bits    != NULL &&
+       N_id_cell  >= 0    &&
+       N_id_cell  <= 503  &&
+       subframe   != NULL)
+    {
+        // Encode the bits to symbols
+        if(0 == phy_struct->bch_N_bits)
+        {
+            bch_channel_encode(phy_struct,
+                               in_bits,
+                               N_in_bits,
+                               N_ant,
+                               phy_struct->bch_encode_bits,
+                               &phy_struct->bch_N_bits);
+            generate_prs_c_cached(phy_struct, N_id_cell, phy_struct->bch_N_bits, phy_struct->bch_c);
+        }
+        for(i=0; i<480; i++)
+        {
+            offset                         = (sfn % 4)*480;
+            phy_struct->bch_scramb_bits[i] = phy_struct->bch_encode_bits[offset+i] ^ phy_struct->bch_c[offset + i];
+        }
+        if(3 == (sfn % 4))
+        {
+            phy_struct->bch_N_bits = 0;
+        }
+        modulation_mapper(phy_struct->bch_scramb_bits,
+                          480,
+                          LIBLTE_PHY_MODULATION_TYPE_QPSK,
+                          phy_struct->bch_d_re,
+                          phy_struct->bch_d_im,
+                          &M_symb);
+        layer_mapper_dl(phy_struct->bch_d_re,
+                        phy_struct->bch_d_im,
+                        M_symb,
+                        N_ant,
+                        1,
+                        LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                        phy_struct->bch_x_re,
+                        phy_struct->bch_x_im,
+                        &M_layer_symb);
+        pre_coder_dl(phy_struct->bch_x_re,
+                     phy_struct->bch_x_im,
+                     M_layer_symb,
+                     N_ant,
+                     LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                     phy_struct->bch_y_re[0],
+                     phy_struct->bch_y_im[0],
+                     240,
+                     &M_ap_symb);
+
+        // Map the symbols to resource elements
+        idx = 0;
+        for(p=0; p<N_ant; p++)
+        {
+            for(i=0; i<72; i++)
+            {
+                k = (phy_struct->cell->N_rb_dl*phy_struct->cell->N_sc_rb_dl)/2 - 36 + i;
+                if((N_id_cell % 3) != (i % 3))
+                {
+                    subframe->tx_symb_re[p][7][k] = phy_struct->bch_y_re[p][idx];
+                    subframe->tx_symb_im[p][7][k] = phy_struct->bch_y_im[p][idx];
+                    subframe->tx_symb_re[p][8][k] = phy_struct->bch_y_re[p][idx+48];
+                    subframe->tx_symb_im[p][8][k] = phy_struct->bch_y_im[p][idx+48];
+                    idx++;
+                }
+                subframe->tx_symb_re[p][9][k]  = phy_struct->bch_y_re[p][i+96];
+                subframe->tx_symb_im[p][9][k]  = phy_struct->bch_y_im[p][i+96];
+                subframe->tx_symb_re[p][10][k] = phy_struct->bch_y_re[p][i+168];
+                subframe->tx_symb_im[p][10][k] = phy_struct->bch_y_im[p][i+168];
+            }
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_bch_channel_decode
+
+    Description: Demodulates and decodes the Physical Broadcast
+                 Channel
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.6
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_bch_channel_decode(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                                uint32                      N_id_cell,
+                                                uint8                      *N_ant,
+                                                uint8                      *out_bits,
+                                                uint32                     *N_out_bits,
+                                                uint8                      *offset)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            j;
+    uint32            p;
+    uint32            in_idx;
+    uint32            idx;
+    uint32            M_layer_symb;
+    uint32            M_symb;
+    uint32            N_bits;
+
+    if(phy_struct != NULL &&
+       subframe   != NULL &&
+       N_id_cell  >= 0    &&
+       N_id_cell  <= 503  &&
+       N_ant      != NULL &&
+       out_bits   != NULL &&
+       N_out_bits != NULL &&
+       offset     != NULL)
+    {
+        err = LIBLTE_ERROR_DECODE_FAIL;
+
+        // Unmap PBCH and channel estimates from resource elements
+        idx = 0;
+        for(i=0; i<72; i++)
+        {
+            in_idx = phy_struct->cell->N_sc_rb_dl*phy_struct->cell->N_rb_dl/2 - 36 + i;
+            if((N_id_cell % 3) != (i % 3))
+            {
+                phy_struct->bch_y_est_re[idx]    = subframe->rx_symb_re[7][in_idx];
+                phy_struct->bch_y_est_im[idx]    = subframe->rx_symb_im[7][in_idx];
+                phy_struct->bch_y_est_re[idx+48] = subframe->rx_symb_re[8][in_idx];
+                phy_struct->bch_y_est_im[idx+48] = subframe->rx_symb_im[8][in_idx];
+                for(p=0; p<4; p++)
+                {
+                    phy_struct->bch_c_est_re[p][idx]    = subframe->rx_ce_re[p][7][in_idx];
+                    phy_struct->bch_c_est_im[p][idx]    = subframe->rx_ce_im[p][7][in_idx];
+                    phy_struct->bch_c_est_re[p][idx+48] = subframe->rx_ce_re[p][8][in_idx];
+                    phy_struct->bch_c_est_im[p][idx+48] = subframe->rx_ce_im[p][8][in_idx];
+                }
+                idx++;
+            }
+            phy_struct->bch_y_est_re[i+96]  = subframe->rx_symb_re[9][in_idx];
+            phy_struct->bch_y_est_im[i+96]  = subframe->rx_symb_im[9][in_idx];
+            phy_struct->bch_y_est_re[i+168] = subframe->rx_symb_re[10][in_idx];
+            phy_struct->bch_y_est_im[i+168] = subframe->rx_symb_im[10][in_idx];
+            for(p=0; p<4; p++)
+            {
+                phy_struct->bch_c_est_re[p][i+96]  = subframe->rx_ce_re[p][9][in_idx];
+                phy_struct->bch_c_est_im[p][i+96]  = subframe->rx_ce_im[p][9][in_idx];
+                phy_struct->bch_c_est_re[p][i+168] = subframe->rx_ce_re[p][10][in_idx];
+                phy_struct->bch_c_est_im[p][i+168] = subframe->rx_ce_im[p][10][in_idx];
+            }
+        }
+
+        // Generate the scrambling sequence
+        generate_prs_c_cached(phy_struct, N_id_cell, 1920, phy_struct->bch_c);
+
+        // Try decoding with 1, 2, and 4 antennas
+        for(p=1; p<5; p++)
+        {
+            if(p != 3)
+            {
+                pre_decoder_and_matched_filter_dl(phy_struct->bch_y_est_re,
+                                                  phy_struct->bch_y_est_im,
+                                                  phy_struct->bch_c_est_re[0],
+                                                  phy_struct->bch_c_est_im[0],
+                                                  240,
+                                                  240,
+                                                  p,
+                                                  LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                                                  phy_struct->bch_x_re,
+                                                  phy_struct->bch_x_im,
+                                                  &M_layer_symb);
+                layer_demapper_dl(phy_struct->bch_x_re,
+                                  phy_struct->bch_x_im,
+                                  M_layer_symb,
+                                  p,
+                                  1,
+                                  LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                                  phy_struct->bch_d_re,
+                                  phy_struct->bch_d_im,
+                                  &M_symb);
+                modulation_demapper(phy_struct->bch_d_re,
+                                    phy_struct->bch_d_im,
+                                    NULL,
+                                    M_symb,
+                                    LIBLTE_PHY_MODULATION_TYPE_QPSK,
+                                    phy_struct->bch_soft_bits,
+                                    &N_bits);
+
+                // Try decoding at each offset
+                *N_ant = 0;
+                for(i=0; i<4; i++)
+                {
+                    for(j=0; j<1920; j++)
+                    {
+                        phy_struct->bch_descramb_bits[j] = RX_NULL_BIT;
+                    }
+                    for(j=0; j<480; j++)
+                    {
+                        phy_struct->bch_descramb_bits[(i*480)+j] = (float)phy_struct->bch_soft_bits[j]*(1-2*(float)phy_struct->bch_c[(i*480)+j]);
+                    }
+                    if(LIBLTE_SUCCESS == bch_channel_decode(phy_struct,
+                                                            phy_struct->bch_descramb_bits,
+                                                            1920,
+                                                            N_ant,
+                                                            out_bits,
+                                                            N_out_bits))
+                    {
+                        *offset = i;
+                        break;
+                    }
+                }
+                if(*N_ant != 0)
+                {
+                    err = LIBLTE_SUCCESS;
+                    break;
+                }
+            }
+        }
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_pdcch_channel_encode
+
+    Description: Encodes and modulates all of the Physical Downlink
+                 Control Channels (PCFICH, PHICH, and PDCCH)
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.7, 6.8, and
+                        6.9
+                        3GPP TS 36.212 v10.1.0 section 5.1.4.2.1
+                        3GPP TS 36.213 v10.3.0 section 7.1 and 9.1.1
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT              *phy_struct,
+                                                  LIBLTE_PHY_PCFICH_STRUCT       *pcfich,
+                                                  LIBLTE_PHY_PHICH_STRUCT        *phich,
+                                                  LIBLTE_PHY_PDCCH_STRUCT        *pdcch,
+                                                  uint32                          N_id_cell,
+                                                  uint8                           N_ant,
+                                                  float                           phich_res,
+                                                  LIBLTE_RRC_PHICH_DURATION_ENUM  phich_dur,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT     *subframe)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            j;
+    uint32            k;
+    uint32            p;
+    uint32            idx;
+    uint32            a_idx;
+    uint32            css_idx;
+    uint32            uss_idx;
+    uint32            actual_idx;
+    uint32            c_init;
+    uint32            N_bits;
+    uint32            M_symb;
+    uint32            M_layer_symb;
+    uint32            M_ap_symb;
+    uint32            N_reg_rb;
+    uint32            N_reg_pdcch;
+    uint32            N_cce_pdcch;
+    uint32            N_reg_cce;
+    uint32            dci_size;
+    uint32            N_dummy;
+    uint32            C_cc_sb;
+    uint32            R_cc_sb;
+    uint32            K_pi;
+    uint32            shift_idx;
+    uint32            k_prime;
+    uint32            l_prime;
+    uint32            m_prime;
+    uint32            Y_k;
+    bool              valid_reg;
+
+    if(phy_struct != NULL &&
+       pcfich     != NULL &&
+       phich      != NULL &&
+       pdcch      != NULL &&
+       N_id_cell  >= 0    &&
+       N_id_cell  <= 503  &&
+       subframe   != NULL)
+    {
+        // Scratch, allocated on first use
+        if(NULL == phy_struct->pdcch_scratch)
+        {
+            phy_struct->pdcch_scratch = (LIBLTE_PHY_PDCCH_SCRATCH_STRUCT *)malloc(sizeof(LIBLTE_PHY_PDCCH_SCRATCH_STRUCT));
+        }
+
+        // PCFICH
+        pcfich_channel_map(phy_struct, pcfich, N_id_cell, N_ant, subframe);
+
+        // PHICH
+        phich_channel_map(phy_struct, phich, pcfich, N_id_cell, N_ant, phich_res, phich_dur, subframe);
+
+        // PDCCH
+        if(pdcch->N_alloc != 0)
+        {
+            // Calculate number of symbols, 3GPP TS 36.211 v10.1.0 section 6.7
+            pdcch->N_symbs = pcfich->cfi;
+            if(phy_struct->cell->N_rb_dl <= 10)
+            {
+                pdcch->N_symbs++;
+            }
+            // Calculate resources, 3GPP TS 36.211 v10.1.0 section 6.8.1
+            N_reg_rb    = 3;
+            N_reg_cce   = 9;
+            N_reg_pdcch = pdcch->N_symbs*(phy_struct->cell->N_rb_dl*N_reg_rb) - phy_struct->cell->N_rb_dl - pcfich->N_reg - phich->N_reg;
+            if(N_ant          == 4 &&
+               pdcch->N_symbs  > 1)
+            {
+                // Remove CRS of antenna ports 2 and 3 from the second symbol
+                N_reg_pdcch -= phy_struct->cell->N_rb_dl;
+            }
+            N_cce_pdcch = N_reg_pdcch/N_reg_cce;
+
+            // Initialize the search space
+            for(p=0; p<N_ant; p++)
+            {
+                for(i=0; i<N_cce_pdcch; i++)
+                {
+                    for(j=0; j<4*N_reg_cce; j++)
+                    {
+                        phy_struct->pdcch_scratch->pdcch_cce_re[p][i][j] = 0;
+                        phy_struct->pdcch_scratch->pdcch_cce_im[p][i][j] = 0;
+                    }
+                    phy_struct->pdcch_cce_used[i] = false;
+                }
+            }
+
+            // Generate the scrambling sequence
+            c_init = (subframe->num << 9) + N_id_cell;
+            generate_prs_c_cached(phy_struct, c_init, 1152, phy_struct->pdcch_c);
+
+            // Add the DCIs
+            for(a_idx=0; a_idx<pdcch->N_alloc; a_idx++)
+            {
+                // Encode the DCI
+                if(LIBLTE_PHY_CHAN_TYPE_DLSCH == pdcch->alloc[a_idx].chan_type)
+                {
+                    dci_1a_pack(&pdcch->alloc[a_idx],
+                                LIBLTE_PHY_DCI_CA_NOT_PRESENT,
+                                phy_struct->cell->N_rb_dl,
                                 N_ant,
                                 phy_struct->pdcch_dci,
                                 &dci_size);
                 }else{ // LIBLTE_PHY_CHAN_TYPE_ULSCH == pdcch->alloc[a_idx].chan_type
                     dci_0_pack(&pdcch->alloc[a_idx],
                                LIBLTE_PHY_DCI_CA_NOT_PRESENT,
-                               phy_struct->N_rb_ul,
+                               phy_struct->cell->N_rb_ul,
                                N_ant,
                                phy_struct->pdcch_dci,
                                &dci_size);
@@ -3984,8 +5663,8 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT
                                 {
                                     for(j=0; j<(4*N_reg_cce); j++)
                                     {
-                                        phy_struct->pdcch_cce_re[p][4*css_idx+i][j] = phy_struct->pdcch_y_re[p][idx];
-                                        phy_struct->pdcch_cce_im[p][4*css_idx+i][j] = phy_struct->pdcch_y_im[p][idx];
+                                        phy_struct->pdcch_scratch->pdcch_cce_re[p][4*css_idx+i][j] = phy_struct->pdcch_y_re[p][idx];
+                                        phy_struct->pdcch_scratch->pdcch_cce_im[p][4*css_idx+i][j] = phy_struct->pdcch_y_im[p][idx];
                                         idx++;
                                     }
                                     phy_struct->pdcch_cce_used[4*css_idx+i] = true;
@@ -4045,8 +5724,8 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT
 //                                {
 //                                    for(j=0; j<(4*N_reg_cce); j++)
 //                                    {
-//                                        phy_struct->pdcch_cce_re[p][actual_idx+i][j] = phy_struct->pdcch_y_re[p][idx];
-//                                        phy_struct->pdcch_cce_im[p][actual_idx+i][j] = phy_struct->pdcch_y_im[p][idx];
+//                                        phy_struct->pdcch_scratch->pdcch_cce_re[p][actual_idx+i][j] = phy_struct->pdcch_y_re[p][idx];
+//                                        phy_struct->pdcch_scratch->pdcch_cce_im[p][actual_idx+i][j] = phy_struct->pdcch_y_im[p][idx];
 //                                        idx++;
 //                                    }
 //                                    phy_struct->pdcch_cce_used[actual_idx+i] = true;
@@ -4066,8 +5745,8 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT
                     {
                         for(k=0; k<4; k++)
                         {
-                            phy_struct->pdcch_reg_re[p][i*N_reg_cce+j][k] = phy_struct->pdcch_cce_re[p][i][j*4+k];
-                            phy_struct->pdcch_reg_im[p][i*N_reg_cce+j][k] = phy_struct->pdcch_cce_im[p][i][j*4+k];
+                            phy_struct->pdcch_scratch->pdcch_reg_re[p][i*N_reg_cce+j][k] = phy_struct->pdcch_scratch->pdcch_cce_re[p][i][j*4+k];
+                            phy_struct->pdcch_scratch->pdcch_reg_im[p][i*N_reg_cce+j][k] = phy_struct->pdcch_scratch->pdcch_cce_im[p][i][j*4+k];
                         }
                     }
                 }
@@ -4079,8 +5758,8 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT
                 {
                     for(j=0; j<4; j++)
                     {
-                        phy_struct->pdcch_perm_re[p][i][j] = phy_struct->pdcch_reg_re[p][phy_struct->pdcch_permute_map[N_reg_pdcch][i]][j];
-                        phy_struct->pdcch_perm_im[p][i][j] = phy_struct->pdcch_reg_im[p][phy_struct->pdcch_permute_map[N_reg_pdcch][i]][j];
+                        phy_struct->pdcch_scratch->pdcch_perm_re[p][i][j] = phy_struct->pdcch_scratch->pdcch_reg_re[p][phy_struct->cell->pdcch_permute_map[N_reg_pdcch][i]][j];
+                        phy_struct->pdcch_scratch->pdcch_perm_im[p][i][j] = phy_struct->pdcch_scratch->pdcch_reg_im[p][phy_struct->cell->pdcch_permute_map[N_reg_pdcch][i]][j];
                     }
                 }
             }
@@ -4092,8 +5771,8 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT
                     shift_idx = (i+N_id_cell) % N_reg_pdcch;
                     for(j=0; j<4; j++)
                     {
-                        phy_struct->pdcch_shift_re[p][i][j] = phy_struct->pdcch_perm_re[p][shift_idx][j];
-                        phy_struct->pdcch_shift_im[p][i][j] = phy_struct->pdcch_perm_im[p][shift_idx][j];
+                        phy_struct->pdcch_scratch->pdcch_shift_re[p][i][j] = phy_struct->pdcch_scratch->pdcch_perm_re[p][shift_idx][j];
+                        phy_struct->pdcch_scratch->pdcch_shift_im[p][i][j] = phy_struct->pdcch_scratch->pdcch_perm_im[p][shift_idx][j];
                     }
                 }
             }
@@ -4102,7 +5781,7 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT
             m_prime = 0;
             k_prime = 0;
             // Step 10
-            while(k_prime < (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl))
+            while(k_prime < (phy_struct->cell->N_rb_dl*phy_struct->cell->N_sc_rb_dl))
             {
                 // Step 3
                 l_prime = 0;
@@ -4141,8 +5820,8 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT
                                     {
                                         for(p=0; p<N_ant; p++)
                                         {
-                                            subframe->tx_symb_re[p][l_prime][k_prime+i] = phy_struct->pdcch_shift_re[p][m_prime][idx];
-                                            subframe->tx_symb_im[p][l_prime][k_prime+i] = phy_struct->pdcch_shift_im[p][m_prime][idx];
+                                            subframe->tx_symb_re[p][l_prime][k_prime+i] = phy_struct->pdcch_scratch->pdcch_shift_re[p][m_prime][idx];
+                                            subframe->tx_symb_im[p][l_prime][k_prime+i] = phy_struct->pdcch_scratch->pdcch_shift_im[p][m_prime][idx];
                                         }
                                         idx++;
                                     }
@@ -4166,8 +5845,8 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT
                                     {
                                         for(p=0; p<N_ant; p++)
                                         {
-                                            subframe->tx_symb_re[p][l_prime][k_prime+i] = phy_struct->pdcch_shift_re[p][m_prime][idx];
-                                            subframe->tx_symb_im[p][l_prime][k_prime+i] = phy_struct->pdcch_shift_im[p][m_prime][idx];
+                                            subframe->tx_symb_re[p][l_prime][k_prime+i] = phy_struct->pdcch_scratch->pdcch_shift_re[p][m_prime][idx];
+                                            subframe->tx_symb_im[p][l_prime][k_prime+i] = phy_struct->pdcch_scratch->pdcch_shift_im[p][m_prime][idx];
                                         }
                                         idx++;
                                     }
@@ -4187,8 +5866,8 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT
                                 {
                                     for(p=0; p<N_ant; p++)
                                     {
-                                        subframe->tx_symb_re[p][l_prime][k_prime+i] = phy_struct->pdcch_shift_re[p][m_prime][i];
-                                        subframe->tx_symb_im[p][l_prime][k_prime+i] = phy_struct->pdcch_shift_im[p][m_prime][i];
+                                        subframe->tx_symb_re[p][l_prime][k_prime+i] = phy_struct->pdcch_scratch->pdcch_shift_re[p][m_prime][i];
+                                        subframe->tx_symb_im[p][l_prime][k_prime+i] = phy_struct->pdcch_scratch->pdcch_shift_im[p][m_prime][i];
                                     }
                                 }
                                 // Step 6
@@ -4263,6 +5942,12 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
        phich      != NULL &&
        pdcch      != NULL)
     {
+        // Scratch, allocated on first use
+        if(NULL == phy_struct->pdcch_scratch)
+        {
+            phy_struct->pdcch_scratch = (LIBLTE_PHY_PDCCH_SCRATCH_STRUCT *)malloc(sizeof(LIBLTE_PHY_PDCCH_SCRATCH_STRUCT));
+        }
+
         // PCFICH
         pcfich_channel_demap(phy_struct, subframe, N_id_cell, N_ant, pcfich, &N_bits);
         if(LIBLTE_SUCCESS != cfi_channel_decode(phy_struct,
@@ -4280,17 +5965,18 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
         // PDCCH
         // Calculate number of symbols, 3GPP TS 36.211 v10.1.0 section 6.7
         pdcch->N_symbs = pcfich->cfi;
-        if(phy_struct->N_rb_dl <= 10)
+        if(phy_struct->cell->N_rb_dl <= 10)
         {
             pdcch->N_symbs++;
         }
         // Calculate resources, 3GPP TS 36.211 v10.1.0 section 6.8.1
         N_reg_rb    = 3;
-        N_reg_pdcch = pdcch->N_symbs*(phy_struct->N_rb_dl*N_reg_rb) - phy_struct->N_rb_dl - pcfich->N_reg - phich->N_reg;
-        if(N_ant == 4)
+        N_reg_pdcch = pdcch->N_symbs*(phy_struct->cell->N_rb_dl*N_reg_rb) - phy_struct->cell->N_rb_dl - pcfich->N_reg - phich->N_reg;
+        if(N_ant          == 4 &&
+           pdcch->N_symbs  > 1)
         {
-            // Remove CRS
-            N_reg_pdcch -= phy_struct->N_rb_dl;
+            // Remove CRS of antenna ports 2 and 3 from the second symbol
+            N_reg_pdcch -= phy_struct->cell->N_rb_dl;
         }
         N_cce_pdcch = N_reg_pdcch/9;
         // Extract resource elements and channel estimate, 3GPP TS 36.211 v10.1.0 section 6.8.5
@@ -4298,7 +5984,7 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
         m_prime = 0;
         k_prime = 0;
         // Step 10
-        while(k_prime < (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl))
+        while(k_prime < (phy_struct->cell->N_rb_dl*phy_struct->cell->N_sc_rb_dl))
         {
             // Step 3
             l_prime = 0;
@@ -4335,12 +6021,12 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
                                 // Avoid CRS
                                 if((N_id_cell % 3) != (i % 3))
                                 {
-                                    phy_struct->pdcch_reg_y_est_re[m_prime][idx] = subframe->rx_symb_re[l_prime][k_prime+i];
-                                    phy_struct->pdcch_reg_y_est_im[m_prime][idx] = subframe->rx_symb_im[l_prime][k_prime+i];
+                                    phy_struct->pdcch_scratch->pdcch_reg_y_est_re[m_prime][idx] = subframe->rx_symb_re[l_prime][k_prime+i];
+                                    phy_struct->pdcch_scratch->pdcch_reg_y_est_im[m_prime][idx] = subframe->rx_symb_im[l_prime][k_prime+i];
                                     for(p=0; p<N_ant; p++)
                                     {
-                                        phy_struct->pdcch_reg_c_est_re[p][m_prime][idx] = subframe->rx_ce_re[p][l_prime][k_prime+i];
-                                        phy_struct->pdcch_reg_c_est_im[p][m_prime][idx] = subframe->rx_ce_im[p][l_prime][k_prime+i];
+                                        phy_struct->pdcch_scratch->pdcch_reg_c_est_re[p][m_prime][idx] = subframe->rx_ce_re[p][l_prime][k_prime+i];
+                                        phy_struct->pdcch_scratch->pdcch_reg_c_est_im[p][m_prime][idx] = subframe->rx_ce_im[p][l_prime][k_prime+i];
                                     }
                                     idx++;
                                 }
@@ -4362,12 +6048,12 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
                                 // Avoid CRS
                                 if((N_id_cell % 3) != (i % 3))
                                 {
-                                    phy_struct->pdcch_reg_y_est_re[m_prime][idx] = subframe->rx_symb_re[l_prime][k_prime+i];
-                                    phy_struct->pdcch_reg_y_est_im[m_prime][idx] = subframe->rx_symb_im[l_prime][k_prime+i];
+                                    phy_struct->pdcch_scratch->pdcch_reg_y_est_re[m_prime][idx] = subframe->rx_symb_re[l_prime][k_prime+i];
+                                    phy_struct->pdcch_scratch->pdcch_reg_y_est_im[m_prime][idx] = subframe->rx_symb_im[l_prime][k_prime+i];
                                     for(p=0; p<N_ant; p++)
                                     {
-                                        phy_struct->pdcch_reg_c_est_re[p][m_prime][idx] = subframe->rx_ce_re[p][l_prime][k_prime+i];
-                                        phy_struct->pdcch_reg_c_est_im[p][m_prime][idx] = subframe->rx_ce_im[p][l_prime][k_prime+i];
+                                        phy_struct->pdcch_scratch->pdcch_reg_c_est_re[p][m_prime][idx] = subframe->rx_ce_re[p][l_prime][k_prime+i];
+                                        phy_struct->pdcch_scratch->pdcch_reg_c_est_im[p][m_prime][idx] = subframe->rx_ce_im[p][l_prime][k_prime+i];
                                     }
                                     idx++;
                                 }
@@ -4385,12 +6071,12 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
                             // Step 5
                             for(i=0; i<4; i++)
                             {
-                                phy_struct->pdcch_reg_y_est_re[m_prime][i] = subframe->rx_symb_re[l_prime][k_prime+i];
-                                phy_struct->pdcch_reg_y_est_im[m_prime][i] = subframe->rx_symb_im[l_prime][k_prime+i];
+                                phy_struct->pdcch_scratch->pdcch_reg_y_est_re[m_prime][i] = subframe->rx_symb_re[l_prime][k_prime+i];
+                                phy_struct->pdcch_scratch->pdcch_reg_y_est_im[m_prime][i] = subframe->rx_symb_im[l_prime][k_prime+i];
                                 for(p=0; p<N_ant; p++)
                                 {
-                                    phy_struct->pdcch_reg_c_est_re[p][m_prime][i] = subframe->rx_ce_re[p][l_prime][k_prime+i];
-                                    phy_struct->pdcch_reg_c_est_im[p][m_prime][i] = subframe->rx_ce_im[p][l_prime][k_prime+i];
+                                    phy_struct->pdcch_scratch->pdcch_reg_c_est_re[p][m_prime][i] = subframe->rx_ce_re[p][l_prime][k_prime+i];
+                                    phy_struct->pdcch_scratch->pdcch_reg_c_est_im[p][m_prime][i] = subframe->rx_ce_im[p][l_prime][k_prime+i];
                                 }
                             }
                             // Step 6
@@ -4410,12 +6096,12 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
             shift_idx = (i+N_id_cell) % N_reg_pdcch;
             for(j=0; j<4; j++)
             {
-                phy_struct->pdcch_shift_y_est_re[shift_idx][j] = phy_struct->pdcch_reg_y_est_re[i][j];
-                phy_struct->pdcch_shift_y_est_im[shift_idx][j] = phy_struct->pdcch_reg_y_est_im[i][j];
+                phy_struct->pdcch_scratch->pdcch_shift_y_est_re[shift_idx][j] = phy_struct->pdcch_scratch->pdcch_reg_y_est_re[i][j];
+                phy_struct->pdcch_scratch->pdcch_shift_y_est_im[shift_idx][j] = phy_struct->pdcch_scratch->pdcch_reg_y_est_im[i][j];
                 for(p=0; p<N_ant; p++)
                 {
-                    phy_struct->pdcch_shift_c_est_re[p][shift_idx][j] = phy_struct->pdcch_reg_c_est_re[p][i][j];
-                    phy_struct->pdcch_shift_c_est_im[p][shift_idx][j] = phy_struct->pdcch_reg_c_est_im[p][i][j];
+                    phy_struct->pdcch_scratch->pdcch_shift_c_est_re[p][shift_idx][j] = phy_struct->pdcch_scratch->pdcch_reg_c_est_re[p][i][j];
+                    phy_struct->pdcch_scratch->pdcch_shift_c_est_im[p][shift_idx][j] = phy_struct->pdcch_scratch->pdcch_reg_c_est_im[p][i][j];
                 }
             }
         }
@@ -4518,12 +6204,12 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
         {
             for(j=0; j<4; j++)
             {
-                phy_struct->pdcch_perm_y_est_re[i][j] = phy_struct->pdcch_shift_y_est_re[(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
-                phy_struct->pdcch_perm_y_est_im[i][j] = phy_struct->pdcch_shift_y_est_im[(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
+                phy_struct->pdcch_scratch->pdcch_perm_y_est_re[i][j] = phy_struct->pdcch_scratch->pdcch_shift_y_est_re[(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
+                phy_struct->pdcch_scratch->pdcch_perm_y_est_im[i][j] = phy_struct->pdcch_scratch->pdcch_shift_y_est_im[(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
                 for(p=0; p<N_ant; p++)
                 {
-                    phy_struct->pdcch_perm_c_est_re[p][i][j] = phy_struct->pdcch_shift_c_est_re[p][(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
-                    phy_struct->pdcch_perm_c_est_im[p][i][j] = phy_struct->pdcch_shift_c_est_im[p][(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
+                    phy_struct->pdcch_scratch->pdcch_perm_c_est_re[p][i][j] = phy_struct->pdcch_scratch->pdcch_shift_c_est_re[p][(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
+                    phy_struct->pdcch_scratch->pdcch_perm_c_est_im[p][i][j] = phy_struct->pdcch_scratch->pdcch_shift_c_est_im[p][(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
                 }
             }
         }
@@ -4535,12 +6221,12 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
             {
                 for(k=0; k<4; k++)
                 {
-                    phy_struct->pdcch_cce_y_est_re[i][j*4+k] = phy_struct->pdcch_perm_y_est_re[i*N_reg_cce+j][k];
-                    phy_struct->pdcch_cce_y_est_im[i][j*4+k] = phy_struct->pdcch_perm_y_est_im[i*N_reg_cce+j][k];
+                    phy_struct->pdcch_scratch->pdcch_cce_y_est_re[i][j*4+k] = phy_struct->pdcch_scratch->pdcch_perm_y_est_re[i*N_reg_cce+j][k];
+                    phy_struct->pdcch_scratch->pdcch_cce_y_est_im[i][j*4+k] = phy_struct->pdcch_scratch->pdcch_perm_y_est_im[i*N_reg_cce+j][k];
                     for(p=0; p<N_ant; p++)
                     {
-                        phy_struct->pdcch_cce_c_est_re[p][i][j*4+k] = phy_struct->pdcch_perm_c_est_re[p][i*N_reg_cce+j][k];
-                        phy_struct->pdcch_cce_c_est_im[p][i][j*4+k] = phy_struct->pdcch_perm_c_est_im[p][i*N_reg_cce+j][k];
+                        phy_struct->pdcch_scratch->pdcch_cce_c_est_re[p][i][j*4+k] = phy_struct->pdcch_scratch->pdcch_perm_c_est_re[p][i*N_reg_cce+j][k];
+                        phy_struct->pdcch_scratch->pdcch_cce_c_est_im[p][i][j*4+k] = phy_struct->pdcch_scratch->pdcch_perm_c_est_im[p][i*N_reg_cce+j][k];
                     }
                 }
             }
@@ -4548,26 +6234,26 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
 
         // Generate the scrambling sequence
         c_init = (subframe->num << 9) + N_id_cell;
-        generate_prs_c(c_init, 1152, phy_struct->pdcch_c);
+        generate_prs_c_cached(phy_struct, c_init, 1152, phy_struct->pdcch_c);
 
         // Determine the size of DCI 1A and 1C FIXME: Clean this up
-        if(phy_struct->N_rb_dl == 6)
+        if(phy_struct->cell->N_rb_dl == 6)
         {
             dci_1a_size = 21;
             dci_1c_size = 9;
-        }else if(phy_struct->N_rb_dl == 15){
+        }else if(phy_struct->cell->N_rb_dl == 15){
             dci_1a_size = 22;
             dci_1c_size = 11;
-        }else if(phy_struct->N_rb_dl == 25){
+        }else if(phy_struct->cell->N_rb_dl == 25){
             dci_1a_size = 25;
             dci_1c_size = 13;
-        }else if(phy_struct->N_rb_dl == 50){
+        }else if(phy_struct->cell->N_rb_dl == 50){
             dci_1a_size = 27;
             dci_1c_size = 13;
-        }else if(phy_struct->N_rb_dl == 75){
+        }else if(phy_struct->cell->N_rb_dl == 75){
             dci_1a_size = 27;
             dci_1c_size = 14;
-        }else{ // phy_struct->N_rb_dl == 100
+        }else{ // phy_struct->cell->N_rb_dl == 100
             dci_1a_size = 28;
             dci_1c_size = 15;
         }
@@ -4581,12 +6267,12 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
             {
                 for(k=0; k<36; k++)
                 {
-                    phy_struct->pdcch_y_est_re[idx] = phy_struct->pdcch_cce_y_est_re[i*4+j][k];
-                    phy_struct->pdcch_y_est_im[idx] = phy_struct->pdcch_cce_y_est_im[i*4+j][k];
+                    phy_struct->pdcch_y_est_re[idx] = phy_struct->pdcch_scratch->pdcch_cce_y_est_re[i*4+j][k];
+                    phy_struct->pdcch_y_est_im[idx] = phy_struct->pdcch_scratch->pdcch_cce_y_est_im[i*4+j][k];
                     for(p=0; p<N_ant; p++)
                     {
-                        phy_struct->pdcch_c_est_re[p][idx] = phy_struct->pdcch_cce_c_est_re[p][i*4+j][k];
-                        phy_struct->pdcch_c_est_im[p][idx] = phy_struct->pdcch_cce_c_est_im[p][i*4+j][k];
+                        phy_struct->pdcch_c_est_re[p][idx] = phy_struct->pdcch_scratch->pdcch_cce_c_est_re[p][i*4+j][k];
+                        phy_struct->pdcch_c_est_im[p][idx] = phy_struct->pdcch_scratch->pdcch_cce_c_est_im[p][i*4+j][k];
                     }
                     idx++;
                 }
@@ -4614,6 +6300,7 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
                               &M_symb);
             modulation_demapper(phy_struct->pdcch_d_re,
                                 phy_struct->pdcch_d_im,
+                                NULL,
                                 M_symb,
                                 LIBLTE_PHY_MODULATION_TYPE_QPSK,
                                 phy_struct->pdcch_soft_bits,
@@ -4655,7 +6342,7 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
                                     dci_1a_size,
                                     LIBLTE_PHY_DCI_CA_NOT_PRESENT,
                                     rnti,
-                                    phy_struct->N_rb_dl,
+                                    phy_struct->cell->N_rb_dl,
                                     N_ant,
                                     &pdcch->alloc[pdcch->N_alloc++]);
             }
@@ -4692,7 +6379,7 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
                 dci_1c_unpack(phy_struct->pdcch_dci,
                               dci_1c_size,
                               rnti,
-                              phy_struct->N_rb_dl,
+                              phy_struct->cell->N_rb_dl,
                               N_ant,
                               &pdcch->alloc[pdcch->N_alloc++]);
             }
@@ -4704,12 +6391,12 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
             {
                 for(k=0; k<36; k++)
                 {
-                    phy_struct->pdcch_y_est_re[idx] = phy_struct->pdcch_cce_y_est_re[i*8+j][k];
-                    phy_struct->pdcch_y_est_im[idx] = phy_struct->pdcch_cce_y_est_im[i*8+j][k];
+                    phy_struct->pdcch_y_est_re[idx] = phy_struct->pdcch_scratch->pdcch_cce_y_est_re[i*8+j][k];
+                    phy_struct->pdcch_y_est_im[idx] = phy_struct->pdcch_scratch->pdcch_cce_y_est_im[i*8+j][k];
                     for(p=0; p<N_ant; p++)
                     {
-                        phy_struct->pdcch_c_est_re[p][idx] = phy_struct->pdcch_cce_c_est_re[p][i*8+j][k];
-                        phy_struct->pdcch_c_est_im[p][idx] = phy_struct->pdcch_cce_c_est_im[p][i*8+j][k];
+                        phy_struct->pdcch_c_est_re[p][idx] = phy_struct->pdcch_scratch->pdcch_cce_c_est_re[p][i*8+j][k];
+                        phy_struct->pdcch_c_est_im[p][idx] = phy_struct->pdcch_scratch->pdcch_cce_c_est_im[p][i*8+j][k];
                     }
                     idx++;
                 }
@@ -4737,6 +6424,7 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
                               &M_symb);
             modulation_demapper(phy_struct->pdcch_d_re,
                                 phy_struct->pdcch_d_im,
+                                NULL,
                                 M_symb,
                                 LIBLTE_PHY_MODULATION_TYPE_QPSK,
                                 phy_struct->pdcch_soft_bits,
@@ -4778,7 +6466,7 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
                                     dci_1a_size,
                                     LIBLTE_PHY_DCI_CA_NOT_PRESENT,
                                     rnti,
-                                    phy_struct->N_rb_dl,
+                                    phy_struct->cell->N_rb_dl,
                                     N_ant,
                                     &pdcch->alloc[pdcch->N_alloc++]);
             }
@@ -4815,7 +6503,7 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
                 dci_1c_unpack(phy_struct->pdcch_dci,
                               dci_1c_size,
                               rnti,
-                              phy_struct->N_rb_dl,
+                              phy_struct->cell->N_rb_dl,
                               N_ant,
                               &pdcch->alloc[pdcch->N_alloc++]);
             }
@@ -4856,40 +6544,46 @@ LIBLTE_ERROR_ENUM liblte_phy_map_crs(LIBLTE_PHY_STRUCT          *phy_struct,
        N_id_cell  >= 0    &&
        N_id_cell  <= 503)
     {
+        // Scratch, allocated on first use
+        if(NULL == phy_struct->dl_ce_scratch)
+        {
+            phy_struct->dl_ce_scratch = (LIBLTE_PHY_DL_CE_SCRATCH_STRUCT *)malloc(sizeof(LIBLTE_PHY_DL_CE_SCRATCH_STRUCT));
+        }
+
         // Generate cell specific reference signals
-        if(phy_struct->N_id_cell_crs == N_id_cell)
-        {
-            crs_re[0]  = &phy_struct->crs_re_storage[subframe->num*2  ][0][0];
-            crs_im[0]  = &phy_struct->crs_im_storage[subframe->num*2  ][0][0];
-            crs_re[1]  = &phy_struct->crs_re_storage[subframe->num*2  ][1][0];
-            crs_im[1]  = &phy_struct->crs_im_storage[subframe->num*2  ][1][0];
-            crs_re[4]  = &phy_struct->crs_re_storage[subframe->num*2  ][2][0];
-            crs_im[4]  = &phy_struct->crs_im_storage[subframe->num*2  ][2][0];
-            crs_re[7]  = &phy_struct->crs_re_storage[subframe->num*2+1][0][0];
-            crs_im[7]  = &phy_struct->crs_im_storage[subframe->num*2+1][0][0];
-            crs_re[8]  = &phy_struct->crs_re_storage[subframe->num*2+1][1][0];
-            crs_im[8]  = &phy_struct->crs_im_storage[subframe->num*2+1][1][0];
-            crs_re[11] = &phy_struct->crs_re_storage[subframe->num*2+1][2][0];
-            crs_im[11] = &phy_struct->crs_im_storage[subframe->num*2+1][2][0];
+        if(phy_struct->cell->N_id_cell_crs == N_id_cell)
+        {
+            crs_re[0]  = &phy_struct->cell->crs_re_storage[subframe->num*2  ][0][0];
+            crs_im[0]  = &phy_struct->cell->crs_im_storage[subframe->num*2  ][0][0];
+            crs_re[1]  = &phy_struct->cell->crs_re_storage[subframe->num*2  ][1][0];
+            crs_im[1]  = &phy_struct->cell->crs_im_storage[subframe->num*2  ][1][0];
+            crs_re[4]  = &phy_struct->cell->crs_re_storage[subframe->num*2  ][2][0];
+            crs_im[4]  = &phy_struct->cell->crs_im_storage[subframe->num*2  ][2][0];
+            crs_re[7]  = &phy_struct->cell->crs_re_storage[subframe->num*2+1][0][0];
+            crs_im[7]  = &phy_struct->cell->crs_im_storage[subframe->num*2+1][0][0];
+            crs_re[8]  = &phy_struct->cell->crs_re_storage[subframe->num*2+1][1][0];
+            crs_im[8]  = &phy_struct->cell->crs_im_storage[subframe->num*2+1][1][0];
+            crs_re[11] = &phy_struct->cell->crs_re_storage[subframe->num*2+1][2][0];
+            crs_im[11] = &phy_struct->cell->crs_im_storage[subframe->num*2+1][2][0];
         }else{
-            generate_crs(subframe->num*2,   0, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->crs_re[0],  phy_struct->crs_im[0]);
-            generate_crs(subframe->num*2,   1, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->crs_re[1],  phy_struct->crs_im[1]);
-            generate_crs(subframe->num*2,   4, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->crs_re[4],  phy_struct->crs_im[4]);
-            generate_crs(subframe->num*2+1, 0, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->crs_re[7],  phy_struct->crs_im[7]);
-            generate_crs(subframe->num*2+1, 1, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->crs_re[8],  phy_struct->crs_im[8]);
-            generate_crs(subframe->num*2+1, 4, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->crs_re[11], phy_struct->crs_im[11]);
-            crs_re[0]  = &phy_struct->crs_re[0 ][0];
-            crs_im[0]  = &phy_struct->crs_im[0 ][0];
-            crs_re[1]  = &phy_struct->crs_re[1 ][0];
-            crs_im[1]  = &phy_struct->crs_im[1 ][0];
-            crs_re[4]  = &phy_struct->crs_re[4 ][0];
-            crs_im[4]  = &phy_struct->crs_im[4 ][0];
-            crs_re[7]  = &phy_struct->crs_re[7 ][0];
-            crs_im[7]  = &phy_struct->crs_im[7 ][0];
-            crs_re[8]  = &phy_struct->crs_re[8 ][0];
-            crs_im[8]  = &phy_struct->crs_im[8 ][0];
-            crs_re[11] = &phy_struct->crs_re[11][0];
-            crs_im[11] = &phy_struct->crs_im[11][0];
+            generate_crs(subframe->num*2,   0, N_id_cell, phy_struct->cell->N_sc_rb_dl, phy_struct->dl_ce_scratch->crs_re[0],  phy_struct->dl_ce_scratch->crs_im[0]);
+            generate_crs(subframe->num*2,   1, N_id_cell, phy_struct->cell->N_sc_rb_dl, phy_struct->dl_ce_scratch->crs_re[1],  phy_struct->dl_ce_scratch->crs_im[1]);
+            generate_crs(subframe->num*2,   4, N_id_cell, phy_struct->cell->N_sc_rb_dl, phy_struct->dl_ce_scratch->crs_re[4],  phy_struct->dl_ce_scratch->crs_im[4]);
+            generate_crs(subframe->num*2+1, 0, N_id_cell, phy_struct->cell->N_sc_rb_dl, phy_struct->dl_ce_scratch->crs_re[7],  phy_struct->dl_ce_scratch->crs_im[7]);
+            generate_crs(subframe->num*2+1, 1, N_id_cell, phy_struct->cell->N_sc_rb_dl, phy_struct->dl_ce_scratch->crs_re[8],  phy_struct->dl_ce_scratch->crs_im[8]);
+            generate_crs(subframe->num*2+1, 4, N_id_cell, phy_struct->cell->N_sc_rb_dl, phy_struct->dl_ce_scratch->crs_re[11], phy_struct->dl_ce_scratch->crs_im[11]);
+            crs_re[0]  = &phy_struct->dl_ce_scratch->crs_re[0 ][0];
+            crs_im[0]  = &phy_struct->dl_ce_scratch->crs_im[0 ][0];
+            crs_re[1]  = &phy_struct->dl_ce_scratch->crs_re[1 ][0];
+            crs_im[1]  = &phy_struct->dl_ce_scratch->crs_im[1 ][0];
+            crs_re[4]  = &phy_struct->dl_ce_scratch->crs_re[4 ][0];
+            crs_im[4]  = &phy_struct->dl_ce_scratch->crs_im[4 ][0];
+            crs_re[7]  = &phy_struct->dl_ce_scratch->crs_re[7 ][0];
+            crs_im[7]  = &phy_struct->dl_ce_scratch->crs_im[7 ][0];
+            crs_re[8]  = &phy_struct->dl_ce_scratch->crs_re[8 ][0];
+            crs_im[8]  = &phy_struct->dl_ce_scratch->crs_im[8 ][0];
+            crs_re[11] = &phy_struct->dl_ce_scratch->crs_re[11][0];
+            crs_im[11] = &phy_struct->dl_ce_scratch->crs_im[11][0];
         }
 
         for(p=0; p<N_ant; p++)
@@ -4930,10 +6624,10 @@ LIBLTE_ERROR_ENUM liblte_phy_map_crs(LIBLTE_PHY_STRUCT          *phy_struct,
             }
             for(i=0; i<N_sym; i++)
             {
-                for(j=0; j<2*phy_struct->N_rb_dl; j++)
+                for(j=0; j<2*phy_struct->cell->N_rb_dl; j++)
                 {
                     k                                  = 6*j + (v[i] + v_shift)%6;
-                    m_prime                            = j + LIBLTE_PHY_N_RB_DL_MAX - phy_struct->N_rb_dl;
+                    m_prime                            = j + LIBLTE_PHY_N_RB_DL_MAX - phy_struct->cell->N_rb_dl;
                     subframe->tx_symb_re[p][sym[i]][k] = crs_re[sym[i]][m_prime];
                     subframe->tx_symb_im[p][sym[i]][k] = crs_im[sym[i]][m_prime];
                 }
@@ -4975,7 +6669,7 @@ LIBLTE_ERROR_ENUM liblte_phy_map_pss(LIBLTE_PHY_STRUCT          *phy_struct,
         {
             for(i=0; i<62; i++)
             {
-                k                             = i - 31 + (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl)/2;
+                k                             = i - 31 + (phy_struct->cell->N_rb_dl*phy_struct->cell->N_sc_rb_dl)/2;
                 subframe->tx_symb_re[p][6][k] = pss_re[i];
                 subframe->tx_symb_im[p][6][k] = pss_im[i];
             }
@@ -5005,27 +6699,24 @@ LIBLTE_ERROR_ENUM liblte_phy_find_pss_and_fine_timing(LIBLTE_PHY_STRUCT *phy_str
                                                       float             *freq_offset)
 {
     LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_INPUTS;
-    float              corr_re_n1;
-    float              corr_im_n1;
-    float              corr_re;
-    float              corr_im;
-    float              corr_re_p1;
-    float              corr_im_p1;
-    float              abs_corr_n1;
+    float              corr_re[3][3];
+    float              corr_im[3][3];
     float              abs_corr;
-    float              abs_corr_p1;
     float              corr_max;
+    float              fine_abs_corr[80];
     float              pss_re[63];
     float              pss_im[63];
-    float             *pss_mod_re;
-    float             *pss_mod_im;
     int32              i;
     int32              idx;
     uint32             j;
     uint32             k;
     uint32             z;
+    uint32             z_start;
+    uint32             hyp;
     uint32             N_s;
     uint32             N_symb;
+    uint32             pss_idx;
+    uint32             first_idx;
     uint32             pss_timing_idx;
     int8               timing;
 
@@ -5037,28 +6728,37 @@ LIBLTE_ERROR_ENUM liblte_phy_find_pss_and_fine_timing(LIBLTE_PHY_STRUCT *phy_str
        pss_symb    != NULL &&
        pss_thresh  != NULL)
     {
+        // Scratch, allocated on first use
+        if(NULL == phy_struct->dl_sync_scratch)
+        {
+            phy_struct->dl_sync_scratch = (LIBLTE_PHY_DL_SYNC_SCRATCH_STRUCT *)malloc(sizeof(LIBLTE_PHY_DL_SYNC_SCRATCH_STRUCT));
+        }
+
         // Generate PSS
         for(i=0; i<3; i++)
         {
-            for(j=0; j<phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl; j++)
+            for(j=0; j<phy_struct->cell->N_rb_dl*phy_struct->cell->N_sc_rb_dl; j++)
             {
-                phy_struct->pss_mod_re[i][j] = 0;
-                phy_struct->pss_mod_im[i][j] = 0;
+                phy_struct->dl_sync_scratch->pss_mod_re[i][j] = 0;
+                phy_struct->dl_sync_scratch->pss_mod_im[i][j] = 0;
             }
             generate_pss(i, pss_re, pss_im);
             for(j=0; j<62; j++)
             {
-                k                                 = j - 31 + (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl)/2;
-                phy_struct->pss_mod_re_n1[i][k-1] = pss_re[j];
-                phy_struct->pss_mod_im_n1[i][k-1] = pss_im[j];
-                phy_struct->pss_mod_re[i][k]      = pss_re[j];
-                phy_struct->pss_mod_im[i][k]      = pss_im[j];
-                phy_struct->pss_mod_re_p1[i][k+1] = pss_re[j];
-                phy_struct->pss_mod_im_p1[i][k+1] = pss_im[j];
+                k                                                  = j - 31 + (phy_struct->cell->N_rb_dl*phy_struct->cell->N_sc_rb_dl)/2;
+                phy_struct->dl_sync_scratch->pss_mod_re_n1[i][k-1] = pss_re[j];
+                phy_struct->dl_sync_scratch->pss_mod_im_n1[i][k-1] = pss_im[j];
+                phy_struct->dl_sync_scratch->pss_mod_re[i][k]      = pss_re[j];
+                phy_struct->dl_sync_scratch->pss_mod_im[i][k]      = pss_im[j];
+                phy_struct->dl_sync_scratch->pss_mod_re_p1[i][k+1] = pss_re[j];
+                phy_struct->dl_sync_scratch->pss_mod_im_p1[i][k+1] = pss_im[j];
             }
         }
 
-        // Demod symbols and correlate with PSS
+        // Demod symbols and correlate with PSS, all three N_id_2 and
+        // frequency hypotheses are correlated in one pass over the
+        // subcarriers the PSS can occupy
+        z_start  = (phy_struct->cell->N_rb_dl*phy_struct->cell->N_sc_rb_dl)/2 - 32;
         corr_max = 0;
         for(i=0; i<12; i++)
         {
@@ -5067,7 +6767,7 @@ LIBLTE_ERROR_ENUM liblte_phy_find_pss_and_fine_timing(LIBLTE_PHY_STRUCT *phy_str
                 samples_to_symbols_dl(phy_struct,
                                       i_samps,
                                       q_samps,
-                                      symb_starts[j]+(phy_struct->N_samps_per_slot*i),
+                                      symb_starts[j]+(phy_struct->cell->N_samps_per_slot*i),
                                       0,
                                       0,
                                       phy_struct->rx_symb_re,
@@ -5075,77 +6775,79 @@ LIBLTE_ERROR_ENUM liblte_phy_find_pss_and_fine_timing(LIBLTE_PHY_STRUCT *phy_str
 
                 for(k=0; k<3; k++)
                 {
-                    corr_re_n1 = 0;
-                    corr_im_n1 = 0;
-                    corr_re    = 0;
-                    corr_im    = 0;
-                    corr_re_p1 = 0;
-                    corr_im_p1 = 0;
-                    for(z=0; z<phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl; z++)
+                    for(hyp=0; hyp<3; hyp++)
                     {
-                        corr_re_n1 += (phy_struct->rx_symb_re[z]*phy_struct->pss_mod_re_n1[k][z] +
-                                       phy_struct->rx_symb_im[z]*phy_struct->pss_mod_im_n1[k][z]);
-                        corr_im_n1 += (phy_struct->rx_symb_re[z]*phy_struct->pss_mod_im_n1[k][z] -
-                                       phy_struct->rx_symb_im[z]*phy_struct->pss_mod_re_n1[k][z]);
-                        corr_re    += (phy_struct->rx_symb_re[z]*phy_struct->pss_mod_re[k][z] +
-                                       phy_struct->rx_symb_im[z]*phy_struct->pss_mod_im[k][z]);
-                        corr_im    += (phy_struct->rx_symb_re[z]*phy_struct->pss_mod_im[k][z] -
-                                       phy_struct->rx_symb_im[z]*phy_struct->pss_mod_re[k][z]);
-                        corr_re_p1 += (phy_struct->rx_symb_re[z]*phy_struct->pss_mod_re_p1[k][z] +
-                                       phy_struct->rx_symb_im[z]*phy_struct->pss_mod_im_p1[k][z]);
-                        corr_im_p1 += (phy_struct->rx_symb_re[z]*phy_struct->pss_mod_im_p1[k][z] -
-                                       phy_struct->rx_symb_im[z]*phy_struct->pss_mod_re_p1[k][z]);
+                        corr_re[k][hyp] = 0;
+                        corr_im[k][hyp] = 0;
                     }
-                    abs_corr_n1 = sqrt(corr_re_n1*corr_re_n1 + corr_im_n1*corr_im_n1);
-                    abs_corr    = sqrt(corr_re*corr_re + corr_im*corr_im);
-                    abs_corr_p1 = sqrt(corr_re_p1*corr_re_p1 + corr_im_p1*corr_im_p1);
-                    if(abs_corr_n1 > corr_max)
-                    {
-                        idx       = -1;
-                        corr_max  = abs_corr_n1;
-                        *pss_symb = (i*N_SYMB_DL_NORMAL_CP)+j;
-                        *N_id_2   = k;
-                    }
-                    if(abs_corr > corr_max)
+                }
+                for(z=z_start; z<(z_start+64); z++)
+                {
+                    for(k=0; k<3; k++)
                     {
-                        idx       = 0;
-                        corr_max  = abs_corr;
-                        *pss_symb = (i*N_SYMB_DL_NORMAL_CP)+j;
-                        *N_id_2   = k;
+                        corr_re[k][0] += (phy_struct->rx_symb_re[z]*phy_struct->dl_sync_scratch->pss_mod_re_n1[k][z] +
+                                          phy_struct->rx_symb_im[z]*phy_struct->dl_sync_scratch->pss_mod_im_n1[k][z]);
+                        corr_im[k][0] += (phy_struct->rx_symb_re[z]*phy_struct->dl_sync_scratch->pss_mod_im_n1[k][z] -
+                                          phy_struct->rx_symb_im[z]*phy_struct->dl_sync_scratch->pss_mod_re_n1[k][z]);
+                        corr_re[k][1] += (phy_struct->rx_symb_re[z]*phy_struct->dl_sync_scratch->pss_mod_re[k][z] +
+                                          phy_struct->rx_symb_im[z]*phy_struct->dl_sync_scratch->pss_mod_im[k][z]);
+                        corr_im[k][1] += (phy_struct->rx_symb_re[z]*phy_struct->dl_sync_scratch->pss_mod_im[k][z] -
+                                          phy_struct->rx_symb_im[z]*phy_struct->dl_sync_scratch->pss_mod_re[k][z]);
+                        corr_re[k][2] += (phy_struct->rx_symb_re[z]*phy_struct->dl_sync_scratch->pss_mod_re_p1[k][z] +
+                                          phy_struct->rx_symb_im[z]*phy_struct->dl_sync_scratch->pss_mod_im_p1[k][z]);
+                        corr_im[k][2] += (phy_struct->rx_symb_re[z]*phy_struct->dl_sync_scratch->pss_mod_im_p1[k][z] -
+                                          phy_struct->rx_symb_im[z]*phy_struct->dl_sync_scratch->pss_mod_re_p1[k][z]);
                     }
-                    if(abs_corr_p1 > corr_max)
+                }
+                for(k=0; k<3; k++)
+                {
+                    for(hyp=0; hyp<3; hyp++)
                     {
-                        idx       = 1;
-                        corr_max  = abs_corr_p1;
-                        *pss_symb = (i*N_SYMB_DL_NORMAL_CP)+j;
-                        *N_id_2   = k;
+                        abs_corr = sqrt(corr_re[k][hyp]*corr_re[k][hyp] + corr_im[k][hyp]*corr_im[k][hyp]);
+                        if(abs_corr > corr_max)
+                        {
+                            idx       = hyp - 1;
+                            corr_max  = abs_corr;
+                            *pss_symb = (i*N_SYMB_DL_NORMAL_CP)+j;
+                            *N_id_2   = k;
+                        }
                     }
                 }
             }
         }
         if(-1 == idx)
         {
-            pss_mod_re   = &phy_struct->pss_mod_re_n1[*N_id_2][0];
-            pss_mod_im   = &phy_struct->pss_mod_im_n1[*N_id_2][0];
             *freq_offset = -15000; // FIXME
         }else if(0 == idx){
-            pss_mod_re   = &phy_struct->pss_mod_re[*N_id_2][0];
-            pss_mod_im   = &phy_struct->pss_mod_im[*N_id_2][0];
             *freq_offset = 0;
         }else{
-            pss_mod_re   = &phy_struct->pss_mod_re_p1[*N_id_2][0];
-            pss_mod_im   = &phy_struct->pss_mod_im_p1[*N_id_2][0];
             *freq_offset = 15000; // FIXME
         }
 
-        // Find optimal timing
+        // Find optimal timing, correlating every offset from -40 to
+        // +39 samples in one overlap-save block.  Negative offsets that
+        // would run off the start of the samples use offset 0.
         N_s      = (*pss_symb)/7;
         N_symb   = (*pss_symb)%7;
+        pss_idx  = symb_starts[N_symb] + (phy_struct->cell->N_samps_per_slot*N_s);
+        if(pss_idx >= 40)
+        {
+            first_idx = pss_idx - 40;
+        }else{
+            first_idx = 0;
+        }
+        pss_corr_block(phy_struct,
+                       &i_samps[first_idx+phy_struct->cell->N_samps_cp_l_0-1],
+                       &q_samps[first_idx+phy_struct->cell->N_samps_cp_l_0-1],
+                       pss_idx + 40 - first_idx,
+                       *N_id_2,
+                       idx + 1,
+                       fine_abs_corr);
         corr_max = 0;
         timing   = 0;
         for(i=-40; i<40; i++)
         {
-            idx = symb_starts[N_symb] + (phy_struct->N_samps_per_slot*N_s);
+            idx = pss_idx;
             if(i < 0)
             {
                 if(idx >= -i)
@@ -5155,26 +6857,7 @@ LIBLTE_ERROR_ENUM liblte_phy_find_pss_and_fine_timing(LIBLTE_PHY_STRUCT *phy_str
             }else{
                 idx += i;
             }
-
-            samples_to_symbols_dl(phy_struct,
-                                  i_samps,
-                                  q_samps,
-                                  idx,
-                                  0,
-                                  0,
-                                  phy_struct->rx_symb_re,
-                                  phy_struct->rx_symb_im);
-
-            corr_re = 0;
-            corr_im = 0;
-            for(j=0; j<phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl; j++)
-            {
-                corr_re += (phy_struct->rx_symb_re[j]*pss_mod_re[j] +
-                            phy_struct->rx_symb_im[j]*pss_mod_im[j]);
-                corr_im += (phy_struct->rx_symb_re[j]*pss_mod_im[j] -
-                            phy_struct->rx_symb_im[j]*pss_mod_re[j]);
-            }
-            abs_corr = sqrt(corr_re*corr_re + corr_im*corr_im);
+            abs_corr = fine_abs_corr[idx-first_idx];
             if(abs_corr > corr_max)
             {
                 corr_max = abs_corr;
@@ -5184,15 +6867,15 @@ LIBLTE_ERROR_ENUM liblte_phy_find_pss_and_fine_timing(LIBLTE_PHY_STRUCT *phy_str
         *pss_thresh = corr_max;
 
         // Construct fine symbol start locations
-        pss_timing_idx = symb_starts[N_symb]+(phy_struct->N_samps_per_slot*N_s)+timing;
-        while((pss_timing_idx + phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_else) < phy_struct->N_samps_per_slot)
+        pss_timing_idx = symb_starts[N_symb]+(phy_struct->cell->N_samps_per_slot*N_s)+timing;
+        while((pss_timing_idx + phy_struct->cell->N_samps_per_symb + phy_struct->cell->N_samps_cp_l_else) < phy_struct->cell->N_samps_per_slot)
         {
-            pss_timing_idx += phy_struct->N_samps_per_frame;
+            pss_timing_idx += phy_struct->cell->N_samps_per_frame;
         }
-        symb_starts[0] = pss_timing_idx + (phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_else)*1 - phy_struct->N_samps_per_slot;
+        symb_starts[0] = pss_timing_idx + (phy_struct->cell->N_samps_per_symb+phy_struct->cell->N_samps_cp_l_else)*1 - phy_struct->cell->N_samps_per_slot;
         for(i=1; i<7; i++)
         {
-            symb_starts[i] = pss_timing_idx + (phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_else)*i + phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_0 - phy_struct->N_samps_per_slot;
+            symb_starts[i] = pss_timing_idx + (phy_struct->cell->N_samps_per_symb+phy_struct->cell->N_samps_cp_l_else)*i + phy_struct->cell->N_samps_per_symb+phy_struct->cell->N_samps_cp_l_0 - phy_struct->cell->N_samps_per_slot;
         }
 
         err = LIBLTE_SUCCESS;
@@ -5226,10 +6909,10 @@ LIBLTE_ERROR_ENUM liblte_phy_map_sss(LIBLTE_PHY_STRUCT          *phy_struct,
         generate_sss(phy_struct,
                      N_id_1,
                      N_id_2,
-                     &phy_struct->sss_mod_re_0[0][0],
-                     &phy_struct->sss_mod_im_0[0][0],
-                     &phy_struct->sss_mod_re_5[0][0],
-                     &phy_struct->sss_mod_im_5[0][0]);
+                     phy_struct->sss_re_0,
+                     phy_struct->sss_im_0,
+                     phy_struct->sss_re_5,
+                     phy_struct->sss_im_5);
 
         if(subframe->num == 0)
         {
@@ -5237,9 +6920,9 @@ LIBLTE_ERROR_ENUM liblte_phy_map_sss(LIBLTE_PHY_STRUCT          *phy_struct,
             {
                 for(i=0; i<62; i++)
                 {
-                    k                             = i - 31 + (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl)/2;
-                    subframe->tx_symb_re[p][5][k] = phy_struct->sss_mod_re_0[0][i];
-                    subframe->tx_symb_im[p][5][k] = phy_struct->sss_mod_im_0[0][i];
+                    k                             = i - 31 + (phy_struct->cell->N_rb_dl*phy_struct->cell->N_sc_rb_dl)/2;
+                    subframe->tx_symb_re[p][5][k] = phy_struct->sss_re_0[i];
+                    subframe->tx_symb_im[p][5][k] = phy_struct->sss_im_0[i];
                 }
             }
         }else if(subframe->num == 5){
@@ -5247,9 +6930,9 @@ LIBLTE_ERROR_ENUM liblte_phy_map_sss(LIBLTE_PHY_STRUCT          *phy_struct,
             {
                 for(i=0; i<62; i++)
                 {
-                    k                             = i - 31 + (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl)/2;
-                    subframe->tx_symb_re[p][5][k] = phy_struct->sss_mod_re_5[0][i];
-                    subframe->tx_symb_im[p][5][k] = phy_struct->sss_mod_im_5[0][i];
+                    k                             = i - 31 + (phy_struct->cell->N_rb_dl*phy_struct->cell->N_sc_rb_dl)/2;
+                    subframe->tx_symb_re[p][5][k] = phy_struct->sss_re_5[i];
+                    subframe->tx_symb_im[p][5][k] = phy_struct->sss_im_5[i];
                 }
             }
         }
@@ -5278,9 +6961,9 @@ LIBLTE_ERROR_ENUM liblte_phy_find_sss(LIBLTE_PHY_STRUCT *phy_struct,
 {
     LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
     float             sss_thresh;
-    float             corr_re;
-    float             corr_im;
-    float             abs_corr;
+    float             abs_corr[2][168];
+    float             y_re[64];
+    float             y_im[64];
     uint32            i;
     uint32            j;
     uint32            k;
@@ -5292,32 +6975,10 @@ LIBLTE_ERROR_ENUM liblte_phy_find_sss(LIBLTE_PHY_STRUCT *phy_struct,
        N_id_1          != NULL &&
        frame_start_idx != NULL)
     {
-        // Generate secondary synchronization signals
-        memset(phy_struct->sss_mod_re_0, 0, sizeof(float)*168*LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP);
-        memset(phy_struct->sss_mod_im_0, 0, sizeof(float)*168*LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP);
-        memset(phy_struct->sss_mod_re_5, 0, sizeof(float)*168*LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP);
-        memset(phy_struct->sss_mod_im_5, 0, sizeof(float)*168*LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP);
-        for(i=0; i<168; i++)
-        {
-            generate_sss(phy_struct,
-                         i,
-                         N_id_2,
-                         phy_struct->sss_re_0,
-                         phy_struct->sss_im_0,
-                         phy_struct->sss_re_5,
-                         phy_struct->sss_im_5);
-            for(j=0; j<62; j++)
-            {
-                k                              = j - 31 + (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl)/2;
-                phy_struct->sss_mod_re_0[i][k] = phy_struct->sss_re_0[j];
-                phy_struct->sss_mod_im_0[i][k] = phy_struct->sss_im_0[j];
-                phy_struct->sss_mod_re_5[i][k] = phy_struct->sss_re_5[j];
-                phy_struct->sss_mod_im_5[i][k] = phy_struct->sss_im_5[j];
-            }
-        }
         sss_thresh = pss_thresh * 0.9;
 
-        // Demod symbol and search for secondary synchronization signals
+        // Demod symbol and correlate the SSS subcarriers with every
+        // N_id_1 for both subframe 0 and subframe 5
         samples_to_symbols_dl(phy_struct,
                               i_samps,
                               q_samps,
@@ -5326,48 +6987,46 @@ LIBLTE_ERROR_ENUM liblte_phy_find_sss(LIBLTE_PHY_STRUCT *phy_struct,
                               0,
                               phy_struct->rx_symb_re,
                               phy_struct->rx_symb_im);
+        k = (phy_struct->cell->N_rb_dl*phy_struct->cell->N_sc_rb_dl)/2 - 31;
+        for(j=0; j<62; j++)
+        {
+            y_re[j] = phy_struct->rx_symb_re[k+j];
+            y_im[j] = phy_struct->rx_symb_im[k+j];
+        }
+        for(j=62; j<64; j++)
+        {
+            y_re[j] = 0;
+            y_im[j] = 0;
+        }
+        PHY_KERNELS.sss_correlate(&phy_struct->cell->sss_ref[N_id_2][0][0][0],
+                                  2*168,
+                                  y_re,
+                                  y_im,
+                                  &abs_corr[0][0]);
+
+        // Search for secondary synchronization signals
         for(i=0; i<168; i++)
         {
-            corr_re = 0;
-            corr_im = 0;
-            for(j=0; j<(phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl); j++)
-            {
-                corr_re += (phy_struct->rx_symb_re[j]*phy_struct->sss_mod_re_0[i][j] +
-                            phy_struct->rx_symb_im[j]*phy_struct->sss_mod_im_0[i][j]);
-                corr_im += (phy_struct->rx_symb_re[j]*phy_struct->sss_mod_im_0[i][j] -
-                            phy_struct->rx_symb_im[j]*phy_struct->sss_mod_re_0[i][j]);
-            }
-            abs_corr = sqrt(corr_re*corr_re + corr_im*corr_im);
-            if(abs_corr > sss_thresh)
+            if(abs_corr[0][i] > sss_thresh)
             {
-                while(symb_starts[5] < ((phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_else)*4 + phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_0))
+                while(symb_starts[5] < ((phy_struct->cell->N_samps_per_symb + phy_struct->cell->N_samps_cp_l_else)*4 + phy_struct->cell->N_samps_per_symb + phy_struct->cell->N_samps_cp_l_0))
                 {
-                    symb_starts[5] += phy_struct->N_samps_per_frame;
+                    symb_starts[5] += phy_struct->cell->N_samps_per_frame;
                 }
                 *N_id_1          = i;
-                *frame_start_idx = symb_starts[5] - ((phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_else)*4 + phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_0);
+                *frame_start_idx = symb_starts[5] - ((phy_struct->cell->N_samps_per_symb + phy_struct->cell->N_samps_cp_l_else)*4 + phy_struct->cell->N_samps_per_symb + phy_struct->cell->N_samps_cp_l_0);
                 err              = LIBLTE_SUCCESS;
                 break;
             }
 
-            corr_re = 0;
-            corr_im = 0;
-            for(j=0; j<(phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl); j++)
-            {
-                corr_re += (phy_struct->rx_symb_re[j]*phy_struct->sss_mod_re_5[i][j] +
-                            phy_struct->rx_symb_im[j]*phy_struct->sss_mod_im_5[i][j]);
-                corr_im += (phy_struct->rx_symb_re[j]*phy_struct->sss_mod_im_5[i][j] -
-                            phy_struct->rx_symb_im[j]*phy_struct->sss_mod_re_5[i][j]);
-            }
-            abs_corr = sqrt(corr_re*corr_re + corr_im*corr_im);
-            if(abs_corr > sss_thresh)
+            if(abs_corr[1][i] > sss_thresh)
             {
-                while(symb_starts[5] < (((phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_else)*4 + phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_0) + phy_struct->N_samps_per_slot*10))
+                while(symb_starts[5] < (((phy_struct->cell->N_samps_per_symb + phy_struct->cell->N_samps_cp_l_else)*4 + phy_struct->cell->N_samps_per_symb + phy_struct->cell->N_samps_cp_l_0) + phy_struct->cell->N_samps_per_slot*10))
                 {
-                    symb_starts[5] += phy_struct->N_samps_per_frame;
+                    symb_starts[5] += phy_struct->cell->N_samps_per_frame;
                 }
                 *N_id_1          = i;
-                *frame_start_idx = symb_starts[5] - ((phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_else)*4 + phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_0) - phy_struct->N_samps_per_slot*10;
+                *frame_start_idx = symb_starts[5] - ((phy_struct->cell->N_samps_per_symb + phy_struct->cell->N_samps_cp_l_else)*4 + phy_struct->cell->N_samps_per_symb + phy_struct->cell->N_samps_cp_l_0) - phy_struct->cell->N_samps_per_slot*10;
                 err              = LIBLTE_SUCCESS;
                 break;
             }
@@ -5405,7 +7064,7 @@ LIBLTE_ERROR_ENUM liblte_phy_dl_find_coarse_timing_and_freq_offset(LIBLTE_PHY_ST
     uint32            j;
     uint32            k;
     uint32            idx;
-    uint32            N_samps_per_symb_else = phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_else;
+    uint32            N_samps_per_symb_else = phy_struct->cell->N_samps_per_symb + phy_struct->cell->N_samps_cp_l_else;
     uint32            N_samps_to_blank      = N_samps_per_symb_else/10;
 
     if(phy_struct    != NULL &&
@@ -5413,47 +7072,45 @@ LIBLTE_ERROR_ENUM liblte_phy_dl_find_coarse_timing_and_freq_offset(LIBLTE_PHY_ST
        q_samps       != NULL &&
        timing_struct != NULL)
     {
+        // Scratch, allocated on first use
+        if(NULL == phy_struct->dl_sync_scratch)
+        {
+            phy_struct->dl_sync_scratch = (LIBLTE_PHY_DL_SYNC_SCRATCH_STRUCT *)malloc(sizeof(LIBLTE_PHY_DL_SYNC_SCRATCH_STRUCT));
+        }
+
         // Timing correlation
-        for(i=0; i<phy_struct->N_samps_per_slot; i++)
+        for(i=0; i<phy_struct->cell->N_samps_per_slot; i++)
         {
-            phy_struct->dl_timing_abs_corr[i] = 0;
+            phy_struct->dl_sync_scratch->dl_timing_abs_corr[i] = 0;
         }
         for(slot=0; slot<N_slots; slot++)
         {
-            for(i=0; i<phy_struct->N_samps_per_slot; i++)
-            {
-                corr_re = 0;
-                corr_im = 0;
-                for(j=0; j<phy_struct->N_samps_cp_l_else; j++)
-                {
-                    idx      = (slot*phy_struct->N_samps_per_slot) + i + j;
-                    corr_re += i_samps[idx]*i_samps[idx+phy_struct->N_samps_per_symb] + q_samps[idx]*q_samps[idx+phy_struct->N_samps_per_symb];
-                    corr_im += i_samps[idx]*q_samps[idx+phy_struct->N_samps_per_symb] - q_samps[idx]*i_samps[idx+phy_struct->N_samps_per_symb];
-                }
-                phy_struct->dl_timing_abs_corr[i] += corr_re*corr_re + corr_im*corr_im;
-            }
+            dl_timing_cp_corr(phy_struct,
+                              &i_samps[slot*phy_struct->cell->N_samps_per_slot],
+                              &q_samps[slot*phy_struct->cell->N_samps_per_slot],
+                              phy_struct->dl_sync_scratch->dl_timing_abs_corr);
         }
 
         // Find mean of correlation and gate correlation results
-        for(i=0; i<phy_struct->N_samps_per_slot; i++)
+        for(i=0; i<phy_struct->cell->N_samps_per_slot; i++)
         {
-            corr_mean                                                      += phy_struct->dl_timing_abs_corr[i];
-            phy_struct->dl_timing_abs_corr[i+phy_struct->N_samps_per_slot]  = phy_struct->dl_timing_abs_corr[i];
+            corr_mean                                                                            += phy_struct->dl_sync_scratch->dl_timing_abs_corr[i];
+            phy_struct->dl_sync_scratch->dl_timing_abs_corr[i+phy_struct->cell->N_samps_per_slot] = phy_struct->dl_sync_scratch->dl_timing_abs_corr[i];
         }
-        corr_mean /= phy_struct->N_samps_per_slot;
-        for(i=0; i<phy_struct->N_samps_per_slot; i++)
+        corr_mean /= phy_struct->cell->N_samps_per_slot;
+        for(i=0; i<phy_struct->cell->N_samps_per_slot; i++)
         {
-            if(phy_struct->dl_timing_abs_corr[i] <= corr_mean)
+            if(phy_struct->dl_sync_scratch->dl_timing_abs_corr[i] <= corr_mean)
             {
-                phy_struct->dl_timing_abs_corr[i]                              = 0;
-                phy_struct->dl_timing_abs_corr[i+phy_struct->N_samps_per_slot] = 0;
+                phy_struct->dl_sync_scratch->dl_timing_abs_corr[i]                                    = 0;
+                phy_struct->dl_sync_scratch->dl_timing_abs_corr[i+phy_struct->cell->N_samps_per_slot] = 0;
             }
         }
 
         // Multiply to get (first_symbol * fourth_symbol)
-        for(i=0; i<phy_struct->N_samps_per_slot; i++)
+        for(i=0; i<phy_struct->cell->N_samps_per_slot; i++)
         {
-            phy_struct->dl_timing_abs_corr[i] *= phy_struct->dl_timing_abs_corr[(phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_0+(phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_else)*3)+i];
+            phy_struct->dl_sync_scratch->dl_timing_abs_corr[i] *= phy_struct->dl_sync_scratch->dl_timing_abs_corr[(phy_struct->cell->N_samps_per_symb+phy_struct->cell->N_samps_cp_l_0+(phy_struct->cell->N_samps_per_symb+phy_struct->cell->N_samps_cp_l_else)*3)+i];
         }
 
         // Search for all of the eNB signals
@@ -5462,11 +7119,11 @@ LIBLTE_ERROR_ENUM liblte_phy_dl_find_coarse_timing_and_freq_offset(LIBLTE_PHY_ST
         {
             abs_corr_max    = 0;
             abs_corr_idx[i] = 0;
-            for(j=0; j<phy_struct->N_samps_per_slot; j++)
+            for(j=0; j<phy_struct->cell->N_samps_per_slot; j++)
             {
-                if(phy_struct->dl_timing_abs_corr[j] > abs_corr_max)
+                if(phy_struct->dl_sync_scratch->dl_timing_abs_corr[j] > abs_corr_max)
                 {
-                    abs_corr_max    = phy_struct->dl_timing_abs_corr[j];
+                    abs_corr_max    = phy_struct->dl_sync_scratch->dl_timing_abs_corr[j];
                     abs_corr_idx[i] = j;
                 }
             }
@@ -5491,7 +7148,7 @@ LIBLTE_ERROR_ENUM liblte_phy_dl_find_coarse_timing_and_freq_offset(LIBLTE_PHY_ST
                         if(idx >= 0 &&
                            idx <= (LIBLTE_PHY_N_SAMPS_PER_SLOT_30_72MHZ*2))
                         {
-                            phy_struct->dl_timing_abs_corr[idx] = 0;
+                            phy_struct->dl_sync_scratch->dl_timing_abs_corr[idx] = 0;
                         }
                     }
                 }
@@ -5509,13 +7166,13 @@ LIBLTE_ERROR_ENUM liblte_phy_dl_find_coarse_timing_and_freq_offset(LIBLTE_PHY_ST
             {
                 corr_re = 0;
                 corr_im = 0;
-                for(j=0; j<phy_struct->N_samps_cp_l_else; j++)
+                for(j=0; j<phy_struct->cell->N_samps_cp_l_else; j++)
                 {
-                    idx      = (slot*phy_struct->N_samps_per_slot) + abs_corr_idx[i] + j;
-                    corr_re += i_samps[idx]*i_samps[idx+phy_struct->N_samps_per_symb] + q_samps[idx]*q_samps[idx+phy_struct->N_samps_per_symb];
-                    corr_im += i_samps[idx]*q_samps[idx+phy_struct->N_samps_per_symb] - q_samps[idx]*i_samps[idx+phy_struct->N_samps_per_symb];
+                    idx      = (slot*phy_struct->cell->N_samps_per_slot) + abs_corr_idx[i] + j;
+                    corr_re += i_samps[idx]*i_samps[idx+phy_struct->cell->N_samps_per_symb] + q_samps[idx]*q_samps[idx+phy_struct->cell->N_samps_per_symb];
+                    corr_im += i_samps[idx]*q_samps[idx+phy_struct->cell->N_samps_per_symb] - q_samps[idx]*i_samps[idx+phy_struct->cell->N_samps_per_symb];
                 }
-                freq_err[i] += atan2f(corr_im, corr_re)/(phy_struct->N_samps_per_symb*2*M_PI*(0.0005/phy_struct->N_samps_per_slot));
+                freq_err[i] += atan2f(corr_im, corr_re)/(phy_struct->cell->N_samps_per_symb*2*M_PI*(0.0005/phy_struct->cell->N_samps_per_slot));
             }
         }
         for(i=0; i<timing_struct->n_corr_peaks; i++)
@@ -5558,9 +7215,6 @@ LIBLTE_ERROR_ENUM liblte_phy_create_dl_subframe(LIBLTE_PHY_STRUCT          *phy_
                                                 float                      *q_samps)
 {
     LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            idx     = 0;
-    uint32            N_samps = 0;
 
     if(phy_struct != NULL &&
        subframe   != NULL &&
@@ -5568,17 +7222,12 @@ LIBLTE_ERROR_ENUM liblte_phy_create_dl_subframe(LIBLTE_PHY_STRUCT          *phy_
        q_samps    != NULL)
     {
         // Modulate symbols
-        for(i=0; i<14; i++)
-        {
-            idx += N_samps;
-            symbols_to_samples_dl(phy_struct,
-                                  &subframe->tx_symb_re[ant][i][0],
-                                  &subframe->tx_symb_im[ant][i][0],
-                                  i,
-                                  &i_samps[idx],
-                                  &q_samps[idx],
-                                  &N_samps);
-        }
+        symbols_to_samples_dl_subframe(phy_struct,
+                                       &subframe->tx_symb_re[ant][0][0],
+                                       &subframe->tx_symb_im[ant][0][0],
+                                       LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP,
+                                       i_samps,
+                                       q_samps);
 
         err = LIBLTE_SUCCESS;
     }
@@ -5603,28 +7252,9 @@ LIBLTE_ERROR_ENUM liblte_phy_get_dl_subframe_and_ce(LIBLTE_PHY_STRUCT          *
                                                     uint8                       N_ant,
                                                     LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
 {
-    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_INPUTS;
-    float             *sym_re;
-    float             *sym_im;
-    float             *rs_re;
-    float             *rs_im;
-    float              tmp_re;
-    float              tmp_im;
-    float              frac_mag = 0;
-    float              frac_ang = 0;
-    float              ce_mag;
-    float              ce_ang;
-    uint32             v_shift         = N_id_cell % 6;
-    uint32             subfr_start_idx = frame_start_idx + subfr_num*phy_struct->N_samps_per_subfr;
-    uint32             N_sym;
-    uint32             m_prime;
-    uint32             i;
-    uint32             j;
-    uint32             k = 0;
-    uint32             p;
-    uint32             v[5];
-    uint32             sym[5];
-    uint32             z;
+    LIBLTE_ERROR_ENUM err             = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            subfr_start_idx = frame_start_idx + subfr_num*phy_struct->cell->N_samps_per_subfr;
+    uint32            i;
 
     if(phy_struct != NULL &&
        i_samps    != NULL &&
@@ -5634,14 +7264,29 @@ LIBLTE_ERROR_ENUM liblte_phy_get_dl_subframe_and_ce(LIBLTE_PHY_STRUCT          *
         N_ant     == 4)   &&
        subframe   != NULL)
     {
+        // Scratch, allocated on first use
+        if(NULL == phy_struct->dl_ce_scratch)
+        {
+            phy_struct->dl_ce_scratch = (LIBLTE_PHY_DL_CE_SCRATCH_STRUCT *)malloc(sizeof(LIBLTE_PHY_DL_CE_SCRATCH_STRUCT));
+        }
+
         subframe->num = subfr_num;
-        for(i=0; i<16; i++)
+
+        // Demodulate symbols, the first two symbols of the next
+        // subframe are also needed for channel estimation
+        samples_to_symbols_dl_subframe(phy_struct,
+                                       i_samps,
+                                       q_samps,
+                                       subfr_start_idx,
+                                       &subframe->rx_symb_re[0][0],
+                                       &subframe->rx_symb_im[0][0],
+                                       LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP);
+        for(i=14; i<16; i++)
         {
-            // Demodulate symbols
             samples_to_symbols_dl(phy_struct,
                                   i_samps,
                                   q_samps,
-                                  subfr_start_idx + (i/7)*phy_struct->N_samps_per_slot,
+                                  subfr_start_idx + (i/7)*phy_struct->cell->N_samps_per_slot,
                                   i%7,
                                   0,
                                   &subframe->rx_symb_re[i][0],
@@ -5649,240 +7294,22 @@ LIBLTE_ERROR_ENUM liblte_phy_get_dl_subframe_and_ce(LIBLTE_PHY_STRUCT          *
         }
 
         // Generate cell specific reference signals
-        generate_crs((subfr_num*2+0)%20, 0, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->dl_ce_crs_re[0],  phy_struct->dl_ce_crs_im[0]);
-        generate_crs((subfr_num*2+0)%20, 1, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->dl_ce_crs_re[1],  phy_struct->dl_ce_crs_im[1]);
-        generate_crs((subfr_num*2+0)%20, 4, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->dl_ce_crs_re[4],  phy_struct->dl_ce_crs_im[4]);
-        generate_crs((subfr_num*2+1)%20, 0, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->dl_ce_crs_re[7],  phy_struct->dl_ce_crs_im[7]);
-        generate_crs((subfr_num*2+1)%20, 1, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->dl_ce_crs_re[8],  phy_struct->dl_ce_crs_im[8]);
-        generate_crs((subfr_num*2+1)%20, 4, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->dl_ce_crs_re[11], phy_struct->dl_ce_crs_im[11]);
-        generate_crs((subfr_num*2+2)%20, 0, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->dl_ce_crs_re[14], phy_struct->dl_ce_crs_im[14]);
-        generate_crs((subfr_num*2+2)%20, 1, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->dl_ce_crs_re[15], phy_struct->dl_ce_crs_im[15]);
+        generate_crs((subfr_num*2+0)%20, 0, N_id_cell, phy_struct->cell->N_sc_rb_dl, phy_struct->dl_ce_scratch->dl_ce_crs_re[0],  phy_struct->dl_ce_scratch->dl_ce_crs_im[0]);
+        generate_crs((subfr_num*2+0)%20, 1, N_id_cell, phy_struct->cell->N_sc_rb_dl, phy_struct->dl_ce_scratch->dl_ce_crs_re[1],  phy_struct->dl_ce_scratch->dl_ce_crs_im[1]);
+        generate_crs((subfr_num*2+0)%20, 4, N_id_cell, phy_struct->cell->N_sc_rb_dl, phy_struct->dl_ce_scratch->dl_ce_crs_re[4],  phy_struct->dl_ce_scratch->dl_ce_crs_im[4]);
+        generate_crs((subfr_num*2+1)%20, 0, N_id_cell, phy_struct->cell->N_sc_rb_dl, phy_struct->dl_ce_scratch->dl_ce_crs_re[7],  phy_struct->dl_ce_scratch->dl_ce_crs_im[7]);
+        generate_crs((subfr_num*2+1)%20, 1, N_id_cell, phy_struct->cell->N_sc_rb_dl, phy_struct->dl_ce_scratch->dl_ce_crs_re[8],  phy_struct->dl_ce_scratch->dl_ce_crs_im[8]);
+        generate_crs((subfr_num*2+1)%20, 4, N_id_cell, phy_struct->cell->N_sc_rb_dl, phy_struct->dl_ce_scratch->dl_ce_crs_re[11], phy_struct->dl_ce_scratch->dl_ce_crs_im[11]);
+        generate_crs((subfr_num*2+2)%20, 0, N_id_cell, phy_struct->cell->N_sc_rb_dl, phy_struct->dl_ce_scratch->dl_ce_crs_re[14], phy_struct->dl_ce_scratch->dl_ce_crs_im[14]);
+        generate_crs((subfr_num*2+2)%20, 1, N_id_cell, phy_struct->cell->N_sc_rb_dl, phy_struct->dl_ce_scratch->dl_ce_crs_re[15], phy_struct->dl_ce_scratch->dl_ce_crs_im[15]);
 
         // Determine channel estimates
-        for(p=0; p<N_ant; p++)
+        subframe->rx_noise_var_valid = false;
+        if(LIBLTE_PHY_DL_CE_TYPE_POLAR == phy_struct->dl_ce_type)
         {
-            // Define v, sym, and N_sym
-            if(p == 0)
-            {
-                v[0]   = 0;
-                v[1]   = 3;
-                v[2]   = 0;
-                v[3]   = 3;
-                v[4]   = 0;
-                sym[0] = 0;
-                sym[1] = 4;
-                sym[2] = 7;
-                sym[3] = 11;
-                sym[4] = 14;
-                N_sym  = 5;
-            }else if(p == 1){
-                v[0]   = 3;
-                v[1]   = 0;
-                v[2]   = 3;
-                v[3]   = 0;
-                v[4]   = 3;
-                sym[0] = 0;
-                sym[1] = 4;
-                sym[2] = 7;
-                sym[3] = 11;
-                sym[4] = 14;
-                N_sym  = 5;
-            }else if(p == 2){
-                v[0]   = 0;
-                v[1]   = 3;
-                v[2]   = 0;
-                sym[0] = 1;
-                sym[1] = 8;
-                sym[2] = 15;
-                N_sym  = 3;
-            }else{ // p == 3
-                v[0]   = 3;
-                v[1]   = 6;
-                v[2]   = 3;
-                sym[0] = 1;
-                sym[1] = 8;
-                sym[2] = 15;
-                N_sym  = 3;
-            }
-
-            for(i=0; i<N_sym; i++)
-            {
-                sym_re = &subframe->rx_symb_re[sym[i]][0];
-                sym_im = &subframe->rx_symb_im[sym[i]][0];
-                rs_re  = &phy_struct->dl_ce_crs_re[sym[i]][0];
-                rs_im  = &phy_struct->dl_ce_crs_im[sym[i]][0];
-
-                for(j=0; j<2*phy_struct->N_rb_dl; j++)
-                {
-                    k                           = 6*j + (v[i] + v_shift)%6;
-                    m_prime                     = j + LIBLTE_PHY_N_RB_DL_MAX - phy_struct->N_rb_dl;
-                    tmp_re                      = sym_re[k]*rs_re[m_prime] + sym_im[k]*rs_im[m_prime];
-                    tmp_im                      = sym_im[k]*rs_re[m_prime] - sym_re[k]*rs_im[m_prime];
-                    phy_struct->dl_ce_mag[i][k] = sqrt(tmp_re*tmp_re + tmp_im*tmp_im);
-                    phy_struct->dl_ce_ang[i][k] = atan2f(tmp_im, tmp_re);
-
-                    // Unwrap phase
-                    if(j > 0)
-                    {
-                        wrap_phase(&phy_struct->dl_ce_ang[i][k], phy_struct->dl_ce_ang[i][k-6]);
-
-                        // Linearly interpolate between CRSs
-                        frac_mag = (phy_struct->dl_ce_mag[i][k] - phy_struct->dl_ce_mag[i][k-6])/6;
-                        frac_ang = (phy_struct->dl_ce_ang[i][k] - phy_struct->dl_ce_ang[i][k-6])/6;
-                        for(z=1; z<6; z++)
-                        {
-                            phy_struct->dl_ce_mag[i][k-z] = phy_struct->dl_ce_mag[i][k-(z-1)] - frac_mag;
-                            phy_struct->dl_ce_ang[i][k-z] = phy_struct->dl_ce_ang[i][k-(z-1)] - frac_ang;
-                        }
-                    }
-
-                    // Linearly interpolate before 1st CRS
-                    if(j == 1)
-                    {
-                        for(z=1; z<((v[i] + v_shift)%6)+1; z++)
-                        {
-                            phy_struct->dl_ce_mag[i][k-6-z] = phy_struct->dl_ce_mag[i][k-6-(z-1)] - frac_mag;
-                            phy_struct->dl_ce_ang[i][k-6-z] = phy_struct->dl_ce_ang[i][k-6-(z-1)] - frac_ang;
-                        }
-                    }
-                }
-
-                // Linearly interpolate after last CRS
-                for(z=1; z<(5-(v[i] + v_shift)%6)+1; z++)
-                {
-                    phy_struct->dl_ce_mag[i][k+z] = phy_struct->dl_ce_mag[i][k+(z-1)] - frac_mag;
-                    phy_struct->dl_ce_ang[i][k+z] = phy_struct->dl_ce_ang[i][k+(z-1)] - frac_ang;
-                }
-            }
-
-            // Linearly interpolate between symbols to construct all channel estimates
-            if(N_sym == 3)
-            {
-                for(j=0; j<phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl; j++)
-                {
-                    // Construct symbol 1 and 8 channel estimates directly
-                    subframe->rx_ce_re[p][1][j] = phy_struct->dl_ce_mag[0][j]*cosf(phy_struct->dl_ce_ang[0][j]);
-                    subframe->rx_ce_im[p][1][j] = phy_struct->dl_ce_mag[0][j]*sinf(phy_struct->dl_ce_ang[0][j]);
-                    subframe->rx_ce_re[p][8][j] = phy_struct->dl_ce_mag[1][j]*cosf(phy_struct->dl_ce_ang[1][j]);
-                    subframe->rx_ce_im[p][8][j] = phy_struct->dl_ce_mag[1][j]*sinf(phy_struct->dl_ce_ang[1][j]);
-
-                    // Interpolate for symbol 2, 3, 4, 5, 6, and 7 channel estimates
-                    frac_mag = (phy_struct->dl_ce_mag[1][j] - phy_struct->dl_ce_mag[0][j])/7;
-                    wrap_phase(&phy_struct->dl_ce_ang[1][j], phy_struct->dl_ce_ang[0][j]);
-                    frac_ang = (phy_struct->dl_ce_ang[1][j] - phy_struct->dl_ce_ang[0][j]);
-                    wrap_phase(&frac_ang, 0);
-                    frac_ang /= 7;
-                    ce_mag    = phy_struct->dl_ce_mag[1][j];
-                    ce_ang    = phy_struct->dl_ce_ang[1][j];
-                    for(z=7; z>1; z--)
-                    {
-                        ce_mag                      -= frac_mag;
-                        ce_ang                      -= frac_ang;
-                        subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
-                        subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
-                    }
-
-                    // Interpolate for symbol 0 channel estimate
-                    // FIXME: Use previous slot to do this correctly
-                    ce_mag                      = phy_struct->dl_ce_mag[0][j] - frac_mag;
-                    ce_ang                      = phy_struct->dl_ce_ang[0][j] - frac_ang;
-                    subframe->rx_ce_re[p][0][j] = ce_mag*cosf(ce_ang);
-                    subframe->rx_ce_im[p][0][j] = ce_mag*sinf(ce_ang);
-
-                    // Interpolate for symbol 9, 10, 11, 12, and 13 channel estimates
-                    frac_mag = (phy_struct->dl_ce_mag[2][j] - phy_struct->dl_ce_mag[1][j])/7;
-                    wrap_phase(&phy_struct->dl_ce_ang[2][j], phy_struct->dl_ce_ang[1][j]);
-                    frac_ang = (phy_struct->dl_ce_ang[2][j] - phy_struct->dl_ce_ang[1][j]);
-                    wrap_phase(&frac_ang, 0);
-                    frac_ang /= 7;
-                    ce_mag    = phy_struct->dl_ce_mag[2][j] - frac_mag;
-                    ce_ang    = phy_struct->dl_ce_ang[2][j] - frac_ang;
-                    for(z=13; z>8; z--)
-                    {
-                        ce_mag                      -= frac_mag;
-                        ce_ang                      -= frac_ang;
-                        subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
-                        subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
-                    }
-                }
-            }else{
-                for(j=0; j<phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl; j++)
-                {
-                    // Construct symbol 0, 4, 7, and 11 channel estimates directly
-                    subframe->rx_ce_re[p][0][j]  = phy_struct->dl_ce_mag[0][j]*cosf(phy_struct->dl_ce_ang[0][j]);
-                    subframe->rx_ce_im[p][0][j]  = phy_struct->dl_ce_mag[0][j]*sinf(phy_struct->dl_ce_ang[0][j]);
-                    subframe->rx_ce_re[p][4][j]  = phy_struct->dl_ce_mag[1][j]*cosf(phy_struct->dl_ce_ang[1][j]);
-                    subframe->rx_ce_im[p][4][j]  = phy_struct->dl_ce_mag[1][j]*sinf(phy_struct->dl_ce_ang[1][j]);
-                    subframe->rx_ce_re[p][7][j]  = phy_struct->dl_ce_mag[2][j]*cosf(phy_struct->dl_ce_ang[2][j]);
-                    subframe->rx_ce_im[p][7][j]  = phy_struct->dl_ce_mag[2][j]*sinf(phy_struct->dl_ce_ang[2][j]);
-                    subframe->rx_ce_re[p][11][j] = phy_struct->dl_ce_mag[3][j]*cosf(phy_struct->dl_ce_ang[3][j]);
-                    subframe->rx_ce_im[p][11][j] = phy_struct->dl_ce_mag[3][j]*sinf(phy_struct->dl_ce_ang[3][j]);
-
-                    // Interpolate for symbol 1, 2, and 3 channel estimates
-                    frac_mag = (phy_struct->dl_ce_mag[1][j] - phy_struct->dl_ce_mag[0][j])/4;
-                    wrap_phase(&phy_struct->dl_ce_ang[1][j], phy_struct->dl_ce_ang[0][j]);
-                    frac_ang = (phy_struct->dl_ce_ang[1][j] - phy_struct->dl_ce_ang[0][j]);
-                    wrap_phase(&frac_ang, 0);
-                    frac_ang /= 4;
-                    ce_mag    = phy_struct->dl_ce_mag[1][j];
-                    ce_ang    = phy_struct->dl_ce_ang[1][j];
-                    for(z=3; z>0; z--)
-                    {
-                        ce_mag                      -= frac_mag;
-                        ce_ang                      -= frac_ang;
-                        subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
-                        subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
-                    }
-
-                    // Interpolate for symbol 5 and 6 channel estimates
-                    frac_mag = (phy_struct->dl_ce_mag[2][j] - phy_struct->dl_ce_mag[1][j])/3;
-                    wrap_phase(&phy_struct->dl_ce_ang[2][j], phy_struct->dl_ce_ang[1][j]);
-                    frac_ang = (phy_struct->dl_ce_ang[2][j] - phy_struct->dl_ce_ang[1][j]);
-                    wrap_phase(&frac_ang, 0);
-                    frac_ang /= 3;
-                    ce_mag    = phy_struct->dl_ce_mag[2][j];
-                    ce_ang    = phy_struct->dl_ce_ang[2][j];
-                    for(z=6; z>4; z--)
-                    {
-                        ce_mag                      -= frac_mag;
-                        ce_ang                      -= frac_ang;
-                        subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
-                        subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
-                    }
-
-                    // Interpolate for symbol 8, 9, and 10 channel estimates
-                    frac_mag = (phy_struct->dl_ce_mag[3][j] - phy_struct->dl_ce_mag[2][j])/4;
-                    wrap_phase(&phy_struct->dl_ce_ang[3][j], phy_struct->dl_ce_ang[2][j]);
-                    frac_ang = (phy_struct->dl_ce_ang[3][j] - phy_struct->dl_ce_ang[2][j]);
-                    wrap_phase(&frac_ang, 0);
-                    frac_ang /= 4;
-                    ce_mag    = phy_struct->dl_ce_mag[3][j];
-                    ce_ang    = phy_struct->dl_ce_ang[3][j];
-                    for(z=10; z>7; z--)
-                    {
-                        ce_mag                      -= frac_mag;
-                        ce_ang                      -= frac_ang;
-                        subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
-                        subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
-                    }
-
-                    // Interpolate for symbol 12 and 13 channel estimates
-                    frac_mag = (phy_struct->dl_ce_mag[4][j] - phy_struct->dl_ce_mag[3][j])/3;
-                    wrap_phase(&phy_struct->dl_ce_ang[4][j], phy_struct->dl_ce_ang[3][j]);
-                    frac_ang = (phy_struct->dl_ce_ang[4][j] - phy_struct->dl_ce_ang[3][j]);
-                    wrap_phase(&frac_ang, 0);
-                    frac_ang /= 3;
-                    ce_mag    = phy_struct->dl_ce_mag[4][j];
-                    ce_ang    = phy_struct->dl_ce_ang[4][j];
-                    for(z=13; z>11; z--)
-                    {
-                        ce_mag                      -= frac_mag;
-                        ce_ang                      -= frac_ang;
-                        subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
-                        subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
-                    }
-                }
-            }
+            dl_ce_polar(phy_struct, N_id_cell, N_ant, subframe);
+        }else{
+            dl_ce_cartesian(phy_struct, N_id_cell, N_ant, subframe);
         }
 
         err = LIBLTE_SUCCESS;
@@ -5904,24 +7331,19 @@ LIBLTE_ERROR_ENUM liblte_phy_get_ul_subframe(LIBLTE_PHY_STRUCT          *phy_str
                                              LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
 {
     LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
 
     if(phy_struct != NULL &&
        i_samps    != NULL &&
        q_samps    != NULL &&
        subframe   != NULL)
     {
-        for(i=0; i<14; i++)
-        {
-            // Demodulate symbols
-            samples_to_symbols_ul(phy_struct,
-                                  i_samps,
-                                  q_samps,
-                                  (i/7)*phy_struct->N_samps_per_slot,
-                                  i%7,
-                                  &subframe->rx_symb_re[i][0],
-                                  &subframe->rx_symb_im[i][0]);
-        }
+        // Demodulate symbols
+        samples_to_symbols_ul_subframe(phy_struct,
+                                       i_samps,
+                                       q_samps,
+                                       &subframe->rx_symb_re[0][0],
+                                       &subframe->rx_symb_im[0][0],
+                                       LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP);
 
         err = LIBLTE_SUCCESS;
     }
@@ -6179,10 +7601,11 @@ LIBLTE_ERROR_ENUM liblte_phy_get_n_cce(LIBLTE_PHY_STRUCT *phy_struct,
     uint32 N_reg_cce = 9;
 
     N_reg_phich = phy_struct->N_group_phich*3;
-    N_reg_pdcch = N_pdcch_symbs*(phy_struct->N_rb_dl*N_reg_rb) - phy_struct->N_rb_dl - N_reg_pcfich - N_reg_phich;
-    if(N_ant == 4)
+    N_reg_pdcch = N_pdcch_symbs*(phy_struct->cell->N_rb_dl*N_reg_rb) - phy_struct->cell->N_rb_dl - N_reg_pcfich - N_reg_phich;
+    if(N_ant         == 4 &&
+       N_pdcch_symbs  > 1)
     {
-        N_reg_pdcch -= phy_struct->N_rb_dl;
+        N_reg_pdcch -= phy_struct->cell->N_rb_dl;
     }
 
     *N_cce = N_reg_pdcch/N_reg_cce;
@@ -6288,7 +7711,7 @@ void transform_precoding(LIBLTE_PHY_STRUCT *phy_struct,
     uint32 j;
 
     // Calculate M_pusch_sc and 1/sqrt(M_pusch_sc)
-    M_pusch_sc               = N_prb * phy_struct->N_sc_rb_ul;
+    M_pusch_sc               = N_prb * phy_struct->cell->N_sc_rb_ul;
     one_over_sqrt_M_pusch_sc = 1/sqrt(M_pusch_sc);
 
     for(i=0; i<12; i++)
@@ -6298,7 +7721,7 @@ void transform_precoding(LIBLTE_PHY_STRUCT *phy_struct,
             phy_struct->transform_precoding_in[j][0] = x_re[i*M_pusch_sc + j];
             phy_struct->transform_precoding_in[j][1] = x_im[i*M_pusch_sc + j];
         }
-        fftwf_execute(phy_struct->transform_precoding_plan[N_prb]);
+        fftwf_execute_dft(phy_struct->cell->transform_precoding_plan[N_prb], phy_struct->transform_precoding_in, phy_struct->transform_precoding_out);
         for(j=0; j<M_pusch_sc; j++)
         {
             y_re[i*M_pusch_sc + j] = one_over_sqrt_M_pusch_sc * phy_struct->transform_precoding_out[j][0];
@@ -6325,14 +7748,15 @@ void transform_pre_decoding(LIBLTE_PHY_STRUCT *phy_struct,
                             float             *x_re,
                             float             *x_im)
 {
-    float  sqrt_M_pusch_sc;
+    float  one_over_sqrt_M_pusch_sc;
     uint32 M_pusch_sc;
     uint32 i;
     uint32 j;
 
-    // Calculate M_pusch_sc and sqrt(M_pusch_sc)
-    M_pusch_sc      = N_prb * phy_struct->N_sc_rb_ul;
-    sqrt_M_pusch_sc = sqrt(M_pusch_sc);
+    // Calculate M_pusch_sc and 1/sqrt(M_pusch_sc), the inverse DFT is
+    // unnormalized so this undoes the scaling of transform_precoding
+    M_pusch_sc               = N_prb * phy_struct->cell->N_sc_rb_ul;
+    one_over_sqrt_M_pusch_sc = 1/sqrt(M_pusch_sc);
 
     for(i=0; i<12; i++)
     {
@@ -6341,11 +7765,11 @@ void transform_pre_decoding(LIBLTE_PHY_STRUCT *phy_struct,
             phy_struct->transform_precoding_in[j][0] = y_re[i*M_pusch_sc + j];
             phy_struct->transform_precoding_in[j][1] = y_im[i*M_pusch_sc + j];
         }
-        fftwf_execute(phy_struct->transform_pre_decoding_plan[N_prb]);
+        fftwf_execute_dft(phy_struct->cell->transform_pre_decoding_plan[N_prb], phy_struct->transform_precoding_in, phy_struct->transform_precoding_out);
         for(j=0; j<M_pusch_sc; j++)
         {
-            x_re[i*M_pusch_sc + j] = sqrt_M_pusch_sc * phy_struct->transform_precoding_out[j][0];
-            x_im[i*M_pusch_sc + j] = sqrt_M_pusch_sc * phy_struct->transform_precoding_out[j][1];
+            x_re[i*M_pusch_sc + j] = one_over_sqrt_M_pusch_sc * phy_struct->transform_precoding_out[j][0];
+            x_im[i*M_pusch_sc + j] = one_over_sqrt_M_pusch_sc * phy_struct->transform_precoding_out[j][1];
         }
     }
 }
@@ -6480,7 +7904,7 @@ void generate_ul_rs(LIBLTE_PHY_STRUCT         *phy_struct,
     // Determine u
     if(group_hopping_enabled)
     {
-        generate_prs_c(N_id_cell/30, 160, phy_struct->ulrs_c);
+        generate_prs_c_cached(phy_struct, N_id_cell/30, 160, phy_struct->ulrs_c);
         f_gh = 0;
         for(i=0; i<8; i++)
         {
@@ -6499,7 +7923,7 @@ void generate_ul_rs(LIBLTE_PHY_STRUCT         *phy_struct,
     }else{
         if(!group_hopping_enabled && sequence_hopping_enabled)
         {
-            generate_prs_c(((N_id_cell/30) << 5) + f_ss, 20, phy_struct->ulrs_c);
+            generate_prs_c_cached(phy_struct, ((N_id_cell/30) << 5) + f_ss, 20, phy_struct->ulrs_c);
             v = phy_struct->ulrs_c[N_slot];
         }else{
             v = 0;
@@ -6600,7 +8024,7 @@ void generate_dmrs_pusch(LIBLTE_PHY_STRUCT *phy_struct,
     f_ss_pusch = ((N_id_cell % 30) + delta_ss) % 30;
 
     // Generate c
-    generate_prs_c(((N_id_cell/30) << 5) + f_ss_pusch, 8*N_ul_symb*20, phy_struct->dmrs_c);
+    generate_prs_c_cached(phy_struct, ((N_id_cell/30) << 5) + f_ss_pusch, 8*N_ul_symb*20, phy_struct->dmrs_c);
 
     // Calculate n_pn_ns
     n_pn_ns_1 = 0;
@@ -6694,30 +8118,30 @@ void prach_preamble_seq_gen(LIBLTE_PHY_STRUCT *phy_struct,
     uint32 N_neg_RA_shift;
     uint32 C_v;
 
-    phy_struct->prach_root_seq_idx    = root_seq_idx;
-    phy_struct->prach_preamble_format = pre_format;
-    phy_struct->prach_zczc            = zczc;
-    phy_struct->prach_hs_flag         = hs_flag;
+    phy_struct->cell->prach_root_seq_idx    = root_seq_idx;
+    phy_struct->cell->prach_preamble_format = pre_format;
+    phy_struct->cell->prach_zczc            = zczc;
+    phy_struct->cell->prach_hs_flag         = hs_flag;
 
-    phy_struct->prach_N_x_u = 0;
+    phy_struct->cell->prach_N_x_u = 0;
     while(N_gen_pre < 64)
     {
         // Determine u and N_zc
         if(4 == pre_format)
         {
-            u                      = PRACH_5_7_2_5[root_seq_idx+phy_struct->prach_N_x_u];
-            phy_struct->prach_N_zc = 139;
+            u                            = PRACH_5_7_2_5[root_seq_idx+phy_struct->cell->prach_N_x_u];
+            phy_struct->cell->prach_N_zc = 139;
         }else{
-            u                      = PRACH_5_7_2_4[root_seq_idx+phy_struct->prach_N_x_u];
-            phy_struct->prach_N_zc = 839;
+            u                            = PRACH_5_7_2_4[root_seq_idx+phy_struct->cell->prach_N_x_u];
+            phy_struct->cell->prach_N_zc = 839;
         }
 
         // Generate x_u
-        for(i=0; i<phy_struct->prach_N_zc; i++)
+        for(i=0; i<phy_struct->cell->prach_N_zc; i++)
         {
-            phase                                                = -M_PI*u*i*(i+1)/phy_struct->prach_N_zc;
-            phy_struct->prach_x_u_re[phy_struct->prach_N_x_u][i] = cos(phase);
-            phy_struct->prach_x_u_im[phy_struct->prach_N_x_u][i] = sin(phase);
+            phase                                                            = -M_PI*u*i*(i+1)/phy_struct->cell->prach_N_zc;
+            phy_struct->cell->prach_x_u_re[phy_struct->cell->prach_N_x_u][i] = cos(phase);
+            phy_struct->cell->prach_x_u_im[phy_struct->cell->prach_N_x_u][i] = sin(phase);
         }
 
         // Determine N_cs
@@ -6733,38 +8157,40 @@ void prach_preamble_seq_gen(LIBLTE_PHY_STRUCT *phy_struct,
             }
         }
 
+        phy_struct->cell->prach_N_cs = N_cs;
+
         // Determine v_max
         if(hs_flag)
         {
             // Determine d_u
-            for(p=1; p<=phy_struct->prach_N_zc; p++)
+            for(p=1; p<=phy_struct->cell->prach_N_zc; p++)
             {
-                if(((p*u) % phy_struct->prach_N_zc) == 1)
+                if(((p*u) % phy_struct->cell->prach_N_zc) == 1)
                 {
                     break;
                 }
             }
-            if(p >= 0 && p < phy_struct->prach_N_zc/2)
+            if(p >= 0 && p < phy_struct->cell->prach_N_zc/2)
             {
                 d_u = p;
             }else{
-                d_u = phy_struct->prach_N_zc - p;
+                d_u = phy_struct->cell->prach_N_zc - p;
             }
 
             // Determine N_RA_shift, d_start, N_RA_group, and N_neg_RA_shift
-            if(d_u >= N_cs && d_u < phy_struct->prach_N_zc/3)
+            if(d_u >= N_cs && d_u < phy_struct->cell->prach_N_zc/3)
             {
                 N_RA_shift     = d_u/N_cs;
                 d_start        = 2*d_u + N_RA_shift*N_cs;
-                N_RA_group     = phy_struct->prach_N_zc/d_start;
-                N_neg_RA_shift = (phy_struct->prach_N_zc - 2*d_u - N_RA_group*d_start)/N_cs;
+                N_RA_group     = phy_struct->cell->prach_N_zc/d_start;
+                N_neg_RA_shift = (phy_struct->cell->prach_N_zc - 2*d_u - N_RA_group*d_start)/N_cs;
                 if(N_neg_RA_shift < 0)
                 {
                     N_neg_RA_shift = 0;
                 }
             }else{
-                N_RA_shift     = (phy_struct->prach_N_zc - 2*d_u)/N_cs;
-                d_start        = phy_struct->prach_N_zc - 2*d_u + N_RA_shift*N_cs;
+                N_RA_shift     = (phy_struct->cell->prach_N_zc - 2*d_u)/N_cs;
+                d_start        = phy_struct->cell->prach_N_zc - 2*d_u + N_RA_shift*N_cs;
                 N_RA_group     = d_u/d_start;
                 N_neg_RA_shift = (d_u - N_RA_group*d_start)/N_cs;
                 if(N_neg_RA_shift < 0)
@@ -6785,7 +8211,7 @@ void prach_preamble_seq_gen(LIBLTE_PHY_STRUCT *phy_struct,
             {
                 v_max = 0;
             }else{
-                v_max = (phy_struct->prach_N_zc/N_cs)-1;
+                v_max = (phy_struct->cell->prach_N_zc/N_cs)-1;
             }
         }
 
@@ -6801,11 +8227,13 @@ void prach_preamble_seq_gen(LIBLTE_PHY_STRUCT *phy_struct,
                 C_v = v*N_cs;
             }
 
-            for(i=0; i<phy_struct->prach_N_zc; i++)
+            for(i=0; i<phy_struct->cell->prach_N_zc; i++)
             {
-                phy_struct->prach_x_u_v_re[N_gen_pre][i] = phy_struct->prach_x_u_re[phy_struct->prach_N_x_u][(i+C_v) % phy_struct->prach_N_zc];
-                phy_struct->prach_x_u_v_im[N_gen_pre][i] = phy_struct->prach_x_u_im[phy_struct->prach_N_x_u][(i+C_v) % phy_struct->prach_N_zc];
+                phy_struct->cell->prach_x_u_v_re[N_gen_pre][i] = phy_struct->cell->prach_x_u_re[phy_struct->cell->prach_N_x_u][(i+C_v) % phy_struct->cell->prach_N_zc];
+                phy_struct->cell->prach_x_u_v_im[N_gen_pre][i] = phy_struct->cell->prach_x_u_im[phy_struct->cell->prach_N_x_u][(i+C_v) % phy_struct->cell->prach_N_zc];
             }
+            phy_struct->cell->prach_pre_root[N_gen_pre] = phy_struct->cell->prach_N_x_u;
+            phy_struct->cell->prach_pre_C_v[N_gen_pre]  = C_v;
 
             // Determine if enough preambles are generated
             N_gen_pre++;
@@ -6816,7 +8244,35 @@ void prach_preamble_seq_gen(LIBLTE_PHY_STRUCT *phy_struct,
         }
 
         // Move to the next root sequence
-        phy_struct->prach_N_x_u++;
+        phy_struct->cell->prach_N_x_u++;
+    }
+}
+
+/*********************************************************************
+    Name: prach_corr_mult
+
+    Description: Multiplies the received PRACH subcarriers with the
+                 conjugate of every root sequence, filling the input
+                 of the batched correlation IDFT
+
+    Document Reference: N/A
+*********************************************************************/
+void prach_corr_mult(LIBLTE_PHY_STRUCT *phy_struct)
+{
+    fftwf_complex *out;
+    float         *u_re;
+    float         *u_im;
+    float         *h_re = phy_struct->prach_x_hat_re;
+    float         *h_im = phy_struct->prach_x_hat_im;
+    uint32         N_zc = phy_struct->cell->prach_N_zc;
+    uint32         i;
+
+    for(i=0; i<phy_struct->cell->prach_N_x_u; i++)
+    {
+        out  = &phy_struct->prach_corr_in[i*N_zc];
+        u_re = phy_struct->cell->prach_x_u_fft_re[i];
+        u_im = phy_struct->cell->prach_x_u_fft_im[i];
+        PHY_KERNELS.cmul_conj_interleaved(h_re, h_im, u_re, u_im, N_zc, out);
     }
 }
 
@@ -7365,7 +8821,7 @@ void pcfich_channel_map(LIBLTE_PHY_STRUCT          *phy_struct,
                        phy_struct->pdcch_encode_bits,
                        &N_bits);
     c_init = (((subframe->num + 1)*(2*N_id_cell + 1)) << 9) + N_id_cell;
-    generate_prs_c(c_init, N_bits, phy_struct->pdcch_c);
+    generate_prs_c_cached(phy_struct, c_init, N_bits, phy_struct->pdcch_c);
     for(i=0; i<N_bits; i++)
     {
         phy_struct->pdcch_scramb_bits[i] = phy_struct->pdcch_encode_bits[i] ^ phy_struct->pdcch_c[i];
@@ -7396,10 +8852,10 @@ void pcfich_channel_map(LIBLTE_PHY_STRUCT          *phy_struct,
                  &M_ap_symb);
     // Map the symbols to resource elements, 3GPP TS 36.211 v10.1.0 section 6.7.4
     pcfich->N_reg = 4;
-    k_hat         = (phy_struct->N_sc_rb_dl/2)*(N_id_cell % (2*phy_struct->N_rb_dl));
+    k_hat         = (phy_struct->cell->N_sc_rb_dl/2)*(N_id_cell % (2*phy_struct->cell->N_rb_dl));
     for(i=0; i<pcfich->N_reg; i++)
     {
-        pcfich->k[i] = (k_hat + (i*phy_struct->N_rb_dl/2)*phy_struct->N_sc_rb_dl/2) % (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl);
+        pcfich->k[i] = (k_hat + (i*phy_struct->cell->N_rb_dl/2)*phy_struct->cell->N_sc_rb_dl/2) % (phy_struct->cell->N_rb_dl*phy_struct->cell->N_sc_rb_dl);
         pcfich->n[i] = (pcfich->k[i]/6) - 0.5;
         for(p=0; p<N_ant; p++)
         {
@@ -7442,10 +8898,10 @@ void pcfich_channel_demap(LIBLTE_PHY_STRUCT          *phy_struct,
 
     // Calculate resources, 3GPP TS 36.211 v10.1.0 section 6.7.4
     pcfich->N_reg = 4;
-    k_hat         = (phy_struct->N_sc_rb_dl/2)*(N_id_cell % (2*phy_struct->N_rb_dl));
+    k_hat         = (phy_struct->cell->N_sc_rb_dl/2)*(N_id_cell % (2*phy_struct->cell->N_rb_dl));
     for(i=0; i<pcfich->N_reg; i++)
     {
-        pcfich->k[i] = (k_hat + (i*phy_struct->N_rb_dl/2)*phy_struct->N_sc_rb_dl/2) % (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl);
+        pcfich->k[i] = (k_hat + (i*phy_struct->cell->N_rb_dl/2)*phy_struct->cell->N_sc_rb_dl/2) % (phy_struct->cell->N_rb_dl*phy_struct->cell->N_sc_rb_dl);
         pcfich->n[i] = (pcfich->k[i]/6) - 0.5;
 
         // Extract resource elements and channel estimate
@@ -7467,7 +8923,7 @@ void pcfich_channel_demap(LIBLTE_PHY_STRUCT          *phy_struct,
     }
     // Decode, 3GPP TS 36.211 v10.1.0 section 6.7
     c_init = (((subframe->num + 1)*(2*N_id_cell + 1)) << 9) + N_id_cell;
-    generate_prs_c(c_init, 32, phy_struct->pdcch_c);
+    generate_prs_c_cached(phy_struct, c_init, 32, phy_struct->pdcch_c);
     pre_decoder_and_matched_filter_dl(phy_struct->pdcch_y_est_re,
                                       phy_struct->pdcch_y_est_im,
                                       phy_struct->pdcch_c_est_re[0],
@@ -7490,6 +8946,7 @@ void pcfich_channel_demap(LIBLTE_PHY_STRUCT          *phy_struct,
                       &M_symb);
     modulation_demapper(phy_struct->pdcch_d_re,
                         phy_struct->pdcch_d_im,
+                        NULL,
                         M_symb,
                         LIBLTE_PHY_MODULATION_TYPE_QPSK,
                         phy_struct->pdcch_soft_bits,
@@ -7525,12 +8982,25 @@ void pdcch_permute_pre_calc(LIBLTE_PHY_STRUCT *phy_struct,
     uint32 N_symbs;
     uint32 N_reg_pcfich = 4;
     uint32 N_reg_phich;
+    uint32 N_symbs_max;
 
     N_reg_phich = phy_struct->N_group_phich*3;
 
-    for(N_symbs=1; N_symbs<=3; N_symbs++)
+    // 3GPP TS 36.211 v10.1.0 section 6.7, small bandwidths use one extra symbol
+    N_symbs_max = 3;
+    if(phy_struct->cell->N_rb_dl <= 10)
+    {
+        N_symbs_max = 4;
+    }
+    for(N_symbs=1; N_symbs<=N_symbs_max; N_symbs++)
     {
-        N_reg_pdcch = N_symbs*(phy_struct->N_rb_dl*N_reg_rb) - phy_struct->N_rb_dl - N_reg_pcfich - N_reg_phich;
+        N_reg_pdcch = N_symbs*(phy_struct->cell->N_rb_dl*N_reg_rb) - phy_struct->cell->N_rb_dl - N_reg_pcfich - N_reg_phich;
+        if(N_ant   == 4 &&
+           N_symbs  > 1)
+        {
+            // Match the REGs left by the CRS of antenna ports 2 and 3
+            N_reg_pdcch -= phy_struct->cell->N_rb_dl;
+        }
         for(i=0; i<N_reg_pdcch; i++)
         {
             phy_struct->pdcch_reg_vec[i] = i;
@@ -7600,7 +9070,7 @@ void pdcch_permute_pre_calc(LIBLTE_PHY_STRUCT *phy_struct,
         {
             for(i=0; i<N_reg_pdcch; i++)
             {
-                phy_struct->pdcch_permute_map[N_reg_pdcch][i] = phy_struct->pdcch_reg_perm_vec[i];
+                phy_struct->cell->pdcch_permute_map[N_reg_pdcch][i] = phy_struct->pdcch_reg_perm_vec[i];
             }
         }
     }
@@ -7646,7 +9116,7 @@ void phich_channel_map(LIBLTE_PHY_STRUCT              *phy_struct,
     phich->N_reg = phy_struct->N_group_phich*3;
 
     c_init = (((subframe->num + 1)*(2*N_id_cell + 1)) << 9) + N_id_cell;
-    generate_prs_c(c_init, 12, phy_struct->pdcch_c);
+    generate_prs_c_cached(phy_struct, c_init, 12, phy_struct->pdcch_c);
     idx = 0;
     for(m_prime=0; m_prime<phy_struct->N_group_phich; m_prime++)
     {
@@ -7712,7 +9182,7 @@ void phich_channel_map(LIBLTE_PHY_STRUCT              *phy_struct,
             // Step 7
             l_prime = 0;
             // Step 1, 2, and 3
-            n_l_prime = phy_struct->N_rb_dl*2 - pcfich->N_reg;
+            n_l_prime = phy_struct->cell->N_rb_dl*2 - pcfich->N_reg;
             // Step 8
             for(i=0; i<3; i++)
             {
@@ -7779,11 +9249,11 @@ void phich_channel_demap(LIBLTE_PHY_STRUCT              *phy_struct,
     uint32 idx;
 
     // Calculate resources, 3GPP TS 36.211 v10.1.0 section 6.9
-    if(LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP == phy_struct->N_sc_rb_dl)
+    if(LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP == phy_struct->cell->N_sc_rb_dl)
     {
-        phy_struct->N_group_phich = (uint32)ceilf((float)phich_res*((float)phy_struct->N_rb_dl/(float)8));
+        phy_struct->N_group_phich = (uint32)ceilf((float)phich_res*((float)phy_struct->cell->N_rb_dl/(float)8));
     }else{
-        phy_struct->N_group_phich = 2*(uint32)ceilf((float)phich_res*((float)phy_struct->N_rb_dl/(float)8));
+        phy_struct->N_group_phich = 2*(uint32)ceilf((float)phich_res*((float)phy_struct->cell->N_rb_dl/(float)8));
     }
     phich->N_reg = phy_struct->N_group_phich*3;
     // Step 4
@@ -7797,7 +9267,7 @@ void phich_channel_demap(LIBLTE_PHY_STRUCT              *phy_struct,
             // Step 7
             l_prime = 0;
             // Step 1, 2, and 3
-            n_l_prime = phy_struct->N_rb_dl*2 - pcfich->N_reg;
+            n_l_prime = phy_struct->cell->N_rb_dl*2 - pcfich->N_reg;
             // Step 8
             for(i=0; i<3; i++)
             {
@@ -7907,6 +9377,124 @@ void generate_pss(uint32  N_id_2,
     }
 }
 
+/*********************************************************************
+    Name: pss_corr_pre_calc
+
+    Description: Builds the overlap-save correlation filters for each
+                 N_id_2 and for frequency offsets of -1, 0, and +1
+                 subcarriers
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.1
+*********************************************************************/
+void pss_corr_pre_calc(LIBLTE_PHY_STRUCT *phy_struct)
+{
+    LIBLTE_PHY_CELL_STRUCT *cell  = phy_struct->cell;
+    float                   pss_re[63];
+    float                   pss_im[63];
+    float                   scale = 1/(float)(cell->N_samps_per_symb*2);
+    int32                   k;
+    uint32                  bin;
+    uint32                  N_id_2;
+    uint32                  hyp;
+    uint32                  i;
+
+    for(N_id_2=0; N_id_2<3; N_id_2++)
+    {
+        generate_pss(N_id_2, pss_re, pss_im);
+        for(hyp=0; hyp<3; hyp++)
+        {
+            // Map the PSS to FFT bins around DC, shifted by hyp-1
+            // subcarriers, the same way samples_to_symbols_dl unmaps them
+            for(i=0; i<cell->N_samps_per_symb; i++)
+            {
+                phy_struct->s2s_in[i][0] = 0;
+                phy_struct->s2s_in[i][1] = 0;
+            }
+            for(i=0; i<62; i++)
+            {
+                k = (int32)i - 31 + (int32)hyp - 1;
+                if(k >= 0)
+                {
+                    bin = k + 1;
+                }else{
+                    bin = cell->N_samps_per_symb + k;
+                }
+                phy_struct->s2s_in[bin][0] = pss_re[i];
+                phy_struct->s2s_in[bin][1] = pss_im[i];
+            }
+            fftwf_execute_dft(cell->symbs_to_samps_dl_plan, phy_struct->s2s_in, phy_struct->s2s_out);
+
+            // Zero pad to twice the symbol length and keep the scaled
+            // conjugate of the spectrum as the correlation filter
+            for(i=0; i<cell->N_samps_per_symb; i++)
+            {
+                phy_struct->s2s_in[i][0]                        = phy_struct->s2s_out[i][0];
+                phy_struct->s2s_in[i][1]                        = phy_struct->s2s_out[i][1];
+                phy_struct->s2s_in[cell->N_samps_per_symb+i][0] = 0;
+                phy_struct->s2s_in[cell->N_samps_per_symb+i][1] = 0;
+            }
+            fftwf_execute_dft(cell->samps_to_symbs_ul_plan, phy_struct->s2s_in, phy_struct->s2s_out);
+            for(i=0; i<cell->N_samps_per_symb*2; i++)
+            {
+                cell->pss_corr_re[N_id_2][hyp][i] = phy_struct->s2s_out[i][0]*scale;
+                cell->pss_corr_im[N_id_2][hyp][i] = -phy_struct->s2s_out[i][1]*scale;
+            }
+        }
+    }
+}
+
+/*********************************************************************
+    Name: pss_corr_block
+
+    Description: Correlates a block of samples against the time domain
+                 PSS using overlap-save, producing the correlation
+                 magnitude at N_offsets consecutive sample offsets
+
+    Document Reference: N/A
+*********************************************************************/
+void pss_corr_block(LIBLTE_PHY_STRUCT *phy_struct,
+                    float             *i_samps,
+                    float             *q_samps,
+                    uint32             N_offsets,
+                    uint32             N_id_2,
+                    uint32             freq_hyp,
+                    float             *abs_corr)
+{
+    LIBLTE_PHY_CELL_STRUCT *cell    = phy_struct->cell;
+    fftwf_complex          *x       = &phy_struct->s2s_out[0];
+    fftwf_complex          *corr    = &phy_struct->s2s_out[cell->N_samps_per_symb*2];
+    float                  *w_re    = cell->pss_corr_re[N_id_2][freq_hyp];
+    float                  *w_im    = cell->pss_corr_im[N_id_2][freq_hyp];
+    uint32                  N_fft   = cell->N_samps_per_symb*2;
+    uint32                  N_samps = N_offsets + cell->N_samps_per_symb - 1;
+    uint32                  i;
+
+    // Only the first N_samps_per_symb+1 outputs are free of wrap
+    // around, so N_offsets must not exceed that.  Samples past the
+    // ones those outputs use are zeroed rather than read.
+    for(i=0; i<N_samps; i++)
+    {
+        phy_struct->s2s_in[i][0] = i_samps[i];
+        phy_struct->s2s_in[i][1] = q_samps[i];
+    }
+    for(i=N_samps; i<N_fft; i++)
+    {
+        phy_struct->s2s_in[i][0] = 0;
+        phy_struct->s2s_in[i][1] = 0;
+    }
+    fftwf_execute_dft(cell->samps_to_symbs_ul_plan, phy_struct->s2s_in, x);
+    for(i=0; i<N_fft; i++)
+    {
+        phy_struct->s2s_in[i][0] = x[i][0]*w_re[i] - x[i][1]*w_im[i];
+        phy_struct->s2s_in[i][1] = x[i][0]*w_im[i] + x[i][1]*w_re[i];
+    }
+    fftwf_execute_dft(cell->symbs_to_samps_ul_plan, phy_struct->s2s_in, corr);
+    for(i=0; i<N_offsets; i++)
+    {
+        abs_corr[i] = sqrt(corr[i][0]*corr[i][0] + corr[i][1]*corr[i][1]);
+    }
+}
+
 /*********************************************************************
     Name: generate_sss
 
@@ -8014,59 +9602,357 @@ void generate_sss(LIBLTE_PHY_STRUCT *phy_struct,
 }
 
 /*********************************************************************
-    Name: symbols_to_samples_dl
+    Name: dl_timing_cp_corr
 
-    Description: Converts subcarrier symbols to I/Q samples for the
-                 downlink
+    Description: Accumulates the magnitude squared of the cyclic
+                 prefix auto-correlation at every sample offset of a
+                 slot, sliding the correlation window one sample at a
+                 time
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.12
+    Document Reference: N/A
 *********************************************************************/
-void symbols_to_samples_dl(LIBLTE_PHY_STRUCT *phy_struct,
-                           float             *symb_re,
-                           float             *symb_im,
-                           uint32             symbol_offset,
-                           float             *samps_re,
-                           float             *samps_im,
-                           uint32            *N_samps)
+void dl_timing_cp_corr(LIBLTE_PHY_STRUCT *phy_struct,
+                       float             *i_samps,
+                       float             *q_samps,
+                       float             *abs_corr)
 {
-    uint32 CP_len;
+    float  *prod_re = phy_struct->dl_sync_scratch->dl_timing_prod_re;
+    float  *prod_im = phy_struct->dl_sync_scratch->dl_timing_prod_im;
+    double  corr_re = 0;
+    double  corr_im = 0;
+    uint32  N_symb  = phy_struct->cell->N_samps_per_symb;
+    uint32  N_cp    = phy_struct->cell->N_samps_cp_l_else;
+    uint32  N_slot  = phy_struct->cell->N_samps_per_slot;
+    uint32  N_prod  = N_slot + N_cp - 1;
+    uint32  i;
+
+    // Product of each sample with the sample one symbol later,
+    // conj(x[n])*x[n+N_symb]
+    PHY_KERNELS.cmul_conj(i_samps,
+                          q_samps,
+                          &i_samps[N_symb],
+                          &q_samps[N_symb],
+                          N_prod,
+                          prod_re,
+                          prod_im);
+
+    // Slide the window across the slot, adding the newest product and
+    // dropping the oldest.  The running sum is kept in double so that
+    // the add/drop rounding does not build up over the slot.
+    for(i=0; i<N_cp; i++)
+    {
+        corr_re += prod_re[i];
+        corr_im += prod_im[i];
+    }
+    for(i=0; i<N_slot; i++)
+    {
+        abs_corr[i] += (float)(corr_re*corr_re + corr_im*corr_im);
+        if((i+N_cp) < N_prod)
+        {
+            corr_re += prod_re[i+N_cp] - prod_re[i];
+            corr_im += prod_im[i+N_cp] - prod_im[i];
+        }
+    }
+}
+
+/*********************************************************************
+    Name: sss_pre_calc
+
+    Description: Builds the SSS references for every N_id_2 and N_id_1
+                 in subframes 0 and 5, keeping only the 62 subcarriers
+                 the SSS occupies
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.2.1
+*********************************************************************/
+void sss_pre_calc(LIBLTE_PHY_STRUCT *phy_struct)
+{
+    LIBLTE_PHY_CELL_STRUCT *cell = phy_struct->cell;
+    uint32                  N_id_1;
+    uint32                  N_id_2;
+
+    memset(cell->sss_ref, 0, sizeof(cell->sss_ref));
+    for(N_id_2=0; N_id_2<3; N_id_2++)
+    {
+        for(N_id_1=0; N_id_1<168; N_id_1++)
+        {
+            // The SSS is real valued, so only the real parts are kept
+            generate_sss(phy_struct,
+                         N_id_1,
+                         N_id_2,
+                         phy_struct->sss_re_0,
+                         phy_struct->sss_im_0,
+                         phy_struct->sss_re_5,
+                         phy_struct->sss_im_5);
+            memcpy(cell->sss_ref[N_id_2][0][N_id_1], phy_struct->sss_re_0, sizeof(float)*62);
+            memcpy(cell->sss_ref[N_id_2][1][N_id_1], phy_struct->sss_re_5, sizeof(float)*62);
+        }
+    }
+}
+
+/*********************************************************************
+    Name: sss_correlate_scalar
+
+    Description: Correlates the received SSS subcarriers against N_refs
+                 real valued SSS references as one matrix-vector
+                 product, producing the correlation magnitude for each
+
+    Document Reference: N/A
+*********************************************************************/
+void sss_correlate_scalar(float  *sss_ref,
+                          uint32  N_refs,
+                          float  *y_re,
+                          float  *y_im,
+                          float  *abs_corr)
+{
+    float  corr_re;
+    float  corr_im;
     uint32 i;
+    uint32 j;
 
-    // Calculate index and CP length
-    if((symbol_offset % 7) == 0)
+    // Each reference is padded to 64 subcarriers with zeros, y_re and
+    // y_im must be padded the same way
+    for(i=0; i<N_refs; i++)
     {
-        CP_len = phy_struct->N_samps_cp_l_0;
-    }else{
-        CP_len = phy_struct->N_samps_cp_l_else;
+        corr_re = 0;
+        corr_im = 0;
+        for(j=0; j<64; j++)
+        {
+            corr_re += sss_ref[i*64+j]*y_re[j];
+            corr_im += sss_ref[i*64+j]*y_im[j];
+        }
+        abs_corr[i] = sqrt(corr_re*corr_re + corr_im*corr_im);
     }
+}
+
+#if defined(__SSE2__)
+/*********************************************************************
+    Name: sss_correlate_sse2
+
+    Description: SSE2 version of sss_correlate_scalar
+
+    Document Reference: N/A
+*********************************************************************/
+void sss_correlate_sse2(float  *sss_ref,
+                        uint32  N_refs,
+                        float  *y_re,
+                        float  *y_im,
+                        float  *abs_corr)
+{
+    float  corr_re;
+    float  corr_im;
+    float  re_4[4];
+    float  im_4[4];
+    uint32 i;
+    uint32 j;
+    __m128 re_v;
+    __m128 im_v;
+    __m128 s_v;
 
-    for(i=0; i<phy_struct->N_samps_per_symb; i++)
+    for(i=0; i<N_refs; i++)
     {
-        phy_struct->s2s_in[i][0] = 0;
-        phy_struct->s2s_in[i][1] = 0;
+        re_v = _mm_setzero_ps();
+        im_v = _mm_setzero_ps();
+        for(j=0; j<64; j+=4)
+        {
+            s_v  = _mm_loadu_ps(&sss_ref[i*64+j]);
+            re_v = _mm_add_ps(re_v, _mm_mul_ps(s_v, _mm_loadu_ps(&y_re[j])));
+            im_v = _mm_add_ps(im_v, _mm_mul_ps(s_v, _mm_loadu_ps(&y_im[j])));
+        }
+        _mm_storeu_ps(re_4, re_v);
+        _mm_storeu_ps(im_4, im_v);
+        corr_re     = (re_4[0] + re_4[1]) + (re_4[2] + re_4[3]);
+        corr_im     = (im_4[0] + im_4[1]) + (im_4[2] + im_4[3]);
+        abs_corr[i] = sqrt(corr_re*corr_re + corr_im*corr_im);
+    }
+}
+#endif
+
+#if defined(PHY_KERNEL_X86)
+/*********************************************************************
+    Name: sss_correlate_avx2
+
+    Description: AVX2 version of sss_correlate_scalar
+
+    Document Reference: N/A
+*********************************************************************/
+PHY_TARGET_AVX2
+void sss_correlate_avx2(float  *sss_ref,
+                        uint32  N_refs,
+                        float  *y_re,
+                        float  *y_im,
+                        float  *abs_corr)
+{
+    float  corr_re;
+    float  corr_im;
+    float  re_4[4];
+    float  im_4[4];
+    uint32 i;
+    uint32 j;
+    __m256 y_re_v[8];
+    __m256 y_im_v[8];
+    __m256 re_v;
+    __m256 im_v;
+    __m256 s_v;
+
+    // The received subcarriers are the same for every reference
+    for(j=0; j<8; j++)
+    {
+        y_re_v[j] = _mm256_loadu_ps(&y_re[j*8]);
+        y_im_v[j] = _mm256_loadu_ps(&y_im[j*8]);
+    }
+    for(i=0; i<N_refs; i++)
+    {
+        re_v = _mm256_setzero_ps();
+        im_v = _mm256_setzero_ps();
+        for(j=0; j<8; j++)
+        {
+            s_v  = _mm256_loadu_ps(&sss_ref[i*64+j*8]);
+            re_v = _mm256_add_ps(re_v, _mm256_mul_ps(s_v, y_re_v[j]));
+            im_v = _mm256_add_ps(im_v, _mm256_mul_ps(s_v, y_im_v[j]));
+        }
+        _mm_storeu_ps(re_4, _mm_add_ps(_mm256_castps256_ps128(re_v), _mm256_extractf128_ps(re_v, 1)));
+        _mm_storeu_ps(im_4, _mm_add_ps(_mm256_castps256_ps128(im_v), _mm256_extractf128_ps(im_v, 1)));
+        corr_re     = (re_4[0] + re_4[1]) + (re_4[2] + re_4[3]);
+        corr_im     = (im_4[0] + im_4[1]) + (im_4[2] + im_4[3]);
+        abs_corr[i] = sqrt(corr_re*corr_re + corr_im*corr_im);
+    }
+}
+
+/*********************************************************************
+    Name: hsum_avx512
+
+    Description: Sums the 16 values of an AVX-512 register, halving
+                 with zero masked extracts.  _mm512_reduce_add_ps and
+                 _mm512_castps512_ps256 leave the extract source
+                 undefined, which shows up as -Wmaybe-uninitialized.
+
+    Document Reference: N/A
+*********************************************************************/
+PHY_TARGET_AVX512
+float hsum_avx512(__m512 v)
+{
+    float   v_4[4];
+    __m512d v_pd = _mm512_castps_pd(v);
+    __m256  v_8;
+
+    v_8 = _mm256_add_ps(_mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xFF, v_pd, 0)),
+                        _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xFF, v_pd, 1)));
+    _mm_storeu_ps(v_4, _mm_add_ps(_mm256_castps256_ps128(v_8), _mm256_extractf128_ps(v_8, 1)));
+
+    return((v_4[0] + v_4[1]) + (v_4[2] + v_4[3]));
+}
+
+/*********************************************************************
+    Name: sss_correlate_avx512
+
+    Description: AVX-512 version of sss_correlate_scalar
+
+    Document Reference: N/A
+*********************************************************************/
+PHY_TARGET_AVX512
+void sss_correlate_avx512(float  *sss_ref,
+                          uint32  N_refs,
+                          float  *y_re,
+                          float  *y_im,
+                          float  *abs_corr)
+{
+    float  corr_re;
+    float  corr_im;
+    uint32 i;
+    uint32 j;
+    __m512 y_re_v[4];
+    __m512 y_im_v[4];
+    __m512 re_v;
+    __m512 im_v;
+    __m512 s_v;
+
+    for(j=0; j<4; j++)
+    {
+        y_re_v[j] = _mm512_loadu_ps(&y_re[j*16]);
+        y_im_v[j] = _mm512_loadu_ps(&y_im[j*16]);
+    }
+    for(i=0; i<N_refs; i++)
+    {
+        re_v = _mm512_setzero_ps();
+        im_v = _mm512_setzero_ps();
+        for(j=0; j<4; j++)
+        {
+            s_v  = _mm512_loadu_ps(&sss_ref[i*64+j*16]);
+            re_v = _mm512_add_ps(re_v, _mm512_mul_ps(s_v, y_re_v[j]));
+            im_v = _mm512_add_ps(im_v, _mm512_mul_ps(s_v, y_im_v[j]));
+        }
+        corr_re     = hsum_avx512(re_v);
+        corr_im     = hsum_avx512(im_v);
+        abs_corr[i] = sqrt(corr_re*corr_re + corr_im*corr_im);
     }
-    for(i=0; i<(phy_struct->FFT_size/2)-phy_struct->FFT_pad_size; i++)
+}
+#endif
+
+/*********************************************************************
+    Name: symbols_to_samples_dl_subframe
+
+    Description: Converts the subcarrier symbols of a downlink
+                 subframe to I/Q samples, transforming all 14 symbols
+                 with one batched IFFT that writes directly into the
+                 output between the cyclic prefixes
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.12
+*********************************************************************/
+void symbols_to_samples_dl_subframe(LIBLTE_PHY_STRUCT *phy_struct,
+                                    float             *symb_re,
+                                    float             *symb_im,
+                                    uint32             symb_stride,
+                                    float             *samps_re,
+                                    float             *samps_im)
+{
+    LIBLTE_PHY_CELL_STRUCT *cell   = phy_struct->cell;
+    float                  *in_re  = (float *)phy_struct->s2s_in;
+    float                  *in_im  = &in_re[14*cell->N_samps_per_symb];
+    uint32                  N      = cell->N_samps_per_symb;
+    uint32                  N_half = (cell->FFT_size/2) - cell->FFT_pad_size;
+    uint32                  CP_len;
+    uint32                  idx;
+    uint32                  L;
+
+    // Map each symbol into its FFT bins, leaving DC and the guard
+    // bands empty
+    for(L=0; L<14; L++)
     {
+        in_re[L*N] = 0;
+        in_im[L*N] = 0;
+        memset(&in_re[L*N+N_half+1], 0, sizeof(float)*(N-2*N_half-1));
+        memset(&in_im[L*N+N_half+1], 0, sizeof(float)*(N-2*N_half-1));
+
         // Positive spectrum
-        phy_struct->s2s_in[i+1][0] = symb_re[i+((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)];
-        phy_struct->s2s_in[i+1][1] = symb_im[i+((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)];
+        memcpy(&in_re[L*N+1], &symb_re[L*symb_stride+N_half], sizeof(float)*N_half);
+        memcpy(&in_im[L*N+1], &symb_im[L*symb_stride+N_half], sizeof(float)*N_half);
 
         // Negative spectrum
-        phy_struct->s2s_in[phy_struct->N_samps_per_symb-i-1][0] = symb_re[((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)-i-1];
-        phy_struct->s2s_in[phy_struct->N_samps_per_symb-i-1][1] = symb_im[((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)-i-1];
-    }
-    fftwf_execute(phy_struct->symbs_to_samps_dl_plan);
-    for(i=0; i<phy_struct->N_samps_per_symb; i++)
-    {
-        samps_re[CP_len+i] = phy_struct->s2s_out[i][0];
-        samps_im[CP_len+i] = phy_struct->s2s_out[i][1];
+        memcpy(&in_re[L*N+N-N_half], &symb_re[L*symb_stride], sizeof(float)*N_half);
+        memcpy(&in_im[L*N+N-N_half], &symb_im[L*symb_stride], sizeof(float)*N_half);
     }
-    for(i=0; i<CP_len; i++)
+
+    // The split plan computes a forward transform, swapping the real
+    // and imaginary arrays on both sides makes it a backward one
+    fftwf_execute_split_dft(cell->symbs_to_samps_dl_subfr_plan,
+                            in_im,
+                            in_re,
+                            &samps_im[cell->N_samps_cp_l_0],
+                            &samps_re[cell->N_samps_cp_l_0]);
+
+    // Fill in the cyclic prefixes
+    for(L=0; L<14; L++)
     {
-        samps_re[i] = samps_re[phy_struct->N_samps_per_symb+i];
-        samps_im[i] = samps_im[phy_struct->N_samps_per_symb+i];
+        if((L % 7) == 0)
+        {
+            CP_len = cell->N_samps_cp_l_0;
+        }else{
+            CP_len = cell->N_samps_cp_l_else;
+        }
+        idx = (L/7)*cell->N_samps_per_slot + cell->N_samps_cp_l_0 + (L%7)*(N+cell->N_samps_cp_l_else);
+        memcpy(&samps_re[idx-CP_len], &samps_re[idx+N-CP_len], sizeof(float)*CP_len);
+        memcpy(&samps_im[idx-CP_len], &samps_im[idx+N-CP_len], sizeof(float)*CP_len);
     }
-    *N_samps = phy_struct->N_samps_per_symb + CP_len;
 }
 
 /*********************************************************************
@@ -8092,34 +9978,34 @@ void symbols_to_samples_ul(LIBLTE_PHY_STRUCT *phy_struct,
     // Calculate index and CP length
     if((symbol_offset % 7) == 0)
     {
-        CP_len = phy_struct->N_samps_cp_l_0;
+        CP_len = phy_struct->cell->N_samps_cp_l_0;
     }else{
-        CP_len = phy_struct->N_samps_cp_l_else;
+        CP_len = phy_struct->cell->N_samps_cp_l_else;
     }
 
-    for(i=0; i<phy_struct->N_samps_per_symb; i++)
+    for(i=0; i<phy_struct->cell->N_samps_per_symb; i++)
     {
         phy_struct->s2s_in[i][0] = 0;
         phy_struct->s2s_in[i][1] = 0;
     }
-    for(i=0; i<phy_struct->FFT_size-(phy_struct->FFT_pad_size/2); i++)
+    for(i=0; i<phy_struct->cell->FFT_size-(phy_struct->cell->FFT_pad_size/2); i++)
     {
-        idx                        = ((i*phy_struct->FFT_pad_size+phy_struct->FFT_size/2)*2+1)%(phy_struct->FFT_size*2);
+        idx                        = ((i*phy_struct->cell->FFT_pad_size+phy_struct->cell->FFT_size/2)*2+1)%(phy_struct->cell->FFT_size*2);
         phy_struct->s2s_in[idx][0] = symb_re[i];
         phy_struct->s2s_in[idx][1] = symb_im[i];
     }
-    fftwf_execute(phy_struct->symbs_to_samps_ul_plan);
-    for(i=0; i<phy_struct->N_samps_per_symb; i++)
+    fftwf_execute_dft(phy_struct->cell->symbs_to_samps_ul_plan, phy_struct->s2s_in, phy_struct->s2s_out);
+    for(i=0; i<phy_struct->cell->N_samps_per_symb; i++)
     {
         samps_re[CP_len+i] = phy_struct->s2s_out[i][0];
         samps_im[CP_len+i] = phy_struct->s2s_out[i][1];
     }
     for(i=0; i<CP_len; i++)
     {
-        samps_re[i] = samps_re[phy_struct->N_samps_per_symb+i];
-        samps_im[i] = samps_im[phy_struct->N_samps_per_symb+i];
+        samps_re[i] = samps_re[phy_struct->cell->N_samps_per_symb+i];
+        samps_im[i] = samps_im[phy_struct->cell->N_samps_per_symb+i];
     }
-    *N_samps = phy_struct->N_samps_per_symb + CP_len;
+    *N_samps = phy_struct->cell->N_samps_per_symb + CP_len;
 }
 
 /*********************************************************************
@@ -8146,88 +10032,383 @@ void samples_to_symbols_dl(LIBLTE_PHY_STRUCT *phy_struct,
     // Calculate index and CP length
     if((symbol_offset % 7) == 0)
     {
-        CP_len = phy_struct->N_samps_cp_l_0;
+        CP_len = phy_struct->cell->N_samps_cp_l_0;
     }else{
-        CP_len = phy_struct->N_samps_cp_l_else;
+        CP_len = phy_struct->cell->N_samps_cp_l_else;
     }
-    index = slot_start_idx + (phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_else)*symbol_offset;
+    index = slot_start_idx + (phy_struct->cell->N_samps_per_symb+phy_struct->cell->N_samps_cp_l_else)*symbol_offset;
     if(symbol_offset > 0)
     {
-        index += phy_struct->N_samps_cp_l_0 - phy_struct->N_samps_cp_l_else;
+        index += phy_struct->cell->N_samps_cp_l_0 - phy_struct->cell->N_samps_cp_l_else;
     }
 
-    for(i=0; i<phy_struct->N_samps_per_symb; i++)
+    for(i=0; i<phy_struct->cell->N_samps_per_symb; i++)
     {
         phy_struct->s2s_in[i][0] = samps_re[index+CP_len-1+i];
         phy_struct->s2s_in[i][1] = samps_im[index+CP_len-1+i];
     }
-    fftwf_execute(phy_struct->samps_to_symbs_dl_plan);
-    for(i=0; i<(phy_struct->FFT_size/2)-phy_struct->FFT_pad_size; i++)
+    fftwf_execute_dft(phy_struct->cell->samps_to_symbs_dl_plan, phy_struct->s2s_in, phy_struct->s2s_out);
+    for(i=0; i<(phy_struct->cell->FFT_size/2)-phy_struct->cell->FFT_pad_size; i++)
     {
         // Positive spectrum
-        symb_re[i+((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)] = phy_struct->s2s_out[i+1][0];
-        symb_im[i+((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)] = phy_struct->s2s_out[i+1][1];
+        symb_re[i+((phy_struct->cell->FFT_size/2)-phy_struct->cell->FFT_pad_size)] = phy_struct->s2s_out[i+1][0];
+        symb_im[i+((phy_struct->cell->FFT_size/2)-phy_struct->cell->FFT_pad_size)] = phy_struct->s2s_out[i+1][1];
 
         // Negative spectrum
-        symb_re[((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)-i-1] = phy_struct->s2s_out[phy_struct->N_samps_per_symb-i-1][0];
-        symb_im[((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)-i-1] = phy_struct->s2s_out[phy_struct->N_samps_per_symb-i-1][1];
+        symb_re[((phy_struct->cell->FFT_size/2)-phy_struct->cell->FFT_pad_size)-i-1] = phy_struct->s2s_out[phy_struct->cell->N_samps_per_symb-i-1][0];
+        symb_im[((phy_struct->cell->FFT_size/2)-phy_struct->cell->FFT_pad_size)-i-1] = phy_struct->s2s_out[phy_struct->cell->N_samps_per_symb-i-1][1];
     }
 
     if(scale == 1)
     {
-        for(i=0; i<2*((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size); i++)
+        PHY_KERNELS.normalize_unit_magnitude(symb_re,
+                                             symb_im,
+                                             2*((phy_struct->cell->FFT_size/2)-phy_struct->cell->FFT_pad_size));
+    }
+}
+
+/*********************************************************************
+    Name: normalize_unit_magnitude_scalar
+
+    Description: Scales complex values to unit magnitude, keeping their
+                 angle
+
+    Document Reference: N/A
+*********************************************************************/
+void normalize_unit_magnitude_scalar(float  *re,
+                                     float  *im,
+                                     uint32  N)
+{
+    float  mag_2;
+    float  scale;
+    uint32 i;
+
+    for(i=0; i<N; i++)
+    {
+        mag_2 = re[i]*re[i] + im[i]*im[i];
+        if(mag_2 < FLT_MIN)
         {
-            symb_re[i] = cosf(atan2f(symb_im[i], symb_re[i]));
-            symb_im[i] = sinf(atan2f(symb_im[i], symb_re[i]));
+            re[i] = 1;
+            im[i] = 0;
+        }else{
+            scale  = 1/sqrtf(mag_2);
+            re[i] *= scale;
+            im[i] *= scale;
         }
     }
 }
 
+#if defined(__SSE2__)
 /*********************************************************************
-    Name: samples_to_symbols_ul
+    Name: normalize_unit_magnitude_sse2
 
-    Description: Converts I/Q samples to subcarrier symbols for the
-                 uplink
+    Description: SSE2 version of normalize_unit_magnitude_scalar, 4
+                 values at a time
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.6
+    Document Reference: N/A
 *********************************************************************/
-void samples_to_symbols_ul(LIBLTE_PHY_STRUCT *phy_struct,
-                           float             *samps_re,
-                           float             *samps_im,
-                           uint32             slot_start_idx,
-                           uint32             symbol_offset,
-                           float             *symb_re,
-                           float             *symb_im)
+void normalize_unit_magnitude_sse2(float  *re,
+                                   float  *im,
+                                   uint32  N)
 {
-    uint32 CP_len;
-    uint32 index;
-    uint32 i;
-    uint32 idx;
+    __m128 re_v;
+    __m128 im_v;
+    __m128 mag_2_v;
+    __m128 scale_v;
+    __m128 zero_v;
+    __m128 min_v   = _mm_set1_ps(FLT_MIN);
+    __m128 one_v   = _mm_set1_ps(1);
+    __m128 half_v  = _mm_set1_ps(0.5);
+    __m128 three_v = _mm_set1_ps(3);
+    uint32 i       = 0;
+
+    for(; i+4<=N; i+=4)
+    {
+        re_v    = _mm_loadu_ps(&re[i]);
+        im_v    = _mm_loadu_ps(&im[i]);
+        mag_2_v = _mm_add_ps(_mm_mul_ps(re_v, re_v), _mm_mul_ps(im_v, im_v));
+
+        // rsqrt is good to 12 bits, one Newton-Raphson step brings it
+        // to about 23
+        scale_v = _mm_rsqrt_ps(mag_2_v);
+        scale_v = _mm_mul_ps(_mm_mul_ps(half_v, scale_v),
+                             _mm_sub_ps(three_v, _mm_mul_ps(mag_2_v, _mm_mul_ps(scale_v, scale_v))));
+        re_v    = _mm_mul_ps(re_v, scale_v);
+        im_v    = _mm_mul_ps(im_v, scale_v);
+
+        // Values too small to scale have an angle of 0, as atan2f gives
+        zero_v = _mm_cmplt_ps(mag_2_v, min_v);
+        re_v   = _mm_or_ps(_mm_andnot_ps(zero_v, re_v), _mm_and_ps(zero_v, one_v));
+        im_v   = _mm_andnot_ps(zero_v, im_v);
+        _mm_storeu_ps(&re[i], re_v);
+        _mm_storeu_ps(&im[i], im_v);
+    }
+    normalize_unit_magnitude_scalar(&re[i], &im[i], N-i);
+}
+#endif
 
-    // Calculate index and CP length
-    if((symbol_offset % 7) == 0)
+#if defined(PHY_KERNEL_X86)
+/*********************************************************************
+    Name: normalize_unit_magnitude_avx2
+
+    Description: AVX2 version of normalize_unit_magnitude_scalar, 8
+                 values at a time
+
+    Document Reference: N/A
+*********************************************************************/
+PHY_TARGET_AVX2
+void normalize_unit_magnitude_avx2(float  *re,
+                                   float  *im,
+                                   uint32  N)
+{
+    __m256 re_v;
+    __m256 im_v;
+    __m256 mag_2_v;
+    __m256 scale_v;
+    __m256 zero_v;
+    __m256 min_v   = _mm256_set1_ps(FLT_MIN);
+    __m256 one_v   = _mm256_set1_ps(1);
+    __m256 half_v  = _mm256_set1_ps(0.5);
+    __m256 three_v = _mm256_set1_ps(3);
+    uint32 i       = 0;
+
+    for(; i+8<=N; i+=8)
     {
-        CP_len = phy_struct->N_samps_cp_l_0;
-    }else{
-        CP_len = phy_struct->N_samps_cp_l_else;
+        re_v    = _mm256_loadu_ps(&re[i]);
+        im_v    = _mm256_loadu_ps(&im[i]);
+        mag_2_v = _mm256_add_ps(_mm256_mul_ps(re_v, re_v), _mm256_mul_ps(im_v, im_v));
+        scale_v = _mm256_rsqrt_ps(mag_2_v);
+        scale_v = _mm256_mul_ps(_mm256_mul_ps(half_v, scale_v),
+                                _mm256_sub_ps(three_v, _mm256_mul_ps(mag_2_v, _mm256_mul_ps(scale_v, scale_v))));
+        zero_v  = _mm256_cmp_ps(mag_2_v, min_v, _CMP_LT_OQ);
+        re_v    = _mm256_blendv_ps(_mm256_mul_ps(re_v, scale_v), one_v, zero_v);
+        im_v    = _mm256_andnot_ps(zero_v, _mm256_mul_ps(im_v, scale_v));
+        _mm256_storeu_ps(&re[i], re_v);
+        _mm256_storeu_ps(&im[i], im_v);
     }
-    index = slot_start_idx + (phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_else)*symbol_offset;
-    if(symbol_offset > 0)
+    normalize_unit_magnitude_scalar(&re[i], &im[i], N-i);
+}
+
+/*********************************************************************
+    Name: normalize_unit_magnitude_avx512
+
+    Description: AVX-512 version of normalize_unit_magnitude_scalar,
+                 16 values at a time.  rsqrt14 is good to 14 bits so
+                 the Newton-Raphson step brings it to full precision.
+
+    Document Reference: N/A
+*********************************************************************/
+PHY_TARGET_AVX512
+void normalize_unit_magnitude_avx512(float  *re,
+                                     float  *im,
+                                     uint32  N)
+{
+    __m512    re_v;
+    __m512    im_v;
+    __m512    mag_2_v;
+    __m512    scale_v;
+    __m512    min_v   = _mm512_set1_ps(FLT_MIN);
+    __m512    one_v   = _mm512_set1_ps(1);
+    __m512    half_v  = _mm512_set1_ps(0.5);
+    __m512    three_v = _mm512_set1_ps(3);
+    __mmask16 zero_m;
+    uint32    i       = 0;
+
+    for(; i+16<=N; i+=16)
     {
-        index += phy_struct->N_samps_cp_l_0 - phy_struct->N_samps_cp_l_else;
+        re_v    = _mm512_loadu_ps(&re[i]);
+        im_v    = _mm512_loadu_ps(&im[i]);
+        mag_2_v = _mm512_add_ps(_mm512_mul_ps(re_v, re_v), _mm512_mul_ps(im_v, im_v));
+        scale_v = _mm512_maskz_rsqrt14_ps(0xFFFF, mag_2_v);
+        scale_v = _mm512_mul_ps(_mm512_mul_ps(half_v, scale_v),
+                                _mm512_sub_ps(three_v, _mm512_mul_ps(mag_2_v, _mm512_mul_ps(scale_v, scale_v))));
+        zero_m  = _mm512_cmp_ps_mask(mag_2_v, min_v, _CMP_LT_OQ);
+        re_v    = _mm512_mask_blend_ps(zero_m, _mm512_mul_ps(re_v, scale_v), one_v);
+        im_v    = _mm512_maskz_mul_ps((__mmask16)~zero_m, im_v, scale_v);
+        _mm512_storeu_ps(&re[i], re_v);
+        _mm512_storeu_ps(&im[i], im_v);
     }
+    normalize_unit_magnitude_scalar(&re[i], &im[i], N-i);
+}
+#endif
 
-    for(i=0; i<phy_struct->N_samps_per_symb; i++)
+/*********************************************************************
+    Name: samples_to_symbols_dl_subframe
+
+    Description: Converts the I/Q samples of a downlink subframe to
+                 subcarrier symbols, transforming all 14 symbols with
+                 one batched FFT that reads directly from the input
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.12
+*********************************************************************/
+void samples_to_symbols_dl_subframe(LIBLTE_PHY_STRUCT *phy_struct,
+                                    float             *samps_re,
+                                    float             *samps_im,
+                                    uint32             subfr_start_idx,
+                                    float             *symb_re,
+                                    float             *symb_im,
+                                    uint32             symb_stride)
+{
+    LIBLTE_PHY_CELL_STRUCT *cell    = phy_struct->cell;
+    float                  *out_re  = (float *)phy_struct->s2s_out;
+    float                  *out_im  = &out_re[14*cell->N_samps_per_symb];
+    uint32                  N       = cell->N_samps_per_symb;
+    uint32                  N_half  = (cell->FFT_size/2) - cell->FFT_pad_size;
+    uint32                  L;
+
+    // Each symbol starts one sample into its cyclic prefix, the same
+    // as samples_to_symbols_dl
+    fftwf_execute_split_dft(cell->samps_to_symbs_dl_subfr_plan,
+                            &samps_re[subfr_start_idx+cell->N_samps_cp_l_0-1],
+                            &samps_im[subfr_start_idx+cell->N_samps_cp_l_0-1],
+                            out_re,
+                            out_im);
+    for(L=0; L<14; L++)
     {
-        phy_struct->s2s_in[i][0] = samps_re[index+CP_len-1+i];
-        phy_struct->s2s_in[i][1] = samps_im[index+CP_len-1+i];
+        // Positive spectrum
+        memcpy(&symb_re[L*symb_stride+N_half], &out_re[L*N+1], sizeof(float)*N_half);
+        memcpy(&symb_im[L*symb_stride+N_half], &out_im[L*N+1], sizeof(float)*N_half);
+
+        // Negative spectrum
+        memcpy(&symb_re[L*symb_stride], &out_re[L*N+N-N_half], sizeof(float)*N_half);
+        memcpy(&symb_im[L*symb_stride], &out_im[L*N+N-N_half], sizeof(float)*N_half);
+    }
+}
+
+/*********************************************************************
+    Name: samples_to_symbols_ul_subframe
+
+    Description: Converts the I/Q samples of an uplink subframe to
+                 subcarrier symbols, transforming all 14 symbols with
+                 one batched FFT
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.6
+*********************************************************************/
+void samples_to_symbols_ul_subframe(LIBLTE_PHY_STRUCT *phy_struct,
+                                    float             *samps_re,
+                                    float             *samps_im,
+                                    float             *symb_re,
+                                    float             *symb_im,
+                                    uint32             symb_stride)
+{
+    LIBLTE_PHY_CELL_STRUCT *cell     = phy_struct->cell;
+    float                  *x_re     = (float *)phy_struct->s2s_in;
+    float                  *x_im     = &x_re[14*cell->N_samps_per_symb];
+    float                  *shift_re = cell->s2s_ul_shift_re;
+    float                  *shift_im = cell->s2s_ul_shift_im;
+    float                  *in_re;
+    float                  *in_im;
+    uint32                  N        = cell->N_samps_per_symb;
+    uint32                  N_sc     = cell->FFT_size - (cell->FFT_pad_size*2);
+    uint32                  k_0      = cell->FFT_pad_size + cell->FFT_size/2;
+    uint32                  idx;
+    uint32                  L;
+
+    // Apply the half subcarrier shift, starting each symbol one sample
+    // into its cyclic prefix
+    for(L=0; L<14; L++)
+    {
+        idx   = (L/7)*cell->N_samps_per_slot + cell->N_samps_cp_l_0 - 1 + (L%7)*(N+cell->N_samps_cp_l_else);
+        in_re = &samps_re[idx];
+        in_im = &samps_im[idx];
+        PHY_KERNELS.cmul(in_re, in_im, shift_re, shift_im, N, &x_re[L*N], &x_im[L*N]);
+    }
+    fftwf_execute_split_dft(cell->samps_to_symbs_ul_subfr_plan, x_re, x_im, x_re, x_im);
+
+    // Unmap the subcarriers, the upper half of the FFT holds the lower
+    // half of the band
+    for(L=0; L<14; L++)
+    {
+        memcpy(&symb_re[L*symb_stride], &x_re[L*N+k_0], sizeof(float)*(N-k_0));
+        memcpy(&symb_im[L*symb_stride], &x_im[L*N+k_0], sizeof(float)*(N-k_0));
+        memcpy(&symb_re[L*symb_stride+N-k_0], &x_re[L*N], sizeof(float)*(N_sc-(N-k_0)));
+        memcpy(&symb_im[L*symb_stride+N-k_0], &x_im[L*N], sizeof(float)*(N_sc-(N-k_0)));
     }
-    fftwf_execute(phy_struct->samps_to_symbs_ul_plan);
-    for(i=0; i<phy_struct->FFT_size-(phy_struct->FFT_pad_size*2); i++)
+}
+
+/*********************************************************************
+    Name: s2s_subframe_pre_calc
+
+    Description: Creates the batched subframe plans used by
+                 symbols_to_samples_dl_subframe,
+                 samples_to_symbols_dl_subframe, and
+                 samples_to_symbols_ul_subframe, along with the uplink
+                 half subcarrier shift
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 5.6 and 6.12
+*********************************************************************/
+void s2s_subframe_pre_calc(LIBLTE_PHY_STRUCT *phy_struct)
+{
+    LIBLTE_PHY_CELL_STRUCT *cell    = phy_struct->cell;
+    fftwf_iodim             dim;
+    fftwf_iodim             symb_dims[2];
+    fftwf_iodim             samp_dims[2];
+    float                  *symb_re = (float *)phy_struct->s2s_in;
+    float                  *symb_im = &symb_re[14*cell->N_samps_per_symb];
+    float                  *samp_re = (float *)phy_struct->s2s_out;
+    float                  *samp_im = &samp_re[cell->N_samps_per_subfr];
+    uint32                  N       = cell->N_samps_per_symb;
+    uint32                  i;
+
+    // One symbol per transform, the symbols are packed back to back in
+    // the workspace and spaced by their cyclic prefixes in the samples
+    dim.n          = N;
+    dim.is         = 1;
+    dim.os         = 1;
+    symb_dims[0].n = 2;
+    symb_dims[1].n = 7;
+    samp_dims[0].n = 2;
+    samp_dims[1].n = 7;
+
+    // Symbols to samples
+    symb_dims[0].is = 7*N;
+    symb_dims[0].os = cell->N_samps_per_slot;
+    symb_dims[1].is = N;
+    symb_dims[1].os = N + cell->N_samps_cp_l_else;
+    cell->symbs_to_samps_dl_subfr_plan = fftwf_plan_guru_split_dft(1,
+                                                                   &dim,
+                                                                   2,
+                                                                   symb_dims,
+                                                                   symb_im,
+                                                                   symb_re,
+                                                                   &samp_im[cell->N_samps_cp_l_0],
+                                                                   &samp_re[cell->N_samps_cp_l_0],
+                                                                   FFTW_MEASURE | FFTW_UNALIGNED);
+
+    // Samples to symbols
+    samp_dims[0].is = cell->N_samps_per_slot;
+    samp_dims[0].os = 7*N;
+    samp_dims[1].is = N + cell->N_samps_cp_l_else;
+    samp_dims[1].os = N;
+    cell->samps_to_symbs_dl_subfr_plan = fftwf_plan_guru_split_dft(1,
+                                                                   &dim,
+                                                                   2,
+                                                                   samp_dims,
+                                                                   &samp_re[cell->N_samps_cp_l_0-1],
+                                                                   &samp_im[cell->N_samps_cp_l_0-1],
+                                                                   symb_re,
+                                                                   symb_im,
+                                                                   FFTW_MEASURE | FFTW_UNALIGNED);
+
+    // Uplink samples to symbols, in place in the workspace
+    symb_dims[0].os = 7*N;
+    symb_dims[1].os = N;
+    cell->samps_to_symbs_ul_subfr_plan = fftwf_plan_guru_split_dft(1,
+                                                                   &dim,
+                                                                   2,
+                                                                   symb_dims,
+                                                                   symb_re,
+                                                                   symb_im,
+                                                                   symb_re,
+                                                                   symb_im,
+                                                                   FFTW_MEASURE);
+
+    // The odd bins of a 2N point FFT of a zero padded symbol are the
+    // bins of an N point FFT of the symbol rotated by -pi*n/N
+    for(i=0; i<N; i++)
     {
-        idx        = ((i+phy_struct->FFT_pad_size+phy_struct->FFT_size/2)*2+1)%(phy_struct->FFT_size*2);
-        symb_re[i] = phy_struct->s2s_out[idx][0];
-        symb_im[i] = phy_struct->s2s_out[idx][1];
+        cell->s2s_ul_shift_re[i] = cosf(-M_PI*i/N);
+        cell->s2s_ul_shift_im[i] = sinf(-M_PI*i/N);
     }
 }
 
@@ -9003,4560 +11184,6429 @@ void modulation_mapper(uint8                           *bits,
                 d_re[N_bits/6] = -7*one_over_sqrt_42;
                 d_im[N_bits/6] = -3*one_over_sqrt_42;
                 break;
-            case 59:
-                d_re[N_bits/6] = -7*one_over_sqrt_42;
-                d_im[N_bits/6] = -1*one_over_sqrt_42;
+            case 59:
+                d_re[N_bits/6] = -7*one_over_sqrt_42;
+                d_im[N_bits/6] = -1*one_over_sqrt_42;
+                break;
+            case 60:
+                d_re[N_bits/6] = -5*one_over_sqrt_42;
+                d_im[N_bits/6] = -5*one_over_sqrt_42;
+                break;
+            case 61:
+                d_re[N_bits/6] = -5*one_over_sqrt_42;
+                d_im[N_bits/6] = -7*one_over_sqrt_42;
+                break;
+            case 62:
+                d_re[N_bits/6] = -7*one_over_sqrt_42;
+                d_im[N_bits/6] = -5*one_over_sqrt_42;
+                break;
+            case 63:
+                d_re[N_bits/6] = -7*one_over_sqrt_42;
+                d_im[N_bits/6] = -7*one_over_sqrt_42;
+                break;
+            }
+        }
+        break;
+    }
+}
+
+/*********************************************************************
+    Name: modulation_demapper
+
+    Description: Maps complex-valued modulation symbols to 8 bit max-log
+                 soft bits, positive for a binary 0.  Uses the piecewise
+                 linear LLRs of Gray mapped QAM, re and im for the first
+                 two bits, then A - |previous| for each following pair.
+                 Each RE is scaled by 1/noise_var when noise_var is not
+                 NULL, otherwise by 1/d so that a received point d from
+                 a decision boundary maps to DEMAP_INT8_UNIT.
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
+*********************************************************************/
+void modulation_demapper(float                           *d_re,
+                         float                           *d_im,
+                         float                           *noise_var,
+                         uint32                           M_symb,
+                         LIBLTE_PHY_MODULATION_TYPE_ENUM  type,
+                         int8                            *bits,
+                         uint32                          *N_bits)
+{
+    float  d;
+    float  A[6] = {0, 0, 0, 0, 0, 0};
+    float  unit_scale;
+    float  nv_scale;
+    uint32 Q_m;
+
+    // d is half the distance between neighboring points in each
+    // dimension, A holds the decision boundary for each bit pair.
+    // 3GPP TS 36.211 v10.1.0 sections 7.1.1 through 7.1.4
+    if(LIBLTE_PHY_MODULATION_TYPE_BPSK == type)
+    {
+        Q_m = 1;
+        d   = 1;
+    }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == type){
+        Q_m = 2;
+        d   = 1/sqrt(2);
+    }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == type){
+        Q_m  = 4;
+        d    = 1/sqrt(10);
+        A[2] = 2*d;
+        A[3] = 2*d;
+    }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == type
+        Q_m  = 6;
+        d    = 1/sqrt(42);
+        A[2] = 4*d;
+        A[3] = 4*d;
+        A[4] = 2*d;
+        A[5] = 2*d;
+    }
+    unit_scale = DEMAP_INT8_UNIT/d;
+    nv_scale   = 4*d*DEMAP_INT8_STEPS;
+    *N_bits = M_symb*Q_m;
+
+    PHY_KERNELS.modulation_demapper_llr(d_re,
+                                        d_im,
+                                        noise_var,
+                                        M_symb,
+                                        Q_m,
+                                        A,
+                                        unit_scale,
+                                        nv_scale,
+                                        bits);
+}
+
+/*********************************************************************
+    Name: modulation_demapper_llr_scalar
+
+    Description: Calculates the LLRs of M_symb REs for
+                 modulation_demapper, A holds the decision boundary
+                 for each bit of an RE
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
+*********************************************************************/
+void modulation_demapper_llr_scalar(float  *d_re,
+                                    float  *d_im,
+                                    float  *noise_var,
+                                    uint32  M_symb,
+                                    uint32  Q_m,
+                                    float  *A,
+                                    float   unit_scale,
+                                    float   nv_scale,
+                                    int8   *bits)
+{
+    float  one_over_sqrt_2 = 1/sqrt(2);
+    float  scale;
+    float  l[6];
+    uint32 i;
+    uint32 j;
+
+    for(i=0; i<M_symb; i++)
+    {
+        if(NULL == noise_var)
+        {
+            scale = unit_scale;
+        }else{
+            scale = nv_scale/fmaxf(noise_var[i], DEMAP_NOISE_VAR_MIN);
+        }
+        if(1 == Q_m)
+        {
+            l[0] = (d_re[i] + d_im[i])*one_over_sqrt_2;
+        }else{
+            l[0] = d_re[i];
+            l[1] = d_im[i];
+            for(j=2; j<Q_m; j++)
+            {
+                l[j] = A[j] - fabsf(l[j-2]);
+            }
+        }
+        for(j=0; j<Q_m; j++)
+        {
+            bits[i*Q_m+j] = (int8)lrintf(fminf(fmaxf(l[j]*scale, -DEMAP_INT8_MAX), DEMAP_INT8_MAX));
+        }
+    }
+}
+
+#if defined(__SSE2__)
+/*********************************************************************
+    Name: modulation_demapper_llr_sse2
+
+    Description: SSE2 version of modulation_demapper_llr_scalar,
+                 blocks of 8 REs are processed at a time
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
+*********************************************************************/
+void modulation_demapper_llr_sse2(float  *d_re,
+                                  float  *d_im,
+                                  float  *noise_var,
+                                  uint32  M_symb,
+                                  uint32  Q_m,
+                                  float  *A,
+                                  float   unit_scale,
+                                  float   nv_scale,
+                                  int8   *bits)
+{
+    __m128  sign_v;
+    __m128  max_v;
+    __m128  min_v;
+    __m128  nv_min_v;
+    __m128  A_v[6];
+    __m128  sc_v;
+    __m128  x_v[6];
+    __m128i llr_v[6][2];
+    __m128i re_v;
+    __m128i im_v;
+    __m128i pair_v[3];
+    uint16  pair_16[3][8];
+    uint32  i = 0;
+    uint32  j;
+    uint32  k;
+    uint32  q;
+
+    if(1 != Q_m)
+    {
+        sign_v   = _mm_set1_ps(-0.0f);
+        max_v    = _mm_set1_ps(DEMAP_INT8_MAX);
+        min_v    = _mm_set1_ps(-DEMAP_INT8_MAX);
+        nv_min_v = _mm_set1_ps(DEMAP_NOISE_VAR_MIN);
+        for(j=0; j<Q_m; j++)
+        {
+            A_v[j] = _mm_set1_ps(A[j]);
+        }
+        for(; i+8<=M_symb; i+=8)
+        {
+            for(q=0; q<2; q++)
+            {
+                if(NULL == noise_var)
+                {
+                    sc_v = _mm_set1_ps(unit_scale);
+                }else{
+                    sc_v = _mm_div_ps(_mm_set1_ps(nv_scale),
+                                      _mm_max_ps(_mm_loadu_ps(&noise_var[i+q*4]), nv_min_v));
+                }
+                x_v[0] = _mm_loadu_ps(&d_re[i+q*4]);
+                x_v[1] = _mm_loadu_ps(&d_im[i+q*4]);
+                for(j=2; j<Q_m; j++)
+                {
+                    x_v[j] = _mm_sub_ps(A_v[j], _mm_andnot_ps(sign_v, x_v[j-2]));
+                }
+                for(j=0; j<Q_m; j++)
+                {
+                    llr_v[j][q] = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(x_v[j], sc_v), min_v), max_v));
+                }
+            }
+
+            // Interleave re and im of each bit pair, one pair per
+            // 16 bits
+            for(j=0; j<Q_m/2; j++)
+            {
+                re_v      = _mm_packs_epi32(llr_v[j*2][0], llr_v[j*2][1]);
+                im_v      = _mm_packs_epi32(llr_v[j*2+1][0], llr_v[j*2+1][1]);
+                pair_v[j] = _mm_unpacklo_epi8(_mm_packs_epi16(re_v, re_v),
+                                              _mm_packs_epi16(im_v, im_v));
+            }
+
+            // Interleave the bit pairs of each RE
+            if(2 == Q_m)
+            {
+                _mm_storeu_si128((__m128i *)&bits[i*2], pair_v[0]);
+            }else if(4 == Q_m){
+                _mm_storeu_si128((__m128i *)&bits[i*4],    _mm_unpacklo_epi16(pair_v[0], pair_v[1]));
+                _mm_storeu_si128((__m128i *)&bits[i*4+16], _mm_unpackhi_epi16(pair_v[0], pair_v[1]));
+            }else{
+                for(j=0; j<3; j++)
+                {
+                    _mm_storeu_si128((__m128i *)pair_16[j], pair_v[j]);
+                }
+                for(k=0; k<8; k++)
+                {
+                    for(j=0; j<3; j++)
+                    {
+                        memcpy(&bits[(i+k)*6+j*2], &pair_16[j][k], sizeof(uint16));
+                    }
+                }
+            }
+        }
+    }
+    modulation_demapper_llr_scalar(&d_re[i],
+                                   &d_im[i],
+                                   (NULL != noise_var) ? &noise_var[i] : NULL,
+                                   M_symb-i,
+                                   Q_m,
+                                   A,
+                                   unit_scale,
+                                   nv_scale,
+                                   &bits[i*Q_m]);
+}
+#endif
+
+/*********************************************************************
+    Name: generate_prs_c
+
+    Description: Generates the psuedo random sequence c
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
+*********************************************************************/
+void generate_prs_c(uint32  c_init,
+                    uint32  len,
+                    uint32 *c)
+{
+    uint32 i;
+    uint32 j;
+    uint32 word;
+    uint32 c_packed[(len+31)/32];
+
+    generate_prs_c_packed(c_init, len, c_packed);
+    for(i=0; i<len/32; i++)
+    {
+        word = c_packed[i];
+        for(j=0; j<32; j++)
+        {
+            c[i*32+j] = (word >> j) & 1;
+        }
+    }
+    for(i=(len/32)*32; i<len; i++)
+    {
+        c[i] = (c_packed[i/32] >> (i%32)) & 1;
+    }
+}
+
+/*********************************************************************
+    Name: generate_prs_c_packed
+
+    Description: Generates the psuedo random sequence c, 32 bits at a
+                 time, packed LSB first into 32 bit words
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
+
+    Notes: x1 and x2 are held as 64 bit windows, bit k being x(n+k).
+           Squaring the generator polynomials gives
+           x1(n+62) = x1(n+6) + x1(n) and
+           x2(n+62) = x2(n+6) + x2(n+4) + x2(n+2) + x2(n),
+           so the next 32 bits of each only depend on bits already
+           in the window.  The N_c=1600 warm-up is taken from
+           PRS_X1_INIT and PRS_X2_INIT.
+*********************************************************************/
+void generate_prs_c_packed(uint32  c_init,
+                           uint32  len,
+                           uint32 *c_packed)
+{
+    uint64 x1 = PRS_X1_INIT;
+    uint64 x2 = 0;
+    uint64 new_bits1;
+    uint64 new_bits2;
+    uint32 i;
+
+    // Jump the 2nd m-sequence ahead by N_c
+    for(i=0; i<31; i++)
+    {
+        if((c_init >> i) & 1)
+        {
+            x2 ^= PRS_X2_INIT[i];
+        }
+    }
+
+    // Generate c
+    for(i=0; i<(len+31)/32; i++)
+    {
+        c_packed[i] = (uint32)(x1 ^ x2);
+
+        new_bits1 = ((x1 >> 8) ^ (x1 >> 2)) & 0xFFFFFFFF;
+        new_bits2 = ((x2 >> 8) ^ (x2 >> 6) ^ (x2 >> 4) ^ (x2 >> 2)) & 0xFFFFFFFF;
+        x1        = (x1 >> 32) | (new_bits1 << 32);
+        x2        = (x2 >> 32) | (new_bits2 << 32);
+    }
+}
+
+/*********************************************************************
+    Name: generate_prs_c_cached
+
+    Description: Generates the psuedo random sequence c using a least
+                 recently used cache of packed sequences keyed by
+                 c_init
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
+*********************************************************************/
+void generate_prs_c_cached(LIBLTE_PHY_STRUCT *phy_struct,
+                           uint32             c_init,
+                           uint32             len,
+                           uint32            *c)
+{
+    LIBLTE_PHY_PRS_CACHE_STRUCT *entry = NULL;
+    uint32                       i;
+    uint32                       j;
+    uint32                       word;
+
+    if(len > 32*LIBLTE_PHY_PRS_CACHE_N_WORDS)
+    {
+        generate_prs_c(c_init, len, c);
+        return;
+    }
+
+    // Look for c_init, otherwise replace the least recently used entry
+    for(i=0; i<LIBLTE_PHY_PRS_CACHE_N_ENTRIES; i++)
+    {
+        if(0      != phy_struct->prs_cache[i].len &&
+           c_init == phy_struct->prs_cache[i].c_init)
+        {
+            entry = &phy_struct->prs_cache[i];
+            break;
+        }
+        if(NULL                                == entry ||
+           phy_struct->prs_cache[i].last_used  <  entry->last_used)
+        {
+            entry = &phy_struct->prs_cache[i];
+        }
+    }
+    if(entry->c_init != c_init ||
+       entry->len    <  len)
+    {
+        generate_prs_c_packed(c_init, len, entry->c_packed);
+        entry->c_init = c_init;
+        entry->len    = len;
+    }
+    entry->last_used = ++phy_struct->prs_cache_time;
+
+    for(i=0; i<len/32; i++)
+    {
+        word = entry->c_packed[i];
+        for(j=0; j<32; j++)
+        {
+            c[i*32+j] = (word >> j) & 1;
+        }
+    }
+    for(i=(len/32)*32; i<len; i++)
+    {
+        c[i] = (entry->c_packed[i/32] >> (i%32)) & 1;
+    }
+}
+
+/*********************************************************************
+    Name: pack_bits
+
+    Description: Packs a bit array into 64 bit words, first bit in the
+                 most significant position of the first word
+
+    Document Reference: N/A
+*********************************************************************/
+void pack_bits(uint8  *bits,
+               uint32  N_bits,
+               uint64 *words)
+{
+    uint64 word;
+    uint32 i;
+    uint32 j;
+
+    for(i=0; i<N_bits/64; i++)
+    {
+        word = 0;
+        for(j=0; j<64; j++)
+        {
+            word = (word << 1) | (bits[i*64+j] & 1);
+        }
+        words[i] = word;
+    }
+    if((N_bits % 64) != 0)
+    {
+        word = 0;
+        for(j=0; j<(N_bits % 64); j++)
+        {
+            word |= (uint64)(bits[i*64+j] & 1) << (63-j);
+        }
+        words[i] = word;
+    }
+}
+
+/*********************************************************************
+    Name: unpack_bits
+
+    Description: Unpacks 64 bit words into a bit array
+
+    Document Reference: N/A
+*********************************************************************/
+void unpack_bits(uint64 *words,
+                 uint32  N_bits,
+                 uint8  *bits)
+{
+    uint64 word;
+    uint32 i;
+    uint32 j;
+
+    for(i=0; i<N_bits/64; i++)
+    {
+        word = words[i];
+        for(j=0; j<64; j++)
+        {
+            bits[i*64+j] = (word >> (63-j)) & 1;
+        }
+    }
+    for(j=0; j<(N_bits % 64); j++)
+    {
+        bits[i*64+j] = (words[i] >> (63-j)) & 1;
+    }
+}
+
+/*********************************************************************
+    Name: copy_bits
+
+    Description: Copies a range of packed bits between arbitrary bit
+                 offsets, leaving the surrounding destination bits
+                 untouched
+
+    Document Reference: N/A
+*********************************************************************/
+void copy_bits(uint64 *src_words,
+               uint32  src_offset,
+               uint32  N_bits,
+               uint64 *dst_words,
+               uint32  dst_offset)
+{
+    uint64 word;
+    uint64 mask;
+    uint32 src_shift;
+    uint32 dst_shift;
+    uint32 N;
+
+    while(N_bits > 0)
+    {
+        // Copy up to the end of the current destination word
+        dst_shift = dst_offset % 64;
+        N         = 64 - dst_shift;
+        if(N > N_bits)
+        {
+            N = N_bits;
+        }
+
+        // Fetch N source bits into the top of word
+        src_shift = src_offset % 64;
+        word      = src_words[src_offset/64] << src_shift;
+        if((src_shift + N) > 64)
+        {
+            word |= src_words[src_offset/64 + 1] >> (64 - src_shift);
+        }
+        mask  = (N == 64) ? ~0ULL : ~(~0ULL >> N);
+        word &= mask;
+
+        dst_words[dst_offset/64] = ((dst_words[dst_offset/64] & ~(mask >> dst_shift)) |
+                                    (word >> dst_shift));
+
+        src_offset += N;
+        dst_offset += N;
+        N_bits     -= N;
+    }
+}
+
+/*********************************************************************
+    Name: calc_crc
+
+    Description: Calculates one of the LTE CRCs
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
+*********************************************************************/
+void calc_crc(uint8  *a_bits,
+              uint32  N_a_bits,
+              uint32  crc,
+              uint8  *p_bits,
+              uint32  N_p_bits)
+{
+    uint32 i;
+    uint32 crc_rem;
+    uint64 a_words[(N_a_bits+63)/64 + 1];
+
+    pack_bits(a_bits, N_a_bits, a_words);
+    crc_rem = calc_crc_packed(a_words, N_a_bits, crc, N_p_bits);
+
+    for(i=0; i<N_p_bits; i++)
+    {
+        p_bits[i] = (crc_rem >> (N_p_bits-1-i)) & 1;
+    }
+}
+
+/*********************************************************************
+    Name: calc_crc_packed
+
+    Description: Calculates one of the LTE CRCs over packed bits,
+                 CRC24A and CRC24B are calculated a byte at a time
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
+*********************************************************************/
+uint32 calc_crc_packed(uint64 *a_words,
+                       uint32  N_a_bits,
+                       uint32  crc,
+                       uint32  N_p_bits)
+{
+    uint32 *table     = NULL;
+    uint32  crc_rem   = 0;
+    uint32  crc_check = (1 << (N_p_bits-1));
+    uint32  crc_mask  = (1 << N_p_bits) - 1;
+    uint32  byte;
+    uint32  i = 0;
+
+    if(24 == N_p_bits)
+    {
+        if(CRC24A == crc)
+        {
+            table = CRC24A_TABLE;
+        }else if(CRC24B == crc){
+            table = CRC24B_TABLE;
+        }
+    }
+
+    // Whole bytes
+    if(NULL != table)
+    {
+        for(i=0; i<N_a_bits/8; i++)
+        {
+            byte    = (a_words[i/8] >> (56 - 8*(i%8))) & 0xFF;
+            crc_rem = ((crc_rem << 8) & 0xFFFFFF) ^ table[((crc_rem >> 16) ^ byte) & 0xFF];
+        }
+        i *= 8;
+    }
+
+    // Remaining bits
+    for(; i<N_a_bits; i++)
+    {
+        crc_rem ^= ((a_words[i/64] >> (63 - (i%64))) & 1) << (N_p_bits-1);
+        if(crc_rem & crc_check)
+        {
+            crc_rem = (crc_rem << 1) ^ crc;
+        }else{
+            crc_rem <<= 1;
+        }
+        crc_rem &= crc_mask;
+    }
+
+    return(crc_rem);
+}
+
+/*********************************************************************
+    Name: code_block_segmentation
+
+    Description: Performs code block segmentation for turbo coded
+                 channels
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
+*********************************************************************/
+void code_block_segmentation(uint8  *b_bits,
+                             uint32  N_b_bits,
+                             uint32 *N_codeblocks,
+                             uint32 *N_filler_bits,
+                             uint8  *c_bits,
+                             uint32  N_c_bits_max,
+                             uint32 *N_c_bits)
+{
+    uint32 N_c_words_max = (N_c_bits_max+63)/64;
+    uint32 r;
+    uint32 i;
+    uint64 b_words[(N_b_bits+63)/64 + 1];
+    uint64 c_words[13*N_c_words_max];
+
+    pack_bits(b_bits, N_b_bits, b_words);
+    code_block_segmentation_packed(b_words,
+                                   N_b_bits,
+                                   N_codeblocks,
+                                   N_filler_bits,
+                                   c_words,
+                                   N_c_words_max,
+                                   N_c_bits);
+    for(r=0; r<*N_codeblocks; r++)
+    {
+        unpack_bits(&c_words[r*N_c_words_max], N_c_bits[r], &c_bits[r*N_c_bits_max]);
+    }
+    for(i=0; i<*N_filler_bits; i++)
+    {
+        c_bits[i] = TX_NULL_SYMB;
+    }
+}
+
+/*********************************************************************
+    Name: code_block_segmentation_packed
+
+    Description: Performs code block segmentation for turbo coded
+                 channels on packed bits, filler bits are zero
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
+*********************************************************************/
+void code_block_segmentation_packed(uint64 *b_words,
+                                    uint32  N_b_bits,
+                                    uint32 *N_codeblocks,
+                                    uint32 *N_filler_bits,
+                                    uint64 *c_words,
+                                    uint32  N_c_words_max,
+                                    uint32 *N_c_bits)
+{
+    uint64 *c_cb_words;
+    uint64  p_cb_word;
+    uint32  Z = 6144;
+    uint32  L;
+    uint32  B;
+    uint32  C;
+    uint32  F;
+    uint32  B_prime;
+    uint32  K_plus  = 0;
+    uint32  K_minus = 0;
+    uint32  K_delta;
+    uint32  K_r;
+    uint32  C_plus;
+    uint32  C_minus;
+    uint32  k;
+    uint32  s;
+    uint32  r;
+    int32   i;
+
+    // Determine L, C, B', K+, C+, K-, and C-
+    if(N_b_bits <= Z)
+    {
+        L       = 0;
+        C       = 1;
+        B_prime = N_b_bits;
+        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
+        {
+            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
+            {
+                K_plus = TURBO_INT_K_TABLE[i];
+                break;
+            }
+        }
+        K_minus = 0;
+        C_plus  = 1;
+        C_minus = 0;
+    }else{
+        B       = N_b_bits;
+        L       = 24;
+        C       = (uint32)ceilf((float)B/(float)(Z-L));
+        B_prime = B + C*L;
+        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
+        {
+            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
+            {
+                K_plus = TURBO_INT_K_TABLE[i];
                 break;
-            case 60:
-                d_re[N_bits/6] = -5*one_over_sqrt_42;
-                d_im[N_bits/6] = -5*one_over_sqrt_42;
+            }
+        }
+        for(i=TURBO_INT_K_TABLE_SIZE-1; i>=0; i--)
+        {
+            if(TURBO_INT_K_TABLE[i] < K_plus)
+            {
+                K_minus = TURBO_INT_K_TABLE[i];
                 break;
-            case 61:
-                d_re[N_bits/6] = -5*one_over_sqrt_42;
-                d_im[N_bits/6] = -7*one_over_sqrt_42;
+            }
+        }
+        K_delta = K_plus - K_minus;
+        C_minus = (C*K_plus - B_prime)/K_delta;
+        C_plus  = C - C_minus;
+    }
+
+    // Determine the number of filler bits
+    *N_codeblocks  = C;
+    F              = C_plus*K_plus + C_minus*K_minus - B_prime;
+    *N_filler_bits = F;
+
+    // Add the filler and input bits
+    k = F;
+    s = 0;
+    for(r=0; r<C; r++)
+    {
+        // Determine the K for this code block
+        if(r < C_minus)
+        {
+            K_r = K_minus;
+        }else{
+            K_r = K_plus;
+        }
+        N_c_bits[r] = K_r;
+        c_cb_words  = &c_words[r*N_c_words_max];
+
+        // Filler bits are zero
+        memset(c_cb_words, 0, sizeof(uint64)*((K_r+63)/64));
+        copy_bits(b_words, s, K_r - L - k, c_cb_words, k);
+        s += K_r - L - k;
+
+        // Add CRC if more than 1 code block is needed
+        if(C > 1)
+        {
+            p_cb_word = (uint64)calc_crc_packed(c_cb_words, K_r - L, CRC24B, L) << (64 - L);
+            copy_bits(&p_cb_word, 0, L, c_cb_words, K_r - L);
+        }
+        k = 0;
+    }
+}
+
+/*********************************************************************
+    Name: code_block_desegmentation
+
+    Description: Performs code block desegmentation for turbo coded
+                 channels, failing if the CRC of any code block fails
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
+*********************************************************************/
+LIBLTE_ERROR_ENUM code_block_desegmentation(uint8  *c_bits,
+                                            uint32 *N_c_bits,
+                                            uint32  N_c_bits_max,
+                                            uint32  tbs,
+                                            uint8  *b_bits,
+                                            uint32  N_b_bits)
+{
+    LIBLTE_ERROR_ENUM  err     = LIBLTE_SUCCESS;
+    uint32             Z       = 6144;
+    uint32             L;
+    uint32             B;
+    uint32             C;
+    uint32             F;
+    uint32             B_prime;
+    uint32             K_plus  = 0;
+    uint32             K_minus = 0;
+    uint32             K_delta;
+    uint32             K_r;
+    uint32             C_plus;
+    uint32             C_minus;
+    uint32             k;
+    uint32             s;
+    uint32             r;
+    uint32             ber;
+    int32              i;
+    uint8             *p_cb_bits;
+    uint8              calc_p_cb_bits[24];
+
+    // Determine L, C, B', K+, C+, K-, and C-
+    if(tbs+24 <= Z)
+    {
+        L       = 0;
+        C       = 1;
+        B_prime = tbs+24;
+        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
+        {
+            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
+            {
+                K_plus = TURBO_INT_K_TABLE[i];
                 break;
-            case 62:
-                d_re[N_bits/6] = -7*one_over_sqrt_42;
-                d_im[N_bits/6] = -5*one_over_sqrt_42;
+            }
+        }
+        K_minus = 0;
+        C_plus  = 1;
+        C_minus = 0;
+    }else{
+        B       = tbs+24;
+        L       = 24;
+        C       = (uint32)ceilf((float)B/(float)(Z-L));
+        B_prime = B + C*L;
+        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
+        {
+            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
+            {
+                K_plus = TURBO_INT_K_TABLE[i];
                 break;
-            case 63:
-                d_re[N_bits/6] = -7*one_over_sqrt_42;
-                d_im[N_bits/6] = -7*one_over_sqrt_42;
+            }
+        }
+        for(i=TURBO_INT_K_TABLE_SIZE-1; i>=0; i--)
+        {
+            if(TURBO_INT_K_TABLE[i] < K_plus)
+            {
+                K_minus = TURBO_INT_K_TABLE[i];
                 break;
             }
         }
-        break;
+        K_delta = K_plus - K_minus;
+        C_minus = (C*K_plus - B_prime)/K_delta;
+        C_plus  = C - C_minus;
+    }
+
+    // Determine the number of filler bits
+    F = C_plus*K_plus + C_minus*K_minus - B_prime;
+
+    // Determine the output bits
+    k = F;
+    s = 0;
+    for(r=0; r<C; r++)
+    {
+        // Determine the K for this code block
+        if(r < C_minus)
+        {
+            K_r = K_minus;
+        }else{
+            K_r = K_plus;
+        }
+
+        // Check CRC if more than 1 code block is present
+        if(C > 1)
+        {
+            calc_crc(&c_bits[r*N_c_bits_max], N_c_bits[r]-L, CRC24B, calc_p_cb_bits, L);
+            p_cb_bits = &c_bits[r*N_c_bits_max+N_c_bits[r]-L];
+            ber       = 0;
+            for(i=0; i<(int32)L; i++)
+            {
+                ber += p_cb_bits[i] ^ calc_p_cb_bits[i];
+            }
+            if(ber != 0)
+            {
+                err = LIBLTE_ERROR_INVALID_CRC;
+            }
+        }
+
+        // Create the output bits
+        while(k < (K_r - L))
+        {
+            b_bits[s++] = c_bits[r*N_c_bits_max+k];
+            k++;
+        }
+        k = 0;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: conv_encode
+
+    Description: Convolutionally encodes a bit array using the
+                 provided parameters
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+*********************************************************************/
+void conv_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                 uint8             *c_bits,
+                 uint32             N_c_bits,
+                 uint32             constraint_len,
+                 uint32             rate,
+                 uint32            *g,
+                 bool               tail_bit,
+                 uint8             *d_bits,
+                 uint32            *N_d_bits)
+{
+    uint32 i;
+    uint32 j;
+    uint32 k;
+    uint8  s_reg[constraint_len];
+    uint8  g_array[3][constraint_len];
+
+    // Initialize the shift register
+    if(tail_bit)
+    {
+        for(i=0; i<constraint_len; i++)
+        {
+            s_reg[i] = c_bits[N_c_bits-i-1];
+        }
+    }else{
+        for(i=0; i<constraint_len; i++)
+        {
+            s_reg[i] = 0;
+        }
+    }
+
+    // Convert g from octal to binary array
+    for(i=0; i<rate; i++)
+    {
+        for(j=0; j<constraint_len; j++)
+        {
+            g_array[i][j] = (g[i] >> (constraint_len-j-1)) & 1;
+        }
+    }
+
+    // Convolutionally encode input
+    for(i=0; i<N_c_bits; i++)
+    {
+        // Add next bit to shift register
+        for(j=constraint_len-1; j>0; j--)
+        {
+            s_reg[j] = s_reg[j-1];
+        }
+        s_reg[0] = c_bits[i];
+
+        // Determine the output bits
+        for(j=0; j<rate; j++)
+        {
+            d_bits[i*rate + j] = 0;
+
+            for(k=0; k<constraint_len; k++)
+            {
+                d_bits[i*rate + j] += s_reg[k]*g_array[j][k];
+            }
+            d_bits[i*rate + j] %= 2;
+        }
+    }
+
+    *N_d_bits = N_c_bits*rate;
+}
+
+/*********************************************************************
+    Name: viterbi_decode
+
+    Description: Tail biting Viterbi decoder for the LTE rate 1/3,
+                 constraint length 7 convolutional code.  The circular
+                 trellis is decoded by wrapping the input around both
+                 ends of the block.  All 64 states are updated with 16
+                 bit saturating add-compare-select and the survivor
+                 decisions of each step are packed into one word.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+
+    Notes: Branch metric sign masks are pre calculated by
+           viterbi_pre_calc
+*********************************************************************/
+void viterbi_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                    float             *d_bits,
+                    uint32             N_d_bits,
+                    uint8             *c_bits,
+                    uint32            *N_c_bits)
+{
+    float   max_value = 0;
+    float   scale     = 0;
+    int16  *in        = phy_struct->vd_in;
+    int16   metric[64];
+    int32   max_metric;
+    uint32  i;
+    uint32  t;
+    uint32  N_bits = N_d_bits/3;
+    uint32  N_wrap;
+    uint32  N_steps;
+    uint32  state;
+
+    *N_c_bits = 0;
+    if(0   == N_bits ||
+       192 <  N_bits)
+    {
+        return;
+    }
+
+    // Quantize the soft bits, NULL bits carry no information
+    for(i=0; i<N_bits*3; i++)
+    {
+        if(d_bits[i]       != RX_NULL_BIT &&
+           fabs(d_bits[i])  > max_value)
+        {
+            max_value = fabs(d_bits[i]);
+        }
+    }
+    if(max_value > 0)
+    {
+        scale = VD_IN_MAX/max_value;
+    }
+    for(i=0; i<N_bits*3; i++)
+    {
+        if(d_bits[i] == RX_NULL_BIT)
+        {
+            in[i] = 0;
+        }else{
+            in[i] = (int16)lroundf(d_bits[i]*scale);
+        }
+    }
+
+    // Wrap the block around both ends and start with all states
+    // equally likely
+    N_wrap  = (N_bits < VD_TB_WRAP) ? N_bits : VD_TB_WRAP;
+    N_steps = N_bits + 2*N_wrap;
+    PHY_KERNELS.viterbi_acs(phy_struct, in, N_bits, N_wrap, N_steps, metric);
+
+    // Traceback from the best final state, keeping the bits from
+    // the middle copy of the block
+    max_metric = metric[0];
+    state      = 0;
+    for(i=1; i<64; i++)
+    {
+        if(metric[i] > max_metric)
+        {
+            max_metric = metric[i];
+            state      = i;
+        }
+    }
+    for(t=N_steps; t>0; t--)
+    {
+        if((t-1) >= N_wrap &&
+           (t-1) <  (N_wrap + N_bits))
+        {
+            c_bits[t-1-N_wrap] = state >> 5;
+        }
+        state = ((state & 31) << 1) | ((phy_struct->vd_dec[t-1] >> state) & 1);
+    }
+    *N_c_bits = N_bits;
+}
+
+/*********************************************************************
+    Name: viterbi_acs_scalar
+
+    Description: Runs the add-compare-select of viterbi_decode over
+                 N_steps trellis steps starting with all states equal,
+                 leaving the survivor decisions in vd_dec and the final
+                 path metrics in metric
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+*********************************************************************/
+void viterbi_acs_scalar(LIBLTE_PHY_STRUCT *phy_struct,
+                        int16             *in,
+                        uint32             N_bits,
+                        uint32             N_wrap,
+                        uint32             N_steps,
+                        int16             *metric)
+{
+    int16  new_metric[64];
+    int32  bm;
+    int32  a;
+    int32  b;
+    uint64 dec;
+    uint32 i;
+    uint32 t;
+    uint32 idx;
+
+    for(i=0; i<64; i++)
+    {
+        metric[i] = 0;
+    }
+    for(t=0; t<N_steps; t++)
+    {
+        idx = ((t + N_bits - N_wrap) % N_bits)*3;
+
+        // Butterflies, states 2s and 2s+1 feed states s and s+32 with
+        // the branch metric of state 2s for input 0 equal to bm and
+        // all others equal to +/-bm
+        dec = 0;
+        for(i=0; i<32; i++)
+        {
+            bm  = (in[idx+0] ^ phy_struct->cell->vd_bm_mask[0][i]) - phy_struct->cell->vd_bm_mask[0][i];
+            bm += (in[idx+1] ^ phy_struct->cell->vd_bm_mask[1][i]) - phy_struct->cell->vd_bm_mask[1][i];
+            bm += (in[idx+2] ^ phy_struct->cell->vd_bm_mask[2][i]) - phy_struct->cell->vd_bm_mask[2][i];
+            a   = metric[2*i]   + bm;
+            b   = metric[2*i+1] - bm;
+            if(b > a)
+            {
+                new_metric[i]  = b;
+                dec           |= (uint64)1 << i;
+            }else{
+                new_metric[i]  = a;
+            }
+            a = metric[2*i]   - bm;
+            b = metric[2*i+1] + bm;
+            if(b > a)
+            {
+                new_metric[i+32]  = b;
+                dec              |= (uint64)1 << (i+32);
+            }else{
+                new_metric[i+32]  = a;
+            }
+        }
+        phy_struct->vd_dec[t] = dec;
+
+        // Normalize to state 0
+        for(i=0; i<64; i++)
+        {
+            metric[i] = new_metric[i] - new_metric[0];
+        }
+    }
+}
+
+#if defined(__SSE2__)
+/*********************************************************************
+    Name: viterbi_acs_sse2
+
+    Description: SSE2 version of viterbi_acs_scalar, 8 states per
+                 register
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+*********************************************************************/
+void viterbi_acs_sse2(LIBLTE_PHY_STRUCT *phy_struct,
+                      int16             *in,
+                      uint32             N_bits,
+                      uint32             N_wrap,
+                      uint32             N_steps,
+                      int16             *metric)
+{
+    __m128i m_v[8];
+    __m128i n_v[8];
+    __m128i mask_v[3][4];
+    __m128i l_v[3];
+    __m128i bm_v;
+    __m128i e_v;
+    __m128i o_v;
+    __m128i a_v;
+    __m128i b_v;
+    __m128i d_v[8];
+    uint32  i;
+    uint32  t;
+    uint32  q;
+    uint32  idx;
+
+    for(q=0; q<4; q++)
+    {
+        for(i=0; i<3; i++)
+        {
+            mask_v[i][q] = _mm_loadu_si128((__m128i *)&phy_struct->cell->vd_bm_mask[i][q*8]);
+        }
+    }
+    for(q=0; q<8; q++)
+    {
+        m_v[q] = _mm_setzero_si128();
+    }
+    for(t=0; t<N_steps; t++)
+    {
+        idx = ((t + N_bits - N_wrap) % N_bits)*3;
+        for(i=0; i<3; i++)
+        {
+            l_v[i] = _mm_set1_epi16(in[idx+i]);
+        }
+
+        // Butterflies, states 2s and 2s+1 feed states s and s+32 with
+        // the branch metric of state 2s for input 0 equal to bm and
+        // all others equal to +/-bm
+        for(q=0; q<4; q++)
+        {
+            bm_v = _mm_sub_epi16(_mm_xor_si128(l_v[0], mask_v[0][q]), mask_v[0][q]);
+            bm_v = _mm_add_epi16(bm_v, _mm_sub_epi16(_mm_xor_si128(l_v[1], mask_v[1][q]), mask_v[1][q]));
+            bm_v = _mm_add_epi16(bm_v, _mm_sub_epi16(_mm_xor_si128(l_v[2], mask_v[2][q]), mask_v[2][q]));
+            e_v  = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(m_v[2*q], 16), 16),
+                                   _mm_srai_epi32(_mm_slli_epi32(m_v[2*q+1], 16), 16));
+            o_v  = _mm_packs_epi32(_mm_srai_epi32(m_v[2*q], 16),
+                                   _mm_srai_epi32(m_v[2*q+1], 16));
+
+            a_v      = _mm_adds_epi16(e_v, bm_v);
+            b_v      = _mm_subs_epi16(o_v, bm_v);
+            n_v[q]   = _mm_max_epi16(a_v, b_v);
+            d_v[q]   = _mm_cmpgt_epi16(b_v, a_v);
+            a_v      = _mm_subs_epi16(e_v, bm_v);
+            b_v      = _mm_adds_epi16(o_v, bm_v);
+            n_v[q+4] = _mm_max_epi16(a_v, b_v);
+            d_v[q+4] = _mm_cmpgt_epi16(b_v, a_v);
+        }
+
+        // Pack the decisions, bit s is set if state s survived from
+        // the odd predecessor
+        phy_struct->vd_dec[t] = 0;
+        for(q=0; q<4; q++)
+        {
+            phy_struct->vd_dec[t] |= (uint64)(_mm_movemask_epi8(_mm_packs_epi16(d_v[2*q], d_v[2*q+1])) & 0xFFFF) << (q*16);
+        }
+
+        // Normalize to state 0
+        a_v = _mm_shuffle_epi32(_mm_shufflelo_epi16(n_v[0], 0), 0);
+        for(q=0; q<8; q++)
+        {
+            m_v[q] = _mm_subs_epi16(n_v[q], a_v);
+        }
+    }
+    for(q=0; q<8; q++)
+    {
+        _mm_storeu_si128((__m128i *)&metric[q*8], m_v[q]);
     }
 }
+#endif
 
+#if defined(PHY_KERNEL_X86)
 /*********************************************************************
-    Name: modulation_demapper
+    Name: viterbi_acs_avx2
 
-    Description: Maps complex-valued modulation symbols to binary
-                 digits
+    Description: AVX2 version of viterbi_acs_scalar, 16 states per
+                 register.  The packs work within each 128 bit lane so
+                 their 64 bit blocks are put back in state order with
+                 a permute.
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+*********************************************************************/
+PHY_TARGET_AVX2
+void viterbi_acs_avx2(LIBLTE_PHY_STRUCT *phy_struct,
+                      int16             *in,
+                      uint32             N_bits,
+                      uint32             N_wrap,
+                      uint32             N_steps,
+                      int16             *metric)
+{
+    __m256i m_v[4];
+    __m256i n_v[4];
+    __m256i mask_v[3][2];
+    __m256i l_v[3];
+    __m256i bm_v;
+    __m256i e_v;
+    __m256i o_v;
+    __m256i a_v;
+    __m256i b_v;
+    __m256i d_v[4];
+    uint32  i;
+    uint32  t;
+    uint32  q;
+    uint32  idx;
 
-    NOTES: Currently only supports BPSK and QPSK
+    for(q=0; q<2; q++)
+    {
+        for(i=0; i<3; i++)
+        {
+            mask_v[i][q] = _mm256_loadu_si256((__m256i *)&phy_struct->cell->vd_bm_mask[i][q*16]);
+        }
+    }
+    for(q=0; q<4; q++)
+    {
+        m_v[q] = _mm256_setzero_si256();
+    }
+    for(t=0; t<N_steps; t++)
+    {
+        idx = ((t + N_bits - N_wrap) % N_bits)*3;
+        for(i=0; i<3; i++)
+        {
+            l_v[i] = _mm256_set1_epi16(in[idx+i]);
+        }
+
+        // Butterflies, the same as viterbi_acs_sse2
+        for(q=0; q<2; q++)
+        {
+            bm_v = _mm256_sub_epi16(_mm256_xor_si256(l_v[0], mask_v[0][q]), mask_v[0][q]);
+            bm_v = _mm256_add_epi16(bm_v, _mm256_sub_epi16(_mm256_xor_si256(l_v[1], mask_v[1][q]), mask_v[1][q]));
+            bm_v = _mm256_add_epi16(bm_v, _mm256_sub_epi16(_mm256_xor_si256(l_v[2], mask_v[2][q]), mask_v[2][q]));
+            e_v  = _mm256_packs_epi32(_mm256_srai_epi32(_mm256_slli_epi32(m_v[2*q], 16), 16),
+                                      _mm256_srai_epi32(_mm256_slli_epi32(m_v[2*q+1], 16), 16));
+            o_v  = _mm256_packs_epi32(_mm256_srai_epi32(m_v[2*q], 16),
+                                      _mm256_srai_epi32(m_v[2*q+1], 16));
+            e_v  = _mm256_permute4x64_epi64(e_v, 0xD8);
+            o_v  = _mm256_permute4x64_epi64(o_v, 0xD8);
+
+            a_v      = _mm256_adds_epi16(e_v, bm_v);
+            b_v      = _mm256_subs_epi16(o_v, bm_v);
+            n_v[q]   = _mm256_max_epi16(a_v, b_v);
+            d_v[q]   = _mm256_cmpgt_epi16(b_v, a_v);
+            a_v      = _mm256_subs_epi16(e_v, bm_v);
+            b_v      = _mm256_adds_epi16(o_v, bm_v);
+            n_v[q+2] = _mm256_max_epi16(a_v, b_v);
+            d_v[q+2] = _mm256_cmpgt_epi16(b_v, a_v);
+        }
+
+        // Pack the decisions, bit s is set if state s survived from
+        // the odd predecessor
+        phy_struct->vd_dec[t] = 0;
+        for(q=0; q<2; q++)
+        {
+            a_v                    = _mm256_permute4x64_epi64(_mm256_packs_epi16(d_v[2*q], d_v[2*q+1]), 0xD8);
+            phy_struct->vd_dec[t] |= (uint64)(uint32)_mm256_movemask_epi8(a_v) << (q*32);
+        }
+
+        // Normalize to state 0
+        a_v = _mm256_broadcastw_epi16(_mm256_castsi256_si128(n_v[0]));
+        for(q=0; q<4; q++)
+        {
+            m_v[q] = _mm256_subs_epi16(n_v[q], a_v);
+        }
+    }
+    for(q=0; q<4; q++)
+    {
+        _mm256_storeu_si256((__m256i *)&metric[q*16], m_v[q]);
+    }
+}
+#endif
+
+/*********************************************************************
+    Name: viterbi_pre_calc
+
+    Description: Pre calculates the Viterbi decoder branch metric
+                 sign masks for the LTE rate 1/3, constraint length 7
+                 convolutional code.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
 *********************************************************************/
-void modulation_demapper(float                           *d_re,
-                         float                           *d_im,
-                         uint32                           M_symb,
-                         LIBLTE_PHY_MODULATION_TYPE_ENUM  type,
-                         int8                            *bits,
-                         uint32                          *N_bits)
+void viterbi_pre_calc(LIBLTE_PHY_STRUCT *phy_struct)
 {
-    float  ang;
-    float  sd;
-    float  act_d_re;
-    float  act_d_im;
-    float  one_over_sqrt_2   = 1/sqrt(2);
-    float  two_over_sqrt_10  = 2/sqrt(10);
-    float  two_over_sqrt_42  = 2/sqrt(42);
-    float  four_over_sqrt_42 = 4/sqrt(42);
-    float  six_over_sqrt_42  = 6/sqrt(42);
+    uint32 g[3] = {0133, 0171, 0165}; // Numbers are in octal
     uint32 i;
+    uint32 j;
+    uint32 k;
+    uint32 reg;
+    uint8  out;
 
-    if(LIBLTE_PHY_MODULATION_TYPE_BPSK == type)
+    // The shift register holds the input bit in bit 6 followed by
+    // the state, every generator taps bits 6 and 0 so flipping the
+    // input or the oldest state bit flips all outputs
+    for(i=0; i<32; i++)
     {
-        // 3GPP TS 36.211 v10.1.0 section 7.1.1
-        *N_bits = M_symb;
-        for(i=0; i<M_symb; i++)
+        reg = 2*i;
+        for(j=0; j<3; j++)
         {
-            ang = atan2f(d_im[i], d_re[i]);
-            if((ang > -M_PI/4) && (ang < 3*M_PI/4))
+            out = 0;
+            for(k=0; k<7; k++)
             {
-                act_d_re = +one_over_sqrt_2;
-                act_d_im = +one_over_sqrt_2;
-                sd       = get_soft_decision(d_re[i], d_im[i], act_d_re, act_d_im, 1);
-                bits[i]  = +(int8)(127*sd);
-            }else{
-                act_d_re = -one_over_sqrt_2;
-                act_d_im = -one_over_sqrt_2;
-                sd       = get_soft_decision(d_re[i], d_im[i], act_d_re, act_d_im, 1);
-                bits[i]  = -(int8)(127*sd);
+                out ^= ((reg & g[j]) >> k) & 1;
             }
+            phy_struct->cell->vd_bm_mask[j][i] = (out) ? -1 : 0;
         }
-    }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == type){
-        // 3GPP TS 36.211 v10.1.0 section 7.1.2
-        *N_bits = M_symb*2;
-        for(i=0; i<M_symb; i++)
+    }
+}
+
+/*********************************************************************
+    Name: turbo_encode
+
+    Description: Turbo encodes a bit array using the LTE Parallel
+                 Concatenated Convolutional Code
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+*********************************************************************/
+LIBLTE_ERROR_ENUM turbo_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                               uint8             *c_bits,
+                               uint32             N_c_bits,
+                               uint32             N_fill_bits,
+                               uint8             *d_bits,
+                               uint32            *N_d_bits)
+{
+    uint32 i;
+    uint32 x;
+    uint32 N_branch_bits = N_c_bits + 4;
+
+    if(N_c_bits > 6144)
+    {
+        return(LIBLTE_ERROR_INVALID_INPUTS);
+    }
+    pack_bits(c_bits, N_c_bits, phy_struct->te_c_words);
+    if(LIBLTE_SUCCESS != turbo_encode_packed(phy_struct,
+                                             phy_struct->te_c_words,
+                                             N_c_bits,
+                                             phy_struct->te_d_words[0],
+                                             97,
+                                             N_d_bits))
+    {
+        return(LIBLTE_ERROR_INVALID_INPUTS);
+    }
+    for(x=0; x<3; x++)
+    {
+        unpack_bits(phy_struct->te_d_words[x], N_branch_bits, &d_bits[x*N_branch_bits]);
+    }
+
+    // Filler bits are NULL in d0 and d1
+    for(i=0; i<N_fill_bits; i++)
+    {
+        d_bits[i]               = TX_NULL_BIT;
+        d_bits[N_branch_bits+i] = TX_NULL_BIT;
+    }
+
+    return(LIBLTE_SUCCESS);
+}
+
+/*********************************************************************
+    Name: turbo_encode_packed
+
+    Description: Turbo encodes packed bits using the LTE Parallel
+                 Concatenated Convolutional Code, producing the three
+                 packed output streams d0, d1, and d2
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+*********************************************************************/
+LIBLTE_ERROR_ENUM turbo_encode_packed(LIBLTE_PHY_STRUCT *phy_struct,
+                                      uint64            *c_words,
+                                      uint32             N_c_bits,
+                                      uint64            *d_words,
+                                      uint32             N_d_words_max,
+                                      uint32            *N_d_bits)
+{
+    uint64 *d0_words = &d_words[0];
+    uint64 *d1_words = &d_words[N_d_words_max];
+    uint64 *d2_words = &d_words[2*N_d_words_max];
+    uint64  word;
+    uint32  K        = N_c_bits;
+    uint32  N_words  = (K+4+63)/64;
+    uint32  state_1  = 0;
+    uint32  state_2  = 0;
+    uint32  out;
+    uint32  shift;
+    uint32  x[3];
+    uint32  z[3];
+    uint32  x_prime[3];
+    uint32  z_prime[3];
+    uint32  idx;
+    uint32  i;
+    uint32  j;
+
+    // Construct c_prime, K must be one of the interleaver sizes
+    if(LIBLTE_SUCCESS != turbo_internal_interleaver_idx(K, phy_struct->te_int_idx))
+    {
+        return(LIBLTE_ERROR_INVALID_INPUTS);
+    }
+    for(i=0; i<K/64; i++)
+    {
+        word = 0;
+        for(j=0; j<64; j++)
         {
-            ang = atan2f(d_im[i], d_re[i]);
-            if((ang >= 0) && (ang < M_PI/2))
-            {
-                act_d_re    = +one_over_sqrt_2;
-                act_d_im    = +one_over_sqrt_2;
-                sd          = get_soft_decision(d_re[i], d_im[i], act_d_re, act_d_im, 1);
-                bits[i*2+0] = +(int8)(127*sd);
-                bits[i*2+1] = +(int8)(127*sd);
-            }else if((ang >= -M_PI/2) && (ang < 0)){
-                act_d_re    = +one_over_sqrt_2;
-                act_d_im    = -one_over_sqrt_2;
-                sd          = get_soft_decision(d_re[i], d_im[i], act_d_re, act_d_im, 1);
-                bits[i*2+0] = +(int8)(127*sd);
-                bits[i*2+1] = -(int8)(127*sd);
-            }else if((ang >= M_PI/2) && (ang < M_PI)){
-                act_d_re    = -one_over_sqrt_2;
-                act_d_im    = +one_over_sqrt_2;
-                sd          = get_soft_decision(d_re[i], d_im[i], act_d_re, act_d_im, 1);
-                bits[i*2+0] = -(int8)(127*sd);
-                bits[i*2+1] = +(int8)(127*sd);
-            }else{
-                act_d_re    = -one_over_sqrt_2;
-                act_d_im    = -one_over_sqrt_2;
-                sd          = get_soft_decision(d_re[i], d_im[i], act_d_re, act_d_im, 1);
-                bits[i*2+0] = -(int8)(127*sd);
-                bits[i*2+1] = -(int8)(127*sd);
-            }
+            idx  = phy_struct->te_int_idx[i*64+j];
+            word = (word << 1) | ((c_words[idx/64] >> (63 - (idx%64))) & 1);
         }
-    }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == type){
-        // 3GPP TS 36.211 v10.1.0 section 7.1.3
-        *N_bits = M_symb*4;
-        // FIXME: Need to make soft decisions
-        for(i=0; i<M_symb; i++)
+        phy_struct->te_c_prime_words[i] = word;
+    }
+    if((K % 64) != 0)
+    {
+        word = 0;
+        for(j=0; j<(K % 64); j++)
         {
-            if(d_re[i] > 0)
-            {
-                bits[i*4+0] = +127;
-            }else{
-                bits[i*4+0] = -127;
-            }
-            if(d_im[i] > 0)
-            {
-                bits[i*4+1] = +127;
-            }else{
-                bits[i*4+1] = -127;
-            }
-            if(fabs(d_re[i]) < two_over_sqrt_10)
-            {
-                bits[i*4+2] = +127;
-            }else{
-                bits[i*4+2] = -127;
-            }
-            if(fabs(d_im[i]) < two_over_sqrt_10)
-            {
-                bits[i*4+3] = +127;
-            }else{
-                bits[i*4+3] = -127;
-            }
+            idx  = phy_struct->te_int_idx[i*64+j];
+            word = (word << 1) | ((c_words[idx/64] >> (63 - (idx%64))) & 1);
         }
-    }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == type
-        // 3GPP TS 36.211 v10.1.0 section 7.1.4
-        *N_bits = M_symb*6;
-        // FIXME: Need to make soft decisions
-        for(i=0; i<M_symb; i++)
+        phy_struct->te_c_prime_words[i] = word << (64 - (K % 64));
+    }
+
+    // Construct d0, z, and z_prime a byte at a time, K is always a
+    // multiple of 8
+    memset(d0_words, 0, sizeof(uint64)*N_words);
+    memset(d1_words, 0, sizeof(uint64)*N_words);
+    memset(d2_words, 0, sizeof(uint64)*N_words);
+    for(i=0; i<K/8; i++)
+    {
+        shift           = 56 - 8*(i%8);
+        out             = phy_struct->cell->te_table[state_1][(c_words[i/8] >> shift) & 0xFF];
+        state_1         = out >> 8;
+        d1_words[i/8]  |= (uint64)(out & 0xFF) << shift;
+        out             = phy_struct->cell->te_table[state_2][(phy_struct->te_c_prime_words[i/8] >> shift) & 0xFF];
+        state_2         = out >> 8;
+        d2_words[i/8]  |= (uint64)(out & 0xFF) << shift;
+    }
+    copy_bits(c_words, 0, K, d0_words, 0);
+
+    // Trellis termination, the shift register input is forced to zero
+    for(i=0; i<3; i++)
+    {
+        x[i]       = ((state_1 >> 1) ^ state_1) & 1;
+        z[i]       = ((state_1 >> 2) ^ state_1) & 1;
+        state_1   >>= 1;
+        x_prime[i] = ((state_2 >> 1) ^ state_2) & 1;
+        z_prime[i] = ((state_2 >> 2) ^ state_2) & 1;
+        state_2   >>= 1;
+    }
+    shift           = 60 - (K % 64);
+    d0_words[K/64] |= (uint64)((x[0] << 3) | (z[1] << 2) | (x_prime[0] << 1) | z_prime[1]) << shift;
+    d1_words[K/64] |= (uint64)((z[0] << 3) | (x[2] << 2) | (z_prime[0] << 1) | x_prime[2]) << shift;
+    d2_words[K/64] |= (uint64)((x[1] << 3) | (z[2] << 2) | (x_prime[1] << 1) | z_prime[2]) << shift;
+
+    *N_d_bits = (K+4)*3;
+
+    return(LIBLTE_SUCCESS);
+}
+
+/*********************************************************************
+    Name: turbo_encode_pre_calc
+
+    Description: Builds the constituent encoder table used by
+                 turbo_encode_packed, indexed by encoder state and
+                 input byte
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+*********************************************************************/
+void turbo_encode_pre_calc(LIBLTE_PHY_STRUCT *phy_struct)
+{
+    uint32 s;
+    uint32 in;
+    uint32 state;
+    uint32 a;
+    uint32 out;
+    uint32 i;
+
+    // State bit 2 is a(k-1), bit 1 is a(k-2), and bit 0 is a(k-3).
+    // Each entry holds the 8 parity bits in the low byte and the
+    // final state above them.
+    for(s=0; s<8; s++)
+    {
+        for(in=0; in<256; in++)
         {
-            if(d_re[i] > 0)
-            {
-                bits[i*6+0] = +127;
-            }else{
-                bits[i*6+0] = -127;
-            }
-            if(d_im[i] > 0)
+            state = s;
+            out   = 0;
+            for(i=0; i<8; i++)
             {
-                bits[i*6+1] = +127;
-            }else{
-                bits[i*6+1] = -127;
+                a     = ((in >> (7-i)) ^ (state >> 1) ^ state) & 1;
+                out   = (out << 1) | ((a ^ (state >> 2) ^ state) & 1);
+                state = (a << 2) | (state >> 1);
             }
-            if(fabs(d_re[i]) < four_over_sqrt_42)
+            phy_struct->cell->te_table[s][in] = (state << 8) | out;
+        }
+    }
+}
+
+/*********************************************************************
+    Name: turbo_decode
+
+    Description: Turbo decodes data according to the LTE Parallel
+                 Concatenated Convolutional Code.  Two max-log-MAP
+                 constituent decoders exchange extrinsic information
+                 for up to td_N_iter iterations, stopping as soon as
+                 the code block CRC passes.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+*********************************************************************/
+LIBLTE_ERROR_ENUM turbo_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                               float             *d_bits,
+                               uint32             N_d_bits,
+                               uint32             N_fill_bits,
+                               uint32             crc,
+                               uint8             *c_bits,
+                               uint32            *N_c_bits)
+{
+    LIBLTE_ERROR_ENUM  err       = LIBLTE_ERROR_INVALID_CRC;
+    float              max_value = 0;
+    float              scale     = 0;
+    float              tmp;
+    int32              llr;
+    uint32             i;
+    uint32             j;
+    uint32             iter;
+    uint32             N_branch_bits = N_d_bits/3;
+    uint32             K;
+    uint16            *int_idx;
+    int16             *in;
+    uint8              p_bits[24];
+
+    // Scratch, allocated on first use
+    if(NULL == phy_struct->td_scratch)
+    {
+        phy_struct->td_scratch = (LIBLTE_PHY_TD_SCRATCH_STRUCT *)malloc(sizeof(LIBLTE_PHY_TD_SCRATCH_STRUCT));
+    }
+    int_idx = phy_struct->td_scratch->td_int_idx;
+    in      = phy_struct->td_scratch->td_in;
+
+    // K must be one of the interleaver sizes
+    if(N_branch_bits  <  4 ||
+       LIBLTE_SUCCESS != turbo_internal_interleaver_idx(N_branch_bits - 4, int_idx))
+    {
+        return(LIBLTE_ERROR_INVALID_INPUTS);
+    }
+    K = N_branch_bits - 4;
+
+    // Quantize the soft bits, NULL bits carry no information
+    for(i=0; i<N_d_bits; i++)
+    {
+        if(d_bits[i]       != RX_NULL_BIT &&
+           fabs(d_bits[i])  > max_value)
+        {
+            max_value = fabs(d_bits[i]);
+        }
+    }
+    if(max_value > 0)
+    {
+        scale = TD_IN_MAX/max_value;
+    }
+    for(i=0; i<N_d_bits; i++)
+    {
+        if(d_bits[i] == RX_NULL_BIT)
+        {
+            in[i] = 0;
+        }else{
+            tmp   = d_bits[i]*scale;
+            in[i] = (int16)lroundf(tmp);
+        }
+    }
+
+    // Split the input into systematic, parity, and tail streams
+    for(i=0; i<K; i++)
+    {
+        phy_struct->td_scratch->td_sys[i]   = in[i*3+0];
+        phy_struct->td_scratch->td_par_1[i] = in[i*3+1];
+        phy_struct->td_scratch->td_par_2[i] = in[i*3+2];
+    }
+    for(i=0; i<N_fill_bits; i++)
+    {
+        phy_struct->td_scratch->td_sys[i] = TD_IN_MAX;
+    }
+    for(i=0; i<K; i++)
+    {
+        phy_struct->td_scratch->td_sys_int[i] = phy_struct->td_scratch->td_sys[int_idx[i]];
+        phy_struct->td_scratch->td_ext_2[i]   = 0;
+    }
+    for(i=0; i<6; i++)
+    {
+        phy_struct->td_scratch->td_tail_1[i] = in[K*3+i];
+        phy_struct->td_scratch->td_tail_2[i] = in[(K+2)*3+i];
+    }
+
+    for(iter=0; iter<phy_struct->td_N_iter; iter++)
+    {
+        // First constituent decoder, natural order
+        for(i=0; i<K; i++)
+        {
+            phy_struct->td_scratch->td_apriori[int_idx[i]] = phy_struct->td_scratch->td_ext_2[i];
+        }
+        turbo_map_decode(phy_struct,
+                         phy_struct->td_scratch->td_sys,
+                         phy_struct->td_scratch->td_par_1,
+                         phy_struct->td_scratch->td_apriori,
+                         phy_struct->td_scratch->td_tail_1,
+                         K,
+                         phy_struct->td_scratch->td_ext_1);
+
+        // Second constituent decoder, interleaved order
+        for(i=0; i<K; i++)
+        {
+            phy_struct->td_scratch->td_apriori[i] = phy_struct->td_scratch->td_ext_1[int_idx[i]];
+        }
+        turbo_map_decode(phy_struct,
+                         phy_struct->td_scratch->td_sys_int,
+                         phy_struct->td_scratch->td_par_2,
+                         phy_struct->td_scratch->td_apriori,
+                         phy_struct->td_scratch->td_tail_2,
+                         K,
+                         phy_struct->td_scratch->td_ext_2);
+
+        // Hard decision
+        for(i=0; i<K; i++)
+        {
+            llr = (phy_struct->td_scratch->td_sys_int[i] +
+                   phy_struct->td_scratch->td_apriori[i] +
+                   phy_struct->td_scratch->td_ext_2[i]);
+            c_bits[int_idx[i]] = (llr < 0) ? 1 : 0;
+        }
+
+        // Early termination
+        calc_crc(c_bits, K-24, crc, p_bits, 24);
+        for(j=0; j<24; j++)
+        {
+            if(p_bits[j] != c_bits[K-24+j])
             {
-                bits[i*6+2] = +127;
-                if(fabs(d_re[i]) > two_over_sqrt_42)
-                {
-                    bits[i*6+4] = +127;
-                }else{
-                    bits[i*6+4] = -127;
-                }
-            }else{
-                bits[i*6+2] = -127;
-                if(fabs(d_re[i]) < six_over_sqrt_42)
-                {
-                    bits[i*6+4] = +127;
-                }else{
-                    bits[i*6+4] = -127;
-                }
+                break;
             }
-            if(fabs(d_im[i]) < four_over_sqrt_42)
-            {
-                bits[i*6+3] = +127;
-                if(fabs(d_im[i]) > two_over_sqrt_42)
-                {
-                    bits[i*6+5] = +127;
-                }else{
-                    bits[i*6+5] = -127;
-                }
-            }else{
-                bits[i*6+3] = -127;
-                if(fabs(d_im[i]) < six_over_sqrt_42)
-                {
-                    bits[i*6+5] = +127;
-                }else{
-                    bits[i*6+5] = -127;
-                }
+        }
+        if(24 == j)
+        {
+            err = LIBLTE_SUCCESS;
+            break;
+        }
+    }
+    *N_c_bits = K;
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: turbo_map_decode
+
+    Description: Max-log-MAP (BCJR) decoder for one of the LTE turbo
+                 code constituent encoders.  The 8 trellis states are
+                 processed as 8 int16 lanes, the trellis termination is
+                 handled here and the recursions by the selected
+                 turbo_map_recursions kernel.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2.1
+
+    Notes: Branch and path metrics are kept at twice their natural
+           scale and the extrinsic output is scaled by 0.75
+*********************************************************************/
+void turbo_map_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                      int16             *sys,
+                      int16             *par,
+                      int16             *apriori,
+                      int16             *tail,
+                      uint32             K,
+                      int16             *ext)
+{
+    int16 beta[8];
+    int16 tmp[8];
+    int32 m;
+    int32 s;
+    int32 i;
+
+    // Trellis termination, each state takes its a=0 branch and the
+    // systematic bit equals the feedback bit
+    for(s=0; s<8; s++)
+    {
+        beta[s] = TD_METRIC_MIN;
+    }
+    beta[0] = 0;
+    for(i=2; i>=0; i--)
+    {
+        for(s=0; s<8; s++)
+        {
+            m  = beta[s>>1];
+            m += (tail[i*2+0] ^ TD_BWD_U_MASK[s]) - TD_BWD_U_MASK[s];
+            m += (tail[i*2+1] ^ TD_BWD_P_MASK[s]) - TD_BWD_P_MASK[s];
+            tmp[s] = (m < TD_METRIC_MIN) ? TD_METRIC_MIN : m;
+        }
+        for(s=0; s<8; s++)
+        {
+            beta[s] = tmp[s] - tmp[0];
+        }
+    }
+
+    PHY_KERNELS.turbo_map_recursions(phy_struct, sys, par, apriori, beta, K, ext);
+}
+
+/*********************************************************************
+    Name: turbo_map_recursions_scalar
+
+    Description: Forward and backward recursions of turbo_map_decode,
+                 starting the backward recursion from the terminated
+                 beta
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2.1
+*********************************************************************/
+void turbo_map_recursions_scalar(LIBLTE_PHY_STRUCT *phy_struct,
+                                 int16             *sys,
+                                 int16             *par,
+                                 int16             *apriori,
+                                 int16             *beta,
+                                 uint32             K,
+                                 int16             *ext)
+{
+    int16 *alpha = phy_struct->td_scratch->td_alpha;
+    int16  tmp[8];
+    int16  b[8];
+    int16  b0[8];
+    int16  b1[8];
+    int16  g;
+    int16  gp;
+    int32  lsa;
+    int32  m;
+    int32  m0;
+    int32  m1;
+    int32  max_0;
+    int32  max_1;
+    int32  s;
+    int32  k;
+
+    // Forward recursion, the predecessors of state s are 2*(s%4) and
+    // 2*(s%4)+1 and the second branch metric is the negated first
+    for(s=0; s<8; s++)
+    {
+        tmp[s] = TD_METRIC_MIN;
+    }
+    tmp[0] = 0;
+    for(k=0; k<(int32)K; k++)
+    {
+        memcpy(&alpha[k*8], tmp, sizeof(tmp));
+        lsa = sys[k] + apriori[k];
+        for(s=0; s<8; s++)
+        {
+            g  = (lsa    ^ TD_FWD_U_MASK[s]) - TD_FWD_U_MASK[s];
+            g += (par[k] ^ TD_FWD_P_MASK[s]) - TD_FWD_P_MASK[s];
+            m0 = alpha[k*8+2*(s&3)]   + g;
+            m1 = alpha[k*8+2*(s&3)+1] - g;
+            tmp[s] = (m0 > m1) ? m0 : m1;
+        }
+        for(s=7; s>=0; s--)
+        {
+            tmp[s] -= tmp[0];
+        }
+    }
+
+    // Backward recursion and extrinsic calculation, the successors
+    // of state s are s/2 and s/2+4 and the second branch metric is
+    // the negated first
+    memcpy(b, beta, sizeof(b));
+    for(k=K-1; k>=0; k--)
+    {
+        lsa   = sys[k] + apriori[k];
+        max_0 = -32768;
+        max_1 = -32768;
+        for(s=0; s<8; s++)
+        {
+            b0[s] = b[s>>1];
+            b1[s] = b[(s>>1)+4];
+            gp    = (par[k] ^ TD_BWD_P_MASK[s]) - TD_BWD_P_MASK[s];
+            m0    = alpha[k*8+s] + gp + b0[s];
+            m1    = alpha[k*8+s] - gp + b1[s];
+            if(TD_BWD_U_MASK[s])
+            {
+                m  = m0;
+                m0 = m1;
+                m1 = m;
             }
+            max_0 = (m0 > max_0) ? m0 : max_0;
+            max_1 = (m1 > max_1) ? m1 : max_1;
+        }
+        m      = ((max_0 - max_1)*3) >> 3;
+        ext[k] = (m > TD_EXT_MAX) ? TD_EXT_MAX : ((m < -TD_EXT_MAX) ? -TD_EXT_MAX : m);
+
+        for(s=0; s<8; s++)
+        {
+            g  = (lsa    ^ TD_BWD_U_MASK[s]) - TD_BWD_U_MASK[s];
+            g += (par[k] ^ TD_BWD_P_MASK[s]) - TD_BWD_P_MASK[s];
+            m0 = b0[s] + g;
+            m1 = b1[s] - g;
+            tmp[s] = (m0 > m1) ? m0 : m1;
+        }
+        for(s=0; s<8; s++)
+        {
+            b[s] = tmp[s] - tmp[0];
         }
     }
 }
 
+#if defined(__SSE2__)
 /*********************************************************************
-    Name: generate_prs_c
+    Name: turbo_map_recursions_sse2
 
-    Description: Generates the psuedo random sequence c
+    Description: SSE2 version of turbo_map_recursions_scalar
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2.1
 *********************************************************************/
-void generate_prs_c(uint32  c_init,
-                    uint32  len,
-                    uint32 *c)
+void turbo_map_recursions_sse2(LIBLTE_PHY_STRUCT *phy_struct,
+                               int16             *sys,
+                               int16             *par,
+                               int16             *apriori,
+                               int16             *beta,
+                               uint32             K,
+                               int16             *ext)
 {
-    uint32 i;
-    uint32 x1;
-    uint32 x2;
-    uint8  new_bit1;
-    uint8  new_bit2;
-
-    // Initialize the 2nd m-sequence
-    x2 = c_init;
-
-    // Advance the 2nd m-sequence
-    for(i=0; i<(1600-31); i++)
+    int16   *alpha   = phy_struct->td_scratch->td_alpha;
+    int32    lsa;
+    int32    m;
+    int32    k;
+    __m128i  a_v;
+    __m128i  b_v;
+    __m128i  b0_v;
+    __m128i  b1_v;
+    __m128i  lsa_v;
+    __m128i  lp_v;
+    __m128i  g_v;
+    __m128i  m0_v;
+    __m128i  m1_v;
+    __m128i  x_v;
+    __m128i  fwd_u_m = _mm_loadu_si128((__m128i *)TD_FWD_U_MASK);
+    __m128i  fwd_p_m = _mm_loadu_si128((__m128i *)TD_FWD_P_MASK);
+    __m128i  bwd_u_m = _mm_loadu_si128((__m128i *)TD_BWD_U_MASK);
+    __m128i  bwd_p_m = _mm_loadu_si128((__m128i *)TD_BWD_P_MASK);
+
+    // Forward recursion, the predecessors of state s are 2*(s%4) and
+    // 2*(s%4)+1 and the second branch metric is the negated first
+    a_v = _mm_set_epi16(TD_METRIC_MIN, TD_METRIC_MIN, TD_METRIC_MIN, TD_METRIC_MIN,
+                        TD_METRIC_MIN, TD_METRIC_MIN, TD_METRIC_MIN, 0);
+    for(k=0; k<(int32)K; k++)
     {
-        new_bit2 = ((x2 >> 3) ^ (x2 >> 2) ^ (x2 >> 1) ^ x2) & 0x1;
-
-        x2 = (x2 >> 1) | (new_bit2 << 30);
+        _mm_storeu_si128((__m128i *)&alpha[k*8], a_v);
+        lsa   = sys[k] + apriori[k];
+        lsa_v = _mm_set1_epi16(lsa);
+        lp_v  = _mm_set1_epi16(par[k]);
+        g_v   = _mm_adds_epi16(_mm_sub_epi16(_mm_xor_si128(lsa_v, fwd_u_m), fwd_u_m),
+                               _mm_sub_epi16(_mm_xor_si128(lp_v, fwd_p_m), fwd_p_m));
+        m0_v  = _mm_srai_epi32(_mm_slli_epi32(a_v, 16), 16);
+        m1_v  = _mm_srai_epi32(a_v, 16);
+        m0_v  = _mm_packs_epi32(m0_v, m0_v);
+        m1_v  = _mm_packs_epi32(m1_v, m1_v);
+        a_v   = _mm_max_epi16(_mm_adds_epi16(m0_v, g_v),
+                              _mm_subs_epi16(m1_v, g_v));
+        x_v   = _mm_shuffle_epi32(_mm_shufflelo_epi16(a_v, 0), 0);
+        a_v   = _mm_subs_epi16(a_v, x_v);
     }
 
-    // Initialize the 1st m-sequence
-    x1 = 0x54D21B24; // This is the result of advancing the initial value of 0x00000001
-
-    // Generate c
-    for(i=0; i<len; i++)
+    // Backward recursion and extrinsic calculation, the successors
+    // of state s are s/2 and s/2+4 and the second branch metric is
+    // the negated first
+    b_v = _mm_loadu_si128((__m128i *)beta);
+    for(k=K-1; k>=0; k--)
     {
-        new_bit1 = ((x1 >> 3) ^ x1) & 0x1;
-        new_bit2 = ((x2 >> 3) ^ (x2 >> 2) ^ (x2 >> 1) ^ x2) & 0x1;
-
-        x1 = (x1 >> 1) | (new_bit1 << 30);
-        x2 = (x2 >> 1) | (new_bit2 << 30);
-
-        c[i] = new_bit1 ^ new_bit2;
+        a_v   = _mm_loadu_si128((__m128i *)&alpha[k*8]);
+        lsa   = sys[k] + apriori[k];
+        lsa_v = _mm_set1_epi16(lsa);
+        lp_v  = _mm_set1_epi16(par[k]);
+        b0_v  = _mm_unpacklo_epi16(b_v, b_v);
+        b1_v  = _mm_unpackhi_epi16(b_v, b_v);
+
+        // Extrinsic, parity contribution only
+        g_v  = _mm_sub_epi16(_mm_xor_si128(lp_v, bwd_p_m), bwd_p_m);
+        m0_v = _mm_adds_epi16(_mm_adds_epi16(a_v, g_v), b0_v);
+        m1_v = _mm_adds_epi16(_mm_subs_epi16(a_v, g_v), b1_v);
+        x_v  = m0_v;
+        m0_v = _mm_or_si128(_mm_and_si128(bwd_u_m, m1_v), _mm_andnot_si128(bwd_u_m, m0_v));
+        m1_v = _mm_or_si128(_mm_and_si128(bwd_u_m, x_v), _mm_andnot_si128(bwd_u_m, m1_v));
+        m0_v = _mm_max_epi16(m0_v, _mm_shuffle_epi32(m0_v, 0x4E));
+        m1_v = _mm_max_epi16(m1_v, _mm_shuffle_epi32(m1_v, 0x4E));
+        m0_v = _mm_max_epi16(m0_v, _mm_shuffle_epi32(m0_v, 0xB1));
+        m1_v = _mm_max_epi16(m1_v, _mm_shuffle_epi32(m1_v, 0xB1));
+        m0_v = _mm_max_epi16(m0_v, _mm_shufflelo_epi16(m0_v, 0xB1));
+        m1_v = _mm_max_epi16(m1_v, _mm_shufflelo_epi16(m1_v, 0xB1));
+        m    = (((int16)_mm_extract_epi16(m0_v, 0) - (int16)_mm_extract_epi16(m1_v, 0))*3) >> 3;
+        ext[k] = (m > TD_EXT_MAX) ? TD_EXT_MAX : ((m < -TD_EXT_MAX) ? -TD_EXT_MAX : m);
+
+        // Beta
+        g_v = _mm_adds_epi16(_mm_sub_epi16(_mm_xor_si128(lsa_v, bwd_u_m), bwd_u_m), g_v);
+        b_v = _mm_max_epi16(_mm_adds_epi16(b0_v, g_v),
+                            _mm_subs_epi16(b1_v, g_v));
+        x_v = _mm_shuffle_epi32(_mm_shufflelo_epi16(b_v, 0), 0);
+        b_v = _mm_subs_epi16(b_v, x_v);
     }
 }
+#endif
 
+#if defined(PHY_KERNEL_X86)
 /*********************************************************************
-    Name: calc_crc
+    Name: turbo_map_recursions_sse4_1
 
-    Description: Calculates one of the LTE CRCs
+    Description: SSE4.1 version of turbo_map_recursions_scalar.  The
+                 branch metric sign flips use psignw, the even and odd
+                 predecessors are gathered with pshufb, and the
+                 extrinsic maximums come from phminposuw on the
+                 metrics flipped by 0x7FFF.
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2.1
 *********************************************************************/
-void calc_crc(uint8  *a_bits,
-              uint32  N_a_bits,
-              uint32  crc,
-              uint8  *p_bits,
-              uint32  N_p_bits)
+PHY_TARGET_SSE4_1
+void turbo_map_recursions_sse4_1(LIBLTE_PHY_STRUCT *phy_struct,
+                                 int16             *sys,
+                                 int16             *par,
+                                 int16             *apriori,
+                                 int16             *beta,
+                                 uint32             K,
+                                 int16             *ext)
 {
-    uint32 i;
-    uint32 crc_rem   = 0;
-    uint32 crc_check = (1 << N_p_bits);
-    uint8  tmp_array[N_a_bits + N_p_bits];
-
-    // Initialize tmp_array
-    memset(tmp_array, 0, N_a_bits + N_p_bits);
-    memcpy(tmp_array, a_bits, N_a_bits);
-
-    for(i=0; i<N_a_bits + N_p_bits; i++)
+    int16   *alpha   = phy_struct->td_scratch->td_alpha;
+    int32    m;
+    int32    k;
+    __m128i  a_v;
+    __m128i  b_v;
+    __m128i  b0_v;
+    __m128i  b1_v;
+    __m128i  lsa_v;
+    __m128i  lp_v;
+    __m128i  g_v;
+    __m128i  m0_v;
+    __m128i  m1_v;
+    __m128i  x_v;
+    __m128i  one_v   = _mm_set1_epi16(1);
+    __m128i  flip_v  = _mm_set1_epi16(0x7FFF);
+    __m128i  fwd_u_s = _mm_or_si128(_mm_loadu_si128((__m128i *)TD_FWD_U_MASK), one_v);
+    __m128i  fwd_p_s = _mm_or_si128(_mm_loadu_si128((__m128i *)TD_FWD_P_MASK), one_v);
+    __m128i  bwd_u_m = _mm_loadu_si128((__m128i *)TD_BWD_U_MASK);
+    __m128i  bwd_u_s = _mm_or_si128(bwd_u_m, one_v);
+    __m128i  bwd_p_s = _mm_or_si128(_mm_loadu_si128((__m128i *)TD_BWD_P_MASK), one_v);
+    __m128i  even_v  = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 0, 1, 4, 5, 8, 9, 12, 13);
+    __m128i  odd_v   = _mm_setr_epi8(2, 3, 6, 7, 10, 11, 14, 15, 2, 3, 6, 7, 10, 11, 14, 15);
+    __m128i  bcast_v = _mm_set1_epi16(0x0100);
+
+    // Forward recursion, the predecessors of state s are 2*(s%4) and
+    // 2*(s%4)+1 and the second branch metric is the negated first
+    a_v = _mm_set_epi16(TD_METRIC_MIN, TD_METRIC_MIN, TD_METRIC_MIN, TD_METRIC_MIN,
+                        TD_METRIC_MIN, TD_METRIC_MIN, TD_METRIC_MIN, 0);
+    for(k=0; k<(int32)K; k++)
     {
-        crc_rem <<= 1;
-        crc_rem  |= tmp_array[i];
-
-        if(crc_rem & crc_check)
-        {
-            crc_rem ^= crc;
-        }
+        _mm_storeu_si128((__m128i *)&alpha[k*8], a_v);
+        lsa_v = _mm_set1_epi16(sys[k] + apriori[k]);
+        lp_v  = _mm_set1_epi16(par[k]);
+        g_v   = _mm_adds_epi16(_mm_sign_epi16(lsa_v, fwd_u_s), _mm_sign_epi16(lp_v, fwd_p_s));
+        m0_v  = _mm_shuffle_epi8(a_v, even_v);
+        m1_v  = _mm_shuffle_epi8(a_v, odd_v);
+        a_v   = _mm_max_epi16(_mm_adds_epi16(m0_v, g_v),
+                              _mm_subs_epi16(m1_v, g_v));
+        a_v   = _mm_subs_epi16(a_v, _mm_shuffle_epi8(a_v, bcast_v));
     }
 
-    for(i=0; i<N_p_bits; i++)
+    // Backward recursion and extrinsic calculation, the successors
+    // of state s are s/2 and s/2+4 and the second branch metric is
+    // the negated first
+    b_v = _mm_loadu_si128((__m128i *)beta);
+    for(k=K-1; k>=0; k--)
     {
-        p_bits[i] = (crc_rem >> (N_p_bits-1-i)) & 1;
+        a_v   = _mm_loadu_si128((__m128i *)&alpha[k*8]);
+        lsa_v = _mm_set1_epi16(sys[k] + apriori[k]);
+        lp_v  = _mm_set1_epi16(par[k]);
+        b0_v  = _mm_unpacklo_epi16(b_v, b_v);
+        b1_v  = _mm_unpackhi_epi16(b_v, b_v);
+
+        // Extrinsic, parity contribution only.  x^0x7FFF is 0x7FFF-x
+        // as an unsigned value, so its minimum gives the maximum of x.
+        g_v  = _mm_sign_epi16(lp_v, bwd_p_s);
+        m0_v = _mm_adds_epi16(_mm_adds_epi16(a_v, g_v), b0_v);
+        m1_v = _mm_adds_epi16(_mm_subs_epi16(a_v, g_v), b1_v);
+        x_v  = m0_v;
+        m0_v = _mm_blendv_epi8(m0_v, m1_v, bwd_u_m);
+        m1_v = _mm_blendv_epi8(m1_v, x_v, bwd_u_m);
+        m0_v = _mm_minpos_epu16(_mm_xor_si128(m0_v, flip_v));
+        m1_v = _mm_minpos_epu16(_mm_xor_si128(m1_v, flip_v));
+        m    = (((int32)_mm_extract_epi16(m1_v, 0) - (int32)_mm_extract_epi16(m0_v, 0))*3) >> 3;
+        ext[k] = (m > TD_EXT_MAX) ? TD_EXT_MAX : ((m < -TD_EXT_MAX) ? -TD_EXT_MAX : m);
+
+        // Beta
+        g_v = _mm_adds_epi16(_mm_sign_epi16(lsa_v, bwd_u_s), g_v);
+        b_v = _mm_max_epi16(_mm_adds_epi16(b0_v, g_v),
+                            _mm_subs_epi16(b1_v, g_v));
+        b_v = _mm_subs_epi16(b_v, _mm_shuffle_epi8(b_v, bcast_v));
     }
 }
+#endif
 
 /*********************************************************************
-    Name: code_block_segmentation
+    Name: turbo_internal_interleaver
 
-    Description: Performs code block segmentation for turbo coded
-                 channels
+    Description: Internal interleaver for the LTE Parallel
+                 Concatenated Convolutional Code, N_in_bits must be
+                 one of the 188 sizes in TURBO_INT_K_TABLE
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 *********************************************************************/
-void code_block_segmentation(uint8  *b_bits,
-                             uint32  N_b_bits,
-                             uint32 *N_codeblocks,
-                             uint32 *N_filler_bits,
-                             uint8  *c_bits,
-                             uint32  N_c_bits_max,
-                             uint32 *N_c_bits)
+LIBLTE_ERROR_ENUM turbo_internal_interleaver_idx(uint32  N_in_bits,
+                                                 uint16 *idx)
 {
-    uint32 Z = 6144;
-    uint32 L;
-    uint32 B;
-    uint32 C;
-    uint32 F;
-    uint32 B_prime;
-    uint32 K_plus  = 0;
-    uint32 K_minus = 0;
-    uint32 K_delta;
-    uint32 K_r;
-    uint32 C_plus;
-    uint32 C_minus;
-    uint32 k;
-    uint32 s;
-    uint32 r;
-    int32  i;
-    uint8  p_cb_bits[24];
+    uint32 i;
+    uint32 f1 = 0;
+    uint32 f2 = 0;
+    uint32 pi;
+    uint32 delta;
 
-    // Determine L, C, B', K+, C+, K-, and C-
-    if(N_b_bits <= Z)
+    // Determine f1 and f2
+    for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
     {
-        L       = 0;
-        C       = 1;
-        B_prime = N_b_bits;
-        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
-        {
-            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
-            {
-                K_plus = TURBO_INT_K_TABLE[i];
-                break;
-            }
-        }
-        K_minus = 0;
-        C_plus  = 1;
-        C_minus = 0;
-    }else{
-        B       = N_b_bits;
-        L       = 24;
-        C       = (uint32)ceilf((float)B/(float)(Z-L));
-        B_prime = B + C*L;
-        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
-        {
-            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
-            {
-                K_plus = TURBO_INT_K_TABLE[i];
-                break;
-            }
-        }
-        for(i=TURBO_INT_K_TABLE_SIZE-1; i>=0; i--)
+        if(N_in_bits == TURBO_INT_K_TABLE[i])
         {
-            if(TURBO_INT_K_TABLE[i] < K_plus)
-            {
-                K_minus = TURBO_INT_K_TABLE[i];
-                break;
-            }
+            f1 = TURBO_INT_F1_TABLE[i];
+            f2 = TURBO_INT_F2_TABLE[i];
+            break;
         }
-        K_delta = K_plus - K_minus;
-        C_minus = (C*K_plus - B_prime)/K_delta;
-        C_plus  = C - C_minus;
     }
-
-    // Determine the number of filler bits and add them
-    *N_codeblocks  = C;
-    F              = C_plus*K_plus + C_minus*K_minus - B_prime;
-    *N_filler_bits = F;
-    for(i=0; i<(int32)F; i++)
+    if(TURBO_INT_K_TABLE_SIZE == i)
     {
-        c_bits[i] = TX_NULL_SYMB;
+        return(LIBLTE_ERROR_INVALID_INPUTS);
     }
 
-    // Add the input bits
-    k = F;
-    s = 0;
-    for(r=0; r<C; r++)
+    // Use pi(i+1) = pi(i) + f1 + f2*(2i+1) to avoid multiplies, both
+    // terms stay below N_in_bits so a subtraction replaces the modulo
+    pi    = 0;
+    delta = (f1 + f2) % N_in_bits;
+    f2    = (2*f2) % N_in_bits;
+    for(i=0; i<N_in_bits; i++)
     {
-        // Determine the K for this code block
-        if(r < C_minus)
-        {
-            K_r = K_minus;
-        }else{
-            K_r = K_plus;
-        }
-        N_c_bits[r] = K_r;
-
-        // Add the input bits
-        while(k < (K_r - L))
+        idx[i] = pi;
+        pi    += delta;
+        if(pi >= N_in_bits)
         {
-            c_bits[r*N_c_bits_max+k] = b_bits[s++];
-            k++;
+            pi -= N_in_bits;
         }
-
-        // Add CRC if more than 1 code block is needed
-        if(C > 1)
+        delta += f2;
+        if(delta >= N_in_bits)
         {
-            calc_crc(&c_bits[r*N_c_bits_max], N_c_bits[r], CRC24B, p_cb_bits, L);
-            N_c_bits[r] += L;
-            while(k < K_r)
-            {
-                c_bits[r*N_c_bits_max+k] = p_cb_bits[k+L-K_r];
-                k++;
-            }
+            delta -= N_in_bits;
         }
-        k = 0;
     }
+
+    return(LIBLTE_SUCCESS);
 }
 
 /*********************************************************************
-    Name: code_block_desegmentation
+    Name: rate_match_turbo_table
 
-    Description: Performs code block desegmentation for turbo coded
-                 channels
+    Description: Looks up the circular buffer index table of a turbo
+                 code block in the rate match index cache, building it
+                 in place of the least recently used entry if needed
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1
 *********************************************************************/
-void code_block_desegmentation(uint8  *c_bits,
-                               uint32 *N_c_bits,
-                               uint32  N_c_bits_max,
-                               uint32  tbs,
-                               uint8  *b_bits,
-                               uint32  N_b_bits)
+LIBLTE_PHY_RM_CACHE_STRUCT* rate_match_turbo_table(LIBLTE_PHY_STRUCT         *phy_struct,
+                                                   uint32                     N_branch_bits,
+                                                   uint32                     N_fill_bits,
+                                                   uint32                     N_codeblocks,
+                                                   uint32                     tx_mode,
+                                                   uint32                     N_soft,
+                                                   uint32                     M_dl_harq,
+                                                   LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type)
 {
-    uint32  Z = 6144;
-    uint32  L;
-    uint32  B;
-    uint32  C;
-    uint32  F;
-    uint32  B_prime;
-    uint32  K_plus  = 0;
-    uint32  K_minus = 0;
-    uint32  K_delta;
-    uint32  K_r;
-    uint32  C_plus;
-    uint32  C_minus;
-    uint32  k;
-    uint32  s;
-    uint32  r;
-    uint32  ber;
-    int32   i;
-    uint8  *p_cb_bits;
-    uint8   calc_p_cb_bits[24];
+    LIBLTE_PHY_RM_CACHE_STRUCT *entry   = NULL;
+    uint16                     *w_idx;
+    uint32                      C_tc_sb = 32; // Step 1: Assign C_tc_sb to 32
+    uint32                      R_tc_sb;
+    uint32                      N_dummy;
+    uint32                      K_mimo;
+    uint32                      N_ir;
+    uint32                      N_cb;
+    uint32                      K_pi;
+    uint32                      K_w;
+    uint32                      k_0[4];
+    uint32                      y_idx;
+    uint32                      rv;
+    uint32                      i;
+    uint32                      j;
+    uint32                      k;
 
-    // Determine L, C, B', K+, C+, K-, and C-
-    if(tbs+24 <= Z)
+    // Sub-block interleaving
+    // Step 2: Determine the number of rows
+    R_tc_sb = 0;
+    while(N_branch_bits > (C_tc_sb*R_tc_sb))
     {
-        L       = 0;
-        C       = 1;
-        B_prime = tbs+24;
-        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
+        R_tc_sb++;
+    }
+    K_pi    = R_tc_sb*C_tc_sb;
+    N_dummy = K_pi - N_branch_bits;
+
+    // Bit collection, selection, and transmission
+    // Determine the circular buffer size
+    K_w = 3*K_pi;
+    if(tx_mode == 3 ||
+       tx_mode == 4 ||
+       tx_mode == 8 ||
+       tx_mode == 9)
+    {
+        K_mimo = 2;
+    }else{
+        K_mimo = 1;
+    }
+    if(M_dl_harq < 8)
+    {
+        N_ir = N_soft/(K_mimo*M_dl_harq);
+    }else{
+        N_ir = N_soft/(K_mimo*8);
+    }
+    if(LIBLTE_PHY_CHAN_TYPE_DLSCH == chan_type ||
+       LIBLTE_PHY_CHAN_TYPE_PCH   == chan_type)
+    {
+        if((N_ir/N_codeblocks) < K_w)
         {
-            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
-            {
-                K_plus = TURBO_INT_K_TABLE[i];
-                break;
-            }
+            N_cb = N_ir/N_codeblocks;
+        }else{
+            N_cb = K_w;
         }
-        K_minus = 0;
-        C_plus  = 1;
-        C_minus = 0;
     }else{
-        B       = tbs+24;
-        L       = 24;
-        C       = (uint32)ceilf((float)B/(float)(Z-L));
-        B_prime = B + C*L;
-        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
+        N_cb = K_w;
+    }
+
+    // Look for the table, otherwise replace the least recently used entry
+    for(i=0; i<LIBLTE_PHY_RM_CACHE_N_ENTRIES; i++)
+    {
+        if(0             != phy_struct->rm_cache[i].N_idx         &&
+           N_branch_bits == phy_struct->rm_cache[i].N_branch_bits &&
+           N_fill_bits   == phy_struct->rm_cache[i].N_fill_bits   &&
+           N_cb          == phy_struct->rm_cache[i].N_cb)
         {
-            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
-            {
-                K_plus = TURBO_INT_K_TABLE[i];
-                break;
-            }
+            entry            = &phy_struct->rm_cache[i];
+            entry->last_used = ++phy_struct->rm_cache_time;
+            return(entry);
         }
-        for(i=TURBO_INT_K_TABLE_SIZE-1; i>=0; i--)
+        if(NULL                               == entry ||
+           phy_struct->rm_cache[i].last_used  <  entry->last_used)
         {
-            if(TURBO_INT_K_TABLE[i] < K_plus)
-            {
-                K_minus = TURBO_INT_K_TABLE[i];
-                break;
-            }
+            entry = &phy_struct->rm_cache[i];
         }
-        K_delta = K_plus - K_minus;
-        C_minus = (C*K_plus - B_prime)/K_delta;
-        C_plus  = C - C_minus;
     }
 
-    // Determine the number of filler bits
-    F = C_plus*K_plus + C_minus*K_minus - B_prime;
-
-    // Determine the output bits
-    k = F;
-    s = 0;
-    for(r=0; r<C; r++)
+    // Steps 3, 4, and 5, map each circular buffer position to its
+    // interleaved d index, dummy and filler positions map to
+    // RMT_NULL_IDX
+    w_idx = entry->idx;
+    for(j=0; j<C_tc_sb; j++)
     {
-        // Determine the K for this code block
-        if(r < C_minus)
+        for(i=0; i<R_tc_sb; i++)
         {
-            K_r = K_minus;
-        }else{
-            K_r = K_plus;
-        }
+            k = j*R_tc_sb + i;
 
-        // Check CRC if more than 1 code block is present
-        if(C > 1)
-        {
-            calc_crc(&c_bits[r*N_c_bits_max], N_c_bits[r]-L, CRC24B, calc_p_cb_bits, L);
-            p_cb_bits = &c_bits[r*N_c_bits_max+N_c_bits[r]-L];
-            ber       = 0;
-            for(i=0; i<(int32)L; i++)
+            // d0 and d1, inter-column permutation
+            y_idx = i*C_tc_sb + IC_PERM_TC[j];
+            if(y_idx < N_dummy ||
+               (y_idx - N_dummy) < N_fill_bits)
             {
-                ber += p_cb_bits[i] ^ calc_p_cb_bits[i];
+                w_idx[k]          = RMT_NULL_IDX;
+                w_idx[K_pi+(2*k)] = RMT_NULL_IDX;
+            }else{
+                w_idx[k]          = (y_idx - N_dummy)*3;
+                w_idx[K_pi+(2*k)] = (y_idx - N_dummy)*3 + 1;
             }
-            if(ber == 0)
+
+            // d2, permutation for the last output
+            y_idx = (IC_PERM_TC[j] + C_tc_sb*i + 1) % K_pi;
+            if(y_idx < N_dummy)
             {
-                printf("CB CRC CORRECT\n");
+                w_idx[K_pi+(2*k)+1] = RMT_NULL_IDX;
             }else{
-                printf("CB CRC INCORRECT\n");
+                w_idx[K_pi+(2*k)+1] = (y_idx - N_dummy)*3 + 2;
+            }
+        }
+    }
+
+    // Drop the NULL positions of the first N_cb, noting where each
+    // redundancy version starts reading
+    for(rv=0; rv<4; rv++)
+    {
+        k_0[rv] = (R_tc_sb*(2*(uint32)ceilf((float)N_cb/(float)(8*R_tc_sb))*rv+2)) % N_cb;
+    }
+    k = 0;
+    for(j=0; j<N_cb; j++)
+    {
+        for(rv=0; rv<4; rv++)
+        {
+            if(j == k_0[rv])
+            {
+                entry->rv_start[rv] = k;
             }
         }
-
-        // Create the output bits
-        while(k < (K_r - L))
+        if(w_idx[j] != RMT_NULL_IDX)
         {
-            b_bits[s++] = c_bits[r*N_c_bits_max+k];
-            k++;
+            w_idx[k++] = w_idx[j];
+        }
+    }
+    for(rv=0; rv<4; rv++)
+    {
+        if(entry->rv_start[rv] == k)
+        {
+            entry->rv_start[rv] = 0;
         }
-        k = 0;
     }
+    entry->N_idx         = k;
+    entry->N_branch_bits = N_branch_bits;
+    entry->N_fill_bits   = N_fill_bits;
+    entry->N_cb          = N_cb;
+    entry->last_used     = ++phy_struct->rm_cache_time;
+
+    return(entry);
 }
 
 /*********************************************************************
-    Name: conv_encode
+    Name: rate_match_turbo
 
-    Description: Convolutionally encodes a bit array using the
-                 provided parameters
+    Description: Rate matches turbo encoded data
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1
 *********************************************************************/
-void conv_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                 uint8             *c_bits,
-                 uint32             N_c_bits,
-                 uint32             constraint_len,
-                 uint32             rate,
-                 uint32            *g,
-                 bool               tail_bit,
-                 uint8             *d_bits,
-                 uint32            *N_d_bits)
+void rate_match_turbo(LIBLTE_PHY_STRUCT         *phy_struct,
+                      uint8                     *d_bits,
+                      uint32                     N_d_bits,
+                      uint32                     N_codeblocks,
+                      uint32                     tx_mode,
+                      uint32                     N_soft,
+                      uint32                     M_dl_harq,
+                      LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type,
+                      uint32                     rv_idx,
+                      uint32                     N_e_bits,
+                      uint8                     *e_bits)
 {
-    uint32 i;
-    uint32 j;
-    uint32 k;
-    uint8  s_reg[constraint_len];
-    uint8  g_array[3][constraint_len];
+    uint32 N_branch_bits = N_d_bits/3;
+    uint32 N_fill_bits   = 0;
+    uint32 x;
 
-    // Initialize the shift register
-    if(tail_bit)
+    // Filler bits are marked as NULL at the start of d0
+    while(N_fill_bits  < N_branch_bits &&
+          TX_NULL_BIT == d_bits[N_fill_bits])
     {
-        for(i=0; i<constraint_len; i++)
+        N_fill_bits++;
+    }
+    for(x=0; x<3; x++)
+    {
+        pack_bits(&d_bits[x*N_branch_bits], N_branch_bits, phy_struct->rmt_d_words[x]);
+    }
+    rate_match_turbo_packed(phy_struct,
+                            phy_struct->rmt_d_words[0],
+                            97,
+                            N_d_bits,
+                            N_fill_bits,
+                            N_codeblocks,
+                            tx_mode,
+                            N_soft,
+                            M_dl_harq,
+                            chan_type,
+                            rv_idx,
+                            N_e_bits,
+                            phy_struct->rmt_e_words,
+                            0);
+    unpack_bits(phy_struct->rmt_e_words, N_e_bits, e_bits);
+}
+
+/*********************************************************************
+    Name: rate_match_turbo_packed
+
+    Description: Rate matches packed turbo encoded data, writing the
+                 e bits at e_offset in the output so that code block
+                 concatenation happens in place
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 sections 5.1.4.1 and
+                        5.1.5
+*********************************************************************/
+void rate_match_turbo_packed(LIBLTE_PHY_STRUCT         *phy_struct,
+                             uint64                    *d_words,
+                             uint32                     N_d_words_max,
+                             uint32                     N_d_bits,
+                             uint32                     N_fill_bits,
+                             uint32                     N_codeblocks,
+                             uint32                     tx_mode,
+                             uint32                     N_soft,
+                             uint32                     M_dl_harq,
+                             LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type,
+                             uint32                     rv_idx,
+                             uint32                     N_e_bits,
+                             uint64                    *e_words,
+                             uint32                     e_offset)
+{
+    LIBLTE_PHY_RM_CACHE_STRUCT *table;
+    uint64                      e_word        = 0;
+    uint32                      N_stream_bits = N_d_words_max*64;
+    uint32                      N_e_word_bits = 0;
+    uint32                      d_idx;
+    uint32                      x;
+    uint32                      j;
+    uint32                      k;
+
+    table = rate_match_turbo_table(phy_struct,
+                                   N_d_bits/3,
+                                   N_fill_bits,
+                                   N_codeblocks,
+                                   tx_mode,
+                                   N_soft,
+                                   M_dl_harq,
+                                   chan_type);
+
+    // Gather the e bits from the circular buffer, d_words holds the
+    // three streams one after the other
+    j = table->rv_start[rv_idx];
+    for(k=0; k<N_e_bits; k++)
+    {
+        d_idx  = table->idx[j]/3;
+        x      = table->idx[j] - d_idx*3;
+        d_idx += x*N_stream_bits;
+        e_word = (e_word << 1) | ((d_words[d_idx/64] >> (63 - (d_idx%64))) & 1);
+        N_e_word_bits++;
+        if(64 == N_e_word_bits)
         {
-            s_reg[i] = c_bits[N_c_bits-i-1];
+            copy_bits(&e_word, 0, 64, e_words, e_offset);
+            e_offset      += 64;
+            N_e_word_bits  = 0;
         }
-    }else{
-        for(i=0; i<constraint_len; i++)
+        j++;
+        if(j == table->N_idx)
         {
-            s_reg[i] = 0;
+            j = 0;
         }
     }
-
-    // Convert g from octal to binary array
-    for(i=0; i<rate; i++)
+    if(0 != N_e_word_bits)
     {
-        for(j=0; j<constraint_len; j++)
-        {
-            g_array[i][j] = (g[i] >> (constraint_len-j-1)) & 1;
-        }
+        e_word <<= 64 - N_e_word_bits;
+        copy_bits(&e_word, 0, N_e_word_bits, e_words, e_offset);
     }
+}
 
-    // Convolutionally encode input
-    for(i=0; i<N_c_bits; i++)
-    {
-        // Add next bit to shift register
-        for(j=constraint_len-1; j>0; j--)
-        {
-            s_reg[j] = s_reg[j-1];
-        }
-        s_reg[0] = c_bits[i];
+/*********************************************************************
+    Name: rate_unmatch_turbo
 
-        // Determine the output bits
-        for(j=0; j<rate; j++)
-        {
-            d_bits[i*rate + j] = 0;
+    Description: Rate unmatches turbo encoded data, soft combining
+                 repeated bits
 
-            for(k=0; k<constraint_len; k++)
-            {
-                d_bits[i*rate + j] += s_reg[k]*g_array[j][k];
-            }
-            d_bits[i*rate + j] %= 2;
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1
+*********************************************************************/
+void rate_unmatch_turbo(LIBLTE_PHY_STRUCT         *phy_struct,
+                        float                     *e_bits,
+                        uint32                     N_e_bits,
+                        uint32                     N_c_bits,
+                        uint32                     N_fill_bits,
+                        uint32                     N_codeblocks,
+                        uint32                     tx_mode,
+                        uint32                     N_soft,
+                        uint32                     M_dl_harq,
+                        LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type,
+                        uint32                     rv_idx,
+                        float                     *d_bits,
+                        uint32                    *N_d_bits)
+{
+    LIBLTE_PHY_RM_CACHE_STRUCT *table;
+    uint32                      N_branch_bits = N_c_bits + 4;
+    uint32                      j;
+    uint32                      k;
+
+    table = rate_match_turbo_table(phy_struct,
+                                   N_branch_bits,
+                                   N_fill_bits,
+                                   N_codeblocks,
+                                   tx_mode,
+                                   N_soft,
+                                   M_dl_harq,
+                                   chan_type);
+
+    // Scatter the e bits back into the circular buffer, positions that
+    // were not transmitted stay at zero
+    memset(d_bits, 0, sizeof(float)*N_branch_bits*3);
+    j = table->rv_start[rv_idx];
+    for(k=0; k<N_e_bits; k++)
+    {
+        d_bits[table->idx[j]] += e_bits[k];
+        j++;
+        if(j == table->N_idx)
+        {
+            j = 0;
         }
     }
-
-    *N_d_bits = N_c_bits*rate;
+    *N_d_bits = N_branch_bits*3;
 }
 
 /*********************************************************************
-    Name: conv_encode_soft
+    Name: rate_match_conv
 
-    Description: Convolutionally encodes a soft bit array using the
-                 provided parameters
+    Description: Rate matches convolutionally encoded data
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.2
 *********************************************************************/
-void conv_encode_soft(LIBLTE_PHY_STRUCT *phy_struct,
-                      int8              *c_bits,
-                      uint32             N_c_bits,
-                      uint32             constraint_len,
-                      uint32             rate,
-                      uint32            *g,
-                      bool               tail_bit,
-                      int8              *d_bits,
-                      uint32            *N_d_bits)
+void rate_match_conv(LIBLTE_PHY_STRUCT *phy_struct,
+                     uint8             *d_bits,
+                     uint32             N_d_bits,
+                     uint32             N_e_bits,
+                     uint8             *e_bits)
 {
+    uint32 C_cc_sb = 32; // Step 1: Assign C_cc_sb to 32
+    uint32 R_cc_sb;
+    uint32 w_idx = 0;
+    uint32 d_idx;
+    uint32 N_dummy;
+    uint32 idx;
+    uint32 K_pi;
+    uint32 K_w;
     uint32 i;
     uint32 j;
     uint32 k;
-    uint32 tmp_sum;
-    uint32 tmp_sign;
-    int32  tmp_mag;
-    int8   s_reg[constraint_len];
-    uint8  g_array[3][constraint_len];
+    uint32 x;
 
-    // Initialize the shift register
-    if(tail_bit)
+    // Sub-block interleaving
+    // Step 2: Determine the number of rows
+    R_cc_sb = 0;
+    while((N_d_bits/3) > (C_cc_sb*R_cc_sb))
     {
-        for(i=0; i<constraint_len; i++)
+        R_cc_sb++;
+    }
+
+    // Steps 3, 4, and 5
+    for(x=0; x<3; x++)
+    {
+        // Step 3: Pack data into matrix and pad with dummy
+        if((N_d_bits/3) < (C_cc_sb*R_cc_sb))
         {
-            s_reg[i] = c_bits[N_c_bits-i-1];
+            N_dummy = C_cc_sb*R_cc_sb - (N_d_bits/3);
+        }else{
+            N_dummy = 0;
         }
-    }else{
-        for(i=0; i<constraint_len; i++)
+        for(i=0; i<N_dummy; i++)
         {
-            s_reg[i] = 127;
+            phy_struct->rmc_tmp[i] = TX_NULL_BIT;
         }
-    }
-
-    // Convert g from octal to binary array
-    for(i=0; i<rate; i++)
-    {
-        for(j=0; j<constraint_len; j++)
+        d_idx = 0;
+        for(i=N_dummy; i<C_cc_sb*R_cc_sb; i++)
         {
-            g_array[i][j] = (g[i] >> (constraint_len-j-1)) & 1;
+            phy_struct->rmc_tmp[i] = d_bits[d_idx*3+x];
+            d_idx++;
         }
-    }
-
-    // Convolutionally encode input
-    for(i=0; i<N_c_bits; i++)
-    {
-        // Add next bit to shift register
-        for(j=constraint_len-1; j>0; j--)
+        idx = 0;
+        for(i=0; i<R_cc_sb; i++)
         {
-            s_reg[j] = s_reg[j-1];
+            for(j=0; j<C_cc_sb; j++)
+            {
+                phy_struct->rmc_sb_mat[i][j] = phy_struct->rmc_tmp[idx++];
+            }
         }
-        s_reg[0] = c_bits[i];
 
-        // Determine the output bits
-        for(j=0; j<rate; j++)
+        // Step 4: Inter-column permutation
+        for(i=0; i<R_cc_sb; i++)
         {
-            tmp_sum  = 0;
-            tmp_mag  = 0;
-            tmp_sign = 0;
-            for(k=0; k<constraint_len; k++)
+            for(j=0; j<C_cc_sb; j++)
             {
-                if(1 == g_array[j][k])
-                {
-                    if(s_reg[k] >= 0)
-                    {
-                        tmp_mag += s_reg[k];
-                    }else{
-                        tmp_mag  += -s_reg[k];
-                        tmp_sign += 1;
-                    }
-                    tmp_sum++;
-                }
+                phy_struct->rmc_sb_perm_mat[i][j] = phy_struct->rmc_sb_mat[i][IC_PERM_CC[j]];
             }
-            d_bits[i*rate + j] = tmp_mag >> (tmp_sum-1);
-            if(1 == (tmp_sign % 2))
+        }
+
+        // Step 5: Read out the bits
+        for(j=0; j<C_cc_sb; j++)
+        {
+            for(i=0; i<R_cc_sb; i++)
             {
-                d_bits[i*rate + j] = -d_bits[i*rate + j];
+                phy_struct->rmc_w[w_idx++] = phy_struct->rmc_sb_perm_mat[i][j];
             }
         }
     }
+    K_pi = R_cc_sb*C_cc_sb;
 
-    *N_d_bits = N_c_bits*rate;
+    // Bit collection, selection, and transmission
+    // Create circular buffer
+    K_w = 3*K_pi;
+    k   = 0;
+    j   = 0;
+    while(k < N_e_bits)
+    {
+        if(phy_struct->rmc_w[j%K_w] != TX_NULL_BIT)
+        {
+            e_bits[k++] = phy_struct->rmc_w[j%K_w];
+        }
+        j++;
+    }
 }
 
 /*********************************************************************
-    Name: viterbi_decode
+    Name: rate_unmatch_conv
 
-    Description: Viterbi decodes a convolutionally coded input bit
-                 array using the provided parameters
+    Description: Rate unmatches convolutionally encoded data
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.2
 *********************************************************************/
-void viterbi_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                    float             *d_bits,
-                    uint32             N_d_bits,
-                    uint32             constraint_len,
-                    uint32             rate,
-                    uint32            *g,
-                    uint8             *c_bits,
-                    uint32            *N_c_bits)
+void rate_unmatch_conv(LIBLTE_PHY_STRUCT *phy_struct,
+                       float             *e_bits,
+                       uint32             N_e_bits,
+                       uint32             N_c_bits,
+                       float             *d_bits,
+                       uint32            *N_d_bits)
 {
-    float  init_min;
-    float  tmp1;
-    float  tmp2;
-    int32  i;
+    uint32 C_cc_sb = 32; // Step 1: Assign C_cc_sb to 32
+    uint32 R_cc_sb;
+    uint32 w_idx = 0;
+    uint32 d_idx;
+    uint32 N_dummy;
+    uint32 idx;
+    uint32 K_pi;
+    uint32 K_w;
+    uint32 i;
     uint32 j;
     uint32 k;
-    uint32 o;
-    uint32 N_states = 1<<(constraint_len-1);
-    uint32 idx;
-    uint32 tb_state_len;
-    uint8  in_path;
-    uint8  prev_state;
-    uint8  in_bit;
-    uint8  prev_state_0;
-    uint8  prev_state_1;
-    uint8  s_reg[constraint_len];
-    uint8  g_array[3][constraint_len];
+    uint32 x;
 
-    // Convert g to binary
-    for(i=0; i<(int32)rate; i++)
-    {
-        for(j=0; j<constraint_len; j++)
-        {
-            g_array[i][j] = (g[i] >> (constraint_len-j-1)) & 1;
-        }
+    // In order to undo bit collection, selection, and transmission
+    // a dummy block must be sub-block interleaved to determine
+    // where NULL bits are to be inserted
+    // Sub-block interleaving
+    // Step 2: Determine the number of rows
+    R_cc_sb = 0;
+    while(N_c_bits > (C_cc_sb*R_cc_sb))
+    {
+        R_cc_sb++;
     }
 
-    // Precalculate state transition outputs
-    for(i=0; i<(int32)N_states; i++)
+    // Steps 3, 4, and 5
+    for(x=0; x<3; x++)
     {
-        // Determine the input path
-        if(i < (N_states/2))
+        // Step 3: Pack data into matrix and pad with dummy
+        if(N_c_bits < (C_cc_sb*R_cc_sb))
         {
-            in_path = 0;
+            N_dummy = C_cc_sb*R_cc_sb - N_c_bits;
         }else{
-            in_path = 1;
+            N_dummy = 0;
         }
-
-        // Determine the outputs based on the previous state and input path
-        for(j=0; j<2; j++)
+        for(i=0; i<N_dummy; i++)
         {
-            prev_state = ((i << 1) + j) % N_states;
-            for(k=0; k<constraint_len; k++)
+            phy_struct->ruc_tmp[i] = RX_NULL_BIT;
+        }
+        for(i=N_dummy; i<C_cc_sb*R_cc_sb; i++)
+        {
+            phy_struct->ruc_tmp[i] = 0;
+        }
+        idx = 0;
+        for(i=0; i<R_cc_sb; i++)
+        {
+            for(j=0; j<C_cc_sb; j++)
             {
-                s_reg[k] = (prev_state >> (constraint_len-k-1)) & 1;
+                phy_struct->ruc_sb_mat[i][j] = phy_struct->ruc_tmp[idx++];
             }
-            s_reg[0] = in_path;
-            for(k=0; k<rate; k++)
+        }
+
+        // Step 4: Inter-column permutation
+        for(i=0; i<R_cc_sb; i++)
+        {
+            for(j=0; j<C_cc_sb; j++)
             {
-                phy_struct->vd_st_output[i][j][k] = 0;
-                for(o=0; o<constraint_len; o++)
-                {
-                    phy_struct->vd_st_output[i][j][k] += s_reg[o]*g_array[k][o];
-                }
-                phy_struct->vd_st_output[i][j][k] %= 2;
+                phy_struct->ruc_sb_perm_mat[i][j] = phy_struct->ruc_sb_mat[i][IC_PERM_CC[j]];
             }
         }
-    }
 
-    // Calculate branch and path metrics
-    for(i=0; i<(int32)N_states; i++)
-    {
-        for(j=0; j<(N_d_bits/rate)+10; j++)
+        // Step 5: Read out the bits
+        for(j=0; j<C_cc_sb; j++)
         {
-            phy_struct->vd_path_metric[i][j] = 0;
+            for(i=0; i<R_cc_sb; i++)
+            {
+                phy_struct->ruc_w_dum[w_idx] = phy_struct->ruc_sb_perm_mat[i][j];
+                phy_struct->ruc_w[w_idx]     = RX_NULL_BIT;
+                w_idx++;
+            }
         }
     }
-    for(i=0; i<(int32)(N_d_bits/rate); i++)
+
+    // Undo bit collection, selection, and transmission by
+    // recreating the circular buffer
+    K_pi = R_cc_sb*C_cc_sb;
+    K_w  = 3*K_pi;
+    k    = 0;
+    j    = 0;
+    while(k < N_e_bits)
     {
-        for(j=0; j<N_states; j++)
+        if(phy_struct->ruc_w_dum[j%K_w] != RX_NULL_BIT)
         {
-            phy_struct->vd_br_metric[j][0] = 0;
-            phy_struct->vd_br_metric[j][1] = 0;
-            phy_struct->vd_p_metric[j][0]  = 0;
-            phy_struct->vd_p_metric[j][1]  = 0;
-            phy_struct->vd_w_metric[j][0]  = 0;
-            phy_struct->vd_w_metric[j][1]  = 0;
-
-            // Calculate the accumulated branch metrics for each state
-            for(k=0; k<2; k++)
-            {
-                prev_state                    = ((j<<1)+k) % N_states;
-                phy_struct->vd_p_metric[j][k] = phy_struct->vd_path_metric[prev_state][i];
-                for(o=0; o<rate; o++)
-                {
-                    if(d_bits[i*rate + o] >= 0)
-                    {
-                        in_bit = 0;
-                    }else{
-                        in_bit = 1;
-                    }
-                    phy_struct->vd_br_metric[j][k] += (phy_struct->vd_st_output[j][k][o]+in_bit)%2;
-                    phy_struct->vd_w_metric[j][k]  += fabs(d_bits[i*rate + o]);
-                }
-            }
-
-            // Keep the smallest branch metric as the path metric, weight the branch metric
-            tmp1 = phy_struct->vd_br_metric[j][0] + phy_struct->vd_p_metric[j][0];
-            tmp2 = phy_struct->vd_br_metric[j][1] + phy_struct->vd_p_metric[j][1];
-            if(tmp1 > tmp2)
+            // Soft combine the inputs
+            if(phy_struct->ruc_w[j%K_w] == RX_NULL_BIT)
             {
-                phy_struct->vd_path_metric[j][i+1] = phy_struct->vd_p_metric[j][1] + phy_struct->vd_w_metric[j][1]*phy_struct->vd_br_metric[j][1];
-            }else{
-                phy_struct->vd_path_metric[j][i+1] = phy_struct->vd_p_metric[j][0] + phy_struct->vd_w_metric[j][0]*phy_struct->vd_br_metric[j][0];
+                phy_struct->ruc_w[j%K_w] = e_bits[k];
+            }else if(e_bits[k] != RX_NULL_BIT){
+                phy_struct->ruc_w[j%K_w] += e_bits[k];
             }
+            k++;
         }
+        j++;
     }
 
-    // Find the minimum metric for the last iteration
-    init_min                     = 1000000;
-    idx                          = 0;
-    phy_struct->vd_tb_state[idx] = 1000000;
-    for(i=0; i<(int32)N_states; i++)
+    // Recreate the sub-block interleaver output
+    for(i=0; i<K_pi; i++)
     {
-        if(phy_struct->vd_path_metric[i][(N_d_bits/rate)] < init_min)
-        {
-            init_min                       = phy_struct->vd_path_metric[i][(N_d_bits/rate)];
-            phy_struct->vd_tb_state[idx++] = i;
-        }
+        phy_struct->ruc_v[0][i] = phy_struct->ruc_w[i];
+        phy_struct->ruc_v[1][i] = phy_struct->ruc_w[i+K_pi];
+        phy_struct->ruc_v[2][i] = phy_struct->ruc_w[i+2*K_pi];
     }
 
-    // Traceback to find the minimum path metrics at each iteration
-    for(i=(N_d_bits/rate)-1; i>=0; i--)
+    // Sub-block deinterleaving
+    // Steps 5, 4, and 3
+    for(x=0; x<3; x++)
     {
-        prev_state_0 = ((((uint8)phy_struct->vd_tb_state[idx-1])<<1) + 0) % N_states;
-        prev_state_1 = ((((uint8)phy_struct->vd_tb_state[idx-1])<<1) + 1) % N_states;
+        // Step 5: Load the permuted matrix
+        idx = 0;
+        for(j=0; j<C_cc_sb; j++)
+        {
+            for(i=0; i<R_cc_sb; i++)
+            {
+                phy_struct->ruc_sb_perm_mat[i][j] = phy_struct->ruc_v[x][idx++];
+            }
+        }
 
-        // Keep the smallest state
-        if(phy_struct->vd_path_metric[prev_state_0][i] > phy_struct->vd_path_metric[prev_state_1][i])
+        // Step 4: Undo permutation
+        for(i=0; i<R_cc_sb; i++)
         {
-            phy_struct->vd_tb_state[idx++] = prev_state_1;
-        }else{
-            phy_struct->vd_tb_state[idx++] = prev_state_0;
+            for(j=0; j<C_cc_sb; j++)
+            {
+                phy_struct->ruc_sb_mat[i][IC_PERM_CC[j]] = phy_struct->ruc_sb_perm_mat[i][j];
+            }
         }
-    }
-    tb_state_len = idx;
 
-    // Read through the traceback to determine the input bits
-    idx = 0;
-    for(i=tb_state_len-2; i>=0; i--)
-    {
-        // If transition has resulted in a lower valued state,
-        // the output is 0 and vice-versa
-        if(phy_struct->vd_tb_state[i] < phy_struct->vd_tb_state[i+1])
+        // Step 3: Unpack the data and remove dummy
+        if(N_c_bits < (C_cc_sb*R_cc_sb))
         {
-            c_bits[idx++] = 0;
-        }else if(phy_struct->vd_tb_state[i] > phy_struct->vd_tb_state[i+1]){
-            c_bits[idx++] = 1;
+            N_dummy = C_cc_sb*R_cc_sb - N_c_bits;
         }else{
-            // Check to see if the transition has resulted in the same state
-            // In this case, if state is 0 then output is 0
-            if(phy_struct->vd_tb_state[i] == 0)
+            N_dummy = 0;
+        }
+        idx = 0;
+        for(i=0; i<R_cc_sb; i++)
+        {
+            for(j=0; j<C_cc_sb; j++)
             {
-                c_bits[idx++] = 0;
-            }else{
-                c_bits[idx++] = 1;
+                phy_struct->ruc_tmp[idx++] = phy_struct->ruc_sb_mat[i][j];
             }
         }
+        d_idx = 0;
+        for(i=N_dummy; i<C_cc_sb*R_cc_sb; i++)
+        {
+            d_bits[d_idx*3+x] = phy_struct->ruc_tmp[i];
+            d_idx++;
+        }
     }
-    *N_c_bits = idx;
+    *N_d_bits = d_idx*3;
 }
 
 /*********************************************************************
-    Name: viterbi_decode_siso
+    Name: code_block_concatenation
 
-    Description: Soft input soft output viterbi decodes a
-                 convolutionally coded input bit array using the
-                 provided parameters
+    Description: Performs code block concatenation for turbo coded
+                 channels
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.5
 *********************************************************************/
-void viterbi_decode_siso(LIBLTE_PHY_STRUCT *phy_struct,
-                         int8              *d_bits,
-                         uint32             N_d_bits,
-                         uint32             constraint_len,
-                         uint32             rate,
-                         uint32            *g,
-                         int8              *c_bits,
-                         uint32            *N_c_bits)
-{
-    float  init_min;
-    float  tmp1;
-    float  tmp2;
-    float  max_weight = 0;
-    int32  i;
-    uint32 j;
-    uint32 k;
-    uint32 o;
-    uint32 N_states = 1<<(constraint_len-1);
-    uint32 idx;
-    uint32 tb_state_len;
-    uint8  in_path;
-    uint8  prev_state;
-    uint8  in_bit;
-    uint8  prev_state_0;
-    uint8  prev_state_1;
-    uint8  s_reg[constraint_len];
-    uint8  g_array[3][constraint_len];
+void code_block_concatenation(uint8  *e_bits,
+                              uint32 *N_e_bits,
+                              uint32  N_e_bits_max,
+                              uint32  N_codeblocks,
+                              uint8  *f_bits,
+                              uint32 *N_f_bits)
+{
+    uint32 j = 0;
+    uint32 k = 0;
+    uint32 r = 0;
 
-    // Convert g to binary
-    for(i=0; i<(int32)rate; i++)
+    // Concatenate code blocks
+    while(r < N_codeblocks)
     {
-        for(j=0; j<constraint_len; j++)
+        j = 0;
+        while(j < N_e_bits[r])
         {
-            g_array[i][j] = (g[i] >> (constraint_len-j-1)) & 1;
+            f_bits[k++] = e_bits[r*N_e_bits_max+j];
+            j++;
         }
+        r++;
     }
+    *N_f_bits = k;
+}
+
+/*********************************************************************
+    Name: code_block_deconcatenation
+
+    Description: Performs code block deconcatenation for turbo coded
+                 channels
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.5
+*********************************************************************/
+void code_block_deconcatenation(float   *f_bits,
+                                uint32   N_f_bits,
+                                uint32   N_codeblocks,
+                                uint32   N_l,
+                                uint32   Q_m,
+                                float  **e_bits,
+                                uint32  *N_e_bits)
+{
+    uint32 G_prime = N_f_bits/(N_l*Q_m);
+    uint32 lambda  = G_prime % N_codeblocks;
+    uint32 k       = 0;
+    uint32 r;
 
-    // Precalculate state transition outputs
-    for(i=0; i<(int32)N_states; i++)
+    // Determine E for each code block, 3GPP TS 36.212 v10.1.0 section
+    // 5.1.4.1.2, the e_bits of each code block are left in place
+    for(r=0; r<N_codeblocks; r++)
     {
-        // Determine the input path
-        if(i < (N_states/2))
+        if(r <= (N_codeblocks - lambda - 1))
         {
-            in_path = 0;
+            N_e_bits[r] = N_l*Q_m*(G_prime/N_codeblocks);
         }else{
-            in_path = 1;
+            N_e_bits[r] = N_l*Q_m*(uint32)ceilf((float)G_prime/(float)N_codeblocks);
         }
+        e_bits[r]  = &f_bits[k];
+        k         += N_e_bits[r];
+    }
+}
 
-        // Determine the outputs based on the previous state and input path
-        for(j=0; j<2; j++)
+/*********************************************************************
+    Name: code_block_decode
+
+    Description: Rate unmatches and turbo decodes a single code block
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 sections 5.1.3.2 and
+                        5.1.4.1
+*********************************************************************/
+void code_block_decode(LIBLTE_PHY_STRUCT        *phy_struct,
+                       LIBLTE_PHY_CB_JOB_STRUCT *job)
+{
+    int32  sum;
+    uint32 N_d_bits;
+    uint32 i;
+
+    // Determine d_bits
+    rate_unmatch_turbo(phy_struct,
+                       job->e_bits,
+                       job->N_e_bits,
+                       *job->N_c_bits,
+                       job->N_fill_bits,
+                       job->N_codeblocks,
+                       job->tx_mode,
+                       job->N_soft,
+                       job->M_dl_harq,
+                       job->chan_type,
+                       job->rv_idx,
+                       phy_struct->cbd_rx_d_bits,
+                       &N_d_bits);
+
+    // Combine with the earlier transmissions of this code block
+    if(NULL != job->harq_bits)
+    {
+        for(i=0; i<N_d_bits; i++)
         {
-            prev_state = ((i << 1) + j) % N_states;
-            for(k=0; k<constraint_len; k++)
-            {
-                s_reg[k] = (prev_state >> (constraint_len-k-1)) & 1;
-            }
-            s_reg[0] = in_path;
-            for(k=0; k<rate; k++)
+            sum = job->harq_bits[i] + (int32)lrintf(phy_struct->cbd_rx_d_bits[i]);
+            if(sum > 32767)
             {
-                phy_struct->vd_st_output[i][j][k] = 0;
-                for(o=0; o<constraint_len; o++)
-                {
-                    phy_struct->vd_st_output[i][j][k] += s_reg[o]*g_array[k][o];
-                }
-                phy_struct->vd_st_output[i][j][k] %= 2;
+                sum = 32767;
+            }else if(sum < -32767){
+                sum = -32767;
             }
+            job->harq_bits[i]            = (int16)sum;
+            phy_struct->cbd_rx_d_bits[i] = (float)sum;
         }
     }
 
-    // Calculate branch and path metrics
-    for(i=0; i<(int32)N_states; i++)
+    // Determine c_bits
+    turbo_decode(phy_struct,
+                 phy_struct->cbd_rx_d_bits,
+                 N_d_bits,
+                 job->N_fill_bits,
+                 job->crc,
+                 job->c_bits,
+                 job->N_c_bits);
+}
+
+/*********************************************************************
+    Name: code_block_decode_all
+
+    Description: Decodes the first N_codeblocks code block jobs of a
+                 workspace, on the code block threads when they exist
+
+    Document Reference: N/A
+*********************************************************************/
+void code_block_decode_all(LIBLTE_PHY_STRUCT *phy_struct,
+                           uint32             N_codeblocks)
+{
+    LIBLTE_PHY_CB_POOL_STRUCT *pool = phy_struct->cb_pool;
+    uint32                     cb;
+
+    if(NULL == pool ||
+       1    == N_codeblocks)
     {
-        for(j=0; j<(N_d_bits/rate)+10; j++)
+        for(cb=0; cb<N_codeblocks; cb++)
         {
-            phy_struct->vd_path_metric[i][j] = 0;
-            phy_struct->vd_w_metric[i][j]    = 0;
+            code_block_decode(phy_struct, &phy_struct->cb_job[cb]);
         }
-    }
-    for(i=0; i<(int32)(N_d_bits/rate); i++)
-    {
-        for(j=0; j<N_states; j++)
-        {
-            phy_struct->vd_br_metric[j][0] = 0;
-            phy_struct->vd_br_metric[j][1] = 0;
-            phy_struct->vd_p_metric[j][0]  = 0;
-            phy_struct->vd_p_metric[j][1]  = 0;
-            phy_struct->vd_br_weight[j][0] = 0;
-            phy_struct->vd_br_weight[j][1] = 0;
-
-            // Calculate the accumulated branch metrics for each state
-            for(k=0; k<2; k++)
-            {
-                prev_state                    = ((j<<1)+k) % N_states;
-                phy_struct->vd_p_metric[j][k] = phy_struct->vd_path_metric[prev_state][i];
-                for(o=0; o<rate; o++)
-                {
-                    if(d_bits[i*rate + o] >= 0)
-                    {
-                        in_bit = 0;
-                    }else{
-                        in_bit = 1;
-                    }
-                    if(phy_struct->vd_st_output[j][k][o] == in_bit)
-                    {
-                        phy_struct->vd_br_metric[j][k] += -1;
-                    }else{
-                        phy_struct->vd_br_metric[j][k] += 1;
-                    }
-                    phy_struct->vd_br_weight[j][k] += fabs(d_bits[i*rate + o]);
-                }
-            }
+    }else{
+        // Publish the jobs, decode alongside the workers, and wait for
+        // the last code block to finish
+        pthread_mutex_lock(&pool->mutex);
+        pool->job      = phy_struct->cb_job;
+        pool->N_jobs   = N_codeblocks;
+        pool->next_job = 0;
+        pool->N_done   = 0;
+        pool->job_id++;
+        pthread_cond_broadcast(&pool->start_cond);
+        pthread_mutex_unlock(&pool->mutex);
 
-            // Keep the smallest branch metric as the path metric, weight the branch metric
-            tmp1 = phy_struct->vd_br_metric[j][0] + phy_struct->vd_p_metric[j][0];
-            tmp2 = phy_struct->vd_br_metric[j][1] + phy_struct->vd_p_metric[j][1];
-            if(tmp1 > tmp2)
-            {
-                phy_struct->vd_path_metric[j][i+1] = phy_struct->vd_p_metric[j][1] + phy_struct->vd_br_weight[j][1]*phy_struct->vd_br_metric[j][1];
-                phy_struct->vd_w_metric[j][i+1]    = phy_struct->vd_br_weight[j][1];
-            }else{
-                phy_struct->vd_path_metric[j][i+1] = phy_struct->vd_p_metric[j][0] + phy_struct->vd_br_weight[j][0]*phy_struct->vd_br_metric[j][0];
-                phy_struct->vd_w_metric[j][i+1]    = phy_struct->vd_br_weight[j][0];
-            }
-        }
-    }
+        code_block_decode_run(pool, phy_struct);
 
-    // Find the minimum metric for the last iteration
-    init_min                     = 1000000;
-    idx                          = 0;
-    phy_struct->vd_tb_state[idx] = 1000000;
-    for(i=0; i<(int32)N_states; i++)
-    {
-        if(phy_struct->vd_path_metric[i][(N_d_bits/rate)] < init_min)
+        pthread_mutex_lock(&pool->mutex);
+        while(pool->N_done != pool->N_jobs)
         {
-            init_min                      = phy_struct->vd_path_metric[i][(N_d_bits/rate)];
-            phy_struct->vd_tb_state[idx]  = i;
-            phy_struct->vd_tb_weight[idx] = phy_struct->vd_w_metric[i][(N_d_bits/rate)];
-            max_weight                    = phy_struct->vd_tb_weight[idx];
-            idx++;
+            pthread_cond_wait(&pool->done_cond, &pool->mutex);
         }
+        pthread_mutex_unlock(&pool->mutex);
     }
+}
+void code_block_decode_run(LIBLTE_PHY_CB_POOL_STRUCT *pool,
+                           LIBLTE_PHY_STRUCT         *ws)
+{
+    LIBLTE_PHY_CB_JOB_STRUCT *job;
 
-    // Traceback to find the minimum path metrics at each iteration
-    for(i=(N_d_bits/rate)-1; i>=0; i--)
+    pthread_mutex_lock(&pool->mutex);
+    while(pool->next_job < pool->N_jobs)
     {
-        prev_state_0 = ((((uint8)phy_struct->vd_tb_state[idx-1])<<1) + 0) % N_states;
-        prev_state_1 = ((((uint8)phy_struct->vd_tb_state[idx-1])<<1) + 1) % N_states;
+        job = &pool->job[pool->next_job++];
+        pthread_mutex_unlock(&pool->mutex);
 
-        // Keep the smallest state
-        if(phy_struct->vd_path_metric[prev_state_0][i] > phy_struct->vd_path_metric[prev_state_1][i])
-        {
-            phy_struct->vd_tb_state[idx]  = prev_state_1;
-            phy_struct->vd_tb_weight[idx] = phy_struct->vd_w_metric[prev_state_1][i];
-        }else{
-            phy_struct->vd_tb_state[idx]  = prev_state_0;
-            phy_struct->vd_tb_weight[idx] = phy_struct->vd_w_metric[prev_state_0][i];
-        }
-        if(phy_struct->vd_tb_weight[idx] > max_weight)
+        code_block_decode(ws, job);
+
+        pthread_mutex_lock(&pool->mutex);
+        pool->N_done++;
+        if(pool->N_done == pool->N_jobs)
         {
-            max_weight = phy_struct->vd_tb_weight[idx];
+            pthread_cond_signal(&pool->done_cond);
         }
-        idx++;
     }
-    tb_state_len = idx;
+    pthread_mutex_unlock(&pool->mutex);
+}
+void* code_block_decode_thread(void *inputs)
+{
+    LIBLTE_PHY_CB_WORKER_STRUCT *worker = (LIBLTE_PHY_CB_WORKER_STRUCT *)inputs;
+    LIBLTE_PHY_CB_POOL_STRUCT   *pool   = worker->pool;
+    uint32                       job_id = 0;
 
-    // Read through the traceback to determine the input bits
-    idx = 0;
-    for(i=tb_state_len-2; i>=0; i--)
+    pthread_mutex_lock(&pool->mutex);
+    while(pool->run)
     {
-        // If transition has resulted in a lower valued state,
-        // the output is 0 and vice-versa
-        if(phy_struct->vd_tb_state[i] < phy_struct->vd_tb_state[i+1])
+        if(job_id != pool->job_id)
         {
-            c_bits[idx++] = 127 * (phy_struct->vd_tb_weight[i]/max_weight);
-        }else if(phy_struct->vd_tb_state[i] > phy_struct->vd_tb_state[i+1]){
-            c_bits[idx++] = -127 * (phy_struct->vd_tb_weight[i]/max_weight);
+            job_id = pool->job_id;
+            pthread_mutex_unlock(&pool->mutex);
+            code_block_decode_run(pool, worker->ws);
+            pthread_mutex_lock(&pool->mutex);
         }else{
-            // Check to see if the transition has resulted in the same state
-            // In this case, if state is 0 then output is 0
-            if(phy_struct->vd_tb_state[i] == 0)
-            {
-                c_bits[idx++] = 127 * (phy_struct->vd_tb_weight[i]/max_weight);
-            }else{
-                c_bits[idx++] = -127 * (phy_struct->vd_tb_weight[i]/max_weight);
-            }
+            pthread_cond_wait(&pool->start_cond, &pool->mutex);
         }
     }
-    *N_c_bits = idx;
-}
-
-/*********************************************************************
-    Name: turbo_encode
-
-    Description: Turbo encodes a bit array using the LTE Parallel
-                 Concatenated Convolutional Code
+    pthread_mutex_unlock(&pool->mutex);
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
-
-    Notes: Currently not handling filler bits
-*********************************************************************/
-void turbo_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                  uint8             *c_bits,
-                  uint32             N_c_bits,
-                  uint32             N_fill_bits,
-                  uint8             *d_bits,
-                  uint32            *N_d_bits)
+    return(NULL);
+}
+void code_block_pool_cleanup(LIBLTE_PHY_STRUCT *phy_struct)
 {
-    uint32 i;
-    uint32 N_branch_bits = N_c_bits + 4;
-
-    // Construct z
-    turbo_constituent_encoder(c_bits,
-                              N_c_bits,
-                              phy_struct->te_z,
-                              phy_struct->te_fb1);
-
-    // Construct c_prime
-    turbo_internal_interleaver(c_bits,
-                               N_c_bits,
-                               phy_struct->te_c_prime);
+    LIBLTE_PHY_CB_POOL_STRUCT *pool = phy_struct->cb_pool;
+    uint32                     i;
 
-    // Construct z_prime
-    turbo_constituent_encoder(phy_struct->te_c_prime,
-                              N_c_bits,
-                              phy_struct->te_z_prime,
-                              phy_struct->te_x_prime);
-
-    // Construct d_bits
-    for(i=0; i<N_c_bits; i++)
+    if(NULL != pool)
     {
-        d_bits[i]                 = c_bits[i];
-        d_bits[N_branch_bits+i]   = phy_struct->te_z[i];
-        d_bits[2*N_branch_bits+i] = phy_struct->te_z_prime[i];
-    }
-    d_bits[N_c_bits]                   = phy_struct->te_fb1[N_c_bits-1];
-    d_bits[N_c_bits+1]                 = phy_struct->te_z[N_c_bits+1];
-    d_bits[N_c_bits+2]                 = phy_struct->te_x_prime[N_c_bits];
-    d_bits[N_c_bits+3]                 = phy_struct->te_z_prime[N_c_bits+1];
-    d_bits[N_branch_bits+N_c_bits]     = phy_struct->te_z[N_c_bits];
-    d_bits[N_branch_bits+N_c_bits+1]   = phy_struct->te_fb1[N_c_bits+1];
-    d_bits[N_branch_bits+N_c_bits+2]   = phy_struct->te_z_prime[N_c_bits];
-    d_bits[N_branch_bits+N_c_bits+3]   = phy_struct->te_x_prime[N_c_bits+2];
-    d_bits[2*N_branch_bits+N_c_bits]   = phy_struct->te_fb1[N_c_bits];
-    d_bits[2*N_branch_bits+N_c_bits+1] = phy_struct->te_z[N_c_bits+1];
-    d_bits[2*N_branch_bits+N_c_bits+2] = phy_struct->te_x_prime[N_c_bits+1];
-    d_bits[2*N_branch_bits+N_c_bits+3] = phy_struct->te_z_prime[N_c_bits+2];
-
-    *N_d_bits = N_branch_bits*3;
+        pthread_mutex_lock(&pool->mutex);
+        pool->run = false;
+        pthread_cond_broadcast(&pool->start_cond);
+        pthread_mutex_unlock(&pool->mutex);
+        for(i=0; i<pool->N_workers; i++)
+        {
+            pthread_join(pool->worker[i].thread, NULL);
+            liblte_phy_cleanup(pool->worker[i].ws);
+        }
+        pthread_mutex_destroy(&pool->mutex);
+        pthread_cond_destroy(&pool->start_cond);
+        pthread_cond_destroy(&pool->done_cond);
+        free(pool);
+        phy_struct->cb_pool = NULL;
+    }
 }
 
 /*********************************************************************
-    Name: turbo_decode
-
-    Description: Turbo decodes data according to the LTE Parallel
-                 Concatenated Convolutional Code.  The design of this
-                 decoder is based on the conversion of the constituent
-                 coder from:
-                                   -------->+---------------->+---- out
-                                   |        ^                 ^
-                           in_act  |   |-|  |   |-|      |-|  |
-                 in --->+------------->|D|----->|D|----->|D|---
-                        ^              |-|      |-|  |   |-|  |
-                        |                            v        |
-                        -----------------------------+<--------
-                 to:
-                           ------->+---------------->+------------- out
-                           |       ^                 ^
-                           |  |-|  |   |-|      |-|  |       
-                 in_act ------|D|----->|D|----->|D|---         
-                           |  |-|      |-|  |   |-|  |          
-                           |                v        v         
-                           ---------------->+------->+------------- in
-                 in_act can be determined using viterbi decoding and
-                 a second copy of in can be calculated using in_act
+    Name: ulsch_data_control_multiplexing
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+    Description: Multiplexes the control and data bits for Uplink
+                 Shared Channel
 
-    Notes: Currently not handling filler bits
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.7
 *********************************************************************/
-void turbo_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                  float             *d_bits,
-                  uint32             N_d_bits,
-                  uint32             N_fill_bits,
-                  uint8             *c_bits,
-                  uint32            *N_c_bits)
+void ulsch_data_control_multiplexing(uint8  *f_bits,
+                                     uint32  N_f_bits,
+                                     uint8  *cqi_bits,
+                                     uint32  N_cqi_bits,
+                                     uint32  N_l,
+                                     uint32  Q_m,
+                                     uint8  *g_bits,
+                                     uint32 *N_g_bits)
 {
-    float  tmp_s_bit;
-    float  max_value = 0;
-    uint32 i;
-    uint32 N_bits;
-    uint32 N_branch_bits = N_d_bits/3;
-    uint32 g_1           = 03; // Numbers are in octal
-    uint32 g_2[2]        = {015, 013}; // Numbers are in octal
+    uint32 i = 0;
+    uint32 j = 0;
+    uint32 k = 0;
+    uint32 n;
 
-    // Step 1: Calculate in_act_1 using d0 and d1
-    for(i=0; i<N_branch_bits-4; i++)
+    while(j < N_cqi_bits)
     {
-        if(fabs(d_bits[i*3+0]) > max_value)
-        {
-            max_value = fabs(d_bits[i*3+0]);
-        }
-        if(fabs(d_bits[i*3+1]) > max_value)
-        {
-            max_value = fabs(d_bits[i*3+1]);
-        }
-        if(fabs(d_bits[i*3+2]) > max_value)
+        for(n=0; n<N_l*Q_m; n++)
         {
-            max_value = fabs(d_bits[i*3+2]);
+            g_bits[k*N_l*Q_m + n] = cqi_bits[j+n];
         }
+        j += N_l*Q_m;
+        k++;
     }
-    for(i=0; i<N_branch_bits-4; i++)
+    while(i < N_f_bits)
     {
-        phy_struct->td_vitdec_in[i*2+0] = (int8)(d_bits[i*3+1]*127/max_value);
-        phy_struct->td_vitdec_in[i*2+1] = (int8)(d_bits[i*3+0]*127/max_value);
+        for(n=0; n<N_l*Q_m; n++)
+        {
+            g_bits[k*N_l*Q_m + n] = f_bits[i+n];
+        }
+        i += N_l*Q_m;
+        k++;
     }
+    *N_g_bits = k;
+}
 
-    viterbi_decode_siso(phy_struct,
-                        phy_struct->td_vitdec_in,
-                        (N_branch_bits-4)*2,
-                        4,
-                        2,
-                        g_2,
-                        phy_struct->td_in_act_1,
-                        &N_bits);
+/*********************************************************************
+    Name: ulsch_data_control_demultiplexing
 
-    // Step 2: Calculate fb_1 using in_act_1
-    phy_struct->td_fb_1[0] = 127;
-    conv_encode_soft(phy_struct,
-                     phy_struct->td_in_act_1,
-                     N_branch_bits-4,
-                     3,
-                     1,
-                     &g_1,
-                     false,
-                     &phy_struct->td_fb_1[1],
-                     &N_bits);
+    Description: Demultiplexes the control and data bits for Uplink
+                 Shared Channel
 
-    // Step 3: Calculate in_calc_1 using in_act_1 and fb_1
-    for(i=0; i<N_branch_bits-4; i++)
-    {
-        if(phy_struct->td_in_act_1[i] >= 0 &&
-           phy_struct->td_fb_1[i]     >= 0)
-        {
-            phy_struct->td_in_calc_1[i] = (phy_struct->td_in_act_1[i] +
-                                           phy_struct->td_fb_1[i]) >> 1;
-        }else if(phy_struct->td_in_act_1[i] < 0 &&
-                 phy_struct->td_fb_1[i]     < 0){
-            phy_struct->td_in_calc_1[i] = (-phy_struct->td_in_act_1[i] -
-                                           phy_struct->td_fb_1[i]) >> 1;
-        }else if(phy_struct->td_in_act_1[i] >= 0 &&
-                 phy_struct->td_fb_1[i]     <  0){
-            phy_struct->td_in_calc_1[i] = -((phy_struct->td_in_act_1[i] -
-                                             phy_struct->td_fb_1[i]) >> 1);
-        }else{
-            phy_struct->td_in_calc_1[i] = -((-phy_struct->td_in_act_1[i] +
-                                             phy_struct->td_fb_1[i]) >> 1);
-        }
-    }
-
-    // Step 4: Calculate in_int using d0
-    for(i=0; i<N_branch_bits-4; i++)
-    {
-        phy_struct->td_vitdec_in[i] = (int8)(d_bits[i*3+0]*127/max_value);
-    }
-    turbo_internal_interleaver(phy_struct->td_vitdec_in,
-                               N_branch_bits-4,
-                               phy_struct->td_in_int);
-
-    // Step 5: Calculate in_int_1 using in_calc_1
-    turbo_internal_interleaver(phy_struct->td_in_calc_1,
-                               N_branch_bits-4,
-                               phy_struct->td_in_int_1);
-
-    // Step 6: Calculate int_act_1 using in_int and d2
-    for(i=0; i<N_branch_bits-4; i++)
-    {
-        phy_struct->td_vitdec_in[2*i+0] = (int8)(d_bits[i*3+2]*127/max_value);
-        phy_struct->td_vitdec_in[2*i+1] = phy_struct->td_in_int[i];
-    }
-    viterbi_decode_siso(phy_struct,
-                        phy_struct->td_vitdec_in,
-                        (N_branch_bits-4)*2,
-                        4,
-                        2,
-                        g_2,
-                        phy_struct->td_int_act_1,
-                        &N_bits);
-
-    // Step 7: Calculate int_act_2 using in_int_1 and d2
-    for(i=0; i<N_branch_bits-4; i++)
-    {
-        phy_struct->td_vitdec_in[2*i+0] = (int8)(d_bits[i*3+2]*127/max_value);
-        phy_struct->td_vitdec_in[2*i+1] = phy_struct->td_in_int_1[i];
-    }
-    viterbi_decode_siso(phy_struct,
-                        phy_struct->td_vitdec_in,
-                        (N_branch_bits-4)*2,
-                        4,
-                        2,
-                        g_2,
-                        phy_struct->td_int_act_2,
-                        &N_bits);
-
-    // Step 8: Calculate fb_int_1 using int_act_1
-    phy_struct->td_fb_int_1[0] = 127;
-    conv_encode_soft(phy_struct,
-                     phy_struct->td_int_act_1,
-                     N_branch_bits-4,
-                     3,
-                     1,
-                     &g_1,
-                     false,
-                     &phy_struct->td_fb_int_1[1],
-                     &N_bits);
-
-    // Step 9: Calculate fb_int_2 using int_act_2
-    phy_struct->td_fb_int_2[0] = 127;
-    conv_encode_soft(phy_struct,
-                     phy_struct->td_int_act_2,
-                     N_branch_bits-4,
-                     3,
-                     1,
-                     &g_1,
-                     false,
-                     &phy_struct->td_fb_int_2[1],
-                     &N_bits);
-
-    // Step 10: Calculate int_calc_1 using int_act_1 and fb_int_1
-    for(i=0; i<N_branch_bits-4; i++)
-    {
-        if(phy_struct->td_int_act_1[i] >= 0 &&
-           phy_struct->td_fb_int_1[i]  >= 0)
-        {
-            phy_struct->td_int_calc_1[i] = (phy_struct->td_int_act_1[i] +
-                                            phy_struct->td_fb_int_1[i]) >> 1;
-        }else if(phy_struct->td_int_act_1[i] < 0 &&
-                 phy_struct->td_fb_int_1[i]  < 0){
-            phy_struct->td_int_calc_1[i] = (-phy_struct->td_int_act_1[i] -
-                                            phy_struct->td_fb_int_1[i]) >> 1;
-        }else if(phy_struct->td_int_act_1[i] >= 0 &&
-                 phy_struct->td_fb_int_1[i]  <  0){
-            phy_struct->td_int_calc_1[i] = -((phy_struct->td_in_act_1[i] -
-                                              phy_struct->td_fb_int_1[i]) >> 1);
-        }else{
-            phy_struct->td_int_calc_1[i] = -((-phy_struct->td_in_act_1[i] +
-                                              phy_struct->td_fb_int_1[i]) >> 1);
-        }
-    }
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.7
+*********************************************************************/
+void ulsch_data_control_demultiplexing(float  *g_bits,
+                                       uint32  N_g_bits,
+                                       uint32  N_cqi_bits,
+                                       uint32  N_l,
+                                       uint32  Q_m,
+                                       float  *f_bits,
+                                       uint32 *N_f_bits,
+                                       float  *cqi_bits)
+{
+    uint32 i = 0;
+    uint32 j = 0;
+    uint32 k = 0;
+    uint32 n;
 
-    // Step 11: Calculate int_calc_2 using int_act_2 and fb_int_2
-    for(i=0; i<N_branch_bits-4; i++)
+    while(j < N_cqi_bits)
     {
-        if(phy_struct->td_int_act_2[i] >= 0 &&
-           phy_struct->td_fb_int_2[i]  >= 0)
+        for(n=0; n<N_l*Q_m; n++)
         {
-            phy_struct->td_int_calc_2[i] = (phy_struct->td_int_act_2[i] +
-                                            phy_struct->td_fb_int_2[i]) >> 1;
-        }else if(phy_struct->td_int_act_2[i] < 0 &&
-                 phy_struct->td_fb_int_2[i]  < 0){
-            phy_struct->td_int_calc_2[i] = (-phy_struct->td_int_act_2[i] -
-                                            phy_struct->td_fb_int_2[i]) >> 1;
-        }else if(phy_struct->td_int_act_2[i] >= 0 &&
-                 phy_struct->td_fb_int_2[i]  <  0){
-            phy_struct->td_int_calc_2[i] = -((phy_struct->td_int_act_2[i] -
-                                              phy_struct->td_fb_int_2[i]) >> 1);
-        }else{
-            phy_struct->td_int_calc_2[i] = -((-phy_struct->td_int_act_2[i] -
-                                              phy_struct->td_fb_int_2[i]) >> 1);
+            cqi_bits[j + n] = g_bits[k*Q_m*N_l + n];
         }
+        j += N_l*Q_m;
+        k++;
     }
-
-    // Step 12: Calculate in_calc_2 using int_calc_1
-    turbo_internal_deinterleaver(phy_struct->td_int_calc_1,
-                                 N_branch_bits-4,
-                                 phy_struct->td_in_calc_2);
-
-    // Step 13: Calculate in_calc_3 using int_calc_2
-    turbo_internal_deinterleaver(phy_struct->td_int_calc_2,
-                                 N_branch_bits-4,
-                                 phy_struct->td_in_calc_3);
-
-    // Step 14: Soft combine d0, in_calc_1, in_calc_2, and in_calc_3 to get output
-    for(i=0; i<N_branch_bits-4; i++)
+    *N_f_bits = N_g_bits - N_cqi_bits;
+    while(i < *N_f_bits)
     {
-        tmp_s_bit = ((int8)(d_bits[i*3+0]*127/max_value) +
-                     phy_struct->td_in_calc_1[i]         +
-                     phy_struct->td_in_calc_2[i]         +
-                     phy_struct->td_in_calc_3[i]);
-        if(tmp_s_bit >= 0)
+        for(n=0; n<N_l*Q_m; n++)
         {
-            c_bits[i] = 0;
-        }else{
-            c_bits[i] = 1;
+            f_bits[i + n] = g_bits[k*Q_m*N_l + n];
         }
+        i += N_l*Q_m;
+        k++;
     }
 }
 
 /*********************************************************************
-    Name: turbo_constituent_encoder
+    Name: ulsch_channel_interleaver
 
-    Description: Constituent encoder for the LTE Parallel Concatenated
-                 Convolutional Code
+    Description: Interleaves Uplink Shared Channel data with RI and
+                 ACK control information
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.8
 *********************************************************************/
-void turbo_constituent_encoder(uint8  *in_bits,
-                               uint32  N_in_bits,
-                               uint8  *out_bits,
-                               uint8  *fb_bits)
+void ulsch_channel_interleaver(LIBLTE_PHY_STRUCT *phy_struct,
+                               uint8             *g_bits,
+                               uint32             N_g_bits,
+                               uint8             *ri_bits,
+                               uint32             N_ri_bits,
+                               uint8             *ack_bits,
+                               uint32             N_ack_bits,
+                               uint32             N_l,
+                               uint32             Q_m,
+                               uint8             *h_bits,
+                               uint32            *N_h_bits)
 {
+    uint32 C_mux;
+    uint32 H_prime;
+    uint32 H_prime_total;
+    uint32 R_mux;
+    uint32 R_prime_mux;
     uint32 i;
     uint32 j;
-    uint32 constraint_len = 4;
-    uint8  s_reg[4]    = {0,0,0,0};
-    uint8  g_array[4]  = {1,1,0,1};
-    uint8  fb_array[4] = {0,0,1,1};
+    uint32 k;
+    uint32 r;
+    uint32 idx;
+    uint32 ri_column_set[4]  = {1, 4, 7, 10};
+    uint32 ack_column_set[4] = {2, 3, 8, 9};
+    uint32 C_ri;
+    uint32 C_ack;
+    uint32 N_pusch_symbs = 12; // FIXME: Only handling normal CP
 
-    // Convolutionally encode input
-    for(i=0; i<N_in_bits; i++)
-    {
-        // Sequence the shift register
-        for(j=constraint_len-1; j>0; j--)
-        {
-            s_reg[j] = s_reg[j-1];
-        }
+    // Step 1: Define C_mux
+    C_mux = N_pusch_symbs;
 
-        // Calculate the feedback bit
-        fb_bits[i] = 0;
-        for(j=0; j<constraint_len; j++)
-        {
-            fb_bits[i] += s_reg[j]*fb_array[j];
-        }
-        fb_bits[i] %= 2;
+    // Step 2: Define R_mux and R_prime_mux
+    H_prime       = N_g_bits;
+    H_prime_total = H_prime + N_ri_bits;
+    R_mux         = (H_prime_total*Q_m*N_l)/C_mux;
+    R_prime_mux   = R_mux/(Q_m*N_l);
 
-        // Add the next bit to the shift register
-        s_reg[0] = (fb_bits[i] + in_bits[i]) % 2;
+    // Initialize the matricies
+    for(i=0; i<C_mux*R_prime_mux; i++)
+    {
+        phy_struct->ul_scratch->ulsch_y_idx[i] = TX_NULL_SYMB;
+    }
+    for(i=0; i<C_mux*R_mux; i++)
+    {
+        phy_struct->ul_scratch->ulsch_y_mat[i] = 0;
+    }
 
-        // Calculate the output bit
-        out_bits[i] = 0;
-        for(j=0; j<constraint_len; j++)
+    // Step 3: Interleave the RI control bits
+    i = 0;
+    j = 0;
+    r = R_prime_mux-1;
+    while(i < N_ri_bits)
+    {
+        C_ri                                                = ri_column_set[j];
+        phy_struct->ul_scratch->ulsch_y_idx[r*C_mux + C_ri] = 1;
+        for(k=0; k<Q_m*N_l; k++)
         {
-            out_bits[i] += s_reg[j]*g_array[j];
+            phy_struct->ul_scratch->ulsch_y_mat[(C_mux*r*Q_m*N_l) + C_ri*Q_m*N_l + k] = ri_bits[i+k];
         }
-        out_bits[i] %= 2;
+        i++;
+        r = R_prime_mux - 1 - i/4;
+        j = (j + 3) % 4;
     }
 
-    // Trellis termination
-    for(i=N_in_bits; i<N_in_bits+4; i++)
+    // Step 4: Interleave the data bits
+    i = 0;
+    k = 0;
+    while(k < H_prime)
     {
-        // Sequence the shift register
-        for(j=constraint_len-1; j>0; j--)
+        if(phy_struct->ul_scratch->ulsch_y_idx[i] == TX_NULL_SYMB)
         {
-            s_reg[j] = s_reg[j-1];
+            phy_struct->ul_scratch->ulsch_y_idx[i] = 1;
+            for(j=0; j<Q_m*N_l; j++)
+            {
+                phy_struct->ul_scratch->ulsch_y_mat[i*Q_m*N_l + j] = g_bits[k*Q_m*N_l + j];
+            }
+            k++;
         }
+        i++;
+    }
 
-        // Calculate the feedback bit
-        fb_bits[i] = 0;
-        for(j=0; j<constraint_len; j++)
+    // Step 5: Interleave the ACK control bits
+    i = 0;
+    j = 0;
+    r = R_prime_mux-1;
+    while(i < N_ack_bits)
+    {
+        C_ack                                                = ack_column_set[j];
+        phy_struct->ul_scratch->ulsch_y_idx[r*C_mux + C_ack] = 2;
+        for(k=0; k<Q_m*N_l; k++)
         {
-            fb_bits[i] += s_reg[j]*fb_array[j];
+            phy_struct->ul_scratch->ulsch_y_mat[(C_mux*r*Q_m*N_l) + C_ack*Q_m*N_l + k] = ack_bits[i+k];
         }
-        fb_bits[i] %= 2;
-
-        // Add the next bit to the shift register
-        s_reg[0] = (fb_bits[i] + fb_bits[i]) % 2;
+        i++;
+        r = R_prime_mux - 1 - i/4;
+        j = (j + 3) % 4;
+    }
 
-        // Calculate the output bit
-        out_bits[i] = 0;
-        for(j=0; j<constraint_len; j++)
+    // Step 6: Read out the bits
+    idx = 0;
+    for(i=0; i<C_mux; i++)
+    {
+        for(j=0; j<R_prime_mux; j++)
         {
-            out_bits[i] += s_reg[j]*g_array[j];
+            for(k=0; k<Q_m*N_l; k++)
+            {
+                h_bits[idx++] = phy_struct->ul_scratch->ulsch_y_mat[j*C_mux*Q_m*N_l + i*Q_m*N_l + k];
+            }
         }
-        out_bits[i] %= 2;
     }
+    *N_h_bits = idx;
 }
 
 /*********************************************************************
-    Name: turbo_internal_interleaver
+    Name: ulsch_channel_deinterleaver
 
-    Description: Internal interleaver for the LTE Parallel
-                 Concatenated Convolutional Code
+    Description: Deinterleaves Uplink Shared Channel data from RI and
+                 ACK control information
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.8
 *********************************************************************/
-void turbo_internal_interleaver(uint8  *in_bits,
-                                uint32  N_in_bits,
-                                uint8  *out_bits)
+void ulsch_channel_deinterleaver(LIBLTE_PHY_STRUCT *phy_struct,
+                                 float             *h_bits,
+                                 uint32             N_h_bits,
+                                 uint32             N_ri_bits,
+                                 uint32             N_ack_bits,
+                                 uint32             N_l,
+                                 uint32             Q_m,
+                                 float             *g_bits,
+                                 uint32            *N_g_bits,
+                                 float             *ri_bits,
+                                 float             *ack_bits)
 {
+    uint32 C_mux;
+    uint32 H_prime;
+    uint32 H_prime_total;
+    uint32 R_mux;
+    uint32 R_prime_mux;
     uint32 i;
-    uint32 f1 = 0;
-    uint32 f2 = 0;
+    uint32 j;
+    uint32 k;
+    uint32 r;
     uint32 idx;
+    uint32 ri_column_set[4]  = {1, 4, 7, 10};
+    uint32 ack_column_set[4] = {2, 3, 8, 9};
+    uint32 C_ri;
+    uint32 C_ack;
+    uint32 N_pusch_symbs = 12; // FIXME: Only handling normal CP
 
-    // Determine f1 and f2
-    for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
+    // Step 1: Define C_mux
+    C_mux = N_pusch_symbs;
+
+    // Step 2: Define R_mux and R_prime_mux
+    H_prime       = N_h_bits/(Q_m*N_l);
+    H_prime_total = H_prime + N_ri_bits;
+    R_mux         = (H_prime_total*Q_m*N_l)/C_mux;
+    R_prime_mux   = R_mux/(Q_m*N_l);
+
+    // Initialize the matricies
+    for(i=0; i<C_mux*R_prime_mux; i++)
     {
-        if(N_in_bits == TURBO_INT_K_TABLE[i])
-        {
-            f1 = TURBO_INT_F1_TABLE[i];
-            f2 = TURBO_INT_F2_TABLE[i];
-            break;
-        }
+        phy_struct->ul_scratch->ulsch_y_idx[i] = RX_NULL_SYMB;
     }
-
-    for(i=0; i<N_in_bits; i++)
+    for(i=0; i<C_mux*R_mux; i++)
     {
-        idx         = (f1*i + f2*i*i) % N_in_bits;
-        out_bits[i] = in_bits[idx];
+        phy_struct->ul_scratch->ulsch_y_mat[i] = 0;
     }
-}
-void turbo_internal_interleaver(int8   *in_bits,
-                                uint32  N_in_bits,
-                                int8   *out_bits)
-{
-    uint32 i;
-    uint32 f1 = 0;
-    uint32 f2 = 0;
-    uint32 idx;
 
-    // Determine f1 and f2
-    for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
+    // Step 6: Construct matrix
+    idx = 0;
+    for(i=0; i<C_mux; i++)
     {
-        if(N_in_bits == TURBO_INT_K_TABLE[i])
+        for(j=0; j<R_prime_mux; j++)
         {
-            f1 = TURBO_INT_F1_TABLE[i];
-            f2 = TURBO_INT_F2_TABLE[i];
-            break;
+            for(k=0; k<Q_m*N_l; k++)
+            {
+                phy_struct->ul_scratch->ulsch_y_mat[j*C_mux*Q_m*N_l + i*Q_m*N_l + k] = h_bits[idx++];
+            }
         }
     }
 
-    for(i=0; i<N_in_bits; i++)
+    // Step 5: Deinterleave the ACK control bits
+    i = 0;
+    j = 0;
+    r = R_prime_mux-1;
+    while(i < N_ack_bits)
     {
-        idx         = (f1*i + f2*i*i) % N_in_bits;
-        out_bits[i] = in_bits[idx];
-    }
-}
-void turbo_internal_interleaver(float  *in_bits,
-                                uint32  N_in_bits,
-                                float  *out_bits)
-{
-    uint32 i;
-    uint32 f1 = 0;
-    uint32 f2 = 0;
-    uint32 idx;
+        C_ack                                                = ack_column_set[j];
+        phy_struct->ul_scratch->ulsch_y_idx[r*C_mux + C_ack] = 2;
+        for(k=0; k<Q_m*N_l; k++)
+        {
+            ack_bits[i+k] = phy_struct->ul_scratch->ulsch_y_mat[C_mux*r*Q_m*N_l + C_ack*Q_m*N_l + k];
+        }
+        i++;
+        r = R_prime_mux - 1 - i/4;
+        j = (j + 3) % 4;
+    }
 
-    // Determine f1 and f2
-    for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
+    // Step 3: Deinterleave the RI control bits
+    i = 0;
+    j = 0;
+    r = R_prime_mux-1;
+    while(i < N_ri_bits)
     {
-        if(N_in_bits == TURBO_INT_K_TABLE[i])
+        C_ri                                                = ri_column_set[j];
+        phy_struct->ul_scratch->ulsch_y_idx[r*C_mux + C_ri] = 1;
+        for(k=0; k<Q_m*N_l; k++)
         {
-            f1 = TURBO_INT_F1_TABLE[i];
-            f2 = TURBO_INT_F2_TABLE[i];
-            break;
+            ri_bits[i*Q_m*N_l + k] = phy_struct->ul_scratch->ulsch_y_mat[C_mux*r*Q_m*N_l + C_ri*Q_m*N_l + k];
         }
+        i++;
+        r = R_prime_mux - 1 - i/4;
+        j = (j + 3) % 4;
     }
 
-    for(i=0; i<N_in_bits; i++)
+    // Step 4: Interleave the data bits
+    i = 0;
+    k = 0;
+    while(k < H_prime)
     {
-        idx         = (f1*i + f2*i*i) % N_in_bits;
-        out_bits[i] = in_bits[idx];
+        if(phy_struct->ul_scratch->ulsch_y_idx[i] == RX_NULL_SYMB)
+        {
+            phy_struct->ul_scratch->ulsch_y_idx[i] = 1;
+            for(j=0; j<Q_m*N_l; j++)
+            {
+                g_bits[k*Q_m*N_l + j] = phy_struct->ul_scratch->ulsch_y_mat[i*Q_m*N_l + j];
+            }
+            k++;
+        }else if(phy_struct->ul_scratch->ulsch_y_idx[i] == 2){
+            for(j=0; j<Q_m*N_l; j++)
+            {
+                g_bits[k*Q_m*N_l + j] = RX_NULL_SYMB;
+            }
+            k++;
+        }
+        i++;
     }
+    *N_g_bits = k*Q_m*N_l;
 }
 
 /*********************************************************************
-    Name: turbo_internal_deinterleaver
+    Name: ulsch_channel_encode
 
-    Description: Internal Deinterleaver for the LTE Parallel
-                 Concatenated Convolutional Code
+    Description: Channel encodes the Uplink Shared Channel
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2
+
+    Notes: Not handling control bits
 *********************************************************************/
-void turbo_internal_deinterleaver(float  *in_bits,
-                                  uint32  N_in_bits,
-                                  float  *out_bits)
+void ulsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                          uint8             *in_bits,
+                          uint32             N_in_bits,
+                          uint32             tbs,
+                          uint32             tx_mode,
+                          uint32             G,
+                          uint32             N_l,
+                          uint32             Q_m,
+                          uint32             rv_idx,
+                          uint8             *out_bits,
+                          uint32            *N_out_bits)
 {
-    uint32 i;
-    uint32 f1 = 0;
-    uint32 f2 = 0;
-    uint32 idx;
+    uint32  cb;
+    uint32  N_codeblocks;
+    uint32  N_fill_bits;
+    uint32  N_d_bits;
+    uint32  N_f_bits;
+    uint32  N_g_bits;
+    uint32  N_ri_bits  = 0;
+    uint32  N_ack_bits = 0;
+    uint32  N_cqi_bits = 0;
+    uint32  G_prime;
+    uint32  lambda;
+    uint64  p_word;
+    uint8  *a_bits;
 
-    // Determine f1 and f2
-    for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
-    {
-        if(N_in_bits == TURBO_INT_K_TABLE[i])
-        {
-            f1 = TURBO_INT_F1_TABLE[i];
-            f2 = TURBO_INT_F2_TABLE[i];
-            break;
-        }
-    }
+    // Define a_bits
+    a_bits = in_bits;
 
-    for(i=0; i<N_in_bits; i++)
-    {
-        idx           = (f1*i + f2*i*i) % N_in_bits;
-        out_bits[idx] = in_bits[i];
-    }
-}
-void turbo_internal_deinterleaver(int8   *in_bits,
-                                  uint32  N_in_bits,
-                                  int8   *out_bits)
-{
-    uint32 i;
-    uint32 f1 = 0;
-    uint32 f2 = 0;
-    uint32 idx;
+    // Pad input up to tbs size, calculate p_bits, and construct b_bits
+    memset(phy_struct->ul_scratch->ulsch_b_words, 0, sizeof(uint64)*((tbs+24+63)/64));
+    pack_bits(a_bits, N_in_bits, phy_struct->ul_scratch->ulsch_b_words);
+    p_word = (uint64)calc_crc_packed(phy_struct->ul_scratch->ulsch_b_words, tbs, CRC24A, 24) << 40;
+    copy_bits(&p_word, 0, 24, phy_struct->ul_scratch->ulsch_b_words, tbs);
 
-    // Determine f1 and f2
-    for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
+    // Construct c_bits
+    code_block_segmentation_packed(phy_struct->ul_scratch->ulsch_b_words,
+                                   tbs+24,
+                                   &N_codeblocks,
+                                   &N_fill_bits,
+                                   phy_struct->ul_scratch->ulsch_c_words[0],
+                                   96,
+                                   phy_struct->ul_scratch->ulsch_N_c_bits);
+
+    N_f_bits = 0;
+    for(cb=0; cb<N_codeblocks; cb++)
     {
-        if(N_in_bits == TURBO_INT_K_TABLE[i])
+        // Construct d_bits
+        turbo_encode_packed(phy_struct,
+                            phy_struct->ul_scratch->ulsch_c_words[cb],
+                            phy_struct->ul_scratch->ulsch_N_c_bits[cb],
+                            phy_struct->ul_scratch->ulsch_d_words[0],
+                            97,
+                            &N_d_bits);
+
+        // Determine e_bits and N_e_bits, concatenating the code blocks
+        // into f_bits as they are rate matched
+        G_prime = G/(N_l*Q_m);
+        lambda  = G_prime % N_codeblocks;
+        if(cb <= (N_codeblocks - lambda - 1))
         {
-            f1 = TURBO_INT_F1_TABLE[i];
-            f2 = TURBO_INT_F2_TABLE[i];
-            break;
-        }
+            phy_struct->ul_scratch->ulsch_N_e_bits[cb] = N_l*Q_m*(G_prime/N_codeblocks);
+        }else{
+            phy_struct->ul_scratch->ulsch_N_e_bits[cb] = N_l*Q_m*(uint32)ceilf((float)G_prime/(float)N_codeblocks);
+        }
+        rate_match_turbo_packed(phy_struct,
+                                phy_struct->ul_scratch->ulsch_d_words[0],
+                                97,
+                                N_d_bits,
+                                (0 == cb) ? N_fill_bits : 0,
+                                N_codeblocks,
+                                tx_mode,
+                                1,
+                                1,
+                                LIBLTE_PHY_CHAN_TYPE_ULSCH,
+                                rv_idx,
+                                phy_struct->ul_scratch->ulsch_N_e_bits[cb],
+                                phy_struct->ul_scratch->ulsch_f_words,
+                                N_f_bits);
+        N_f_bits += phy_struct->ul_scratch->ulsch_N_e_bits[cb];
     }
 
-    for(i=0; i<N_in_bits; i++)
-    {
-        idx           = (f1*i + f2*i*i) % N_in_bits;
-        out_bits[idx] = in_bits[i];
-    }
+    // Determine f_bits
+    unpack_bits(phy_struct->ul_scratch->ulsch_f_words, N_f_bits, phy_struct->ul_scratch->ulsch_tx_f_bits);
+
+    // Determine g_bits
+    ulsch_data_control_multiplexing(phy_struct->ul_scratch->ulsch_tx_f_bits,
+                                    N_f_bits,
+                                    NULL,
+                                    N_cqi_bits,
+                                    N_l,
+                                    Q_m,
+                                    phy_struct->ul_scratch->ulsch_tx_g_bits,
+                                    &N_g_bits);
+
+    // Determine output
+    ulsch_channel_interleaver(phy_struct,
+                              phy_struct->ul_scratch->ulsch_tx_g_bits,
+                              N_g_bits,
+                              NULL,
+                              N_ri_bits,
+                              NULL,
+                              N_ack_bits,
+                              N_l,
+                              Q_m,
+                              out_bits,
+                              N_out_bits);
 }
 
 /*********************************************************************
-    Name: rate_match_turbo
+    Name: ulsch_channel_decode
 
-    Description: Rate matches turbo encoded data
+    Description: Channel decodes the Uplink Shared Channel
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2
+
+    Notes: Not handling control bits
 *********************************************************************/
-void rate_match_turbo(LIBLTE_PHY_STRUCT         *phy_struct,
-                      uint8                     *d_bits,
-                      uint32                     N_d_bits,
-                      uint32                     N_codeblocks,
-                      uint32                     tx_mode,
-                      uint32                     N_soft,
-                      uint32                     M_dl_harq,
-                      LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type,
-                      uint32                     rv_idx,
-                      uint32                     N_e_bits,
-                      uint8                     *e_bits)
+LIBLTE_ERROR_ENUM ulsch_channel_decode(LIBLTE_PHY_STRUCT             *phy_struct,
+                                       float                         *in_bits,
+                                       uint32                         N_in_bits,
+                                       uint32                         tbs,
+                                       uint32                         tx_mode,
+                                       uint32                         N_l,
+                                       uint32                         Q_m,
+                                       uint32                         rv_idx,
+                                       LIBLTE_PHY_HARQ_BUFFER_STRUCT *harq,
+                                       uint8                         *out_bits,
+                                       uint32                        *N_out_bits)
 {
-    uint32 C_tc_sb = 32; // Step 1: Assign C_tc_sb to 32
-    uint32 R_tc_sb;
-    uint32 w_idx = 0;
-    uint32 d_idx;
-    uint32 pi_idx;
-    uint32 N_dummy;
-    uint32 K_mimo;
-    uint32 N_ir;
-    uint32 N_cb;
-    uint32 idx;
-    uint32 K_pi;
-    uint32 K_w;
-    uint32 k_0;
-    uint32 i;
-    uint32 j;
-    uint32 k;
-    uint32 x;
-
-    // Sub-block interleaving
-    // Step 2: Determine the number of rows
-    R_tc_sb = 0;
-    while((N_d_bits/3) > (C_tc_sb*R_tc_sb))
-    {
-        R_tc_sb++;
-    }
-
-    // Steps 3, 4, and 5
-    for(x=0; x<3; x++)
-    {
-        // Step 3: Pack data into matrix and pad with dummy
-        if((N_d_bits/3) < (C_tc_sb*R_tc_sb))
-        {
-            N_dummy = C_tc_sb*R_tc_sb - (N_d_bits/3);
-        }else{
-            N_dummy = 0;
-        }
-        for(i=0; i<N_dummy; i++)
-        {
-            phy_struct->rmt_tmp[i] = TX_NULL_BIT;
-        }
-        d_idx = 0;
-        for(i=N_dummy; i<C_tc_sb*R_tc_sb; i++)
-        {
-            phy_struct->rmt_tmp[i] = d_bits[(N_d_bits/3)*x+d_idx];
-            d_idx++;
-        }
-        idx = 0;
-        for(i=0; i<R_tc_sb; i++)
-        {
-            for(j=0; j<C_tc_sb; j++)
-            {
-                phy_struct->rmt_sb_mat[i][j] = phy_struct->rmt_tmp[idx++];
-            }
-        }
+    LIBLTE_PHY_CB_JOB_STRUCT *job;
+    LIBLTE_ERROR_ENUM         err = LIBLTE_ERROR_INVALID_CRC;
+    LIBLTE_ERROR_ENUM         cb_err;
+    uint32                    i;
+    uint32                    cb;
+    uint32                    ber;
+    uint32                    N_b_bits;
+    uint32                    N_f_bits;
+    uint32                    N_g_bits;
+    uint32                    N_ri_bits  = 0;
+    uint32                    N_ack_bits = 0;
+    uint32                    N_cqi_bits = 0;
+    uint32                    N_fill_bits;
+    uint32                    N_codeblocks;
+    uint32                    crc;
+    uint8                     calc_p_bits[24];
+    uint8                    *a_bits;
+    uint8                    *p_bits;
+
+    // Determine the code block sizes and filler bits
+    N_b_bits = tbs+24;
+    memset(phy_struct->ul_scratch->ulsch_b_bits, 0, sizeof(uint8)*N_b_bits);
+    code_block_segmentation(phy_struct->ul_scratch->ulsch_b_bits,
+                            N_b_bits,
+                            &N_codeblocks,
+                            &N_fill_bits,
+                            phy_struct->ul_scratch->ulsch_c_bits[0],
+                            6144,
+                            phy_struct->ul_scratch->ulsch_N_c_bits);
 
-        w_idx = 0;
-        if(x != 2)
-        {
-            // Step 4: Inter-column permutation
-            for(i=0; i<R_tc_sb; i++)
-            {
-                for(j=0; j<C_tc_sb; j++)
-                {
-                    phy_struct->rmt_sb_perm_mat[i][j] = phy_struct->rmt_sb_mat[i][IC_PERM_TC[j]];
-                }
-            }
+    // Determine g_bits
+    ulsch_channel_deinterleaver(phy_struct,
+                                in_bits,
+                                N_in_bits,
+                                N_ri_bits,
+                                N_ack_bits,
+                                N_l,
+                                Q_m,
+                                phy_struct->ul_scratch->ulsch_rx_g_bits,
+                                &N_g_bits,
+                                NULL,
+                                NULL);
 
-            // Step 5: Read out the bits
-            idx  = 0;
-            K_pi = R_tc_sb*C_tc_sb;
-            for(j=0; j<C_tc_sb; j++)
-            {
-                for(i=0; i<R_tc_sb; i++)
-                {
-                    if(x == 0)
-                    {
-                        phy_struct->rmt_w[w_idx++] = phy_struct->rmt_sb_perm_mat[i][j];
-                    }else{
-                        phy_struct->rmt_w[K_pi+(2*w_idx)] = phy_struct->rmt_sb_perm_mat[i][j];
-                        w_idx++;
-                    }
-                }
-            }
-        }else{
-            // Step 4: Permutation for the last output
-            K_pi = R_tc_sb*C_tc_sb;
-            idx  = 0;
-            for(i=0; i<R_tc_sb; i++)
-            {
-                for(j=0; j<C_tc_sb; j++)
-                {
-                    phy_struct->rmt_y[idx++] = phy_struct->rmt_sb_mat[i][j];
-                }
-            }
-            for(i=0; i<K_pi; i++)
-            {
-                pi_idx                              = (IC_PERM_TC[i/R_tc_sb]+C_tc_sb*(i%R_tc_sb)+1) % K_pi;
-                phy_struct->rmt_w[K_pi+(2*w_idx)+1] = phy_struct->rmt_y[pi_idx];
-                w_idx++;
-            }
-        }
-    }
+    // Determine f_bits
+    ulsch_data_control_demultiplexing(phy_struct->ul_scratch->ulsch_rx_g_bits,
+                                      N_g_bits,
+                                      N_cqi_bits,
+                                      N_l,
+                                      Q_m,
+                                      phy_struct->ul_scratch->ulsch_rx_f_bits,
+                                      &N_f_bits,
+                                      NULL);
 
-    // Bit collection, selection, and transmission
-    // Create circular buffer
-    K_w = 3*K_pi;
-    if(tx_mode == 3 ||
-       tx_mode == 4 ||
-       tx_mode == 8 ||
-       tx_mode == 9)
-    {
-        K_mimo = 2;
-    }else{
-        K_mimo = 1;
-    }
-    if(M_dl_harq < 8)
-    {
-        N_ir = N_soft/(K_mimo*M_dl_harq);
-    }else{
-        N_ir = N_soft/(K_mimo*8);
-    }
-    if(LIBLTE_PHY_CHAN_TYPE_DLSCH == chan_type ||
-       LIBLTE_PHY_CHAN_TYPE_PCH   == chan_type)
+    // Determine e_bits
+    code_block_deconcatenation(phy_struct->ul_scratch->ulsch_rx_f_bits,
+                               N_f_bits,
+                               N_codeblocks,
+                               N_l,
+                               Q_m,
+                               phy_struct->ul_scratch->ulsch_rx_e_bits,
+                               phy_struct->ul_scratch->ulsch_N_e_bits);
+
+    // A different transport block starts with empty soft buffers
+    if(NULL != harq &&
+       (tbs          != harq->tbs ||
+        N_codeblocks != harq->N_codeblocks))
     {
-        if((N_ir/N_codeblocks) < K_w)
+        for(cb=0; cb<N_codeblocks; cb++)
         {
-            N_cb = N_ir/N_codeblocks;
-        }else{
-            N_cb = K_w;
+            memset(harq->soft_bits[cb], 0, sizeof(int16)*3*(phy_struct->ul_scratch->ulsch_N_c_bits[cb]+4));
         }
+        harq->tbs          = tbs;
+        harq->N_codeblocks = N_codeblocks;
+    }
+
+    // Determine c_bits, each code block is decoded independently
+    if(1 == N_codeblocks)
+    {
+        crc = CRC24A;
     }else{
-        N_cb = K_w;
+        crc = CRC24B;
     }
-    k_0 = R_tc_sb*(2*(uint32)ceilf((float)N_cb/(float)(8*R_tc_sb))*rv_idx+2);
-    k   = 0;
-    j   = 0;
-    while(k < N_e_bits)
+    for(cb=0; cb<N_codeblocks; cb++)
     {
-        if(phy_struct->rmt_w[(k_0+j)%N_cb] != TX_NULL_BIT)
-        {
-            e_bits[k++] = phy_struct->rmt_w[(k_0+j)%N_cb];
+        job               = &phy_struct->cb_job[cb];
+        job->chan_type    = LIBLTE_PHY_CHAN_TYPE_ULSCH;
+        job->e_bits       = phy_struct->ul_scratch->ulsch_rx_e_bits[cb];
+        job->N_e_bits     = phy_struct->ul_scratch->ulsch_N_e_bits[cb];
+        job->N_fill_bits  = (0 == cb) ? N_fill_bits : 0;
+        job->N_codeblocks = N_codeblocks;
+        job->tx_mode      = tx_mode;
+        job->N_soft       = 1;
+        job->M_dl_harq    = 1;
+        job->rv_idx       = rv_idx;
+        job->crc          = crc;
+        job->N_c_bits     = &phy_struct->ul_scratch->ulsch_N_c_bits[cb];
+        job->c_bits       = phy_struct->ul_scratch->ulsch_c_bits[cb];
+        if(NULL != harq)
+        {
+            job->harq_bits = harq->soft_bits[cb];
+        }else{
+            job->harq_bits = NULL;
         }
-        j++;
     }
-}
+    code_block_decode_all(phy_struct, N_codeblocks);
 
-/*********************************************************************
-    Name: rate_unmatch_turbo
+    // Determine b_bits
+    cb_err = code_block_desegmentation(phy_struct->ul_scratch->ulsch_c_bits[0],
+                                       phy_struct->ul_scratch->ulsch_N_c_bits,
+                                       6144,
+                                       tbs,
+                                       phy_struct->ul_scratch->ulsch_b_bits,
+                                       N_b_bits);
 
-    Description: Rate unmatches turbo encoded data
+    // Recover a_bits and p_bits
+    a_bits = &phy_struct->ul_scratch->ulsch_b_bits[0];
+    p_bits = &phy_struct->ul_scratch->ulsch_b_bits[tbs];
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1
-*********************************************************************/
-void rate_unmatch_turbo(LIBLTE_PHY_STRUCT         *phy_struct,
-                        float                     *e_bits,
-                        uint32                     N_e_bits,
-                        uint8                     *dummy_bits,
-                        uint32                     N_dummy_bits,
-                        uint32                     N_codeblocks,
-                        uint32                     tx_mode,
-                        uint32                     N_soft,
-                        uint32                     M_dl_harq,
-                        LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type,
-                        uint32                     rv_idx,
-                        float                     *d_bits,
-                        uint32                    *N_d_bits)
-{
-    uint32 C_tc_sb = 32; // Step 1: Assign C_tc_sb to 32
-    uint32 R_tc_sb;
-    uint32 w_idx = 0;
-    uint32 d_idx;
-    uint32 pi_idx;
-    uint32 N_dummy;
-    uint32 K_mimo;
-    uint32 N_ir;
-    uint32 N_cb;
-    uint32 idx;
-    uint32 K_pi;
-    uint32 K_w;
-    uint32 k_0;
-    uint32 i;
-    uint32 j;
-    uint32 k;
-    uint32 x;
+    // Calculate p_bits
+    calc_crc(a_bits, tbs, CRC24A, calc_p_bits, 24);
 
-    // In order to undo bit collection, selection, and transmission
-    // a dummy block must be sub-block interleaved to determine
-    // where NULL bits are to be inserted
-    // Sub-block interleaving
-    // Step 2: Determine the number of rows
-    R_tc_sb = 0;
-    while(N_dummy_bits > (C_tc_sb*R_tc_sb))
+    // Check CRC
+    ber = 0;
+    for(i=0; i<24; i++)
     {
-        R_tc_sb++;
+        ber += p_bits[i] ^ calc_p_bits[i];
     }
-
-    // Steps 3, 4, and 5
-    for(x=0; x<3; x++)
+    if(LIBLTE_SUCCESS == cb_err &&
+       0              == ber)
     {
-        // Step 3: Pack data into matrix and pad with dummy
-        if(N_dummy_bits < (C_tc_sb*R_tc_sb))
-        {
-            N_dummy = C_tc_sb*R_tc_sb - N_dummy_bits;
-        }else{
-            N_dummy = 0;
-        }
-        for(i=0; i<N_dummy; i++)
-        {
-            phy_struct->rut_tmp[i] = RX_NULL_BIT;
-        }
-        d_idx = 0;
-        for(i=N_dummy; i<C_tc_sb*R_tc_sb; i++)
-        {
-            phy_struct->rut_tmp[i] = dummy_bits[d_idx*3+x];
-            d_idx++;
-        }
-        idx = 0;
-        for(i=0; i<R_tc_sb; i++)
+        for(i=0; i<tbs; i++)
         {
-            for(j=0; j<C_tc_sb; j++)
-            {
-                phy_struct->rut_sb_mat[i][j] = phy_struct->rut_tmp[idx++];
-            }
+            out_bits[i] = a_bits[i];
         }
+        *N_out_bits = tbs;
+        err         = LIBLTE_SUCCESS;
 
-        w_idx = 0;
-        if(x != 2)
+        // The transport block is done with its soft buffer
+        if(NULL != harq)
         {
-            // Step 4: Inter-column permutation
-            for(i=0; i<R_tc_sb; i++)
-            {
-                for(j=0; j<C_tc_sb; j++)
-                {
-                    phy_struct->rut_sb_perm_mat[i][j] = phy_struct->rut_sb_mat[i][IC_PERM_TC[j]];
-                }
-            }
-
-            // Step 5: Read out the bits
-            K_pi = R_tc_sb*C_tc_sb;
-            for(j=0; j<C_tc_sb; j++)
-            {
-                for(i=0; i<R_tc_sb; i++)
-                {
-                    if(x == 0)
-                    {
-                        phy_struct->rut_w_dum[w_idx] = phy_struct->rut_sb_perm_mat[i][j];
-                        phy_struct->rut_w[w_idx]     = RX_NULL_BIT;
-                        w_idx++;
-                    }else{
-                        phy_struct->rut_w_dum[K_pi+(2*w_idx)] = phy_struct->rut_sb_perm_mat[i][j];
-                        phy_struct->rut_w[K_pi+(2*w_idx)]     = RX_NULL_BIT;
-                        w_idx++;
-                    }
-                }
-            }
-        }else{
-            // Step 4: Permutation for the last output
-            K_pi = R_tc_sb*C_tc_sb;
-            idx  = 0;
-            for(i=0; i<R_tc_sb; i++)
-            {
-                for(j=0; j<C_tc_sb; j++)
-                {
-                    phy_struct->rut_y[idx++] = phy_struct->rut_sb_mat[i][j];
-                }
-            }
-            for(i=0; i<K_pi; i++)
-            {
-                pi_idx                                  = (IC_PERM_TC[i/R_tc_sb]+C_tc_sb*(i%R_tc_sb)+1)%K_pi;
-                phy_struct->rut_w_dum[K_pi+(2*w_idx)+1] = phy_struct->rut_y[pi_idx];
-                phy_struct->rut_w[K_pi+(2*w_idx)+1]     = RX_NULL_BIT;
-                w_idx++;
-            }
+            harq->tbs = 0;
         }
     }
 
-    // Undo bit collection, selection, and transmission by
-    // recreating the circular buffer
-    K_w = 3*K_pi;
-    if(tx_mode == 3 ||
-       tx_mode == 4 ||
-       tx_mode == 8 ||
-       tx_mode == 9)
+    return(err);
+}
+
+/*********************************************************************
+    Name: bch_channel_encode
+
+    Description: Channel encodes the broadcast channel
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.1
+*********************************************************************/
+void bch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                        uint8             *in_bits,
+                        uint32             N_in_bits,
+                        uint8              N_ant,
+                        uint8             *out_bits,
+                        uint32            *N_out_bits)
+{
+    uint32  i;
+    uint32  g[3] = {0133, 0171, 0165}; // Numbers are in octal
+    uint32  N_d_bits;
+    uint8  *ant_mask = NULL;
+    uint8  *a_bits   = NULL;
+    uint8   p_bits[16];
+    uint8   ant_mask_1[16] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
+    uint8   ant_mask_2[16] = {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1};
+    uint8   ant_mask_4[16] = {0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1};
+
+    if(N_ant == 1)
     {
-        K_mimo = 2;
+        ant_mask = ant_mask_1;
+    }else if(N_ant == 2){
+        ant_mask = ant_mask_2;
     }else{
-        K_mimo = 1;
+        ant_mask = ant_mask_4;
     }
-    if(M_dl_harq < 8)
+
+    // Define a_bits
+    a_bits = in_bits;
+
+    // Calculate p_bits
+    calc_crc(a_bits, 24, CRC16, p_bits, 16);
+
+    // Mask p_bits
+    for(i=0; i<16; i++)
     {
-        N_ir = N_soft/(K_mimo*M_dl_harq);
-    }else{
-        N_ir = N_soft/(K_mimo*8);
+        p_bits[i] = p_bits[i] ^ ant_mask[i];
     }
-    if(LIBLTE_PHY_CHAN_TYPE_DLSCH == chan_type ||
-       LIBLTE_PHY_CHAN_TYPE_PCH   == chan_type)
+
+    // Construct c_bits
+    for(i=0; i<24; i++)
     {
-        if((N_ir/N_codeblocks) < K_w)
-        {
-            N_cb = N_ir/N_codeblocks;
-        }else{
-            N_cb = K_w;
-        }
-    }else{
-        N_cb = K_w;
+        phy_struct->bch_c_bits[i] = a_bits[i];
     }
-    k_0 = R_tc_sb*(2*ceilf((float)N_cb/(float)(8*R_tc_sb))*rv_idx+2);
-    k   = 0;
-    j   = 0;
-    while(k < N_e_bits)
+    for(i=0; i<16; i++)
     {
-        if(phy_struct->rut_w_dum[(k_0+j)%N_cb] != RX_NULL_BIT)
-        {
-            // Soft combine the inputs
-            if(phy_struct->rut_w[(k_0+j)%N_cb] == RX_NULL_BIT)
-            {
-                phy_struct->rut_w[(k_0+j)%N_cb] = e_bits[k];
-            }else if(e_bits[k] != RX_NULL_BIT){
-                phy_struct->rut_w[(k_0+j)%N_cb] += e_bits[k];
-            }
-            k++;
-        }
-        j++;
+        phy_struct->bch_c_bits[24+i] = p_bits[i];
     }
 
-    // Recreate the sub-block interleaver output
-    for(i=0; i<K_pi; i++)
-    {
-        phy_struct->rut_v[0][i] = phy_struct->rut_w[i];
-        phy_struct->rut_v[1][i] = phy_struct->rut_w[K_pi+2*i];
-        phy_struct->rut_v[2][i] = phy_struct->rut_w[K_pi+2*i+1];
-    }
+    // Determine d_bits
+    conv_encode(phy_struct,
+                phy_struct->bch_c_bits,
+                40,
+                7,
+                3,
+                g,
+                true,
+                phy_struct->bch_tx_d_bits,
+                &N_d_bits);
 
-    // Sub-block deinterleaving
-    // Steps 5, 4, and 3
-    for(x=0; x<3; x++)
-    {
-        if(x != 2)
-        {
-            // Step 5: Load the permuted matrix
-            idx = 0;
-            for(j=0; j<C_tc_sb; j++)
-            {
-                for(i=0; i<R_tc_sb; i++)
-                {
-                    phy_struct->rut_sb_perm_mat[i][j] = phy_struct->rut_v[x][idx++];
-                }
-            }
+    // Determine e_bits
+    rate_match_conv(phy_struct, phy_struct->bch_tx_d_bits, N_d_bits, 1920, out_bits);
+    *N_out_bits = 1920;
+}
 
-            // Step 4: Undo permutation
-            for(i=0; i<R_tc_sb; i++)
-            {
-                for(j=0; j<C_tc_sb; j++)
-                {
-                    phy_struct->rut_sb_mat[i][IC_PERM_TC[j]] = phy_struct->rut_sb_perm_mat[i][j];
-                }
-            }
-        }else{
-            // Step 4: Permutation for the last output
-            for(i=0; i<K_pi; i++)
-            {
-                pi_idx                    = (IC_PERM_TC[i/R_tc_sb]+C_tc_sb*(i%R_tc_sb)+1) % K_pi;
-                phy_struct->rut_y[pi_idx] = phy_struct->rut_v[x][i];
-            }
-            idx = 0;
-            for(i=0; i<R_tc_sb; i++)
-            {
-                for(j=0; j<C_tc_sb; j++)
-                {
-                    phy_struct->rut_sb_mat[i][j] = phy_struct->rut_y[idx++];
-                }
-            }
-        }
+/*********************************************************************
+    Name: bch_channel_decode
 
-        // Step 3: Unpack the data and remove dummy
-        if(N_dummy_bits < (C_tc_sb*R_tc_sb))
-        {
-            N_dummy = C_tc_sb*R_tc_sb - N_dummy_bits;
-        }else{
-            N_dummy = 0;
-        }
-        idx = 0;
-        for(i=0; i<R_tc_sb; i++)
-        {
-            for(j=0; j<C_tc_sb; j++)
-            {
-                phy_struct->rut_tmp[idx++] = phy_struct->rut_sb_mat[i][j];
-            }
-        }
-        d_idx = 0;
-        for(i=N_dummy; i<C_tc_sb*R_tc_sb; i++)
-        {
-            d_bits[d_idx*3+x] = phy_struct->rut_tmp[i];
-            d_idx++;
-        }
-    }
-    *N_d_bits = d_idx*3;
-}
+    Description: Channel decodes the broadcast channel
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.1
+*********************************************************************/
+LIBLTE_ERROR_ENUM bch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                                     float             *in_bits,
+                                     uint32             N_in_bits,
+                                     uint8             *N_ant,
+                                     uint8             *out_bits,
+                                     uint32            *N_out_bits)
+{
+    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_CRC;
+    uint32             ber_1;
+    uint32             ber_2;
+    uint32             ber_4;
+    uint32             N_d_bits;
+    uint32             N_c_bits;
+    uint32             i;
+    uint8             *a_bits;
+    uint8             *p_bits;
+    uint8              calc_p_bits[16];
+    uint8              ant_mask_1[16] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
+    uint8              ant_mask_2[16] = {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1};
+    uint8              ant_mask_4[16] = {0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1};
 
-/*********************************************************************
-    Name: rate_match_conv
+    // Rate unmatch to get the d_bits
+    rate_unmatch_conv(phy_struct,
+                      in_bits,
+                      N_in_bits,
+                      40,
+                      phy_struct->bch_rx_d_bits,
+                      &N_d_bits);
 
-    Description: Rate matches convolutionally encoded data
+    // Viterbi decode the d_bits to get the c_bits
+    viterbi_decode(phy_struct,
+                   phy_struct->bch_rx_d_bits,
+                   N_d_bits,
+                   phy_struct->bch_c_bits,
+                   &N_c_bits);
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.2
-*********************************************************************/
-void rate_match_conv(LIBLTE_PHY_STRUCT *phy_struct,
-                     uint8             *d_bits,
-                     uint32             N_d_bits,
-                     uint32             N_e_bits,
-                     uint8             *e_bits)
-{
-    uint32 C_cc_sb = 32; // Step 1: Assign C_cc_sb to 32
-    uint32 R_cc_sb;
-    uint32 w_idx = 0;
-    uint32 d_idx;
-    uint32 N_dummy;
-    uint32 idx;
-    uint32 K_pi;
-    uint32 K_w;
-    uint32 i;
-    uint32 j;
-    uint32 k;
-    uint32 x;
+    // Recover a_bits and p_bits
+    a_bits = &phy_struct->bch_c_bits[0];
+    p_bits = &phy_struct->bch_c_bits[24];
 
-    // Sub-block interleaving
-    // Step 2: Determine the number of rows
-    R_cc_sb = 0;
-    while((N_d_bits/3) > (C_cc_sb*R_cc_sb))
+    // Calculate p_bits
+    calc_crc(a_bits, 24, CRC16, calc_p_bits, 16);
+
+    // Try all p_bit masks
+    ber_1 = 0;
+    ber_2 = 0;
+    ber_4 = 0;
+    for(i=0; i<16; i++)
     {
-        R_cc_sb++;
+        ber_1 += p_bits[i] ^ (calc_p_bits[i] ^ ant_mask_1[i]);
+        ber_2 += p_bits[i] ^ (calc_p_bits[i] ^ ant_mask_2[i]);
+        ber_4 += p_bits[i] ^ (calc_p_bits[i] ^ ant_mask_4[i]);
     }
 
-    // Steps 3, 4, and 5
-    for(x=0; x<3; x++)
+    if(ber_1 == 0 || ber_2 == 0 || ber_4 == 0)
     {
-        // Step 3: Pack data into matrix and pad with dummy
-        if((N_d_bits/3) < (C_cc_sb*R_cc_sb))
-        {
-            N_dummy = C_cc_sb*R_cc_sb - (N_d_bits/3);
-        }else{
-            N_dummy = 0;
-        }
-        for(i=0; i<N_dummy; i++)
-        {
-            phy_struct->rmc_tmp[i] = TX_NULL_BIT;
-        }
-        d_idx = 0;
-        for(i=N_dummy; i<C_cc_sb*R_cc_sb; i++)
-        {
-            phy_struct->rmc_tmp[i] = d_bits[d_idx*3+x];
-            d_idx++;
-        }
-        idx = 0;
-        for(i=0; i<R_cc_sb; i++)
-        {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->rmc_sb_mat[i][j] = phy_struct->rmc_tmp[idx++];
-            }
-        }
-
-        // Step 4: Inter-column permutation
-        for(i=0; i<R_cc_sb; i++)
-        {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->rmc_sb_perm_mat[i][j] = phy_struct->rmc_sb_mat[i][IC_PERM_CC[j]];
-            }
-        }
-
-        // Step 5: Read out the bits
-        for(j=0; j<C_cc_sb; j++)
+        for(i=0; i<24; i++)
         {
-            for(i=0; i<R_cc_sb; i++)
-            {
-                phy_struct->rmc_w[w_idx++] = phy_struct->rmc_sb_perm_mat[i][j];
-            }
+            out_bits[i] = a_bits[i];
         }
+        *N_out_bits = 24;
+        err         = LIBLTE_SUCCESS;
     }
-    K_pi = R_cc_sb*C_cc_sb;
-
-    // Bit collection, selection, and transmission
-    // Create circular buffer
-    K_w = 3*K_pi;
-    k   = 0;
-    j   = 0;
-    while(k < N_e_bits)
+    if(ber_1 == 0)
     {
-        if(phy_struct->rmc_w[j%K_w] != TX_NULL_BIT)
-        {
-            e_bits[k++] = phy_struct->rmc_w[j%K_w];
-        }
-        j++;
+        *N_ant = 1;
+    }else if(ber_2 == 0){
+        *N_ant = 2;
+    }else if(ber_4 == 0){
+        *N_ant = 4;
     }
+
+    return(err);
 }
 
 /*********************************************************************
-    Name: rate_unmatch_conv
+    Name: dlsch_channel_encode
 
-    Description: Rate unmatches convolutionally encoded data
+    Description: Channel encodes the Downlink Shared Channel
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.2
 *********************************************************************/
-void rate_unmatch_conv(LIBLTE_PHY_STRUCT *phy_struct,
-                       float             *e_bits,
-                       uint32             N_e_bits,
-                       uint32             N_c_bits,
-                       float             *d_bits,
-                       uint32            *N_d_bits)
+void dlsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                          uint8             *in_bits,
+                          uint32             N_in_bits,
+                          uint32             tbs,
+                          uint32             tx_mode,
+                          uint32             rv_idx,
+                          uint32             G,
+                          uint32             N_l,
+                          uint32             Q_m,
+                          uint32             M_dl_harq,
+                          uint32             N_soft,
+                          uint8             *out_bits,
+                          uint32            *N_out_bits)
 {
-    uint32 C_cc_sb = 32; // Step 1: Assign C_cc_sb to 32
-    uint32 R_cc_sb;
-    uint32 w_idx = 0;
-    uint32 d_idx;
-    uint32 N_dummy;
-    uint32 idx;
-    uint32 K_pi;
-    uint32 K_w;
-    uint32 i;
-    uint32 j;
-    uint32 k;
-    uint32 x;
+    uint32  cb;
+    uint32  N_codeblocks;
+    uint32  N_fill_bits;
+    uint32  N_d_bits;
+    uint32  N_f_bits;
+    uint32  G_prime;
+    uint32  lambda;
+    uint64  p_word;
+    uint8  *a_bits;
 
-    // In order to undo bit collection, selection, and transmission
-    // a dummy block must be sub-block interleaved to determine
-    // where NULL bits are to be inserted
-    // Sub-block interleaving
-    // Step 2: Determine the number of rows
-    R_cc_sb = 0;
-    while(N_c_bits > (C_cc_sb*R_cc_sb))
-    {
-        R_cc_sb++;
-    }
+    // Define a_bits
+    a_bits = in_bits;
 
-    // Steps 3, 4, and 5
-    for(x=0; x<3; x++)
+    // Pad input up to tbs size, calculate p_bits, and construct b_bits
+    memset(phy_struct->dl_scratch->dlsch_b_words, 0, sizeof(uint64)*((tbs+24+63)/64));
+    pack_bits(a_bits, N_in_bits, phy_struct->dl_scratch->dlsch_b_words);
+    p_word = (uint64)calc_crc_packed(phy_struct->dl_scratch->dlsch_b_words, tbs, CRC24A, 24) << 40;
+    copy_bits(&p_word, 0, 24, phy_struct->dl_scratch->dlsch_b_words, tbs);
+
+    // Construct c_bits
+    code_block_segmentation_packed(phy_struct->dl_scratch->dlsch_b_words,
+                                   tbs+24,
+                                   &N_codeblocks,
+                                   &N_fill_bits,
+                                   phy_struct->dl_scratch->dlsch_c_words[0],
+                                   96,
+                                   phy_struct->dl_scratch->dlsch_N_c_bits);
+
+    N_f_bits = 0;
+    for(cb=0; cb<N_codeblocks; cb++)
     {
-        // Step 3: Pack data into matrix and pad with dummy
-        if(N_c_bits < (C_cc_sb*R_cc_sb))
+        // Construct d_bits
+        turbo_encode_packed(phy_struct,
+                            phy_struct->dl_scratch->dlsch_c_words[cb],
+                            phy_struct->dl_scratch->dlsch_N_c_bits[cb],
+                            phy_struct->dl_scratch->dlsch_d_words[0],
+                            97,
+                            &N_d_bits);
+
+        // Determine e_bits and N_e_bits, concatenating the code blocks
+        // into f_bits as they are rate matched
+        G_prime = G/(N_l*Q_m);
+        lambda  = G_prime % N_codeblocks;
+        if(cb <= (N_codeblocks - lambda - 1))
         {
-            N_dummy = C_cc_sb*R_cc_sb - N_c_bits;
+            phy_struct->dl_scratch->dlsch_N_e_bits[cb] = N_l*Q_m*(G_prime/N_codeblocks);
         }else{
-            N_dummy = 0;
-        }
-        for(i=0; i<N_dummy; i++)
-        {
-            phy_struct->ruc_tmp[i] = RX_NULL_BIT;
-        }
-        for(i=N_dummy; i<C_cc_sb*R_cc_sb; i++)
-        {
-            phy_struct->ruc_tmp[i] = 0;
-        }
-        idx = 0;
-        for(i=0; i<R_cc_sb; i++)
-        {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->ruc_sb_mat[i][j] = phy_struct->ruc_tmp[idx++];
-            }
-        }
+            phy_struct->dl_scratch->dlsch_N_e_bits[cb] = N_l*Q_m*(uint32)ceilf((float)G_prime/(float)N_codeblocks);
+        }
+        rate_match_turbo_packed(phy_struct,
+                                phy_struct->dl_scratch->dlsch_d_words[0],
+                                97,
+                                N_d_bits,
+                                (0 == cb) ? N_fill_bits : 0,
+                                N_codeblocks,
+                                tx_mode,
+                                N_soft,
+                                M_dl_harq,
+                                LIBLTE_PHY_CHAN_TYPE_DLSCH,
+                                rv_idx,
+                                phy_struct->dl_scratch->dlsch_N_e_bits[cb],
+                                phy_struct->dl_scratch->dlsch_f_words,
+                                N_f_bits);
+        N_f_bits += phy_struct->dl_scratch->dlsch_N_e_bits[cb];
+    }
 
-        // Step 4: Inter-column permutation
-        for(i=0; i<R_cc_sb; i++)
-        {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->ruc_sb_perm_mat[i][j] = phy_struct->ruc_sb_mat[i][IC_PERM_CC[j]];
-            }
-        }
+    unpack_bits(phy_struct->dl_scratch->dlsch_f_words, N_f_bits, out_bits);
+    *N_out_bits = N_f_bits;
+}
 
-        // Step 5: Read out the bits
-        for(j=0; j<C_cc_sb; j++)
-        {
-            for(i=0; i<R_cc_sb; i++)
-            {
-                phy_struct->ruc_w_dum[w_idx] = phy_struct->ruc_sb_perm_mat[i][j];
-                phy_struct->ruc_w[w_idx]     = RX_NULL_BIT;
-                w_idx++;
-            }
-        }
-    }
+/*********************************************************************
+    Name: dlsch_channel_decode
+
+    Description: Channel decodes the Downlink Shared Channel
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.2
+*********************************************************************/
+LIBLTE_ERROR_ENUM dlsch_channel_decode(LIBLTE_PHY_STRUCT             *phy_struct,
+                                       float                         *in_bits,
+                                       uint32                         N_in_bits,
+                                       uint32                         tbs,
+                                       uint32                         tx_mode,
+                                       uint32                         rv_idx,
+                                       uint32                         N_l,
+                                       uint32                         Q_m,
+                                       uint32                         M_dl_harq,
+                                       uint32                         N_soft,
+                                       LIBLTE_PHY_HARQ_BUFFER_STRUCT *harq,
+                                       uint8                         *out_bits,
+                                       uint32                        *N_out_bits)
+{
+    LIBLTE_PHY_CB_JOB_STRUCT *job;
+    LIBLTE_ERROR_ENUM         err = LIBLTE_ERROR_INVALID_CRC;
+    LIBLTE_ERROR_ENUM         cb_err;
+    uint32                    i;
+    uint32                    cb;
+    uint32                    ber;
+    uint32                    N_b_bits;
+    uint32                    N_fill_bits;
+    uint32                    N_codeblocks;
+    uint32                    crc;
+    uint8                     calc_p_bits[24];
+    uint8                    *a_bits;
+    uint8                    *p_bits;
+
+    // Determine the code block sizes and filler bits
+    N_b_bits = tbs+24;
+    memset(phy_struct->dl_scratch->dlsch_b_bits, 0, sizeof(uint8)*N_b_bits);
+    code_block_segmentation(phy_struct->dl_scratch->dlsch_b_bits,
+                            N_b_bits,
+                            &N_codeblocks,
+                            &N_fill_bits,
+                            phy_struct->dl_scratch->dlsch_c_bits[0],
+                            6144,
+                            phy_struct->dl_scratch->dlsch_N_c_bits);
 
-    // Undo bit collection, selection, and transmission by
-    // recreating the circular buffer
-    K_pi = R_cc_sb*C_cc_sb;
-    K_w  = 3*K_pi;
-    k    = 0;
-    j    = 0;
-    while(k < N_e_bits)
+    // Determine e_bits
+    code_block_deconcatenation(in_bits,
+                               N_in_bits,
+                               N_codeblocks,
+                               N_l,
+                               Q_m,
+                               phy_struct->dl_scratch->dlsch_rx_e_bits,
+                               phy_struct->dl_scratch->dlsch_N_e_bits);
+
+    // A different transport block starts with empty soft buffers
+    if(NULL != harq &&
+       (tbs          != harq->tbs ||
+        N_codeblocks != harq->N_codeblocks))
     {
-        if(phy_struct->ruc_w_dum[j%K_w] != RX_NULL_BIT)
+        for(cb=0; cb<N_codeblocks; cb++)
         {
-            // Soft combine the inputs
-            if(phy_struct->ruc_w[j%K_w] == RX_NULL_BIT)
-            {
-                phy_struct->ruc_w[j%K_w] = e_bits[k];
-            }else if(e_bits[k] != RX_NULL_BIT){
-                phy_struct->ruc_w[j%K_w] += e_bits[k];
-            }
-            k++;
+            memset(harq->soft_bits[cb], 0, sizeof(int16)*3*(phy_struct->dl_scratch->dlsch_N_c_bits[cb]+4));
         }
-        j++;
+        harq->tbs          = tbs;
+        harq->N_codeblocks = N_codeblocks;
     }
 
-    // Recreate the sub-block interleaver output
-    for(i=0; i<K_pi; i++)
+    // Determine c_bits, each code block is decoded independently
+    if(1 == N_codeblocks)
     {
-        phy_struct->ruc_v[0][i] = phy_struct->ruc_w[i];
-        phy_struct->ruc_v[1][i] = phy_struct->ruc_w[i+K_pi];
-        phy_struct->ruc_v[2][i] = phy_struct->ruc_w[i+2*K_pi];
+        crc = CRC24A;
+    }else{
+        crc = CRC24B;
     }
-
-    // Sub-block deinterleaving
-    // Steps 5, 4, and 3
-    for(x=0; x<3; x++)
+    for(cb=0; cb<N_codeblocks; cb++)
     {
-        // Step 5: Load the permuted matrix
-        idx = 0;
-        for(j=0; j<C_cc_sb; j++)
-        {
-            for(i=0; i<R_cc_sb; i++)
-            {
-                phy_struct->ruc_sb_perm_mat[i][j] = phy_struct->ruc_v[x][idx++];
-            }
+        job               = &phy_struct->cb_job[cb];
+        job->chan_type    = LIBLTE_PHY_CHAN_TYPE_DLSCH;
+        job->e_bits       = phy_struct->dl_scratch->dlsch_rx_e_bits[cb];
+        job->N_e_bits     = phy_struct->dl_scratch->dlsch_N_e_bits[cb];
+        job->N_fill_bits  = (0 == cb) ? N_fill_bits : 0;
+        job->N_codeblocks = N_codeblocks;
+        job->tx_mode      = tx_mode;
+        job->N_soft       = N_soft;
+        job->M_dl_harq    = M_dl_harq;
+        job->rv_idx       = rv_idx;
+        job->crc          = crc;
+        job->N_c_bits     = &phy_struct->dl_scratch->dlsch_N_c_bits[cb];
+        job->c_bits       = phy_struct->dl_scratch->dlsch_c_bits[cb];
+        if(NULL != harq)
+        {
+            job->harq_bits = harq->soft_bits[cb];
+        }else{
+            job->harq_bits = NULL;
         }
+    }
+    code_block_decode_all(phy_struct, N_codeblocks);
 
-        // Step 4: Undo permutation
-        for(i=0; i<R_cc_sb; i++)
-        {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->ruc_sb_mat[i][IC_PERM_CC[j]] = phy_struct->ruc_sb_perm_mat[i][j];
-            }
-        }
+    // Determine b_bits
+    cb_err = code_block_desegmentation(phy_struct->dl_scratch->dlsch_c_bits[0],
+                                       phy_struct->dl_scratch->dlsch_N_c_bits,
+                                       6144,
+                                       tbs,
+                                       phy_struct->dl_scratch->dlsch_b_bits,
+                                       N_b_bits);
 
-        // Step 3: Unpack the data and remove dummy
-        if(N_c_bits < (C_cc_sb*R_cc_sb))
-        {
-            N_dummy = C_cc_sb*R_cc_sb - N_c_bits;
-        }else{
-            N_dummy = 0;
-        }
-        idx = 0;
-        for(i=0; i<R_cc_sb; i++)
+    // Recover a_bits and p_bits
+    a_bits = &phy_struct->dl_scratch->dlsch_b_bits[0];
+    p_bits = &phy_struct->dl_scratch->dlsch_b_bits[tbs];
+
+    // Calculate p_bits
+    calc_crc(a_bits, tbs, CRC24A, calc_p_bits, 24);
+
+    // Check CRC
+    ber = 0;
+    for(i=0; i<24; i++)
+    {
+        ber += p_bits[i] ^ calc_p_bits[i];
+    }
+    if(LIBLTE_SUCCESS == cb_err &&
+       0              == ber)
+    {
+        for(i=0; i<tbs; i++)
         {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->ruc_tmp[idx++] = phy_struct->ruc_sb_mat[i][j];
-            }
+            out_bits[i] = a_bits[i];
         }
-        d_idx = 0;
-        for(i=N_dummy; i<C_cc_sb*R_cc_sb; i++)
+        *N_out_bits = tbs;
+        err         = LIBLTE_SUCCESS;
+
+        // The transport block is done with its soft buffer
+        if(NULL != harq)
         {
-            d_bits[d_idx*3+x] = phy_struct->ruc_tmp[i];
-            d_idx++;
+            harq->tbs = 0;
         }
     }
-    *N_d_bits = d_idx*3;
+
+    return(err);
 }
 
 /*********************************************************************
-    Name: code_block_concatenation
+    Name: dci_channel_encode
 
-    Description: Performs code block concatenation for turbo coded
-                 channels
+    Description: Channel encodes the Downlink Control Information
+                 channel
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.5
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3
 *********************************************************************/
-void code_block_concatenation(uint8  *e_bits,
-                              uint32 *N_e_bits,
-                              uint32  N_e_bits_max,
-                              uint32  N_codeblocks,
-                              uint8  *f_bits,
-                              uint32 *N_f_bits)
+void dci_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                        uint8             *in_bits,
+                        uint32             N_in_bits,
+                        uint16             rnti,
+                        uint8              ue_ant,
+                        uint32             N_out_bits,
+                        uint8             *out_bits)
 {
-    uint32 j = 0;
-    uint32 k = 0;
-    uint32 r = 0;
+    uint32 i;
+    uint32 N_d_bits;
+    uint32 g[3] = {0133, 0171, 0165}; // Numbers are in octal
+    uint8  x_rnti_bits[16];
+    uint8  x_as_bits[16];
+    uint8  p_bits[16];
 
-    // Concatenate code blocks
-    while(r < N_codeblocks)
+    // Convert RNTI to bit array
+    for(i=0; i<16; i++)
     {
-        j = 0;
-        while(j < N_e_bits[r])
-        {
-            f_bits[k++] = e_bits[r*N_e_bits_max+j];
-            j++;
-        }
-        r++;
+        x_rnti_bits[i] = (rnti >> (15-i)) & 1;
     }
-    *N_f_bits = k;
+
+    // Construct UE antenna mask
+    memset(x_as_bits, 0, sizeof(uint8)*16);
+    if(ue_ant == 1)
+    {
+        x_as_bits[15] = 1;
+    }
+
+    // Calculate p_bits
+    calc_crc(in_bits, N_in_bits, CRC16, p_bits, 16);
+
+    // Mask p_bits
+    for(i=0; i<16; i++)
+    {
+        p_bits[i] ^= x_rnti_bits[i] ^ x_as_bits[i];
+    }
+
+    // Construct c_bits
+    for(i=0; i<N_in_bits; i++)
+    {
+        phy_struct->dci_c_bits[i] = in_bits[i];
+    }
+    for(i=0; i<16; i++)
+    {
+        phy_struct->dci_c_bits[N_in_bits+i] = p_bits[i];
+    }
+
+    // Determine d_bits
+    conv_encode(phy_struct,
+                phy_struct->dci_c_bits,
+                N_in_bits+16,
+                7,
+                3,
+                g,
+                true,
+                phy_struct->dci_tx_d_bits,
+                &N_d_bits);
+
+    // Determine e_bits
+    rate_match_conv(phy_struct, phy_struct->dci_tx_d_bits, N_d_bits, N_out_bits, out_bits);
 }
 
 /*********************************************************************
-    Name: code_block_deconcatenation
+    Name: dci_channel_decode
 
-    Description: Performs code block deconcatenation for turbo coded
-                 channels
+    Description: Channel decodes the Downlink Control Information
+                 channel
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.5
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3
 *********************************************************************/
-void code_block_deconcatenation(float  *f_bits,
-                                uint32  N_f_bits,
-                                uint32  tbs,
-                                float  *e_bits,
-                                uint32 *N_e_bits,
-                                uint32  N_e_bits_max,
-                                uint32 *N_codeblocks)
-{
-    uint32 Z = 6144;
-    uint32 L;
-    uint32 B;
-    uint32 C;
-    uint32 F;
-    uint32 B_prime;
-    uint32 K_plus  = 0;
-    uint32 K_minus = 0;
-    uint32 K_delta;
-    uint32 C_plus;
-    uint32 C_minus;
-    uint32 j;
-    uint32 k;
-    uint32 r;
-    int32  i;
+LIBLTE_ERROR_ENUM dci_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                                     float             *in_bits,
+                                     uint32             N_in_bits,
+                                     uint16             rnti_start,
+                                     uint16             rnti_range,
+                                     uint8              ue_ant,
+                                     uint8             *out_bits,
+                                     uint32             N_out_bits,
+                                     uint16            *rnti_found)
+{
+    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_CRC;
+    uint32             i;
+    uint32             j;
+    uint32             N_d_bits;
+    uint32             N_c_bits;
+    uint32             ber;
+    uint16             rnti;
+    uint8              x_rnti_bits[16];
+    uint8              x_as_bits[16];
+    uint8             *a_bits;
+    uint8             *p_bits;
+    uint8              calc_p_bits[16];
 
-    // Determine L, C, B', K+, C+, K-, and C-, 3GPP TS 36.212 v10.1.0 section 5.1.2
-    if(tbs <= Z)
+    // Construct UE antenna mask
+    memset(x_as_bits, 0, sizeof(uint8)*16);
+    if(ue_ant == 1)
     {
-        L       = 0;
-        C       = 1;
-        B_prime = N_f_bits;
-        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
-        {
-            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
-            {
-                K_plus = TURBO_INT_K_TABLE[i];
-                break;
-            }
-        }
-        K_minus = 0;
-        C_plus  = 1;
-        C_minus = 0;
-    }else{
-        B       = tbs + 24;
-        L       = 24;
-        C       = (uint32)ceilf((float)B/(float)(Z-L));
-        B_prime = B + C*L;
-        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
-        {
-            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
-            {
-                K_plus = TURBO_INT_K_TABLE[i];
-                break;
-            }
-        }
-        for(i=TURBO_INT_K_TABLE_SIZE-1; i>=0; i--)
-        {
-            if(TURBO_INT_K_TABLE[i] < K_plus)
-            {
-                K_minus = TURBO_INT_K_TABLE[i];
-                break;
-            }
-        }
-        K_delta = K_plus - K_minus;
-        C_minus = (C*K_plus - B_prime)/K_delta;
-        C_plus  = C - C_minus;
+        x_as_bits[15] = 1;
     }
-    F             = C_plus*K_plus + C_minus*K_minus - B_prime;
-    *N_codeblocks = C;
 
-    // Deconcatenate code blocks
-    k = 0;
-    r = 0;
-    while(r < C)
+    // Rate unmatch to get the d_bits
+    rate_unmatch_conv(phy_struct,
+                      in_bits,
+                      N_in_bits,
+                      N_out_bits+16,
+                      phy_struct->dci_rx_d_bits,
+                      &N_d_bits);
+
+    // Viterbi decode the d_bits to get the c_bits
+    viterbi_decode(phy_struct,
+                   phy_struct->dci_rx_d_bits,
+                   N_d_bits,
+                   phy_struct->dci_c_bits,
+                   &N_c_bits);
+
+    // Recover a_bits and p_bits
+    a_bits = &phy_struct->dci_c_bits[0];
+    p_bits = &phy_struct->dci_c_bits[N_out_bits];
+
+    // Calculate p_bits
+    calc_crc(a_bits, N_out_bits, CRC16, calc_p_bits, 16);
+
+    for(j=0; j<rnti_range; j++)
     {
-        // Determine the K for this code block
-        if(r < C_minus)
-        {
-            N_e_bits[r] = K_minus;
-        }else{
-            N_e_bits[r] = K_plus;
-        }
-        if(C > 1)
+        // Convert RNTI to bit array
+        for(i=0; i<16; i++)
         {
-            N_e_bits[r] += L;
+            rnti           = rnti_start + j;
+            x_rnti_bits[i] = (rnti >> (15-i)) & 1;
         }
-        // FIXME: Not handling filler bits currently
-        N_e_bits[r] -= F;
 
-        j = 0;
-        while(j < N_e_bits[r])
+        // Check CRC
+        ber = 0;
+        for(i=0; i<16; i++)
         {
-            e_bits[r*N_e_bits_max+j] = f_bits[k++];
-            j++;
+            ber += p_bits[i] ^ (calc_p_bits[i] ^ x_rnti_bits[i] ^ x_as_bits[i]);
         }
-        r++;
-    }
-}
-
-/*********************************************************************
-    Name: ulsch_data_control_multiplexing
-
-    Description: Multiplexes the control and data bits for Uplink
-                 Shared Channel
-
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.7
-*********************************************************************/
-void ulsch_data_control_multiplexing(uint8  *f_bits,
-                                     uint32  N_f_bits,
-                                     uint8  *cqi_bits,
-                                     uint32  N_cqi_bits,
-                                     uint32  N_l,
-                                     uint32  Q_m,
-                                     uint8  *g_bits,
-                                     uint32 *N_g_bits)
-{
-    uint32 i = 0;
-    uint32 j = 0;
-    uint32 k = 0;
-    uint32 n;
-
-    while(j < N_cqi_bits)
-    {
-        for(n=0; n<N_l*Q_m; n++)
+        if(ber == 0)
         {
-            g_bits[k*N_l*Q_m + n] = cqi_bits[j+n];
+            for(i=0; i<N_out_bits; i++)
+            {
+                out_bits[i] = a_bits[i];
+            }
+            err = LIBLTE_SUCCESS;
         }
-        j += N_l*Q_m;
-        k++;
-    }
-    while(i < N_f_bits)
-    {
-        for(n=0; n<N_l*Q_m; n++)
+        if(LIBLTE_SUCCESS == err)
         {
-            g_bits[k*N_l*Q_m + n] = f_bits[i+n];
+            *rnti_found = rnti;
+            break;
         }
-        i += N_l*Q_m;
-        k++;
     }
-    *N_g_bits = k;
+
+    return(err);
 }
 
 /*********************************************************************
-    Name: ulsch_data_control_demultiplexing
+    Name: dci_0_pack
 
-    Description: Demultiplexes the control and data bits for Uplink
-                 Shared Channel
+    Description: Packs all of the fields into the Downlink Control
+                 Information format 0
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.7
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.1
+                        3GPP TS 36.213 v10.3.0 section 8.1.1
+                        3GPP TS 36.213 v10.3.0 section 8.6
+
+    Notes: Currently only handles non-hopping single-cluster
+           assignments
 *********************************************************************/
-void ulsch_data_control_demultiplexing(float  *g_bits,
-                                       uint32  N_g_bits,
-                                       uint32  N_cqi_bits,
-                                       uint32  N_l,
-                                       uint32  Q_m,
-                                       float  *f_bits,
-                                       uint32 *N_f_bits,
-                                       float  *cqi_bits)
+void dci_0_pack(LIBLTE_PHY_ALLOCATION_STRUCT    *alloc,
+                LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
+                uint32                           N_rb_ul,
+                uint8                            N_ant,
+                uint8                           *out_bits,
+                uint32                          *N_out_bits)
 {
-    uint32 i = 0;
-    uint32 j = 0;
-    uint32 k = 0;
-    uint32 n;
+    uint32  RIV;
+    uint32  RIV_length;
+    uint32  size;
+    uint8  *dci = out_bits;
 
-    while(j < N_cqi_bits)
-    {
-        for(n=0; n<N_l*Q_m; n++)
-        {
-            cqi_bits[j + n] = g_bits[k*Q_m*N_l + n];
-        }
-        j += N_l*Q_m;
-        k++;
-    }
-    *N_f_bits = N_g_bits - N_cqi_bits;
-    while(i < *N_f_bits)
+    // Carrier indicator
+    if(LIBLTE_PHY_DCI_CA_PRESENT == ca_presence)
     {
-        for(n=0; n<N_l*Q_m; n++)
-        {
-            f_bits[i + n] = g_bits[k*Q_m*N_l + n];
-        }
-        i += N_l*Q_m;
-        k++;
+        printf("WARNING: Not handling carrier indicator\n");
+        liblte_value_2_bits(0, &dci, 3);
     }
-}
 
-/*********************************************************************
-    Name: ulsch_channel_interleaver
+    // Format 0/1A flag is set to format 0
+    liblte_value_2_bits(DCI_0_1A_FLAG_0, &dci, 1);
 
-    Description: Interleaves Uplink Shared Channel data with RI and
-                 ACK control information
+    // Frequency hopping flag
+    liblte_value_2_bits(0, &dci, 1);
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.8
-*********************************************************************/
-void ulsch_channel_interleaver(LIBLTE_PHY_STRUCT *phy_struct,
-                               uint8             *g_bits,
-                               uint32             N_g_bits,
-                               uint8             *ri_bits,
-                               uint32             N_ri_bits,
-                               uint8             *ack_bits,
-                               uint32             N_ack_bits,
-                               uint32             N_l,
-                               uint32             Q_m,
-                               uint8             *h_bits,
-                               uint32            *N_h_bits)
-{
-    uint32 C_mux;
-    uint32 H_prime;
-    uint32 H_prime_total;
-    uint32 R_mux;
-    uint32 R_prime_mux;
-    uint32 i;
-    uint32 j;
-    uint32 k;
-    uint32 r;
-    uint32 idx;
-    uint32 ri_column_set[4]  = {1, 4, 7, 10};
-    uint32 ack_column_set[4] = {2, 3, 8, 9};
-    uint32 C_ri;
-    uint32 C_ack;
-    uint32 N_pusch_symbs = 12; // FIXME: Only handling normal CP
+    // RBA
+    // FIXME: Only supporting non-hopping single-cluster
+    RIV_length = (uint32)ceilf(logf(N_rb_ul*(N_rb_ul+1)/2)/logf(2));
+    if((alloc->N_prb-1) <= (N_rb_ul/2))
+    {
+        RIV = N_rb_ul*(alloc->N_prb-1) + alloc->prb[0][0];
+    }else{
+        RIV = N_rb_ul*(N_rb_ul - alloc->N_prb + 1) + (N_rb_ul - 1 - alloc->prb[0][0]);
+    }
+    liblte_value_2_bits(RIV, &dci, RIV_length);
 
-    // Step 1: Define C_mux
-    C_mux = N_pusch_symbs;
+    // Modulation and coding scheme and redundancy version
+    liblte_value_2_bits(alloc->mcs, &dci, 5);
 
-    // Step 2: Define R_mux and R_prime_mux
-    H_prime       = N_g_bits;
-    H_prime_total = H_prime + N_ri_bits;
-    R_mux         = (H_prime_total*Q_m*N_l)/C_mux;
-    R_prime_mux   = R_mux/(Q_m*N_l);
+    // New data indicator
+    liblte_value_2_bits(alloc->ndi, &dci, 1);
 
-    // Initialize the matricies
-    for(i=0; i<C_mux*R_prime_mux; i++)
-    {
-        phy_struct->ulsch_y_idx[i] = TX_NULL_SYMB;
-    }
-    for(i=0; i<C_mux*R_mux; i++)
-    {
-        phy_struct->ulsch_y_mat[i] = 0;
-    }
+    // TPC command
+    liblte_value_2_bits(alloc->tpc, &dci, 2);
 
-    // Step 3: Interleave the RI control bits
-    i = 0;
-    j = 0;
-    r = R_prime_mux-1;
-    while(i < N_ri_bits)
-    {
-        C_ri                                    = ri_column_set[j];
-        phy_struct->ulsch_y_idx[r*C_mux + C_ri] = 1;
-        for(k=0; k<Q_m*N_l; k++)
-        {
-            phy_struct->ulsch_y_mat[(C_mux*r*Q_m*N_l) + C_ri*Q_m*N_l + k] = ri_bits[i+k];
-        }
-        i++;
-        r = R_prime_mux - 1 - i/4;
-        j = (j + 3) % 4;
-    }
+    // Cyclic shift
+    liblte_value_2_bits(0, &dci, 3);
 
-    // Step 4: Interleave the data bits
-    i = 0;
-    k = 0;
-    while(k < H_prime)
-    {
-        if(phy_struct->ulsch_y_idx[i] == TX_NULL_SYMB)
-        {
-            phy_struct->ulsch_y_idx[i] = 1;
-            for(j=0; j<Q_m*N_l; j++)
-            {
-                phy_struct->ulsch_y_mat[i*Q_m*N_l + j] = g_bits[k+j];
-            }
-            k++;
-        }
-        i++;
-    }
+    // CSI request
+    liblte_value_2_bits(0, &dci, 1);
 
-    // Step 5: Interleave the ACK control bits
-    i = 0;
-    j = 0;
-    r = R_prime_mux-1;
-    while(i < N_ack_bits)
-    {
-        C_ack                                    = ack_column_set[j];
-        phy_struct->ulsch_y_idx[r*C_mux + C_ack] = 2;
-        for(k=0; k<Q_m*N_l; k++)
-        {
-            phy_struct->ulsch_y_mat[(C_mux*r*Q_m*N_l) + C_ack*Q_m*N_l + k] = ack_bits[i+k];
-        }
-        i++;
-        r = R_prime_mux - 1 - i/4;
-        j = (j + 3) % 4;
-    }
+    // Pad bit
+    liblte_value_2_bits(0, &dci, 1);
 
-    // Step 6: Read out the bits
-    idx = 0;
-    for(i=0; i<C_mux; i++)
+    // Pad if needed
+    size = dci - out_bits;
+    if(size == 12 ||
+       size == 14 ||
+       size == 16 ||
+       size == 20 ||
+       size == 24 ||
+       size == 26 ||
+       size == 32 ||
+       size == 40 ||
+       size == 44 ||
+       size == 56)
     {
-        for(j=0; j<R_prime_mux; j++)
-        {
-            for(k=0; k<Q_m*N_l; k++)
-            {
-                h_bits[idx++] = phy_struct->ulsch_y_mat[j*C_mux*Q_m*N_l + i*Q_m*N_l + k];
-            }
-        }
+        size++;
+        liblte_value_2_bits(0, &dci, 1);
     }
-    *N_h_bits = idx;
+    *N_out_bits = size;
 }
 
 /*********************************************************************
-    Name: ulsch_channel_deinterleaver
+    Name: dci_0_unpack
 
-    Description: Deinterleaves Uplink Shared Channel data from RI and
-                 ACK control information
+    Description: Unpacks all of the fields from the Downlink Control
+                 Information format 0
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.8
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.1
+                        3GPP TS 36.213 v10.3.0 section 8.1.1
+                        3GPP TS 36.213 v10.3.0 section 8.6
+
+    Notes: N/A
 *********************************************************************/
-void ulsch_channel_deinterleaver(LIBLTE_PHY_STRUCT *phy_struct,
-                                 float             *h_bits,
-                                 uint32             N_h_bits,
-                                 uint32             N_ri_bits,
-                                 uint32             N_ack_bits,
-                                 uint32             N_l,
-                                 uint32             Q_m,
-                                 float             *g_bits,
-                                 uint32            *N_g_bits,
-                                 float             *ri_bits,
-                                 float             *ack_bits)
-{
-    uint32 C_mux;
-    uint32 H_prime;
-    uint32 H_prime_total;
-    uint32 R_mux;
-    uint32 R_prime_mux;
-    uint32 i;
-    uint32 j;
-    uint32 k;
-    uint32 r;
-    uint32 idx;
-    uint32 ri_column_set[4]  = {1, 4, 7, 10};
-    uint32 ack_column_set[4] = {2, 3, 8, 9};
-    uint32 C_ri;
-    uint32 C_ack;
-    uint32 N_pusch_symbs = 12; // FIXME: Only handling normal CP
+// FIXME
 
-    // Step 1: Define C_mux
-    C_mux = N_pusch_symbs;
+/*********************************************************************
+    Name: dci_1a_pack
 
-    // Step 2: Define R_mux and R_prime_mux
-    H_prime       = N_h_bits/(Q_m*N_l);
-    H_prime_total = H_prime + N_ri_bits;
-    R_mux         = (H_prime_total*Q_m*N_l)/C_mux;
-    R_prime_mux   = R_mux/(Q_m*N_l);
+    Description: Packs all of the fields into the Downlink Control
+                 Information format 1A
 
-    // Initialize the matricies
-    for(i=0; i<C_mux*R_prime_mux; i++)
-    {
-        phy_struct->ulsch_y_idx[i] = RX_NULL_SYMB;
-    }
-    for(i=0; i<C_mux*R_mux; i++)
-    {
-        phy_struct->ulsch_y_mat[i] = 0;
-    }
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.3
+                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
+                        3GPP TS 36.213 v10.3.0 section 7.1.7
 
-    // Step 6: Construct matrix
-    idx = 0;
-    for(i=0; i<C_mux; i++)
-    {
-        for(j=0; j<R_prime_mux; j++)
-        {
-            for(k=0; k<Q_m*N_l; k++)
-            {
-                phy_struct->ulsch_y_mat[j*C_mux*Q_m*N_l + i*Q_m*N_l + k] = h_bits[idx++];
-            }
-        }
-    }
+    Notes: Currently only handles localized virtual resource blocks
+*********************************************************************/
+void dci_1a_pack(LIBLTE_PHY_ALLOCATION_STRUCT    *alloc,
+                 LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
+                 uint32                           N_rb_dl,
+                 uint8                            N_ant,
+                 uint8                           *out_bits,
+                 uint32                          *N_out_bits)
+{
+    uint32  RIV;
+    uint32  RIV_length;
+    uint32  size;
+    uint32  N_prb_1a;
+    uint8  *dci = out_bits;
 
-    // Step 5: Deinterleave the ACK control bits
-    i = 0;
-    j = 0;
-    r = R_prime_mux-1;
-    while(i < N_ack_bits)
+    // Carrier indicator
+    if(LIBLTE_PHY_DCI_CA_PRESENT == ca_presence)
     {
-        C_ack                                    = ack_column_set[j];
-        phy_struct->ulsch_y_idx[r*C_mux + C_ack] = 2;
-        for(k=0; k<Q_m*N_l; k++)
-        {
-            ack_bits[i+k] = phy_struct->ulsch_y_mat[C_mux*r*Q_m*N_l + C_ack*Q_m*N_l + k];
-        }
-        i++;
-        r = R_prime_mux - 1 - i/4;
-        j = (j + 3) % 4;
+        printf("WARNING: Not handling carrier indicator\n");
+        liblte_value_2_bits(0, &dci, 3);
     }
 
-    // Step 3: Deinterleave the RI control bits
-    i = 0;
-    j = 0;
-    r = R_prime_mux-1;
-    while(i < N_ri_bits)
+    // Format 0/1A flag is set to format 1A
+    liblte_value_2_bits(DCI_0_1A_FLAG_1A, &dci, 1);
+
+    if(LIBLTE_MAC_SI_RNTI        == alloc->rnti ||
+       LIBLTE_MAC_P_RNTI         == alloc->rnti ||
+       (LIBLTE_MAC_RA_RNTI_START <= alloc->rnti &&
+        LIBLTE_MAC_RA_RNTI_END   >= alloc->rnti))
     {
-        C_ri                                    = ri_column_set[j];
-        phy_struct->ulsch_y_idx[r*C_mux + C_ri] = 1;
-        for(k=0; k<Q_m*N_l; k++)
+        // FIXME: Only supporting localized VRBs
+        liblte_value_2_bits(DCI_VRB_TYPE_LOCALIZED, &dci, 1);
+        RIV_length = (uint32)ceilf(logf(N_rb_dl*(N_rb_dl+1)/2)/logf(2));
+        if((alloc->N_prb-1) <= (N_rb_dl/2))
         {
-            ri_bits[i*Q_m*N_l + k] = phy_struct->ulsch_y_mat[C_mux*r*Q_m*N_l + C_ri*Q_m*N_l + k];
+            RIV = N_rb_dl*(alloc->N_prb-1) + alloc->prb[0][0];
+        }else{
+            RIV = N_rb_dl*(N_rb_dl-alloc->N_prb+1) + (N_rb_dl - 1 - alloc->prb[0][0]);
         }
-        i++;
-        r = R_prime_mux - 1 - i/4;
-        j = (j + 3) % 4;
-    }
+        liblte_value_2_bits(RIV, &dci, RIV_length);
 
-    // Step 4: Interleave the data bits
-    i = 0;
-    k = 0;
-    while(k < H_prime)
-    {
-        if(phy_struct->ulsch_y_idx[i] == RX_NULL_SYMB)
+        // Modulation and coding scheme
+        liblte_value_2_bits(alloc->mcs, &dci, 5);
+
+        // HARQ process number, FIXME: FDD only
+        liblte_value_2_bits(0, &dci, 3);
+
+        // New data indicator
+        liblte_value_2_bits(0, &dci, 1);
+
+        // Redundancy version
+        liblte_value_2_bits(alloc->rv_idx, &dci, 2);
+
+        // TPC
+        N_prb_1a = 3;
+        liblte_value_2_bits(1, &dci, 2);
+
+        // Calculate the TBS
+        alloc->tbs = TBS_71721[alloc->mcs][N_prb_1a-1];
+    }else{
+        // FIXME: Only supporting localized VRBs
+        liblte_value_2_bits(DCI_VRB_TYPE_LOCALIZED, &dci, 1);
+        RIV_length = (uint32)ceilf(logf(N_rb_dl*(N_rb_dl+1)/2)/logf(2));
+        if((alloc->N_prb-1) <= (N_rb_dl/2))
         {
-            phy_struct->ulsch_y_idx[i] = 1;
-            for(j=0; j<Q_m*N_l; j++)
-            {
-                g_bits[k*Q_m*N_l + j] = phy_struct->ulsch_y_mat[i*Q_m*N_l + j];
-            }
-            k++;
-        }else if(phy_struct->ulsch_y_idx[i] == 2){
-            for(j=0; j<Q_m*N_l; j++)
-            {
-                g_bits[k*Q_m*N_l + j] = RX_NULL_SYMB;
-            }
-            k++;
+            RIV = N_rb_dl*(alloc->N_prb-1) + alloc->prb[0][0];
+        }else{
+            RIV = N_rb_dl*(N_rb_dl - alloc->N_prb + 1) + (N_rb_dl - 1 - alloc->prb[0][0]);
         }
-        i++;
-    }
-    *N_g_bits = k*Q_m*N_l;
-}
+        liblte_value_2_bits(RIV, &dci, RIV_length);
 
-/*********************************************************************
-    Name: ulsch_channel_encode
+        // Modulation and coding scheme
+        liblte_value_2_bits(alloc->mcs, &dci, 5);
 
-    Description: Channel encodes the Uplink Shared Channel
+        // HARQ process number, FIXME: FDD only
+        liblte_value_2_bits(0, &dci, 3);
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2
+        // New data indicator
+        liblte_value_2_bits(alloc->ndi, &dci, 1);
 
-    Notes: Not handling control bits
-*********************************************************************/
-void ulsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                          uint8             *in_bits,
-                          uint32             N_in_bits,
-                          uint32             tbs,
-                          uint32             tx_mode,
-                          uint32             G,
-                          uint32             N_l,
-                          uint32             Q_m,
-                          uint32             rv_idx,
-                          uint8             *out_bits,
-                          uint32            *N_out_bits)
-{
-    uint32  i;
-    uint32  cb;
-    uint32  N_codeblocks;
-    uint32  N_fill_bits;
-    uint32  N_d_bits;
-    uint32  N_f_bits;
-    uint32  N_g_bits;
-    uint32  N_ri_bits  = 0;
-    uint32  N_ack_bits = 0;
-    uint32  N_cqi_bits = 0;
-    uint32  G_prime;
-    uint32  lambda;
-    uint8   p_bits[24];
-    uint8  *a_bits;
+        // Redundancy version
+        liblte_value_2_bits(alloc->rv_idx, &dci, 2);
 
-    // Define a_bits
-    a_bits = in_bits;
+        // TPC
+        liblte_value_2_bits(alloc->tpc, &dci, 2);
 
-    // Pad input up to tbs size, calculate p_bits, and construct b_bits
-    for(i=0; i<N_in_bits; i++)
-    {
-        phy_struct->ulsch_b_bits[i] = a_bits[i];
-    }
-    for(i=N_in_bits; i<tbs; i++)
-    {
-        phy_struct->ulsch_b_bits[i] = 0;
-    }
-    calc_crc(phy_struct->ulsch_b_bits, tbs, CRC24A, p_bits, 24);
-    for(i=0; i<24; i++)
-    {
-        phy_struct->ulsch_b_bits[tbs+i] = p_bits[i];
+        // Calculate the TBS
+        alloc->tbs = TBS_71721[alloc->mcs][alloc->N_prb-1];
     }
 
-    // Construct c_bits
-    code_block_segmentation(phy_struct->ulsch_b_bits,
-                            tbs+24,
-                            &N_codeblocks,
-                            &N_fill_bits,
-                            phy_struct->ulsch_c_bits[0],
-                            6144,
-                            phy_struct->ulsch_N_c_bits);
-
-    for(cb=0; cb<N_codeblocks; cb++)
+    // Pad if needed
+    size = dci - out_bits;
+    if(size == 12 ||
+       size == 14 ||
+       size == 16 ||
+       size == 20 ||
+       size == 24 ||
+       size == 26 ||
+       size == 32 ||
+       size == 40 ||
+       size == 44 ||
+       size == 56)
     {
-        // Construct d_bits
-        turbo_encode(phy_struct,
-                     phy_struct->ulsch_c_bits[cb],
-                     phy_struct->ulsch_N_c_bits[cb],
-                     N_fill_bits,
-                     phy_struct->ulsch_tx_d_bits,
-                     &N_d_bits);
-
-        // Determine e_bits and N_e_bits
-        G_prime = G/(N_l*Q_m);
-        lambda  = G_prime % N_codeblocks;
-        if(cb <= (N_codeblocks - lambda - 1))
-        {
-            phy_struct->ulsch_N_e_bits[cb] = N_l*Q_m*(G_prime/N_codeblocks);
-        }else{
-            phy_struct->ulsch_N_e_bits[cb] = N_l*Q_m*(uint32)ceilf((float)G_prime/(float)N_codeblocks);
-        }
-        rate_match_turbo(phy_struct,
-                         phy_struct->ulsch_tx_d_bits,
-                         N_d_bits,
-                         N_codeblocks,
-                         tx_mode,
-                         1,
-                         1,
-                         LIBLTE_PHY_CHAN_TYPE_ULSCH,
-                         rv_idx,
-                         phy_struct->ulsch_N_e_bits[cb],
-                         phy_struct->ulsch_tx_e_bits[0]);
+        size++;
+        liblte_value_2_bits(0, &dci, 1);
     }
-
-    // Determine f_bits
-    code_block_concatenation(phy_struct->ulsch_tx_e_bits[0],
-                             phy_struct->ulsch_N_e_bits,
-                             18432,
-                             N_codeblocks,
-                             phy_struct->ulsch_tx_f_bits,
-                             &N_f_bits);
-
-    // Determine g_bits
-    ulsch_data_control_multiplexing(phy_struct->ulsch_tx_f_bits,
-                                    N_f_bits,
-                                    NULL,
-                                    N_cqi_bits,
-                                    N_l,
-                                    Q_m,
-                                    phy_struct->ulsch_tx_g_bits,
-                                    &N_g_bits);
-
-    // Determine output
-    ulsch_channel_interleaver(phy_struct,
-                              phy_struct->ulsch_tx_g_bits,
-                              N_g_bits,
-                              NULL,
-                              N_ri_bits,
-                              NULL,
-                              N_ack_bits,
-                              N_l,
-                              Q_m,
-                              out_bits,
-                              N_out_bits);
+    *N_out_bits = size;
 }
 
 /*********************************************************************
-    Name: ulsch_channel_decode
+    Name: dci_1a_unpack
 
-    Description: Channel decodes the Uplink Shared Channel
+    Description: Unpacks all of the fields from the Downlink Control
+                 Information format 1A
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.3
+                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
+                        3GPP TS 36.213 v10.3.0 section 7.1.7
 
-    Notes: Not handling control bits
+    Notes: Currently only handles SI-RNTI, P-RNTI, or RA-RNTI and
+           localized virtual resource blocks
 *********************************************************************/
-LIBLTE_ERROR_ENUM ulsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                       float             *in_bits,
-                                       uint32             N_in_bits,
-                                       uint32             tbs,
-                                       uint32             tx_mode,
-                                       uint32             N_l,
-                                       uint32             Q_m,
-                                       uint32             rv_idx,
-                                       uint8             *out_bits,
-                                       uint32            *N_out_bits)
+LIBLTE_ERROR_ENUM dci_1a_unpack(uint8                           *in_bits,
+                                uint32                           N_in_bits,
+                                LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
+                                uint16                           rnti,
+                                uint32                           N_rb_dl,
+                                uint8                            N_ant,
+                                LIBLTE_PHY_ALLOCATION_STRUCT    *alloc)
 {
-    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_CRC;
+    LIBLTE_ERROR_ENUM  err      = LIBLTE_SUCCESS;
+    uint32             RB_start = 0;
+    uint32             RIV;
+    uint32             RIV_length;
     uint32             i;
-    uint32             cb;
-    uint32             ber;
-    uint32             N_b_bits;
-    uint32             N_d_bits;
-    uint32             N_f_bits;
-    uint32             N_g_bits;
-    uint32             N_ri_bits  = 0;
-    uint32             N_ack_bits = 0;
-    uint32             N_cqi_bits = 0;
-    uint32             N_fill_bits;
-    uint32             N_codeblocks;
-    uint8              calc_p_bits[24];
-    uint8             *a_bits;
-    uint8             *p_bits;
-
-    // In order to decode an ULSCH message, the NULL bit pattern must be
-    // determined by encoding a sequence of zeros
-    N_b_bits = tbs+24;
-    memset(phy_struct->ulsch_b_bits, 0, sizeof(uint8)*N_b_bits);
-    code_block_segmentation(phy_struct->ulsch_b_bits,
-                            N_b_bits,
-                            &N_codeblocks,
-                            &N_fill_bits,
-                            phy_struct->ulsch_c_bits[0],
-                            6144,
-                            phy_struct->ulsch_N_c_bits);
-
-    // Determine g_bits
-    ulsch_channel_deinterleaver(phy_struct,
-                                in_bits,
-                                N_in_bits,
-                                N_ri_bits,
-                                N_ack_bits,
-                                N_l,
-                                Q_m,
-                                phy_struct->ulsch_rx_g_bits,
-                                &N_g_bits,
-                                NULL,
-                                NULL);
-
-    // Determine f_bits
-    ulsch_data_control_demultiplexing(phy_struct->ulsch_rx_g_bits,
-                                      N_g_bits,
-                                      N_cqi_bits,
-                                      N_l,
-                                      Q_m,
-                                      phy_struct->ulsch_rx_f_bits,
-                                      &N_f_bits,
-                                      NULL);
+    uint32             j;
+    uint32             ca_ind;
+    uint32             N_prb_1a;
+    uint32             tpc;
+    uint32             dci_0_1a_flag;
+    uint32             loc_or_dist;
+    uint32             harq_process;
+    uint32             new_data_ind;
+    uint8             *dci = in_bits;
 
-    // Determine e_bits
-    code_block_deconcatenation(phy_struct->ulsch_rx_f_bits,
-                               N_f_bits,
-                               tbs,
-                               phy_struct->ulsch_rx_e_bits[0],
-                               phy_struct->ulsch_N_e_bits,
-                               18432,
-                               &N_codeblocks);
+    // Carrier indicator
+    if(LIBLTE_PHY_DCI_CA_PRESENT == ca_presence)
+    {
+        ca_ind = liblte_bits_2_value(&dci, 3);
+        printf("WARNING: Not handling carrier indicator\n");
+    }
 
-    for(cb=0; cb<N_codeblocks; cb++)
+    // Check DCI 0/1A flag 3GPP TS 36.212 v10.1.0 section 5.3.3.1.3
+    dci_0_1a_flag = liblte_bits_2_value(&dci, 1);
+    if(DCI_0_1A_FLAG_0 == dci_0_1a_flag)
     {
-        // Construct dummy_d_bits
-        turbo_encode(phy_struct,
-                     phy_struct->ulsch_c_bits[cb],
-                     phy_struct->ulsch_N_c_bits[cb],
-                     N_fill_bits,
-                     phy_struct->ulsch_tx_d_bits,
-                     &N_d_bits);
-
-        // Determine d_bits
-        rate_unmatch_turbo(phy_struct,
-                           phy_struct->ulsch_rx_e_bits[cb],
-                           phy_struct->ulsch_N_e_bits[cb],
-                           phy_struct->ulsch_tx_d_bits,
-                           N_d_bits/3,
-                           N_codeblocks,
-                           tx_mode,
-                           1,
-                           1,
-                           LIBLTE_PHY_CHAN_TYPE_ULSCH,
-                           rv_idx,
-                           phy_struct->ulsch_rx_d_bits,
-                           &N_d_bits);
-
-        // Determine c_bits
-        turbo_decode(phy_struct,
-                     phy_struct->ulsch_rx_d_bits,
-                     N_d_bits,
-                     N_fill_bits,
-                     phy_struct->ulsch_c_bits[cb],
-                     &phy_struct->ulsch_N_c_bits[cb]);
+        printf("ERROR: DCI 1A flagged as DCI 0\n");
+        return(LIBLTE_ERROR_INVALID_CONTENTS);
     }
 
-    // Determine b_bits
-    code_block_desegmentation(phy_struct->ulsch_c_bits[0],
-                              phy_struct->ulsch_N_c_bits,
-                              6144,
-                              tbs,
-                              phy_struct->ulsch_b_bits,
-                              N_b_bits);
+    if(LIBLTE_MAC_SI_RNTI        == rnti ||
+       LIBLTE_MAC_P_RNTI         == rnti ||
+       (LIBLTE_MAC_RA_RNTI_START <= rnti &&
+        LIBLTE_MAC_RA_RNTI_END   >= rnti))
+    {
+        // Determine if RIV uses local or distributed VRBs
+        loc_or_dist = liblte_bits_2_value(&dci, 1);
 
-    // Recover a_bits and p_bits
-    a_bits = &phy_struct->ulsch_b_bits[0];
-    p_bits = &phy_struct->ulsch_b_bits[tbs];
+        // Find the RIV that was sent 3GPP TS 36.213 v10.3.0 section 7.1.6.3
+        RIV_length   = (uint32)ceilf(logf(N_rb_dl*(N_rb_dl+1)/2)/logf(2));
+        RIV          = liblte_bits_2_value(&dci, RIV_length);
+        alloc->N_prb = RIV/N_rb_dl + 1;
+        RB_start     = RIV % N_rb_dl;
+        if((alloc->N_prb + RB_start) > N_rb_dl)
+        {
+            // Allocations longer than N_rb_dl/2 + 1 are sent mirrored
+            alloc->N_prb = N_rb_dl - alloc->N_prb + 2;
+            RB_start     = N_rb_dl - 1 - RB_start;
+        }
 
-    // Calculate p_bits
-    calc_crc(a_bits, tbs, CRC24A, calc_p_bits, 24);
+        // Extract the rest of the fields
+        alloc->mcs    = liblte_bits_2_value(&dci, 5);
+        harq_process  = liblte_bits_2_value(&dci, 3);
+        new_data_ind  = liblte_bits_2_value(&dci, 1);
+        alloc->rv_idx = liblte_bits_2_value(&dci, 2);
+        tpc           = liblte_bits_2_value(&dci, 2);
 
-    // Check CRC
-    ber = 0;
-    for(i=0; i<24; i++)
-    {
-        ber += p_bits[i] ^ calc_p_bits[i];
-    }
-    if(ber == 0)
-    {
-        for(i=0; i<tbs; i++)
+        // Parse the data
+        if((tpc % 2) == 0)
         {
-            out_bits[i] = a_bits[i];
+            N_prb_1a = 2;
+        }else{
+            N_prb_1a = 3;
         }
-        *N_out_bits = tbs;
-        err         = LIBLTE_SUCCESS;
+        if(DCI_VRB_TYPE_DISTRIBUTED == loc_or_dist)
+        {
+            // FIXME: Figure out gapping
+            // FIXME: Convert to localized blocks
+        }else{
+            // Convert allocation into array of prbs
+            for(i=0; i<alloc->N_prb; i++)
+            {
+                alloc->prb[0][i] = RB_start + i;
+                alloc->prb[1][i] = RB_start + i;
+            }
+        }
+
+        // Fill in the allocation structure 3GPP TS 36.213 v10.3.0 section 7.1.7
+        alloc->mod_type       = LIBLTE_PHY_MODULATION_TYPE_QPSK;
+        alloc->pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
+        if(N_ant == 1)
+        {
+            alloc->tx_mode = 1;
+        }else{
+            alloc->tx_mode = 2;
+        }
+        alloc->N_codewords = 1;
+        if(9 >= alloc->mcs)
+        {
+            alloc->tbs = TBS_71721[alloc->mcs][N_prb_1a-1];
+        }else if(16 >= alloc->mcs){
+            alloc->tbs = TBS_71721[alloc->mcs-1][N_prb_1a-1];
+        }else if(28 >= alloc->mcs){
+            alloc->tbs = TBS_71721[alloc->mcs-2][N_prb_1a-1];
+        }else{
+            err = LIBLTE_ERROR_INVALID_CONTENTS;
+        }
+        alloc->rnti = rnti;
+    }else{
+        printf("ERROR: Not handling DCI 1As for C-RNTI\n");
     }
 
     return(err);
 }
 
 /*********************************************************************
-    Name: bch_channel_encode
+    Name: dci_1c_pack
 
-    Description: Channel encodes the broadcast channel
+    Description: Packs all of the fields into the Downlink Control
+                 Information format 1C
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.1
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.4
+                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
+                        3GPP TS 36.213 v10.3.0 section 7.1.7
 *********************************************************************/
-void bch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                        uint8             *in_bits,
-                        uint32             N_in_bits,
-                        uint8              N_ant,
-                        uint8             *out_bits,
-                        uint32            *N_out_bits)
+// FIXME
+
+/*********************************************************************
+    Name: dci_1c_unpack
+
+    Description: Unpacks all of the fields from the Downlink Control
+                 Information format 1C
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.4
+                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
+                        3GPP TS 36.213 v10.3.0 section 7.1.7
+
+    Notes: Currently only handling SI-RNTI, P-RNTI, and RA-RNTI
+*********************************************************************/
+void dci_1c_unpack(uint8                        *in_bits,
+                   uint32                        N_in_bits,
+                   uint16                        rnti,
+                   uint32                        N_rb_dl,
+                   uint8                         N_ant,
+                   LIBLTE_PHY_ALLOCATION_STRUCT *alloc)
 {
+    uint32  RB_start = 0;
+    uint32  RIV;
+    uint32  RIV_length;
     uint32  i;
-    uint32  g[3] = {0133, 0171, 0165}; // Numbers are in octal
-    uint32  N_d_bits;
-    uint8  *ant_mask = NULL;
-    uint8  *a_bits   = NULL;
-    uint8   p_bits[16];
-    uint8   ant_mask_1[16] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
-    uint8   ant_mask_2[16] = {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1};
-    uint8   ant_mask_4[16] = {0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1};
+    uint32  idash;
+    uint32  j;
+    uint32  jdash;
+    uint32  gap_ind;
+    uint32  N_gap;
+    uint32  N_vrb_gap1_dl;
+    uint32  N_vrb_gap2_dl;
+    uint32  N_vrb_dl;
+    uint32  Ndash_vrb_dl;
+    uint32  N_rb_step;
+    uint32  Ntilde_vrb_dl;
+    uint32  P;
+    uint32  N_row;
+    uint32  N_col;
+    uint32  N_null;
+    uint32  n_vrb;
+    uint32  ntilde_vrb;
+    uint32  ntildedash_prb;
+    uint32  ntildedashdash_prb;
+    uint32  ntilde_prb_even;
+    uint32  ntilde_prb_odd;
+    uint32  n_prb_even;
+    uint32  n_prb_odd;
+    uint8  *dci = in_bits;
 
-    if(N_ant == 1)
+    if(N_rb_dl < 50)
     {
-        ant_mask = ant_mask_1;
-    }else if(N_ant == 2){
-        ant_mask = ant_mask_2;
+        gap_ind = 0;
     }else{
-        ant_mask = ant_mask_4;
+        gap_ind = liblte_bits_2_value(&dci, 1);
     }
 
-    // Define a_bits
-    a_bits = in_bits;
-
-    // Calculate p_bits
-    calc_crc(a_bits, 24, CRC16, p_bits, 16);
-
-    // Mask p_bits
-    for(i=0; i<16; i++)
+    if(N_rb_dl <= 10)
     {
-        p_bits[i] = p_bits[i] ^ ant_mask[i];
+        N_gap = (uint32)ceilf(N_rb_dl/2.0);
+    }else if(N_rb_dl == 11){
+        N_gap = 4;
+    }else if(N_rb_dl <= 19){
+        N_gap = 8;
+    }else if(N_rb_dl <= 26){
+        N_gap = 12;
+    }else if(N_rb_dl <= 44){
+        N_gap = 18;
+    }else if(N_rb_dl <= 49){
+        N_gap = 27;
+    }else if(N_rb_dl <= 63){
+        N_gap = (gap_ind == 0) ? 27 : 9;
+    }else if(N_rb_dl <= 70){
+        N_gap = (gap_ind == 0) ? 32 : 16;
+    }else{
+        N_gap = (gap_ind == 0) ? 48 : 16;
     }
 
-    // Construct c_bits
-    for(i=0; i<24; i++)
-    {
-        phy_struct->bch_c_bits[i] = a_bits[i];
-    }
-    for(i=0; i<16; i++)
+    if(N_gap < (N_rb_dl-N_gap))
     {
-        phy_struct->bch_c_bits[24+i] = p_bits[i];
+        N_vrb_gap1_dl = 2 * N_gap;
+    }else{
+        N_vrb_gap1_dl = 2 * (N_rb_dl-N_gap);
     }
 
-    // Determine d_bits
-    conv_encode(phy_struct,
-                phy_struct->bch_c_bits,
-                40,
-                7,
-                3,
-                g,
-                true,
-                phy_struct->bch_tx_d_bits,
-                &N_d_bits);
-
-    // Determine e_bits
-    rate_match_conv(phy_struct, phy_struct->bch_tx_d_bits, N_d_bits, 1920, out_bits);
-    *N_out_bits = 1920;
-}
-
-/*********************************************************************
-    Name: bch_channel_decode
-
-    Description: Channel decodes the broadcast channel
-
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.1
-*********************************************************************/
-LIBLTE_ERROR_ENUM bch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                     float             *in_bits,
-                                     uint32             N_in_bits,
-                                     uint8             *N_ant,
-                                     uint8             *out_bits,
-                                     uint32            *N_out_bits)
-{
-    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_CRC;
-    uint32             ber_1;
-    uint32             ber_2;
-    uint32             ber_4;
-    uint32             N_d_bits;
-    uint32             N_c_bits;
-    uint32             i;
-    uint32             g[3] = {0133, 0171, 0165}; // Numbers are in octal
-    uint8             *a_bits;
-    uint8             *p_bits;
-    uint8              calc_p_bits[16];
-    uint8              ant_mask_1[16] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
-    uint8              ant_mask_2[16] = {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1};
-    uint8              ant_mask_4[16] = {0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1};
-
-    // Rate unmatch to get the d_bits
-    rate_unmatch_conv(phy_struct,
-                      in_bits,
-                      N_in_bits,
-                      40,
-                      phy_struct->bch_rx_d_bits,
-                      &N_d_bits);
-
-    // Viterbi decode the d_bits to get the c_bits
-    viterbi_decode(phy_struct,
-                   phy_struct->bch_rx_d_bits,
-                   N_d_bits,
-                   7,
-                   3,
-                   g,
-                   phy_struct->bch_c_bits,
-                   &N_c_bits);
-
-    // Recover a_bits and p_bits
-    a_bits = &phy_struct->bch_c_bits[0];
-    p_bits = &phy_struct->bch_c_bits[24];
-
-    // Calculate p_bits
-    calc_crc(a_bits, 24, CRC16, calc_p_bits, 16);
+    N_vrb_gap2_dl = (N_rb_dl/(2*N_gap)) * 2 * N_gap;
 
-    // Try all p_bit masks
-    ber_1 = 0;
-    ber_2 = 0;
-    ber_4 = 0;
-    for(i=0; i<16; i++)
+    if(gap_ind == 0)
     {
-        ber_1 += p_bits[i] ^ (calc_p_bits[i] ^ ant_mask_1[i]);
-        ber_2 += p_bits[i] ^ (calc_p_bits[i] ^ ant_mask_2[i]);
-        ber_4 += p_bits[i] ^ (calc_p_bits[i] ^ ant_mask_4[i]);
+        N_vrb_dl = N_vrb_gap1_dl;
+    }else{
+        N_vrb_dl = N_vrb_gap2_dl;
     }
 
-    if(ber_1 == 0 || ber_2 == 0 || ber_4 == 0)
+    if(N_rb_dl <= 49)
     {
-        for(i=0; i<24; i++)
-        {
-            out_bits[i] = a_bits[i];
-        }
-        *N_out_bits = 24;
-        err         = LIBLTE_SUCCESS;
+        N_rb_step = 2;
+    }else{
+        N_rb_step = 4;
     }
-    if(ber_1 == 0)
+
+    Ntilde_vrb_dl = (gap_ind == 0) ? N_vrb_dl : 2*N_gap;
+
+    if(LIBLTE_MAC_SI_RNTI        == rnti ||
+       LIBLTE_MAC_P_RNTI         == rnti ||
+       (LIBLTE_MAC_RA_RNTI_START <= rnti &&
+        LIBLTE_MAC_RA_RNTI_END   >= rnti))
     {
-        *N_ant = 1;
-    }else if(ber_2 == 0){
-        *N_ant = 2;
-    }else if(ber_4 == 0){
-        *N_ant = 4;
-    }
+        RIV_length = ceilf(logf((N_vrb_gap1_dl/N_rb_step) * ((N_vrb_gap1_dl/N_rb_step)+1) / 2.0)/logf(2));
+        RIV        = liblte_bits_2_value(&dci, RIV_length);
 
-    return(err);
-}
+        for(i=N_rb_step; i<=(N_vrb_dl/N_rb_step)*N_rb_step; i+=N_rb_step) // L_crb running variable N_rb_step to floor(N_vrb_dl/N_rb_step)*N_rb_step
+        {
+            for(j=0; j<=((N_vrb_dl/N_rb_step)-1)*N_rb_step; j+=N_rb_step) // RB_start running variable 0 to (floor(N_vrb_dl/N_rb_step)-1)*N_rb_step
+            {
+                idash        = i/N_rb_step;
+                jdash        = j/N_rb_step;
+                Ndash_vrb_dl = N_vrb_dl/N_rb_step;
 
-/*********************************************************************
-    Name: dlsch_channel_encode
+                if((idash-1) <= (Ndash_vrb_dl/2))
+                {
+                    if(RIV == (Ndash_vrb_dl*(idash-1)+jdash)) // RB_start to RB_start+alloc->N_prb gives n_vrb(i).  These are then mapped to PRBs as below
+                    {
+                        alloc->N_prb = i;
+                        RB_start     = j;
+                    }
+                }else{
+                    if(RIV == (Ndash_vrb_dl*(Ndash_vrb_dl-idash+1)+(Ndash_vrb_dl-1-jdash)))
+                    {
+                        alloc->N_prb = i;
+                        RB_start     = j;
+                    }
+                }
+            }
+        }
+        // Extract the rest of the fields
+        alloc->mcs = liblte_bits_2_value(&dci, 5);
 
-    Description: Channel encodes the Downlink Shared Channel
+        // Convert allocation into array of PRBs
+        // Calculate Resource Block Group size (P)
+        if(N_rb_dl <= 10)
+        {
+            P = 1;
+        }else if(N_rb_dl <= 26){
+            P = 2;
+        }else if(N_rb_dl <= 63){
+            P = 3;
+        }else{
+            P = 4;
+        }
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.2
-*********************************************************************/
-void dlsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                          uint8             *in_bits,
-                          uint32             N_in_bits,
-                          uint32             tbs,
-                          uint32             tx_mode,
-                          uint32             rv_idx,
-                          uint32             G,
-                          uint32             N_l,
-                          uint32             Q_m,
-                          uint32             M_dl_harq,
-                          uint32             N_soft,
-                          uint8             *out_bits,
-                          uint32            *N_out_bits)
-{
-    uint32  i;
-    uint32  cb;
-    uint32  N_codeblocks;
-    uint32  N_fill_bits;
-    uint32  N_d_bits;
-    uint32  G_prime;
-    uint32  lambda;
-    uint8   p_bits[24];
-    uint8  *a_bits;
+        N_col  = 4;
+        N_row  = ceilf(Ntilde_vrb_dl/(4.0*P)) * P;
+        N_null = 4*N_row - Ntilde_vrb_dl;
+        n_vrb  = RB_start;
 
-    // Define a_bits
-    a_bits = in_bits;
+        // 3GPP TS 36.211 v10.6.0 section 6.2.3.2
+        for(i=0; i<alloc->N_prb; i++)
+        {
+            ntilde_vrb         = n_vrb % Ntilde_vrb_dl;
+            ntildedash_prb     = 2*N_row*(ntilde_vrb % 2) + (ntilde_vrb/2) + Ntilde_vrb_dl*(n_vrb/Ntilde_vrb_dl);
+            ntildedashdash_prb = N_row*(ntilde_vrb % 4) + (ntilde_vrb/4) + Ntilde_vrb_dl*(n_vrb/Ntilde_vrb_dl);
+            // even slot
+            if((N_null != 0) && (ntilde_vrb >= (Ntilde_vrb_dl-N_null)) && (ntilde_vrb%2 == 1))
+            {
+                ntilde_prb_even = ntildedash_prb - N_row;
+            }else if((N_null != 0) && (ntilde_vrb >= (Ntilde_vrb_dl-N_null)) && (ntilde_vrb%2 == 0)){
+                ntilde_prb_even = ntildedash_prb - N_row + N_null/2;
+            }else if((N_null != 0) && (ntilde_vrb < (Ntilde_vrb_dl-N_null)) && (ntilde_vrb%4 >= 2)){
+                ntilde_prb_even = ntildedashdash_prb - N_null/2;
+            }else{
+                ntilde_prb_even = ntildedashdash_prb;
+            }
+            // odd slot
+            ntilde_prb_odd = (ntilde_prb_even + Ntilde_vrb_dl/2)%Ntilde_vrb_dl + Ntilde_vrb_dl * (n_vrb/Ntilde_vrb_dl);
 
-    // Pad input up to tbs size, calculate p_bits, and construct b_bits
-    for(i=0; i<N_in_bits; i++)
-    {
-        phy_struct->dlsch_b_bits[i] = a_bits[i];
-    }
-    for(i=N_in_bits; i<tbs; i++)
-    {
-        phy_struct->dlsch_b_bits[i] = 0;
-    }
-    calc_crc(phy_struct->dlsch_b_bits, tbs, CRC24A, p_bits, 24);
-    for(i=0; i<24; i++)
-    {
-        phy_struct->dlsch_b_bits[tbs+i] = p_bits[i];
-    }
+            // even slot
+            if(ntilde_prb_even < Ntilde_vrb_dl/2)
+            {
+                n_prb_even = ntilde_prb_even;
+            }else{
+                n_prb_even = ntilde_prb_even + N_gap - Ntilde_vrb_dl/2;
+            }
 
-    // Construct c_bits
-    code_block_segmentation(phy_struct->dlsch_b_bits,
-                            tbs+24,
-                            &N_codeblocks,
-                            &N_fill_bits,
-                            phy_struct->dlsch_c_bits[0],
-                            6144,
-                            phy_struct->dlsch_N_c_bits);
+            // odd slot
+            if(ntilde_prb_odd < Ntilde_vrb_dl/2)
+            {
+                n_prb_odd = ntilde_prb_odd;
+            }else{
+                n_prb_odd = ntilde_prb_odd + N_gap - Ntilde_vrb_dl/2;
+            }
 
-    for(cb=0; cb<N_codeblocks; cb++)
-    {
-        // Construct d_bits
-        turbo_encode(phy_struct,
-                     phy_struct->dlsch_c_bits[cb],
-                     phy_struct->dlsch_N_c_bits[cb],
-                     N_fill_bits,
-                     phy_struct->dlsch_tx_d_bits,
-                     &N_d_bits);
-
-        // Determine e_bits and N_e_bits
-        G_prime = G/(N_l*Q_m);
-        lambda  = G_prime % N_codeblocks;
-        if(cb <= (N_codeblocks - lambda - 1))
+            alloc->prb[0][i] = n_prb_even;
+            alloc->prb[1][i] = n_prb_odd;
+            n_vrb++;
+        }
+
+        // Fill in the allocation structure 3GPP TS 36.213 v10.3.0 section 7.1.7
+        alloc->mod_type       = LIBLTE_PHY_MODULATION_TYPE_QPSK;
+        alloc->pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
+        if(N_ant == 1)
         {
-            phy_struct->dlsch_N_e_bits[cb] = N_l*Q_m*(G_prime/N_codeblocks);
+            alloc->tx_mode = 1;
         }else{
-            phy_struct->dlsch_N_e_bits[cb] = N_l*Q_m*(uint32)ceilf((float)G_prime/(float)N_codeblocks);
+            alloc->tx_mode = 2;
         }
-        rate_match_turbo(phy_struct,
-                         phy_struct->dlsch_tx_d_bits,
-                         N_d_bits,
-                         N_codeblocks,
-                         tx_mode,
-                         N_soft,
-                         M_dl_harq,
-                         LIBLTE_PHY_CHAN_TYPE_DLSCH,
-                         rv_idx,
-                         phy_struct->dlsch_N_e_bits[cb],
-                         phy_struct->dlsch_tx_e_bits[0]);
+        alloc->N_codewords = 1;
+        alloc->tbs         = TBS_71723[alloc->mcs];
+        alloc->rnti        = rnti;
+    }else{
+        printf("ERROR: Not handling DCI 1Cs for C-RNTI\n");
     }
-
-    code_block_concatenation(phy_struct->dlsch_tx_e_bits[0],
-                             phy_struct->dlsch_N_e_bits,
-                             18432,
-                             N_codeblocks,
-                             out_bits,
-                             N_out_bits);
 }
 
 /*********************************************************************
-    Name: dlsch_channel_decode
+    Name: cfi_channel_encode
 
-    Description: Channel decodes the Downlink Shared Channel
+    Description: Channel encodes the Control Format Indicator channel
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.4
 *********************************************************************/
-LIBLTE_ERROR_ENUM dlsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                       float             *in_bits,
-                                       uint32             N_in_bits,
-                                       uint32             tbs,
-                                       uint32             tx_mode,
-                                       uint32             rv_idx,
-                                       uint32             M_dl_harq,
-                                       uint32             N_soft,
-                                       uint8             *out_bits,
-                                       uint32            *N_out_bits)
+void cfi_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                        uint32             cfi,
+                        uint8             *out_bits,
+                        uint32            *N_out_bits)
 {
-    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_CRC;
-    uint32             i;
-    uint32             cb;
-    uint32             ber;
-    uint32             N_b_bits;
-    uint32             N_d_bits;
-    uint32             N_fill_bits;
-    uint32             N_codeblocks;
-    uint8              calc_p_bits[24];
-    uint8             *a_bits;
-    uint8             *p_bits;
-
-    // In order to decode a DLSCH message, the NULL bit pattern must be
-    // determined by encoding a sequence of zeros
-    N_b_bits = tbs+24;
-    memset(phy_struct->dlsch_b_bits, 0, sizeof(uint8)*N_b_bits);
-    code_block_segmentation(phy_struct->dlsch_b_bits,
-                            N_b_bits,
-                            &N_codeblocks,
-                            &N_fill_bits,
-                            phy_struct->dlsch_c_bits[0],
-                            6144,
-                            phy_struct->dlsch_N_c_bits);
-
-    // Determine e_bits
-    code_block_deconcatenation(in_bits,
-                               N_in_bits,
-                               tbs,
-                               phy_struct->dlsch_rx_e_bits[0],
-                               phy_struct->dlsch_N_e_bits,
-                               18432,
-                               &N_codeblocks);
-
-    for(cb=0; cb<N_codeblocks; cb++)
-    {
-        // Construct dummy_d_bits
-        turbo_encode(phy_struct,
-                     phy_struct->dlsch_c_bits[cb],
-                     phy_struct->dlsch_N_c_bits[cb],
-                     N_fill_bits,
-                     phy_struct->dlsch_tx_d_bits,
-                     &N_d_bits);
-
-        // Determine d_bits
-        rate_unmatch_turbo(phy_struct,
-                           phy_struct->dlsch_rx_e_bits[cb],
-                           phy_struct->dlsch_N_e_bits[cb],
-                           phy_struct->dlsch_tx_d_bits,
-                           N_d_bits/3,
-                           N_codeblocks,
-                           tx_mode,
-                           N_soft,
-                           M_dl_harq,
-                           LIBLTE_PHY_CHAN_TYPE_DLSCH,
-                           rv_idx,
-                           phy_struct->dlsch_rx_d_bits,
-                           &N_d_bits);
-
-        // Determine c_bits
-        turbo_decode(phy_struct,
-                     phy_struct->dlsch_rx_d_bits,
-                     N_d_bits,
-                     N_fill_bits,
-                     phy_struct->dlsch_c_bits[cb],
-                     &phy_struct->dlsch_N_c_bits[cb]);
-    }
-
-    // Determine b_bits
-    code_block_desegmentation(phy_struct->dlsch_c_bits[0],
-                              phy_struct->dlsch_N_c_bits,
-                              6144,
-                              tbs,
-                              phy_struct->dlsch_b_bits,
-                              N_b_bits);
-
-    // Recover a_bits and p_bits
-    a_bits = &phy_struct->dlsch_b_bits[0];
-    p_bits = &phy_struct->dlsch_b_bits[tbs];
-
-    // Calculate p_bits
-    calc_crc(a_bits, tbs, CRC24A, calc_p_bits, 24);
+    uint32  i;
+    uint8  *cfi_bits;
 
-    // Check CRC
-    ber = 0;
-    for(i=0; i<24; i++)
+    *N_out_bits = 32;
+    if(1 == cfi)
     {
-        ber += p_bits[i] ^ calc_p_bits[i];
+        cfi_bits = CFI_BITS_1;
+    }else if(2 == cfi){
+        cfi_bits = CFI_BITS_2;
+    }else if(3 == cfi){
+        cfi_bits = CFI_BITS_3;
+    }else{
+        cfi_bits = CFI_BITS_4;
     }
-    if(ber == 0)
+    for(i=0; i<*N_out_bits; i++)
     {
-        for(i=0; i<tbs; i++)
-        {
-            out_bits[i] = a_bits[i];
-        }
-        *N_out_bits = tbs;
-        err         = LIBLTE_SUCCESS;
+        out_bits[i] = cfi_bits[i];
     }
-
-    return(err);
 }
 
 /*********************************************************************
-    Name: dci_channel_encode
+    Name: cfi_channel_decode
 
-    Description: Channel encodes the Downlink Control Information
-                 channel
+    Description: Channel decodes the Control Format Indicator channel
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.4
 *********************************************************************/
-void dci_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                        uint8             *in_bits,
-                        uint32             N_in_bits,
-                        uint16             rnti,
-                        uint8              ue_ant,
-                        uint32             N_out_bits,
-                        uint8             *out_bits)
+LIBLTE_ERROR_ENUM cfi_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                                     float             *in_bits,
+                                     uint32             N_in_bits,
+                                     uint32            *cfi)
 {
-    uint32 i;
-    uint32 N_d_bits;
-    uint32 g[3] = {0133, 0171, 0165}; // Numbers are in octal
-    uint8  x_rnti_bits[16];
-    uint8  x_as_bits[16];
-    uint8  p_bits[16];
-
-    // Convert RNTI to bit array
-    for(i=0; i<16; i++)
-    {
-        x_rnti_bits[i] = (rnti >> (15-i)) & 1;
-    }
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_CRC;
+    uint32            i;
+    uint32            ber[4] = {0,0,0,0};
+    uint32            min_ber;
+    uint32            cfi_num;
+    uint8             in_bit;
 
-    // Construct UE antenna mask
-    memset(x_as_bits, 0, sizeof(uint8)*16);
-    if(ue_ant == 1)
+    // Calculate the number of bit errors for each CFI
+    for(i=0; i<N_in_bits; i++)
     {
-        x_as_bits[15] = 1;
-    }
-
-    // Calculate p_bits
-    calc_crc(in_bits, N_in_bits, CRC16, p_bits, 16);
+        // Convert from soft NRZ to hard bit
+        if(in_bits[i] >= 0)
+        {
+            in_bit = 0;
+        }else{
+            in_bit = 1;
+        }
 
-    // Mask p_bits
-    for(i=0; i<16; i++)
-    {
-        p_bits[i] ^= x_rnti_bits[i] ^ x_as_bits[i];
+        if(CFI_BITS_1[i] != in_bit)
+        {
+            ber[0]++;
+        }
+        if(CFI_BITS_2[i] != in_bit)
+        {
+            ber[1]++;
+        }
+        if(CFI_BITS_3[i] != in_bit)
+        {
+            ber[2]++;
+        }
+        if(CFI_BITS_4[i] != in_bit)
+        {
+            ber[3]++;
+        }
     }
 
-    // Construct c_bits
-    for(i=0; i<N_in_bits; i++)
-    {
-        phy_struct->dci_c_bits[i] = in_bits[i];
-    }
-    for(i=0; i<16; i++)
+    // Find the CFI with the least number of bit errors
+    min_ber = 32;
+    for(i=0; i<4; i++)
     {
-        phy_struct->dci_c_bits[N_in_bits+i] = p_bits[i];
+        if(ber[i] < min_ber)
+        {
+            min_ber = ber[i];
+            cfi_num = i+1;
+        }
     }
 
-    // Determine d_bits
-    conv_encode(phy_struct,
-                phy_struct->dci_c_bits,
-                N_in_bits+16,
-                7,
-                3,
-                g,
-                true,
-                phy_struct->dci_tx_d_bits,
-                &N_d_bits);
-
-    // Determine e_bits
-    rate_match_conv(phy_struct, phy_struct->dci_tx_d_bits, N_d_bits, N_out_bits, out_bits);
-}
-
-/*********************************************************************
-    Name: dci_channel_decode
-
-    Description: Channel decodes the Downlink Control Information
-                 channel
-
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3
-*********************************************************************/
-LIBLTE_ERROR_ENUM dci_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                     float             *in_bits,
-                                     uint32             N_in_bits,
-                                     uint16             rnti_start,
-                                     uint16             rnti_range,
-                                     uint8              ue_ant,
-                                     uint8             *out_bits,
-                                     uint32             N_out_bits,
-                                     uint16            *rnti_found)
-{
-    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_CRC;
-    uint32             i;
-    uint32             j;
-    uint32             N_d_bits;
-    uint32             N_c_bits;
-    uint32             ber;
-    uint32             g[3] = {0133, 0171, 0165}; // Numbers are in octal
-    uint16             rnti;
-    uint8              x_rnti_bits[16];
-    uint8              x_as_bits[16];
-    uint8             *a_bits;
-    uint8             *p_bits;
-    uint8              calc_p_bits[16];
-
-    // Construct UE antenna mask
-    memset(x_as_bits, 0, sizeof(uint8)*16);
-    if(ue_ant == 1)
+    // Make sure the number of bit errors is acceptably low
+    if(min_ber < CFI_N_ACCEPTABLE_BERS)
     {
-        x_as_bits[15] = 1;
+        *cfi = cfi_num;
+        err  = LIBLTE_SUCCESS;
     }
 
-    // Rate unmatch to get the d_bits
-    rate_unmatch_conv(phy_struct,
-                      in_bits,
-                      N_in_bits,
-                      N_out_bits+16,
-                      phy_struct->dci_rx_d_bits,
-                      &N_d_bits);
-
-    // Viterbi decode the d_bits to get the c_bits
-    viterbi_decode(phy_struct,
-                   phy_struct->dci_rx_d_bits,
-                   N_d_bits,
-                   7,
-                   3,
-                   g,
-                   phy_struct->dci_c_bits,
-                   &N_c_bits);
+    return(err);
+}
 
-    // Recover a_bits and p_bits
-    a_bits = &phy_struct->dci_c_bits[0];
-    p_bits = &phy_struct->dci_c_bits[N_out_bits];
+/*********************************************************************
+    Name: get_ul_ce
 
-    // Calculate p_bits
-    calc_crc(a_bits, N_out_bits, CRC16, calc_p_bits, 16);
+    Description: Resolves channel estimates for the uplink and
+                 estimates the noise variance from the second
+                 difference of neighboring DMRS least squares
+                 estimates, which cancels any channel that is linear
+                 across them
 
-    for(j=0; j<rnti_range; j++)
+    Document Reference: N/A
+*********************************************************************/
+void get_ul_ce(LIBLTE_PHY_STRUCT *phy_struct,
+               float             *c_est_0_re,
+               float             *c_est_0_im,
+               float             *c_est_1_re,
+               float             *c_est_1_im,
+               uint32             N_prb,
+               uint32             N_subfr,
+               float             *c_est_re,
+               float             *c_est_im,
+               float             *noise_var)
+{
+    float  *dmrs_0_re;
+    float  *dmrs_0_im;
+    float  *dmrs_1_re;
+    float  *dmrs_1_im;
+    float  *c_re[2];
+    float  *c_im[2];
+    float  *rs_re[2];
+    float  *rs_im[2];
+    float   tmp_re;
+    float   tmp_im;
+    float   ls_re[3];
+    float   ls_im[3];
+    float   nv = 0;
+    float   mag_0;
+    float   mag_1;
+    float   ang_0;
+    float   ang_1;
+    float   frac_mag;
+    float   frac_ang;
+    float   ce_mag[12];
+    float   ce_ang[12];
+    uint32  i;
+    uint32  k;
+    uint32  L;
+    uint32  M_pusch_sc = N_prb * phy_struct->cell->N_sc_rb_ul;
+
+    dmrs_0_re = phy_struct->cell->dmrs_0_re[N_subfr][N_prb];
+    dmrs_0_im = phy_struct->cell->dmrs_0_im[N_subfr][N_prb];
+    dmrs_1_re = phy_struct->cell->dmrs_1_re[N_subfr][N_prb];
+    dmrs_1_im = phy_struct->cell->dmrs_1_im[N_subfr][N_prb];
+
+    // Noise variance, the noise in each second difference has 6
+    // times the variance of a single RE
+    c_re[0]  = c_est_0_re;
+    c_im[0]  = c_est_0_im;
+    c_re[1]  = c_est_1_re;
+    c_im[1]  = c_est_1_im;
+    rs_re[0] = dmrs_0_re;
+    rs_im[0] = dmrs_0_im;
+    rs_re[1] = dmrs_1_re;
+    rs_im[1] = dmrs_1_im;
+    for(L=0; L<2; L++)
     {
-        // Convert RNTI to bit array
-        for(i=0; i<16; i++)
+        for(i=1; i<M_pusch_sc-1; i++)
         {
-            rnti           = rnti_start + j;
-            x_rnti_bits[i] = (rnti >> (15-i)) & 1;
+            for(k=0; k<3; k++)
+            {
+                ls_re[k] = c_re[L][i-1+k]*rs_re[L][i-1+k] + c_im[L][i-1+k]*rs_im[L][i-1+k];
+                ls_im[k] = c_im[L][i-1+k]*rs_re[L][i-1+k] - c_re[L][i-1+k]*rs_im[L][i-1+k];
+            }
+            tmp_re  = ls_re[0] - 2*ls_re[1] + ls_re[2];
+            tmp_im  = ls_im[0] - 2*ls_im[1] + ls_im[2];
+            nv     += (tmp_re*tmp_re + tmp_im*tmp_im)/6;
         }
+    }
+    *noise_var = nv/(2*(M_pusch_sc-2));
 
-        // Check CRC
-        ber = 0;
-        for(i=0; i<16; i++)
+    for(i=0; i<M_pusch_sc; i++)
+    {
+        tmp_re = c_est_0_re[i]*dmrs_0_re[i] + c_est_0_im[i]*dmrs_0_im[i];
+        tmp_im = c_est_0_im[i]*dmrs_0_re[i] - c_est_0_re[i]*dmrs_0_im[i];
+        mag_0  = sqrt(tmp_re*tmp_re + tmp_im*tmp_im);
+        ang_0  = atan2f(tmp_im, tmp_re);
+        tmp_re = c_est_1_re[i]*dmrs_1_re[i] + c_est_1_im[i]*dmrs_1_im[i];
+        tmp_im = c_est_1_im[i]*dmrs_1_re[i] - c_est_1_re[i]*dmrs_1_im[i];
+        mag_1  = sqrt(tmp_re*tmp_re + tmp_im*tmp_im);
+        ang_1  = atan2f(tmp_im, tmp_re);
+
+        frac_mag = (mag_1 - mag_0)/7;
+        frac_ang = (ang_1 - ang_0);
+        if(frac_ang >= M_PI) // Wrap angle
         {
-            ber += p_bits[i] ^ (calc_p_bits[i] ^ x_rnti_bits[i] ^ x_as_bits[i]);
+            frac_ang -= 2*M_PI;
+        }else if(frac_ang <= -M_PI){
+            frac_ang += 2*M_PI;
         }
-        if(ber == 0)
+        frac_ang /= 7;
+
+        for(L=0; L<3; L++)
         {
-            for(i=0; i<N_out_bits; i++)
-            {
-                out_bits[i] = a_bits[i];
-            }
-            err = LIBLTE_SUCCESS;
+            ce_mag[L]   = mag_0 - (3-L)*frac_mag;
+            ce_ang[L]   = ang_0 - (3-L)*frac_ang;
+            ce_mag[3+L] = mag_0 + (1+L)*frac_mag;
+            ce_ang[3+L] = ang_0 + (1+L)*frac_ang;
+            ce_mag[6+L] = mag_1 - (3-L)*frac_mag;
+            ce_ang[6+L] = ang_1 - (3-L)*frac_ang;
+            ce_mag[9+L] = mag_1 + (1+L)*frac_mag;
+            ce_ang[9+L] = ang_1 + (1+L)*frac_ang;
         }
-        if(LIBLTE_SUCCESS == err)
+        for(L=0; L<12; L++)
         {
-            *rnti_found = rnti;
-            break;
+            c_est_re[L*M_pusch_sc + i] = ce_mag[L]*cos(ce_ang[L]);
+            c_est_im[L*M_pusch_sc + i] = ce_mag[L]*sin(ce_ang[L]);
         }
     }
-
-    return(err);
 }
 
 /*********************************************************************
-    Name: dci_0_pack
-
-    Description: Packs all of the fields into the Downlink Control
-                 Information format 0
+    Name: get_num_bits_in_prb
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.1
-                        3GPP TS 36.213 v10.3.0 section 8.1.1
-                        3GPP TS 36.213 v10.3.0 section 8.6
+    Description: Determines the number of bits available in a
+                 particular PRB with a particular modulation type
 
-    Notes: Currently only handles non-hopping single-cluster
-           assignments
+    Document Reference: N/A
 *********************************************************************/
-void dci_0_pack(LIBLTE_PHY_ALLOCATION_STRUCT    *alloc,
-                LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
-                uint32                           N_rb_ul,
-                uint8                            N_ant,
-                uint8                           *out_bits,
-                uint32                          *N_out_bits)
+uint32 get_num_bits_in_prb(uint32                          N_subframe,
+                           uint32                          N_ctrl_symbs,
+                           uint32                          prb,
+                           uint32                          N_rb_dl,
+                           uint8                           N_ant,
+                           LIBLTE_PHY_MODULATION_TYPE_ENUM mod_type)
 {
-    uint32  RIV;
-    uint32  RIV_length;
-    uint32  size;
-    uint8  *dci = out_bits;
+    uint32 first_prb;
+    uint32 last_prb;
+    uint32 N_REs;
+    uint32 N_bits;
+    bool   partial_prb;
 
-    // Carrier indicator
-    if(LIBLTE_PHY_DCI_CA_PRESENT == ca_presence)
+    // Determine first and last PBCH, PSS, and SSS PRBs
+    if(N_rb_dl == 6)
     {
-        printf("WARNING: Not handling carrier indicator\n");
-        liblte_value_2_bits(0, &dci, 3);
+        partial_prb = false;
+        first_prb   = 0;
+        last_prb    = 5;
+    }else if(N_rb_dl == 15){
+        partial_prb = true;
+        first_prb   = 4;
+        last_prb    = 10;
+    }else if(N_rb_dl == 25){
+        partial_prb = true;
+        first_prb   = 9;
+        last_prb    = 15;
+    }else if(N_rb_dl == 50){
+        partial_prb = false;
+        first_prb   = 22;
+        last_prb    = 27;
+    }else if(N_rb_dl == 75){
+        partial_prb = true;
+        first_prb   = 34;
+        last_prb    = 40;
+    }else{ // N_rb_dl == 100
+        partial_prb = false;
+        first_prb   = 47;
+        last_prb    = 52;
     }
 
-    // Format 0/1A flag is set to format 0
-    liblte_value_2_bits(DCI_0_1A_FLAG_0, &dci, 1);
+    if(N_ant == 1)
+    {
+        // Start with raw number of resource elements
+        N_REs = (14-4)*12 + 4*10;
 
-    // Frequency hopping flag
-    liblte_value_2_bits(0, &dci, 1);
+        // Remove control symbols
+        N_REs -= ((N_ctrl_symbs-1)*12 + 10);
 
-    // RBA
-    // FIXME: Only supporting non-hopping single-cluster
-    RIV_length = (uint32)ceilf(logf(N_rb_ul*(N_rb_ul+1)/2)/logf(2));
-    if((alloc->N_prb-1) <= (N_rb_ul/2))
-    {
-        RIV = N_rb_ul*(alloc->N_prb-1) + alloc->prb[0][0];
-    }else{
-        RIV = N_rb_ul*(N_rb_ul - alloc->N_prb + 1) + (N_rb_ul - 1 - alloc->prb[0][0]);
+        // Remove PBCH, PSS, and SSS
+        if(prb >= first_prb &&
+           prb <= last_prb)
+        {
+            if(true == partial_prb &&
+               (prb == first_prb   ||
+                prb == last_prb))
+            {
+                if(N_subframe == 0)
+                {
+                    N_REs -= 5*6 + 5;
+                }else if(N_subframe == 5){
+                    N_REs -= 2*6;
+                }
+            }else{
+                if(N_subframe == 0)
+                {
+                    N_REs -= 5*12 + 10;
+                }else if(N_subframe == 5){
+                    N_REs -= 2*12;
+                }
+            }
+        }
+    }else if(N_ant == 2){
+        // Start with raw number of resource elements
+        N_REs = (14-4)*12 + 4*8;
+
+        // Remove control symbols
+        N_REs -= ((N_ctrl_symbs-1)*12 + 8);
+
+        // Remove PBCH, PSS, and SSS
+        if(prb >= first_prb &&
+           prb <= last_prb)
+        {
+            if(true == partial_prb &&
+               (prb == first_prb   ||
+                prb == last_prb))
+            {
+                if(N_subframe == 0)
+                {
+                    N_REs -= 5*6 + 4;
+                }else if(N_subframe == 5){
+                    N_REs -= 2*6;
+                }
+            }else{
+                if(N_subframe == 0)
+                {
+                    N_REs -= 5*12 + 8;
+                }else if(N_subframe == 5){
+                    N_REs -= 2*12;
+                }
+            }
+        }
+    }else{ // N_ant == 4
+        // Start with raw number of resource elements
+        N_REs = (14-6)*12 + 6*8;
+
+        // Remove control symbols
+        if(1 == N_ctrl_symbs)
+        {
+            N_REs -= 8;
+        }else{
+            N_REs -= ((N_ctrl_symbs-2)*12 + 2*8);
+        }
+
+        // Remove PBCH, PSS, and SSS
+        if(prb >= first_prb &&
+           prb <= last_prb)
+        {
+            if(true == partial_prb &&
+               (prb == first_prb   ||
+                prb == last_prb))
+            {
+                if(N_subframe == 0)
+                {
+                    N_REs -= 4*6 + 2*4;
+                }else if(N_subframe == 5){
+                    N_REs -= 2*6;
+                }
+            }else{
+                if(N_subframe == 0)
+                {
+                    N_REs -= 4*12 + 2*8;
+                }else if(N_subframe == 5){
+                    N_REs -= 2*12;
+                }
+            }
+        }
     }
-    liblte_value_2_bits(RIV, &dci, RIV_length);
-
-    // Modulation and coding scheme and redundancy version
-    liblte_value_2_bits(alloc->mcs, &dci, 5);
-
-    // New data indicator
-    liblte_value_2_bits(alloc->ndi, &dci, 1);
-
-    // TPC command
-    liblte_value_2_bits(alloc->tpc, &dci, 2);
-
-    // Cyclic shift
-    liblte_value_2_bits(0, &dci, 3);
-
-    // CSI request
-    liblte_value_2_bits(0, &dci, 1);
 
-    // Pad bit
-    liblte_value_2_bits(0, &dci, 1);
-
-    // Pad if needed
-    size = dci - out_bits;
-    if(size == 12 ||
-       size == 14 ||
-       size == 16 ||
-       size == 20 ||
-       size == 24 ||
-       size == 26 ||
-       size == 32 ||
-       size == 40 ||
-       size == 44 ||
-       size == 56)
+    switch(mod_type)
     {
-        size++;
-        liblte_value_2_bits(0, &dci, 1);
+    case LIBLTE_PHY_MODULATION_TYPE_BPSK:
+        N_bits = N_REs;
+        break;
+    case LIBLTE_PHY_MODULATION_TYPE_QPSK:
+        N_bits = N_REs*2;
+        break;
+    case LIBLTE_PHY_MODULATION_TYPE_16QAM:
+        N_bits = N_REs*4;
+        break;
+    case LIBLTE_PHY_MODULATION_TYPE_64QAM:
+        N_bits = N_REs*6;
+        break;
+    default:
+        N_bits = 0;
+        break;
     }
-    *N_out_bits = size;
+
+    return(N_bits);
 }
 
 /*********************************************************************
-    Name: dci_0_unpack
-
-    Description: Unpacks all of the fields from the Downlink Control
-                 Information format 0
+    Name: wrap_phase
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.1
-                        3GPP TS 36.213 v10.3.0 section 8.1.1
-                        3GPP TS 36.213 v10.3.0 section 8.6
+    Description: Checks the phase difference between two angles and
+                 wraps one to make the difference less than 2*pi.
 
-    Notes: N/A
+    Document Reference: N/A
 *********************************************************************/
-// FIXME
+inline void wrap_phase(float *phase_1,
+                       float  phase_2)
+{
+    while((*phase_1 - phase_2) >= M_PI)
+    {
+        *phase_1 = *phase_1 - 2*M_PI;
+    }
+    while((*phase_1 - phase_2) <= -M_PI)
+    {
+        *phase_1 = *phase_1 + 2*M_PI;
+    }
+}
 
 /*********************************************************************
-    Name: dci_1a_pack
-
-    Description: Packs all of the fields into the Downlink Control
-                 Information format 1A
+    Name: dl_ce_polar
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.3
-                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
-                        3GPP TS 36.213 v10.3.0 section 7.1.7
+    Description: Estimates the downlink channel by interpolating the
+                 magnitude and unwrapped phase of the CRS estimates in
+                 frequency and then in time
 
-    Notes: Currently only handles localized virtual resource blocks
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.10.1
 *********************************************************************/
-void dci_1a_pack(LIBLTE_PHY_ALLOCATION_STRUCT    *alloc,
-                 LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
-                 uint32                           N_rb_dl,
-                 uint8                            N_ant,
-                 uint8                           *out_bits,
-                 uint32                          *N_out_bits)
+void dl_ce_polar(LIBLTE_PHY_STRUCT          *phy_struct,
+                 uint32                      N_id_cell,
+                 uint8                       N_ant,
+                 LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
 {
-    uint32  RIV;
-    uint32  RIV_length;
-    uint32  size;
-    uint32  N_prb_1a;
-    uint8  *dci = out_bits;
-
-    // Carrier indicator
-    if(LIBLTE_PHY_DCI_CA_PRESENT == ca_presence)
-    {
-        printf("WARNING: Not handling carrier indicator\n");
-        liblte_value_2_bits(0, &dci, 3);
-    }
-
-    // Format 0/1A flag is set to format 1A
-    liblte_value_2_bits(DCI_0_1A_FLAG_1A, &dci, 1);
+    float  *sym_re;
+    float  *sym_im;
+    float  *rs_re;
+    float  *rs_im;
+    float   tmp_re;
+    float   tmp_im;
+    float   frac_mag = 0;
+    float   frac_ang = 0;
+    float   ce_mag;
+    float   ce_ang;
+    uint32  v_shift  = N_id_cell % 6;
+    uint32  N_sym;
+    uint32  m_prime;
+    uint32  i;
+    uint32  j;
+    uint32  k = 0;
+    uint32  p;
+    uint32  v[5];
+    uint32  sym[5];
+    uint32  z;
 
-    if(LIBLTE_MAC_SI_RNTI        == alloc->rnti ||
-       LIBLTE_MAC_P_RNTI         == alloc->rnti ||
-       (LIBLTE_MAC_RA_RNTI_START <= alloc->rnti &&
-        LIBLTE_MAC_RA_RNTI_END   >= alloc->rnti))
+    for(p=0; p<N_ant; p++)
     {
-        // FIXME: Only supporting localized VRBs
-        liblte_value_2_bits(DCI_VRB_TYPE_LOCALIZED, &dci, 1);
-        RIV_length = (uint32)ceilf(logf(N_rb_dl*(N_rb_dl+1)/2)/logf(2));
-        if((alloc->N_prb-1) <= (N_rb_dl/2))
-        {
-            RIV = N_rb_dl*(alloc->N_prb-1) + alloc->prb[0][0];
-        }else{
-            RIV = N_rb_dl*(N_rb_dl-alloc->N_prb+1) + (N_rb_dl - 1 - alloc->prb[0][0]);
-        }
-        liblte_value_2_bits(RIV, &dci, RIV_length);
-
-        // Modulation and coding scheme
-        liblte_value_2_bits(alloc->mcs, &dci, 5);
-
-        // HARQ process number, FIXME: FDD only
-        liblte_value_2_bits(0, &dci, 3);
-
-        // New data indicator
-        liblte_value_2_bits(0, &dci, 1);
+        // Define v, sym, and N_sym
+        if(p == 0)
+        {
+            v[0]   = 0;
+            v[1]   = 3;
+            v[2]   = 0;
+            v[3]   = 3;
+            v[4]   = 0;
+            sym[0] = 0;
+            sym[1] = 4;
+            sym[2] = 7;
+            sym[3] = 11;
+            sym[4] = 14;
+            N_sym  = 5;
+        }else if(p == 1){
+            v[0]   = 3;
+            v[1]   = 0;
+            v[2]   = 3;
+            v[3]   = 0;
+            v[4]   = 3;
+            sym[0] = 0;
+            sym[1] = 4;
+            sym[2] = 7;
+            sym[3] = 11;
+            sym[4] = 14;
+            N_sym  = 5;
+        }else if(p == 2){
+            v[0]   = 0;
+            v[1]   = 3;
+            v[2]   = 0;
+            sym[0] = 1;
+            sym[1] = 8;
+            sym[2] = 15;
+            N_sym  = 3;
+        }else{ // p == 3
+            v[0]   = 3;
+            v[1]   = 6;
+            v[2]   = 3;
+            sym[0] = 1;
+            sym[1] = 8;
+            sym[2] = 15;
+            N_sym  = 3;
+        }
+
+        for(i=0; i<N_sym; i++)
+        {
+            sym_re = &subframe->rx_symb_re[sym[i]][0];
+            sym_im = &subframe->rx_symb_im[sym[i]][0];
+            rs_re  = &phy_struct->dl_ce_scratch->dl_ce_crs_re[sym[i]][0];
+            rs_im  = &phy_struct->dl_ce_scratch->dl_ce_crs_im[sym[i]][0];
+
+            for(j=0; j<2*phy_struct->cell->N_rb_dl; j++)
+            {
+                k                                          = 6*j + (v[i] + v_shift)%6;
+                m_prime                                    = j + LIBLTE_PHY_N_RB_DL_MAX - phy_struct->cell->N_rb_dl;
+                tmp_re                                     = sym_re[k]*rs_re[m_prime] + sym_im[k]*rs_im[m_prime];
+                tmp_im                                     = sym_im[k]*rs_re[m_prime] - sym_re[k]*rs_im[m_prime];
+                phy_struct->dl_ce_scratch->dl_ce_mag[i][k] = sqrt(tmp_re*tmp_re + tmp_im*tmp_im);
+                phy_struct->dl_ce_scratch->dl_ce_ang[i][k] = atan2f(tmp_im, tmp_re);
+
+                // Unwrap phase
+                if(j > 0)
+                {
+                    wrap_phase(&phy_struct->dl_ce_scratch->dl_ce_ang[i][k], phy_struct->dl_ce_scratch->dl_ce_ang[i][k-6]);
 
-        // Redundancy version
-        liblte_value_2_bits(alloc->rv_idx, &dci, 2);
+                    // Linearly interpolate between CRSs
+                    frac_mag = (phy_struct->dl_ce_scratch->dl_ce_mag[i][k] - phy_struct->dl_ce_scratch->dl_ce_mag[i][k-6])/6;
+                    frac_ang = (phy_struct->dl_ce_scratch->dl_ce_ang[i][k] - phy_struct->dl_ce_scratch->dl_ce_ang[i][k-6])/6;
+                    for(z=1; z<6; z++)
+                    {
+                        phy_struct->dl_ce_scratch->dl_ce_mag[i][k-z] = phy_struct->dl_ce_scratch->dl_ce_mag[i][k-(z-1)] - frac_mag;
+                        phy_struct->dl_ce_scratch->dl_ce_ang[i][k-z] = phy_struct->dl_ce_scratch->dl_ce_ang[i][k-(z-1)] - frac_ang;
+                    }
+                }
 
-        // TPC
-        N_prb_1a = 3;
-        liblte_value_2_bits(1, &dci, 2);
+                // Linearly interpolate before 1st CRS
+                if(j == 1)
+                {
+                    for(z=1; z<((v[i] + v_shift)%6)+1; z++)
+                    {
+                        phy_struct->dl_ce_scratch->dl_ce_mag[i][k-6-z] = phy_struct->dl_ce_scratch->dl_ce_mag[i][k-6-(z-1)] - frac_mag;
+                        phy_struct->dl_ce_scratch->dl_ce_ang[i][k-6-z] = phy_struct->dl_ce_scratch->dl_ce_ang[i][k-6-(z-1)] - frac_ang;
+                    }
+                }
+            }
 
-        // Calculate the TBS
-        alloc->tbs = TBS_71721[alloc->mcs][N_prb_1a-1];
-    }else{
-        // FIXME: Only supporting localized VRBs
-        liblte_value_2_bits(DCI_VRB_TYPE_LOCALIZED, &dci, 1);
-        RIV_length = (uint32)ceilf(logf(N_rb_dl*(N_rb_dl+1)/2)/logf(2));
-        if((alloc->N_prb-1) <= (N_rb_dl/2))
-        {
-            RIV = N_rb_dl*(alloc->N_prb-1) + alloc->prb[0][0];
-        }else{
-            RIV = N_rb_dl*(N_rb_dl - alloc->N_prb + 1) + (N_rb_dl - 1 - alloc->prb[0][0]);
+            // Linearly interpolate after last CRS
+            for(z=1; z<(5-(v[i] + v_shift)%6)+1; z++)
+            {
+                phy_struct->dl_ce_scratch->dl_ce_mag[i][k+z] = phy_struct->dl_ce_scratch->dl_ce_mag[i][k+(z-1)] - frac_mag;
+                phy_struct->dl_ce_scratch->dl_ce_ang[i][k+z] = phy_struct->dl_ce_scratch->dl_ce_ang[i][k+(z-1)] - frac_ang;
+            }
         }
-        liblte_value_2_bits(RIV, &dci, RIV_length);
-
-        // Modulation and coding scheme
-        liblte_value_2_bits(alloc->mcs, &dci, 5);
-
-        // HARQ process number, FIXME: FDD only
-        liblte_value_2_bits(0, &dci, 3);
 
-        // New data indicator
-        liblte_value_2_bits(alloc->ndi, &dci, 1);
+        // Linearly interpolate between symbols to construct all channel estimates
+        if(N_sym == 3)
+        {
+            for(j=0; j<phy_struct->cell->N_rb_dl*phy_struct->cell->N_sc_rb_dl; j++)
+            {
+                // Construct symbol 1 and 8 channel estimates directly
+                subframe->rx_ce_re[p][1][j] = phy_struct->dl_ce_scratch->dl_ce_mag[0][j]*cosf(phy_struct->dl_ce_scratch->dl_ce_ang[0][j]);
+                subframe->rx_ce_im[p][1][j] = phy_struct->dl_ce_scratch->dl_ce_mag[0][j]*sinf(phy_struct->dl_ce_scratch->dl_ce_ang[0][j]);
+                subframe->rx_ce_re[p][8][j] = phy_struct->dl_ce_scratch->dl_ce_mag[1][j]*cosf(phy_struct->dl_ce_scratch->dl_ce_ang[1][j]);
+                subframe->rx_ce_im[p][8][j] = phy_struct->dl_ce_scratch->dl_ce_mag[1][j]*sinf(phy_struct->dl_ce_scratch->dl_ce_ang[1][j]);
+
+                // Interpolate for symbol 2, 3, 4, 5, 6, and 7 channel estimates
+                frac_mag = (phy_struct->dl_ce_scratch->dl_ce_mag[1][j] - phy_struct->dl_ce_scratch->dl_ce_mag[0][j])/7;
+                wrap_phase(&phy_struct->dl_ce_scratch->dl_ce_ang[1][j], phy_struct->dl_ce_scratch->dl_ce_ang[0][j]);
+                frac_ang = (phy_struct->dl_ce_scratch->dl_ce_ang[1][j] - phy_struct->dl_ce_scratch->dl_ce_ang[0][j]);
+                wrap_phase(&frac_ang, 0);
+                frac_ang /= 7;
+                ce_mag    = phy_struct->dl_ce_scratch->dl_ce_mag[1][j];
+                ce_ang    = phy_struct->dl_ce_scratch->dl_ce_ang[1][j];
+                for(z=7; z>1; z--)
+                {
+                    ce_mag                      -= frac_mag;
+                    ce_ang                      -= frac_ang;
+                    subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
+                    subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
+                }
 
-        // Redundancy version
-        liblte_value_2_bits(alloc->rv_idx, &dci, 2);
+                // Interpolate for symbol 0 channel estimate
+                // FIXME: Use previous slot to do this correctly
+                ce_mag                      = phy_struct->dl_ce_scratch->dl_ce_mag[0][j] - frac_mag;
+                ce_ang                      = phy_struct->dl_ce_scratch->dl_ce_ang[0][j] - frac_ang;
+                subframe->rx_ce_re[p][0][j] = ce_mag*cosf(ce_ang);
+                subframe->rx_ce_im[p][0][j] = ce_mag*sinf(ce_ang);
+
+                // Interpolate for symbol 9, 10, 11, 12, and 13 channel estimates
+                frac_mag = (phy_struct->dl_ce_scratch->dl_ce_mag[2][j] - phy_struct->dl_ce_scratch->dl_ce_mag[1][j])/7;
+                wrap_phase(&phy_struct->dl_ce_scratch->dl_ce_ang[2][j], phy_struct->dl_ce_scratch->dl_ce_ang[1][j]);
+                frac_ang = (phy_struct->dl_ce_scratch->dl_ce_ang[2][j] - phy_struct->dl_ce_scratch->dl_ce_ang[1][j]);
+                wrap_phase(&frac_ang, 0);
+                frac_ang /= 7;
+                ce_mag    = phy_struct->dl_ce_scratch->dl_ce_mag[2][j] - frac_mag;
+                ce_ang    = phy_struct->dl_ce_scratch->dl_ce_ang[2][j] - frac_ang;
+                for(z=13; z>8; z--)
+                {
+                    ce_mag                      -= frac_mag;
+                    ce_ang                      -= frac_ang;
+                    subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
+                    subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
+                }
+            }
+        }else{
+            for(j=0; j<phy_struct->cell->N_rb_dl*phy_struct->cell->N_sc_rb_dl; j++)
+            {
+                // Construct symbol 0, 4, 7, and 11 channel estimates directly
+                subframe->rx_ce_re[p][0][j]  = phy_struct->dl_ce_scratch->dl_ce_mag[0][j]*cosf(phy_struct->dl_ce_scratch->dl_ce_ang[0][j]);
+                subframe->rx_ce_im[p][0][j]  = phy_struct->dl_ce_scratch->dl_ce_mag[0][j]*sinf(phy_struct->dl_ce_scratch->dl_ce_ang[0][j]);
+                subframe->rx_ce_re[p][4][j]  = phy_struct->dl_ce_scratch->dl_ce_mag[1][j]*cosf(phy_struct->dl_ce_scratch->dl_ce_ang[1][j]);
+                subframe->rx_ce_im[p][4][j]  = phy_struct->dl_ce_scratch->dl_ce_mag[1][j]*sinf(phy_struct->dl_ce_scratch->dl_ce_ang[1][j]);
+                subframe->rx_ce_re[p][7][j]  = phy_struct->dl_ce_scratch->dl_ce_mag[2][j]*cosf(phy_struct->dl_ce_scratch->dl_ce_ang[2][j]);
+                subframe->rx_ce_im[p][7][j]  = phy_struct->dl_ce_scratch->dl_ce_mag[2][j]*sinf(phy_struct->dl_ce_scratch->dl_ce_ang[2][j]);
+                subframe->rx_ce_re[p][11][j] = phy_struct->dl_ce_scratch->dl_ce_mag[3][j]*cosf(phy_struct->dl_ce_scratch->dl_ce_ang[3][j]);
+                subframe->rx_ce_im[p][11][j] = phy_struct->dl_ce_scratch->dl_ce_mag[3][j]*sinf(phy_struct->dl_ce_scratch->dl_ce_ang[3][j]);
+
+                // Interpolate for symbol 1, 2, and 3 channel estimates
+                frac_mag = (phy_struct->dl_ce_scratch->dl_ce_mag[1][j] - phy_struct->dl_ce_scratch->dl_ce_mag[0][j])/4;
+                wrap_phase(&phy_struct->dl_ce_scratch->dl_ce_ang[1][j], phy_struct->dl_ce_scratch->dl_ce_ang[0][j]);
+                frac_ang = (phy_struct->dl_ce_scratch->dl_ce_ang[1][j] - phy_struct->dl_ce_scratch->dl_ce_ang[0][j]);
+                wrap_phase(&frac_ang, 0);
+                frac_ang /= 4;
+                ce_mag    = phy_struct->dl_ce_scratch->dl_ce_mag[1][j];
+                ce_ang    = phy_struct->dl_ce_scratch->dl_ce_ang[1][j];
+                for(z=3; z>0; z--)
+                {
+                    ce_mag                      -= frac_mag;
+                    ce_ang                      -= frac_ang;
+                    subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
+                    subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
+                }
 
-        // TPC
-        liblte_value_2_bits(alloc->tpc, &dci, 2);
+                // Interpolate for symbol 5 and 6 channel estimates
+                frac_mag = (phy_struct->dl_ce_scratch->dl_ce_mag[2][j] - phy_struct->dl_ce_scratch->dl_ce_mag[1][j])/3;
+                wrap_phase(&phy_struct->dl_ce_scratch->dl_ce_ang[2][j], phy_struct->dl_ce_scratch->dl_ce_ang[1][j]);
+                frac_ang = (phy_struct->dl_ce_scratch->dl_ce_ang[2][j] - phy_struct->dl_ce_scratch->dl_ce_ang[1][j]);
+                wrap_phase(&frac_ang, 0);
+                frac_ang /= 3;
+                ce_mag    = phy_struct->dl_ce_scratch->dl_ce_mag[2][j];
+                ce_ang    = phy_struct->dl_ce_scratch->dl_ce_ang[2][j];
+                for(z=6; z>4; z--)
+                {
+                    ce_mag                      -= frac_mag;
+                    ce_ang                      -= frac_ang;
+                    subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
+                    subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
+                }
 
-        // Calculate the TBS
-        alloc->tbs = TBS_71721[alloc->mcs][alloc->N_prb-1];
-    }
+                // Interpolate for symbol 8, 9, and 10 channel estimates
+                frac_mag = (phy_struct->dl_ce_scratch->dl_ce_mag[3][j] - phy_struct->dl_ce_scratch->dl_ce_mag[2][j])/4;
+                wrap_phase(&phy_struct->dl_ce_scratch->dl_ce_ang[3][j], phy_struct->dl_ce_scratch->dl_ce_ang[2][j]);
+                frac_ang = (phy_struct->dl_ce_scratch->dl_ce_ang[3][j] - phy_struct->dl_ce_scratch->dl_ce_ang[2][j]);
+                wrap_phase(&frac_ang, 0);
+                frac_ang /= 4;
+                ce_mag    = phy_struct->dl_ce_scratch->dl_ce_mag[3][j];
+                ce_ang    = phy_struct->dl_ce_scratch->dl_ce_ang[3][j];
+                for(z=10; z>7; z--)
+                {
+                    ce_mag                      -= frac_mag;
+                    ce_ang                      -= frac_ang;
+                    subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
+                    subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
+                }
 
-    // Pad if needed
-    size = dci - out_bits;
-    if(size == 12 ||
-       size == 14 ||
-       size == 16 ||
-       size == 20 ||
-       size == 24 ||
-       size == 26 ||
-       size == 32 ||
-       size == 40 ||
-       size == 44 ||
-       size == 56)
-    {
-        size++;
-        liblte_value_2_bits(0, &dci, 1);
+                // Interpolate for symbol 12 and 13 channel estimates
+                frac_mag = (phy_struct->dl_ce_scratch->dl_ce_mag[4][j] - phy_struct->dl_ce_scratch->dl_ce_mag[3][j])/3;
+                wrap_phase(&phy_struct->dl_ce_scratch->dl_ce_ang[4][j], phy_struct->dl_ce_scratch->dl_ce_ang[3][j]);
+                frac_ang = (phy_struct->dl_ce_scratch->dl_ce_ang[4][j] - phy_struct->dl_ce_scratch->dl_ce_ang[3][j]);
+                wrap_phase(&frac_ang, 0);
+                frac_ang /= 3;
+                ce_mag    = phy_struct->dl_ce_scratch->dl_ce_mag[4][j];
+                ce_ang    = phy_struct->dl_ce_scratch->dl_ce_ang[4][j];
+                for(z=13; z>11; z--)
+                {
+                    ce_mag                      -= frac_mag;
+                    ce_ang                      -= frac_ang;
+                    subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
+                    subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
+                }
+            }
+        }
     }
-    *N_out_bits = size;
 }
 
-/*********************************************************************
-    Name: dci_1a_unpack
-
-    Description: Unpacks all of the fields from the Downlink Control
-                 Information format 1A
-
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.3
-                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
-                        3GPP TS 36.213 v10.3.0 section 7.1.7
-
-    Notes: Currently only handles SI-RNTI, P-RNTI, or RA-RNTI and
-           localized virtual resource blocks
-*********************************************************************/
-LIBLTE_ERROR_ENUM dci_1a_unpack(uint8                           *in_bits,
-                                uint32                           N_in_bits,
-                                LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
-                                uint16                           rnti,
-                                uint32                           N_rb_dl,
-                                uint8                            N_ant,
-                                LIBLTE_PHY_ALLOCATION_STRUCT    *alloc)
-{
-    LIBLTE_ERROR_ENUM  err      = LIBLTE_SUCCESS;
-    uint32             RB_start = 0;
-    uint32             RIV;
-    uint32             RIV_length;
-    uint32             i;
-    uint32             j;
-    uint32             ca_ind;
-    uint32             N_prb_1a;
-    uint32             tpc;
-    uint32             dci_0_1a_flag;
-    uint32             loc_or_dist;
-    uint32             harq_process;
-    uint32             new_data_ind;
-    uint8             *dci = in_bits;
-
-    // Carrier indicator
-    if(LIBLTE_PHY_DCI_CA_PRESENT == ca_presence)
+/*********************************************************************
+    Name: dl_ce_cartesian
+
+    Description: Estimates the downlink channel from the least squares
+                 CRS estimates, interpolating the complex values with
+                 the linear or Wiener weights in frequency and linearly
+                 in time.  The noise variance of each PRB is estimated
+                 from the second difference of neighboring CRSs, which
+                 cancels any channel that is linear across them.
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.10.1
+*********************************************************************/
+void dl_ce_cartesian(LIBLTE_PHY_STRUCT          *phy_struct,
+                     uint32                      N_id_cell,
+                     uint8                       N_ant,
+                     LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
+{
+    float  *sym_re;
+    float  *sym_im;
+    float  *rs_re;
+    float  *rs_im;
+    float  *ls_re;
+    float  *ls_im;
+    float   d_re;
+    float   d_im;
+    float   pwr      = 0;
+    float   nv       = 0;
+    float   frac;
+    uint32  v_shift  = N_id_cell % 6;
+    uint32  N_pilots = 2*phy_struct->cell->N_rb_dl;
+    uint32  N_sc     = phy_struct->cell->N_rb_dl*phy_struct->cell->N_sc_rb_dl;
+    uint32  N_crs    = 0;
+    uint32  m_prime;
+    uint32  sym;
+    uint32  i;
+    uint32  j;
+    uint32  k;
+    uint32  p;
+    uint32  z;
+
+    // Least squares estimate at each CRS and the noise variance
+    // from the second difference of neighboring CRSs, the noise in
+    // which has 6 times the variance of a single RE
+    memset(phy_struct->dl_ce_scratch->dl_ce_nv_acc, 0, sizeof(float)*phy_struct->cell->N_rb_dl);
+    for(p=0; p<N_ant; p++)
     {
-        ca_ind = liblte_bits_2_value(&dci, 3);
-        printf("WARNING: Not handling carrier indicator\n");
+        for(i=0; i<DL_CE_N_CRS_SYMBS[p]; i++)
+        {
+            sym    = DL_CE_CRS_SYMB[p][i];
+            sym_re = &subframe->rx_symb_re[sym][0];
+            sym_im = &subframe->rx_symb_im[sym][0];
+            rs_re  = &phy_struct->dl_ce_scratch->dl_ce_crs_re[sym][0];
+            rs_im  = &phy_struct->dl_ce_scratch->dl_ce_crs_im[sym][0];
+            ls_re  = &phy_struct->dl_ce_scratch->dl_ce_ls_re[p][i][0];
+            ls_im  = &phy_struct->dl_ce_scratch->dl_ce_ls_im[p][i][0];
+            for(j=0; j<N_pilots; j++)
+            {
+                k         = 6*j + (DL_CE_CRS_V[p][i] + v_shift)%6;
+                m_prime   = j + LIBLTE_PHY_N_RB_DL_MAX - phy_struct->cell->N_rb_dl;
+                ls_re[j]  = sym_re[k]*rs_re[m_prime] + sym_im[k]*rs_im[m_prime];
+                ls_im[j]  = sym_im[k]*rs_re[m_prime] - sym_re[k]*rs_im[m_prime];
+                pwr      += ls_re[j]*ls_re[j] + ls_im[j]*ls_im[j];
+            }
+            for(j=1; j<N_pilots-1; j++)
+            {
+                d_re                                          = ls_re[j-1] - 2*ls_re[j] + ls_re[j+1];
+                d_im                                          = ls_im[j-1] - 2*ls_im[j] + ls_im[j+1];
+                phy_struct->dl_ce_scratch->dl_ce_nv_acc[j/2] += (d_re*d_re + d_im*d_im)/6;
+            }
+            N_crs++;
+        }
     }
 
-    // Check DCI 0/1A flag 3GPP TS 36.212 v10.1.0 section 5.3.3.1.3
-    dci_0_1a_flag = liblte_bits_2_value(&dci, 1);
-    if(DCI_0_1A_FLAG_0 == dci_0_1a_flag)
+    // The first and last PRBs have one second difference per CRS
+    // symbol, all others have two
+    for(j=0; j<phy_struct->cell->N_rb_dl; j++)
     {
-        printf("ERROR: DCI 1A flagged as DCI 0\n");
-        return(LIBLTE_ERROR_INVALID_CONTENTS);
+        nv += phy_struct->dl_ce_scratch->dl_ce_nv_acc[j];
+        if(0 == j ||
+           (phy_struct->cell->N_rb_dl-1) == j)
+        {
+            subframe->rx_noise_var[j] = phy_struct->dl_ce_scratch->dl_ce_nv_acc[j]/N_crs;
+        }else{
+            subframe->rx_noise_var[j] = phy_struct->dl_ce_scratch->dl_ce_nv_acc[j]/(2*N_crs);
+        }
     }
+    nv                           /= N_crs*(N_pilots-2);
+    pwr                           = pwr/(N_crs*N_pilots) - nv;
+    subframe->rx_noise_var_valid  = phy_struct->dl_ce_est_noise_var;
 
-    if(LIBLTE_MAC_SI_RNTI        == rnti ||
-       LIBLTE_MAC_P_RNTI         == rnti ||
-       (LIBLTE_MAC_RA_RNTI_START <= rnti &&
-        LIBLTE_MAC_RA_RNTI_END   >= rnti))
+    dl_ce_interp_weights(phy_struct,
+                         phy_struct->dl_ce_type,
+                         fmaxf(nv/fmaxf(pwr, FLT_MIN), DL_CE_NOISE_RATIO_MIN));
+
+    for(p=0; p<N_ant; p++)
     {
-        // Determine if RIV uses local or distributed VRBs
-        loc_or_dist = liblte_bits_2_value(&dci, 1);
+        // Interpolate in frequency at each CRS symbol
+        for(i=0; i<DL_CE_N_CRS_SYMBS[p]; i++)
+        {
+            dl_ce_interp_freq(phy_struct->dl_ce_scratch->dl_ce_ls_re[p][i],
+                              phy_struct->dl_ce_scratch->dl_ce_ls_im[p][i],
+                              N_pilots,
+                              (DL_CE_CRS_V[p][i] + v_shift)%6,
+                              phy_struct->dl_ce_w,
+                              phy_struct->dl_ce_scratch->dl_ce_re[i],
+                              phy_struct->dl_ce_scratch->dl_ce_im[i]);
+        }
+
+        // Interpolate in time between the surrounding CRS symbols,
+        // extrapolating symbol 0 for antenna ports 2 and 3
+        // FIXME: Use previous slot to do this correctly
+        i = 0;
+        for(z=0; z<14; z++)
+        {
+            while((i+2)                  <  DL_CE_N_CRS_SYMBS[p] &&
+                  DL_CE_CRS_SYMB[p][i+1] <= z)
+            {
+                i++;
+            }
+            frac = ((float)z - (float)DL_CE_CRS_SYMB[p][i])/(float)(DL_CE_CRS_SYMB[p][i+1] - DL_CE_CRS_SYMB[p][i]);
+            PHY_KERNELS.dl_ce_interp_time(phy_struct->dl_ce_scratch->dl_ce_re[i],
+                                          phy_struct->dl_ce_scratch->dl_ce_im[i],
+                                          phy_struct->dl_ce_scratch->dl_ce_re[i+1],
+                                          phy_struct->dl_ce_scratch->dl_ce_im[i+1],
+                                          frac,
+                                          N_sc,
+                                          subframe->rx_ce_re[p][z],
+                                          subframe->rx_ce_im[p][z]);
+        }
+    }
+}
 
-        // Find the RIV that was sent 3GPP TS 36.213 v10.3.0 section 7.1.6.3
-        RIV_length   = (uint32)ceilf(logf(N_rb_dl*(N_rb_dl+1)/2)/logf(2));
-        RIV          = liblte_bits_2_value(&dci, RIV_length);
-        alloc->N_prb = RIV/N_rb_dl + 1;
-        RB_start     = RIV % N_rb_dl;
+/*********************************************************************
+    Name: dl_ce_interp_weights
 
-        // Extract the rest of the fields
-        alloc->mcs    = liblte_bits_2_value(&dci, 5);
-        harq_process  = liblte_bits_2_value(&dci, 3);
-        new_data_ind  = liblte_bits_2_value(&dci, 1);
-        alloc->rv_idx = liblte_bits_2_value(&dci, 2);
-        tpc           = liblte_bits_2_value(&dci, 2);
+    Description: Fills dl_ce_w with the 4 tap frequency interpolation
+                 weights for each subcarrier position relative to a
+                 window of 4 CRSs, from 5 subcarriers before the first
+                 CRS to 23 after it.  Wiener weights use a sinc
+                 frequency correlation for a delay spread as long as
+                 the normal cyclic prefix and the given noise to
+                 signal ratio.
 
-        // Parse the data
-        if((tpc % 2) == 0)
+    Document Reference: N/A
+*********************************************************************/
+void dl_ce_interp_weights(LIBLTE_PHY_STRUCT          *phy_struct,
+                          LIBLTE_PHY_DL_CE_TYPE_ENUM  ce_type,
+                          float                       noise_ratio)
+{
+    float  r_pp[4][8];
+    float  r_hp[4];
+    float  x;
+    float  pivot;
+    float  factor;
+    int32  pos;
+    uint32 i;
+    uint32 a;
+    uint32 b;
+    uint32 c;
+
+    if(LIBLTE_PHY_DL_CE_TYPE_WIENER == ce_type)
+    {
+        // Invert the CRS autocorrelation plus noise, Gauss-Jordan
+        // elimination of [R_pp | I] without pivoting is safe since
+        // R_pp is positive definite
+        for(a=0; a<4; a++)
         {
-            N_prb_1a = 2;
-        }else{
-            N_prb_1a = 3;
+            for(b=0; b<4; b++)
+            {
+                x             = M_PI*DL_CE_WIENER_DF_TAU*6*((float)a - (float)b);
+                r_pp[a][b]    = (a == b) ? 1 + noise_ratio : sinf(x)/x;
+                r_pp[a][b+4]  = (a == b) ? 1 : 0;
+            }
         }
-        if(DCI_VRB_TYPE_DISTRIBUTED == loc_or_dist)
+        for(a=0; a<4; a++)
         {
-            // FIXME: Figure out gapping
-            // FIXME: Convert to localized blocks
-        }else{
-            // Convert allocation into array of prbs
-            for(i=0; i<alloc->N_prb; i++)
+            pivot = r_pp[a][a];
+            for(c=0; c<8; c++)
             {
-                alloc->prb[0][i] = RB_start + i;
-                alloc->prb[1][i] = RB_start + i;
+                r_pp[a][c] /= pivot;
+            }
+            for(b=0; b<4; b++)
+            {
+                if(b != a)
+                {
+                    factor = r_pp[b][a];
+                    for(c=0; c<8; c++)
+                    {
+                        r_pp[b][c] -= factor*r_pp[a][c];
+                    }
+                }
             }
         }
 
-        // Fill in the allocation structure 3GPP TS 36.213 v10.3.0 section 7.1.7
-        alloc->mod_type       = LIBLTE_PHY_MODULATION_TYPE_QPSK;
-        alloc->pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
-        if(N_ant == 1)
+        // w = r_hp*inv(R_pp + noise_ratio*I)
+        for(i=0; i<DL_CE_N_W_POS; i++)
         {
-            alloc->tx_mode = 1;
-        }else{
-            alloc->tx_mode = 2;
+            pos = (int32)i - 5;
+            for(a=0; a<4; a++)
+            {
+                x       = M_PI*DL_CE_WIENER_DF_TAU*(float)(pos - 6*(int32)a);
+                r_hp[a] = (0 == pos - 6*(int32)a) ? 1 : sinf(x)/x;
+            }
+            for(b=0; b<4; b++)
+            {
+                phy_struct->dl_ce_w[i][b] = 0;
+                for(a=0; a<4; a++)
+                {
+                    phy_struct->dl_ce_w[i][b] += r_hp[a]*r_pp[a][b+4];
+                }
+            }
         }
-        alloc->N_codewords = 1;
-        if(9 >= alloc->mcs)
+    }else{
+        // Linear between the two surrounding CRSs, extrapolating the
+        // first and last pair beyond the edges
+        for(i=0; i<DL_CE_N_W_POS; i++)
         {
-            alloc->tbs = TBS_71721[alloc->mcs][N_prb_1a-1];
-        }else if(16 >= alloc->mcs){
-            alloc->tbs = TBS_71721[alloc->mcs-1][N_prb_1a-1];
-        }else if(28 >= alloc->mcs){
-            alloc->tbs = TBS_71721[alloc->mcs-2][N_prb_1a-1];
-        }else{
-            err = LIBLTE_ERROR_INVALID_CONTENTS;
+            pos = (int32)i - 5;
+            if(pos < 6)
+            {
+                a = 0;
+            }else if(pos < 12){
+                a = 1;
+            }else{
+                a = 2;
+            }
+            x = (float)(pos - 6*(int32)a)/6;
+            for(b=0; b<4; b++)
+            {
+                phy_struct->dl_ce_w[i][b] = 0;
+            }
+            phy_struct->dl_ce_w[i][a]   = 1 - x;
+            phy_struct->dl_ce_w[i][a+1] = x;
         }
-        alloc->rnti = rnti;
-    }else{
-        printf("ERROR: Not handling DCI 1As for C-RNTI\n");
     }
+}
 
-    return(err);
+/*********************************************************************
+    Name: dl_ce_interp_freq
+
+    Description: Interpolates the CRS estimates of one symbol to all
+                 subcarriers, each subcarrier uses the 4 closest CRSs
+                 and the weights for its position relative to them.
+
+    Document Reference: N/A
+*********************************************************************/
+void dl_ce_interp_freq(float  *ls_re,
+                       float  *ls_im,
+                       uint32  N_pilots,
+                       uint32  offset,
+                       float   w[][4],
+                       float  *ce_re,
+                       float  *ce_im)
+{
+    float  *w_k;
+    uint32  N_sc = 6*N_pilots;
+    uint32  s;
+    uint32  k;
+
+    for(k=0; k<N_sc; k++)
+    {
+        // Window of 4 CRSs starting one before k, clamped to the band
+        if(k < (offset + 12))
+        {
+            s = 0;
+        }else{
+            s = (k - offset)/6 - 1;
+            if(s > (N_pilots - 4))
+            {
+                s = N_pilots - 4;
+            }
+        }
+        w_k      = w[k + 5 - (6*s + offset)];
+        ce_re[k] = w_k[0]*ls_re[s] + w_k[1]*ls_re[s+1] + w_k[2]*ls_re[s+2] + w_k[3]*ls_re[s+3];
+        ce_im[k] = w_k[0]*ls_im[s] + w_k[1]*ls_im[s+1] + w_k[2]*ls_im[s+2] + w_k[3]*ls_im[s+3];
+    }
 }
 
 /*********************************************************************
-    Name: dci_1c_pack
+    Name: dl_ce_interp_time_scalar
 
-    Description: Packs all of the fields into the Downlink Control
-                 Information format 1C
+    Description: Linearly interpolates, or extrapolates when frac is
+                 outside of [0, 1], between two symbols of channel
+                 estimates.
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.4
-                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
-                        3GPP TS 36.213 v10.3.0 section 7.1.7
+    Document Reference: N/A
 *********************************************************************/
-// FIXME
+void dl_ce_interp_time_scalar(float  *a_re,
+                              float  *a_im,
+                              float  *b_re,
+                              float  *b_im,
+                              float   frac,
+                              uint32  N,
+                              float  *ce_re,
+                              float  *ce_im)
+{
+    uint32 i;
+
+    for(i=0; i<N; i++)
+    {
+        ce_re[i] = a_re[i] + frac*(b_re[i] - a_re[i]);
+        ce_im[i] = a_im[i] + frac*(b_im[i] - a_im[i]);
+    }
+}
 
+#if defined(__SSE2__)
 /*********************************************************************
-    Name: dci_1c_unpack
+    Name: dl_ce_interp_time_sse2
 
-    Description: Unpacks all of the fields from the Downlink Control
-                 Information format 1C
+    Description: SSE2 version of dl_ce_interp_time_scalar
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.4
-                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
-                        3GPP TS 36.213 v10.3.0 section 7.1.7
+    Document Reference: N/A
+*********************************************************************/
+void dl_ce_interp_time_sse2(float  *a_re,
+                            float  *a_im,
+                            float  *b_re,
+                            float  *b_im,
+                            float   frac,
+                            uint32  N,
+                            float  *ce_re,
+                            float  *ce_im)
+{
+    __m128 frac_v = _mm_set1_ps(frac);
+    __m128 a_v;
+    uint32 i      = 0;
 
-    Notes: Currently only handling SI-RNTI, P-RNTI, and RA-RNTI
+    for(; i+4<=N; i+=4)
+    {
+        a_v = _mm_loadu_ps(&a_re[i]);
+        _mm_storeu_ps(&ce_re[i], _mm_add_ps(a_v, _mm_mul_ps(frac_v, _mm_sub_ps(_mm_loadu_ps(&b_re[i]), a_v))));
+        a_v = _mm_loadu_ps(&a_im[i]);
+        _mm_storeu_ps(&ce_im[i], _mm_add_ps(a_v, _mm_mul_ps(frac_v, _mm_sub_ps(_mm_loadu_ps(&b_im[i]), a_v))));
+    }
+    dl_ce_interp_time_scalar(&a_re[i], &a_im[i], &b_re[i], &b_im[i], frac, N-i, &ce_re[i], &ce_im[i]);
+}
+#endif
+
+#if defined(PHY_KERNEL_X86)
+/*********************************************************************
+    Name: dl_ce_interp_time_avx2
+
+    Description: AVX2 version of dl_ce_interp_time_scalar
+
+    Document Reference: N/A
 *********************************************************************/
-void dci_1c_unpack(uint8                        *in_bits,
-                   uint32                        N_in_bits,
-                   uint16                        rnti,
-                   uint32                        N_rb_dl,
-                   uint8                         N_ant,
-                   LIBLTE_PHY_ALLOCATION_STRUCT *alloc)
+PHY_TARGET_AVX2
+void dl_ce_interp_time_avx2(float  *a_re,
+                            float  *a_im,
+                            float  *b_re,
+                            float  *b_im,
+                            float   frac,
+                            uint32  N,
+                            float  *ce_re,
+                            float  *ce_im)
 {
-    uint32  RB_start = 0;
-    uint32  RIV;
-    uint32  RIV_length;
-    uint32  i;
-    uint32  idash;
-    uint32  j;
-    uint32  jdash;
-    uint32  gap_ind;
-    uint32  N_gap;
-    uint32  N_vrb_gap1_dl;
-    uint32  N_vrb_gap2_dl;
-    uint32  N_vrb_dl;
-    uint32  Ndash_vrb_dl;
-    uint32  N_rb_step;
-    uint32  Ntilde_vrb_dl;
-    uint32  P;
-    uint32  N_row;
-    uint32  N_col;
-    uint32  N_null;
-    uint32  n_vrb;
-    uint32  ntilde_vrb;
-    uint32  ntildedash_prb;
-    uint32  ntildedashdash_prb;
-    uint32  ntilde_prb_even;
-    uint32  ntilde_prb_odd;
-    uint32  n_prb_even;
-    uint32  n_prb_odd;
-    uint8  *dci = in_bits;
+    __m256 frac_v = _mm256_set1_ps(frac);
+    __m256 a_v;
+    uint32 i      = 0;
 
-    if(N_rb_dl < 50)
+    for(; i+8<=N; i+=8)
     {
-        gap_ind = 0;
-    }else{
-        gap_ind = liblte_bits_2_value(&dci, 1);
+        a_v = _mm256_loadu_ps(&a_re[i]);
+        _mm256_storeu_ps(&ce_re[i], _mm256_add_ps(a_v, _mm256_mul_ps(frac_v, _mm256_sub_ps(_mm256_loadu_ps(&b_re[i]), a_v))));
+        a_v = _mm256_loadu_ps(&a_im[i]);
+        _mm256_storeu_ps(&ce_im[i], _mm256_add_ps(a_v, _mm256_mul_ps(frac_v, _mm256_sub_ps(_mm256_loadu_ps(&b_im[i]), a_v))));
     }
+    dl_ce_interp_time_scalar(&a_re[i], &a_im[i], &b_re[i], &b_im[i], frac, N-i, &ce_re[i], &ce_im[i]);
+}
 
-    if(N_rb_dl <= 10)
+/*********************************************************************
+    Name: dl_ce_interp_time_avx512
+
+    Description: AVX-512 version of dl_ce_interp_time_scalar
+
+    Document Reference: N/A
+*********************************************************************/
+PHY_TARGET_AVX512
+void dl_ce_interp_time_avx512(float  *a_re,
+                              float  *a_im,
+                              float  *b_re,
+                              float  *b_im,
+                              float   frac,
+                              uint32  N,
+                              float  *ce_re,
+                              float  *ce_im)
+{
+    __m512 frac_v = _mm512_set1_ps(frac);
+    __m512 a_v;
+    uint32 i      = 0;
+
+    for(; i+16<=N; i+=16)
     {
-        N_gap = (uint32)ceilf(N_rb_dl/2.0);
-    }else if(N_rb_dl == 11){
-        N_gap = 4;
-    }else if(N_rb_dl <= 19){
-        N_gap = 8;
-    }else if(N_rb_dl <= 26){
-        N_gap = 12;
-    }else if(N_rb_dl <= 44){
-        N_gap = 18;
-    }else if(N_rb_dl <= 49){
-        N_gap = 27;
-    }else if(N_rb_dl <= 63){
-        N_gap = (gap_ind == 0) ? 27 : 9;
-    }else if(N_rb_dl <= 70){
-        N_gap = (gap_ind == 0) ? 32 : 16;
-    }else{
-        N_gap = (gap_ind == 0) ? 48 : 16;
+        a_v = _mm512_loadu_ps(&a_re[i]);
+        _mm512_storeu_ps(&ce_re[i], _mm512_add_ps(a_v, _mm512_mul_ps(frac_v, _mm512_sub_ps(_mm512_loadu_ps(&b_re[i]), a_v))));
+        a_v = _mm512_loadu_ps(&a_im[i]);
+        _mm512_storeu_ps(&ce_im[i], _mm512_add_ps(a_v, _mm512_mul_ps(frac_v, _mm512_sub_ps(_mm512_loadu_ps(&b_im[i]), a_v))));
     }
+    dl_ce_interp_time_scalar(&a_re[i], &a_im[i], &b_re[i], &b_im[i], frac, N-i, &ce_re[i], &ce_im[i]);
+}
+#endif
 
-    if(N_gap < (N_rb_dl-N_gap))
+/*********************************************************************
+    Name: fftw_wisdom_filename
+
+    Description: Builds the wisdom file name for this CPU and sample
+                 rate, the CPU is identified by a hash of its model
+                 name and feature flags.
+
+    Document Reference: N/A
+*********************************************************************/
+void fftw_wisdom_filename(uint32  fs,
+                          char   *filename)
+{
+    FILE   *cpuinfo;
+    char    line[1024];
+    uint32  cpu_hash = 2166136261U;
+    uint32  i;
+    bool    model_found = false;
+    bool    flags_found = false;
+
+    // FNV-1a over the first model name and flags lines of /proc/cpuinfo
+    cpuinfo = fopen("/proc/cpuinfo", "r");
+    if(NULL != cpuinfo)
     {
-        N_vrb_gap1_dl = 2 * N_gap;
-    }else{
-        N_vrb_gap1_dl = 2 * (N_rb_dl-N_gap);
+        while((!model_found || !flags_found) &&
+              NULL != fgets(line, sizeof(line), cpuinfo))
+        {
+            if((!model_found && 0 == strncmp(line, "model name", 10)) ||
+               (!flags_found && 0 == strncmp(line, "flags", 5)))
+            {
+                if('m' == line[0])
+                {
+                    model_found = true;
+                }else{
+                    flags_found = true;
+                }
+                for(i=0; '\0' != line[i]; i++)
+                {
+                    cpu_hash = (cpu_hash ^ (uint8)line[i]) * 16777619U;
+                }
+            }
+        }
+        fclose(cpuinfo);
     }
 
-    N_vrb_gap2_dl = (N_rb_dl/(2*N_gap)) * 2 * N_gap;
+    snprintf(filename,
+             FFTW_WISDOM_FILENAME_MAX,
+             "%s/liblte_fftw_wisdom_%08X_%u.dat",
+             FFTW_WISDOM_PATH,
+             cpu_hash,
+             fs);
+}
+
+/*********************************************************************
+    Name: fftw_wisdom_import
+
+    Description: Imports stored wisdom ahead of FFT plan creation and
+                 returns a snapshot of the wisdom, to be handed to
+                 fftw_wisdom_export once the plans are created.
+
+    Document Reference: N/A
+*********************************************************************/
+char* fftw_wisdom_import(uint32 fs)
+{
+    char filename[FFTW_WISDOM_FILENAME_MAX];
 
-    if(gap_ind == 0)
+    if('\0' == FFTW_WISDOM_PATH[0])
     {
-        N_vrb_dl = N_vrb_gap1_dl;
-    }else{
-        N_vrb_dl = N_vrb_gap2_dl;
+        return(NULL);
     }
 
-    if(N_rb_dl <= 49)
-    {
-        N_rb_step = 2;
-    }else{
-        N_rb_step = 4;
-    }
+    fftw_wisdom_filename(fs, filename);
+    fftwf_import_wisdom_from_filename(filename);
 
-    Ntilde_vrb_dl = (gap_ind == 0) ? N_vrb_dl : 2*N_gap;
+    return(fftwf_export_wisdom_to_string());
+}
 
-    if(LIBLTE_MAC_SI_RNTI        == rnti ||
-       LIBLTE_MAC_P_RNTI         == rnti ||
-       (LIBLTE_MAC_RA_RNTI_START <= rnti &&
-        LIBLTE_MAC_RA_RNTI_END   >= rnti))
+/*********************************************************************
+    Name: fftw_wisdom_export
+
+    Description: Stores the wisdom if plan creation added to it since
+                 the snapshot was taken, and frees the snapshot.
+
+    Document Reference: N/A
+*********************************************************************/
+void fftw_wisdom_export(uint32  fs,
+                        char   *snapshot)
+{
+    char   filename[FFTW_WISDOM_FILENAME_MAX];
+    char   tmp_filename[FFTW_WISDOM_FILENAME_MAX + 8];
+    char  *wisdom;
+    size_t N_bytes;
+    int    fd;
+    bool   written;
+
+    if(NULL == snapshot)
     {
-        RIV_length = ceilf(logf((N_vrb_gap1_dl/N_rb_step) * ((N_vrb_gap1_dl/N_rb_step)+1) / 2.0)/logf(2));
-        RIV        = liblte_bits_2_value(&dci, RIV_length);
+        return;
+    }
 
-        for(i=N_rb_step; i<=(N_vrb_dl/N_rb_step)*N_rb_step; i+=N_rb_step) // L_crb running variable N_rb_step to floor(N_vrb_dl/N_rb_step)*N_rb_step
-        {
-            for(j=0; j<=((N_vrb_dl/N_rb_step)-1)*N_rb_step; j+=N_rb_step) // RB_start running variable 0 to (floor(N_vrb_dl/N_rb_step)-1)*N_rb_step
+    wisdom = fftwf_export_wisdom_to_string();
+    if(NULL != wisdom &&
+       0    != strcmp(wisdom, snapshot))
+    {
+        // Write a uniquely named temporary file next to the store and
+        // rename it so that a crash part way through never leaves a
+        // truncated store behind
+        fftw_wisdom_filename(fs, filename);
+        snprintf(tmp_filename, sizeof(tmp_filename), "%s.XXXXXX", filename);
+        fd = mkstemp(tmp_filename);
+        if(-1 != fd)
+        {
+            N_bytes = strlen(wisdom);
+            written = (N_bytes == (size_t)write(fd, wisdom, N_bytes));
+            if(0 != close(fd) ||
+               !written       ||
+               0 != rename(tmp_filename, filename))
             {
-                idash        = i/N_rb_step;
-                jdash        = j/N_rb_step;
-                Ndash_vrb_dl = N_vrb_dl/N_rb_step;
-
-                if((idash-1) <= (Ndash_vrb_dl/2))
-                {
-                    if(RIV == (Ndash_vrb_dl*(idash-1)+jdash)) // RB_start to RB_start+alloc->N_prb gives n_vrb(i).  These are then mapped to PRBs as below
-                    {
-                        alloc->N_prb = i;
-                        RB_start     = j;
-                    }
-                }else{
-                    if(RIV == (Ndash_vrb_dl*(Ndash_vrb_dl-idash+1)+(Ndash_vrb_dl-1-jdash)))
-                    {
-                        alloc->N_prb = i;
-                        RB_start     = j;
-                    }
-                }
+                unlink(tmp_filename);
             }
         }
-        // Extract the rest of the fields
-        alloc->mcs = liblte_bits_2_value(&dci, 5);
+    }
+    fftwf_free(wisdom);
+    fftwf_free(snapshot);
+}
 
-        // Convert allocation into array of PRBs
-        // Calculate Resource Block Group size (P)
-        if(N_rb_dl <= 10)
-        {
-            P = 1;
-        }else if(N_rb_dl <= 26){
-            P = 2;
-        }else if(N_rb_dl <= 63){
-            P = 3;
-        }else{
-            P = 4;
-        }
+/*********************************************************************
+    Name: phy_kernel_select
 
-        N_col  = 4;
-        N_row  = ceilf(Ntilde_vrb_dl/(4.0*P)) * P;
-        N_null = 4*N_row - Ntilde_vrb_dl;
-        n_vrb  = RB_start;
+    Description: Fills PHY_KERNELS with the best implementation of each
+                 DSP kernel for this CPU.  LIBLTE_PHY_SIMD_ENV_VAR can
+                 select a lower instruction set, for comparing the
+                 implementations, but never one the CPU lacks.  Each
+                 level starts from the one below it so kernels without
+                 a version for an instruction set keep the best lower
+                 one.
 
-        // 3GPP TS 36.211 v10.6.0 section 6.2.3.2
-        for(i=0; i<alloc->N_prb; i++)
+    Document Reference: N/A
+*********************************************************************/
+void phy_kernel_select(void)
+{
+    LIBLTE_PHY_SIMD_ENUM  cpu_simd = LIBLTE_PHY_SIMD_SCALAR;
+    LIBLTE_PHY_SIMD_ENUM  env_simd;
+    char                 *env;
+    uint32                i;
+
+    // Detect the CPU's instruction sets, SSE2 kernels are only built
+    // when the compiler baseline includes SSE2
+#if defined(PHY_KERNEL_X86)
+    __builtin_cpu_init();
+#if defined(__SSE2__)
+    cpu_simd = LIBLTE_PHY_SIMD_SSE2;
+    if(__builtin_cpu_supports("sse4.1"))
+    {
+        cpu_simd = LIBLTE_PHY_SIMD_SSE4_1;
+        if(__builtin_cpu_supports("avx2"))
         {
-            ntilde_vrb         = n_vrb % Ntilde_vrb_dl;
-            ntildedash_prb     = 2*N_row*(ntilde_vrb % 2) + (ntilde_vrb/2) + Ntilde_vrb_dl*(n_vrb/Ntilde_vrb_dl);
-            ntildedashdash_prb = N_row*(ntilde_vrb % 4) + (ntilde_vrb/4) + Ntilde_vrb_dl*(n_vrb/Ntilde_vrb_dl);
-            // even slot
-            if((N_null != 0) && (ntilde_vrb >= (Ntilde_vrb_dl-N_null)) && (ntilde_vrb%2 == 1))
-            {
-                ntilde_prb_even = ntildedash_prb - N_row;
-            }else if((N_null != 0) && (ntilde_vrb >= (Ntilde_vrb_dl-N_null)) && (ntilde_vrb%2 == 0)){
-                ntilde_prb_even = ntildedash_prb - N_row + N_null/2;
-            }else if((N_null != 0) && (ntilde_vrb < (Ntilde_vrb_dl-N_null)) && (ntilde_vrb%4 >= 2)){
-                ntilde_prb_even = ntildedashdash_prb - N_null/2;
-            }else{
-                ntilde_prb_even = ntildedashdash_prb;
-            }
-            // odd slot
-            ntilde_prb_odd = (ntilde_prb_even + Ntilde_vrb_dl/2)%Ntilde_vrb_dl + Ntilde_vrb_dl * (n_vrb/Ntilde_vrb_dl);
-
-            // even slot
-            if(ntilde_prb_even < Ntilde_vrb_dl/2)
+            cpu_simd = LIBLTE_PHY_SIMD_AVX2;
+            if(__builtin_cpu_supports("avx512f"))
             {
-                n_prb_even = ntilde_prb_even;
-            }else{
-                n_prb_even = ntilde_prb_even + N_gap - Ntilde_vrb_dl/2;
+                cpu_simd = LIBLTE_PHY_SIMD_AVX512;
             }
+        }
+    }
+#endif
+#endif
+    PHY_SIMD = cpu_simd;
 
-            // odd slot
-            if(ntilde_prb_odd < Ntilde_vrb_dl/2)
+    // Environment override
+    env = getenv(LIBLTE_PHY_SIMD_ENV_VAR);
+    if(NULL != env)
+    {
+        env_simd = LIBLTE_PHY_SIMD_N_ITEMS;
+        for(i=0; i<LIBLTE_PHY_SIMD_N_ITEMS; i++)
+        {
+            if(0 == strcmp(env, liblte_phy_simd_text[i]))
             {
-                n_prb_odd = ntilde_prb_odd;
-            }else{
-                n_prb_odd = ntilde_prb_odd + N_gap - Ntilde_vrb_dl/2;
+                env_simd = (LIBLTE_PHY_SIMD_ENUM)i;
             }
-
-            alloc->prb[0][i] = n_prb_even;
-            alloc->prb[1][i] = n_prb_odd;
-            n_vrb++;
         }
-
-        // Fill in the allocation structure 3GPP TS 36.213 v10.3.0 section 7.1.7
-        alloc->mod_type       = LIBLTE_PHY_MODULATION_TYPE_QPSK;
-        alloc->pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
-        if(N_ant == 1)
+        if(LIBLTE_PHY_SIMD_N_ITEMS == env_simd)
         {
-            alloc->tx_mode = 1;
+            fprintf(stderr, "WARNING: Unknown %s value %s\n", LIBLTE_PHY_SIMD_ENV_VAR, env);
+        }else if(env_simd > cpu_simd){
+            fprintf(stderr, "WARNING: %s=%s is not supported by this CPU\n", LIBLTE_PHY_SIMD_ENV_VAR, env);
         }else{
-            alloc->tx_mode = 2;
+            PHY_SIMD = env_simd;
         }
-        alloc->N_codewords = 1;
-        alloc->tbs         = TBS_71723[alloc->mcs];
-        alloc->rnti        = rnti;
-    }else{
-        printf("ERROR: Not handling DCI 1Cs for C-RNTI\n");
     }
+
+    PHY_KERNELS.cmul                     = cmul_scalar;
+    PHY_KERNELS.cmul_conj                = cmul_conj_scalar;
+    PHY_KERNELS.cmul_conj_interleaved    = cmul_conj_interleaved_scalar;
+    PHY_KERNELS.sss_correlate            = sss_correlate_scalar;
+    PHY_KERNELS.normalize_unit_magnitude = normalize_unit_magnitude_scalar;
+    PHY_KERNELS.dl_ce_interp_time        = dl_ce_interp_time_scalar;
+    PHY_KERNELS.modulation_demapper_llr  = modulation_demapper_llr_scalar;
+    PHY_KERNELS.viterbi_acs              = viterbi_acs_scalar;
+    PHY_KERNELS.turbo_map_recursions     = turbo_map_recursions_scalar;
+#if defined(__SSE2__)
+    if(PHY_SIMD >= LIBLTE_PHY_SIMD_SSE2)
+    {
+        PHY_KERNELS.cmul                     = cmul_sse2;
+        PHY_KERNELS.cmul_conj                = cmul_conj_sse2;
+        PHY_KERNELS.cmul_conj_interleaved    = cmul_conj_interleaved_sse2;
+        PHY_KERNELS.sss_correlate            = sss_correlate_sse2;
+        PHY_KERNELS.normalize_unit_magnitude = normalize_unit_magnitude_sse2;
+        PHY_KERNELS.dl_ce_interp_time        = dl_ce_interp_time_sse2;
+        PHY_KERNELS.modulation_demapper_llr  = modulation_demapper_llr_sse2;
+        PHY_KERNELS.viterbi_acs              = viterbi_acs_sse2;
+        PHY_KERNELS.turbo_map_recursions     = turbo_map_recursions_sse2;
+    }
+#endif
+#if defined(PHY_KERNEL_X86)
+    if(PHY_SIMD >= LIBLTE_PHY_SIMD_SSE4_1)
+    {
+        PHY_KERNELS.turbo_map_recursions = turbo_map_recursions_sse4_1;
+    }
+    if(PHY_SIMD >= LIBLTE_PHY_SIMD_AVX2)
+    {
+        PHY_KERNELS.cmul                     = cmul_avx2;
+        PHY_KERNELS.cmul_conj                = cmul_conj_avx2;
+        PHY_KERNELS.cmul_conj_interleaved    = cmul_conj_interleaved_avx2;
+        PHY_KERNELS.sss_correlate            = sss_correlate_avx2;
+        PHY_KERNELS.normalize_unit_magnitude = normalize_unit_magnitude_avx2;
+        PHY_KERNELS.dl_ce_interp_time        = dl_ce_interp_time_avx2;
+        PHY_KERNELS.viterbi_acs              = viterbi_acs_avx2;
+    }
+    if(PHY_SIMD >= LIBLTE_PHY_SIMD_AVX512)
+    {
+        PHY_KERNELS.cmul                     = cmul_avx512;
+        PHY_KERNELS.cmul_conj                = cmul_conj_avx512;
+        PHY_KERNELS.sss_correlate            = sss_correlate_avx512;
+        PHY_KERNELS.normalize_unit_magnitude = normalize_unit_magnitude_avx512;
+        PHY_KERNELS.dl_ce_interp_time        = dl_ce_interp_time_avx512;
+    }
+#endif
 }
 
 /*********************************************************************
-    Name: cfi_channel_encode
+    Name: cmul_scalar
 
-    Description: Channel encodes the Control Format Indicator channel
+    Description: Multiplies two complex vectors, y = a*b
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.4
+    Document Reference: N/A
 *********************************************************************/
-void cfi_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                        uint32             cfi,
-                        uint8             *out_bits,
-                        uint32            *N_out_bits)
+void cmul_scalar(float  *a_re,
+                 float  *a_im,
+                 float  *b_re,
+                 float  *b_im,
+                 uint32  N,
+                 float  *y_re,
+                 float  *y_im)
 {
-    uint32  i;
-    uint8  *cfi_bits;
+    uint32 i;
 
-    *N_out_bits = 32;
-    if(1 == cfi)
+    for(i=0; i<N; i++)
     {
-        cfi_bits = CFI_BITS_1;
-    }else if(2 == cfi){
-        cfi_bits = CFI_BITS_2;
-    }else if(3 == cfi){
-        cfi_bits = CFI_BITS_3;
-    }else{
-        cfi_bits = CFI_BITS_4;
+        y_re[i] = a_re[i]*b_re[i] - a_im[i]*b_im[i];
+        y_im[i] = a_re[i]*b_im[i] + a_im[i]*b_re[i];
     }
-    for(i=0; i<*N_out_bits; i++)
+}
+
+/*********************************************************************
+    Name: cmul_conj_scalar
+
+    Description: Multiplies the conjugate of one complex vector with
+                 another, y = conj(a)*b
+
+    Document Reference: N/A
+*********************************************************************/
+void cmul_conj_scalar(float  *a_re,
+                      float  *a_im,
+                      float  *b_re,
+                      float  *b_im,
+                      uint32  N,
+                      float  *y_re,
+                      float  *y_im)
+{
+    uint32 i;
+
+    for(i=0; i<N; i++)
     {
-        out_bits[i] = cfi_bits[i];
+        y_re[i] = a_re[i]*b_re[i] + a_im[i]*b_im[i];
+        y_im[i] = a_re[i]*b_im[i] - a_im[i]*b_re[i];
     }
 }
 
 /*********************************************************************
-    Name: cfi_channel_decode
+    Name: cmul_conj_interleaved_scalar
 
-    Description: Channel decodes the Control Format Indicator channel
+    Description: Multiplies the conjugate of one complex vector with
+                 another, y = conj(a)*b, writing interleaved output
+                 for FFTW
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.4
+    Document Reference: N/A
 *********************************************************************/
-LIBLTE_ERROR_ENUM cfi_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                     float             *in_bits,
-                                     uint32             N_in_bits,
-                                     uint32            *cfi)
+void cmul_conj_interleaved_scalar(float         *a_re,
+                                  float         *a_im,
+                                  float         *b_re,
+                                  float         *b_im,
+                                  uint32         N,
+                                  fftwf_complex *y)
 {
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_CRC;
-    uint32            i;
-    uint32            ber[4] = {0,0,0,0};
-    uint32            min_ber;
-    uint32            cfi_num;
-    uint8             in_bit;
+    uint32 i;
 
-    // Calculate the number of bit errors for each CFI
-    for(i=0; i<N_in_bits; i++)
+    for(i=0; i<N; i++)
     {
-        // Convert from soft NRZ to hard bit
-        if(in_bits[i] >= 0)
-        {
-            in_bit = 0;
-        }else{
-            in_bit = 1;
-        }
+        y[i][0] = a_re[i]*b_re[i] + a_im[i]*b_im[i];
+        y[i][1] = a_re[i]*b_im[i] - a_im[i]*b_re[i];
+    }
+}
 
-        if(CFI_BITS_1[i] != in_bit)
-        {
-            ber[0]++;
-        }
-        if(CFI_BITS_2[i] != in_bit)
-        {
-            ber[1]++;
-        }
-        if(CFI_BITS_3[i] != in_bit)
-        {
-            ber[2]++;
-        }
-        if(CFI_BITS_4[i] != in_bit)
-        {
-            ber[3]++;
-        }
+#if defined(__SSE2__)
+/*********************************************************************
+    Name: cmul_sse2
+
+    Description: SSE2 version of cmul_scalar
+
+    Document Reference: N/A
+*********************************************************************/
+void cmul_sse2(float  *a_re,
+               float  *a_im,
+               float  *b_re,
+               float  *b_im,
+               uint32  N,
+               float  *y_re,
+               float  *y_im)
+{
+    __m128 ar_v;
+    __m128 ai_v;
+    __m128 br_v;
+    __m128 bi_v;
+    uint32 i = 0;
+
+    for(; i+4<=N; i+=4)
+    {
+        ar_v = _mm_loadu_ps(&a_re[i]);
+        ai_v = _mm_loadu_ps(&a_im[i]);
+        br_v = _mm_loadu_ps(&b_re[i]);
+        bi_v = _mm_loadu_ps(&b_im[i]);
+        _mm_storeu_ps(&y_re[i], _mm_sub_ps(_mm_mul_ps(ar_v, br_v), _mm_mul_ps(ai_v, bi_v)));
+        _mm_storeu_ps(&y_im[i], _mm_add_ps(_mm_mul_ps(ar_v, bi_v), _mm_mul_ps(ai_v, br_v)));
     }
+    cmul_scalar(&a_re[i], &a_im[i], &b_re[i], &b_im[i], N-i, &y_re[i], &y_im[i]);
+}
 
-    // Find the CFI with the least number of bit errors
-    min_ber = 32;
-    for(i=0; i<4; i++)
+/*********************************************************************
+    Name: cmul_conj_sse2
+
+    Description: SSE2 version of cmul_conj_scalar
+
+    Document Reference: N/A
+*********************************************************************/
+void cmul_conj_sse2(float  *a_re,
+                    float  *a_im,
+                    float  *b_re,
+                    float  *b_im,
+                    uint32  N,
+                    float  *y_re,
+                    float  *y_im)
+{
+    __m128 ar_v;
+    __m128 ai_v;
+    __m128 br_v;
+    __m128 bi_v;
+    uint32 i = 0;
+
+    for(; i+4<=N; i+=4)
     {
-        if(ber[i] < min_ber)
-        {
-            min_ber = ber[i];
-            cfi_num = i+1;
-        }
+        ar_v = _mm_loadu_ps(&a_re[i]);
+        ai_v = _mm_loadu_ps(&a_im[i]);
+        br_v = _mm_loadu_ps(&b_re[i]);
+        bi_v = _mm_loadu_ps(&b_im[i]);
+        _mm_storeu_ps(&y_re[i], _mm_add_ps(_mm_mul_ps(ar_v, br_v), _mm_mul_ps(ai_v, bi_v)));
+        _mm_storeu_ps(&y_im[i], _mm_sub_ps(_mm_mul_ps(ar_v, bi_v), _mm_mul_ps(ai_v, br_v)));
     }
+    cmul_conj_scalar(&a_re[i], &a_im[i], &b_re[i], &b_im[i], N-i, &y_re[i], &y_im[i]);
+}
 
-    // Make sure the number of bit errors is acceptably low
-    if(min_ber < CFI_N_ACCEPTABLE_BERS)
+/*********************************************************************
+    Name: cmul_conj_interleaved_sse2
+
+    Description: SSE2 version of cmul_conj_interleaved_scalar
+
+    Document Reference: N/A
+*********************************************************************/
+void cmul_conj_interleaved_sse2(float         *a_re,
+                                float         *a_im,
+                                float         *b_re,
+                                float         *b_im,
+                                uint32         N,
+                                fftwf_complex *y)
+{
+    __m128 ar_v;
+    __m128 ai_v;
+    __m128 br_v;
+    __m128 bi_v;
+    __m128 re_v;
+    __m128 im_v;
+    uint32 i = 0;
+
+    for(; i+4<=N; i+=4)
     {
-        *cfi = cfi_num;
-        err  = LIBLTE_SUCCESS;
+        ar_v = _mm_loadu_ps(&a_re[i]);
+        ai_v = _mm_loadu_ps(&a_im[i]);
+        br_v = _mm_loadu_ps(&b_re[i]);
+        bi_v = _mm_loadu_ps(&b_im[i]);
+        re_v = _mm_add_ps(_mm_mul_ps(ar_v, br_v), _mm_mul_ps(ai_v, bi_v));
+        im_v = _mm_sub_ps(_mm_mul_ps(ar_v, bi_v), _mm_mul_ps(ai_v, br_v));
+        _mm_storeu_ps(&y[i][0],   _mm_unpacklo_ps(re_v, im_v));
+        _mm_storeu_ps(&y[i+2][0], _mm_unpackhi_ps(re_v, im_v));
     }
+    cmul_conj_interleaved_scalar(&a_re[i], &a_im[i], &b_re[i], &b_im[i], N-i, &y[i]);
+}
+#endif
 
-    return(err);
+#if defined(PHY_KERNEL_X86)
+/*********************************************************************
+    Name: cmul_avx2
+
+    Description: AVX2 version of cmul_scalar
+
+    Document Reference: N/A
+*********************************************************************/
+PHY_TARGET_AVX2
+void cmul_avx2(float  *a_re,
+               float  *a_im,
+               float  *b_re,
+               float  *b_im,
+               uint32  N,
+               float  *y_re,
+               float  *y_im)
+{
+    __m256 ar_v;
+    __m256 ai_v;
+    __m256 br_v;
+    __m256 bi_v;
+    uint32 i = 0;
+
+    for(; i+8<=N; i+=8)
+    {
+        ar_v = _mm256_loadu_ps(&a_re[i]);
+        ai_v = _mm256_loadu_ps(&a_im[i]);
+        br_v = _mm256_loadu_ps(&b_re[i]);
+        bi_v = _mm256_loadu_ps(&b_im[i]);
+        _mm256_storeu_ps(&y_re[i], _mm256_sub_ps(_mm256_mul_ps(ar_v, br_v), _mm256_mul_ps(ai_v, bi_v)));
+        _mm256_storeu_ps(&y_im[i], _mm256_add_ps(_mm256_mul_ps(ar_v, bi_v), _mm256_mul_ps(ai_v, br_v)));
+    }
+    cmul_scalar(&a_re[i], &a_im[i], &b_re[i], &b_im[i], N-i, &y_re[i], &y_im[i]);
 }
 
 /*********************************************************************
-    Name: get_ul_ce
+    Name: cmul_conj_avx2
 
-    Description: Resolves channel estimates for the uplink
+    Description: AVX2 version of cmul_conj_scalar
 
     Document Reference: N/A
 *********************************************************************/
-void get_ul_ce(LIBLTE_PHY_STRUCT *phy_struct,
-               float             *c_est_0_re,
-               float             *c_est_0_im,
-               float             *c_est_1_re,
-               float             *c_est_1_im,
-               uint32             N_prb,
-               uint32             N_subfr,
-               float             *c_est_re,
-               float             *c_est_im)
+PHY_TARGET_AVX2
+void cmul_conj_avx2(float  *a_re,
+                    float  *a_im,
+                    float  *b_re,
+                    float  *b_im,
+                    uint32  N,
+                    float  *y_re,
+                    float  *y_im)
 {
-    float  *dmrs_0_re;
-    float  *dmrs_0_im;
-    float  *dmrs_1_re;
-    float  *dmrs_1_im;
-    float   tmp_re;
-    float   tmp_im;
-    float   mag_0;
-    float   mag_1;
-    float   ang_0;
-    float   ang_1;
-    float   frac_mag;
-    float   frac_ang;
-    float   ce_mag[12];
-    float   ce_ang[12];
-    uint32  i;
-    uint32  L;
-    uint32  M_pusch_sc = N_prb * phy_struct->N_sc_rb_ul;
-
-    dmrs_0_re = phy_struct->dmrs_0_re[N_subfr][N_prb];
-    dmrs_0_im = phy_struct->dmrs_0_im[N_subfr][N_prb];
-    dmrs_1_re = phy_struct->dmrs_1_re[N_subfr][N_prb];
-    dmrs_1_im = phy_struct->dmrs_1_im[N_subfr][N_prb];
+    __m256 ar_v;
+    __m256 ai_v;
+    __m256 br_v;
+    __m256 bi_v;
+    uint32 i = 0;
 
-    for(i=0; i<M_pusch_sc; i++)
+    for(; i+8<=N; i+=8)
     {
-        tmp_re = c_est_0_re[i]*dmrs_0_re[i] + c_est_0_im[i]*dmrs_0_im[i];
-        tmp_im = c_est_0_im[i]*dmrs_0_re[i] - c_est_0_re[i]*dmrs_0_im[i];
-        mag_0  = sqrt(tmp_re*tmp_re + tmp_im*tmp_im);
-        ang_0  = atan2f(tmp_im, tmp_re);
-        tmp_re = c_est_1_re[i]*dmrs_1_re[i] + c_est_1_im[i]*dmrs_1_im[i];
-        tmp_im = c_est_1_im[i]*dmrs_1_re[i] - c_est_1_re[i]*dmrs_1_im[i];
-        mag_1  = sqrt(tmp_re*tmp_re + tmp_im*tmp_im);
-        ang_1  = atan2f(tmp_im, tmp_re);
-
-        frac_mag = (mag_1 - mag_0)/7;
-        frac_ang = (ang_1 - ang_0);
-        if(frac_ang >= M_PI) // Wrap angle
-        {
-            frac_ang -= 2*M_PI;
-        }else if(frac_ang <= -M_PI){
-            frac_ang += 2*M_PI;
-        }
-        frac_ang /= 7;
-
-        for(L=0; L<3; L++)
-        {
-            ce_mag[L]   = mag_0 - (3-L)*frac_mag;
-            ce_ang[L]   = ang_0 - (3-L)*frac_ang;
-            ce_mag[3+L] = mag_0 + (1+L)*frac_mag;
-            ce_ang[3+L] = ang_0 + (1+L)*frac_ang;
-            ce_mag[6+L] = mag_1 - (3-L)*frac_mag;
-            ce_ang[6+L] = ang_1 - (3-L)*frac_ang;
-            ce_mag[9+L] = mag_1 + (1+L)*frac_mag;
-            ce_ang[9+L] = ang_1 + (1+L)*frac_ang;
-        }
-        for(L=0; L<12; L++)
-        {
-            c_est_re[L*M_pusch_sc + i] = ce_mag[L]*cos(ce_ang[L]);
-            c_est_im[L*M_pusch_sc + i] = ce_mag[L]*sin(ce_ang[L]);
-        }
+        ar_v = _mm256_loadu_ps(&a_re[i]);
+        ai_v = _mm256_loadu_ps(&a_im[i]);
+        br_v = _mm256_loadu_ps(&b_re[i]);
+        bi_v = _mm256_loadu_ps(&b_im[i]);
+        _mm256_storeu_ps(&y_re[i], _mm256_add_ps(_mm256_mul_ps(ar_v, br_v), _mm256_mul_ps(ai_v, bi_v)));
+        _mm256_storeu_ps(&y_im[i], _mm256_sub_ps(_mm256_mul_ps(ar_v, bi_v), _mm256_mul_ps(ai_v, br_v)));
     }
+    cmul_conj_scalar(&a_re[i], &a_im[i], &b_re[i], &b_im[i], N-i, &y_re[i], &y_im[i]);
 }
 
 /*********************************************************************
-    Name: get_soft_decision
+    Name: cmul_conj_interleaved_avx2
 
-    Description: Determines the magnitude of the soft decision
+    Description: AVX2 version of cmul_conj_interleaved_scalar.  The
+                 unpacks work within each 128 bit lane so the lanes
+                 are swapped back into order before storing.
 
     Document Reference: N/A
 *********************************************************************/
-float get_soft_decision(float rx_re,
-                        float rx_im,
-                        float exp_re,
-                        float exp_im,
-                        float max_dist)
+PHY_TARGET_AVX2
+void cmul_conj_interleaved_avx2(float         *a_re,
+                                float         *a_im,
+                                float         *b_re,
+                                float         *b_im,
+                                uint32         N,
+                                fftwf_complex *y)
 {
-    float diff_re;
-    float diff_im;
-    float dist;
-
-    diff_re = rx_re - exp_re;
-    diff_im = rx_im - exp_im;
-    dist    = sqrt(diff_re*diff_re + diff_im*diff_im);
+    __m256 ar_v;
+    __m256 ai_v;
+    __m256 br_v;
+    __m256 bi_v;
+    __m256 re_v;
+    __m256 im_v;
+    __m256 lo_v;
+    __m256 hi_v;
+    uint32 i = 0;
 
-    if(dist >= (max_dist - (max_dist/120)))
+    for(; i+8<=N; i+=8)
     {
-        dist = max_dist - (max_dist/120);
+        ar_v = _mm256_loadu_ps(&a_re[i]);
+        ai_v = _mm256_loadu_ps(&a_im[i]);
+        br_v = _mm256_loadu_ps(&b_re[i]);
+        bi_v = _mm256_loadu_ps(&b_im[i]);
+        re_v = _mm256_add_ps(_mm256_mul_ps(ar_v, br_v), _mm256_mul_ps(ai_v, bi_v));
+        im_v = _mm256_sub_ps(_mm256_mul_ps(ar_v, bi_v), _mm256_mul_ps(ai_v, br_v));
+        lo_v = _mm256_unpacklo_ps(re_v, im_v);
+        hi_v = _mm256_unpackhi_ps(re_v, im_v);
+        _mm256_storeu_ps(&y[i][0],   _mm256_permute2f128_ps(lo_v, hi_v, 0x20));
+        _mm256_storeu_ps(&y[i+4][0], _mm256_permute2f128_ps(lo_v, hi_v, 0x31));
     }
-
-    return(max_dist - dist);
+    cmul_conj_interleaved_scalar(&a_re[i], &a_im[i], &b_re[i], &b_im[i], N-i, &y[i]);
 }
-float get_soft_decision(float rx,
-                        float exp,
-                        float max_dist)
+
+/*********************************************************************
+    Name: cmul_avx512
+
+    Description: AVX-512 version of cmul_scalar
+
+    Document Reference: N/A
+*********************************************************************/
+PHY_TARGET_AVX512
+void cmul_avx512(float  *a_re,
+                 float  *a_im,
+                 float  *b_re,
+                 float  *b_im,
+                 uint32  N,
+                 float  *y_re,
+                 float  *y_im)
 {
-    float dist;
+    __m512 ar_v;
+    __m512 ai_v;
+    __m512 br_v;
+    __m512 bi_v;
+    uint32 i = 0;
 
-    if(rx > exp)
+    for(; i+16<=N; i+=16)
     {
-        dist = rx - exp;
-    }else{
-        dist = exp - rx;
+        ar_v = _mm512_loadu_ps(&a_re[i]);
+        ai_v = _mm512_loadu_ps(&a_im[i]);
+        br_v = _mm512_loadu_ps(&b_re[i]);
+        bi_v = _mm512_loadu_ps(&b_im[i]);
+        _mm512_storeu_ps(&y_re[i], _mm512_sub_ps(_mm512_mul_ps(ar_v, br_v), _mm512_mul_ps(ai_v, bi_v)));
+        _mm512_storeu_ps(&y_im[i], _mm512_add_ps(_mm512_mul_ps(ar_v, bi_v), _mm512_mul_ps(ai_v, br_v)));
     }
+    cmul_scalar(&a_re[i], &a_im[i], &b_re[i], &b_im[i], N-i, &y_re[i], &y_im[i]);
+}
+
+/*********************************************************************
+    Name: cmul_conj_avx512
+
+    Description: AVX-512 version of cmul_conj_scalar
+
+    Document Reference: N/A
+*********************************************************************/
+PHY_TARGET_AVX512
+void cmul_conj_avx512(float  *a_re,
+                      float  *a_im,
+                      float  *b_re,
+                      float  *b_im,
+                      uint32  N,
+                      float  *y_re,
+                      float  *y_im)
+{
+    __m512 ar_v;
+    __m512 ai_v;
+    __m512 br_v;
+    __m512 bi_v;
+    uint32 i = 0;
 
-    if(dist > 0.176)
+    for(; i+16<=N; i+=16)
     {
-        dist = 1;
-    }else if(dist > 0.353){
-        dist = 0.75;
-    }else if(dist > 0.530){
-        dist = 0.5;
-    }else{
-        dist = 0.25;
+        ar_v = _mm512_loadu_ps(&a_re[i]);
+        ai_v = _mm512_loadu_ps(&a_im[i]);
+        br_v = _mm512_loadu_ps(&b_re[i]);
+        bi_v = _mm512_loadu_ps(&b_im[i]);
+        _mm512_storeu_ps(&y_re[i], _mm512_add_ps(_mm512_mul_ps(ar_v, br_v), _mm512_mul_ps(ai_v, bi_v)));
+        _mm512_storeu_ps(&y_im[i], _mm512_sub_ps(_mm512_mul_ps(ar_v, bi_v), _mm512_mul_ps(ai_v, br_v)));
     }
-
-    return(dist);
+    cmul_conj_scalar(&a_re[i], &a_im[i], &b_re[i], &b_im[i], N-i, &y_re[i], &y_im[i]);
 }
+#endif
 
 /*********************************************************************
-    Name: get_num_bits_in_prb
+    Name: phy_workspace_alloc
 
-    Description: Determines the number of bits available in a
-                 particular PRB with a particular modulation type
+    Description: Allocates a workspace for a cell, including its own
+                 FFT buffers so that the shared plans can be executed
+                 from several threads at once.
 
     Document Reference: N/A
 *********************************************************************/
-uint32 get_num_bits_in_prb(uint32                          N_subframe,
-                           uint32                          N_ctrl_symbs,
-                           uint32                          prb,
-                           uint32                          N_rb_dl,
-                           uint8                           N_ant,
-                           LIBLTE_PHY_MODULATION_TYPE_ENUM mod_type)
+void phy_workspace_alloc(LIBLTE_PHY_CELL_STRUCT  *cell,
+                         LIBLTE_PHY_STRUCT      **workspace)
 {
-    uint32 first_prb;
-    uint32 last_prb;
-    uint32 N_REs;
-    uint32 N_bits;
-    bool   partial_prb;
+    uint32 N_prach_fft_max = 24576/(30720000/cell->fs);
+    uint32 i;
 
-    // Determine first and last PBCH, PSS, and SSS PRBs
-    if(N_rb_dl == 6)
-    {
-        partial_prb = false;
-        first_prb   = 0;
-        last_prb    = 5;
-    }else if(N_rb_dl == 15){
-        partial_prb = true;
-        first_prb   = 4;
-        last_prb    = 10;
-    }else if(N_rb_dl == 25){
-        partial_prb = true;
-        first_prb   = 9;
-        last_prb    = 15;
-    }else if(N_rb_dl == 50){
-        partial_prb = false;
-        first_prb   = 22;
-        last_prb    = 27;
-    }else if(N_rb_dl == 75){
-        partial_prb = true;
-        first_prb   = 34;
-        last_prb    = 40;
-    }else{ // N_rb_dl == 100
-        partial_prb = false;
-        first_prb   = 47;
-        last_prb    = 52;
-    }
+    *workspace         = (LIBLTE_PHY_STRUCT *)malloc(sizeof(LIBLTE_PHY_STRUCT));
+    (*workspace)->cell = cell;
 
-    if(N_ant == 1)
-    {
-        // Start with raw number of resource elements
-        N_REs = (14-4)*12 + 4*10;
+    // Channel scratch, allocated by the first call that needs it
+    (*workspace)->ul_scratch      = NULL;
+    (*workspace)->dl_scratch      = NULL;
+    (*workspace)->pdcch_scratch   = NULL;
+    (*workspace)->dl_ce_scratch   = NULL;
+    (*workspace)->dl_sync_scratch = NULL;
+    (*workspace)->td_scratch      = NULL;
 
-        // Remove control symbols
-        N_REs -= ((N_ctrl_symbs-1)*12 + 10);
+    // Samples to symbols
+    (*workspace)->s2s_in  = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*cell->N_samps_per_symb*2*20);
+    (*workspace)->s2s_out = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*cell->N_samps_per_symb*2*20);
 
-        // Remove PBCH, PSS, and SSS
-        if(prb >= first_prb &&
-           prb <= last_prb)
-        {
-            if(true == partial_prb &&
-               (prb == first_prb   ||
-                prb == last_prb))
-            {
-                if(N_subframe == 0)
-                {
-                    N_REs -= 5*6 + 5;
-                }else if(N_subframe == 5){
-                    N_REs -= 2*6;
-                }
-            }else{
-                if(N_subframe == 0)
-                {
-                    N_REs -= 5*12 + 10;
-                }else if(N_subframe == 5){
-                    N_REs -= 2*12;
-                }
-            }
-        }
-    }else if(N_ant == 2){
-        // Start with raw number of resource elements
-        N_REs = (14-4)*12 + 4*8;
+    // PUSCH
+    (*workspace)->transform_precoding_in  = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL);
+    (*workspace)->transform_precoding_out = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL);
 
-        // Remove control symbols
-        N_REs -= ((N_ctrl_symbs-1)*12 + 8);
+    // PRACH, sized for the largest preamble format at this sample rate
+    (*workspace)->prach_dft_in   = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*PRACH_N_ZC_MAX);
+    (*workspace)->prach_dft_out  = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*PRACH_N_ZC_MAX);
+    (*workspace)->prach_fft_in   = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*N_prach_fft_max);
+    (*workspace)->prach_fft_out  = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*N_prach_fft_max);
+    (*workspace)->prach_corr_in  = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*64*PRACH_N_ZC_MAX);
+    (*workspace)->prach_corr_out = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*64*PRACH_N_ZC_MAX);
 
-        // Remove PBCH, PSS, and SSS
-        if(prb >= first_prb &&
-           prb <= last_prb)
-        {
-            if(true == partial_prb &&
-               (prb == first_prb   ||
-                prb == last_prb))
-            {
-                if(N_subframe == 0)
-                {
-                    N_REs -= 5*6 + 4;
-                }else if(N_subframe == 5){
-                    N_REs -= 2*6;
-                }
-            }else{
-                if(N_subframe == 0)
-                {
-                    N_REs -= 5*12 + 8;
-                }else if(N_subframe == 5){
-                    N_REs -= 2*12;
-                }
-            }
-        }
-    }else{ // N_ant == 4
-        // Start with raw number of resource elements
-        N_REs = (14-6)*12 + 6*8;
+    // BCH, no encoding pending until the first call
+    (*workspace)->bch_N_bits = 0;
 
-        // Remove control symbols
-        if(1 == N_ctrl_symbs)
-        {
-            N_REs -= 8;
-        }else{
-            N_REs -= ((N_ctrl_symbs-2)*12 + 2*8);
-        }
+    // Turbo decode
+    (*workspace)->td_N_iter = LIBLTE_PHY_TURBO_DECODE_N_ITER_DEFAULT;
 
-        // Remove PBCH, PSS, and SSS
-        if(prb >= first_prb &&
-           prb <= last_prb)
-        {
-            if(true == partial_prb &&
-               (prb == first_prb   ||
-                prb == last_prb))
-            {
-                if(N_subframe == 0)
-                {
-                    N_REs -= 4*6 + 2*4;
-                }else if(N_subframe == 5){
-                    N_REs -= 2*6;
-                }
-            }else{
-                if(N_subframe == 0)
-                {
-                    N_REs -= 4*12 + 2*8;
-                }else if(N_subframe == 5){
-                    N_REs -= 2*12;
-                }
-            }
-        }
-    }
+    // Channel estimate
+    (*workspace)->dl_ce_type          = LIBLTE_PHY_DL_CE_TYPE_POLAR;
+    (*workspace)->dl_ce_est_noise_var = false;
 
-    switch(mod_type)
+    // Code block decode
+    (*workspace)->cb_pool = NULL;
+
+    // Pseudo random sequence cache
+    for(i=0; i<LIBLTE_PHY_PRS_CACHE_N_ENTRIES; i++)
     {
-    case LIBLTE_PHY_MODULATION_TYPE_BPSK:
-        N_bits = N_REs;
-        break;
-    case LIBLTE_PHY_MODULATION_TYPE_QPSK:
-        N_bits = N_REs*2;
-        break;
-    case LIBLTE_PHY_MODULATION_TYPE_16QAM:
-        N_bits = N_REs*4;
-        break;
-    case LIBLTE_PHY_MODULATION_TYPE_64QAM:
-        N_bits = N_REs*6;
-        break;
-    default:
-        N_bits = 0;
-        break;
+        (*workspace)->prs_cache[i].c_init    = 0;
+        (*workspace)->prs_cache[i].len       = 0;
+        (*workspace)->prs_cache[i].last_used = 0;
     }
+    (*workspace)->prs_cache_time = 0;
 
-    return(N_bits);
+    // Rate match index cache
+    for(i=0; i<LIBLTE_PHY_RM_CACHE_N_ENTRIES; i++)
+    {
+        (*workspace)->rm_cache[i].N_idx     = 0;
+        (*workspace)->rm_cache[i].last_used = 0;
+    }
+    (*workspace)->rm_cache_time = 0;
 }
 
 /*********************************************************************
-    Name: wrap_phase
+    Name: phy_cell_ul_cleanup
 
-    Description: Checks the phase difference between two angles and
-                 wraps one to make the difference less than 2*pi.
+    Description: Destroys the uplink plans of a cell.
 
     Document Reference: N/A
 *********************************************************************/
-inline void wrap_phase(float *phase_1,
-                       float  phase_2)
+void phy_cell_ul_cleanup(LIBLTE_PHY_CELL_STRUCT *cell)
 {
-    while((*phase_1 - phase_2) >= M_PI)
-    {
-        *phase_1 = *phase_1 - 2*M_PI;
-    }
-    while((*phase_1 - phase_2) <= -M_PI)
+    uint32 i;
+
+    // PRACH
+    fftwf_destroy_plan(cell->prach_corr_plan);
+    fftwf_destroy_plan(cell->prach_idft_plan);
+    fftwf_destroy_plan(cell->prach_fft_plan);
+    fftwf_destroy_plan(cell->prach_ifft_plan);
+    fftwf_destroy_plan(cell->prach_dft_plan);
+
+    // PUSCH
+    for(i=0; i<cell->N_rb_ul; i++)
     {
-        *phase_1 = *phase_1 + 2*M_PI;
+        if((i % 2) == 0 ||
+           (i % 3) == 0 ||
+           (i % 5) == 0)
+        {
+            fftwf_destroy_plan(cell->transform_precoding_plan[i]);
+            fftwf_destroy_plan(cell->transform_pre_decoding_plan[i]);
+        }
     }
+
+    // Generic
+    cell->ul_init = false;
 }
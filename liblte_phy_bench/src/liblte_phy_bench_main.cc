@@ -0,0 +1,1430 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_phy_bench_main.cc
+
+    Description: Contains all the implementations for the LTE Physical Layer
+                 library microbenchmarks.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/18/2026    agent            Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_phy.h"
+#include "liblte_phy_kernels.h"
+#include "liblte_mac.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define BENCH_N_RESULTS_MAX        2048
+#define BENCH_DEFAULT_MIN_TIME_MS  50
+#define BENCH_N_ID_CELL            1
+#define BENCH_N_MCS                29
+#define BENCH_N_PDCCH_SYMBS        2
+#define BENCH_N_SYNC_FRAMES        3
+#define BENCH_N_SYNC_SLOTS         40
+#define BENCH_PRACH_FREQ_OFFSET    4
+#define BENCH_DEMAP_N_SYMBS        (LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP*12)
+#define BENCH_TD_K_MAX             6144
+#define BENCH_RM_N_E_MAX           (6*(BENCH_TD_K_MAX+4))
+#define BENCH_N_SOFT               250368
+#define BENCH_M_DL_HARQ            8
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef struct{
+    char   name[48];
+    char   param[32];
+    uint32 N_rb;
+    uint32 N_ant;
+    int32  mcs;
+    uint32 N_samps;
+    uint64 N_calls;
+    double ns_per_call;
+    double msamps_per_sec;
+}BENCH_RESULT_STRUCT;
+
+typedef struct{
+    LIBLTE_PHY_STRUCT               *phy_struct;
+    LIBLTE_PHY_SUBFRAME_STRUCT      *tx_subframe;
+    LIBLTE_PHY_SUBFRAME_STRUCT      *rx_subframe;
+    LIBLTE_PHY_ALLOCATION_STRUCT    *alloc;
+    LIBLTE_PHY_PDCCH_STRUCT         *pdcch;
+    LIBLTE_PHY_PDCCH_STRUCT         *rx_pdcch;
+    LIBLTE_PHY_PCFICH_STRUCT         pcfich;
+    LIBLTE_PHY_PCFICH_STRUCT         rx_pcfich;
+    LIBLTE_PHY_PHICH_STRUCT          phich;
+    LIBLTE_PHY_PHICH_STRUCT          rx_phich;
+    LIBLTE_PHY_COARSE_TIMING_STRUCT  timing;
+    LIBLTE_PHY_MODULATION_TYPE_ENUM  mod_type;
+    LIBLTE_ERROR_ENUM                err;
+    float                           *i_samps;
+    float                           *q_samps;
+    float                           *tx_i_samps;
+    float                           *tx_q_samps;
+    float                           *soft_bits;
+    float                           *noise_var;
+    float                            pss_thresh;
+    uint32                           N_id_2;
+    uint32                           N_samps;
+    uint32                           N_bits;
+    uint32                           N_out_bits;
+    uint8                           *bits;
+    uint8                           *out_bits;
+    int8                            *llr_8;
+    uint8                            N_ant;
+}BENCH_CONTEXT_STRUCT;
+
+typedef void (*BENCH_FUNC)(BENCH_CONTEXT_STRUCT *ctx);
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+static BENCH_RESULT_STRUCT        bench_results[BENCH_N_RESULTS_MAX];
+static uint32                     bench_N_results = 0;
+static uint32                     bench_N_failed  = 0;
+static double                     bench_min_time  = BENCH_DEFAULT_MIN_TIME_MS/1000.0;
+static const char                *bench_filter    = NULL;
+static uint32                     bench_N_rb      = 0;
+static uint32                     bench_N_ant     = 0;
+static int32                      bench_mcs       = -1;
+static LIBLTE_PHY_SUBFRAME_STRUCT bench_tx_subframe;
+static LIBLTE_PHY_SUBFRAME_STRUCT bench_rx_subframe;
+static LIBLTE_PHY_PDCCH_STRUCT    bench_pdcch;
+static LIBLTE_PHY_PDCCH_STRUCT    bench_rx_pdcch;
+static float                      bench_soft_bits[BENCH_RM_N_E_MAX];
+static float                      bench_d_re[BENCH_DEMAP_N_SYMBS];
+static float                      bench_d_im[BENCH_DEMAP_N_SYMBS];
+static float                      bench_noise_var[BENCH_DEMAP_N_SYMBS];
+static uint8                      bench_bits[BENCH_RM_N_E_MAX];
+static uint8                      bench_out_bits[BENCH_RM_N_E_MAX];
+static int8                       bench_llr_8[BENCH_DEMAP_N_SYMBS*6];
+
+static const uint32 bench_N_rb_list[6]  = {LIBLTE_PHY_N_RB_DL_1_4MHZ,
+                                           LIBLTE_PHY_N_RB_DL_3MHZ,
+                                           LIBLTE_PHY_N_RB_DL_5MHZ,
+                                           LIBLTE_PHY_N_RB_DL_10MHZ,
+                                           LIBLTE_PHY_N_RB_DL_15MHZ,
+                                           LIBLTE_PHY_N_RB_DL_20MHZ};
+static const uint8  bench_N_ant_list[3] = {1, 2, 4};
+static const LIBLTE_PHY_MODULATION_TYPE_ENUM bench_mod_type_list[4] = {LIBLTE_PHY_MODULATION_TYPE_BPSK,
+                                                                       LIBLTE_PHY_MODULATION_TYPE_QPSK,
+                                                                       LIBLTE_PHY_MODULATION_TYPE_16QAM,
+                                                                       LIBLTE_PHY_MODULATION_TYPE_64QAM};
+static const char bench_mod_type_text[4][8] = {"bpsk", "qpsk", "16qam", "64qam"};
+
+/*******************************************************************************
+                              LOCAL FUNCTION PROTOTYPES
+*******************************************************************************/
+
+double bench_now(void);
+bool bench_selected(const char *name,
+                    uint32      N_rb,
+                    uint32      N_ant,
+                    int32       mcs);
+void bench_run(const char           *name,
+               const char           *param,
+               uint32                N_rb,
+               uint32                N_ant,
+               int32                 mcs,
+               uint32                N_samps,
+               BENCH_FUNC            func,
+               BENCH_CONTEXT_STRUCT *ctx);
+LIBLTE_PHY_FS_ENUM bench_fs(uint32 N_rb);
+uint32 bench_n_prb(uint32 I_tbs,
+                   uint32 N_rb,
+                   bool   ul);
+void bench_random_bits(uint8  *bits,
+                       uint32  N_bits);
+void bench_loopback(LIBLTE_PHY_SUBFRAME_STRUCT *tx_subframe,
+                    LIBLTE_PHY_SUBFRAME_STRUCT *rx_subframe,
+                    uint32                      N_sc,
+                    uint8                       N_ant);
+void bench_check_loopback(const char           *name,
+                          const char           *param,
+                          uint32                N_rb,
+                          uint32                N_ant,
+                          int32                 mcs,
+                          BENCH_FUNC            func,
+                          BENCH_CONTEXT_STRUCT *ctx,
+                          uint8                *bits,
+                          uint32                N_bits);
+void bench_check_pdcch_loopback(uint32                N_rb,
+                                uint32                N_ant,
+                                BENCH_CONTEXT_STRUCT *ctx);
+uint32 bench_count_res(LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                       uint32                      N_sc,
+                       uint8                       N_ant);
+void bench_dl(uint32 N_rb,
+              uint8  N_ant);
+void bench_ul(uint32 N_rb);
+void bench_kernels(void);
+void bench_write_json(FILE       *file,
+                      const char *tag);
+void bench_create_dl_subframe(BENCH_CONTEXT_STRUCT *ctx);
+void bench_get_dl_subframe_and_ce(BENCH_CONTEXT_STRUCT *ctx);
+void bench_dl_find_coarse_timing(BENCH_CONTEXT_STRUCT *ctx);
+void bench_find_pss_and_fine_timing(BENCH_CONTEXT_STRUCT *ctx);
+void bench_find_sss(BENCH_CONTEXT_STRUCT *ctx);
+void bench_bch_channel_encode(BENCH_CONTEXT_STRUCT *ctx);
+void bench_bch_channel_decode(BENCH_CONTEXT_STRUCT *ctx);
+void bench_pdcch_channel_encode(BENCH_CONTEXT_STRUCT *ctx);
+void bench_pdcch_channel_decode(BENCH_CONTEXT_STRUCT *ctx);
+void bench_pdsch_channel_encode(BENCH_CONTEXT_STRUCT *ctx);
+void bench_pdsch_channel_decode(BENCH_CONTEXT_STRUCT *ctx);
+void bench_pusch_channel_encode(BENCH_CONTEXT_STRUCT *ctx);
+void bench_pusch_channel_decode(BENCH_CONTEXT_STRUCT *ctx);
+void bench_detect_prach(BENCH_CONTEXT_STRUCT *ctx);
+void bench_turbo_decode(BENCH_CONTEXT_STRUCT *ctx);
+void bench_viterbi_decode(BENCH_CONTEXT_STRUCT *ctx);
+void bench_rate_unmatch_turbo(BENCH_CONTEXT_STRUCT *ctx);
+void bench_modulation_demapper(BENCH_CONTEXT_STRUCT *ctx);
+
+/*******************************************************************************
+                              MAIN
+*******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    FILE       *json_file = NULL;
+    const char *json_path = NULL;
+    const char *tag       = "";
+    uint32      i;
+    uint32      j;
+    int         opt;
+
+    while(-1 != (opt = getopt(argc, argv, "b:r:a:m:t:j:g:h")))
+    {
+        switch(opt)
+        {
+        case 'b':
+            bench_filter = optarg;
+            break;
+        case 'r':
+            bench_N_rb = atoi(optarg);
+            break;
+        case 'a':
+            bench_N_ant = atoi(optarg);
+            break;
+        case 'm':
+            bench_mcs = atoi(optarg);
+            break;
+        case 't':
+            bench_min_time = atof(optarg)/1000.0;
+            break;
+        case 'j':
+            json_path = optarg;
+            break;
+        case 'g':
+            tag = optarg;
+            break;
+        default:
+            printf("Usage: %s [options]\n", argv[0]);
+            printf("    -b name   Only run benchmarks whose name contains name\n");
+            printf("    -r N_rb   Only run one bandwidth (6, 15, 25, 50, 75, or 100)\n");
+            printf("    -a N_ant  Only run one antenna count (1, 2, or 4)\n");
+            printf("    -m mcs    Only run one MCS (0 to 28)\n");
+            printf("    -t ms     Minimum run time per benchmark, default %u\n", BENCH_DEFAULT_MIN_TIME_MS);
+            printf("    -j file   Write the results as JSON to file, - for stdout\n");
+            printf("    -g tag    Tag stored with the JSON results, e.g. a commit id\n");
+            return(('h' == opt) ? 0 : 1);
+        }
+    }
+
+    if(NULL != json_path)
+    {
+        if(0 == strcmp(json_path, "-"))
+        {
+            json_file = stdout;
+        }else{
+            json_file = fopen(json_path, "w");
+            if(NULL == json_file)
+            {
+                printf("ERROR: Can't open %s\n", json_path);
+                return(1);
+            }
+        }
+    }
+
+    srand(1);
+    printf("*** liblte_phy benchmarks, %s kernels ***\n", liblte_phy_simd_text[liblte_phy_get_simd()]);
+    printf("%-34s %-12s %5s %5s %4s %14s %12s\n", "name", "param", "N_rb", "N_ant", "mcs", "ns/call", "Msamples/s");
+
+    for(i=0; i<6; i++)
+    {
+        for(j=0; j<3; j++)
+        {
+            if((0 == bench_N_rb  || bench_N_rb  == bench_N_rb_list[i]) &&
+               (0 == bench_N_ant || bench_N_ant == bench_N_ant_list[j]))
+            {
+                bench_dl(bench_N_rb_list[i], bench_N_ant_list[j]);
+            }
+        }
+        if((0 == bench_N_rb  || bench_N_rb == bench_N_rb_list[i]) &&
+           (0 == bench_N_ant || 1          == bench_N_ant))
+        {
+            bench_ul(bench_N_rb_list[i]);
+        }
+    }
+    bench_kernels();
+
+    if(NULL != json_file)
+    {
+        bench_write_json(json_file, tag);
+        if(stdout != json_file)
+        {
+            fclose(json_file);
+        }
+    }
+
+    if(0 != bench_N_failed)
+    {
+        printf("ERROR: %u benchmark checks failed\n", bench_N_failed);
+        return(1);
+    }
+
+    return(0);
+}
+
+/*******************************************************************************
+                              LOCAL FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: bench_now
+
+    Description: Returns a monotonic time in seconds
+*********************************************************************/
+double bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return(ts.tv_sec + ts.tv_nsec*1e-9);
+}
+
+/*********************************************************************
+    Name: bench_selected
+
+    Description: Checks a benchmark against the command line filters,
+                 mcs is -1 and N_rb and N_ant are 0 for benchmarks that
+                 don't depend on them
+*********************************************************************/
+bool bench_selected(const char *name,
+                    uint32      N_rb,
+                    uint32      N_ant,
+                    int32       mcs)
+{
+    if(NULL != bench_filter &&
+       NULL == strstr(name, bench_filter))
+    {
+        return(false);
+    }
+    if((0 != bench_N_rb && 0 != N_rb && bench_N_rb != N_rb) ||
+       (0 != bench_N_ant && 0 != N_ant && bench_N_ant != N_ant) ||
+       (-1 != bench_mcs && -1 != mcs && bench_mcs != mcs))
+    {
+        return(false);
+    }
+
+    return(true);
+}
+
+/*********************************************************************
+    Name: bench_run
+
+    Description: Times func, doubling the number of calls per batch
+                 until the minimum run time is reached, then prints
+                 and records the result.  A call that returns an
+                 error is counted as a failure and not timed.  N_samps is the number of
+                 samples each call processes, in the unit of the
+                 benchmark.
+*********************************************************************/
+void bench_run(const char           *name,
+               const char           *param,
+               uint32                N_rb,
+               uint32                N_ant,
+               int32                 mcs,
+               uint32                N_samps,
+               BENCH_FUNC            func,
+               BENCH_CONTEXT_STRUCT *ctx)
+{
+    BENCH_RESULT_STRUCT *result;
+    double               start;
+    double               elapsed = 0;
+    uint64               N_calls = 0;
+    uint64               N_batch = 1;
+    uint64               i;
+
+    if(!bench_selected(name, N_rb, N_ant, mcs) ||
+       BENCH_N_RESULTS_MAX == bench_N_results)
+    {
+        return;
+    }
+
+    // Warm up caches, FFT plans, and rate matching tables, and check
+    // that the call succeeds, a failing chain is not timed
+    ctx->err = LIBLTE_SUCCESS;
+    func(ctx);
+    if(LIBLTE_SUCCESS != ctx->err)
+    {
+        printf("ERROR: %s %s N_rb=%u N_ant=%u mcs=%d returned %u\n", name, param, N_rb, N_ant, mcs, ctx->err);
+        bench_N_failed++;
+        return;
+    }
+
+    while(elapsed < bench_min_time)
+    {
+        start = bench_now();
+        for(i=0; i<N_batch; i++)
+        {
+            func(ctx);
+        }
+        elapsed += bench_now() - start;
+        N_calls += N_batch;
+        N_batch *= 2;
+    }
+
+    result = &bench_results[bench_N_results++];
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    snprintf(result->param, sizeof(result->param), "%s", param);
+    result->N_rb           = N_rb;
+    result->N_ant          = N_ant;
+    result->mcs            = mcs;
+    result->N_samps        = N_samps;
+    result->N_calls        = N_calls;
+    result->ns_per_call    = elapsed*1e9/N_calls;
+    result->msamps_per_sec = N_samps*1e3/result->ns_per_call;
+
+    printf("%-34s %-12s %5u %5u %4d %14.0f %12.3f\n",
+           name,
+           param,
+           N_rb,
+           N_ant,
+           mcs,
+           result->ns_per_call,
+           result->msamps_per_sec);
+    fflush(stdout);
+}
+
+/*********************************************************************
+    Name: bench_fs
+
+    Description: Returns the sample rate used for a bandwidth
+*********************************************************************/
+LIBLTE_PHY_FS_ENUM bench_fs(uint32 N_rb)
+{
+    LIBLTE_PHY_FS_ENUM fs;
+
+    if(LIBLTE_PHY_N_RB_DL_1_4MHZ == N_rb)
+    {
+        fs = LIBLTE_PHY_FS_1_92MHZ;
+    }else if(LIBLTE_PHY_N_RB_DL_3MHZ == N_rb){
+        fs = LIBLTE_PHY_FS_3_84MHZ;
+    }else if(LIBLTE_PHY_N_RB_DL_5MHZ == N_rb){
+        fs = LIBLTE_PHY_FS_7_68MHZ;
+    }else if(LIBLTE_PHY_N_RB_DL_10MHZ == N_rb){
+        fs = LIBLTE_PHY_FS_15_36MHZ;
+    }else{
+        fs = LIBLTE_PHY_FS_30_72MHZ;
+    }
+
+    return(fs);
+}
+
+/*********************************************************************
+    Name: bench_n_prb
+
+    Description: Returns the largest allocation, up to N_rb, whose
+                 transport block fits in an allocation message.  UL
+                 allocations are also limited to the sizes that
+                 liblte_phy_ul_init creates DFT plans for.
+*********************************************************************/
+uint32 bench_n_prb(uint32 I_tbs,
+                   uint32 N_rb,
+                   bool   ul)
+{
+    uint32 N_prb;
+
+    for(N_prb=N_rb; N_prb>1; N_prb--)
+    {
+        if(ul &&
+           (N_rb == N_prb ||
+            ((N_prb % 2) != 0 &&
+             (N_prb % 3) != 0 &&
+             (N_prb % 5) != 0)))
+        {
+            continue;
+        }
+        if(TBS_71721[I_tbs][N_prb-1] <= LIBLTE_MAX_MSG_SIZE)
+        {
+            break;
+        }
+    }
+
+    return(N_prb);
+}
+
+/*********************************************************************
+    Name: bench_random_bits
+
+    Description: Fills an array with random bits
+*********************************************************************/
+void bench_random_bits(uint8  *bits,
+                       uint32  N_bits)
+{
+    uint32 i;
+
+    for(i=0; i<N_bits; i++)
+    {
+        bits[i] = rand() & 1;
+    }
+}
+
+/*********************************************************************
+    Name: bench_loopback
+
+    Description: Receives a transmitted subframe over an ideal channel,
+                 all antennas are summed with unit channel estimates
+*********************************************************************/
+void bench_loopback(LIBLTE_PHY_SUBFRAME_STRUCT *tx_subframe,
+                    LIBLTE_PHY_SUBFRAME_STRUCT *rx_subframe,
+                    uint32                      N_sc,
+                    uint8                       N_ant)
+{
+    uint32 i;
+    uint32 j;
+    uint32 p;
+
+    memset(rx_subframe, 0, sizeof(LIBLTE_PHY_SUBFRAME_STRUCT));
+    rx_subframe->num = tx_subframe->num;
+    for(i=0; i<14; i++)
+    {
+        for(j=0; j<N_sc; j++)
+        {
+            for(p=0; p<N_ant; p++)
+            {
+                rx_subframe->rx_symb_re[i][j] += tx_subframe->tx_symb_re[p][i][j];
+                rx_subframe->rx_symb_im[i][j] += tx_subframe->tx_symb_im[p][i][j];
+                rx_subframe->rx_ce_re[p][i][j] = 1;
+            }
+        }
+    }
+}
+
+/*********************************************************************
+    Name: bench_check_loopback
+
+    Description: Calls the decode func once on the looped back
+                 subframe and checks that it returns the N_bits that
+                 were encoded, counting a failure otherwise
+*********************************************************************/
+void bench_check_loopback(const char           *name,
+                          const char           *param,
+                          uint32                N_rb,
+                          uint32                N_ant,
+                          int32                 mcs,
+                          BENCH_FUNC            func,
+                          BENCH_CONTEXT_STRUCT *ctx,
+                          uint8                *bits,
+                          uint32                N_bits)
+{
+    if(!bench_selected(name, N_rb, N_ant, mcs))
+    {
+        return;
+    }
+
+    ctx->err        = LIBLTE_SUCCESS;
+    ctx->N_out_bits = 0;
+    func(ctx);
+    if(LIBLTE_SUCCESS != ctx->err        ||
+       N_bits         != ctx->N_out_bits ||
+       0              != memcmp(bits, ctx->out_bits, N_bits))
+    {
+        printf("ERROR: %s %s N_rb=%u N_ant=%u mcs=%d loopback failed, returned %u with %u bits\n",
+               name,
+               param,
+               N_rb,
+               N_ant,
+               mcs,
+               ctx->err,
+               ctx->N_out_bits);
+        bench_N_failed++;
+    }
+}
+
+/*********************************************************************
+    Name: bench_check_pdcch_loopback
+
+    Description: Decodes the looped back control channels once and
+                 checks that the CFI and the DCI allocation that were
+                 encoded are recovered, counting a failure otherwise.
+                 The SI DCI may be found in more than one search space,
+                 only the first copy is checked.
+*********************************************************************/
+void bench_check_pdcch_loopback(uint32                N_rb,
+                                uint32                N_ant,
+                                BENCH_CONTEXT_STRUCT *ctx)
+{
+    LIBLTE_PHY_ALLOCATION_STRUCT *tx_alloc = &ctx->pdcch->alloc[0];
+    LIBLTE_PHY_ALLOCATION_STRUCT *rx_alloc = &ctx->rx_pdcch->alloc[0];
+    uint32                        i;
+    bool                          match;
+
+    if(!bench_selected("pdcch_channel_decode", N_rb, N_ant, -1))
+    {
+        return;
+    }
+
+    memset(ctx->rx_pdcch, 0, sizeof(LIBLTE_PHY_PDCCH_STRUCT));
+    ctx->err = LIBLTE_SUCCESS;
+    bench_pdcch_channel_decode(ctx);
+    match = (LIBLTE_SUCCESS      == ctx->err                 &&
+             ctx->pcfich.cfi     == ctx->rx_pcfich.cfi       &&
+             0                   != ctx->rx_pdcch->N_alloc   &&
+             tx_alloc->rnti      == rx_alloc->rnti           &&
+             tx_alloc->tbs       == rx_alloc->tbs            &&
+             tx_alloc->N_prb     == rx_alloc->N_prb);
+    for(i=0; match && i<tx_alloc->N_prb; i++)
+    {
+        match = (tx_alloc->prb[0][i] == rx_alloc->prb[0][i] &&
+                 tx_alloc->prb[1][i] == rx_alloc->prb[1][i]);
+    }
+    if(!match)
+    {
+        printf("ERROR: pdcch_channel_decode N_rb=%u N_ant=%u loopback failed, returned %u with %u allocations\n",
+               N_rb,
+               N_ant,
+               ctx->err,
+               ctx->rx_pdcch->N_alloc);
+        bench_N_failed++;
+    }
+}
+
+/*********************************************************************
+    Name: bench_count_res
+
+    Description: Counts the resource elements used on any antenna of a
+                 subframe
+*********************************************************************/
+uint32 bench_count_res(LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                       uint32                      N_sc,
+                       uint8                       N_ant)
+{
+    uint32 N_res = 0;
+    uint32 i;
+    uint32 j;
+    uint32 p;
+
+    for(i=0; i<14; i++)
+    {
+        for(j=0; j<N_sc; j++)
+        {
+            for(p=0; p<N_ant; p++)
+            {
+                if(0 != subframe->tx_symb_re[p][i][j] ||
+                   0 != subframe->tx_symb_im[p][i][j])
+                {
+                    N_res++;
+                    break;
+                }
+            }
+        }
+    }
+
+    return(N_res);
+}
+
+/*********************************************************************
+    Name: bench_dl
+
+    Description: Runs the downlink benchmarks for one bandwidth and
+                 antenna count.  Waveform functions are measured in
+                 I/Q samples, channel functions in resource elements.
+                 PDSCH uses the largest allocation whose transport
+                 block fits in an allocation message.
+*********************************************************************/
+void bench_dl(uint32 N_rb,
+              uint8  N_ant)
+{
+    LIBLTE_PHY_STRUCT    *phy_struct;
+    BENCH_CONTEXT_STRUCT  ctx;
+    char                  param[32];
+    uint32                N_sc = N_rb*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP;
+    uint32                N_samps_per_subfr;
+    uint32                N_samps_per_frame;
+    uint32                N_sync_samps;
+    uint32                N_res;
+    uint32                pss_symb;
+    uint32                N_id_1;
+    uint32                frame_start_idx;
+    uint32                I_tbs;
+    uint32                N_prb;
+    uint32                tbs;
+    uint32                i;
+    uint32                j;
+    uint32                p;
+    uint32                sf;
+    uint8                 mcs;
+    float                 freq_offset;
+
+    if(LIBLTE_SUCCESS != liblte_phy_init(&phy_struct,
+                                         bench_fs(N_rb),
+                                         BENCH_N_ID_CELL,
+                                         N_ant,
+                                         N_rb,
+                                         LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP,
+                                         1))
+    {
+        printf("ERROR: liblte_phy_init failed for N_rb=%u N_ant=%u\n", N_rb, N_ant);
+        return;
+    }
+    N_samps_per_subfr = phy_struct->cell->N_samps_per_subfr;
+    N_samps_per_frame = phy_struct->cell->N_samps_per_frame;
+    N_sync_samps      = N_samps_per_frame*BENCH_N_SYNC_FRAMES;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.phy_struct  = phy_struct;
+    ctx.tx_subframe = &bench_tx_subframe;
+    ctx.rx_subframe = &bench_rx_subframe;
+    ctx.pdcch       = &bench_pdcch;
+    ctx.rx_pdcch    = &bench_rx_pdcch;
+    ctx.alloc       = &bench_pdcch.alloc[0];
+    ctx.N_ant       = N_ant;
+    ctx.bits        = bench_bits;
+    ctx.out_bits    = bench_out_bits;
+    ctx.i_samps     = (float *)calloc(N_sync_samps, sizeof(float));
+    ctx.q_samps     = (float *)calloc(N_sync_samps, sizeof(float));
+    ctx.tx_i_samps  = (float *)calloc(N_samps_per_subfr, sizeof(float));
+    ctx.tx_q_samps  = (float *)calloc(N_samps_per_subfr, sizeof(float));
+
+    // Build a frame of random QPSK with CRS, PSS, and SSS, summed over
+    // all antennas and repeated for the synchronization searches
+    for(sf=0; sf<10; sf++)
+    {
+        memset(&bench_tx_subframe, 0, sizeof(bench_tx_subframe));
+        bench_tx_subframe.num = sf;
+        for(p=0; p<N_ant; p++)
+        {
+            for(i=0; i<14; i++)
+            {
+                for(j=0; j<N_sc; j++)
+                {
+                    bench_tx_subframe.tx_symb_re[p][i][j] = (rand() & 1) ? 0.7071f : -0.7071f;
+                    bench_tx_subframe.tx_symb_im[p][i][j] = (rand() & 1) ? 0.7071f : -0.7071f;
+                }
+            }
+        }
+        liblte_phy_map_crs(phy_struct, &bench_tx_subframe, BENCH_N_ID_CELL, N_ant);
+        if(0 == sf || 5 == sf)
+        {
+            liblte_phy_map_pss(phy_struct, &bench_tx_subframe, BENCH_N_ID_CELL % 3, N_ant);
+            liblte_phy_map_sss(phy_struct, &bench_tx_subframe, BENCH_N_ID_CELL / 3, BENCH_N_ID_CELL % 3, N_ant);
+        }
+        for(p=0; p<N_ant; p++)
+        {
+            liblte_phy_create_dl_subframe(phy_struct, &bench_tx_subframe, p, ctx.tx_i_samps, ctx.tx_q_samps);
+            for(i=0; i<N_samps_per_subfr; i++)
+            {
+                ctx.i_samps[sf*N_samps_per_subfr + i] += ctx.tx_i_samps[i];
+                ctx.q_samps[sf*N_samps_per_subfr + i] += ctx.tx_q_samps[i];
+            }
+        }
+    }
+    for(i=N_samps_per_frame; i<N_sync_samps; i++)
+    {
+        ctx.i_samps[i] = ctx.i_samps[i - N_samps_per_frame];
+        ctx.q_samps[i] = ctx.q_samps[i - N_samps_per_frame];
+    }
+
+    // Waveform
+    bench_run("create_dl_subframe", "", N_rb, N_ant, -1, N_samps_per_subfr, bench_create_dl_subframe, &ctx);
+    bench_run("get_dl_subframe_and_ce", "", N_rb, N_ant, -1, N_samps_per_subfr, bench_get_dl_subframe_and_ce, &ctx);
+
+    // Synchronization
+    ctx.N_samps = BENCH_N_SYNC_SLOTS;
+    bench_run("dl_find_coarse_timing_and_freq_offset",
+              "",
+              N_rb,
+              N_ant,
+              -1,
+              BENCH_N_SYNC_SLOTS*phy_struct->cell->N_samps_per_slot,
+              bench_dl_find_coarse_timing,
+              &ctx);
+    if(bench_selected("find_pss_and_fine_timing", N_rb, N_ant, -1) ||
+       bench_selected("find_sss", N_rb, N_ant, -1))
+    {
+        liblte_phy_dl_find_coarse_timing_and_freq_offset(phy_struct, ctx.i_samps, ctx.q_samps, BENCH_N_SYNC_SLOTS, &ctx.timing);
+        if(0 != ctx.timing.n_corr_peaks &&
+           LIBLTE_SUCCESS == liblte_phy_find_pss_and_fine_timing(phy_struct,
+                                                                 ctx.i_samps,
+                                                                 ctx.q_samps,
+                                                                 ctx.timing.symb_starts[0],
+                                                                 &ctx.N_id_2,
+                                                                 &pss_symb,
+                                                                 &ctx.pss_thresh,
+                                                                 &freq_offset))
+        {
+            bench_run("find_pss_and_fine_timing", "", N_rb, N_ant, -1, N_samps_per_frame, bench_find_pss_and_fine_timing, &ctx);
+            if(LIBLTE_SUCCESS == liblte_phy_find_sss(phy_struct,
+                                                     ctx.i_samps,
+                                                     ctx.q_samps,
+                                                     ctx.N_id_2,
+                                                     ctx.timing.symb_starts[0],
+                                                     ctx.pss_thresh,
+                                                     &N_id_1,
+                                                     &frame_start_idx))
+            {
+                bench_run("find_sss", "", N_rb, N_ant, -1, N_samps_per_frame, bench_find_sss, &ctx);
+            }else{
+                printf("ERROR: SSS not found for N_rb=%u N_ant=%u\n", N_rb, N_ant);
+                bench_N_failed++;
+            }
+        }else{
+            printf("ERROR: PSS not found for N_rb=%u N_ant=%u\n", N_rb, N_ant);
+            bench_N_failed++;
+        }
+    }
+
+    // BCH
+    memset(&bench_tx_subframe, 0, sizeof(bench_tx_subframe));
+    bench_tx_subframe.num = 0;
+    bench_random_bits(bench_bits, 24);
+    ctx.N_bits = 24;
+    liblte_phy_bch_channel_encode(phy_struct, bench_bits, 24, BENCH_N_ID_CELL, N_ant, &bench_tx_subframe, 0);
+    N_res = bench_count_res(&bench_tx_subframe, N_sc, N_ant);
+    bench_loopback(&bench_tx_subframe, &bench_rx_subframe, N_sc, N_ant);
+    bench_check_loopback("bch_channel_decode", "", N_rb, N_ant, -1, bench_bch_channel_decode, &ctx, bench_bits, 24);
+    bench_run("bch_channel_encode", "", N_rb, N_ant, -1, N_res, bench_bch_channel_encode, &ctx);
+    bench_run("bch_channel_decode", "", N_rb, N_ant, -1, N_res, bench_bch_channel_decode, &ctx);
+
+    // PDCCH, one DCI 1A for SI
+    memset(&bench_pdcch, 0, sizeof(bench_pdcch));
+    memset(&ctx.phich, 0, sizeof(ctx.phich));
+    ctx.pcfich.cfi                = 2;
+    if(4                         == N_ant &&
+       LIBLTE_PHY_N_RB_DL_1_4MHZ == N_rb)
+    {
+        // The CRS of antenna ports 2 and 3 leave only 3 CCEs with a
+        // CFI of 2, too few for the aggregation level 4 DCI
+        ctx.pcfich.cfi = 3;
+    }
+    bench_pdcch.N_alloc           = 1;
+    ctx.alloc->msg.N_bits         = 256;
+    ctx.alloc->pre_coder_type     = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
+    ctx.alloc->mod_type           = LIBLTE_PHY_MODULATION_TYPE_QPSK;
+    ctx.alloc->chan_type          = LIBLTE_PHY_CHAN_TYPE_DLSCH;
+    ctx.alloc->N_codewords        = 1;
+    ctx.alloc->N_layers           = 1;
+    ctx.alloc->tx_mode            = 1;
+    ctx.alloc->rnti               = LIBLTE_MAC_SI_RNTI;
+    bench_random_bits(ctx.alloc->msg.msg, ctx.alloc->msg.N_bits);
+    liblte_phy_get_tbs_mcs_and_n_prb_for_dl(ctx.alloc->msg.N_bits,
+                                            1,
+                                            N_rb,
+                                            ctx.alloc->rnti,
+                                            &ctx.alloc->tbs,
+                                            &ctx.alloc->mcs,
+                                            &ctx.alloc->N_prb);
+    for(i=0; i<ctx.alloc->N_prb; i++)
+    {
+        ctx.alloc->prb[0][i] = i;
+        ctx.alloc->prb[1][i] = i;
+    }
+    memset(&bench_tx_subframe, 0, sizeof(bench_tx_subframe));
+    bench_tx_subframe.num = 1;
+    bench_pdcch_channel_encode(&ctx);
+    N_res = bench_count_res(&bench_tx_subframe, N_sc, N_ant);
+    bench_loopback(&bench_tx_subframe, &bench_rx_subframe, N_sc, N_ant);
+    bench_check_pdcch_loopback(N_rb, N_ant, &ctx);
+    bench_run("pdcch_channel_encode", "", N_rb, N_ant, -1, N_res, bench_pdcch_channel_encode, &ctx);
+    bench_run("pdcch_channel_decode", "", N_rb, N_ant, -1, N_res, bench_pdcch_channel_decode, &ctx);
+
+    // PDSCH, one full bandwidth allocation per MCS
+    bench_pdcch.N_symbs = BENCH_N_PDCCH_SYMBS;
+    for(mcs=0; mcs<BENCH_N_MCS; mcs++)
+    {
+        if(!bench_selected("pdsch_channel_encode", N_rb, N_ant, mcs) &&
+           !bench_selected("pdsch_channel_decode", N_rb, N_ant, mcs))
+        {
+            continue;
+        }
+        I_tbs = (mcs <= 9) ? mcs : ((mcs <= 16) ? mcs - 1 : mcs - 2);
+        N_prb = bench_n_prb(I_tbs, N_rb, false);
+        tbs   = TBS_71721[I_tbs][N_prb-1];
+        ctx.alloc->tbs            = tbs;
+        ctx.alloc->mcs            = mcs;
+        ctx.alloc->N_prb          = N_prb;
+        ctx.alloc->rv_idx         = 0;
+        ctx.alloc->rnti           = 0x1234;
+        ctx.alloc->tx_mode        = (1 == N_ant) ? 1 : 2;
+        ctx.alloc->msg.N_bits     = tbs;
+        if(mcs <= 9)
+        {
+            ctx.alloc->mod_type = LIBLTE_PHY_MODULATION_TYPE_QPSK;
+        }else if(mcs <= 16){
+            ctx.alloc->mod_type = LIBLTE_PHY_MODULATION_TYPE_16QAM;
+        }else{
+            ctx.alloc->mod_type = LIBLTE_PHY_MODULATION_TYPE_64QAM;
+        }
+        for(i=0; i<N_prb; i++)
+        {
+            ctx.alloc->prb[0][i] = i;
+            ctx.alloc->prb[1][i] = i;
+        }
+        bench_random_bits(ctx.alloc->msg.msg, tbs);
+        memset(&bench_tx_subframe, 0, sizeof(bench_tx_subframe));
+        bench_tx_subframe.num = 1;
+        bench_pdsch_channel_encode(&ctx);
+        N_res = bench_count_res(&bench_tx_subframe, N_sc, N_ant);
+        bench_loopback(&bench_tx_subframe, &bench_rx_subframe, N_sc, N_ant);
+        snprintf(param, sizeof(param), "prb=%u,tbs=%u", N_prb, tbs);
+        bench_check_loopback("pdsch_channel_decode", param, N_rb, N_ant, mcs, bench_pdsch_channel_decode, &ctx, ctx.alloc->msg.msg, tbs);
+        bench_run("pdsch_channel_encode", param, N_rb, N_ant, mcs, N_res, bench_pdsch_channel_encode, &ctx);
+        bench_run("pdsch_channel_decode", param, N_rb, N_ant, mcs, N_res, bench_pdsch_channel_decode, &ctx);
+    }
+
+    free(ctx.tx_i_samps);
+    free(ctx.tx_q_samps);
+    free(ctx.i_samps);
+    free(ctx.q_samps);
+    liblte_phy_cleanup(phy_struct);
+}
+
+/*********************************************************************
+    Name: bench_ul
+
+    Description: Runs the uplink benchmarks for one bandwidth, the
+                 library only supports a single uplink antenna
+*********************************************************************/
+void bench_ul(uint32 N_rb)
+{
+    LIBLTE_PHY_STRUCT            *phy_struct;
+    LIBLTE_PHY_ALLOCATION_STRUCT  alloc;
+    BENCH_CONTEXT_STRUCT          ctx;
+    char                          param[32];
+    uint32                        N_sc = N_rb*LIBLTE_PHY_N_SC_RB_UL;
+    uint32                        N_samps_per_subfr;
+    uint32                        N_res;
+    uint32                        I_tbs;
+    uint32                        N_prb;
+    uint32                        tbs;
+    uint32                        i;
+    uint8                         mcs;
+
+    if(LIBLTE_SUCCESS != liblte_phy_init(&phy_struct,
+                                         bench_fs(N_rb),
+                                         BENCH_N_ID_CELL,
+                                         1,
+                                         N_rb,
+                                         LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP,
+                                         1) ||
+       LIBLTE_SUCCESS != liblte_phy_ul_init(phy_struct,
+                                            BENCH_N_ID_CELL,
+                                            0,
+                                            0,
+                                            1,
+                                            false,
+                                            0,
+                                            false,
+                                            false,
+                                            0,
+                                            0))
+    {
+        printf("ERROR: liblte_phy_init failed for N_rb=%u\n", N_rb);
+        return;
+    }
+    N_samps_per_subfr = phy_struct->cell->N_samps_per_subfr;
+
+    memset(&ctx, 0, sizeof(ctx));
+    memset(&alloc, 0, sizeof(alloc));
+    ctx.phy_struct  = phy_struct;
+    ctx.tx_subframe = &bench_tx_subframe;
+    ctx.rx_subframe = &bench_rx_subframe;
+    ctx.alloc       = &alloc;
+    ctx.N_ant       = 1;
+    ctx.out_bits    = bench_out_bits;
+
+    // PRACH, one preamble in two subframes
+    ctx.i_samps = (float *)calloc(N_samps_per_subfr*2, sizeof(float));
+    ctx.q_samps = (float *)calloc(N_samps_per_subfr*2, sizeof(float));
+    liblte_phy_generate_prach(phy_struct, 7, BENCH_PRACH_FREQ_OFFSET, ctx.i_samps, ctx.q_samps);
+    bench_run("detect_prach", "", N_rb, 1, -1, N_samps_per_subfr, bench_detect_prach, &ctx);
+    free(ctx.i_samps);
+    free(ctx.q_samps);
+
+    // PUSCH, one full bandwidth allocation per MCS
+    alloc.pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
+    alloc.chan_type      = LIBLTE_PHY_CHAN_TYPE_ULSCH;
+    alloc.N_codewords    = 1;
+    alloc.N_layers       = 1;
+    alloc.tx_mode        = 1;
+    alloc.rnti           = 0x1234;
+    for(i=0; i<N_rb; i++)
+    {
+        alloc.prb[0][i] = i;
+        alloc.prb[1][i] = i;
+    }
+    for(mcs=0; mcs<BENCH_N_MCS; mcs++)
+    {
+        if(!bench_selected("pusch_channel_encode", N_rb, 1, mcs) &&
+           !bench_selected("pusch_channel_decode", N_rb, 1, mcs))
+        {
+            continue;
+        }
+        if(mcs <= 10)
+        {
+            I_tbs          = mcs;
+            alloc.mod_type = LIBLTE_PHY_MODULATION_TYPE_QPSK;
+        }else if(mcs <= 20){
+            I_tbs          = mcs - 1;
+            alloc.mod_type = LIBLTE_PHY_MODULATION_TYPE_16QAM;
+        }else{
+            I_tbs          = mcs - 2;
+            alloc.mod_type = LIBLTE_PHY_MODULATION_TYPE_64QAM;
+        }
+        N_prb            = bench_n_prb(I_tbs, N_rb, true);
+        tbs              = TBS_71721[I_tbs][N_prb-1];
+        alloc.N_prb      = N_prb;
+        alloc.tbs        = tbs;
+        alloc.mcs        = mcs;
+        alloc.msg.N_bits = tbs;
+        bench_random_bits(alloc.msg.msg, tbs);
+        memset(&bench_tx_subframe, 0, sizeof(bench_tx_subframe));
+        bench_tx_subframe.num = 1;
+        bench_pusch_channel_encode(&ctx);
+        N_res = bench_count_res(&bench_tx_subframe, N_sc, 1);
+        bench_loopback(&bench_tx_subframe, &bench_rx_subframe, N_sc, 1);
+        snprintf(param, sizeof(param), "prb=%u,tbs=%u", N_prb, tbs);
+        bench_check_loopback("pusch_channel_decode", param, N_rb, 1, mcs, bench_pusch_channel_decode, &ctx, alloc.msg.msg, tbs);
+        bench_run("pusch_channel_encode", param, N_rb, 1, mcs, N_res, bench_pusch_channel_encode, &ctx);
+        bench_run("pusch_channel_decode", param, N_rb, 1, mcs, N_res, bench_pusch_channel_decode, &ctx);
+    }
+
+    liblte_phy_ul_cleanup(phy_struct);
+    liblte_phy_cleanup(phy_struct);
+}
+
+/*********************************************************************
+    Name: bench_kernels
+
+    Description: Runs the internal kernel benchmarks.  The decoders
+                 and rate unmatching are measured in soft bits, the
+                 demapper in resource elements.
+*********************************************************************/
+void bench_kernels(void)
+{
+    LIBLTE_PHY_STRUCT    *phy_struct;
+    BENCH_CONTEXT_STRUCT  ctx;
+    char                  param[32];
+    uint32                td_K[3]  = {40, 1024, BENCH_TD_K_MAX};
+    uint32                vd_K[2]  = {40, 44};
+    uint32                rm_E[3]  = {BENCH_TD_K_MAX, 3*(BENCH_TD_K_MAX+4), 6*(BENCH_TD_K_MAX+4)};
+    uint32                g[3]     = {0133, 0171, 0165};
+    uint32                N_d_bits;
+    uint32                B;
+    uint32                i;
+    uint32                j;
+    uint32                k;
+
+    if(LIBLTE_SUCCESS != liblte_phy_init(&phy_struct,
+                                         LIBLTE_PHY_FS_1_92MHZ,
+                                         BENCH_N_ID_CELL,
+                                         1,
+                                         LIBLTE_PHY_N_RB_DL_1_4MHZ,
+                                         LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP,
+                                         1))
+    {
+        printf("ERROR: liblte_phy_init failed for the kernels\n");
+        return;
+    }
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.phy_struct = phy_struct;
+    ctx.soft_bits  = bench_soft_bits;
+    ctx.bits       = bench_bits;
+    ctx.out_bits   = bench_out_bits;
+    ctx.llr_8      = bench_llr_8;
+    ctx.i_samps    = bench_d_re;
+    ctx.q_samps    = bench_d_im;
+
+    // Turbo decode of random bits, the CRC never passes so every
+    // iteration is run
+    for(i=0; i<3; i++)
+    {
+        bench_random_bits(bench_out_bits, td_K[i]);
+        turbo_encode(phy_struct, bench_out_bits, td_K[i], 0, bench_bits, &N_d_bits);
+        B = N_d_bits/3;
+        for(j=0; j<B; j++)
+        {
+            for(k=0; k<3; k++)
+            {
+                bench_soft_bits[j*3+k] = bench_bits[k*B+j] ? -1.0f : 1.0f;
+            }
+        }
+        ctx.N_bits = N_d_bits;
+        snprintf(param, sizeof(param), "K=%u", td_K[i]);
+        bench_run("turbo_decode", param, 0, 0, -1, N_d_bits, bench_turbo_decode, &ctx);
+    }
+
+    // Viterbi decode of a BCH and a 20MHz DCI 1A sized block
+    for(i=0; i<2; i++)
+    {
+        bench_random_bits(bench_out_bits, vd_K[i]);
+        conv_encode(phy_struct, bench_out_bits, vd_K[i], 7, 3, g, true, bench_bits, &N_d_bits);
+        for(j=0; j<N_d_bits; j++)
+        {
+            bench_soft_bits[j] = bench_bits[j] ? -1.0f : 1.0f;
+        }
+        ctx.N_bits = N_d_bits;
+        snprintf(param, sizeof(param), "K=%u", vd_K[i]);
+        bench_run("viterbi_decode", param, 0, 0, -1, N_d_bits, bench_viterbi_decode, &ctx);
+    }
+
+    // Rate unmatching of the largest code block, punctured, at the
+    // mother code rate, and repeated
+    for(i=0; i<3; i++)
+    {
+        for(j=0; j<rm_E[i]; j++)
+        {
+            bench_soft_bits[j] = (rand() & 1) ? -1.0f : 1.0f;
+        }
+        ctx.N_bits = rm_E[i];
+        snprintf(param, sizeof(param), "E=%u", rm_E[i]);
+        bench_run("rate_unmatch_turbo", param, 0, 0, -1, rm_E[i], bench_rate_unmatch_turbo, &ctx);
+    }
+
+    // Demapper over a full 20MHz subframe of noisy constellation points
+    for(i=0; i<BENCH_DEMAP_N_SYMBS; i++)
+    {
+        bench_d_re[i]      = (rand()/(float)RAND_MAX - 0.5f)*2.4f;
+        bench_d_im[i]      = (rand()/(float)RAND_MAX - 0.5f)*2.4f;
+        bench_noise_var[i] = 0.01f + rand()/(float)RAND_MAX*0.2f;
+    }
+    ctx.N_samps = BENCH_DEMAP_N_SYMBS;
+    for(i=0; i<4; i++)
+    {
+        ctx.mod_type = bench_mod_type_list[i];
+        for(j=0; j<2; j++)
+        {
+            ctx.noise_var = (0 == j) ? NULL : bench_noise_var;
+            snprintf(param, sizeof(param), "%.7s%s", bench_mod_type_text[i], (0 == j) ? "" : ",nv");
+            bench_run("modulation_demapper", param, 0, 0, -1, BENCH_DEMAP_N_SYMBS, bench_modulation_demapper, &ctx);
+        }
+    }
+
+    liblte_phy_cleanup(phy_struct);
+}
+
+/*********************************************************************
+    Name: bench_write_json
+
+    Description: Writes all results as one JSON object
+*********************************************************************/
+void bench_write_json(FILE       *file,
+                      const char *tag)
+{
+    BENCH_RESULT_STRUCT *result;
+    uint32               i;
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"tag\": \"%s\",\n", tag);
+    fprintf(file, "  \"simd\": \"%s\",\n", liblte_phy_simd_text[liblte_phy_get_simd()]);
+    fprintf(file, "  \"min_time_ms\": %.0f,\n", bench_min_time*1000.0);
+    fprintf(file, "  \"results\": [\n");
+    for(i=0; i<bench_N_results; i++)
+    {
+        result = &bench_results[i];
+        fprintf(file, "    {\"name\": \"%s\", \"param\": \"%s\", ", result->name, result->param);
+        if(0 != result->N_rb)
+        {
+            fprintf(file, "\"n_rb\": %u, \"n_ant\": %u, ", result->N_rb, result->N_ant);
+        }else{
+            fprintf(file, "\"n_rb\": null, \"n_ant\": null, ");
+        }
+        if(-1 != result->mcs)
+        {
+            fprintf(file, "\"mcs\": %d, ", result->mcs);
+        }else{
+            fprintf(file, "\"mcs\": null, ");
+        }
+        fprintf(file,
+                "\"samples\": %u, \"calls\": %llu, \"ns_per_call\": %.1f, \"msamples_per_s\": %.4f}%s\n",
+                result->N_samps,
+                (unsigned long long)result->N_calls,
+                result->ns_per_call,
+                result->msamps_per_sec,
+                (i+1 < bench_N_results) ? "," : "");
+    }
+    fprintf(file, "  ]\n");
+    fprintf(file, "}\n");
+}
+
+/*********************************************************************
+    Name: bench_*
+
+    Description: Benchmark bodies, each makes one call with the
+                 inputs prepared in the context
+*********************************************************************/
+void bench_create_dl_subframe(BENCH_CONTEXT_STRUCT *ctx)
+{
+    ctx->err = liblte_phy_create_dl_subframe(ctx->phy_struct, ctx->tx_subframe, 0, ctx->tx_i_samps, ctx->tx_q_samps);
+}
+
+void bench_get_dl_subframe_and_ce(BENCH_CONTEXT_STRUCT *ctx)
+{
+    ctx->err = liblte_phy_get_dl_subframe_and_ce(ctx->phy_struct,
+                                                 ctx->i_samps,
+                                                 ctx->q_samps,
+                                                 0,
+                                                 1,
+                                                 BENCH_N_ID_CELL,
+                                                 ctx->N_ant,
+                                                 ctx->rx_subframe);
+}
+
+void bench_dl_find_coarse_timing(BENCH_CONTEXT_STRUCT *ctx)
+{
+    ctx->err = liblte_phy_dl_find_coarse_timing_and_freq_offset(ctx->phy_struct,
+                                                                ctx->i_samps,
+                                                                ctx->q_samps,
+                                                                ctx->N_samps,
+                                                                &ctx->timing);
+}
+
+void bench_find_pss_and_fine_timing(BENCH_CONTEXT_STRUCT *ctx)
+{
+    uint32 symb_starts[7];
+    uint32 N_id_2;
+    uint32 pss_symb;
+    float  pss_thresh;
+    float  freq_offset;
+
+    memcpy(symb_starts, ctx->timing.symb_starts[0], sizeof(symb_starts));
+    ctx->err = liblte_phy_find_pss_and_fine_timing(ctx->phy_struct,
+                                                   ctx->i_samps,
+                                                   ctx->q_samps,
+                                                   symb_starts,
+                                                   &N_id_2,
+                                                   &pss_symb,
+                                                   &pss_thresh,
+                                                   &freq_offset);
+}
+
+void bench_find_sss(BENCH_CONTEXT_STRUCT *ctx)
+{
+    uint32 N_id_1;
+    uint32 frame_start_idx;
+
+    ctx->err = liblte_phy_find_sss(ctx->phy_struct,
+                                   ctx->i_samps,
+                                   ctx->q_samps,
+                                   ctx->N_id_2,
+                                   ctx->timing.symb_starts[0],
+                                   ctx->pss_thresh,
+                                   &N_id_1,
+                                   &frame_start_idx);
+}
+
+void bench_bch_channel_encode(BENCH_CONTEXT_STRUCT *ctx)
+{
+    ctx->err = liblte_phy_bch_channel_encode(ctx->phy_struct,
+                                             ctx->bits,
+                                             ctx->N_bits,
+                                             BENCH_N_ID_CELL,
+                                             ctx->N_ant,
+                                             ctx->tx_subframe,
+                                             0);
+}
+
+void bench_bch_channel_decode(BENCH_CONTEXT_STRUCT *ctx)
+{
+    uint8 N_ant;
+    uint8 offset;
+
+    ctx->err = liblte_phy_bch_channel_decode(ctx->phy_struct,
+                                             ctx->rx_subframe,
+                                             BENCH_N_ID_CELL,
+                                             &N_ant,
+                                             ctx->out_bits,
+                                             &ctx->N_out_bits,
+                                             &offset);
+}
+
+void bench_pdcch_channel_encode(BENCH_CONTEXT_STRUCT *ctx)
+{
+    ctx->err = liblte_phy_pdcch_channel_encode(ctx->phy_struct,
+                                               &ctx->pcfich,
+                                               &ctx->phich,
+                                               ctx->pdcch,
+                                               BENCH_N_ID_CELL,
+                                               ctx->N_ant,
+                                               1,
+                                               LIBLTE_RRC_PHICH_DURATION_NORMAL,
+                                               ctx->tx_subframe);
+}
+
+void bench_pdcch_channel_decode(BENCH_CONTEXT_STRUCT *ctx)
+{
+    ctx->err = liblte_phy_pdcch_channel_decode(ctx->phy_struct,
+                                               ctx->rx_subframe,
+                                               BENCH_N_ID_CELL,
+                                               ctx->N_ant,
+                                               1,
+                                               LIBLTE_RRC_PHICH_DURATION_NORMAL,
+                                               &ctx->rx_pcfich,
+                                               &ctx->rx_phich,
+                                               ctx->rx_pdcch);
+}
+
+void bench_pdsch_channel_encode(BENCH_CONTEXT_STRUCT *ctx)
+{
+    ctx->err = liblte_phy_pdsch_channel_encode(ctx->phy_struct,
+                                               ctx->pdcch,
+                                               BENCH_N_ID_CELL,
+                                               ctx->N_ant,
+                                               ctx->tx_subframe);
+}
+
+void bench_pdsch_channel_decode(BENCH_CONTEXT_STRUCT *ctx)
+{
+    ctx->err = liblte_phy_pdsch_channel_decode(ctx->phy_struct,
+                                               ctx->rx_subframe,
+                                               ctx->alloc,
+                                               BENCH_N_PDCCH_SYMBS,
+                                               BENCH_N_ID_CELL,
+                                               ctx->N_ant,
+                                               NULL,
+                                               ctx->out_bits,
+                                               &ctx->N_out_bits);
+}
+
+void bench_pusch_channel_encode(BENCH_CONTEXT_STRUCT *ctx)
+{
+    ctx->err = liblte_phy_pusch_channel_encode(ctx->phy_struct,
+                                               ctx->alloc,
+                                               BENCH_N_ID_CELL,
+                                               1,
+                                               ctx->tx_subframe);
+}
+
+void bench_pusch_channel_decode(BENCH_CONTEXT_STRUCT *ctx)
+{
+    ctx->err = liblte_phy_pusch_channel_decode(ctx->phy_struct,
+                                               ctx->rx_subframe,
+                                               ctx->alloc,
+                                               BENCH_N_ID_CELL,
+                                               1,
+                                               NULL,
+                                               ctx->out_bits,
+                                               &ctx->N_out_bits);
+}
+
+void bench_detect_prach(BENCH_CONTEXT_STRUCT *ctx)
+{
+    uint32 N_det_pre;
+    uint32 det_pre[64];
+    uint32 det_ta[64];
+    float  det_pwr[64];
+    float  noise_floor;
+
+    ctx->err = liblte_phy_detect_prach(ctx->phy_struct,
+                                       ctx->i_samps,
+                                       ctx->q_samps,
+                                       BENCH_PRACH_FREQ_OFFSET,
+                                       &N_det_pre,
+                                       det_pre,
+                                       det_ta,
+                                       det_pwr,
+                                       &noise_floor);
+}
+
+void bench_turbo_decode(BENCH_CONTEXT_STRUCT *ctx)
+{
+    uint32 N_c_bits;
+
+    turbo_decode(ctx->phy_struct,
+                 ctx->soft_bits,
+                 ctx->N_bits,
+                 0,
+                 0x01864CFB,
+                 ctx->out_bits,
+                 &N_c_bits);
+}
+
+void bench_viterbi_decode(BENCH_CONTEXT_STRUCT *ctx)
+{
+    uint32 N_c_bits;
+
+    viterbi_decode(ctx->phy_struct,
+                   ctx->soft_bits,
+                   ctx->N_bits,
+                   ctx->out_bits,
+                   &N_c_bits);
+}
+
+void bench_rate_unmatch_turbo(BENCH_CONTEXT_STRUCT *ctx)
+{
+    static float d_bits[3*(BENCH_TD_K_MAX+4)];
+    uint32       N_d_bits;
+
+    rate_unmatch_turbo(ctx->phy_struct,
+                       ctx->soft_bits,
+                       ctx->N_bits,
+                       BENCH_TD_K_MAX,
+                       0,
+                       1,
+                       1,
+                       BENCH_N_SOFT,
+                       BENCH_M_DL_HARQ,
+                       LIBLTE_PHY_CHAN_TYPE_DLSCH,
+                       0,
+                       d_bits,
+                       &N_d_bits);
+}
+
+void bench_modulation_demapper(BENCH_CONTEXT_STRUCT *ctx)
+{
+    uint32 N_bits;
+
+    modulation_demapper(ctx->i_samps,
+                        ctx->q_samps,
+                        ctx->noise_var,
+                        ctx->N_samps,
+                        ctx->mod_type,
+                        ctx->llr_8,
+                        &N_bits);
+}